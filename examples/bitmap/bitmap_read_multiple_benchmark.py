@@ -0,0 +1,77 @@
+# SPDX-License-Identifier: Apache-2.0
+
+# Benchmark Bitmap.read_multiple throughput with different worker pool configurations.
+# On multi-socket systems, pinning the pool to a single NUMA node keeps decoded images
+# in memory local to the workers.
+
+import sgl
+import numpy as np
+import tempfile
+from pathlib import Path
+
+IMAGE_COUNT = 256
+IMAGE_WIDTH = 1024
+IMAGE_HEIGHT = 1024
+REPEAT = 3
+
+
+def write_images(directory: Path):
+    paths = []
+    for i in range(IMAGE_COUNT):
+        path = directory / f"test{i}.png"
+        bmp = sgl.Bitmap(
+            np.random.randint(0, 255, (IMAGE_HEIGHT, IMAGE_WIDTH, 3), dtype=np.uint8)
+        )
+        bmp.write_async(path)
+        paths.append(path)
+    sgl.thread.wait_for_tasks()
+    return paths
+
+
+def benchmark(name: str, desc: sgl.thread.ThreadPoolDesc, paths: list[Path]):
+    sgl.thread.configure_global_thread_pool(desc)
+    best = float("inf")
+    for _ in range(REPEAT):
+        t = sgl.Timer()
+        bmps = sgl.Bitmap.read_multiple(paths)
+        best = min(best, t.elapsed_s())
+        del bmps
+    mb = IMAGE_COUNT * IMAGE_WIDTH * IMAGE_HEIGHT * 3 / (1024 * 1024)
+    print(f"{name:<40} {best:8.3f} s {mb / best:10.1f} MB/s")
+
+
+def main():
+    processor_count = sgl.platform.processor_count()
+    numa_node_count = sgl.platform.numa_node_count()
+    print(f"processors: {processor_count}, NUMA nodes: {numa_node_count}")
+
+    with tempfile.TemporaryDirectory() as directory:
+        paths = write_images(Path(directory))
+
+        default_desc = sgl.thread.global_thread_pool_desc()
+
+        benchmark("default", default_desc, paths)
+        for thread_count in [1, 4, processor_count // 2]:
+            if thread_count > 0:
+                benchmark(
+                    f"{thread_count} threads",
+                    sgl.thread.ThreadPoolDesc({"thread_count": thread_count}),
+                    paths,
+                )
+        for node in range(numa_node_count):
+            benchmark(
+                f"NUMA node {node}",
+                sgl.thread.ThreadPoolDesc({"numa_node": node}),
+                paths,
+            )
+        benchmark(
+            "default (low priority)",
+            sgl.thread.ThreadPoolDesc({"priority": sgl.platform.ThreadPriority.low}),
+            paths,
+        )
+
+        sgl.thread.configure_global_thread_pool(default_desc)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,115 @@
+# SPDX-License-Identifier: Apache-2.0
+
+# Benchmark the parallel primitives of device.primitives against naive versions using
+# global atomics (reduction, histogram) and a multi-pass Hillis-Steele scan.
+
+import sgl
+import numpy as np
+from pathlib import Path
+
+EXAMPLE_DIR = Path(__file__).parent
+
+COUNT = 1 << 24
+BIN_COUNT = 256
+USAGE = sgl.ResourceUsage.shader_resource | sgl.ResourceUsage.unordered_access
+
+device = sgl.Device(compiler_options={"include_paths": [EXAMPLE_DIR]})
+primitives = device.primitives
+uint32 = sgl.TypeReflection.ScalarType.uint32
+
+kernels = {
+    name: device.create_compute_kernel(
+        device.load_program("primitives_benchmark.slang", [name])
+    )
+    for name in ["reduce_atomic", "histogram_atomic", "scan_pass"]
+}
+
+rng = np.random.default_rng(0)
+data = rng.integers(0, BIN_COUNT, COUNT).astype(np.uint32)
+src = device.create_buffer(size=data.nbytes, usage=USAGE, data=data)
+tmp = device.create_buffer(size=data.nbytes, usage=USAGE)
+dst = device.create_buffer(size=data.nbytes, usage=USAGE)
+bins = device.create_buffer(size=BIN_COUNT * 4, usage=USAGE)
+count = device.create_buffer(size=4, usage=USAGE)
+
+
+def run(name: str, encode, byte_count: int):
+    result = device.benchmark(encode, {"name": name, "bytes": byte_count})
+    print(
+        f"{name:<20} {result.median * 1e3:8.3f} ms "
+        f"{result.bandwidth / 1e9:8.1f} GB/s {COUNT / result.median / 1e9:8.2f} Gelem/s"
+        + (" (noisy)" if result.noisy else "")
+    )
+
+
+def reduce_atomic(command_buffer: sgl.CommandBuffer):
+    command_buffer.clear_resource_view(dst.get_uav(), sgl.uint4(0, 0, 0, 0))
+    kernels["reduce_atomic"].dispatch(
+        [COUNT, 1, 1],
+        vars={"count": COUNT, "src": src, "dst": dst},
+        command_buffer=command_buffer,
+    )
+
+
+def histogram_atomic(command_buffer: sgl.CommandBuffer):
+    command_buffer.clear_resource_view(bins.get_uav(), sgl.uint4(0, 0, 0, 0))
+    kernels["histogram_atomic"].dispatch(
+        [COUNT, 1, 1],
+        vars={"count": COUNT, "bin_count": BIN_COUNT, "src": src, "dst": bins},
+        command_buffer=command_buffer,
+    )
+
+
+def scan_naive(command_buffer: sgl.CommandBuffer):
+    buffers = [src, dst, tmp]
+    offset = 1
+    while offset < COUNT:
+        kernels["scan_pass"].dispatch(
+            [COUNT, 1, 1],
+            vars={
+                "count": COUNT,
+                "offset": offset,
+                "src": buffers[0],
+                "dst": buffers[1],
+            },
+            command_buffer=command_buffer,
+        )
+        command_buffer.uav_barrier(buffers[1])
+        buffers = [buffers[1], buffers[2], buffers[1]]
+        offset *= 2
+
+
+def main():
+    print(f"elements: {COUNT}, bins: {BIN_COUNT}")
+    size = COUNT * 4
+
+    run("reduce (atomic)", reduce_atomic, size)
+    run(
+        "reduce",
+        lambda cb: primitives.reduce(cb, sgl.ReduceOp.sum, src, dst, COUNT, uint32),
+        size,
+    )
+    run("histogram (atomic)", histogram_atomic, size)
+    run(
+        "histogram",
+        lambda cb: primitives.histogram(cb, src, bins, COUNT, BIN_COUNT),
+        size,
+    )
+    run("scan (Hillis-Steele)", scan_naive, 2 * size)
+    run("scan", lambda cb: primitives.scan(cb, src, dst, COUNT, uint32), 2 * size)
+    run(
+        "compact",
+        lambda cb: primitives.compact(cb, src, src, dst, count, COUNT, uint32),
+        3 * size,
+    )
+
+    # Sorting is in-place, sort a copy to keep the input intact.
+    def sort(command_buffer: sgl.CommandBuffer):
+        command_buffer.copy_buffer_region(tmp, 0, src, 0, size)
+        primitives.sort(command_buffer, tmp, None, COUNT, 8)
+
+    run("sort (8 bit keys)", sort, 2 * 2 * size)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,93 @@
+# SPDX-License-Identifier: Apache-2.0
+
+# Benchmark gradient accumulation into a broadcast argument of a backward call.
+# Compares global atomics against the hierarchical reductions selectable with
+# sgl.slangpy.GradientReduction (wave/group partial sums and privatized partial sums,
+# both followed by a tree reduction into the destination).
+
+import sgl
+import numpy as np
+from pathlib import Path
+
+EXAMPLE_DIR = Path(__file__).parent
+
+THREAD_COUNT = 1 << 20
+ELEMENT_COUNT = 16
+REPEAT = 20
+
+device = sgl.Device(compiler_options={"include_paths": [EXAMPLE_DIR]})
+reducer = sgl.slangpy.GradientReducer(device)
+
+kernels = {
+    name: device.create_compute_kernel(
+        device.load_program("gradient_reduction_benchmark.slang", [f"{name}_main"])
+    )
+    for name in ["atomic", "workgroup", "privatized"]
+}
+
+
+def benchmark(name: str, reduction: sgl.slangpy.GradientReduction):
+    kernel = kernels[name]
+    thread_group_size = kernel.pipeline.thread_group_size.x
+    info = sgl.slangpy.select_gradient_reduction(
+        reduction, THREAD_COUNT, 1, ELEMENT_COUNT, thread_group_size
+    )
+
+    grad = device.create_buffer(
+        size=ELEMENT_COUNT * 4,
+        usage=sgl.ResourceUsage.shader_resource | sgl.ResourceUsage.unordered_access,
+        data=np.zeros(ELEMENT_COUNT, dtype=np.float32),
+    )
+    desc = sgl.slangpy.GradientReductionDesc()
+    desc.partials = reducer.allocate_partials(ELEMENT_COUNT, max(info.partial_count, 1))
+    desc.destination = grad
+    desc.element_count = ELEMENT_COUNT
+    desc.partial_count = max(info.partial_count, 1)
+
+    def run():
+        command_buffer = device.create_command_buffer()
+        if info.reduction != sgl.slangpy.GradientReduction.atomic:
+            reducer.clear(command_buffer, desc)
+        kernel.dispatch(
+            thread_count=[THREAD_COUNT, 1, 1],
+            vars={
+                "thread_count": THREAD_COUNT,
+                "element_count": ELEMENT_COUNT,
+                "partial_count": desc.partial_count,
+                "grad": grad,
+                "partials": desc.partials,
+            },
+            command_buffer=command_buffer,
+        )
+        if info.reduction != sgl.slangpy.GradientReduction.atomic:
+            reducer.reduce(command_buffer, desc)
+        command_buffer.submit()
+
+    # Warm up and check the result of a single call.
+    run()
+    device.wait()
+    result = grad.to_numpy().view(np.float32).copy()
+
+    t = sgl.Timer()
+    for _ in range(REPEAT):
+        run()
+    device.wait()
+    elapsed_ms = t.elapsed_ms() / REPEAT
+
+    print(
+        f"{name:<12} partials={info.partial_count:<8} {elapsed_ms:8.3f} ms/call "
+        f"{THREAD_COUNT / elapsed_ms / 1e6:8.2f} Gthreads/s"
+    )
+    return result
+
+
+def main():
+    print(f"threads: {THREAD_COUNT}, broadcast elements: {ELEMENT_COUNT}")
+    reference = benchmark("atomic", sgl.slangpy.GradientReduction.atomic)
+    for name in ["workgroup", "privatized"]:
+        result = benchmark(name, getattr(sgl.slangpy.GradientReduction, name))
+        assert np.allclose(result, reference, rtol=1e-3)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,895 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "async_io.h"
+
+#include "sgl/core/error.h"
+#include "sgl/core/format.h"
+#include "sgl/core/logger.h"
+#include "sgl/core/platform.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#if SGL_WINDOWS
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif SGL_LINUX || SGL_MACOS
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#error "Unknown OS"
+#endif
+
+#if SGL_LINUX && __has_include(<linux/io_uring.h>)
+#define SGL_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#else
+#define SGL_HAS_IO_URING 0
+#endif
+
+namespace sgl {
+
+// -----------------------------------------------------------------------------
+// AsyncFile
+// -----------------------------------------------------------------------------
+
+/// Read up to \c size bytes at \c offset. Returns the number of bytes read or \c -errno on failure.
+static int64_t read_at(AsyncFile::FileHandle file, uint64_t offset, void* buffer, size_t size)
+{
+    size_t total = 0;
+    while (total < size) {
+#if SGL_WINDOWS
+        OVERLAPPED overlapped{};
+        overlapped.Offset = DWORD(offset + total);
+        overlapped.OffsetHigh = DWORD((offset + total) >> 32);
+        DWORD chunk = DWORD(std::min<size_t>(size - total, 1u << 30));
+        DWORD count = 0;
+        if (!::ReadFile(file, static_cast<uint8_t*>(buffer) + total, chunk, &count, &overlapped)) {
+            if (::GetLastError() == ERROR_HANDLE_EOF)
+                break;
+            return -EIO;
+        }
+#else
+        ssize_t count = ::pread(file, static_cast<uint8_t*>(buffer) + total, size - total, off_t(offset + total));
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+            return -errno;
+        }
+#endif
+        if (count == 0)
+            break;
+        total += size_t(count);
+    }
+    return int64_t(total);
+}
+
+/// Write \c size bytes at \c offset. Returns the number of bytes written or \c -errno on failure.
+static int64_t write_at(AsyncFile::FileHandle file, uint64_t offset, const void* buffer, size_t size)
+{
+    size_t total = 0;
+    while (total < size) {
+#if SGL_WINDOWS
+        OVERLAPPED overlapped{};
+        overlapped.Offset = DWORD(offset + total);
+        overlapped.OffsetHigh = DWORD((offset + total) >> 32);
+        DWORD chunk = DWORD(std::min<size_t>(size - total, 1u << 30));
+        DWORD count = 0;
+        if (!::WriteFile(file, static_cast<const uint8_t*>(buffer) + total, chunk, &count, &overlapped))
+            return -EIO;
+#else
+        ssize_t count
+            = ::pwrite(file, static_cast<const uint8_t*>(buffer) + total, size - total, off_t(offset + total));
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+            return -errno;
+        }
+#endif
+        total += size_t(count);
+    }
+    return int64_t(total);
+}
+
+static std::string error_string(int64_t result)
+{
+    return std::generic_category().message(int(-result));
+}
+
+AsyncFile::AsyncFile(const std::filesystem::path& path, Mode mode)
+    : m_path(path)
+    , m_mode(mode)
+{
+#if SGL_WINDOWS
+    if (mode == Mode::read)
+        m_file = ::CreateFileW(
+            m_path.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            NULL,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            NULL
+        );
+    else
+        m_file = ::CreateFileW(m_path.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        m_file = nullptr;
+        SGL_THROW("{}: I/O error while attempting to open file (error {}).", m_path, ::GetLastError());
+    }
+    LARGE_INTEGER size;
+    if (::GetFileSizeEx(m_file, &size))
+        m_size = uint64_t(size.QuadPart);
+#else
+    int flags = mode == Mode::read ? O_RDONLY : (O_WRONLY | O_CREAT | O_TRUNC);
+    m_file = ::open(m_path.c_str(), flags | O_CLOEXEC, 0644);
+    if (m_file < 0)
+        SGL_THROW("{}: I/O error while attempting to open file: {}", m_path, error_string(-errno));
+    struct stat stat_info;
+    if (::fstat(m_file, &stat_info) == 0)
+        m_size = uint64_t(stat_info.st_size);
+#endif
+}
+
+AsyncFile::~AsyncFile()
+{
+#if SGL_WINDOWS
+    if (m_file)
+        ::CloseHandle(m_file);
+#else
+    if (m_file >= 0)
+        ::close(m_file);
+#endif
+}
+
+size_t AsyncFile::read_at(uint64_t offset, void* buffer, size_t size) const
+{
+    int64_t result = sgl::read_at(m_file, offset, buffer, size);
+    if (result < 0)
+        SGL_THROW("{}: I/O error while reading from file: {}", m_path, error_string(result));
+    return size_t(result);
+}
+
+void AsyncFile::write_at(uint64_t offset, const void* buffer, size_t size) const
+{
+    int64_t result = sgl::write_at(m_file, offset, buffer, size);
+    if (result < 0)
+        SGL_THROW("{}: I/O error while writing to file: {}", m_path, error_string(result));
+}
+
+// -----------------------------------------------------------------------------
+// AsyncIOQueue backends
+// -----------------------------------------------------------------------------
+
+struct AsyncIORequest {
+    AsyncFile::FileHandle file;
+    bool write;
+    uint64_t offset;
+    void* buffer;
+    size_t size;
+    uint64_t user_data;
+};
+
+struct AsyncIOQueue::Backend {
+    virtual ~Backend() = default;
+
+    virtual AsyncIOBackend type() const = 0;
+
+    /// Start executing a request. The caller guarantees that no more than queue depth requests are in flight.
+    virtual void submit(const AsyncIORequest& request) = 0;
+
+    /// Wait for at least \c min_count completions and append all available completions.
+    virtual void complete(uint32_t min_count, std::vector<AsyncIOCompletion>& completions) = 0;
+};
+
+/// Portable backend executing blocking reads/writes on worker threads.
+class ThreadBackend : public AsyncIOQueue::Backend {
+public:
+    ThreadBackend(uint32_t thread_count)
+    {
+        for (uint32_t i = 0; i < std::max(thread_count, 1u); ++i)
+            m_threads.emplace_back(
+                [this, i]()
+                {
+                    platform::set_thread_name(fmt::format("sgl-aio-{}", i));
+                    run();
+                }
+            );
+    }
+
+    ~ThreadBackend() override
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_request_cv.notify_all();
+        for (auto& thread : m_threads)
+            thread.join();
+    }
+
+    AsyncIOBackend type() const override { return AsyncIOBackend::thread; }
+
+    void submit(const AsyncIORequest& request) override
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_requests.push_back(request);
+        }
+        m_request_cv.notify_one();
+    }
+
+    void complete(uint32_t min_count, std::vector<AsyncIOCompletion>& completions) override
+    {
+        std::unique_lock lock(m_mutex);
+        m_completion_cv.wait(lock, [&]() { return m_completions.size() >= min_count; });
+        completions.insert(completions.end(), m_completions.begin(), m_completions.end());
+        m_completions.clear();
+    }
+
+private:
+    void run()
+    {
+        while (true) {
+            AsyncIORequest request;
+            {
+                std::unique_lock lock(m_mutex);
+                m_request_cv.wait(lock, [&]() { return m_stop || !m_requests.empty(); });
+                if (m_stop)
+                    return;
+                request = m_requests.front();
+                m_requests.pop_front();
+            }
+            int64_t result = request.write ? write_at(request.file, request.offset, request.buffer, request.size)
+                                           : read_at(request.file, request.offset, request.buffer, request.size);
+            {
+                std::lock_guard lock(m_mutex);
+                m_completions.push_back({request.user_data, result});
+            }
+            m_completion_cv.notify_one();
+        }
+    }
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_request_cv;
+    std::condition_variable m_completion_cv;
+    std::deque<AsyncIORequest> m_requests;
+    std::vector<AsyncIOCompletion> m_completions;
+    bool m_stop{false};
+};
+
+#if SGL_HAS_IO_URING
+
+static int io_uring_setup(unsigned entries, io_uring_params* params)
+{
+    return int(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return int(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static int io_uring_register(int fd, unsigned opcode, void* arg, unsigned nr_args)
+{
+    return int(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+/// Linux io_uring backend using the raw system call interface.
+class IoUringBackend : public AsyncIOQueue::Backend {
+public:
+    IoUringBackend(uint32_t queue_depth)
+    {
+        io_uring_params params{};
+        m_fd = io_uring_setup(queue_depth, &params);
+        if (m_fd < 0)
+            SGL_THROW("Failed to create io_uring: {}", error_string(-errno));
+
+        // Map submission and completion rings.
+        m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        m_single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (m_single_mmap)
+            m_sq_ring_size = m_cq_ring_size = std::max(m_sq_ring_size, m_cq_ring_size);
+
+        try {
+            m_sq_ring = map(m_sq_ring_size, IORING_OFF_SQ_RING);
+            m_cq_ring = m_single_mmap ? m_sq_ring : map(m_cq_ring_size, IORING_OFF_CQ_RING);
+            m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            m_sqes = static_cast<io_uring_sqe*>(map(m_sqes_size, IORING_OFF_SQES));
+        } catch (...) {
+            // The destructor does not run if the constructor throws.
+            release();
+            throw;
+        }
+
+        auto* sq = static_cast<uint8_t*>(m_sq_ring);
+        m_sq_tail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+        m_sq_mask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+        m_sq_array = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+
+        auto* cq = static_cast<uint8_t*>(m_cq_ring);
+        m_cq_head = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+        m_cq_tail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+        m_cq_mask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    }
+
+    ~IoUringBackend() override { release(); }
+
+    AsyncIOBackend type() const override { return AsyncIOBackend::io_uring; }
+
+    void submit(const AsyncIORequest& request) override
+    {
+        SGL_CHECK(request.size <= UINT32_MAX, "Request size {} exceeds the io_uring limit.", request.size);
+
+        uint32_t tail = *m_sq_tail;
+        uint32_t index = tail & m_sq_mask;
+        io_uring_sqe& sqe = m_sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = request.write ? IORING_OP_WRITE : IORING_OP_READ;
+        sqe.fd = request.file;
+        sqe.off = request.offset;
+        sqe.addr = reinterpret_cast<uint64_t>(request.buffer);
+        sqe.len = uint32_t(request.size);
+        sqe.user_data = request.user_data;
+        m_sq_array[index] = index;
+        std::atomic_ref(*m_sq_tail).store(tail + 1, std::memory_order_release);
+
+        while (io_uring_enter(m_fd, 1, 0, 0) < 0) {
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                int error = errno;
+                // Withdraw the entry, the caller releases the request's user data.
+                std::atomic_ref(*m_sq_tail).store(tail, std::memory_order_release);
+                SGL_THROW("Failed to submit io_uring request: {}", error_string(-error));
+            }
+        }
+    }
+
+    void complete(uint32_t min_count, std::vector<AsyncIOCompletion>& completions) override
+    {
+        uint32_t count = 0;
+        while (true) {
+            uint32_t head = *m_cq_head;
+            uint32_t tail = std::atomic_ref(*m_cq_tail).load(std::memory_order_acquire);
+            for (; head != tail; ++head, ++count) {
+                const io_uring_cqe& cqe = m_cqes[head & m_cq_mask];
+                completions.push_back({cqe.user_data, cqe.res});
+            }
+            std::atomic_ref(*m_cq_head).store(head, std::memory_order_release);
+            if (count >= min_count)
+                break;
+            if (io_uring_enter(m_fd, 0, min_count - count, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+                SGL_THROW("Failed to wait for io_uring completions: {}", error_string(-errno));
+        }
+    }
+
+    static bool is_supported()
+    {
+        io_uring_params params{};
+        int fd = io_uring_setup(1, &params);
+        if (fd < 0)
+            return false;
+        // Check that IORING_OP_READ and IORING_OP_WRITE are supported (Linux 5.6+).
+        constexpr unsigned OP_COUNT = 256;
+        std::vector<uint8_t> storage(sizeof(io_uring_probe) + OP_COUNT * sizeof(io_uring_probe_op));
+        auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+        bool supported = io_uring_register(fd, IORING_REGISTER_PROBE, probe, OP_COUNT) == 0
+            && probe->last_op >= IORING_OP_WRITE && (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED)
+            && (probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED);
+        ::close(fd);
+        return supported;
+    }
+
+private:
+    void release()
+    {
+        if (m_sqes)
+            ::munmap(m_sqes, m_sqes_size);
+        if (m_cq_ring && !m_single_mmap)
+            ::munmap(m_cq_ring, m_cq_ring_size);
+        if (m_sq_ring)
+            ::munmap(m_sq_ring, m_sq_ring_size);
+        if (m_fd >= 0)
+            ::close(m_fd);
+        m_sqes = nullptr;
+        m_cq_ring = nullptr;
+        m_sq_ring = nullptr;
+        m_fd = -1;
+    }
+
+    void* map(size_t size, uint64_t offset)
+    {
+        void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, off_t(offset));
+        if (ptr == MAP_FAILED)
+            SGL_THROW("Failed to map io_uring: {}", error_string(-errno));
+        return ptr;
+    }
+
+    int m_fd{-1};
+    bool m_single_mmap{false};
+    void* m_sq_ring{nullptr};
+    void* m_cq_ring{nullptr};
+    size_t m_sq_ring_size{0};
+    size_t m_cq_ring_size{0};
+    io_uring_sqe* m_sqes{nullptr};
+    size_t m_sqes_size{0};
+    uint32_t* m_sq_tail;
+    uint32_t m_sq_mask;
+    uint32_t* m_sq_array;
+    uint32_t* m_cq_head;
+    uint32_t* m_cq_tail;
+    uint32_t m_cq_mask;
+    io_uring_cqe* m_cqes;
+};
+
+#endif // SGL_HAS_IO_URING
+
+// -----------------------------------------------------------------------------
+// AsyncIOQueue
+// -----------------------------------------------------------------------------
+
+AsyncIOQueue::AsyncIOQueue(AsyncIOQueueDesc desc)
+    : m_desc(std::move(desc))
+{
+    SGL_CHECK(m_desc.queue_depth > 0, "Queue depth must be greater than zero.");
+
+    AsyncIOBackend backend = m_desc.backend;
+    if (backend == AsyncIOBackend::auto_)
+        backend = is_io_uring_supported() ? AsyncIOBackend::io_uring : AsyncIOBackend::thread;
+
+    switch (backend) {
+    case AsyncIOBackend::thread:
+        m_backend = std::make_unique<ThreadBackend>(m_desc.thread_count);
+        break;
+    case AsyncIOBackend::io_uring:
+#if SGL_HAS_IO_URING
+        m_backend = std::make_unique<IoUringBackend>(m_desc.queue_depth);
+        break;
+#else
+        SGL_THROW("io_uring is not supported on this platform.");
+#endif
+    default:
+        SGL_THROW("Invalid backend {}.", backend);
+    }
+}
+
+AsyncIOQueue::~AsyncIOQueue()
+{
+    // Wait for requests in flight, they may still reference the caller's buffers.
+    while (m_in_flight_count > 0)
+        complete(m_in_flight_count);
+}
+
+AsyncIOBackend AsyncIOQueue::backend() const
+{
+    return m_backend->type();
+}
+
+void AsyncIOQueue::submit(
+    const AsyncFile* file,
+    bool write,
+    uint64_t offset,
+    void* buffer,
+    size_t size,
+    uint64_t user_data
+)
+{
+    SGL_CHECK_NOT_NULL(file);
+
+    // Make room by reaping a completion. It is returned by the next call to complete().
+    if (m_in_flight_count == m_desc.queue_depth) {
+        size_t count = m_completed.size();
+        m_backend->complete(1, m_completed);
+        m_in_flight_count -= uint32_t(m_completed.size() - count);
+    }
+
+    m_backend->submit({
+        .file = file->native_handle(),
+        .write = write,
+        .offset = offset,
+        .buffer = buffer,
+        .size = size,
+        .user_data = user_data,
+    });
+    m_in_flight_count++;
+    m_pending_count++;
+}
+
+void AsyncIOQueue::submit_read(const AsyncFile* file, uint64_t offset, void* buffer, size_t size, uint64_t user_data)
+{
+    submit(file, false, offset, buffer, size, user_data);
+}
+
+void AsyncIOQueue::submit_write(
+    const AsyncFile* file,
+    uint64_t offset,
+    const void* buffer,
+    size_t size,
+    uint64_t user_data
+)
+{
+    submit(file, true, offset, const_cast<void*>(buffer), size, user_data);
+}
+
+std::vector<AsyncIOCompletion> AsyncIOQueue::complete(uint32_t min_count)
+{
+    std::vector<AsyncIOCompletion> completions = std::move(m_completed);
+    m_completed.clear();
+
+    min_count = std::min(min_count, m_pending_count);
+    uint32_t wait_count = min_count > completions.size() ? min_count - uint32_t(completions.size()) : 0;
+    size_t count = completions.size();
+    m_backend->complete(wait_count, completions);
+    m_in_flight_count -= uint32_t(completions.size() - count);
+    m_pending_count -= uint32_t(completions.size());
+
+    return completions;
+}
+
+bool AsyncIOQueue::is_io_uring_supported()
+{
+#if SGL_HAS_IO_URING
+    static bool supported = IoUringBackend::is_supported();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+std::string AsyncIOQueue::to_string() const
+{
+    return fmt::format(
+        "AsyncIOQueue(\n"
+        "  backend = {},\n"
+        "  queue_depth = {},\n"
+        "  pending_count = {}\n"
+        ")",
+        backend(),
+        m_desc.queue_depth,
+        m_pending_count
+    );
+}
+
+// -----------------------------------------------------------------------------
+// I/O service
+// -----------------------------------------------------------------------------
+
+namespace async_io {
+
+    /// Size of the individual read/write requests issued for a file.
+    static constexpr size_t CHUNK_SIZE = 1024 * 1024;
+
+    /// Maximum number of requests in flight.
+    static constexpr uint32_t QUEUE_DEPTH = 128;
+
+    /// Read or write of an entire file.
+    struct Job {
+        std::filesystem::path path;
+        bool write;
+        std::vector<uint8_t> data;
+        ReadCallback read_callback;
+        WriteCallback write_callback;
+
+        ref<AsyncFile> file;
+        /// Offset of the next chunk to submit.
+        uint64_t next_offset{0};
+        /// Remainders of short reads/writes to resubmit.
+        std::vector<std::pair<uint64_t, size_t>> retries;
+        /// Number of chunks in flight.
+        uint32_t in_flight{0};
+        /// Lowest offset a read returned end of file at. The data is truncated to it when the job finishes.
+        uint64_t eof_offset{std::numeric_limits<uint64_t>::max()};
+        std::exception_ptr error;
+
+        uint64_t end_offset() const { return std::min(uint64_t(data.size()), eof_offset); }
+        bool has_chunks() const { return !error && (next_offset < end_offset() || !retries.empty()); }
+    };
+
+    /// Chunk in flight, referenced by the completion's user data.
+    struct Chunk {
+        Job* job;
+        uint64_t offset;
+        size_t size;
+    };
+
+    /// Service thread driving an \c AsyncIOQueue for whole-file reads and writes.
+    class Service {
+    public:
+        Service()
+            : m_queue(make_ref<AsyncIOQueue>(AsyncIOQueueDesc{.queue_depth = QUEUE_DEPTH}))
+        {
+            log_debug("Async I/O service using {} backend.", m_queue->backend());
+            m_thread = std::thread(
+                [this]()
+                {
+                    platform::set_thread_name("sgl-aio-service");
+                    run();
+                }
+            );
+        }
+
+        ~Service()
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_stop = true;
+            }
+            m_cv.notify_all();
+            m_thread.join();
+        }
+
+        AsyncIOBackend backend() const { return m_queue->backend(); }
+
+        void post(std::unique_ptr<Job> job)
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_incoming.push_back(std::move(job));
+                m_job_count++;
+            }
+            m_cv.notify_all();
+        }
+
+        size_t pending_count() const
+        {
+            std::lock_guard lock(m_mutex);
+            return m_job_count;
+        }
+
+        void wait_for_idle()
+        {
+            std::unique_lock lock(m_mutex);
+            m_idle_cv.wait(lock, [this]() { return m_job_count == 0; });
+        }
+
+    private:
+        void run()
+        {
+            while (true) {
+                std::vector<std::unique_ptr<Job>> incoming;
+                {
+                    std::unique_lock lock(m_mutex);
+                    m_cv.wait(
+                        lock,
+                        [this]() { return m_stop || !m_incoming.empty() || m_queue->pending_count() > 0; }
+                    );
+                    if (m_stop && m_incoming.empty() && m_queue->pending_count() == 0)
+                        return;
+                    incoming = std::move(m_incoming);
+                    m_incoming.clear();
+                }
+
+                for (auto& job : incoming)
+                    start(std::move(job));
+
+                submit_chunks();
+
+                if (m_queue->pending_count() > 0) {
+                    for (const AsyncIOCompletion& completion : m_queue->complete(1))
+                        on_complete(completion);
+                }
+            }
+        }
+
+        void start(std::unique_ptr<Job> job)
+        {
+            try {
+                job->file = make_ref<AsyncFile>(job->path, job->write ? AsyncFile::Mode::write : AsyncFile::Mode::read);
+                if (!job->write)
+                    job->data.resize(job->file->size());
+            } catch (...) {
+                job->error = std::current_exception();
+            }
+            if (job->has_chunks())
+                m_active.push_back(std::move(job));
+            else
+                finish(std::move(job));
+        }
+
+        void submit_chunks()
+        {
+            // Submit chunks round-robin across active jobs until the queue is full.
+            bool submitted = true;
+            while (submitted && m_queue->pending_count() < QUEUE_DEPTH) {
+                submitted = false;
+                for (auto& job : m_active) {
+                    if (m_queue->pending_count() >= QUEUE_DEPTH)
+                        break;
+                    if (!job->has_chunks())
+                        continue;
+                    uint64_t offset;
+                    size_t size;
+                    if (!job->retries.empty()) {
+                        std::tie(offset, size) = job->retries.back();
+                        job->retries.pop_back();
+                        // Retries past the end of a truncated file are dropped.
+                        if (offset >= job->end_offset()) {
+                            submitted = true;
+                            continue;
+                        }
+                        size = std::min(size, size_t(job->end_offset() - offset));
+                    } else {
+                        offset = job->next_offset;
+                        size = std::min(CHUNK_SIZE, size_t(job->end_offset() - offset));
+                        job->next_offset += size;
+                    }
+                    // The chunk is owned by the completion once it is submitted.
+                    auto chunk = std::make_unique<Chunk>(Chunk{job.get(), offset, size});
+                    auto user_data = reinterpret_cast<uint64_t>(chunk.get());
+                    try {
+                        if (job->write)
+                            m_queue->submit_write(job->file, offset, job->data.data() + offset, size, user_data);
+                        else
+                            m_queue->submit_read(job->file, offset, job->data.data() + offset, size, user_data);
+                    } catch (...) {
+                        // Fail the job, not the service thread.
+                        job->error = std::current_exception();
+                        continue;
+                    }
+                    chunk.release();
+                    job->in_flight++;
+                    submitted = true;
+                }
+            }
+
+            // Failed jobs without chunks in flight get no more completions, finish them here.
+            for (auto it = m_active.begin(); it != m_active.end();) {
+                if ((*it)->in_flight == 0 && !(*it)->has_chunks()) {
+                    std::unique_ptr<Job> finished = std::move(*it);
+                    it = m_active.erase(it);
+                    finish(std::move(finished));
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        void on_complete(const AsyncIOCompletion& completion)
+        {
+            std::unique_ptr<Chunk> chunk(reinterpret_cast<Chunk*>(completion.user_data));
+            Job* job = chunk->job;
+            job->in_flight--;
+
+            if (completion.result < 0) {
+                if (!job->error)
+                    job->error = std::make_exception_ptr(std::runtime_error(fmt::format(
+                        "{}: I/O error while {} file: {}",
+                        job->path,
+                        job->write ? "writing" : "reading",
+                        error_string(completion.result)
+                    )));
+            } else if (size_t(completion.result) < chunk->size) {
+                if (completion.result == 0 && !job->write) {
+                    // File was truncated while reading. Chunks past this offset may still complete (or
+                    // complete earlier), so the data is only truncated once the job finishes.
+                    job->eof_offset = std::min(job->eof_offset, chunk->offset);
+                } else {
+                    job->retries.emplace_back(
+                        chunk->offset + completion.result,
+                        chunk->size - size_t(completion.result)
+                    );
+                }
+            }
+
+            if (job->in_flight == 0 && !job->has_chunks()) {
+                auto it = std::find_if(m_active.begin(), m_active.end(), [&](const auto& j) { return j.get() == job; });
+                std::unique_ptr<Job> finished = std::move(*it);
+                m_active.erase(it);
+                finish(std::move(finished));
+            }
+        }
+
+        void finish(std::unique_ptr<Job> job)
+        {
+            job->file = nullptr;
+            try {
+                if (job->write) {
+                    if (job->write_callback)
+                        job->write_callback(job->error);
+                    else if (job->error)
+                        std::rethrow_exception(job->error);
+                } else {
+                    if (job->eof_offset < job->data.size())
+                        job->data.resize(job->eof_offset);
+                    job->read_callback(job->error ? std::vector<uint8_t>{} : std::move(job->data), job->error);
+                }
+            } catch (const std::exception& e) {
+                log_error("Async I/O: {}", e.what());
+            }
+            {
+                std::lock_guard lock(m_mutex);
+                m_job_count--;
+            }
+            m_idle_cv.notify_all();
+        }
+
+        ref<AsyncIOQueue> m_queue;
+        std::thread m_thread;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::condition_variable m_idle_cv;
+        std::vector<std::unique_ptr<Job>> m_incoming;
+        size_t m_job_count{0};
+        bool m_stop{false};
+
+        // Only accessed by the service thread.
+        std::vector<std::unique_ptr<Job>> m_active;
+    };
+
+    static std::unique_ptr<Service> s_service;
+    static std::mutex s_service_mutex;
+
+    static Service& service()
+    {
+        std::lock_guard lock(s_service_mutex);
+        if (!s_service)
+            s_service = std::make_unique<Service>();
+        return *s_service;
+    }
+
+    void static_shutdown()
+    {
+        std::lock_guard lock(s_service_mutex);
+        s_service.reset();
+    }
+
+    void read_file(const std::filesystem::path& path, ReadCallback callback)
+    {
+        SGL_CHECK(callback, "Read callback must be set.");
+        auto job = std::make_unique<Job>();
+        job->path = path;
+        job->write = false;
+        job->read_callback = std::move(callback);
+        service().post(std::move(job));
+    }
+
+    void write_file(const std::filesystem::path& path, std::vector<uint8_t> data, WriteCallback callback)
+    {
+        auto job = std::make_unique<Job>();
+        job->path = path;
+        job->write = true;
+        job->data = std::move(data);
+        job->write_callback = std::move(callback);
+        service().post(std::move(job));
+    }
+
+    size_t pending_count()
+    {
+        std::lock_guard lock(s_service_mutex);
+        return s_service ? s_service->pending_count() : 0;
+    }
+
+    void wait_for_idle()
+    {
+        Service* svc;
+        {
+            std::lock_guard lock(s_service_mutex);
+            svc = s_service.get();
+        }
+        if (svc)
+            svc->wait_for_idle();
+    }
+
+    AsyncIOBackend backend()
+    {
+        return service().backend();
+    }
+
+} // namespace async_io
+
+} // namespace sgl
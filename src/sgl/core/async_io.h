@@ -0,0 +1,287 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sgl/core/macros.h"
+#include "sgl/core/object.h"
+#include "sgl/core/enum.h"
+#include "sgl/core/thread.h"
+
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace sgl {
+
+enum class AsyncIOBackend {
+    /// Use io_uring if supported, the thread backend otherwise.
+    auto_,
+    /// Portable backend issuing blocking reads/writes on dedicated worker threads.
+    thread,
+    /// Linux io_uring backend.
+    io_uring,
+};
+
+SGL_ENUM_INFO(
+    AsyncIOBackend,
+    {
+        {AsyncIOBackend::auto_, "auto"},
+        {AsyncIOBackend::thread, "thread"},
+        {AsyncIOBackend::io_uring, "io_uring"},
+    }
+);
+SGL_ENUM_REGISTER(AsyncIOBackend);
+
+/**
+ * \brief File opened for asynchronous I/O.
+ */
+class SGL_API AsyncFile : public Object {
+    SGL_OBJECT(AsyncFile)
+public:
+    enum class Mode {
+        /// Open an existing file for reading.
+        read,
+        /// Create (or truncate) a file for writing.
+        write,
+    };
+
+    SGL_ENUM_INFO(
+        Mode,
+        {
+            {Mode::read, "read"},
+            {Mode::write, "write"},
+        }
+    );
+
+    AsyncFile(const std::filesystem::path& path, Mode mode);
+    ~AsyncFile();
+
+    SGL_NON_COPYABLE_AND_MOVABLE(AsyncFile);
+
+    const std::filesystem::path& path() const { return m_path; }
+
+    Mode mode() const { return m_mode; }
+
+    /// Size of the file in bytes (at the time it was opened).
+    uint64_t size() const { return m_size; }
+
+    /// Read up to \c size bytes at \c offset (blocking).
+    /// \return Number of bytes read (less than \c size at the end of the file).
+    size_t read_at(uint64_t offset, void* buffer, size_t size) const;
+
+    /// Write \c size bytes at \c offset (blocking).
+    void write_at(uint64_t offset, const void* buffer, size_t size) const;
+
+#if SGL_WINDOWS
+    using FileHandle = void*;
+#else
+    using FileHandle = int;
+#endif
+
+    /// Native file handle (file descriptor on POSIX systems).
+    FileHandle native_handle() const { return m_file; }
+
+private:
+    std::filesystem::path m_path;
+    Mode m_mode;
+    uint64_t m_size{0};
+#if SGL_WINDOWS
+    FileHandle m_file{nullptr};
+#else
+    FileHandle m_file{-1};
+#endif
+};
+
+SGL_ENUM_REGISTER(AsyncFile::Mode);
+
+struct AsyncIOQueueDesc {
+    /// Backend to use.
+    AsyncIOBackend backend{AsyncIOBackend::auto_};
+    /// Maximum number of requests in flight.
+    uint32_t queue_depth{64};
+    /// Number of worker threads used by the thread backend.
+    uint32_t thread_count{4};
+};
+
+struct AsyncIOCompletion {
+    /// User data passed on submission.
+    uint64_t user_data;
+    /// Number of bytes transferred, or a negative error code (\c -errno) on failure.
+    int64_t result;
+};
+
+/**
+ * \brief Queue for asynchronous reads and writes into caller-owned buffers.
+ *
+ * Requests are submitted with \c submit_read / \c submit_write and their results are
+ * retrieved with \c complete. Buffers and files must stay alive until the corresponding
+ * request has completed. On Linux, io_uring is used if supported by the kernel. Otherwise
+ * requests are executed by a small set of worker threads.
+ *
+ * The queue is not thread-safe and is meant to be driven by a single thread.
+ */
+class SGL_API AsyncIOQueue : public Object {
+    SGL_OBJECT(AsyncIOQueue)
+public:
+    AsyncIOQueue(AsyncIOQueueDesc desc = {});
+    ~AsyncIOQueue();
+
+    SGL_NON_COPYABLE_AND_MOVABLE(AsyncIOQueue);
+
+    const AsyncIOQueueDesc& desc() const { return m_desc; }
+
+    /// The backend in use (never \c AsyncIOBackend::auto_).
+    AsyncIOBackend backend() const;
+
+    /**
+     * \brief Submit a read request.
+     *
+     * If the queue is full, this blocks until a request completes.
+     * The completion of that request is returned by the next call to \c complete.
+     *
+     * \param file File to read from.
+     * \param offset Offset in the file.
+     * \param buffer Buffer to read into.
+     * \param size Number of bytes to read.
+     * \param user_data User data returned with the completion.
+     */
+    void submit_read(const AsyncFile* file, uint64_t offset, void* buffer, size_t size, uint64_t user_data);
+
+    /// Submit a write request. See \c submit_read.
+    void submit_write(const AsyncFile* file, uint64_t offset, const void* buffer, size_t size, uint64_t user_data);
+
+    /**
+     * \brief Retrieve completed requests.
+     *
+     * Blocks until at least \c min_count requests have completed (or fewer if fewer are pending).
+     *
+     * \param min_count Minimum number of completions to wait for.
+     * \return List of completions.
+     */
+    std::vector<AsyncIOCompletion> complete(uint32_t min_count = 1);
+
+    /// Number of submitted requests that have not been returned by \c complete yet.
+    uint32_t pending_count() const { return m_pending_count; }
+
+    /// Check if the io_uring backend is supported on this system.
+    static bool is_io_uring_supported();
+
+    std::string to_string() const override;
+
+    struct Backend;
+
+private:
+    void submit(const AsyncFile* file, bool write, uint64_t offset, void* buffer, size_t size, uint64_t user_data);
+
+    AsyncIOQueueDesc m_desc;
+    std::unique_ptr<Backend> m_backend;
+    /// Completions reaped while submitting to a full queue.
+    std::vector<AsyncIOCompletion> m_completed;
+    /// Number of requests submitted to the backend and not yet reaped.
+    uint32_t m_in_flight_count{0};
+    /// Number of requests not yet returned by \c complete.
+    uint32_t m_pending_count{0};
+};
+
+namespace async_io {
+
+    using ReadCallback = std::function<void(std::vector<uint8_t> data, std::exception_ptr error)>;
+    using WriteCallback = std::function<void(std::exception_ptr error)>;
+
+    SGL_API void static_shutdown();
+
+    /**
+     * \brief Read an entire file asynchronously.
+     *
+     * Files are read by a shared I/O service thread driving an \c AsyncIOQueue.
+     * The callback is invoked on the service thread and should not block.
+     */
+    SGL_API void read_file(const std::filesystem::path& path, ReadCallback callback);
+
+    /**
+     * \brief Write data to a file asynchronously (the file is created or truncated).
+     *
+     * The callback is invoked on the service thread and should not block.
+     */
+    SGL_API void write_file(const std::filesystem::path& path, std::vector<uint8_t> data, WriteCallback callback = {});
+
+    /// Number of file reads/writes that have not completed yet.
+    SGL_API size_t pending_count();
+
+    /// Block until all file reads/writes have completed.
+    SGL_API void wait_for_idle();
+
+    /// Backend used by the I/O service.
+    SGL_API AsyncIOBackend backend();
+
+    /**
+     * \brief Read an entire file asynchronously and process its contents on the global thread pool.
+     *
+     * When called from a global thread pool worker, \c func is instead run on the thread waiting for
+     * the returned future, as a worker waiting for another pool task can deadlock the pool.
+     *
+     * \param path File to read.
+     * \param func Function called with the file contents (\c std::vector<uint8_t>).
+     * \return Future holding the result of \c func.
+     */
+    template<typename F, typename R = std::invoke_result_t<std::decay_t<F>, std::vector<uint8_t>>>
+    std::future<R> read_file_and_process(const std::filesystem::path& path, F&& func)
+    {
+        if (thread::in_global_thread_pool()) {
+            auto data_promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
+            std::future<std::vector<uint8_t>> data = data_promise->get_future();
+            read_file(
+                path,
+                [data_promise](std::vector<uint8_t> data, std::exception_ptr error)
+                {
+                    if (error)
+                        data_promise->set_exception(error);
+                    else
+                        data_promise->set_value(std::move(data));
+                }
+            );
+            return std::async(
+                std::launch::deferred,
+                [func = std::forward<F>(func), data = std::move(data)]() mutable { return func(data.get()); }
+            );
+        }
+
+        auto promise = std::make_shared<std::promise<R>>();
+        std::future<R> future = promise->get_future();
+        read_file(
+            path,
+            [promise, func = std::forward<F>(func)](std::vector<uint8_t> data, std::exception_ptr error)
+            {
+                if (error) {
+                    promise->set_exception(error);
+                    return;
+                }
+                // Thread pool tasks need to be copyable, share the data instead of copying it.
+                auto shared_data = std::make_shared<std::vector<uint8_t>>(std::move(data));
+                thread::do_async(
+                    [promise, func, shared_data]()
+                    {
+                        try {
+                            if constexpr (std::is_void_v<R>) {
+                                func(std::move(*shared_data));
+                                promise->set_value();
+                            } else {
+                                promise->set_value(func(std::move(*shared_data)));
+                            }
+                        } catch (...) {
+                            promise->set_exception(std::current_exception());
+                        }
+                    }
+                );
+            }
+        );
+        return future;
+    }
+
+} // namespace async_io
+
+} // namespace sgl
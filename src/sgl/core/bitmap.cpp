@@ -48,9 +48,11 @@ derivative works thereof, in binary and source code form.
 
 #include "sgl/core/config.h"
 #include "sgl/core/macros.h"
+#include "sgl/core/async_io.h"
 #include "sgl/core/error.h"
 #include "sgl/core/logger.h"
 #include "sgl/core/file_stream.h"
+#include "sgl/core/memory_stream.h"
 #include "sgl/core/string.h"
 #include "sgl/core/thread.h"
 #include "sgl/core/type_utils.h"
@@ -106,13 +108,177 @@ SGL_DIAGNOSTIC_POP
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
 #include <map>
 #include <mutex>
+#include <optional>
+#include <string_view>
 
 SGL_DISABLE_MSVC_WARNING(4611)
 
 namespace sgl {
 
+// ----------------------------------------------------------------------------
+// Geometric transforms
+// ----------------------------------------------------------------------------
+
+/// Tile size (in pixels) of cache-blocked transforms.
+static constexpr uint32_t TRANSFORM_TILE_SIZE = 64;
+
+/// Minimum number of pixels to process on the thread pool.
+static constexpr size_t PARALLEL_PIXEL_COUNT = 256 * 256;
+
+/// Run \c func(begin, end) over the range [0, count), on the global thread pool if \c pixel_count is large enough.
+template<typename F>
+static void parallel_for(size_t count, size_t pixel_count, F&& func)
+{
+    if (pixel_count < PARALLEL_PIXEL_COUNT)
+        func(size_t(0), count);
+    else
+        thread::parallel_for(size_t(0), count, func);
+}
+
+template<size_t N>
+struct PixelBytes {
+    uint8_t bytes[N];
+};
+
+/// Copies pixels of type \c P (or of runtime size if \c P is void).
+template<typename P>
+struct PixelCopy {
+    size_t size;
+
+    void operator()(uint8_t* dst, size_t dst_index, const uint8_t* src, size_t src_index) const
+    {
+        if constexpr (std::is_void_v<P>)
+            std::memcpy(dst + dst_index * size, src + src_index * size, size);
+        else
+            reinterpret_cast<P*>(dst)[dst_index] = reinterpret_cast<const P*>(src)[src_index];
+    }
+
+    void reverse(uint8_t* data, size_t count) const
+    {
+        if constexpr (std::is_void_v<P>) {
+            uint8_t* temp = reinterpret_cast<uint8_t*>(alloca(size));
+            for (size_t i = 0, j = count - 1; i < count / 2; ++i, --j) {
+                std::memcpy(temp, data + i * size, size);
+                std::memcpy(data + i * size, data + j * size, size);
+                std::memcpy(data + j * size, temp, size);
+            }
+        } else {
+            std::reverse(reinterpret_cast<P*>(data), reinterpret_cast<P*>(data) + count);
+        }
+    }
+};
+
+/// Call \c func with a pixel copy functor specialized for common pixel sizes.
+template<typename F>
+static void dispatch_pixel_copy(size_t size, F&& func)
+{
+    switch (size) {
+    case 1:
+        return func(PixelCopy<PixelBytes<1>>{size});
+    case 2:
+        return func(PixelCopy<PixelBytes<2>>{size});
+    case 3:
+        return func(PixelCopy<PixelBytes<3>>{size});
+    case 4:
+        return func(PixelCopy<PixelBytes<4>>{size});
+    case 6:
+        return func(PixelCopy<PixelBytes<6>>{size});
+    case 8:
+        return func(PixelCopy<PixelBytes<8>>{size});
+    case 12:
+        return func(PixelCopy<PixelBytes<12>>{size});
+    case 16:
+        return func(PixelCopy<PixelBytes<16>>{size});
+    default:
+        return func(PixelCopy<void>{size});
+    }
+}
+
+/// Create a bitmap with the same pixel layout as \c bitmap.
+static ref<Bitmap> create_bitmap_like(const Bitmap* bitmap, uint32_t width, uint32_t height)
+{
+    bool multi_channel = bitmap->pixel_format() == Bitmap::PixelFormat::multi_channel;
+    ref<Bitmap> result = make_ref<Bitmap>(
+        bitmap->pixel_format(),
+        bitmap->component_type(),
+        width,
+        height,
+        multi_channel ? bitmap->channel_count() : 0,
+        multi_channel ? bitmap->channel_names() : std::vector<std::string>{}
+    );
+    result->set_srgb_gamma(bitmap->srgb_gamma());
+    return result;
+}
+
+enum class TransformOp {
+    transpose,
+    rotate90,
+    rotate270,
+};
+
+/// Transpose/rotate a bitmap, processing the destination in tiles so that the source column accesses stay in cache.
+template<TransformOp Op>
+static ref<Bitmap> transform_blocked(const Bitmap* bitmap)
+{
+    const uint32_t src_width = bitmap->width();
+    const uint32_t src_height = bitmap->height();
+    const uint32_t dst_width = src_height;
+    const uint32_t dst_height = src_width;
+
+    ref<Bitmap> result = create_bitmap_like(bitmap, dst_width, dst_height);
+    const uint8_t* src = bitmap->uint8_data();
+    uint8_t* dst = result->uint8_data();
+    size_t tile_rows = (dst_height + TRANSFORM_TILE_SIZE - 1) / TRANSFORM_TILE_SIZE;
+
+    dispatch_pixel_copy(
+        bitmap->bytes_per_pixel(),
+        [&](const auto& copy)
+        {
+            parallel_for(
+                tile_rows,
+                bitmap->pixel_count(),
+                [&](size_t begin, size_t end)
+                {
+                    for (size_t tile_row = begin; tile_row < end; ++tile_row) {
+                        uint32_t y0 = uint32_t(tile_row) * TRANSFORM_TILE_SIZE;
+                        uint32_t y1 = std::min(y0 + TRANSFORM_TILE_SIZE, dst_height);
+                        for (uint32_t x0 = 0; x0 < dst_width; x0 += TRANSFORM_TILE_SIZE) {
+                            uint32_t x1 = std::min(x0 + TRANSFORM_TILE_SIZE, dst_width);
+                            for (uint32_t y = y0; y < y1; ++y) {
+                                for (uint32_t x = x0; x < x1; ++x) {
+                                    uint32_t src_x, src_y;
+                                    if constexpr (Op == TransformOp::transpose) {
+                                        src_x = y;
+                                        src_y = x;
+                                    } else if constexpr (Op == TransformOp::rotate90) {
+                                        src_x = y;
+                                        src_y = src_height - 1 - x;
+                                    } else {
+                                        src_x = src_width - 1 - y;
+                                        src_y = x;
+                                    }
+                                    copy(dst, size_t(y) * dst_width + x, src, size_t(src_y) * src_width + src_x);
+                                }
+                            }
+                        }
+                    }
+                }
+            );
+        }
+    );
+
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Bitmap
+// ----------------------------------------------------------------------------
+
 Bitmap::Bitmap(
     PixelFormat pixel_format,
     ComponentType component_type,
@@ -127,7 +293,6 @@ Bitmap::Bitmap(
     , m_width(width)
     , m_height(height)
     , m_data(reinterpret_cast<uint8_t*>(data))
-    , m_owns_data(false)
 {
     SGL_CHECK(
         pixel_format != PixelFormat::multi_channel || channel_count > 0,
@@ -139,22 +304,21 @@ Bitmap::Bitmap(
 
     rebuild_pixel_struct(channel_count, channel_names);
 
-    if (!m_data) {
-        m_data = std::make_unique<uint8_t[]>(buffer_size());
-        m_owns_data = true;
-    }
+    if (!m_data)
+        allocate_data();
 }
 
 Bitmap::Bitmap(const Bitmap& other)
-    : m_pixel_format(other.m_pixel_format)
+    : Object()
+    , m_pixel_format(other.m_pixel_format)
     , m_component_type(other.m_component_type)
     , m_pixel_struct(new Struct(*other.m_pixel_struct))
     , m_width(other.m_width)
     , m_height(other.m_height)
     , m_srgb_gamma(other.m_srgb_gamma)
-    , m_data(new uint8_t[other.buffer_size()])
 {
-    std::memcpy(m_data.get(), other.m_data.get(), other.buffer_size());
+    allocate_data();
+    std::memcpy(m_data, other.m_data, other.buffer_size());
 }
 
 Bitmap::Bitmap(Bitmap&& other)
@@ -164,7 +328,10 @@ Bitmap::Bitmap(Bitmap&& other)
     , m_width(std::exchange(other.m_width, 0))
     , m_height(std::exchange(other.m_height, 0))
     , m_srgb_gamma(std::exchange(other.m_srgb_gamma, false))
-    , m_data(std::move(other.m_data))
+    , m_data(std::exchange(other.m_data, nullptr))
+    , m_data_size(std::exchange(other.m_data_size, 0))
+    , m_memory_pool(std::exchange(other.m_memory_pool, nullptr))
+    , m_stb_data(std::exchange(other.m_stb_data, false))
 {
 }
 
@@ -181,29 +348,81 @@ Bitmap::Bitmap(const std::filesystem::path& path, FileFormat format)
 
 Bitmap::~Bitmap()
 {
-    if (!m_owns_data)
-        m_data.release();
+    release_data();
 }
 
 std::vector<ref<Bitmap>> Bitmap::read_multiple(std::span<std::filesystem::path> paths, FileFormat format)
 {
-    std::vector<std::future<ref<Bitmap>>> futures;
-    futures.reserve(paths.size());
-    for (const auto& path : paths)
-        futures.push_back(thread::do_async(
-            [](const std::filesystem::path& path, FileFormat format) { return make_ref<Bitmap>(path, format); },
+    // Files are read by the async I/O service and decoded on the global thread pool. Waiting for the
+    // I/O service does not occupy the pool, so this is safe to call from pool tasks.
+    std::vector<std::future<std::vector<uint8_t>>> files;
+    files.reserve(paths.size());
+    for (const auto& path : paths) {
+        auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
+        files.push_back(promise->get_future());
+        async_io::read_file(
             path,
-            format
-        ));
-    std::vector<ref<Bitmap>> bitmaps;
-    bitmaps.reserve(paths.size());
-    for (auto& future : futures) {
-        future.wait();
-        bitmaps.push_back(future.get());
+            [promise](std::vector<uint8_t> data, std::exception_ptr error)
+            {
+                if (error)
+                    promise->set_exception(error);
+                else
+                    promise->set_value(std::move(data));
+            }
+        );
     }
+    std::vector<ref<Bitmap>> bitmaps(paths.size());
+    thread::parallel_for(
+        size_t(0),
+        paths.size(),
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i) {
+                std::vector<uint8_t> data = files[i].get();
+                MemoryStream stream(data.data(), data.size());
+                bitmaps[i] = make_ref<Bitmap>(&stream, format);
+            }
+        },
+        paths.size()
+    );
     return bitmaps;
 }
 
+std::vector<Bitmap::Info> Bitmap::probe_multiple(std::span<std::filesystem::path> paths, FileFormat format)
+{
+    std::vector<Info> infos(paths.size());
+    thread::parallel_for(
+        size_t(0),
+        paths.size(),
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+                infos[i] = Bitmap::probe(paths[i], format);
+        },
+        paths.size()
+    );
+    return infos;
+}
+
+static Bitmap::FileFormat file_format_from_extension(const std::filesystem::path& path)
+{
+    std::string extension = string::to_lower(path.extension().string());
+    if (extension == ".png")
+        return Bitmap::FileFormat::png;
+    else if (extension == ".jpg" || extension == ".jpeg")
+        return Bitmap::FileFormat::jpg;
+    else if (extension == ".bmp")
+        return Bitmap::FileFormat::bmp;
+    else if (extension == ".tga")
+        return Bitmap::FileFormat::tga;
+    else if (extension == ".hdr" || extension == ".rgbe")
+        return Bitmap::FileFormat::hdr;
+    else if (extension == ".exr")
+        return Bitmap::FileFormat::exr;
+    else
+        SGL_THROW("Unsupported image file extension \"%s\"", extension);
+}
+
 void Bitmap::write(Stream* stream, FileFormat format, int quality) const
 {
     SGL_UNUSED(quality);
@@ -212,21 +431,7 @@ void Bitmap::write(Stream* stream, FileFormat format, int quality) const
 
     if (format == FileFormat::auto_) {
         SGL_CHECK(fs, "Unable to determine image file format without a filename.");
-        std::string extension = string::to_lower(fs->path().extension().string());
-        if (extension == ".png")
-            format = FileFormat::png;
-        else if (extension == ".jpg" || extension == ".jpeg")
-            format = FileFormat::jpg;
-        else if (extension == ".bmp")
-            format = FileFormat::bmp;
-        else if (extension == ".tga")
-            format = FileFormat::tga;
-        else if (extension == ".hdr" || extension == ".rgbe")
-            format = FileFormat::hdr;
-        else if (extension == ".exr")
-            format = FileFormat::exr;
-        else
-            SGL_THROW("Unsupported image file extension \"%s\"", extension);
+        format = file_format_from_extension(fs->path());
     }
 
     log_debug(
@@ -275,12 +480,35 @@ void Bitmap::write(const std::filesystem::path& path, FileFormat format, int qua
 
 void Bitmap::write_async(const std::filesystem::path& path, FileFormat format, int quality) const
 {
+    if (format == FileFormat::auto_)
+        format = file_format_from_extension(path);
+
     // Increment reference count to ensure that the bitmap is not destroyed before written.
+    // The image is encoded on the I/O thread pool and written by the async I/O service.
     this->inc_ref();
-    thread::do_async(
+    thread::do_async_io(
         [=, this]()
         {
-            this->write(path, format, quality);
+            try {
+                MemoryStream stream;
+                this->write(&stream, format, quality);
+                async_io::write_file(
+                    path,
+                    std::vector<uint8_t>(stream.data(), stream.data() + stream.size()),
+                    [path](std::exception_ptr error)
+                    {
+                        if (!error)
+                            return;
+                        try {
+                            std::rethrow_exception(error);
+                        } catch (const std::exception& e) {
+                            log_error("Failed to write bitmap to \"{}\": {}", path, e.what());
+                        }
+                    }
+                );
+            } catch (const std::exception& e) {
+                log_error("Failed to write bitmap to \"{}\": {}", path, e.what());
+            }
             this->dec_ref();
         }
     );
@@ -312,7 +540,7 @@ void Bitmap::set_srgb_gamma(bool srgb_gamma)
 
 void Bitmap::clear()
 {
-    std::memset(m_data.get(), 0, buffer_size());
+    std::memset(m_data, 0, buffer_size());
 }
 
 void Bitmap::vflip()
@@ -329,11 +557,121 @@ void Bitmap::vflip()
     }
 }
 
+void Bitmap::hflip()
+{
+    uint8_t* data = uint8_data();
+    size_t row_size = m_width * bytes_per_pixel();
+    dispatch_pixel_copy(
+        bytes_per_pixel(),
+        [&](const auto& copy)
+        {
+            parallel_for(
+                m_height,
+                pixel_count(),
+                [&](size_t begin, size_t end)
+                {
+                    for (size_t y = begin; y < end; ++y)
+                        copy.reverse(data + y * row_size, m_width);
+                }
+            );
+        }
+    );
+}
+
+ref<Bitmap> Bitmap::transpose() const
+{
+    return transform_blocked<TransformOp::transpose>(this);
+}
+
+ref<Bitmap> Bitmap::rotate90() const
+{
+    return transform_blocked<TransformOp::rotate90>(this);
+}
+
+ref<Bitmap> Bitmap::rotate180() const
+{
+    ref<Bitmap> result = create_bitmap_like(this, m_width, m_height);
+    const uint8_t* src = uint8_data();
+    uint8_t* dst = result->uint8_data();
+    size_t row_size = m_width * bytes_per_pixel();
+    dispatch_pixel_copy(
+        bytes_per_pixel(),
+        [&](const auto& copy)
+        {
+            parallel_for(
+                m_height,
+                pixel_count(),
+                [&](size_t begin, size_t end)
+                {
+                    for (size_t y = begin; y < end; ++y) {
+                        uint8_t* dst_row = dst + y * row_size;
+                        std::memcpy(dst_row, src + (m_height - 1 - y) * row_size, row_size);
+                        copy.reverse(dst_row, m_width);
+                    }
+                }
+            );
+        }
+    );
+    return result;
+}
+
+ref<Bitmap> Bitmap::rotate270() const
+{
+    return transform_blocked<TransformOp::rotate270>(this);
+}
+
+ref<Bitmap> Bitmap::crop(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const
+{
+    return view(x, y, width, height).to_bitmap();
+}
+
+BitmapView Bitmap::view() const
+{
+    return BitmapView(ref(this), 0, 0, m_width, m_height);
+}
+
+BitmapView Bitmap::view(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const
+{
+    return BitmapView(ref(this), x, y, width, height);
+}
+
+std::vector<BitmapView>
+Bitmap::tiles(uint32_t tile_width, uint32_t tile_height, uint32_t step_x, uint32_t step_y, bool include_partial) const
+{
+    SGL_CHECK(tile_width > 0 && tile_height > 0, "Tile size must be greater than zero.");
+    step_x = step_x == 0 ? tile_width : step_x;
+    step_y = step_y == 0 ? tile_height : step_y;
+
+    std::vector<BitmapView> result;
+    ref<const Bitmap> self(this);
+    for (uint32_t y = 0; y < m_height; y += step_y) {
+        if (!include_partial && y + tile_height > m_height)
+            break;
+        for (uint32_t x = 0; x < m_width; x += step_x) {
+            if (!include_partial && x + tile_width > m_width)
+                break;
+            result.emplace_back(self, x, y, std::min(tile_width, m_width - x), std::min(tile_height, m_height - y));
+        }
+    }
+    return result;
+}
+
 std::vector<std::pair<std::string, ref<Bitmap>>> Bitmap::split() const
 {
     if (m_pixel_format != PixelFormat::multi_channel)
         return {{"", ref(const_cast<Bitmap*>(this))}};
 
+    std::vector<std::pair<std::string, ref<Bitmap>>> result;
+    for (const auto& [prefix, view] : split_views())
+        result.push_back({prefix, view.to_bitmap()});
+    return result;
+}
+
+std::vector<std::pair<std::string, BitmapView>> Bitmap::split_views() const
+{
+    if (m_pixel_format != PixelFormat::multi_channel)
+        return {{"", view()}};
+
     // Split fields by prefix.
     std::multimap<std::string, std::pair<std::string, Struct::Field*>> split_fields;
     for (Struct::Field& field : *m_pixel_struct) {
@@ -349,7 +687,7 @@ std::vector<std::pair<std::string, ref<Bitmap>>> Bitmap::split() const
         split_fields.emplace(prefix, std::make_pair(suffix, &field));
     }
 
-    std::vector<std::pair<std::string, ref<Bitmap>>> result;
+    std::vector<std::pair<std::string, BitmapView>> result;
 
     for (auto it = split_fields.begin(); it != split_fields.end();) {
         std::string prefix = it->first;
@@ -379,33 +717,29 @@ std::vector<std::pair<std::string, ref<Bitmap>>> Bitmap::split() const
         else if (field_format == "r|g|b|a")
             pixel_format = PixelFormat::rgba;
 
-        ref<Bitmap> target;
-        if (pixel_format == PixelFormat::multi_channel) {
-            target = ref(new Bitmap(
-                pixel_format,
-                m_component_type,
-                m_width,
-                m_height,
-                narrow_cast<uint32_t>(field_names.size()),
-                field_names
-            ));
-        } else {
-            target = ref(new Bitmap(pixel_format, m_component_type, m_width, m_height));
-        }
-
-        target->set_srgb_gamma(m_srgb_gamma);
+        if (pixel_format != PixelFormat::multi_channel)
+            field_names.clear();
 
-        ref<Struct> target_struct = ref(new Struct(*target->pixel_struct()));
+        // Target pixel struct with fields named after the source fields.
+        ref<Struct> target_struct = create_pixel_struct(
+            pixel_format,
+            m_component_type,
+            m_srgb_gamma,
+            narrow_cast<uint32_t>(field_names.size()),
+            field_names
+        );
         for (auto it2 = range.first; it2 != range.second; ++it2) {
             std::string field_name
                 = pixel_format == PixelFormat::multi_channel ? it2->second.first : string::to_upper(it2->second.first);
             target_struct->field(field_name).name = it2->second.second->name;
         }
 
-        StructConverter converter(m_pixel_struct, target_struct);
-        converter.convert(data(), target->data(), pixel_count());
+        BitmapView split_view = view();
+        split_view.m_pixel_format = pixel_format;
+        split_view.m_channel_struct = target_struct;
+        split_view.m_channel_names = std::move(field_names);
 
-        result.push_back({prefix, target});
+        result.push_back({prefix, std::move(split_view)});
         it = range.second;
     }
 
@@ -491,7 +825,7 @@ bool Bitmap::operator==(const Bitmap& other) const
 {
     return m_pixel_format == other.m_pixel_format && m_component_type == other.m_component_type
         && *m_pixel_struct == *other.m_pixel_struct && m_width == other.m_width && m_height == other.m_height
-        && m_srgb_gamma == other.m_srgb_gamma && std::memcmp(m_data.get(), other.m_data.get(), buffer_size()) == 0;
+        && m_srgb_gamma == other.m_srgb_gamma && std::memcmp(m_data, other.m_data, buffer_size()) == 0;
 }
 
 std::string Bitmap::to_string() const
@@ -559,17 +893,68 @@ Bitmap::FileFormat Bitmap::detect_file_format(Stream* stream)
     return format;
 }
 
+static ref<MemoryPool> s_memory_pool;
+static std::mutex s_memory_pool_mutex;
+
+ref<MemoryPool> Bitmap::memory_pool()
+{
+    std::lock_guard lock(s_memory_pool_mutex);
+    if (!s_memory_pool)
+        s_memory_pool = make_ref<MemoryPool>();
+    return s_memory_pool;
+}
+
+void Bitmap::set_memory_pool(ref<MemoryPool> memory_pool)
+{
+    std::lock_guard lock(s_memory_pool_mutex);
+    s_memory_pool = std::move(memory_pool);
+}
+
 void Bitmap::static_init()
 {
     // IlmThread::ThreadPool::globalThreadPool().setThreadProvider(new EXRThreadPool());
 }
 
-void Bitmap::static_shutdown() { }
+void Bitmap::static_shutdown()
+{
+    set_memory_pool(nullptr);
+}
+
+void Bitmap::allocate_data()
+{
+    release_data();
+    m_memory_pool = memory_pool();
+    m_data_size = buffer_size();
+    m_data = static_cast<uint8_t*>(m_memory_pool->allocate(m_data_size));
+}
+
+void Bitmap::release_data()
+{
+    if (m_memory_pool)
+        m_memory_pool->release(m_data, m_data_size);
+    else if (m_stb_data)
+        stbi_image_free(m_data);
+    m_memory_pool = nullptr;
+    m_stb_data = false;
+    m_data = nullptr;
+    m_data_size = 0;
+}
 
 void Bitmap::rebuild_pixel_struct(uint32_t channel_count, const std::vector<std::string>& channel_names)
+{
+    m_pixel_struct = create_pixel_struct(m_pixel_format, m_component_type, m_srgb_gamma, channel_count, channel_names);
+}
+
+ref<Struct> Bitmap::create_pixel_struct(
+    PixelFormat pixel_format,
+    ComponentType component_type,
+    bool srgb_gamma,
+    uint32_t channel_count,
+    const std::vector<std::string>& channel_names
+)
 {
     std::vector<std::string> channels;
-    switch (m_pixel_format) {
+    switch (pixel_format) {
     case PixelFormat::y:
         channels = {"Y"};
         break;
@@ -604,16 +989,17 @@ void Bitmap::rebuild_pixel_struct(uint32_t channel_count, const std::vector<std:
         break;
     }
 
-    m_pixel_struct = make_ref<Struct>();
+    ref<Struct> pixel_struct = make_ref<Struct>();
     for (const auto& channel : channels) {
-        bool is_alpha = m_pixel_format != PixelFormat::multi_channel && channel == "A";
+        bool is_alpha = pixel_format != PixelFormat::multi_channel && channel == "A";
         Struct::Flags flags = Struct::Flags::none;
-        if (Struct::is_integer(m_component_type) && Struct::type_size(m_component_type) <= 2)
+        if (Struct::is_integer(component_type) && Struct::type_size(component_type) <= 2)
             flags |= Struct::Flags::normalized;
-        if (m_srgb_gamma && !is_alpha)
+        if (srgb_gamma && !is_alpha)
             flags |= Struct::Flags::srgb_gamma;
-        m_pixel_struct->append(channel, m_component_type, flags);
+        pixel_struct->append(channel, component_type, flags);
     }
+    return pixel_struct;
 }
 
 void Bitmap::read(Stream* stream, FileFormat format)
@@ -718,6 +1104,326 @@ struct StreamReader {
     }
 };
 
+static Bitmap::PixelFormat pixel_format_from_channel_count(uint32_t channel_count)
+{
+    switch (channel_count) {
+    case 1:
+        return Bitmap::PixelFormat::y;
+    case 2:
+        return Bitmap::PixelFormat::ya;
+    case 3:
+        return Bitmap::PixelFormat::rgb;
+    case 4:
+        return Bitmap::PixelFormat::rgba;
+    default:
+        SGL_THROW("Unsupported number of channels {}!", channel_count);
+    }
+}
+
+static uint32_t read_be32(const uint8_t* data)
+{
+    return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | uint32_t(data[3]);
+}
+
+static uint16_t read_le16(const uint8_t* data)
+{
+    return uint16_t(data[0] | (data[1] << 8));
+}
+
+static uint32_t read_le32(const uint8_t* data)
+{
+    return uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+}
+
+/// Probe a file using stb_image. This only reads the header, which matches what \c read_stb() reports.
+static Bitmap::Info probe_stb(Stream* stream, const char* format, bool is_srgb, bool is_hdr)
+{
+    StreamReader reader(stream);
+
+    int w, h, c;
+    if (!stbi_info_from_callbacks(&reader.callbacks, &reader, &w, &h, &c))
+        SGL_THROW("Failed to read {} file header!", format);
+    reader.reset();
+
+    return {
+        .pixel_format = pixel_format_from_channel_count(c),
+        .component_type = is_hdr ? Bitmap::ComponentType::float32 : Bitmap::ComponentType::uint8,
+        .width = uint32_t(w),
+        .height = uint32_t(h),
+        .channel_count = uint32_t(c),
+        .srgb_gamma = is_srgb,
+    };
+}
+
+#if SGL_HAS_LIBPNG
+/// Probe a PNG file by parsing the IHDR chunk and scanning the chunks preceding the image data
+/// for transparency information. Mirrors the transformations applied in \c Bitmap::read_png().
+static Bitmap::Info probe_png(Stream* stream)
+{
+    size_t pos = stream->tell();
+
+    // Signature (8 bytes), chunk length and type (8 bytes), IHDR data (13 bytes), CRC (4 bytes).
+    static const uint8_t PNG_SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    uint8_t header[33];
+    stream->read(header, sizeof(header));
+    if (std::memcmp(header, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) != 0 || std::memcmp(header + 12, "IHDR", 4) != 0)
+        SGL_THROW("Failed to read PNG file header!");
+
+    uint32_t width = read_be32(header + 16);
+    uint32_t height = read_be32(header + 20);
+    uint8_t bit_depth = header[24];
+    uint8_t color_type = header[25];
+
+    bool has_transparency = false;
+    while (true) {
+        uint8_t chunk[8];
+        stream->read(chunk, sizeof(chunk));
+        if (std::memcmp(chunk + 4, "tRNS", 4) == 0)
+            has_transparency = true;
+        if (has_transparency || std::memcmp(chunk + 4, "IDAT", 4) == 0 || std::memcmp(chunk + 4, "IEND", 4) == 0)
+            break;
+        stream->seek(stream->tell() + read_be32(chunk) + 4);
+    }
+
+    stream->seek(pos);
+
+    uint32_t channel_count;
+    switch (color_type) {
+    case PNG_COLOR_TYPE_GRAY:
+        channel_count = 1;
+        break;
+    case PNG_COLOR_TYPE_GRAY_ALPHA:
+        channel_count = 2;
+        break;
+    case PNG_COLOR_TYPE_RGB:
+    case PNG_COLOR_TYPE_PALETTE:
+        channel_count = 3;
+        break;
+    case PNG_COLOR_TYPE_RGB_ALPHA:
+        channel_count = 4;
+        break;
+    default:
+        SGL_THROW("Unknown color type {}!", color_type);
+    }
+    if (has_transparency && (color_type & PNG_COLOR_MASK_ALPHA) == 0)
+        channel_count += 1;
+
+    return {
+        .pixel_format = pixel_format_from_channel_count(channel_count),
+        .component_type = bit_depth == 16 ? Bitmap::ComponentType::uint16 : Bitmap::ComponentType::uint8,
+        .width = width,
+        .height = height,
+        .channel_count = channel_count,
+        .srgb_gamma = true,
+    };
+}
+#else
+static Bitmap::Info probe_png(Stream* stream)
+{
+    return probe_stb(stream, "PNG", true, false);
+}
+#endif
+
+/// Probe an OpenEXR file by parsing the "channels" and "dataWindow" attributes of the (first) header.
+/// Detects pixel formats in the same way as \c Bitmap::read_exr().
+static Bitmap::Info probe_exr(Stream* stream)
+{
+    size_t pos = stream->tell();
+
+    uint32_t magic_and_version[2];
+    stream->read(magic_and_version, sizeof(magic_and_version));
+
+    auto read_string = [stream]()
+    {
+        std::string str;
+        char c;
+        while (true) {
+            stream->read(&c, 1);
+            if (c == '\0')
+                break;
+            str.push_back(c);
+            if (str.size() > 255)
+                SGL_THROW("Invalid OpenEXR header!");
+        }
+        return str;
+    };
+
+    // Each attribute is stored as name, type name, value size and value. The header ends with an empty name.
+    std::vector<std::pair<std::string, int32_t>> channels;
+    int32_t data_window[4];
+    bool has_data_window = false;
+    while (channels.empty() || !has_data_window) {
+        std::string name = read_string();
+        if (name.empty())
+            break;
+        std::string type = read_string();
+        int32_t size;
+        stream->read(&size, sizeof(size));
+        SGL_CHECK(size >= 0, "Invalid OpenEXR header!");
+        if (name == "channels" && type == "chlist") {
+            std::vector<char> value(size);
+            stream->read(value.data(), size);
+            // Each channel is stored as name, pixel type, linear flag, 3 reserved bytes, x/y sampling.
+            size_t offset = 0;
+            while (offset < value.size() && value[offset] != '\0') {
+                std::string channel_name(value.data() + offset, strnlen(value.data() + offset, value.size() - offset));
+                offset += channel_name.size() + 1;
+                SGL_CHECK(offset + 16 <= value.size(), "Invalid OpenEXR channel list!");
+                int32_t pixel_type;
+                std::memcpy(&pixel_type, value.data() + offset, sizeof(pixel_type));
+                offset += 16;
+                channels.emplace_back(std::move(channel_name), pixel_type);
+            }
+        } else if (name == "dataWindow" && type == "box2i") {
+            SGL_CHECK(size == sizeof(data_window), "Invalid OpenEXR data window!");
+            stream->read(data_window, sizeof(data_window));
+            has_data_window = true;
+        } else {
+            stream->seek(stream->tell() + size);
+        }
+    }
+
+    stream->seek(pos);
+
+    if (channels.empty() || !has_data_window)
+        SGL_THROW("Failed to read OpenEXR file header!");
+
+    Bitmap::Info info;
+    switch (channels[0].second) {
+    case 0:
+        info.component_type = Bitmap::ComponentType::uint32;
+        break;
+    case 1:
+        info.component_type = Bitmap::ComponentType::float16;
+        break;
+    case 2:
+        info.component_type = Bitmap::ComponentType::float32;
+        break;
+    default:
+        SGL_THROW("EXR image contains invalid component type (must be float16, float32 or uint32)");
+    }
+
+    enum { unknown, R, G, B, A, Y, RY, BY, CLASS_COUNT };
+    bool found[CLASS_COUNT] = {false};
+    for (const auto& [channel_name, pixel_type] : channels) {
+        std::string name = channel_name;
+        auto it = name.rfind(".");
+        if (it != std::string::npos)
+            name = name.substr(it + 1);
+        name = string::to_lower(name);
+        if (name == "r")
+            found[R] = true;
+        else if (name == "g")
+            found[G] = true;
+        else if (name == "b")
+            found[B] = true;
+        else if (name == "a")
+            found[A] = true;
+        else if (name == "y")
+            found[Y] = true;
+        else if (name == "ry")
+            found[RY] = true;
+        else if (name == "by")
+            found[BY] = true;
+    }
+
+    size_t channel_count = channels.size();
+    info.pixel_format = Bitmap::PixelFormat::multi_channel;
+    bool color = (found[R] && found[G] && found[B]) || (found[Y] && found[RY] && found[BY]);
+    if (channel_count == 3 && color)
+        info.pixel_format = Bitmap::PixelFormat::rgb;
+    else if (channel_count == 4 && color && found[A])
+        info.pixel_format = Bitmap::PixelFormat::rgba;
+    else if (channel_count == 1 && found[Y])
+        info.pixel_format = Bitmap::PixelFormat::y;
+    else if (channel_count == 2 && found[Y] && found[A])
+        info.pixel_format = Bitmap::PixelFormat::ya;
+
+    info.width = uint32_t(data_window[2] - data_window[0] + 1);
+    info.height = uint32_t(data_window[3] - data_window[1] + 1);
+    info.channel_count = uint32_t(channel_count);
+    info.srgb_gamma = false;
+    return info;
+}
+
+static Bitmap::Info probe_bmp(Stream* stream);
+static Bitmap::Info probe_tga(Stream* stream);
+static Bitmap::Info probe_hdr(Stream* stream);
+
+Bitmap::Info Bitmap::probe(Stream* stream, FileFormat format)
+{
+    if (format == FileFormat::auto_)
+        format = detect_file_format(stream);
+
+    Info info;
+    switch (format) {
+    case FileFormat::png:
+        info = probe_png(stream);
+        break;
+    case FileFormat::jpg:
+        info = probe_stb(stream, "JPEG", true, false);
+        break;
+    case FileFormat::bmp:
+        info = probe_bmp(stream);
+        break;
+    case FileFormat::tga:
+        info = probe_tga(stream);
+        break;
+    case FileFormat::hdr:
+        info = probe_hdr(stream);
+        break;
+    case FileFormat::exr:
+        info = probe_exr(stream);
+        break;
+    default:
+        SGL_THROW("Unknown file format!");
+    }
+    info.file_format = format;
+    return info;
+}
+
+Bitmap::Info Bitmap::probe(const std::filesystem::path& path, FileFormat format)
+{
+    FileStream stream(path, FileStream::Mode::read);
+    return probe(&stream, format);
+}
+
+std::string Bitmap::Info::to_string() const
+{
+    return fmt::format(
+        "Bitmap.Info(\n"
+        "  file_format = {},\n"
+        "  pixel_format = {},\n"
+        "  component_type = {},\n"
+        "  width = {},\n"
+        "  height = {},\n"
+        "  channel_count = {},\n"
+        "  srgb_gamma = {}\n"
+        ")",
+        file_format,
+        pixel_format,
+        component_type,
+        width,
+        height,
+        channel_count,
+        srgb_gamma
+    );
+}
+
+static void log_read(Stream* stream, const char* format, const Bitmap* bitmap)
+{
+    auto fs = dynamic_cast<FileStream*>(stream);
+    log_debug(
+        "Reading {} file \"{}\" ({}x{}, {}, {}) ...",
+        format,
+        fs ? fs->path().string() : "<stream>",
+        bitmap->width(),
+        bitmap->height(),
+        bitmap->pixel_format(),
+        bitmap->component_type()
+    );
+}
+
 void Bitmap::read_stb(Stream* stream, const char* format, bool is_srgb, bool is_hdr)
 {
     StreamReader reader(stream);
@@ -750,16 +1456,7 @@ void Bitmap::read_stb(Stream* stream, const char* format, bool is_srgb, bool is_
 
     rebuild_pixel_struct();
 
-    auto fs = dynamic_cast<FileStream*>(stream);
-    log_debug(
-        "Reading {} file \"{}\" ({}x{}, {}, {}) ...",
-        format,
-        fs ? fs->path().string() : "<stream>",
-        m_width,
-        m_height,
-        m_pixel_format,
-        m_component_type
-    );
+    log_read(stream, format, this);
 
     void* data = nullptr;
     switch (m_component_type) {
@@ -778,8 +1475,11 @@ void Bitmap::read_stb(Stream* stream, const char* format, bool is_srgb, bool is_
     SGL_ASSERT_EQ(m_width, static_cast<uint32_t>(w));
     SGL_ASSERT_EQ(m_height, static_cast<uint32_t>(h));
 
-    m_data = std::unique_ptr<uint8_t[]>(reinterpret_cast<uint8_t*>(data));
-    m_owns_data = true;
+    // Take ownership of the decoded image instead of copying it into pool allocated storage.
+    release_data();
+    m_data = static_cast<uint8_t*>(data);
+    m_data_size = buffer_size();
+    m_stb_data = true;
 }
 
 // ----------------------------------------------------------------------------
@@ -944,12 +1644,10 @@ void Bitmap::read_png(Stream* stream)
         m_component_type
     );
 
-    size_t size = buffer_size();
-    m_data = std::unique_ptr<uint8_t[]>(new uint8_t[size]);
-    m_owns_data = true;
+    allocate_data();
 
     size_t row_bytes = png_get_rowbytes(png_ptr, info_ptr);
-    SGL_ASSERT(row_bytes == size / m_height);
+    SGL_ASSERT(row_bytes == buffer_size() / m_height);
 
     png_bytepp rows = static_cast<png_bytepp>(alloca(sizeof(png_bytep) * m_height));
     for (size_t i = 0; i < m_height; i++)
@@ -1067,7 +1765,7 @@ void Bitmap::write_png(Stream* stream, int compression) const
 
     volatile png_bytepp rows = static_cast<png_bytepp>(alloca(sizeof(png_bytep) * m_height));
     for (size_t i = 0; i < m_height; i++)
-        rows[i] = &m_data[row_bytes * i];
+        rows[i] = m_data + row_bytes * i;
 
     png_write_image(png_ptr, rows);
     png_write_end(png_ptr, info_ptr);
@@ -1267,8 +1965,7 @@ void Bitmap::read_jpg(Stream* stream)
 
     size_t row_stride = static_cast<size_t>(cinfo.output_width) * static_cast<size_t>(cinfo.output_components);
 
-    m_data = std::unique_ptr<uint8_t[]>(new uint8_t[buffer_size()]);
-    m_owns_data = true;
+    allocate_data();
 
     JSAMPARRAY scanlines = reinterpret_cast<JSAMPARRAY>(alloca(sizeof(JSAMPROW) * m_height));
     for (size_t i = 0; i < m_height; ++i)
@@ -1340,7 +2037,7 @@ void Bitmap::write_jpg(Stream* stream, int quality) const
 
     // Write scanline by scanline
     for (size_t i = 0; i < m_height; ++i) {
-        const uint8_t* source = m_data.get() + i * m_width * cinfo.input_components;
+        const uint8_t* source = m_data + i * m_width * cinfo.input_components;
         jpeg_write_scanlines(&cinfo, const_cast<JSAMPARRAY>(&source), 1);
     }
 
@@ -1366,62 +2063,875 @@ void Bitmap::write_jpg(Stream* stream, int quality) const
 
 #endif // SGL_HAS_LIBJPEG
 
+// ----------------------------------------------------------------------------
+// Native codecs
+// ----------------------------------------------------------------------------
+
+// The common variants of BMP, TGA and HDR files are decoded and encoded natively. The file is
+// read into memory at once and scanlines are converted directly from/to the bitmap buffer on the
+// thread pool. Other variants fall back to stb_image.
+
+static void write_le16(uint8_t* data, uint16_t value)
+{
+    data[0] = uint8_t(value);
+    data[1] = uint8_t(value >> 8);
+}
+
+static void write_le32(uint8_t* data, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        data[i] = uint8_t(value >> (i * 8));
+}
+
+/// Stream contents read into memory.
+struct StreamData {
+    std::unique_ptr<uint8_t[]> data;
+    size_t size{0};
+};
+
+/// Read up to \c max_size bytes starting at the current stream position.
+/// If \c rewind is true, the stream position is restored afterwards.
+static StreamData read_stream_data(Stream* stream, size_t max_size = SIZE_MAX, bool rewind = false)
+{
+    size_t pos = stream->tell();
+    StreamData result;
+    result.size = std::min(stream->size() - pos, max_size);
+    result.data.reset(new uint8_t[result.size]);
+    stream->read(result.data.get(), result.size);
+    if (rewind)
+        stream->seek(pos);
+    return result;
+}
+
+/// Convert \c count pixels between RGB(A) and BGR(A) order.
+/// A single source channel is expanded to gray RGB, a missing source alpha channel is set to opaque.
+/// Source and destination may alias if they have the same number of channels.
+template<uint32_t SrcChannels, uint32_t DstChannels>
+static void swap_red_blue(const uint8_t* src, uint8_t* dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i, src += SrcChannels, dst += DstChannels) {
+        uint8_t c0 = src[0];
+        uint8_t c1 = SrcChannels >= 3 ? src[1] : c0;
+        uint8_t c2 = SrcChannels >= 3 ? src[2] : c0;
+        uint8_t c3 = SrcChannels == 4 ? src[3] : 255;
+        dst[0] = c2;
+        dst[1] = c1;
+        dst[2] = c0;
+        if constexpr (DstChannels == 4)
+            dst[3] = c3;
+    }
+}
+
+/// Number of rows encoded per task when writing files in parallel.
+static constexpr uint32_t ENCODE_ROWS_PER_CHUNK = 16;
+
+/**
+ * Encode rows in parallel and write them to \c stream in order.
+ * \c encode_row(y, out) encodes row \c y to \c out and returns the end of the written data.
+ * It may write at most \c max_row_size bytes.
+ */
+template<typename F>
+static void write_encoded_rows(Stream* stream, uint32_t height, size_t pixel_count, size_t max_row_size, F&& encode_row)
+{
+    size_t chunk_count = (height + ENCODE_ROWS_PER_CHUNK - 1) / ENCODE_ROWS_PER_CHUNK;
+    std::vector<std::vector<uint8_t>> chunks(chunk_count);
+    parallel_for(
+        chunk_count,
+        pixel_count,
+        [&](size_t begin, size_t end)
+        {
+            std::unique_ptr<uint8_t[]> scratch(new uint8_t[max_row_size * ENCODE_ROWS_PER_CHUNK]);
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                uint32_t y_begin = uint32_t(chunk * ENCODE_ROWS_PER_CHUNK);
+                uint32_t y_end = std::min(y_begin + ENCODE_ROWS_PER_CHUNK, height);
+                uint8_t* out = scratch.get();
+                for (uint32_t y = y_begin; y < y_end; ++y)
+                    out = encode_row(y, out);
+                chunks[chunk].assign(scratch.get(), out);
+            }
+        }
+    );
+    for (const auto& chunk : chunks)
+        stream->write(chunk.data(), chunk.size());
+}
+
 // ----------------------------------------------------------------------------
 // BMP I/O
 // ----------------------------------------------------------------------------
 
+/// Size of the file header and the largest info header (BITMAPV5HEADER).
+static constexpr size_t BMP_MAX_HEADER_SIZE = 14 + 124;
+
+struct BMPHeader {
+    uint32_t width{0};
+    uint32_t height{0};
+    bool top_down{false};
+    /// Bytes per pixel in the file (3 or 4).
+    uint32_t bytes_per_pixel{0};
+    /// Number of decoded channels (3 or 4).
+    uint32_t channel_count{0};
+    /// True if an all-zero alpha channel is treated as opaque (32-bit files without bit fields).
+    bool implicit_alpha{false};
+    size_t data_offset{0};
+
+    size_t row_pitch() const { return (size_t(width) * bytes_per_pixel + 3) & ~size_t(3); }
+
+    Bitmap::Info info() const
+    {
+        return {
+            .pixel_format = channel_count == 4 ? Bitmap::PixelFormat::rgba : Bitmap::PixelFormat::rgb,
+            .component_type = Bitmap::ComponentType::uint8,
+            .width = width,
+            .height = height,
+            .channel_count = channel_count,
+            .srgb_gamma = true,
+        };
+    }
+};
+
+/// Parse a BMP header. Returns \c std::nullopt for variants without a native decoder
+/// (palettized, 16-bit, RLE or non-standard bit fields). Decodes to the same layout as stb_image.
+static std::optional<BMPHeader> parse_bmp_header(const uint8_t* data, size_t size)
+{
+    if (size < 14 + 40 || data[0] != 'B' || data[1] != 'M')
+        return {};
+    uint32_t header_size = read_le32(data + 14);
+    if (header_size != 40 && header_size != 108 && header_size != 124)
+        return {};
+    int32_t width = int32_t(read_le32(data + 18));
+    int32_t height = int32_t(read_le32(data + 22));
+    uint16_t planes = read_le16(data + 26);
+    uint16_t bits_per_pixel = read_le16(data + 28);
+    uint32_t compression = read_le32(data + 30);
+    if (width <= 0 || height == 0 || height == INT32_MIN || planes != 1)
+        return {};
+
+    BMPHeader header{
+        .width = uint32_t(width),
+        .height = uint32_t(std::abs(height)),
+        .top_down = height < 0,
+        .data_offset = read_le32(data + 10),
+    };
+    size_t masks_end = 14 + header_size;
+    if (bits_per_pixel == 24 && compression == 0) {
+        header.bytes_per_pixel = 3;
+        header.channel_count = 3;
+    } else if (bits_per_pixel == 32 && compression == 0) {
+        header.bytes_per_pixel = 4;
+        header.channel_count = 4;
+        header.implicit_alpha = true;
+    } else if (bits_per_pixel == 32 && compression == 3) {
+        // Bit fields follow the BITMAPINFOHEADER (without alpha) or are part of the V4/V5 header.
+        if (header_size == 40)
+            masks_end += 12;
+        if (size < masks_end)
+            return {};
+        uint32_t alpha_mask = header_size == 40 ? 0 : read_le32(data + 66);
+        if (read_le32(data + 54) != 0xff0000 || read_le32(data + 58) != 0xff00 || read_le32(data + 62) != 0xff
+            || (alpha_mask != 0 && alpha_mask != 0xff000000))
+            return {};
+        header.bytes_per_pixel = 4;
+        header.channel_count = alpha_mask ? 4 : 3;
+    } else {
+        return {};
+    }
+    if (header.data_offset < masks_end)
+        return {};
+    return header;
+}
+
+static Bitmap::Info probe_bmp(Stream* stream)
+{
+    StreamData header_data = read_stream_data(stream, BMP_MAX_HEADER_SIZE, true);
+    if (auto header = parse_bmp_header(header_data.data.get(), header_data.size))
+        return header->info();
+    return probe_stb(stream, "BMP", true, false);
+}
+
 void Bitmap::read_bmp(Stream* stream)
 {
-    read_stb(stream, "BMP", true, false);
+    size_t pos = stream->tell();
+    StreamData file = read_stream_data(stream);
+    std::optional<BMPHeader> header = parse_bmp_header(file.data.get(), file.size);
+    if (!header) {
+        stream->seek(pos);
+        read_stb(stream, "BMP", true, false);
+        return;
+    }
+    size_t row_pitch = header->row_pitch();
+    if (header->data_offset + row_pitch * header->height > file.size)
+        SGL_THROW("Failed to read BMP file!");
+
+    Info info = header->info();
+    m_width = info.width;
+    m_height = info.height;
+    m_pixel_format = info.pixel_format;
+    m_component_type = info.component_type;
+    m_srgb_gamma = info.srgb_gamma;
+    rebuild_pixel_struct();
+    log_read(stream, "BMP", this);
+    allocate_data();
+
+    const uint8_t* src = file.data.get() + header->data_offset;
+    uint8_t* dst = uint8_data();
+    size_t dst_row_size = size_t(m_width) * header->channel_count;
+    std::atomic<uint32_t> alpha_bits{0};
+    parallel_for(
+        m_height,
+        pixel_count(),
+        [&](size_t begin, size_t end)
+        {
+            uint32_t alpha = 0;
+            for (size_t y = begin; y < end; ++y) {
+                const uint8_t* src_row = src + (header->top_down ? y : m_height - 1 - y) * row_pitch;
+                uint8_t* dst_row = dst + y * dst_row_size;
+                if (header->bytes_per_pixel == 3) {
+                    swap_red_blue<3, 3>(src_row, dst_row, m_width);
+                } else if (header->channel_count == 3) {
+                    swap_red_blue<4, 3>(src_row, dst_row, m_width);
+                } else {
+                    swap_red_blue<4, 4>(src_row, dst_row, m_width);
+                    if (header->implicit_alpha) {
+                        for (size_t x = 0; x < m_width; ++x)
+                            alpha |= dst_row[x * 4 + 3];
+                    }
+                }
+            }
+            alpha_bits |= alpha;
+        }
+    );
+
+    // 32-bit files without bit fields often leave the alpha channel zero, treat them as opaque.
+    if (header->implicit_alpha && alpha_bits == 0) {
+        for (size_t i = 3; i < buffer_size(); i += 4)
+            dst[i] = 255;
+    }
 }
 
 void Bitmap::write_bmp(Stream* stream) const
 {
     check_required_format("BMP", {PixelFormat::y, PixelFormat::rgb, PixelFormat::rgba}, {ComponentType::uint8});
 
-    if (!stbi_write_bmp_to_func(&stbi_write_func, stream, m_width, m_height, int(channel_count()), data()))
-        SGL_THROW("Failed to write BMP file!");
+    // RGBA is written as 32-bit with a BITMAPV4HEADER and bit fields, everything else as 24-bit RGB.
+    bool has_alpha = m_pixel_format == PixelFormat::rgba;
+    uint32_t bytes_per_pixel = has_alpha ? 4 : 3;
+    uint32_t header_size = has_alpha ? 108 : 40;
+    size_t row_pitch = (size_t(m_width) * bytes_per_pixel + 3) & ~size_t(3);
+    size_t data_offset = 14 + header_size;
+    size_t file_size = data_offset + row_pitch * m_height;
+    SGL_CHECK(file_size <= UINT32_MAX, "Bitmap is too large for a BMP file.");
+
+    std::unique_ptr<uint8_t[]> file(new uint8_t[file_size]);
+    uint8_t* header = file.get();
+    std::memset(header, 0, data_offset);
+    header[0] = 'B';
+    header[1] = 'M';
+    write_le32(header + 2, uint32_t(file_size));
+    write_le32(header + 10, uint32_t(data_offset));
+    write_le32(header + 14, header_size);
+    write_le32(header + 18, m_width);
+    write_le32(header + 22, m_height);
+    write_le16(header + 26, 1);
+    write_le16(header + 28, uint16_t(bytes_per_pixel * 8));
+    write_le32(header + 34, uint32_t(row_pitch * m_height));
+    if (has_alpha) {
+        write_le32(header + 30, 3); // BI_BITFIELDS
+        write_le32(header + 54, 0xff0000);
+        write_le32(header + 58, 0xff00);
+        write_le32(header + 62, 0xff);
+        write_le32(header + 66, 0xff000000);
+        write_le32(header + 70, 0x73524742); // LCS_sRGB
+    }
+
+    // Rows are stored bottom-up.
+    const uint8_t* src = uint8_data();
+    uint8_t* dst = file.get() + data_offset;
+    uint32_t channel_count = this->channel_count();
+    parallel_for(
+        m_height,
+        pixel_count(),
+        [&](size_t begin, size_t end)
+        {
+            for (size_t y = begin; y < end; ++y) {
+                const uint8_t* src_row = src + y * m_width * channel_count;
+                uint8_t* dst_row = dst + (m_height - 1 - y) * row_pitch;
+                if (channel_count == 1)
+                    swap_red_blue<1, 3>(src_row, dst_row, m_width);
+                else if (channel_count == 3)
+                    swap_red_blue<3, 3>(src_row, dst_row, m_width);
+                else
+                    swap_red_blue<4, 4>(src_row, dst_row, m_width);
+                size_t row_size = size_t(m_width) * bytes_per_pixel;
+                std::memset(dst_row + row_size, 0, row_pitch - row_size);
+            }
+        }
+    );
+
+    stream->write(file.get(), file_size);
 }
 
 // ----------------------------------------------------------------------------
 // TGA I/O
 // ----------------------------------------------------------------------------
 
+static constexpr size_t TGA_HEADER_SIZE = 18;
+
+struct TGAHeader {
+    uint32_t width{0};
+    uint32_t height{0};
+    bool top_down{false};
+    bool rle{false};
+    /// Number of channels (equal to the bytes per pixel).
+    uint32_t channel_count{0};
+    size_t data_offset{0};
+
+    Bitmap::Info info() const
+    {
+        return {
+            .pixel_format = pixel_format_from_channel_count(channel_count),
+            .component_type = Bitmap::ComponentType::uint8,
+            .width = width,
+            .height = height,
+            .channel_count = channel_count,
+            .srgb_gamma = true,
+        };
+    }
+};
+
+/// Parse a TGA header. Returns \c std::nullopt for variants without a native decoder
+/// (color mapped or 15/16-bit color). Decodes to the same layout as stb_image.
+static std::optional<TGAHeader> parse_tga_header(const uint8_t* data, size_t size)
+{
+    if (size < TGA_HEADER_SIZE)
+        return {};
+    uint8_t id_length = data[0];
+    uint8_t color_map_type = data[1];
+    uint8_t image_type = data[2];
+    uint16_t width = read_le16(data + 12);
+    uint16_t height = read_le16(data + 14);
+    uint8_t bits_per_pixel = data[16];
+    uint8_t descriptor = data[17];
+    if (color_map_type != 0 || width == 0 || height == 0)
+        return {};
+
+    TGAHeader header{
+        .width = width,
+        .height = height,
+        .top_down = (descriptor & 0x20) != 0,
+        .rle = image_type >= 8,
+        .data_offset = TGA_HEADER_SIZE + id_length,
+    };
+    bool gray = image_type == 3 || image_type == 11;
+    bool color = image_type == 2 || image_type == 10;
+    if (gray && (bits_per_pixel == 8 || bits_per_pixel == 16))
+        header.channel_count = bits_per_pixel / 8;
+    else if (color && (bits_per_pixel == 24 || bits_per_pixel == 32))
+        header.channel_count = bits_per_pixel / 8;
+    else
+        return {};
+    return header;
+}
+
+static Bitmap::Info probe_tga(Stream* stream)
+{
+    StreamData header_data = read_stream_data(stream, TGA_HEADER_SIZE, true);
+    if (auto header = parse_tga_header(header_data.data.get(), header_data.size))
+        return header->info();
+    return probe_stb(stream, "TGA", true, false);
+}
+
+/// Decode TGA run-length encoded pixel packets. Packets may span rows.
+static void decode_tga_rle(const uint8_t* src, const uint8_t* src_end, uint8_t* dst, const TGAHeader& header)
+{
+    size_t pixel_size = header.channel_count;
+    size_t row_size = header.width * pixel_size;
+    auto dst_row = [&](uint32_t y) { return dst + (header.top_down ? y : header.height - 1 - y) * row_size; };
+
+    uint32_t y = 0;
+    size_t x = 0;
+    uint8_t* row = dst_row(0);
+    while (y < header.height) {
+        if (src >= src_end)
+            SGL_THROW("Failed to read TGA file!");
+        uint8_t packet = *src++;
+        size_t count = (packet & 0x7f) + 1;
+        bool repeat = (packet & 0x80) != 0;
+        if (size_t(src_end - src) < (repeat ? 1 : count) * pixel_size)
+            SGL_THROW("Failed to read TGA file!");
+        const uint8_t* pixel = src;
+        if (repeat)
+            src += pixel_size;
+        while (count > 0 && y < header.height) {
+            size_t n = std::min(count, (row_size - x) / pixel_size);
+            if (!repeat) {
+                std::memcpy(row + x, src, n * pixel_size);
+                src += n * pixel_size;
+            } else if (pixel_size == 1) {
+                std::memset(row + x, pixel[0], n);
+            } else {
+                for (size_t i = 0; i < n; ++i)
+                    std::memcpy(row + x + i * pixel_size, pixel, pixel_size);
+            }
+            x += n * pixel_size;
+            count -= n;
+            if (x == row_size) {
+                x = 0;
+                if (++y < header.height)
+                    row = dst_row(y);
+            }
+        }
+    }
+}
+
 void Bitmap::read_tga(Stream* stream)
 {
-    read_stb(stream, "TGA", true, false);
+    size_t pos = stream->tell();
+    StreamData file = read_stream_data(stream);
+    std::optional<TGAHeader> header = parse_tga_header(file.data.get(), file.size);
+    if (!header) {
+        stream->seek(pos);
+        read_stb(stream, "TGA", true, false);
+        return;
+    }
+    // Run-length encoded packets hold at most 128 pixels, which bounds the size of valid data.
+    size_t row_size = size_t(header->width) * header->channel_count;
+    size_t pixels = size_t(header->width) * header->height;
+    size_t min_data_size = header->rle ? (pixels + 127) / 128 * (1 + header->channel_count) : row_size * header->height;
+    if (header->data_offset > file.size || file.size - header->data_offset < min_data_size)
+        SGL_THROW("Failed to read TGA file!");
+
+    Info info = header->info();
+    m_width = info.width;
+    m_height = info.height;
+    m_pixel_format = info.pixel_format;
+    m_component_type = info.component_type;
+    m_srgb_gamma = info.srgb_gamma;
+    rebuild_pixel_struct();
+    log_read(stream, "TGA", this);
+    allocate_data();
+
+    const uint8_t* src = file.data.get() + header->data_offset;
+    uint8_t* dst = uint8_data();
+    if (header->rle)
+        decode_tga_rle(src, file.data.get() + file.size, dst, *header);
+
+    // Copy uncompressed rows and convert from BGR(A) to RGB(A).
+    uint32_t channel_count = header->channel_count;
+    if (header->rle && channel_count < 3)
+        return;
+    parallel_for(
+        m_height,
+        pixel_count(),
+        [&](size_t begin, size_t end)
+        {
+            for (size_t y = begin; y < end; ++y) {
+                uint8_t* dst_row = dst + y * row_size;
+                const uint8_t* src_row
+                    = header->rle ? dst_row : src + (header->top_down ? y : m_height - 1 - y) * row_size;
+                if (channel_count == 3)
+                    swap_red_blue<3, 3>(src_row, dst_row, m_width);
+                else if (channel_count == 4)
+                    swap_red_blue<4, 4>(src_row, dst_row, m_width);
+                else
+                    std::memcpy(dst_row, src_row, row_size);
+            }
+        }
+    );
+}
+
+/// Encode a row of pixels as TGA run-length encoded packets. Packets do not span rows.
+static uint8_t* encode_tga_rle_row(const uint8_t* row, uint32_t width, uint32_t pixel_size, uint8_t* out)
+{
+    auto equal = [&](uint32_t a, uint32_t b)
+    { return std::memcmp(row + a * pixel_size, row + b * pixel_size, pixel_size) == 0; };
+    auto write_pixels = [&](uint32_t x, uint32_t count)
+    {
+        if (pixel_size == 3)
+            swap_red_blue<3, 3>(row + x * 3, out, count);
+        else if (pixel_size == 4)
+            swap_red_blue<4, 4>(row + x * 4, out, count);
+        else
+            std::memcpy(out, row + x * pixel_size, count * pixel_size);
+        out += count * pixel_size;
+    };
+
+    uint32_t x = 0;
+    while (x < width) {
+        uint32_t count = 1;
+        if (x + 1 < width && equal(x, x + 1)) {
+            // Run of identical pixels.
+            while (count < 128 && x + count < width && equal(x, x + count))
+                ++count;
+            *out++ = uint8_t(0x80 | (count - 1));
+            write_pixels(x, 1);
+        } else {
+            // Raw pixels up to the start of the next run.
+            while (count < 128 && x + count < width && !(x + count + 1 < width && equal(x + count, x + count + 1)))
+                ++count;
+            *out++ = uint8_t(count - 1);
+            write_pixels(x, count);
+        }
+        x += count;
+    }
+    return out;
 }
 
 void Bitmap::write_tga(Stream* stream) const
 {
     check_required_format("TGA", {PixelFormat::y, PixelFormat::rgb, PixelFormat::rgba}, {ComponentType::uint8});
-
-    if (!stbi_write_tga_to_func(&stbi_write_func, stream, m_width, m_height, int(channel_count()), data()))
-        SGL_THROW("Failed to write TGA file!");
+    SGL_CHECK(m_width <= 0xffff && m_height <= 0xffff, "Bitmap is too large for a TGA file.");
+
+    // Run-length encoded, stored top-down.
+    uint32_t channel_count = this->channel_count();
+    uint8_t header[TGA_HEADER_SIZE] = {};
+    header[2] = channel_count == 1 ? 11 : 10;
+    write_le16(header + 12, uint16_t(m_width));
+    write_le16(header + 14, uint16_t(m_height));
+    header[16] = uint8_t(channel_count * 8);
+    header[17] = uint8_t(0x20 | (channel_count == 4 ? 8 : 0));
+    stream->write(header, TGA_HEADER_SIZE);
+
+    // Each packet holds at least one pixel.
+    size_t max_row_size = size_t(m_width) * (channel_count + 1);
+    size_t row_size = size_t(m_width) * channel_count;
+    const uint8_t* data = uint8_data();
+    write_encoded_rows(
+        stream,
+        m_height,
+        pixel_count(),
+        max_row_size,
+        [&](uint32_t y, uint8_t* out) { return encode_tga_rle_row(data + y * row_size, m_width, channel_count, out); }
+    );
 }
 
 // ----------------------------------------------------------------------------
 // HDR I/O
 // ----------------------------------------------------------------------------
 
+/// Maximum size of the text header read when probing HDR files.
+static constexpr size_t HDR_MAX_HEADER_SIZE = 64 * 1024;
+
+struct HDRHeader {
+    uint32_t width{0};
+    uint32_t height{0};
+    size_t data_offset{0};
+
+    Bitmap::Info info() const
+    {
+        return {
+            .pixel_format = Bitmap::PixelFormat::rgb,
+            .component_type = Bitmap::ComponentType::float32,
+            .width = width,
+            .height = height,
+            .channel_count = 3,
+            .srgb_gamma = false,
+        };
+    }
+};
+
+/// Parse a Radiance HDR header. Like stb_image, only RGBE data in standard orientation is supported.
+static std::optional<HDRHeader> parse_hdr_header(const uint8_t* data, size_t size)
+{
+    size_t pos = 0;
+    auto next_line = [&]() -> std::optional<std::string_view>
+    {
+        const uint8_t* end = static_cast<const uint8_t*>(std::memchr(data + pos, '\n', size - pos));
+        if (!end)
+            return {};
+        std::string_view line(reinterpret_cast<const char*>(data + pos), end - (data + pos));
+        pos = end - data + 1;
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        return line;
+    };
+
+    std::optional<std::string_view> line = next_line();
+    if (!line || (*line != "#?RADIANCE" && *line != "#?RGBE"))
+        return {};
+    bool is_rgbe = false;
+    while (true) {
+        if (!(line = next_line()))
+            return {};
+        if (line->empty())
+            break;
+        if (*line == "FORMAT=32-bit_rle_rgbe")
+            is_rgbe = true;
+    }
+    if (!is_rgbe || !(line = next_line()))
+        return {};
+
+    // Resolution string "-Y <height> +X <width>".
+    auto parse = [](std::string_view& str, std::string_view prefix, uint32_t& value)
+    {
+        while (str.starts_with(' '))
+            str.remove_prefix(1);
+        if (!str.starts_with(prefix))
+            return false;
+        str.remove_prefix(prefix.size());
+        auto result = std::from_chars(str.data(), str.data() + str.size(), value);
+        str.remove_prefix(result.ptr - str.data());
+        return result.ec == std::errc() && value > 0;
+    };
+    HDRHeader header{.data_offset = pos};
+    std::string_view resolution = *line;
+    if (!parse(resolution, "-Y ", header.height) || !parse(resolution, "+X ", header.width))
+        return {};
+    return header;
+}
+
+static Bitmap::Info probe_hdr(Stream* stream)
+{
+    StreamData header_data = read_stream_data(stream, HDR_MAX_HEADER_SIZE, true);
+    if (auto header = parse_hdr_header(header_data.data.get(), header_data.size))
+        return header->info();
+    return probe_stb(stream, "HDR", false, true);
+}
+
+/// Convert RGBE pixels to float RGB. Channel \c c of pixel \c i is read from <tt>rgbe[c][i * Stride]</tt>.
+/// Matches stb_image, i.e. value = mantissa * 2^(exponent - 136).
+template<size_t Stride>
+static void rgbe_to_float(const uint8_t* const rgbe[4], float* dst, size_t count)
+{
+    const uint8_t* r = rgbe[0];
+    const uint8_t* g = rgbe[1];
+    const uint8_t* b = rgbe[2];
+    const uint8_t* e = rgbe[3];
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t exponent = e[i * Stride];
+        // 2^(exponent - 136) as the product of two normal floats, which is exact for all exponents
+        // including the ones where the result is denormal.
+        float scale = stdx::bit_cast<float>(((exponent >> 1) + 59) << 23)
+            * stdx::bit_cast<float>((((exponent + 1) >> 1) + 59) << 23);
+        scale = exponent ? scale : 0.f;
+        dst[i * 3 + 0] = float(r[i * Stride]) * scale;
+        dst[i * 3 + 1] = float(g[i * Stride]) * scale;
+        dst[i * 3 + 2] = float(b[i * Stride]) * scale;
+    }
+}
+
+/// Convert float RGB pixels to RGBE. Channel \c c of pixel \c i is written to <tt>rgbe[c][i * Stride]</tt>.
+/// Matches stb_image_write, except that negative values are clamped to zero.
+template<size_t Stride>
+static void float_to_rgbe(const float* src, uint8_t* const rgbe[4], size_t count)
+{
+    uint8_t* r = rgbe[0];
+    uint8_t* g = rgbe[1];
+    uint8_t* b = rgbe[2];
+    uint8_t* e = rgbe[3];
+    for (size_t i = 0; i < count; ++i) {
+        float red = src[i * 3 + 0];
+        float green = src[i * 3 + 1];
+        float blue = src[i * 3 + 2];
+        float max_value = std::max(red, std::max(green, blue));
+        bool is_zero = !(max_value >= 1e-32f);
+        // frexp(max_value) exponent and 2^(8 - exponent), computed from the float bits.
+        int32_t biased = std::max(int32_t((stdx::bit_cast<uint32_t>(max_value) >> 23) & 0xff), 20);
+        int32_t exponent = biased - 126;
+        float normalize = stdx::bit_cast<float>(uint32_t(261 - biased) << 23);
+        r[i * Stride] = is_zero ? 0 : uint8_t(std::max(red * normalize, 0.f));
+        g[i * Stride] = is_zero ? 0 : uint8_t(std::max(green * normalize, 0.f));
+        b[i * Stride] = is_zero ? 0 : uint8_t(std::max(blue * normalize, 0.f));
+        e[i * Stride] = is_zero ? 0 : uint8_t(exponent + 128);
+    }
+}
+
+/// Run-length encode a scanline channel of an HDR file. Only runs of at least 3 bytes are encoded
+/// as runs. Writes at most 2 * count bytes.
+static uint8_t* encode_hdr_rle(const uint8_t* data, uint32_t count, uint8_t* out)
+{
+    uint32_t x = 0;
+    while (x < count) {
+        // Find the next run.
+        uint32_t run = x;
+        while (run + 2 < count && !(data[run] == data[run + 1] && data[run] == data[run + 2]))
+            ++run;
+        if (run + 2 >= count)
+            run = count;
+        // Literals up to the run.
+        while (x < run) {
+            uint32_t n = std::min(run - x, 128u);
+            *out++ = uint8_t(n);
+            std::memcpy(out, data + x, n);
+            out += n;
+            x += n;
+        }
+        // The run.
+        if (run < count) {
+            uint32_t run_end = run;
+            while (run_end < count && data[run_end] == data[run])
+                ++run_end;
+            while (x < run_end) {
+                uint32_t n = std::min(run_end - x, 127u);
+                *out++ = uint8_t(128 + n);
+                *out++ = data[run];
+                x += n;
+            }
+        }
+    }
+    return out;
+}
+
 void Bitmap::read_hdr(Stream* stream)
 {
-    read_stb(stream, "HDR", false, true);
+    size_t pos = stream->tell();
+    StreamData file = read_stream_data(stream);
+    std::optional<HDRHeader> header = parse_hdr_header(file.data.get(), file.size);
+    if (!header) {
+        stream->seek(pos);
+        read_stb(stream, "HDR", false, true);
+        return;
+    }
+
+    const uint8_t* data = file.data.get() + header->data_offset;
+    size_t size = file.size - header->data_offset;
+    uint32_t width = header->width;
+    uint32_t height = header->height;
+
+    // Scanlines are run-length encoded if the first one starts with the RLE marker.
+    bool rle = width >= 8 && width < 32768 && size >= 4 && data[0] == 2 && data[1] == 2 && (data[2] & 0x80) == 0;
+
+    // Find the scanline offsets with a serial pass that only parses run lengths.
+    // Each encoded scanline takes at least 12 bytes (marker and one run per channel).
+    std::vector<size_t> offsets;
+    if (!rle) {
+        if (size / 4 / width < height)
+            SGL_THROW("Failed to read HDR file!");
+    } else {
+        if (size / 12 < height)
+            SGL_THROW("Failed to read HDR file!");
+        offsets.resize(height);
+        size_t offset = 0;
+        for (uint32_t y = 0; y < height; ++y) {
+            offsets[y] = offset;
+            if (offset + 4 > size || data[offset] != 2 || data[offset + 1] != 2
+                || uint32_t((data[offset + 2] << 8) | data[offset + 3]) != width)
+                SGL_THROW("Failed to read HDR file!");
+            offset += 4;
+            for (uint32_t c = 0; c < 4; ++c) {
+                for (uint32_t x = 0; x < width;) {
+                    if (offset >= size)
+                        SGL_THROW("Failed to read HDR file!");
+                    uint32_t count = data[offset++];
+                    if (count > 128) {
+                        count -= 128;
+                        offset += 1;
+                    } else {
+                        offset += count;
+                    }
+                    if (count == 0 || count > width - x)
+                        SGL_THROW("Failed to read HDR file!");
+                    x += count;
+                }
+            }
+        }
+        if (offset > size)
+            SGL_THROW("Failed to read HDR file!");
+    }
+
+    Info info = header->info();
+    m_width = info.width;
+    m_height = info.height;
+    m_pixel_format = info.pixel_format;
+    m_component_type = info.component_type;
+    m_srgb_gamma = info.srgb_gamma;
+    rebuild_pixel_struct();
+    log_read(stream, "HDR", this);
+    allocate_data();
+
+    float* dst = reinterpret_cast<float*>(m_data);
+    if (!rle) {
+        parallel_for(
+            m_height,
+            pixel_count(),
+            [&](size_t begin, size_t end)
+            {
+                const uint8_t* src = data + begin * width * 4;
+                const uint8_t* rgbe[4] = {src, src + 1, src + 2, src + 3};
+                rgbe_to_float<4>(rgbe, dst + begin * width * 3, (end - begin) * width);
+            }
+        );
+        return;
+    }
+
+    // Decode scanlines in parallel.
+    parallel_for(
+        m_height,
+        pixel_count(),
+        [&](size_t begin, size_t end)
+        {
+            std::unique_ptr<uint8_t[]> planes(new uint8_t[width * 4]);
+            const uint8_t* rgbe[4]
+                = {planes.get(), planes.get() + width, planes.get() + width * 2, planes.get() + width * 3};
+            for (size_t y = begin; y < end; ++y) {
+                const uint8_t* src = data + offsets[y] + 4;
+                for (uint32_t c = 0; c < 4; ++c) {
+                    uint8_t* plane = planes.get() + c * width;
+                    for (uint32_t x = 0; x < width;) {
+                        uint32_t count = *src++;
+                        if (count > 128) {
+                            count -= 128;
+                            std::memset(plane + x, *src++, count);
+                        } else {
+                            std::memcpy(plane + x, src, count);
+                            src += count;
+                        }
+                        x += count;
+                    }
+                }
+                rgbe_to_float<1>(rgbe, dst + y * width * 3, width);
+            }
+        }
+    );
 }
 
 void Bitmap::write_hdr(Stream* stream) const
 {
     check_required_format("HDR", {PixelFormat::rgb}, {ComponentType::float32});
 
-    if (!stbi_write_hdr_to_func(
-            &stbi_write_func,
+    std::string header = fmt::format("#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y {} +X {}\n", m_height, m_width);
+    stream->write(header.data(), header.size());
+
+    // Scanlines are run-length encoded unless the width is outside the range supported by the format.
+    uint32_t width = m_width;
+    const float* src = reinterpret_cast<const float*>(m_data);
+    bool rle = width >= 8 && width < 32768;
+    if (!rle) {
+        write_encoded_rows(
             stream,
-            m_width,
             m_height,
-            int(channel_count()),
-            reinterpret_cast<const float*>(data())
-        ))
-        SGL_THROW("Failed to write HDR file!");
+            pixel_count(),
+            width * 4,
+            [&](uint32_t y, uint8_t* out)
+            {
+                uint8_t* rgbe[4] = {out, out + 1, out + 2, out + 3};
+                float_to_rgbe<4>(src + size_t(y) * width * 3, rgbe, width);
+                return out + width * 4;
+            }
+        );
+        return;
+    }
+
+    // The RGBE planes are written to the end of the row output, behind the space needed for encoding.
+    size_t max_encoded_size = 4 + 4 * 2 * width;
+    write_encoded_rows(
+        stream,
+        m_height,
+        pixel_count(),
+        max_encoded_size + width * 4,
+        [&](uint32_t y, uint8_t* out)
+        {
+            uint8_t* planes = out + max_encoded_size;
+            uint8_t* rgbe[4] = {planes, planes + width, planes + width * 2, planes + width * 3};
+            float_to_rgbe<1>(src + size_t(y) * width * 3, rgbe, width);
+            *out++ = 2;
+            *out++ = 2;
+            *out++ = uint8_t(width >> 8);
+            *out++ = uint8_t(width & 0xff);
+            for (uint32_t c = 0; c < 4; ++c)
+                out = encode_hdr_rle(rgbe[c], width, out);
+            return out;
+        }
+    );
 }
 
 // ----------------------------------------------------------------------------
@@ -1678,15 +3188,15 @@ void Bitmap::read_exr(Stream* stream)
     size_t pixel_count = this->pixel_count();
     size_t row_stride = pixel_stride * m_width;
 
-    m_data = std::unique_ptr<uint8_t[]>(new uint8_t[row_stride * m_height]);
-    m_owns_data = true;
+    allocate_data();
+    SGL_ASSERT(m_data_size == row_stride * m_height);
 
 #if 0
     using ResampleBuffer = std::pair<std::string, ref<Bitmap>>;
     std::vector<ResampleBuffer> resample_buffers;
 #endif
 
-    uint8_t* ptr = m_data.get() - (data_window.min.x + data_window.min.y * m_width) * pixel_stride;
+    uint8_t* ptr = m_data - (data_window.min.x + data_window.min.y * m_width) * pixel_stride;
 
     // Tell OpenEXR where the image data should be put.
     Imf::FrameBuffer framebuffer;
@@ -1806,13 +3316,13 @@ void Bitmap::read_exr(Stream* stream)
 
         switch (m_component_type) {
         case ComponentType::float16:
-            convert(reinterpret_cast<math::float16_t*>(m_data.get()));
+            convert(reinterpret_cast<math::float16_t*>(m_data));
             break;
         case ComponentType::float32:
-            convert(reinterpret_cast<float*>(m_data.get()));
+            convert(reinterpret_cast<float*>(m_data));
             break;
         case ComponentType::uint32:
-            convert(reinterpret_cast<uint32_t*>(m_data.get()));
+            convert(reinterpret_cast<uint32_t*>(m_data));
             break;
         default:
             SGL_THROW("Internal error!");
@@ -1887,13 +3397,13 @@ void Bitmap::read_exr(Stream* stream)
 
         switch (m_component_format) {
         case Struct::Type::Float16:
-            convert((dr::half*)m_data.get());
+            convert((dr::half*)m_data);
             break;
         case Struct::Type::Float32:
-            convert((float*)m_data.get());
+            convert((float*)m_data);
             break;
         case Struct::Type::UInt32:
-            convert((uint32_t*)m_data.get());
+            convert((uint32_t*)m_data);
             break;
         default:
             Throw("Internal error!");
@@ -2216,8 +3726,8 @@ void Bitmap::read_exr(Stream* stream)
     size_t pixel_count = this->pixel_count();
     size_t row_stride = pixel_stride * m_width;
 
-    m_data = std::unique_ptr<uint8_t[]>(new uint8_t[row_stride * m_height]);
-    m_owns_data = true;
+    allocate_data();
+    SGL_ASSERT(m_data_size == row_stride * m_height);
 
     for (const auto& field : *m_pixel_struct) {
         int channel_index = find_channel_index(field.name);
@@ -2336,4 +3846,141 @@ void Bitmap::write_exr(Stream* stream, int quality) const
 
 #endif // SGL_HAS_OPENEXR
 
+// ----------------------------------------------------------------------------
+// BitmapView
+// ----------------------------------------------------------------------------
+
+BitmapView::BitmapView(ref<const Bitmap> bitmap, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    : m_bitmap(std::move(bitmap))
+    , m_x(x)
+    , m_y(y)
+    , m_width(width)
+    , m_height(height)
+{
+    SGL_CHECK_NOT_NULL(m_bitmap);
+    SGL_CHECK(
+        uint64_t(x) + width <= m_bitmap->width() && uint64_t(y) + height <= m_bitmap->height(),
+        "View ({}, {}, {}, {}) exceeds bitmap size {}x{}.",
+        x,
+        y,
+        width,
+        height,
+        m_bitmap->width(),
+        m_bitmap->height()
+    );
+    m_pixel_format = m_bitmap->pixel_format();
+}
+
+const uint8_t* BitmapView::data() const
+{
+    SGL_CHECK(m_bitmap, "Bitmap view is empty.");
+    return m_bitmap->uint8_data() + (size_t(m_y) * m_bitmap->width() + m_x) * bytes_per_pixel();
+}
+
+BitmapView BitmapView::subview(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const
+{
+    SGL_CHECK(
+        uint64_t(x) + width <= m_width && uint64_t(y) + height <= m_height,
+        "Sub-view ({}, {}, {}, {}) exceeds view size {}x{}.",
+        x,
+        y,
+        width,
+        height,
+        m_width,
+        m_height
+    );
+    BitmapView result = *this;
+    result.m_x += x;
+    result.m_y += y;
+    result.m_width = width;
+    result.m_height = height;
+    return result;
+}
+
+ref<Bitmap> BitmapView::to_bitmap() const
+{
+    SGL_CHECK(m_bitmap, "Bitmap view is empty.");
+
+    if (!m_channel_struct) {
+        ref<Bitmap> result = create_bitmap_like(m_bitmap, m_width, m_height);
+        if (empty())
+            return result;
+        size_t row_size = m_width * bytes_per_pixel();
+        if (is_contiguous()) {
+            std::memcpy(result->uint8_data(), data(), row_size * m_height);
+        } else {
+            parallel_for(
+                m_height,
+                size_t(m_width) * m_height,
+                [&](size_t begin, size_t end)
+                {
+                    for (size_t y = begin; y < end; ++y)
+                        std::memcpy(result->uint8_data() + y * row_size, row(uint32_t(y)), row_size);
+                }
+            );
+        }
+        return result;
+    }
+
+    ref<Bitmap> result = make_ref<Bitmap>(
+        m_pixel_format,
+        m_bitmap->component_type(),
+        m_width,
+        m_height,
+        narrow_cast<uint32_t>(m_channel_names.size()),
+        m_channel_names
+    );
+    result->set_srgb_gamma(m_bitmap->srgb_gamma());
+    if (empty())
+        return result;
+
+    StructConverter converter(m_bitmap->pixel_struct(), m_channel_struct);
+    size_t row_size = m_width * result->bytes_per_pixel();
+    if (is_contiguous()) {
+        // Convert in chunks of rows to use multiple threads.
+        parallel_for(
+            m_height,
+            size_t(m_width) * m_height,
+            [&](size_t begin, size_t end)
+            {
+                uint8_t* dst = result->uint8_data() + begin * row_size;
+                converter.convert(row(uint32_t(begin)), dst, (end - begin) * m_width);
+            }
+        );
+    } else {
+        parallel_for(
+            m_height,
+            size_t(m_width) * m_height,
+            [&](size_t begin, size_t end)
+            {
+                for (size_t y = begin; y < end; ++y)
+                    converter.convert(row(uint32_t(y)), result->uint8_data() + y * row_size, m_width);
+            }
+        );
+    }
+    return result;
+}
+
+std::string BitmapView::to_string() const
+{
+    if (!m_bitmap)
+        return "BitmapView()";
+    return fmt::format(
+        "BitmapView(\n"
+        "  x = {},\n"
+        "  y = {},\n"
+        "  width = {},\n"
+        "  height = {},\n"
+        "  pixel_format = {},\n"
+        "  bitmap = {}\n"
+        ")",
+        m_x,
+        m_y,
+        m_width,
+        m_height,
+        m_pixel_format,
+        string::indent(m_bitmap->to_string())
+    );
+}
+
 } // namespace sgl
@@ -49,6 +49,7 @@ derivative works thereof, in binary and source code form.
 #include "sgl/core/macros.h"
 #include "sgl/core/object.h"
 #include "sgl/core/enum.h"
+#include "sgl/core/memory_pool.h"
 #include "sgl/core/stream.h"
 #include "sgl/core/struct.h"
 
@@ -61,6 +62,8 @@ derivative works thereof, in binary and source code form.
 
 namespace sgl {
 
+class BitmapView;
+
 class SGL_API Bitmap : public Object {
     SGL_OBJECT(Bitmap)
 public:
@@ -123,6 +126,26 @@ public:
 
     using ComponentType = Struct::Type;
 
+    /// Image properties determined from the file header only (see \c probe).
+    struct Info {
+        /// The file format.
+        FileFormat file_format{FileFormat::unknown};
+        /// The pixel format the image is loaded with.
+        PixelFormat pixel_format{PixelFormat::rgb};
+        /// The component type the image is loaded with.
+        ComponentType component_type{ComponentType::uint8};
+        /// The width of the image in pixels.
+        uint32_t width{0};
+        /// The height of the image in pixels.
+        uint32_t height{0};
+        /// The number of channels.
+        uint32_t channel_count{0};
+        /// True if the image is loaded with sRGB gamma encoding.
+        bool srgb_gamma{false};
+
+        std::string to_string() const;
+    };
+
     Bitmap(
         PixelFormat pixel_format,
         ComponentType component_type,
@@ -150,6 +173,25 @@ public:
     static std::vector<ref<Bitmap>>
     read_multiple(std::span<std::filesystem::path> paths, FileFormat format = FileFormat::auto_);
 
+    /**
+     * \brief Determine the image properties of a file without decoding the pixel data.
+     *
+     * Only the file header is read from the stream, which is typically a few hundred bytes.
+     * The stream position is restored after probing.
+     *
+     * \param stream Stream to probe.
+     * \param format File format (auto-detected by default).
+     * \return Image properties, matching those of a \c Bitmap loaded from the same stream.
+     */
+    static Info probe(Stream* stream, FileFormat format = FileFormat::auto_);
+
+    /// Determine the image properties of a file without decoding the pixel data.
+    static Info probe(const std::filesystem::path& path, FileFormat format = FileFormat::auto_);
+
+    /// Probe a list of files. Uses multi-threading to probe files in parallel.
+    static std::vector<Info>
+    probe_multiple(std::span<std::filesystem::path> paths, FileFormat format = FileFormat::auto_);
+
     void write(Stream* stream, FileFormat format = FileFormat::auto_, int quality = -1) const;
     void write(const std::filesystem::path& path, FileFormat format = FileFormat::auto_, int quality = -1) const;
 
@@ -196,22 +238,22 @@ public:
     size_t buffer_size() const { return pixel_count() * bytes_per_pixel(); }
 
     /// The raw image data.
-    void* data() { return m_data.get(); }
-    const void* data() const { return m_data.get(); }
+    void* data() { return m_data; }
+    const void* data() const { return m_data; }
 
     /// The raw image data as uint8_t.
-    uint8_t* uint8_data() { return m_data.get(); }
-    const uint8_t* uint8_data() const { return m_data.get(); }
+    uint8_t* uint8_data() { return m_data; }
+    const uint8_t* uint8_data() const { return m_data; }
 
     template<typename T>
     T* data_as()
     {
-        return reinterpret_cast<T*>(m_data.get());
+        return reinterpret_cast<T*>(m_data);
     }
     template<typename T>
     const T* data_as() const
     {
-        return reinterpret_cast<const T*>(m_data.get());
+        return reinterpret_cast<const T*>(m_data);
     }
 
     /// True if bitmap is empty.
@@ -223,6 +265,50 @@ public:
     /// Vertically flip the bitmap.
     void vflip();
 
+    /// Horizontally flip the bitmap.
+    void hflip();
+
+    /// Return the transposed bitmap (pixel (x, y) is moved to (y, x)).
+    ref<Bitmap> transpose() const;
+
+    /// Return the bitmap rotated by 90 degrees clockwise.
+    ref<Bitmap> rotate90() const;
+
+    /// Return the bitmap rotated by 180 degrees.
+    ref<Bitmap> rotate180() const;
+
+    /// Return the bitmap rotated by 270 degrees clockwise (90 degrees counter-clockwise).
+    ref<Bitmap> rotate270() const;
+
+    /// Return a copy of the given sub-rectangle of the bitmap.
+    ref<Bitmap> crop(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const;
+
+    /// Return a view of the entire bitmap.
+    BitmapView view() const;
+
+    /// Return a view of the given sub-rectangle of the bitmap (no pixels are copied).
+    BitmapView view(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const;
+
+    /**
+     * \brief Return views of tiles covering the bitmap (no pixels are copied).
+     *
+     * Tiles are returned in row-major order.
+     *
+     * \param tile_width Width of the tiles.
+     * \param tile_height Height of the tiles.
+     * \param step_x Horizontal distance between tiles (0 to use \c tile_width).
+     * \param step_y Vertical distance between tiles (0 to use \c tile_height).
+     * \param include_partial If true, include tiles clipped at the right and bottom borders.
+     * \return List of tile views.
+     */
+    std::vector<BitmapView> tiles(
+        uint32_t tile_width,
+        uint32_t tile_height,
+        uint32_t step_x = 0,
+        uint32_t step_y = 0,
+        bool include_partial = false
+    ) const;
+
     /**
      * \brief Split bitmap into multiple bitmaps, each containing the channels with the same prefix.
      *
@@ -238,6 +324,9 @@ public:
      */
     std::vector<std::pair<std::string, ref<Bitmap>>> split() const;
 
+    /// Same as \c split but returns views, channels are only extracted when calling \c BitmapView::to_bitmap.
+    std::vector<std::pair<std::string, BitmapView>> split_views() const;
+
     ref<Bitmap> convert(PixelFormat pixel_format, ComponentType component_type, bool srgb_gamma) const;
 
     void convert(Bitmap* target) const;
@@ -252,12 +341,35 @@ public:
 
     static FileFormat detect_file_format(Stream* stream);
 
+    /// The memory pool used for allocating pixel storage of new bitmaps.
+    static ref<MemoryPool> memory_pool();
+
+    /// Set the memory pool used for allocating pixel storage of new bitmaps.
+    /// Existing bitmaps keep a reference to the pool they were allocated from.
+    /// Pass \c nullptr to restore the default memory pool.
+    static void set_memory_pool(ref<MemoryPool> memory_pool);
+
     static void static_init();
     static void static_shutdown();
 
 private:
     void rebuild_pixel_struct(uint32_t channel_count = 0, const std::vector<std::string>& channel_names = {});
 
+    static ref<Struct> create_pixel_struct(
+        PixelFormat pixel_format,
+        ComponentType component_type,
+        bool srgb_gamma,
+        uint32_t channel_count,
+        const std::vector<std::string>& channel_names
+    );
+
+    /// Allocate pixel storage of \c buffer_size() bytes from the memory pool.
+    void allocate_data();
+
+    /// Release pixel storage (if owned).
+    /// Storage is either returned to its memory pool or, if decoded by stb_image, freed by stb_image.
+    void release_data();
+
     void read(Stream* stream, FileFormat format);
 
     void check_required_format(
@@ -292,11 +404,91 @@ private:
     uint32_t m_width;
     uint32_t m_height;
     bool m_srgb_gamma;
-    std::unique_ptr<uint8_t[]> m_data;
-    bool m_owns_data;
+    uint8_t* m_data{nullptr};
+    size_t m_data_size{0};
+    /// Memory pool the pixel storage was allocated from (nullptr if data is not owned).
+    ref<MemoryPool> m_memory_pool;
+    /// True if the pixel storage was allocated by stb_image and is owned by the bitmap.
+    bool m_stb_data{false};
 };
 
 SGL_ENUM_REGISTER(Bitmap::FileFormat);
 SGL_ENUM_REGISTER(Bitmap::PixelFormat);
 
+/**
+ * \brief Lightweight view of a sub-rectangle of a bitmap.
+ *
+ * The view keeps a reference to the parent bitmap and addresses its pixels through a row stride,
+ * no pixel data is copied until \c to_bitmap is called. Views returned by \c Bitmap::split_views
+ * additionally select a subset of the parent's channels.
+ */
+class SGL_API BitmapView {
+public:
+    BitmapView() = default;
+
+    /// Create a view of the given sub-rectangle of a bitmap.
+    BitmapView(ref<const Bitmap> bitmap, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+    /// The parent bitmap.
+    const Bitmap* bitmap() const { return m_bitmap; }
+
+    /// Horizontal offset of the view in the parent bitmap.
+    uint32_t x() const { return m_x; }
+
+    /// Vertical offset of the view in the parent bitmap.
+    uint32_t y() const { return m_y; }
+
+    /// The width of the view in pixels.
+    uint32_t width() const { return m_width; }
+
+    /// The height of the view in pixels.
+    uint32_t height() const { return m_height; }
+
+    /// True if the view is empty.
+    bool empty() const { return m_width == 0 || m_height == 0; }
+
+    /// The pixel format of the bitmap returned by \c to_bitmap.
+    Bitmap::PixelFormat pixel_format() const { return m_pixel_format; }
+
+    /// True if the view selects a subset of the parent's channels.
+    bool has_channel_subset() const { return m_channel_struct != nullptr; }
+
+    /// The number of bytes per pixel in the parent bitmap.
+    size_t bytes_per_pixel() const { return m_bitmap ? m_bitmap->bytes_per_pixel() : 0; }
+
+    /// The number of bytes between consecutive rows.
+    size_t row_stride() const { return m_bitmap ? m_bitmap->width() * bytes_per_pixel() : 0; }
+
+    /// True if the rows of the view are stored contiguously.
+    bool is_contiguous() const { return m_bitmap && (m_width == m_bitmap->width() || m_height <= 1); }
+
+    /// Pointer to the first pixel of the view.
+    const uint8_t* data() const;
+
+    /// Pointer to the first pixel of row \c y of the view.
+    const uint8_t* row(uint32_t y) const { return data() + y * row_stride(); }
+
+    /// Return a view of the given sub-rectangle of this view.
+    BitmapView subview(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const;
+
+    /// Copy the pixels of the view into a new bitmap.
+    ref<Bitmap> to_bitmap() const;
+
+    std::string to_string() const;
+
+private:
+    ref<const Bitmap> m_bitmap;
+    uint32_t m_x{0};
+    uint32_t m_y{0};
+    uint32_t m_width{0};
+    uint32_t m_height{0};
+    Bitmap::PixelFormat m_pixel_format{Bitmap::PixelFormat::y};
+    /// Channel selection (target pixel struct with fields named after the parent's fields), or nullptr.
+    ref<const Struct> m_channel_struct;
+    /// Channel names of the target bitmap (multi-channel only).
+    std::vector<std::string> m_channel_names;
+
+    friend class Bitmap;
+};
+
 } // namespace sgl
@@ -0,0 +1,546 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "compressed_stream.h"
+
+#include "sgl/core/config.h"
+#include "sgl/core/error.h"
+#include "sgl/core/file_stream.h"
+#include "sgl/core/format.h"
+#include "sgl/core/logger.h"
+#include "sgl/core/thread.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#if SGL_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+#if SGL_HAS_LZ4
+#include <lz4frame.h>
+#endif
+
+namespace sgl {
+
+/// Magic number of zstd frames.
+static constexpr uint32_t ZSTD_FRAME_MAGIC = 0xfd2fb528;
+/// Magic number of LZ4 frames.
+static constexpr uint32_t LZ4_FRAME_MAGIC = 0x184d2204;
+/// Magic number of the skippable frame holding the seek table (valid for both zstd and LZ4).
+static constexpr uint32_t SEEK_TABLE_FRAME_MAGIC = 0x184d2a5e;
+/// Magic number at the end of the seek table (zstd seekable format).
+static constexpr uint32_t SEEKABLE_MAGIC = 0x8f92eab1;
+
+/// Size of the skippable frame header (magic + frame size).
+static constexpr size_t SKIPPABLE_HEADER_SIZE = 8;
+/// Size of the seek table footer (frame count + descriptor + magic).
+static constexpr size_t SEEK_TABLE_FOOTER_SIZE = 9;
+/// Size of a seek table entry (compressed size + decompressed size).
+static constexpr size_t SEEK_TABLE_ENTRY_SIZE = 8;
+/// Seek table descriptor flag indicating per-frame checksums.
+static constexpr uint8_t SEEK_TABLE_CHECKSUM_FLAG = 0x80;
+
+static void store_le32(uint8_t* p, uint32_t value)
+{
+    p[0] = uint8_t(value);
+    p[1] = uint8_t(value >> 8);
+    p[2] = uint8_t(value >> 16);
+    p[3] = uint8_t(value >> 24);
+}
+
+static uint32_t load_le32(const uint8_t* p)
+{
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+// -----------------------------------------------------------------------------
+// Codecs
+// -----------------------------------------------------------------------------
+
+#if SGL_HAS_ZSTD
+struct ZstdContexts {
+    ZSTD_CCtx* cctx{nullptr};
+    ZSTD_DCtx* dctx{nullptr};
+    ~ZstdContexts()
+    {
+        ZSTD_freeCCtx(cctx);
+        ZSTD_freeDCtx(dctx);
+    }
+};
+/// Contexts are reused by each thread to avoid reallocating compression state for every block.
+static thread_local ZstdContexts s_zstd;
+#endif
+
+#if SGL_HAS_LZ4
+struct Lz4Contexts {
+    LZ4F_dctx* dctx{nullptr};
+    ~Lz4Contexts() { LZ4F_freeDecompressionContext(dctx); }
+};
+static thread_local Lz4Contexts s_lz4;
+#endif
+
+static std::vector<uint8_t> compress_block(CompressionCodec codec, int level, const uint8_t* src, size_t size)
+{
+    std::vector<uint8_t> dst;
+    switch (codec) {
+#if SGL_HAS_ZSTD
+    case CompressionCodec::zstd: {
+        if (!s_zstd.cctx)
+            s_zstd.cctx = ZSTD_createCCtx();
+        dst.resize(ZSTD_compressBound(size));
+        size_t result = ZSTD_compressCCtx(
+            s_zstd.cctx,
+            dst.data(),
+            dst.size(),
+            src,
+            size,
+            level == 0 ? ZSTD_CLEVEL_DEFAULT : level
+        );
+        if (ZSTD_isError(result))
+            SGL_THROW("zstd compression failed: {}", ZSTD_getErrorName(result));
+        dst.resize(result);
+        break;
+    }
+#endif
+#if SGL_HAS_LZ4
+    case CompressionCodec::lz4: {
+        LZ4F_preferences_t preferences{};
+        preferences.compressionLevel = level;
+        preferences.frameInfo.blockSizeID = LZ4F_max1MB;
+        preferences.frameInfo.contentSize = size;
+        dst.resize(LZ4F_compressFrameBound(size, &preferences));
+        size_t result = LZ4F_compressFrame(dst.data(), dst.size(), src, size, &preferences);
+        if (LZ4F_isError(result))
+            SGL_THROW("LZ4 compression failed: {}", LZ4F_getErrorName(result));
+        dst.resize(result);
+        break;
+    }
+#endif
+    default:
+        SGL_UNUSED(level, src, size);
+        SGL_THROW("Compression codec \"{}\" is not supported.", codec);
+    }
+    return dst;
+}
+
+static void decompress_block(
+    CompressionCodec codec,
+    const uint8_t* src,
+    size_t compressed_size,
+    uint8_t* dst,
+    size_t size
+)
+{
+    switch (codec) {
+#if SGL_HAS_ZSTD
+    case CompressionCodec::zstd: {
+        if (!s_zstd.dctx)
+            s_zstd.dctx = ZSTD_createDCtx();
+        size_t result = ZSTD_decompressDCtx(s_zstd.dctx, dst, size, src, compressed_size);
+        if (ZSTD_isError(result))
+            SGL_THROW("zstd decompression failed: {}", ZSTD_getErrorName(result));
+        if (result != size)
+            SGL_THROW("zstd decompression failed: expected {} bytes, got {}", size, result);
+        break;
+    }
+#endif
+#if SGL_HAS_LZ4
+    case CompressionCodec::lz4: {
+        if (!s_lz4.dctx) {
+            LZ4F_errorCode_t error = LZ4F_createDecompressionContext(&s_lz4.dctx, LZ4F_VERSION);
+            if (LZ4F_isError(error))
+                SGL_THROW("Failed to create LZ4 decompression context: {}", LZ4F_getErrorName(error));
+        }
+        LZ4F_resetDecompressionContext(s_lz4.dctx);
+        size_t src_pos = 0;
+        size_t dst_pos = 0;
+        while (true) {
+            size_t src_size = compressed_size - src_pos;
+            size_t dst_size = size - dst_pos;
+            size_t result = LZ4F_decompress(s_lz4.dctx, dst + dst_pos, &dst_size, src + src_pos, &src_size, nullptr);
+            if (LZ4F_isError(result))
+                SGL_THROW("LZ4 decompression failed: {}", LZ4F_getErrorName(result));
+            src_pos += src_size;
+            dst_pos += dst_size;
+            if (result == 0)
+                break;
+            if (src_size == 0 && dst_size == 0)
+                SGL_THROW("LZ4 decompression failed: truncated frame");
+        }
+        if (dst_pos != size)
+            SGL_THROW("LZ4 decompression failed: expected {} bytes, got {}", size, dst_pos);
+        break;
+    }
+#endif
+    default:
+        SGL_UNUSED(src, compressed_size, dst, size);
+        SGL_THROW("Compression codec \"{}\" is not supported.", codec);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// CompressedStream
+// -----------------------------------------------------------------------------
+
+CompressedStream::CompressedStream(ref<Stream> stream, Mode mode, CompressedStreamDesc desc)
+    : m_stream(std::move(stream))
+    , m_mode(mode)
+    , m_desc(std::move(desc))
+    , m_codec(m_desc.codec)
+{
+    SGL_CHECK_NOT_NULL(m_stream);
+    SGL_CHECK(
+        m_desc.block_size > 0 && m_desc.block_size <= UINT32_MAX,
+        "Invalid block size {}.",
+        m_desc.block_size
+    );
+
+    if (m_mode == Mode::read) {
+        SGL_CHECK(m_stream->is_readable(), "Underlying stream is not readable.");
+        read_seek_table();
+    } else {
+        SGL_CHECK(m_stream->is_writable(), "Underlying stream is not writable.");
+        SGL_CHECK(is_codec_supported(m_codec), "Compression codec \"{}\" is not supported.", m_codec);
+        m_block.reserve(m_desc.block_size);
+    }
+}
+
+CompressedStream::~CompressedStream()
+{
+    try {
+        close();
+    } catch (const std::exception& e) {
+        log_error("Failed to close compressed stream: {}", e.what());
+    }
+}
+
+void CompressedStream::close()
+{
+    if (!m_is_open)
+        return;
+    m_is_open = false;
+    if (m_mode == Mode::write) {
+        if (!m_block.empty())
+            submit_block();
+        write_completed_blocks(0);
+        write_seek_table();
+        m_stream->flush();
+    }
+    m_cached_data = {};
+    m_cached_frame = size_t(-1);
+}
+
+void CompressedStream::read(void* p, size_t size)
+{
+    SGL_CHECK(m_is_open, "Attempted to read from a closed compressed stream");
+    SGL_CHECK(m_mode == Mode::read, "Attempted to read from a write-only compressed stream");
+    if (m_pos + size > m_size) {
+        size_t gcount = m_size - m_pos;
+        throw EOFException(fmt::format("Compressed stream: read {} out of {} bytes", gcount, size), gcount);
+    }
+    if (size == 0)
+        return;
+
+    auto dst = static_cast<uint8_t*>(p);
+    size_t first = find_frame(m_pos);
+    size_t last = find_frame(m_pos + size - 1);
+
+    // Frames fully covered by the read are decompressed directly into the destination.
+    // Partially covered frames (at most the first and last) are decompressed into temporary buffers.
+    struct Task {
+        size_t frame;
+        uint8_t* dst;
+    };
+    std::vector<Task> tasks;
+    std::vector<uint8_t> first_data;
+    std::vector<uint8_t> last_data;
+    for (size_t i = first; i <= last; ++i) {
+        if (i == m_cached_frame && (i == first || i == last))
+            continue;
+        const Frame& frame = m_frames[i];
+        if (frame.offset >= m_pos && frame.offset + frame.size <= m_pos + size) {
+            tasks.push_back({i, dst + (frame.offset - m_pos)});
+        } else {
+            std::vector<uint8_t>& data = i == last ? last_data : first_data;
+            data.resize(frame.size);
+            tasks.push_back({i, data.data()});
+        }
+    }
+
+    if (!tasks.empty()) {
+        // Compressed frames are stored contiguously, read them with a single read.
+        const Frame& begin = m_frames[tasks.front().frame];
+        const Frame& end = m_frames[tasks.back().frame];
+        std::vector<uint8_t> compressed(end.compressed_offset + end.compressed_size - begin.compressed_offset);
+        m_stream->seek(begin.compressed_offset);
+        m_stream->read(compressed.data(), compressed.size());
+
+        auto decompress = [&](const Task& task)
+        {
+            const Frame& frame = m_frames[task.frame];
+            decompress_block(
+                m_codec,
+                compressed.data() + (frame.compressed_offset - begin.compressed_offset),
+                frame.compressed_size,
+                task.dst,
+                frame.size
+            );
+        };
+
+        thread::parallel_for(
+            size_t(0),
+            tasks.size(),
+            [&](size_t begin_index, size_t end_index)
+            {
+                for (size_t i = begin_index; i < end_index; ++i)
+                    decompress(tasks[i]);
+            },
+            tasks.size()
+        );
+    }
+
+    // Copy partially covered frames.
+    for (size_t i : {first, last}) {
+        const Frame& frame = m_frames[i];
+        const std::vector<uint8_t>* data = nullptr;
+        if (i == m_cached_frame)
+            data = &m_cached_data;
+        else if (i == last && !last_data.empty())
+            data = &last_data;
+        else if (i == first && !first_data.empty())
+            data = &first_data;
+        if (!data)
+            continue;
+        size_t begin = std::max(m_pos, size_t(frame.offset));
+        size_t end = std::min(m_pos + size, size_t(frame.offset + frame.size));
+        std::memcpy(dst + (begin - m_pos), data->data() + (begin - frame.offset), end - begin);
+        if (first == last)
+            break;
+    }
+
+    // Keep the last partially read frame for subsequent sequential reads.
+    if (!last_data.empty()) {
+        m_cached_frame = last;
+        m_cached_data = std::move(last_data);
+    }
+
+    m_pos += size;
+}
+
+void CompressedStream::write(const void* p, size_t size)
+{
+    SGL_CHECK(m_is_open, "Attempted to write to a closed compressed stream");
+    SGL_CHECK(m_mode == Mode::write, "Attempted to write to a read-only compressed stream");
+
+    auto src = static_cast<const uint8_t*>(p);
+    while (size > 0) {
+        size_t count = std::min(m_desc.block_size - m_block.size(), size);
+        m_block.insert(m_block.end(), src, src + count);
+        src += count;
+        size -= count;
+        m_pos += count;
+        if (m_block.size() == m_desc.block_size) {
+            submit_block();
+            write_completed_blocks(m_desc.max_blocks_in_flight);
+        }
+    }
+    m_size = m_pos;
+}
+
+void CompressedStream::seek(size_t pos)
+{
+    if (m_mode == Mode::write)
+        SGL_CHECK(pos == m_pos, "Compressed streams in write mode only support sequential writes.");
+    else
+        SGL_CHECK(pos <= m_size, "Attempted to seek past the end of a compressed stream");
+    m_pos = pos;
+}
+
+void CompressedStream::truncate(size_t size)
+{
+    SGL_UNUSED(size);
+    SGL_THROW("Compressed streams do not support truncation.");
+}
+
+void CompressedStream::flush()
+{
+    if (m_mode != Mode::write || !m_is_open)
+        return;
+    if (!m_block.empty())
+        submit_block();
+    write_completed_blocks(0);
+    m_stream->flush();
+}
+
+bool CompressedStream::is_codec_supported(CompressionCodec codec)
+{
+    switch (codec) {
+    case CompressionCodec::zstd:
+        return SGL_HAS_ZSTD;
+    case CompressionCodec::lz4:
+        return SGL_HAS_LZ4;
+    }
+    return false;
+}
+
+bool CompressedStream::detect_compressed_stream(Stream* stream)
+{
+    size_t size = stream->size();
+    if (size < SKIPPABLE_HEADER_SIZE + SEEK_TABLE_FOOTER_SIZE)
+        return false;
+    size_t pos = stream->tell();
+    uint8_t footer[SEEK_TABLE_FOOTER_SIZE];
+    stream->seek(size - SEEK_TABLE_FOOTER_SIZE);
+    stream->read(footer, SEEK_TABLE_FOOTER_SIZE);
+    stream->seek(pos);
+    return load_le32(footer + 5) == SEEKABLE_MAGIC;
+}
+
+std::string CompressedStream::to_string() const
+{
+    return fmt::format(
+        "CompressedStream(\n"
+        "  mode = {},\n"
+        "  codec = {},\n"
+        "  size = {},\n"
+        "  frame_count = {}\n"
+        ")",
+        m_mode,
+        m_codec,
+        m_size,
+        m_frames.size()
+    );
+}
+
+void CompressedStream::read_seek_table()
+{
+    SGL_CHECK(detect_compressed_stream(m_stream), "Stream does not contain a seekable compressed stream.");
+
+    size_t total_size = m_stream->size();
+    uint8_t footer[SEEK_TABLE_FOOTER_SIZE];
+    m_stream->seek(total_size - SEEK_TABLE_FOOTER_SIZE);
+    m_stream->read(footer, SEEK_TABLE_FOOTER_SIZE);
+    uint32_t frame_count = load_le32(footer);
+    uint8_t descriptor = footer[4];
+    SGL_CHECK((descriptor & 0x7f) == 0, "Invalid seek table descriptor.");
+
+    size_t entry_size = SEEK_TABLE_ENTRY_SIZE + ((descriptor & SEEK_TABLE_CHECKSUM_FLAG) ? 4 : 0);
+    size_t table_size = frame_count * entry_size + SEEK_TABLE_FOOTER_SIZE;
+    SGL_CHECK(table_size + SKIPPABLE_HEADER_SIZE <= total_size, "Invalid seek table.");
+    size_t frames_size = total_size - table_size - SKIPPABLE_HEADER_SIZE;
+
+    std::vector<uint8_t> table(SKIPPABLE_HEADER_SIZE + table_size - SEEK_TABLE_FOOTER_SIZE);
+    m_stream->seek(frames_size);
+    m_stream->read(table.data(), table.size());
+    SGL_CHECK(
+        load_le32(table.data()) == SEEK_TABLE_FRAME_MAGIC && load_le32(table.data() + 4) == table_size,
+        "Invalid seek table frame."
+    );
+
+    m_frames.resize(frame_count);
+    uint64_t compressed_offset = 0;
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < frame_count; ++i) {
+        const uint8_t* entry = table.data() + SKIPPABLE_HEADER_SIZE + i * entry_size;
+        m_frames[i] = {
+            .compressed_offset = compressed_offset,
+            .compressed_size = load_le32(entry),
+            .offset = offset,
+            .size = load_le32(entry + 4),
+        };
+        compressed_offset += m_frames[i].compressed_size;
+        offset += m_frames[i].size;
+    }
+    SGL_CHECK(compressed_offset == frames_size, "Seek table does not match the compressed data.");
+    m_size = offset;
+
+    // Detect the codec from the first frame.
+    if (frame_count > 0) {
+        uint8_t magic[4];
+        m_stream->seek(0);
+        m_stream->read(magic, 4);
+        if (load_le32(magic) == ZSTD_FRAME_MAGIC)
+            m_codec = CompressionCodec::zstd;
+        else if (load_le32(magic) == LZ4_FRAME_MAGIC)
+            m_codec = CompressionCodec::lz4;
+        else
+            SGL_THROW("Unknown compressed frame format.");
+        SGL_CHECK(is_codec_supported(m_codec), "Compression codec \"{}\" is not supported.", m_codec);
+    }
+}
+
+void CompressedStream::write_seek_table()
+{
+    size_t table_size = m_frames.size() * SEEK_TABLE_ENTRY_SIZE + SEEK_TABLE_FOOTER_SIZE;
+    std::vector<uint8_t> table(SKIPPABLE_HEADER_SIZE + table_size);
+    uint8_t* p = table.data();
+    store_le32(p, SEEK_TABLE_FRAME_MAGIC);
+    store_le32(p + 4, uint32_t(table_size));
+    p += SKIPPABLE_HEADER_SIZE;
+    for (const Frame& frame : m_frames) {
+        store_le32(p, frame.compressed_size);
+        store_le32(p + 4, frame.size);
+        p += SEEK_TABLE_ENTRY_SIZE;
+    }
+    store_le32(p, uint32_t(m_frames.size()));
+    p[4] = 0;
+    store_le32(p + 5, SEEKABLE_MAGIC);
+    m_stream->write(table.data(), table.size());
+}
+
+void CompressedStream::submit_block()
+{
+    auto block = std::make_shared<std::vector<uint8_t>>(std::move(m_block));
+    m_pending_block_sizes.push_back(uint32_t(block->size()));
+    auto compress = [codec = m_codec, level = m_desc.level, block]()
+    { return compress_block(codec, level, block->data(), block->size()); };
+    if (thread::in_global_thread_pool()) {
+        // Blocks are waited for when too many are in flight, which a pool worker must not do.
+        std::promise<std::vector<uint8_t>> promise;
+        promise.set_value(compress());
+        m_pending_blocks.push_back(promise.get_future());
+    } else {
+        m_pending_blocks.push_back(thread::do_async(compress));
+    }
+    m_block = {};
+    m_block.reserve(m_desc.block_size);
+}
+
+void CompressedStream::write_completed_blocks(size_t max_in_flight)
+{
+    // Write blocks in order. Wait for the oldest block if too many blocks are in flight.
+    while (!m_pending_blocks.empty()) {
+        auto& future = m_pending_blocks.front();
+        if (m_pending_blocks.size() <= max_in_flight
+            && future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            break;
+        std::vector<uint8_t> compressed = future.get();
+        m_pending_blocks.pop_front();
+        uint32_t size = m_pending_block_sizes.front();
+        m_pending_block_sizes.pop_front();
+
+        m_stream->write(compressed.data(), compressed.size());
+        uint64_t offset = m_frames.empty() ? 0 : m_frames.back().offset + m_frames.back().size;
+        m_frames.push_back({
+            .compressed_offset = m_compressed_size,
+            .compressed_size = uint32_t(compressed.size()),
+            .offset = offset,
+            .size = size,
+        });
+        m_compressed_size += compressed.size();
+    }
+}
+
+size_t CompressedStream::find_frame(size_t pos) const
+{
+    auto it = std::upper_bound(
+        m_frames.begin(),
+        m_frames.end(),
+        pos,
+        [](size_t value, const Frame& frame) { return value < frame.offset; }
+    );
+    return size_t(it - m_frames.begin()) - 1;
+}
+
+} // namespace sgl
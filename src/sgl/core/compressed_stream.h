@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sgl/core/stream.h"
+#include "sgl/core/enum.h"
+
+#include <deque>
+#include <future>
+#include <vector>
+
+namespace sgl {
+
+enum class CompressionCodec {
+    zstd,
+    lz4,
+};
+
+SGL_ENUM_INFO(
+    CompressionCodec,
+    {
+        {CompressionCodec::zstd, "zstd"},
+        {CompressionCodec::lz4, "lz4"},
+    }
+);
+SGL_ENUM_REGISTER(CompressionCodec);
+
+struct CompressedStreamDesc {
+    /// Compression codec (only used when writing).
+    CompressionCodec codec{CompressionCodec::zstd};
+    /// Compression level (only used when writing). 0 selects the codec's default level.
+    int level{0};
+    /// Size of uncompressed blocks. Each block is compressed into an independent frame.
+    size_t block_size{1024 * 1024};
+    /// Maximum number of blocks compressed in parallel when writing.
+    uint32_t max_blocks_in_flight{16};
+};
+
+/**
+ * \brief Stream adapter compressing data into a seekable zstd or LZ4 container.
+ *
+ * Data is split into fixed size blocks, each compressed into an independent zstd/LZ4 frame
+ * on the global thread pool. The frames are followed by a seek table stored in a skippable
+ * frame (compatible with the zstd seekable format), so the result can be decompressed by the
+ * standard \c zstd / \c lz4 tools and supports random access when reading.
+ *
+ * Write mode only supports sequential writes. Read mode supports arbitrary seeks; blocks
+ * covered by a read are decompressed in parallel.
+ */
+class SGL_API CompressedStream : public Stream {
+    SGL_OBJECT(CompressedStream)
+public:
+    enum class Mode {
+        read,
+        write,
+    };
+
+    SGL_ENUM_INFO(
+        Mode,
+        {
+            {Mode::read, "read"},
+            {Mode::write, "write"},
+        }
+    );
+
+    /**
+     * \brief Constructor.
+     *
+     * \param stream Underlying stream holding the compressed data (and nothing else).
+     * \param mode Stream mode.
+     * \param desc Compression settings.
+     */
+    CompressedStream(ref<Stream> stream, Mode mode, CompressedStreamDesc desc = {});
+    virtual ~CompressedStream();
+
+    Stream* stream() const { return m_stream; }
+    Mode mode() const { return m_mode; }
+    const CompressedStreamDesc& desc() const { return m_desc; }
+
+    /// Codec used by the stream (detected from the data in read mode).
+    CompressionCodec codec() const { return m_codec; }
+
+    bool is_open() const override { return m_is_open; }
+    bool is_readable() const override { return m_mode == Mode::read; }
+    bool is_writable() const override { return m_mode == Mode::write; }
+
+    /// Close the stream. In write mode this compresses all pending data and writes the seek table.
+    void close() override;
+
+    void read(void* p, size_t size) override;
+    void write(const void* p, size_t size) override;
+
+    /// Seek to a position. Only seeking to the current position is supported in write mode.
+    void seek(size_t pos) override;
+
+    /// Not supported.
+    void truncate(size_t size) override;
+
+    size_t tell() const override { return m_pos; }
+
+    /// Uncompressed size of the stream.
+    size_t size() const override { return m_size; }
+
+    /// Compress buffered data into a (possibly partial) block and flush the underlying stream.
+    void flush() override;
+
+    /// Number of frames in the stream.
+    size_t frame_count() const { return m_frames.size(); }
+
+    /// Check if a codec is available in this build.
+    static bool is_codec_supported(CompressionCodec codec);
+
+    /// Check if a stream holds a seekable compressed stream (restores the stream position).
+    static bool detect_compressed_stream(Stream* stream);
+
+    std::string to_string() const override;
+
+private:
+    struct Frame {
+        /// Offset of the compressed frame in the underlying stream.
+        uint64_t compressed_offset;
+        uint32_t compressed_size;
+        /// Offset of the frame's data in the uncompressed stream.
+        uint64_t offset;
+        uint32_t size;
+    };
+
+    void read_seek_table();
+    void write_seek_table();
+
+    void submit_block();
+    void write_completed_blocks(size_t max_in_flight);
+
+    size_t find_frame(size_t pos) const;
+
+    ref<Stream> m_stream;
+    Mode m_mode;
+    CompressedStreamDesc m_desc;
+    CompressionCodec m_codec;
+    bool m_is_open{true};
+
+    size_t m_pos{0};
+    size_t m_size{0};
+    std::vector<Frame> m_frames;
+
+    /// Write mode: uncompressed data of the current block and blocks being compressed.
+    std::vector<uint8_t> m_block;
+    std::deque<std::future<std::vector<uint8_t>>> m_pending_blocks;
+    std::deque<uint32_t> m_pending_block_sizes;
+    uint64_t m_compressed_size{0};
+
+    /// Read mode: most recently decompressed frame.
+    size_t m_cached_frame{size_t(-1)};
+    std::vector<uint8_t> m_cached_data;
+};
+
+SGL_ENUM_REGISTER(CompressedStream::Mode);
+
+} // namespace sgl
@@ -4,6 +4,8 @@
 
 #include "sgl/core/file_stream.h"
 
+#include <algorithm>
+
 // Adapted from https://github.com/redorav/ddspp
 
 // Sources
@@ -697,6 +699,68 @@ std::string DDSFile::to_string() const
     );
 }
 
+DDSFile::Info DDSFile::probe(Stream* stream)
+{
+    size_t pos = stream->tell();
+    size_t size = stream->size() - pos;
+    if (size < MIN_HEADER_SIZE)
+        SGL_THROW("DDS file is too small");
+
+    // Read the header including the optional DX10 extension.
+    uint8_t header[MIN_HEADER_SIZE + sizeof(HeaderDXT10)] = {};
+    size = std::min(size, sizeof(header));
+    stream->read(header, size);
+    stream->seek(pos);
+
+    DDSFile file;
+    if (!file.decode_header(header, size))
+        SGL_THROW("DDS file has invalid header");
+
+    return {
+        .dxgi_format = file.m_dxgi_format,
+        .type = file.m_type,
+        .width = file.m_width,
+        .height = file.m_height,
+        .depth = file.m_depth,
+        .mip_count = file.m_mip_count,
+        .array_size = file.m_array_size,
+        .compressed = file.m_compressed,
+        .srgb = file.m_srgb,
+    };
+}
+
+DDSFile::Info DDSFile::probe(const std::filesystem::path& path)
+{
+    FileStream stream(path, FileStream::Mode::read);
+    return probe(&stream);
+}
+
+std::string DDSFile::Info::to_string() const
+{
+    return fmt::format(
+        "DDSFile.Info(\n"
+        "  dxgi_format = {},\n"
+        "  type = {},\n"
+        "  width = {},\n"
+        "  height = {},\n"
+        "  depth = {},\n"
+        "  mip_count = {},\n"
+        "  array_size = {},\n"
+        "  compressed = {},\n"
+        "  srgb = {}\n"
+        ")",
+        dxgi_format,
+        type,
+        width,
+        height,
+        depth,
+        mip_count,
+        array_size,
+        compressed,
+        srgb
+    );
+}
+
 bool DDSFile::detect_dds_file(Stream* stream)
 {
     size_t pos = stream->tell();
@@ -39,6 +39,35 @@ public:
         }
     );
 
+    /// Texture properties determined from the DDS header only (see \c probe).
+    struct Info {
+        uint32_t dxgi_format{0};
+        TextureType type{TextureType::texture_2d};
+        uint32_t width{0};
+        uint32_t height{0};
+        uint32_t depth{0};
+        uint32_t mip_count{0};
+        uint32_t array_size{0};
+        bool compressed{false};
+        bool srgb{false};
+
+        std::string to_string() const;
+    };
+
+    /**
+     * \brief Determine the texture properties of a DDS file without reading the texture data.
+     *
+     * Only the DDS header (and DX10 header extension) is read from the stream.
+     * The stream position is restored after probing.
+     *
+     * \param stream Stream to probe.
+     * \return Texture properties.
+     */
+    static Info probe(Stream* stream);
+
+    /// Determine the texture properties of a DDS file without reading the texture data.
+    static Info probe(const std::filesystem::path& path);
+
     const uint8_t* data() const { return m_data; }
     size_t size() const { return m_size; }
 
@@ -76,6 +105,8 @@ public:
     static bool detect_dds_file(Stream* stream);
 
 private:
+    DDSFile() = default;
+
     bool decode_header(const uint8_t* data, size_t size);
 
     uint8_t* m_data{nullptr};
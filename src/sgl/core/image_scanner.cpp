@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "image_scanner.h"
+
+#include "sgl/core/error.h"
+#include "sgl/core/file_stream.h"
+#include "sgl/core/string.h"
+#include "sgl/core/thread.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace sgl {
+
+static const std::vector<std::string> DEFAULT_EXTENSIONS = {
+    ".png",
+    ".jpg",
+    ".jpeg",
+    ".bmp",
+    ".tga",
+    ".hdr",
+    ".rgbe",
+    ".exr",
+    ".dds",
+};
+
+/// Number of scheduled blocks per worker thread, to balance files with varying probe times.
+static constexpr size_t BLOCKS_PER_THREAD = 4;
+
+static void probe_entry(ImageScanEntry& entry)
+{
+    try {
+        FileStream stream(entry.path, FileStream::Mode::read);
+        if (DDSFile::detect_dds_file(&stream))
+            entry.dds_info = DDSFile::probe(&stream);
+        else
+            entry.bitmap_info = Bitmap::probe(&stream);
+    } catch (const std::exception& e) {
+        entry.error = e.what();
+    }
+}
+
+std::vector<ImageScanEntry> scan_image_directory(
+    const std::filesystem::path& directory,
+    const ImageScanDesc& desc,
+    std::span<const ImageScanEntry> previous
+)
+{
+    SGL_CHECK(std::filesystem::is_directory(directory), "\"{}\" is not a directory.", directory);
+
+    const std::vector<std::string>& extensions = desc.extensions.empty() ? DEFAULT_EXTENSIONS : desc.extensions;
+
+    // Collect image files.
+    std::vector<ImageScanEntry> entries;
+    auto add_entry = [&](const std::filesystem::directory_entry& dir_entry)
+    {
+        std::error_code ec;
+        if (!dir_entry.is_regular_file(ec))
+            return;
+        std::string extension = string::to_lower(dir_entry.path().extension().string());
+        if (std::find(extensions.begin(), extensions.end(), extension) == extensions.end())
+            return;
+        entries.push_back({
+            .path = dir_entry.path(),
+            .file_size = dir_entry.file_size(ec),
+            .last_write_time = dir_entry.last_write_time(ec),
+        });
+    };
+    auto options = std::filesystem::directory_options::skip_permission_denied;
+    if (desc.recursive) {
+        for (const auto& dir_entry : std::filesystem::recursive_directory_iterator(directory, options))
+            add_entry(dir_entry);
+    } else {
+        for (const auto& dir_entry : std::filesystem::directory_iterator(directory, options))
+            add_entry(dir_entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.path < b.path; });
+
+    // Reuse entries of unchanged files from the previous scan.
+    std::unordered_map<std::filesystem::path::string_type, const ImageScanEntry*> previous_entries;
+    previous_entries.reserve(previous.size());
+    for (const ImageScanEntry& entry : previous)
+        previous_entries.emplace(entry.path.native(), &entry);
+
+    std::vector<ImageScanEntry*> pending;
+    pending.reserve(entries.size());
+    for (ImageScanEntry& entry : entries) {
+        auto it = previous_entries.find(entry.path.native());
+        if (it != previous_entries.end() && it->second->file_size == entry.file_size
+            && it->second->last_write_time == entry.last_write_time)
+            entry = *it->second;
+        else
+            pending.push_back(&entry);
+    }
+
+    // Probe new and modified files in parallel.
+    auto probe_block = [&pending](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+            probe_entry(*pending[i]);
+    };
+    size_t block_count = thread::global_thread_pool().get_thread_count() * BLOCKS_PER_THREAD;
+    thread::parallel_for(size_t(0), pending.size(), probe_block, block_count);
+
+    return entries;
+}
+
+} // namespace sgl
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sgl/core/macros.h"
+#include "sgl/core/bitmap.h"
+#include "sgl/core/dds_file.h"
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace sgl {
+
+/// Image file found by \c scan_image_directory.
+struct ImageScanEntry {
+    /// Path of the image file.
+    std::filesystem::path path;
+    /// Size of the file in bytes.
+    uint64_t file_size{0};
+    /// Last modification time of the file.
+    std::filesystem::file_time_type last_write_time;
+    /// Image properties (set for all formats supported by \c Bitmap).
+    std::optional<Bitmap::Info> bitmap_info;
+    /// Texture properties (set for DDS files).
+    std::optional<DDSFile::Info> dds_info;
+    /// Error message if the file header could not be read (empty on success).
+    std::string error;
+};
+
+struct ImageScanDesc {
+    /// Scan sub-directories.
+    bool recursive{true};
+    /// File extensions to include (lower case, including the leading dot).
+    /// If empty, all file extensions of formats supported by \c Bitmap and \c DDSFile are included.
+    std::vector<std::string> extensions;
+};
+
+/**
+ * \brief Scan a directory for image files and probe their headers in parallel.
+ *
+ * Files are probed on the global thread pool, reading only the file headers
+ * (see \c Bitmap::probe and \c DDSFile::probe). Files that fail to probe are
+ * reported with an error message instead of throwing.
+ *
+ * To update an existing catalogue incrementally, pass the entries of a previous scan.
+ * Entries of files with unchanged size and modification time are reused without probing.
+ *
+ * \param directory Directory to scan.
+ * \param desc Scan options.
+ * \param previous Entries of a previous scan to reuse.
+ * \return List of image files, sorted by path.
+ */
+SGL_API std::vector<ImageScanEntry> scan_image_directory(
+    const std::filesystem::path& directory,
+    const ImageScanDesc& desc = {},
+    std::span<const ImageScanEntry> previous = {}
+);
+
+} // namespace sgl
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "memory_pool.h"
+
+#include "sgl/core/error.h"
+#include "sgl/core/format.h"
+#include "sgl/core/maths.h"
+#include "sgl/core/platform.h"
+#include "sgl/core/string.h"
+
+#include "sgl/stl/bit.h"
+
+namespace sgl {
+
+/// Size of a huge page (2 MB on x86-64 and most ARM64 configurations).
+static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/// Number of size classes per power of two.
+static constexpr size_t SIZE_CLASS_STEPS = 8;
+
+MemoryPool::MemoryPool(MemoryPoolDesc desc)
+    : m_desc(std::move(desc))
+{
+    SGL_CHECK(m_desc.alignment > 0 && is_power_of_two(m_desc.alignment), "Alignment must be a power of two.");
+}
+
+MemoryPool::~MemoryPool()
+{
+    trim();
+}
+
+void* MemoryPool::allocate(size_t size)
+{
+    size = block_size(size);
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_stats.allocation_count++;
+        if (m_desc.enable_pooling) {
+            auto it = m_free_blocks.find(size);
+            if (it != m_free_blocks.end() && !it->second.empty()) {
+                void* ptr = it->second.back();
+                it->second.pop_back();
+                m_stats.pool_hit_count++;
+                m_stats.pooled_size -= size;
+                return ptr;
+            }
+        }
+        m_stats.allocated_size += size;
+    }
+
+    return allocate_block(size);
+}
+
+void MemoryPool::release(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    size = block_size(size);
+
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_desc.enable_pooling && m_stats.pooled_size + size <= m_desc.max_pooled_size) {
+            m_free_blocks[size].push_back(ptr);
+            m_stats.pooled_size += size;
+            return;
+        }
+        m_stats.allocated_size -= size;
+    }
+
+    release_block(ptr, size);
+}
+
+void MemoryPool::trim()
+{
+    std::map<size_t, std::vector<void*>> free_blocks;
+    {
+        std::lock_guard lock(m_mutex);
+        free_blocks = std::move(m_free_blocks);
+        m_free_blocks.clear();
+        m_stats.allocated_size -= m_stats.pooled_size;
+        m_stats.pooled_size = 0;
+    }
+
+    for (const auto& [size, blocks] : free_blocks)
+        for (void* ptr : blocks)
+            release_block(ptr, size);
+}
+
+MemoryPool::Stats MemoryPool::stats() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+size_t MemoryPool::size_class(size_t size)
+{
+    if (size <= SIZE_CLASS_STEPS)
+        return SIZE_CLASS_STEPS;
+    // Round up to the next multiple of 1/8th of the largest power of two below size.
+    size_t step = stdx::bit_floor(size - 1) / SIZE_CLASS_STEPS;
+    return align_to(step, size);
+}
+
+std::string MemoryPool::to_string() const
+{
+    Stats stats = this->stats();
+    return fmt::format(
+        "MemoryPool(\n"
+        "  alignment = {},\n"
+        "  enable_pooling = {},\n"
+        "  max_pooled_size = {},\n"
+        "  huge_page_threshold = {},\n"
+        "  allocated_size = {},\n"
+        "  pooled_size = {}\n"
+        ")",
+        m_desc.alignment,
+        m_desc.enable_pooling,
+        string::format_byte_size(m_desc.max_pooled_size),
+        string::format_byte_size(m_desc.huge_page_threshold),
+        string::format_byte_size(stats.allocated_size),
+        string::format_byte_size(stats.pooled_size)
+    );
+}
+
+size_t MemoryPool::block_size(size_t size) const
+{
+    size = std::max(size, size_t(1));
+    if (m_desc.enable_pooling)
+        size = size_class(size);
+    return align_to(m_desc.alignment, size);
+}
+
+size_t MemoryPool::block_alignment(size_t size) const
+{
+    if (m_desc.huge_page_threshold > 0 && size >= m_desc.huge_page_threshold)
+        return std::max(m_desc.alignment, HUGE_PAGE_SIZE);
+    static const size_t page_size = platform::page_size();
+    if (size >= page_size)
+        return std::max(m_desc.alignment, page_size);
+    return m_desc.alignment;
+}
+
+void* MemoryPool::allocate_block(size_t size)
+{
+    size_t alignment = block_alignment(size);
+    void* ptr = platform::aligned_alloc(size, alignment);
+    if (!ptr)
+        SGL_THROW("Failed to allocate {} of memory.", string::format_byte_size(size));
+    if (alignment >= HUGE_PAGE_SIZE)
+        platform::advise_huge_pages(ptr, size);
+    return ptr;
+}
+
+void MemoryPool::release_block(void* ptr, size_t size)
+{
+    SGL_UNUSED(size);
+    platform::aligned_free(ptr);
+}
+
+} // namespace sgl
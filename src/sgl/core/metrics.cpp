@@ -0,0 +1,352 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "metrics.h"
+
+#include "sgl/core/error.h"
+#include "sgl/core/format.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sgl {
+
+namespace detail {
+    uint32_t next_metric_shard_index()
+    {
+        static std::atomic<uint32_t> s_next_index{0};
+        return s_next_index.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARD_COUNT;
+    }
+} // namespace detail
+
+static void atomic_add(std::atomic<double>& atomic, double value)
+{
+    double current = atomic.load(std::memory_order_relaxed);
+    while (!atomic.compare_exchange_weak(current, current + value, std::memory_order_relaxed))
+        ;
+}
+
+// ----------------------------------------------------------------------------
+// Counter
+// ----------------------------------------------------------------------------
+
+uint64_t Counter::value() const
+{
+    uint64_t value = 0;
+    for (const Shard& shard : m_shards)
+        value += shard.value.load(std::memory_order_relaxed);
+    return value;
+}
+
+void Counter::reset()
+{
+    for (Shard& shard : m_shards)
+        shard.value.store(0, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+// Gauge
+// ----------------------------------------------------------------------------
+
+void Gauge::add(double value)
+{
+    atomic_add(m_value, value);
+}
+
+void Gauge::set_function(std::function<double()> function)
+{
+    std::lock_guard lock(m_function_mutex);
+    m_function = std::move(function);
+}
+
+double Gauge::value() const
+{
+    {
+        std::lock_guard lock(m_function_mutex);
+        if (m_function)
+            return m_function();
+    }
+    return m_value.load(std::memory_order_relaxed);
+}
+
+void Gauge::reset()
+{
+    m_value.store(0.0, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+// Histogram
+// ----------------------------------------------------------------------------
+
+Histogram::Histogram(std::string name, std::string help, std::vector<double> bounds)
+    : Metric(MetricType::histogram, std::move(name), std::move(help))
+    , m_bounds(std::move(bounds))
+{
+    SGL_CHECK(std::is_sorted(m_bounds.begin(), m_bounds.end()), "Histogram bounds must be sorted.");
+    for (Shard& shard : m_shards) {
+        shard.counts = std::make_unique<std::atomic<uint64_t>[]>(m_bounds.size() + 1);
+        for (size_t i = 0; i <= m_bounds.size(); ++i)
+            shard.counts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::observe(double value)
+{
+    size_t bucket = std::lower_bound(m_bounds.begin(), m_bounds.end(), value) - m_bounds.begin();
+    Shard& shard = m_shards[detail::metric_shard_index()];
+    shard.counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    atomic_add(shard.sum, value);
+}
+
+std::vector<uint64_t> Histogram::bucket_counts() const
+{
+    std::vector<uint64_t> counts(m_bounds.size() + 1, 0);
+    for (const Shard& shard : m_shards)
+        for (size_t i = 0; i < counts.size(); ++i)
+            counts[i] += shard.counts[i].load(std::memory_order_relaxed);
+    return counts;
+}
+
+uint64_t Histogram::count() const
+{
+    uint64_t count = 0;
+    for (uint64_t bucket_count : bucket_counts())
+        count += bucket_count;
+    return count;
+}
+
+double Histogram::sum() const
+{
+    double sum = 0.0;
+    for (const Shard& shard : m_shards)
+        sum += shard.sum.load(std::memory_order_relaxed);
+    return sum;
+}
+
+void Histogram::reset()
+{
+    for (Shard& shard : m_shards) {
+        for (size_t i = 0; i <= m_bounds.size(); ++i)
+            shard.counts[i].store(0, std::memory_order_relaxed);
+        shard.sum.store(0.0, std::memory_order_relaxed);
+    }
+}
+
+std::vector<double> Histogram::exponential_bounds(double start, double factor, size_t count)
+{
+    SGL_CHECK(start > 0.0, "Start must be positive.");
+    SGL_CHECK(factor > 1.0, "Factor must be greater than 1.");
+    std::vector<double> bounds(count);
+    for (size_t i = 0; i < count; ++i, start *= factor)
+        bounds[i] = start;
+    return bounds;
+}
+
+// ----------------------------------------------------------------------------
+// MetricsRegistry
+// ----------------------------------------------------------------------------
+
+MetricsRegistry& MetricsRegistry::get()
+{
+    // Intentionally leaked, metrics can be referenced from static variables
+    // and updated during static destruction.
+    static MetricsRegistry* s_registry = new MetricsRegistry();
+    return *s_registry;
+}
+
+template<typename T, typename... Args>
+T& MetricsRegistry::get_or_create(MetricType type, std::string_view name, Args&&... args)
+{
+    std::lock_guard lock(m_mutex);
+    auto it = m_metrics.find(name);
+    if (it != m_metrics.end()) {
+        SGL_CHECK(
+            it->second->type() == type,
+            "Metric \"{}\" is already registered as a {}.",
+            name,
+            it->second->type()
+        );
+        return static_cast<T&>(*it->second);
+    }
+    auto metric = std::make_unique<T>(std::string(name), std::forward<Args>(args)...);
+    T& result = *metric;
+    m_metrics.emplace(std::string(name), std::move(metric));
+    return result;
+}
+
+Counter& MetricsRegistry::counter(std::string_view name, std::string_view help)
+{
+    return get_or_create<Counter>(MetricType::counter, name, std::string(help));
+}
+
+Gauge& MetricsRegistry::gauge(std::string_view name, std::string_view help)
+{
+    return get_or_create<Gauge>(MetricType::gauge, name, std::string(help));
+}
+
+Histogram& MetricsRegistry::histogram(std::string_view name, std::string_view help, std::vector<double> bounds)
+{
+    return get_or_create<Histogram>(MetricType::histogram, name, std::string(help), std::move(bounds));
+}
+
+MetricsSnapshot MetricsRegistry::snapshot() const
+{
+    std::lock_guard lock(m_mutex);
+    MetricsSnapshot snapshot;
+    snapshot.reserve(m_metrics.size());
+    for (const auto& [name, metric] : m_metrics) {
+        MetricSample sample{
+            .type = metric->type(),
+            .name = metric->name(),
+            .help = metric->help(),
+        };
+        switch (metric->type()) {
+        case MetricType::counter:
+            sample.value = double(static_cast<const Counter&>(*metric).value());
+            break;
+        case MetricType::gauge:
+            sample.value = static_cast<const Gauge&>(*metric).value();
+            break;
+        case MetricType::histogram: {
+            const Histogram& histogram = static_cast<const Histogram&>(*metric);
+            std::vector<uint64_t> counts = histogram.bucket_counts();
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i < counts.size(); ++i) {
+                cumulative += counts[i];
+                double bound
+                    = i < histogram.bounds().size() ? histogram.bounds()[i] : std::numeric_limits<double>::infinity();
+                sample.buckets.emplace_back(bound, cumulative);
+            }
+            sample.count = cumulative;
+            sample.value = histogram.sum();
+            break;
+        }
+        }
+        snapshot.push_back(std::move(sample));
+    }
+    return snapshot;
+}
+
+void MetricsRegistry::reset()
+{
+    std::lock_guard lock(m_mutex);
+    for (auto& [name, metric] : m_metrics)
+        metric->reset();
+}
+
+std::string MetricsRegistry::to_prometheus() const
+{
+    return to_prometheus(snapshot());
+}
+
+std::string MetricsRegistry::to_json() const
+{
+    return to_json(snapshot());
+}
+
+static std::string format_number(double value)
+{
+    if (std::isinf(value))
+        return value > 0.0 ? "+Inf" : "-Inf";
+    if (std::isnan(value))
+        return "NaN";
+    return fmt::format("{}", value);
+}
+
+std::string MetricsRegistry::to_prometheus(std::span<const MetricSample> snapshot)
+{
+    auto escape_help = [](std::string_view str)
+    {
+        std::string result;
+        for (char c : str) {
+            if (c == '\\')
+                result += "\\\\";
+            else if (c == '\n')
+                result += "\\n";
+            else
+                result += c;
+        }
+        return result;
+    };
+
+    std::string result;
+    for (const MetricSample& sample : snapshot) {
+        if (!sample.help.empty())
+            result += fmt::format("# HELP {} {}\n", sample.name, escape_help(sample.help));
+        result += fmt::format("# TYPE {} {}\n", sample.name, sample.type);
+        if (sample.type == MetricType::histogram) {
+            for (const auto& [bound, count] : sample.buckets)
+                result += fmt::format("{}_bucket{{le=\"{}\"}} {}\n", sample.name, format_number(bound), count);
+            result += fmt::format("{}_sum {}\n", sample.name, format_number(sample.value));
+            result += fmt::format("{}_count {}\n", sample.name, sample.count);
+        } else {
+            result += fmt::format("{} {}\n", sample.name, format_number(sample.value));
+        }
+    }
+    return result;
+}
+
+std::string MetricsRegistry::to_json(std::span<const MetricSample> snapshot)
+{
+    auto escape_string = [](std::string_view str)
+    {
+        std::string result;
+        for (char c : str) {
+            switch (c) {
+            case '"':
+                result += "\\\"";
+                break;
+            case '\\':
+                result += "\\\\";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            case '\t':
+                result += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    result += fmt::format("\\u{:04x}", int(c));
+                else
+                    result += c;
+            }
+        }
+        return result;
+    };
+
+    // JSON has no representation for infinity/NaN, use null instead.
+    auto json_number = [](double value) { return std::isfinite(value) ? fmt::format("{}", value) : "null"; };
+
+    std::string result = "{\"metrics\":[";
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        const MetricSample& sample = snapshot[i];
+        if (i > 0)
+            result += ",";
+        result += fmt::format(
+            "{{\"name\":\"{}\",\"type\":\"{}\",\"help\":\"{}\",\"value\":{}",
+            escape_string(sample.name),
+            sample.type,
+            escape_string(sample.help),
+            json_number(sample.value)
+        );
+        if (sample.type == MetricType::histogram) {
+            result += fmt::format(",\"count\":{},\"buckets\":[", sample.count);
+            for (size_t j = 0; j < sample.buckets.size(); ++j) {
+                if (j > 0)
+                    result += ",";
+                result += fmt::format(
+                    "{{\"le\":{},\"count\":{}}}",
+                    json_number(sample.buckets[j].first),
+                    sample.buckets[j].second
+                );
+            }
+            result += "]";
+        }
+        result += "}";
+    }
+    result += "]}";
+    return result;
+}
+
+} // namespace sgl
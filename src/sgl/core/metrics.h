@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sgl/core/macros.h"
+#include "sgl/core/enum.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sgl {
+
+/// Number of shards used by sharded metrics (counters and histograms).
+static constexpr size_t METRIC_SHARD_COUNT = 16;
+
+namespace detail {
+    SGL_API uint32_t next_metric_shard_index();
+
+    /// Returns the shard index of the calling thread.
+    inline uint32_t metric_shard_index()
+    {
+        static thread_local uint32_t index = next_metric_shard_index();
+        return index;
+    }
+} // namespace detail
+
+enum class MetricType {
+    counter,
+    gauge,
+    histogram,
+};
+
+SGL_ENUM_INFO(
+    MetricType,
+    {
+        {MetricType::counter, "counter"},
+        {MetricType::gauge, "gauge"},
+        {MetricType::histogram, "histogram"},
+    }
+);
+SGL_ENUM_REGISTER(MetricType);
+
+/// Base class for metrics.
+class SGL_API Metric {
+public:
+    Metric(MetricType type, std::string name, std::string help)
+        : m_type(type)
+        , m_name(std::move(name))
+        , m_help(std::move(help))
+    {
+    }
+    virtual ~Metric() = default;
+
+    SGL_NON_COPYABLE_AND_MOVABLE(Metric);
+
+    MetricType type() const { return m_type; }
+    const std::string& name() const { return m_name; }
+    const std::string& help() const { return m_help; }
+
+    /// Reset the metric to its initial state.
+    virtual void reset() = 0;
+
+private:
+    MetricType m_type;
+    std::string m_name;
+    std::string m_help;
+};
+
+/**
+ * \brief Monotonically increasing counter.
+ *
+ * The counter is sharded across threads to avoid cache line contention on hot paths.
+ * Incrementing is a single relaxed atomic add on a thread-local shard.
+ */
+class SGL_API Counter : public Metric {
+public:
+    Counter(std::string name, std::string help)
+        : Metric(MetricType::counter, std::move(name), std::move(help))
+    {
+    }
+
+    /// Increment the counter.
+    void add(uint64_t value = 1)
+    {
+        m_shards[detail::metric_shard_index()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /// Current value (sum over all shards).
+    uint64_t value() const;
+
+    void reset() override;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+    std::array<Shard, METRIC_SHARD_COUNT> m_shards;
+};
+
+/**
+ * \brief Gauge that can go up and down.
+ *
+ * Alternatively to setting the value explicitly, a function can be installed that is
+ * evaluated whenever the gauge value is queried (e.g. to report a queue depth).
+ */
+class SGL_API Gauge : public Metric {
+public:
+    Gauge(std::string name, std::string help)
+        : Metric(MetricType::gauge, std::move(name), std::move(help))
+    {
+    }
+
+    /// Set the gauge value.
+    void set(double value) { m_value.store(value, std::memory_order_relaxed); }
+
+    /// Add to the gauge value.
+    void add(double value);
+
+    /// Subtract from the gauge value.
+    void sub(double value) { add(-value); }
+
+    /// Set a function that is evaluated to determine the gauge value.
+    void set_function(std::function<double()> function);
+
+    /// Current value.
+    double value() const;
+
+    void reset() override;
+
+private:
+    std::atomic<double> m_value{0.0};
+    mutable std::mutex m_function_mutex;
+    std::function<double()> m_function;
+};
+
+/**
+ * \brief Histogram of observed values.
+ *
+ * Observations are counted in buckets defined by their (inclusive) upper bounds.
+ * An implicit last bucket collects all observations larger than the last bound.
+ * Bucket counts are sharded across threads.
+ */
+class SGL_API Histogram : public Metric {
+public:
+    Histogram(std::string name, std::string help, std::vector<double> bounds);
+
+    /// Record an observation.
+    void observe(double value);
+
+    /// Upper bounds of the buckets (excluding the implicit +inf bucket).
+    const std::vector<double>& bounds() const { return m_bounds; }
+
+    /// Number of observations per bucket (non-cumulative, including the +inf bucket).
+    std::vector<uint64_t> bucket_counts() const;
+
+    /// Total number of observations.
+    uint64_t count() const;
+
+    /// Sum of all observations.
+    double sum() const;
+
+    void reset() override;
+
+    /// Exponentially spaced bucket bounds: start, start * factor, start * factor^2, ...
+    static std::vector<double> exponential_bounds(double start, double factor, size_t count);
+
+private:
+    struct alignas(64) Shard {
+        std::unique_ptr<std::atomic<uint64_t>[]> counts;
+        std::atomic<double> sum{0.0};
+    };
+
+    std::vector<double> m_bounds;
+    std::array<Shard, METRIC_SHARD_COUNT> m_shards;
+};
+
+/// Snapshot of a single metric.
+struct MetricSample {
+    MetricType type;
+    std::string name;
+    std::string help;
+    /// Counter or gauge value. For histograms, the sum of all observations.
+    double value{0.0};
+    /// Histogram only: total number of observations.
+    uint64_t count{0};
+    /// Histogram only: (upper bound, cumulative count) pairs, including the +inf bucket.
+    std::vector<std::pair<double, uint64_t>> buckets;
+};
+
+using MetricsSnapshot = std::vector<MetricSample>;
+
+/**
+ * \brief Global registry of runtime metrics.
+ *
+ * Metrics are registered by name and live for the lifetime of the process, so references
+ * returned from the registry can be cached (typically in a static variable) and used on hot paths.
+ * Registering a metric with an existing name returns the existing metric.
+ *
+ * The registry can be snapshotted and exported in Prometheus text format or as JSON.
+ */
+class SGL_API MetricsRegistry {
+public:
+    SGL_NON_COPYABLE_AND_MOVABLE(MetricsRegistry);
+
+    /// Returns the global metrics registry.
+    static MetricsRegistry& get();
+
+    /// Register (or lookup) a counter.
+    Counter& counter(std::string_view name, std::string_view help = {});
+
+    /// Register (or lookup) a gauge.
+    Gauge& gauge(std::string_view name, std::string_view help = {});
+
+    /// Register (or lookup) a histogram.
+    Histogram& histogram(std::string_view name, std::string_view help, std::vector<double> bounds);
+
+    /// Take a snapshot of all registered metrics (sorted by name).
+    MetricsSnapshot snapshot() const;
+
+    /// Reset all registered metrics.
+    void reset();
+
+    /// Export all metrics in Prometheus text exposition format.
+    std::string to_prometheus() const;
+
+    /// Export all metrics as JSON.
+    std::string to_json() const;
+
+    /// Convert a snapshot to Prometheus text exposition format.
+    static std::string to_prometheus(std::span<const MetricSample> snapshot);
+
+    /// Convert a snapshot to JSON.
+    static std::string to_json(std::span<const MetricSample> snapshot);
+
+private:
+    MetricsRegistry() = default;
+
+    template<typename T, typename... Args>
+    T& get_or_create(MetricType type, std::string_view name, Args&&... args);
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, std::unique_ptr<Metric>, std::less<>> m_metrics;
+};
+
+} // namespace sgl
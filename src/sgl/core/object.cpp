@@ -13,6 +13,7 @@ namespace sgl {
 
 static void (*object_inc_ref_py)(PyObject*) noexcept = nullptr;
 static void (*object_dec_ref_py)(PyObject*) noexcept = nullptr;
+static bool (*object_try_inc_ref_py)(PyObject*) noexcept = nullptr;
 
 #if SGL_ENABLE_OBJECT_TRACKING
 static std::mutex s_tracked_objects_mutex;
@@ -58,16 +59,15 @@ void Object::dec_ref(bool dealloc) const noexcept
             if (value == 1) {
                 fprintf(stderr, "Object::dec_ref(%p): reference count underflow!", this);
                 abort();
-            } else if (value == 3) {
-                if (dealloc) {
+            }
+            // Release our writes to the object, the thread removing the last
+            // reference acquires them before destroying the instance.
+            if (!m_state.compare_exchange_weak(value, value - 2, std::memory_order_release, std::memory_order_relaxed))
+                continue;
+            if (value == 3) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (dealloc)
                     delete this;
-                } else {
-                    m_state.store(1, std::memory_order_relaxed);
-                }
-            } else {
-                if (!m_state
-                         .compare_exchange_weak(value, value - 2, std::memory_order_relaxed, std::memory_order_relaxed))
-                    continue;
             }
         } else {
             object_dec_ref_py((PyObject*)value);
@@ -76,6 +76,24 @@ void Object::dec_ref(bool dealloc) const noexcept
     }
 }
 
+bool Object::try_inc_ref() const noexcept
+{
+    uintptr_t value = m_state.load(std::memory_order_relaxed);
+
+    while (true) {
+        if (value & 1) {
+            // No references left, the object is being destroyed.
+            if (value == 1)
+                return false;
+            if (!m_state.compare_exchange_weak(value, value + 2, std::memory_order_relaxed, std::memory_order_relaxed))
+                continue;
+            return true;
+        } else {
+            return object_try_inc_ref_py((PyObject*)value);
+        }
+    }
+}
+
 uint64_t Object::ref_count() const
 {
     uintptr_t value = m_state.load(std::memory_order_relaxed);
@@ -88,15 +106,24 @@ uint64_t Object::ref_count() const
 void Object::set_self_py(PyObject* o) noexcept
 {
     uintptr_t value = m_state.load(std::memory_order_relaxed);
-    if (value & 1) {
-        value >>= 1;
-        for (uintptr_t i = 0; i < value; ++i)
+
+    while (true) {
+        if (!(value & 1)) {
+            fprintf(stderr, "Object::set_self_py(%p): a Python object was already present!", this);
+            abort();
+        }
+
+        // Move the references to the Python object before publishing it. Other threads
+        // may concurrently add or remove C++ references, in which case we retry.
+        uintptr_t count = value >> 1;
+        for (uintptr_t i = 0; i < count; ++i)
             object_inc_ref_py(o);
 
-        m_state.store((uintptr_t)o);
-    } else {
-        fprintf(stderr, "Object::set_self_py(%p): a Python object was already present!", this);
-        abort();
+        if (m_state.compare_exchange_weak(value, (uintptr_t)o, std::memory_order_acq_rel, std::memory_order_relaxed))
+            break;
+
+        for (uintptr_t i = 0; i < count; ++i)
+            object_dec_ref_py(o);
     }
 }
 
@@ -180,10 +207,15 @@ void Object::set_enable_ref_tracking(bool enable)
 
 #endif // SGL_ENABLE_REF_TRACKING
 
-void object_init_py(void (*object_inc_ref_py_)(PyObject*) noexcept, void (*object_dec_ref_py_)(PyObject*) noexcept)
+void object_init_py(
+    void (*object_inc_ref_py_)(PyObject*) noexcept,
+    void (*object_dec_ref_py_)(PyObject*) noexcept,
+    bool (*object_try_inc_ref_py_)(PyObject*) noexcept
+)
 {
     object_inc_ref_py = object_inc_ref_py_;
     object_dec_ref_py = object_dec_ref_py_;
+    object_try_inc_ref_py = object_try_inc_ref_py_;
 }
 
 } // namespace sgl
@@ -122,6 +122,17 @@ public:
     /// Decrease the object's reference count and potentially deallocate it.
     void dec_ref(bool dealloc = true) const noexcept;
 
+    /**
+     * \brief Increase the object's reference count unless it already dropped to zero.
+     *
+     * Used by caches holding non-owning pointers, where another thread may be removing the
+     * last reference concurrently. The caller must guarantee that the memory stays valid,
+     * typically by holding a lock that the destructor also takes.
+     *
+     * \return True if a reference was added, false if the object is being destroyed.
+     */
+    bool try_inc_ref() const noexcept;
+
     /// Return current reference count.
     uint64_t ref_count() const;
 
@@ -187,10 +198,14 @@ public:
  *
  * Python binding code must invoke `object_init_py` and provide functions that
  * can be used to increase/decrease the Python reference count of an instance
- * (i.e., `Py_INCREF` / `Py_DECREF`).
+ * (i.e., `Py_INCREF` / `Py_DECREF`), and to increase it only if it is non-zero
+ * (see `Object::try_inc_ref()`).
  */
-SGL_API void
-object_init_py(void (*object_inc_ref_py)(PyObject*) noexcept, void (*object_dec_ref_py)(PyObject*) noexcept);
+SGL_API void object_init_py(
+    void (*object_inc_ref_py)(PyObject*) noexcept,
+    void (*object_dec_ref_py)(PyObject*) noexcept,
+    bool (*object_try_inc_ref_py)(PyObject*) noexcept
+);
 
 
 #if SGL_ENABLE_REF_TRACKING
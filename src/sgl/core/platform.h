@@ -3,6 +3,7 @@
 #pragma once
 
 #include "sgl/core/macros.h"
+#include "sgl/core/enum.h"
 
 #include <filesystem>
 #include <functional>
@@ -179,6 +180,60 @@ struct MemoryStats {
 /// Get the current memory stats.
 [[nodiscard]] SGL_API MemoryStats memory_stats();
 
+/// Allocate a block of memory with the given alignment (must be a power of two).
+/// Memory needs to be released with \c aligned_free.
+/// \return Pointer to the allocated memory or nullptr if allocation failed.
+[[nodiscard]] SGL_API void* aligned_alloc(size_t size, size_t alignment);
+
+/// Release a block of memory allocated with \c aligned_alloc.
+SGL_API void aligned_free(void* ptr);
+
+/// Advise the OS to back the given memory range with (transparent) huge pages.
+/// The memory range should be page aligned.
+/// \return True if the advice was accepted.
+SGL_API bool advise_huge_pages(void* ptr, size_t size);
+
+// -------------------------------------------------------------------------------------------------
+// Threads
+// -------------------------------------------------------------------------------------------------
+
+/// Thread priority classes.
+enum class ThreadPriority {
+    low,
+    normal,
+    high,
+};
+
+SGL_ENUM_INFO(
+    ThreadPriority,
+    {
+        {ThreadPriority::low, "low"},
+        {ThreadPriority::normal, "normal"},
+        {ThreadPriority::high, "high"},
+    }
+);
+SGL_ENUM_REGISTER(ThreadPriority);
+
+/// The number of logical processors.
+[[nodiscard]] SGL_API uint32_t processor_count();
+
+/// The number of NUMA nodes (1 on systems without NUMA).
+[[nodiscard]] SGL_API uint32_t numa_node_count();
+
+/// Get the logical processors belonging to a NUMA node.
+[[nodiscard]] SGL_API std::vector<uint32_t> numa_node_processors(uint32_t node);
+
+/// Set the name of the calling thread (shown in debuggers and profilers).
+SGL_API void set_thread_name(std::string_view name);
+
+/// Restrict the calling thread to run on the given logical processors.
+/// \return True if the affinity was set.
+SGL_API bool set_thread_affinity(std::span<const uint32_t> processors);
+
+/// Set the priority of the calling thread.
+/// \return True if the priority was set.
+SGL_API bool set_thread_priority(ThreadPriority priority);
+
 // -------------------------------------------------------------------------------------------------
 // Shared libraries
 // -------------------------------------------------------------------------------------------------
@@ -13,13 +13,21 @@
 #include <dlfcn.h>
 #include <signal.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 #include <pwd.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
 #include <linux/limits.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <regex>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 namespace sgl::platform {
 
@@ -212,6 +220,117 @@ MemoryStats memory_stats()
     return stats;
 }
 
+void* aligned_alloc(size_t size, size_t alignment)
+{
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, std::max(alignment, sizeof(void*)), size) != 0)
+        return nullptr;
+    return ptr;
+}
+
+void aligned_free(void* ptr)
+{
+    free(ptr);
+}
+
+bool advise_huge_pages(void* ptr, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+    return madvise(ptr, size, MADV_HUGEPAGE) == 0;
+#else
+    SGL_UNUSED(ptr, size);
+    return false;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+// Threads
+// -------------------------------------------------------------------------------------------------
+
+uint32_t processor_count()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? uint32_t(count) : 1;
+}
+
+/// Parse a sysfs cpu list (e.g. "0-3,8-11").
+static std::vector<uint32_t> parse_cpu_list(const std::string& str)
+{
+    std::vector<uint32_t> cpus;
+    std::istringstream stream(str);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        uint32_t first, last;
+        int count = std::sscanf(range.c_str(), "%u-%u", &first, &last);
+        if (count == 1)
+            cpus.push_back(first);
+        else if (count == 2)
+            for (uint32_t cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+uint32_t numa_node_count()
+{
+    uint32_t count = 0;
+    while (std::filesystem::exists(fmt::format("/sys/devices/system/node/node{}", count)))
+        ++count;
+    return std::max(count, 1u);
+}
+
+std::vector<uint32_t> numa_node_processors(uint32_t node)
+{
+    std::ifstream file(fmt::format("/sys/devices/system/node/node{}/cpulist", node));
+    std::string cpu_list;
+    if (file && std::getline(file, cpu_list))
+        return parse_cpu_list(cpu_list);
+
+    // No NUMA information available, treat the system as a single node.
+    std::vector<uint32_t> cpus;
+    if (node == 0)
+        for (uint32_t cpu = 0; cpu < processor_count(); ++cpu)
+            cpus.push_back(cpu);
+    return cpus;
+}
+
+void set_thread_name(std::string_view name)
+{
+    // Thread names are limited to 16 characters including the null terminator.
+    std::string truncated{name.substr(0, 15)};
+    pthread_setname_np(pthread_self(), truncated.c_str());
+}
+
+bool set_thread_affinity(std::span<const uint32_t> processors)
+{
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (uint32_t processor : processors)
+        if (processor < CPU_SETSIZE)
+            CPU_SET(processor, &cpu_set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+}
+
+bool set_thread_priority(ThreadPriority priority)
+{
+    // On Linux, the nice value applies to individual threads when using the thread id.
+    // Raising the priority above normal requires CAP_SYS_NICE.
+    int nice_value = 0;
+    switch (priority) {
+    case ThreadPriority::low:
+        nice_value = 10;
+        break;
+    case ThreadPriority::normal:
+        nice_value = 0;
+        break;
+    case ThreadPriority::high:
+        nice_value = -5;
+        break;
+    }
+    pid_t tid = pid_t(syscall(SYS_gettid));
+    return setpriority(PRIO_PROCESS, id_t(tid), nice_value) == 0;
+}
+
 // -------------------------------------------------------------------------------------------------
 // Shared libraries
 // -------------------------------------------------------------------------------------------------
@@ -18,7 +18,11 @@
 #include <mach/mach.h>
 #include <sys/time.h>
 #include <sys/resource.h>
+#include <pthread.h>
+#include <pthread/qos.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <regex>
 #include <iostream>
 #include <fstream>
@@ -209,6 +213,80 @@ MemoryStats memory_stats()
     return stats;
 }
 
+void* aligned_alloc(size_t size, size_t alignment)
+{
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, std::max(alignment, sizeof(void*)), size) != 0)
+        return nullptr;
+    return ptr;
+}
+
+void aligned_free(void* ptr)
+{
+    free(ptr);
+}
+
+bool advise_huge_pages(void* ptr, size_t size)
+{
+    // macOS does not support transparent huge pages.
+    SGL_UNUSED(ptr, size);
+    return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Threads
+// -------------------------------------------------------------------------------------------------
+
+uint32_t processor_count()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? uint32_t(count) : 1;
+}
+
+uint32_t numa_node_count()
+{
+    return 1;
+}
+
+std::vector<uint32_t> numa_node_processors(uint32_t node)
+{
+    std::vector<uint32_t> processors;
+    if (node == 0)
+        for (uint32_t i = 0; i < processor_count(); ++i)
+            processors.push_back(i);
+    return processors;
+}
+
+void set_thread_name(std::string_view name)
+{
+    pthread_setname_np(std::string(name).c_str());
+}
+
+bool set_thread_affinity(std::span<const uint32_t> processors)
+{
+    // macOS does not support binding threads to processors.
+    SGL_UNUSED(processors);
+    return false;
+}
+
+bool set_thread_priority(ThreadPriority priority)
+{
+    // Map priorities to quality of service classes.
+    qos_class_t qos_class = QOS_CLASS_DEFAULT;
+    switch (priority) {
+    case ThreadPriority::low:
+        qos_class = QOS_CLASS_UTILITY;
+        break;
+    case ThreadPriority::normal:
+        qos_class = QOS_CLASS_DEFAULT;
+        break;
+    case ThreadPriority::high:
+        qos_class = QOS_CLASS_USER_INITIATED;
+        break;
+    }
+    return pthread_set_qos_class_self_np(qos_class, 0) == 0;
+}
+
 // -------------------------------------------------------------------------------------------------
 // Shared libraries
 // -------------------------------------------------------------------------------------------------
@@ -20,6 +20,7 @@
 #include <ShlObj_core.h>
 #include <winioctl.h>
 #include <DbgHelp.h>
+#include <malloc.h>
 
 #include <mutex>
 
@@ -453,6 +454,89 @@ MemoryStats memory_stats()
     return stats;
 }
 
+void* aligned_alloc(size_t size, size_t alignment)
+{
+    return _aligned_malloc(size, alignment);
+}
+
+void aligned_free(void* ptr)
+{
+    _aligned_free(ptr);
+}
+
+bool advise_huge_pages(void* ptr, size_t size)
+{
+    // Windows only supports large pages through VirtualAlloc with MEM_LARGE_PAGES,
+    // which requires the SeLockMemoryPrivilege. There is no transparent mechanism.
+    SGL_UNUSED(ptr, size);
+    return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Threads
+// -------------------------------------------------------------------------------------------------
+
+uint32_t processor_count()
+{
+    return GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+}
+
+uint32_t numa_node_count()
+{
+    ULONG highest_node = 0;
+    if (!GetNumaHighestNodeNumber(&highest_node))
+        return 1;
+    return highest_node + 1;
+}
+
+std::vector<uint32_t> numa_node_processors(uint32_t node)
+{
+    std::vector<uint32_t> processors;
+    GROUP_AFFINITY affinity = {};
+    if (!GetNumaNodeProcessorMaskEx(USHORT(node), &affinity))
+        return processors;
+    for (uint32_t i = 0; i < 64; ++i)
+        if (affinity.Mask & (KAFFINITY(1) << i))
+            processors.push_back(affinity.Group * 64 + i);
+    return processors;
+}
+
+void set_thread_name(std::string_view name)
+{
+    SetThreadDescription(GetCurrentThread(), string::to_wstring(name).c_str());
+}
+
+bool set_thread_affinity(std::span<const uint32_t> processors)
+{
+    // Threads can only be bound to processors of a single processor group.
+    // Use the group of the first processor and ignore processors in other groups.
+    if (processors.empty())
+        return false;
+    GROUP_AFFINITY affinity = {};
+    affinity.Group = WORD(processors[0] / 64);
+    for (uint32_t processor : processors)
+        if (processor / 64 == affinity.Group)
+            affinity.Mask |= KAFFINITY(1) << (processor % 64);
+    return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+}
+
+bool set_thread_priority(ThreadPriority priority)
+{
+    int value = THREAD_PRIORITY_NORMAL;
+    switch (priority) {
+    case ThreadPriority::low:
+        value = THREAD_PRIORITY_BELOW_NORMAL;
+        break;
+    case ThreadPriority::normal:
+        value = THREAD_PRIORITY_NORMAL;
+        break;
+    case ThreadPriority::high:
+        value = THREAD_PRIORITY_ABOVE_NORMAL;
+        break;
+    }
+    return SetThreadPriority(GetCurrentThread(), value) != 0;
+}
+
 // -------------------------------------------------------------------------------------------------
 // Shared libraries
 // -------------------------------------------------------------------------------------------------
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "nanobind.h"
+
+#include "sgl/core/async_io.h"
+
+namespace sgl {
+SGL_DICT_TO_DESC_BEGIN(AsyncIOQueueDesc)
+SGL_DICT_TO_DESC_FIELD(backend, AsyncIOBackend)
+SGL_DICT_TO_DESC_FIELD(queue_depth, uint32_t)
+SGL_DICT_TO_DESC_FIELD(thread_count, uint32_t)
+SGL_DICT_TO_DESC_END()
+} // namespace sgl
+
+SGL_PY_EXPORT(core_async_io)
+{
+    using namespace sgl;
+
+    using Buffer = nb::ndarray<nb::device::cpu, nb::c_contig>;
+
+    nb::sgl_enum<AsyncIOBackend>(m, "AsyncIOBackend", D_NA(AsyncIOBackend));
+
+    nb::class_<AsyncFile, Object> async_file(m, "AsyncFile", D_NA(AsyncFile));
+
+    nb::sgl_enum<AsyncFile::Mode>(async_file, "Mode", D_NA(AsyncFile, Mode));
+
+    async_file //
+        .def(nb::init<const std::filesystem::path&, AsyncFile::Mode>(), "path"_a, "mode"_a, D_NA(AsyncFile, AsyncFile))
+        .def_prop_ro("path", &AsyncFile::path, D_NA(AsyncFile, path))
+        .def_prop_ro("mode", &AsyncFile::mode, D_NA(AsyncFile, mode))
+        .def_prop_ro("size", &AsyncFile::size, D_NA(AsyncFile, size));
+
+    nb::class_<AsyncIOQueueDesc>(m, "AsyncIOQueueDesc", D_NA(AsyncIOQueueDesc))
+        .def(nb::init<>())
+        .def(
+            "__init__",
+            [](AsyncIOQueueDesc* self, nb::dict dict) { new (self) AsyncIOQueueDesc(dict_to_AsyncIOQueueDesc(dict)); }
+        )
+        .def_rw("backend", &AsyncIOQueueDesc::backend, D_NA(AsyncIOQueueDesc, backend))
+        .def_rw("queue_depth", &AsyncIOQueueDesc::queue_depth, D_NA(AsyncIOQueueDesc, queue_depth))
+        .def_rw("thread_count", &AsyncIOQueueDesc::thread_count, D_NA(AsyncIOQueueDesc, thread_count));
+    nb::implicitly_convertible<nb::dict, AsyncIOQueueDesc>();
+
+    nb::class_<AsyncIOCompletion>(m, "AsyncIOCompletion", D_NA(AsyncIOCompletion))
+        .def_ro("user_data", &AsyncIOCompletion::user_data, D_NA(AsyncIOCompletion, user_data))
+        .def_ro("result", &AsyncIOCompletion::result, D_NA(AsyncIOCompletion, result))
+        .def(
+            "__repr__",
+            [](const AsyncIOCompletion& self)
+            { return fmt::format("AsyncIOCompletion(user_data={}, result={})", self.user_data, self.result); }
+        );
+
+    nb::class_<AsyncIOQueue, Object>(m, "AsyncIOQueue", D_NA(AsyncIOQueue))
+        .def(nb::init<AsyncIOQueueDesc>(), "desc"_a = AsyncIOQueueDesc{}, D_NA(AsyncIOQueue, AsyncIOQueue))
+        .def_prop_ro("desc", &AsyncIOQueue::desc, D_NA(AsyncIOQueue, desc))
+        .def_prop_ro("backend", &AsyncIOQueue::backend, D_NA(AsyncIOQueue, backend))
+        .def(
+            "submit_read",
+            [](AsyncIOQueue* self, const AsyncFile* file, uint64_t offset, Buffer buffer, uint64_t user_data)
+            { self->submit_read(file, offset, buffer.data(), buffer.nbytes(), user_data); },
+            "file"_a,
+            "offset"_a,
+            "buffer"_a,
+            "user_data"_a = 0,
+            D_NA(AsyncIOQueue, submit_read)
+        )
+        .def(
+            "submit_write",
+            [](AsyncIOQueue* self, const AsyncFile* file, uint64_t offset, Buffer buffer, uint64_t user_data)
+            { self->submit_write(file, offset, buffer.data(), buffer.nbytes(), user_data); },
+            "file"_a,
+            "offset"_a,
+            "buffer"_a,
+            "user_data"_a = 0,
+            D_NA(AsyncIOQueue, submit_write)
+        )
+        .def(
+            "complete",
+            [](AsyncIOQueue* self, uint32_t min_count)
+            {
+                nb::gil_scoped_release guard;
+                return self->complete(min_count);
+            },
+            "min_count"_a = 1,
+            D_NA(AsyncIOQueue, complete)
+        )
+        .def_prop_ro("pending_count", &AsyncIOQueue::pending_count, D_NA(AsyncIOQueue, pending_count))
+        .def_static(
+            "is_io_uring_supported",
+            &AsyncIOQueue::is_io_uring_supported,
+            D_NA(AsyncIOQueue, is_io_uring_supported)
+        );
+}
@@ -8,6 +8,20 @@
 
 #include "sgl/stl/bit.h" // Replace with <bit> when available on all platforms.
 
+namespace sgl {
+
+/// Numpy type string for a component type.
+static std::string array_typestr(Bitmap::ComponentType component_type)
+{
+    std::string format(3, '\0');
+    format[0] = stdx::endian::native == stdx::endian::little ? '<' : '>';
+    format[1] = Struct::is_float(component_type) ? 'f' : (Struct::is_unsigned(component_type) ? 'u' : 'i');
+    format[2] = '0' + static_cast<char>(Struct::type_size(component_type));
+    return format;
+}
+
+} // namespace sgl
+
 SGL_PY_EXPORT(core_bitmap)
 {
     using namespace sgl;
@@ -18,6 +32,16 @@ SGL_PY_EXPORT(core_bitmap)
     bitmap.attr("ComponentType") = m.attr("Struct").attr("Type");
     nb::sgl_enum<Bitmap::FileFormat>(bitmap, "FileFormat", D(Bitmap, FileFormat));
 
+    nb::class_<Bitmap::Info>(bitmap, "Info", D_NA(Bitmap, Info))
+        .def_ro("file_format", &Bitmap::Info::file_format, D_NA(Bitmap, Info, file_format))
+        .def_ro("pixel_format", &Bitmap::Info::pixel_format, D_NA(Bitmap, Info, pixel_format))
+        .def_ro("component_type", &Bitmap::Info::component_type, D_NA(Bitmap, Info, component_type))
+        .def_ro("width", &Bitmap::Info::width, D_NA(Bitmap, Info, width))
+        .def_ro("height", &Bitmap::Info::height, D_NA(Bitmap, Info, height))
+        .def_ro("channel_count", &Bitmap::Info::channel_count, D_NA(Bitmap, Info, channel_count))
+        .def_ro("srgb_gamma", &Bitmap::Info::srgb_gamma, D_NA(Bitmap, Info, srgb_gamma))
+        .def("__repr__", &Bitmap::Info::to_string);
+
     bitmap //
         .def(
             "__init__",
@@ -117,7 +141,34 @@ SGL_PY_EXPORT(core_bitmap)
         .def("empty", &Bitmap::empty, D(Bitmap, empty))
         .def("clear", &Bitmap::clear, D(Bitmap, clear))
         .def("vflip", &Bitmap::vflip, D(Bitmap, vflip))
+        .def("hflip", &Bitmap::hflip, D_NA(Bitmap, hflip))
+        .def("transpose", &Bitmap::transpose, D_NA(Bitmap, transpose))
+        .def("rotate90", &Bitmap::rotate90, D_NA(Bitmap, rotate90))
+        .def("rotate180", &Bitmap::rotate180, D_NA(Bitmap, rotate180))
+        .def("rotate270", &Bitmap::rotate270, D_NA(Bitmap, rotate270))
+        .def("crop", &Bitmap::crop, "x"_a, "y"_a, "width"_a, "height"_a, D_NA(Bitmap, crop))
+        .def("view", nb::overload_cast<>(&Bitmap::view, nb::const_), D_NA(Bitmap, view))
+        .def(
+            "view",
+            nb::overload_cast<uint32_t, uint32_t, uint32_t, uint32_t>(&Bitmap::view, nb::const_),
+            "x"_a,
+            "y"_a,
+            "width"_a,
+            "height"_a,
+            D_NA(Bitmap, view, 2)
+        )
+        .def(
+            "tiles",
+            &Bitmap::tiles,
+            "tile_width"_a,
+            "tile_height"_a,
+            "step_x"_a = 0,
+            "step_y"_a = 0,
+            "include_partial"_a = false,
+            D_NA(Bitmap, tiles)
+        )
         .def("split", &Bitmap::split, D(Bitmap, split))
+        .def("split_views", &Bitmap::split_views, D_NA(Bitmap, split_views))
         .def(
             "convert",
             [](Bitmap& self,
@@ -152,6 +203,13 @@ SGL_PY_EXPORT(core_bitmap)
             "quality"_a = -1,
             D(Bitmap, write_async)
         )
+        .def_static("memory_pool", &Bitmap::memory_pool, D_NA(Bitmap, memory_pool))
+        .def_static(
+            "set_memory_pool",
+            &Bitmap::set_memory_pool,
+            "memory_pool"_a.none(),
+            D_NA(Bitmap, set_memory_pool)
+        )
         .def_static(
             "read_multiple",
             &Bitmap::read_multiple,
@@ -159,6 +217,24 @@ SGL_PY_EXPORT(core_bitmap)
             "format"_a = Bitmap::FileFormat::auto_,
             D(Bitmap, read_multiple)
         )
+        .def_static(
+            "probe",
+            [](const std::filesystem::path& path, Bitmap::FileFormat format) { return Bitmap::probe(path, format); },
+            "path"_a,
+            "format"_a = Bitmap::FileFormat::auto_,
+            D_NA(Bitmap, probe)
+        )
+        .def_static(
+            "probe_multiple",
+            [](std::vector<std::filesystem::path> paths, Bitmap::FileFormat format)
+            {
+                nb::gil_scoped_release guard;
+                return Bitmap::probe_multiple(paths, format);
+            },
+            "paths"_a,
+            "format"_a = Bitmap::FileFormat::auto_,
+            D_NA(Bitmap, probe_multiple)
+        )
         .def(nb::self == nb::self)
         .def(nb::self != nb::self)
         .def_prop_ro(
@@ -174,13 +250,7 @@ SGL_PY_EXPORT(core_bitmap)
                 else
                     result["shape"] = nb::make_tuple(self.height(), self.width(), self.channel_count());
 
-                std::string format(3, '\0');
-                format[0] = stdx::endian::native == stdx::endian::little ? '<' : '>';
-                format[1] = Struct::is_float(self.component_type())
-                    ? 'f'
-                    : (Struct::is_unsigned(self.component_type()) ? 'u' : 'i');
-                format[2] = '0' + static_cast<char>(Struct::type_size(self.component_type()));
-                result["typestr"] = format;
+                result["typestr"] = array_typestr(self.component_type());
 
                 result["data"] = nb::make_tuple(reinterpret_cast<uintptr_t>(self.data()), false);
                 result["version"] = 3;
@@ -224,4 +294,51 @@ SGL_PY_EXPORT(core_bitmap)
                 return nb::str(html.c_str());
             }
         );
+
+    nb::class_<BitmapView>(m, "BitmapView", D_NA(BitmapView))
+        .def_prop_ro(
+            "bitmap",
+            [](const BitmapView& self) { return ref(const_cast<Bitmap*>(self.bitmap())); },
+            D_NA(BitmapView, bitmap)
+        )
+        .def_prop_ro("x", &BitmapView::x, D_NA(BitmapView, x))
+        .def_prop_ro("y", &BitmapView::y, D_NA(BitmapView, y))
+        .def_prop_ro("width", &BitmapView::width, D_NA(BitmapView, width))
+        .def_prop_ro("height", &BitmapView::height, D_NA(BitmapView, height))
+        .def_prop_ro("pixel_format", &BitmapView::pixel_format, D_NA(BitmapView, pixel_format))
+        .def_prop_ro("has_channel_subset", &BitmapView::has_channel_subset, D_NA(BitmapView, has_channel_subset))
+        .def_prop_ro("row_stride", &BitmapView::row_stride, D_NA(BitmapView, row_stride))
+        .def("empty", &BitmapView::empty, D_NA(BitmapView, empty))
+        .def("is_contiguous", &BitmapView::is_contiguous, D_NA(BitmapView, is_contiguous))
+        .def("subview", &BitmapView::subview, "x"_a, "y"_a, "width"_a, "height"_a, D_NA(BitmapView, subview))
+        .def("to_bitmap", &BitmapView::to_bitmap, D_NA(BitmapView, to_bitmap))
+        .def_prop_ro(
+            "__array_interface__",
+            [](const BitmapView& self) -> nb::object
+            {
+                if (self.empty())
+                    return nb::none();
+                SGL_CHECK(
+                    !self.has_channel_subset(),
+                    "Views selecting a subset of channels cannot be accessed directly, use to_bitmap()."
+                );
+
+                const Bitmap* bitmap = self.bitmap();
+                size_t component_size = Struct::type_size(bitmap->component_type());
+                nb::dict result;
+                if (bitmap->channel_count() == 1) {
+                    result["shape"] = nb::make_tuple(self.height(), self.width());
+                    result["strides"] = nb::make_tuple(self.row_stride(), self.bytes_per_pixel());
+                } else {
+                    result["shape"] = nb::make_tuple(self.height(), self.width(), bitmap->channel_count());
+                    result["strides"] = nb::make_tuple(self.row_stride(), self.bytes_per_pixel(), component_size);
+                }
+                result["typestr"] = array_typestr(bitmap->component_type());
+                result["data"] = nb::make_tuple(reinterpret_cast<uintptr_t>(self.data()), true);
+                result["version"] = 3;
+
+                return nb::object(result);
+            }
+        )
+        .def("__repr__", &BitmapView::to_string);
 }
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "nanobind.h"
+
+#include "sgl/core/dds_file.h"
+
+SGL_PY_EXPORT(core_dds_file)
+{
+    using namespace sgl;
+
+    nb::class_<DDSFile, Object> dds_file(m, "DDSFile", D_NA(DDSFile));
+
+    nb::sgl_enum<DDSFile::TextureType>(dds_file, "TextureType", D_NA(DDSFile, TextureType));
+
+    nb::class_<DDSFile::Info>(dds_file, "Info", D_NA(DDSFile, Info))
+        .def_ro("dxgi_format", &DDSFile::Info::dxgi_format, D_NA(DDSFile, Info, dxgi_format))
+        .def_ro("type", &DDSFile::Info::type, D_NA(DDSFile, Info, type))
+        .def_ro("width", &DDSFile::Info::width, D_NA(DDSFile, Info, width))
+        .def_ro("height", &DDSFile::Info::height, D_NA(DDSFile, Info, height))
+        .def_ro("depth", &DDSFile::Info::depth, D_NA(DDSFile, Info, depth))
+        .def_ro("mip_count", &DDSFile::Info::mip_count, D_NA(DDSFile, Info, mip_count))
+        .def_ro("array_size", &DDSFile::Info::array_size, D_NA(DDSFile, Info, array_size))
+        .def_ro("compressed", &DDSFile::Info::compressed, D_NA(DDSFile, Info, compressed))
+        .def_ro("srgb", &DDSFile::Info::srgb, D_NA(DDSFile, Info, srgb))
+        .def("__repr__", &DDSFile::Info::to_string);
+
+    dds_file //
+        .def(nb::init<const std::filesystem::path&>(), "path"_a, D_NA(DDSFile, DDSFile))
+        .def_prop_ro("dxgi_format", &DDSFile::dxgi_format, D_NA(DDSFile, dxgi_format))
+        .def_prop_ro("type", &DDSFile::type, D_NA(DDSFile, type))
+        .def_prop_ro("width", &DDSFile::width, D_NA(DDSFile, width))
+        .def_prop_ro("height", &DDSFile::height, D_NA(DDSFile, height))
+        .def_prop_ro("depth", &DDSFile::depth, D_NA(DDSFile, depth))
+        .def_prop_ro("mip_count", &DDSFile::mip_count, D_NA(DDSFile, mip_count))
+        .def_prop_ro("array_size", &DDSFile::array_size, D_NA(DDSFile, array_size))
+        .def_prop_ro("compressed", &DDSFile::compressed, D_NA(DDSFile, compressed))
+        .def_prop_ro("srgb", &DDSFile::srgb, D_NA(DDSFile, srgb))
+        .def_static(
+            "probe",
+            [](const std::filesystem::path& path) { return DDSFile::probe(path); },
+            "path"_a,
+            D_NA(DDSFile, probe)
+        );
+}
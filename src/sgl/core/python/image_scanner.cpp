@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "nanobind.h"
+
+#include "sgl/core/image_scanner.h"
+
+#include <chrono>
+
+namespace sgl {
+SGL_DICT_TO_DESC_BEGIN(ImageScanDesc)
+SGL_DICT_TO_DESC_FIELD(recursive, bool)
+SGL_DICT_TO_DESC_FIELD(extensions, std::vector<std::string>)
+SGL_DICT_TO_DESC_END()
+} // namespace sgl
+
+SGL_PY_EXPORT(core_image_scanner)
+{
+    using namespace sgl;
+
+    nb::class_<ImageScanEntry>(m, "ImageScanEntry", D_NA(ImageScanEntry))
+        .def_ro("path", &ImageScanEntry::path, D_NA(ImageScanEntry, path))
+        .def_ro("file_size", &ImageScanEntry::file_size, D_NA(ImageScanEntry, file_size))
+        .def_prop_ro(
+            "last_write_time",
+            [](const ImageScanEntry& self)
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(self.last_write_time.time_since_epoch())
+                    .count();
+            },
+            D_NA(ImageScanEntry, last_write_time)
+        )
+        .def_ro("bitmap_info", &ImageScanEntry::bitmap_info, D_NA(ImageScanEntry, bitmap_info))
+        .def_ro("dds_info", &ImageScanEntry::dds_info, D_NA(ImageScanEntry, dds_info))
+        .def_ro("error", &ImageScanEntry::error, D_NA(ImageScanEntry, error))
+        .def(
+            "__repr__",
+            [](const ImageScanEntry& self)
+            { return fmt::format("ImageScanEntry(path=\"{}\", file_size={})", self.path, self.file_size); }
+        );
+
+    nb::class_<ImageScanDesc>(m, "ImageScanDesc", D_NA(ImageScanDesc))
+        .def(nb::init<>())
+        .def(
+            "__init__",
+            [](ImageScanDesc* self, nb::dict dict) { new (self) ImageScanDesc(dict_to_ImageScanDesc(dict)); }
+        )
+        .def_rw("recursive", &ImageScanDesc::recursive, D_NA(ImageScanDesc, recursive))
+        .def_rw("extensions", &ImageScanDesc::extensions, D_NA(ImageScanDesc, extensions));
+    nb::implicitly_convertible<nb::dict, ImageScanDesc>();
+
+    m.def(
+        "scan_image_directory",
+        [](const std::filesystem::path& directory, ImageScanDesc desc, std::vector<ImageScanEntry> previous)
+        {
+            nb::gil_scoped_release guard;
+            return scan_image_directory(directory, desc, previous);
+        },
+        "directory"_a,
+        "desc"_a = ImageScanDesc{},
+        "previous"_a = std::vector<ImageScanEntry>{},
+        D_NA(scan_image_directory)
+    );
+}
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "nanobind.h"
+
+#include "sgl/core/memory_pool.h"
+
+namespace sgl {
+SGL_DICT_TO_DESC_BEGIN(MemoryPoolDesc)
+SGL_DICT_TO_DESC_FIELD(alignment, size_t)
+SGL_DICT_TO_DESC_FIELD(enable_pooling, bool)
+SGL_DICT_TO_DESC_FIELD(max_pooled_size, size_t)
+SGL_DICT_TO_DESC_FIELD(huge_page_threshold, size_t)
+SGL_DICT_TO_DESC_END()
+} // namespace sgl
+
+SGL_PY_EXPORT(core_memory_pool)
+{
+    using namespace sgl;
+
+    nb::class_<MemoryPoolDesc>(m, "MemoryPoolDesc", D_NA(MemoryPoolDesc))
+        .def(nb::init<>())
+        .def(
+            "__init__",
+            [](MemoryPoolDesc* self, nb::dict dict) { new (self) MemoryPoolDesc(dict_to_MemoryPoolDesc(dict)); }
+        )
+        .def_rw("alignment", &MemoryPoolDesc::alignment, D_NA(MemoryPoolDesc, alignment))
+        .def_rw("enable_pooling", &MemoryPoolDesc::enable_pooling, D_NA(MemoryPoolDesc, enable_pooling))
+        .def_rw("max_pooled_size", &MemoryPoolDesc::max_pooled_size, D_NA(MemoryPoolDesc, max_pooled_size))
+        .def_rw(
+            "huge_page_threshold",
+            &MemoryPoolDesc::huge_page_threshold,
+            D_NA(MemoryPoolDesc, huge_page_threshold)
+        );
+    nb::implicitly_convertible<nb::dict, MemoryPoolDesc>();
+
+    nb::class_<MemoryPool, Object> memory_pool(m, "MemoryPool", D_NA(MemoryPool));
+
+    nb::class_<MemoryPool::Stats>(memory_pool, "Stats", D_NA(MemoryPool, Stats))
+        .def_ro("allocation_count", &MemoryPool::Stats::allocation_count, D_NA(MemoryPool, Stats, allocation_count))
+        .def_ro("pool_hit_count", &MemoryPool::Stats::pool_hit_count, D_NA(MemoryPool, Stats, pool_hit_count))
+        .def_ro("allocated_size", &MemoryPool::Stats::allocated_size, D_NA(MemoryPool, Stats, allocated_size))
+        .def_ro("pooled_size", &MemoryPool::Stats::pooled_size, D_NA(MemoryPool, Stats, pooled_size));
+
+    memory_pool //
+        .def(nb::init<MemoryPoolDesc>(), "desc"_a = MemoryPoolDesc{}, D_NA(MemoryPool, MemoryPool))
+        .def_prop_ro("desc", &MemoryPool::desc, D_NA(MemoryPool, desc))
+        .def_prop_ro("stats", &MemoryPool::stats, D_NA(MemoryPool, stats))
+        .def("trim", &MemoryPool::trim, D_NA(MemoryPool, trim))
+        .def_static("size_class", &MemoryPool::size_class, "size"_a, D_NA(MemoryPool, size_class));
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "nanobind.h"
+
+#include "sgl/core/metrics.h"
+
+#include <nanobind/stl/pair.h>
+
+SGL_PY_EXPORT(core_metrics)
+{
+    using namespace sgl;
+
+    nb::sgl_enum<MetricType>(m, "MetricType", D_NA(MetricType));
+
+    nb::class_<Metric>(m, "Metric", D_NA(Metric))
+        .def_prop_ro("type", &Metric::type, D_NA(Metric, type))
+        .def_prop_ro("name", &Metric::name, D_NA(Metric, name))
+        .def_prop_ro("help", &Metric::help, D_NA(Metric, help))
+        .def("reset", &Metric::reset, D_NA(Metric, reset));
+
+    nb::class_<Counter, Metric>(m, "Counter", D_NA(Counter))
+        .def("add", &Counter::add, "value"_a = 1, D_NA(Counter, add))
+        .def_prop_ro("value", &Counter::value, D_NA(Counter, value));
+
+    nb::class_<Gauge, Metric>(m, "Gauge", D_NA(Gauge))
+        .def("set", &Gauge::set, "value"_a, D_NA(Gauge, set))
+        .def("add", &Gauge::add, "value"_a, D_NA(Gauge, add))
+        .def("sub", &Gauge::sub, "value"_a, D_NA(Gauge, sub))
+        .def_prop_ro("value", &Gauge::value, D_NA(Gauge, value));
+
+    nb::class_<Histogram, Metric>(m, "Histogram", D_NA(Histogram))
+        .def("observe", &Histogram::observe, "value"_a, D_NA(Histogram, observe))
+        .def_prop_ro("bounds", &Histogram::bounds, D_NA(Histogram, bounds))
+        .def_prop_ro("bucket_counts", &Histogram::bucket_counts, D_NA(Histogram, bucket_counts))
+        .def_prop_ro("count", &Histogram::count, D_NA(Histogram, count))
+        .def_prop_ro("sum", &Histogram::sum, D_NA(Histogram, sum))
+        .def_static(
+            "exponential_bounds",
+            &Histogram::exponential_bounds,
+            "start"_a,
+            "factor"_a,
+            "count"_a,
+            D_NA(Histogram, exponential_bounds)
+        );
+
+    nb::class_<MetricSample>(m, "MetricSample", D_NA(MetricSample))
+        .def_ro("type", &MetricSample::type, D_NA(MetricSample, type))
+        .def_ro("name", &MetricSample::name, D_NA(MetricSample, name))
+        .def_ro("help", &MetricSample::help, D_NA(MetricSample, help))
+        .def_ro("value", &MetricSample::value, D_NA(MetricSample, value))
+        .def_ro("count", &MetricSample::count, D_NA(MetricSample, count))
+        .def_ro("buckets", &MetricSample::buckets, D_NA(MetricSample, buckets));
+
+    nb::class_<MetricsRegistry>(m, "MetricsRegistry", D_NA(MetricsRegistry))
+        .def_static("get", &MetricsRegistry::get, nb::rv_policy::reference, D_NA(MetricsRegistry, get))
+        .def(
+            "counter",
+            &MetricsRegistry::counter,
+            "name"_a,
+            "help"_a = "",
+            nb::rv_policy::reference,
+            D_NA(MetricsRegistry, counter)
+        )
+        .def(
+            "gauge",
+            &MetricsRegistry::gauge,
+            "name"_a,
+            "help"_a = "",
+            nb::rv_policy::reference,
+            D_NA(MetricsRegistry, gauge)
+        )
+        .def(
+            "histogram",
+            &MetricsRegistry::histogram,
+            "name"_a,
+            "help"_a,
+            "bounds"_a,
+            nb::rv_policy::reference,
+            D_NA(MetricsRegistry, histogram)
+        )
+        .def("snapshot", &MetricsRegistry::snapshot, D_NA(MetricsRegistry, snapshot))
+        .def("reset", &MetricsRegistry::reset, D_NA(MetricsRegistry, reset))
+        .def(
+            "to_prometheus",
+            nb::overload_cast<>(&MetricsRegistry::to_prometheus, nb::const_),
+            D_NA(MetricsRegistry, to_prometheus)
+        )
+        .def("to_json", nb::overload_cast<>(&MetricsRegistry::to_json, nb::const_), D_NA(MetricsRegistry, to_json));
+}
@@ -4,6 +4,13 @@
 
 #include "sgl/core/object.h"
 
+// Free-threaded builds use PyUnstable_TryIncRef() (Python 3.14+), which is safe against concurrent deallocation.
+#if defined(Py_GIL_DISABLED) && PY_VERSION_HEX >= 0x030E0000
+#define SGL_PY_HAS_TRY_INC_REF 1
+#else
+#define SGL_PY_HAS_TRY_INC_REF 0
+#endif
+
 SGL_PY_EXPORT(core_object)
 {
     using namespace sgl;
@@ -17,13 +24,39 @@ SGL_PY_EXPORT(core_object)
         {
             nb::gil_scoped_acquire guard;
             Py_DECREF(o);
+        },
+        [](PyObject* o) noexcept
+        {
+#if SGL_PY_HAS_TRY_INC_REF
+            // Atomically fails if the object is being deallocated on another thread.
+            return PyUnstable_TryIncRef(o) != 0;
+#elif defined(Py_GIL_DISABLED)
+            // Checking and incrementing the reference count is not atomic without the GIL, report a miss.
+            return false;
+#else
+            // Python objects are deallocated while holding the GIL. Callers typically hold a lock
+            // that the destructor also takes, so acquiring the GIL here could deadlock.
+            // Without the GIL the reference count cannot be inspected safely, report a miss instead.
+            if (!PyGILState_Check() || Py_REFCNT(o) == 0)
+                return false;
+            Py_INCREF(o);
+            return true;
+#endif
         }
     );
 
     nb::class_<Object>(
         m,
         "Object",
-        nb::intrusive_ptr<Object>([](Object* o, PyObject* po) noexcept { o->set_self_py(po); }),
+        nb::intrusive_ptr<Object>(
+            [](Object* o, PyObject* po) noexcept
+            {
+#if SGL_PY_HAS_TRY_INC_REF
+                PyUnstable_EnableTryIncRef(po);
+#endif
+                o->set_self_py(po);
+            }
+        ),
         "Base class for all reference counted objects."
     )
 #if SGL_ENABLE_OBJECT_TRACKING
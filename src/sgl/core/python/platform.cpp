@@ -74,4 +74,10 @@ SGL_PY_EXPORT(core_platform)
         .def_ro("peak_rss", &MemoryStats::peak_rss, D(platform, MemoryStats, peak_rss));
 
     platform.def("memory_stats", &memory_stats, D(platform, memory_stats));
+
+    nb::sgl_enum<ThreadPriority>(platform, "ThreadPriority", D_NA(platform, ThreadPriority));
+
+    platform.def("processor_count", &processor_count, D_NA(platform, processor_count));
+    platform.def("numa_node_count", &numa_node_count, D_NA(platform, numa_node_count));
+    platform.def("numa_node_processors", &numa_node_processors, "node"_a, D_NA(platform, numa_node_processors));
 }
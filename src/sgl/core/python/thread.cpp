@@ -4,12 +4,35 @@
 
 #include "sgl/core/thread.h"
 
+namespace sgl::thread {
+SGL_DICT_TO_DESC_BEGIN(ThreadPoolDesc)
+SGL_DICT_TO_DESC_FIELD(thread_count, uint32_t)
+SGL_DICT_TO_DESC_FIELD(name, std::string)
+SGL_DICT_TO_DESC_FIELD(priority, platform::ThreadPriority)
+SGL_DICT_TO_DESC_FIELD(processors, std::vector<uint32_t>)
+SGL_DICT_TO_DESC_FIELD(numa_node, std::optional<uint32_t>)
+SGL_DICT_TO_DESC_END()
+} // namespace sgl::thread
+
 SGL_PY_EXPORT(core_thread)
 {
     using namespace sgl::thread;
 
     nb::module_ thread = m.attr("thread");
 
+    nb::class_<ThreadPoolDesc>(thread, "ThreadPoolDesc", D_NA(thread, ThreadPoolDesc))
+        .def(nb::init<>())
+        .def(
+            "__init__",
+            [](ThreadPoolDesc* self, nb::dict dict) { new (self) ThreadPoolDesc(dict_to_ThreadPoolDesc(dict)); }
+        )
+        .def_rw("thread_count", &ThreadPoolDesc::thread_count, D_NA(thread, ThreadPoolDesc, thread_count))
+        .def_rw("name", &ThreadPoolDesc::name, D_NA(thread, ThreadPoolDesc, name))
+        .def_rw("priority", &ThreadPoolDesc::priority, D_NA(thread, ThreadPoolDesc, priority))
+        .def_rw("processors", &ThreadPoolDesc::processors, D_NA(thread, ThreadPoolDesc, processors))
+        .def_rw("numa_node", &ThreadPoolDesc::numa_node, D_NA(thread, ThreadPoolDesc, numa_node));
+    nb::implicitly_convertible<nb::dict, ThreadPoolDesc>();
+
     thread.def(
         "wait_for_tasks",
         []()
@@ -19,4 +42,27 @@ SGL_PY_EXPORT(core_thread)
         },
         D(thread, wait_for_tasks)
     );
+
+    thread.def(
+        "configure_global_thread_pool",
+        [](ThreadPoolDesc desc)
+        {
+            nb::gil_scoped_release guard;
+            configure_global_thread_pool(std::move(desc));
+        },
+        "desc"_a,
+        D_NA(thread, configure_global_thread_pool)
+    );
+    thread.def(
+        "configure_io_thread_pool",
+        [](ThreadPoolDesc desc)
+        {
+            nb::gil_scoped_release guard;
+            configure_io_thread_pool(std::move(desc));
+        },
+        "desc"_a,
+        D_NA(thread, configure_io_thread_pool)
+    );
+    thread.def("global_thread_pool_desc", &global_thread_pool_desc, D_NA(thread, global_thread_pool_desc));
+    thread.def("io_thread_pool_desc", &io_thread_pool_desc, D_NA(thread, io_thread_pool_desc));
 }
@@ -67,10 +67,13 @@ derivative works thereof, in binary and source code form.
 #endif
 
 #include <limits>
+#include <optional>
+#include <type_traits>
 #include <unordered_map>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <utility>
 
 #define SGL_LOG_JIT_ASSEMBLY 0
@@ -686,6 +689,340 @@ struct VMProgram : public Program {
     }
 };
 
+/// Ahead-of-time compiled conversion kernels for common pixel formats.
+/// These cover conversions between RGB/RGBA structs (as created by \c Bitmap) with
+/// uint8, uint16, float16 and float32 components, with and without sRGB gamma.
+/// Results are identical to the ones computed by the virtual machine.
+namespace aot {
+
+    template<typename T>
+    struct ComponentTraits;
+
+    template<>
+    struct ComponentTraits<uint8_t> {
+        static constexpr Struct::Type type = Struct::Type::uint8;
+        static constexpr bool is_integer = true;
+        static constexpr double max = 255.0;
+    };
+
+    template<>
+    struct ComponentTraits<uint16_t> {
+        static constexpr Struct::Type type = Struct::Type::uint16;
+        static constexpr bool is_integer = true;
+        static constexpr double max = 65535.0;
+    };
+
+    template<>
+    struct ComponentTraits<math::float16_t> {
+        static constexpr Struct::Type type = Struct::Type::float16;
+        static constexpr bool is_integer = false;
+    };
+
+    template<>
+    struct ComponentTraits<float> {
+        static constexpr Struct::Type type = Struct::Type::float32;
+        static constexpr bool is_integer = false;
+    };
+
+    /// Round to nearest even and clamp to [0, max].
+    /// Clamping first allows rounding by adding/subtracting 2^52, which (unlike \c std::rint)
+    /// vectorizes without SSE4.1. NaN is mapped to 0.
+    inline double round_and_clamp(double value, double max)
+    {
+        value = value > 0.0 ? value : 0.0;
+        value = value < max ? value : max;
+        return (value + 0x1p52) - 0x1p52;
+    }
+
+    /// Convert a single component, following the code generated by \c generate_code.
+    template<typename S, typename D, bool SrcSrgb, bool DstSrgb>
+    inline D convert_component(S value)
+    {
+        if constexpr (std::is_same_v<S, D> && SrcSrgb == DstSrgb) {
+            return value;
+        } else {
+            double v;
+            if constexpr (std::is_same_v<S, math::float16_t>)
+                v = math::float16_to_float32(value.toBits());
+            else
+                v = static_cast<double>(value);
+            if constexpr (ComponentTraits<S>::is_integer)
+                v *= 1.0 / ComponentTraits<S>::max;
+            if constexpr (SrcSrgb)
+                v = math::srgb_to_linear(v);
+            if constexpr (DstSrgb)
+                v = math::linear_to_srgb(v);
+            if constexpr (ComponentTraits<D>::is_integer)
+                return static_cast<D>(round_and_clamp(v * ComponentTraits<D>::max, ComponentTraits<D>::max));
+            else if constexpr (std::is_same_v<D, math::float16_t>)
+                return math::float16_t::fromBits(math::float32_to_float16(static_cast<float>(v)));
+            else
+                return static_cast<float>(v);
+        }
+    }
+
+    /// Convert the default value of a field, following the code generated by \c generate_code.
+    template<typename D>
+    inline D convert_default(double value)
+    {
+        if constexpr (ComponentTraits<D>::is_integer)
+            return static_cast<D>(static_cast<uint64_t>(value));
+        else if constexpr (std::is_same_v<D, math::float16_t>)
+            return math::float16_t::fromBits(math::float32_to_float16(static_cast<float>(value)));
+        else
+            return static_cast<float>(value);
+    }
+
+    /// Component conversion computed on the fly.
+    template<typename S, typename D, bool SrcSrgb, bool DstSrgb>
+    struct ComputeOp {
+        D operator()(S value) const { return convert_component<S, D, SrcSrgb, DstSrgb>(value); }
+    };
+
+    /// Component conversion using a lookup table indexed by the bits of 8/16-bit components.
+    template<typename S, typename D>
+    struct LutOp {
+        const D* lut;
+
+        D operator()(S value) const
+        {
+            if constexpr (std::is_same_v<S, math::float16_t>)
+                return lut[value.toBits()];
+            else
+                return lut[value];
+        }
+    };
+
+    /// Get the lookup table for converting components of type \c S to \c D.
+    /// Tables are built on first use and shared between all programs.
+    template<typename S, typename D, bool SrcSrgb, bool DstSrgb>
+    const D* get_lut()
+    {
+        static const std::vector<D> lut = []()
+        {
+            std::vector<D> result(size_t(1) << (sizeof(S) * 8));
+            for (size_t i = 0; i < result.size(); ++i) {
+                S value;
+                if constexpr (std::is_same_v<S, math::float16_t>)
+                    value = math::float16_t::fromBits(static_cast<uint16_t>(i));
+                else
+                    value = static_cast<S>(i);
+                result[i] = convert_component<S, D, SrcSrgb, DstSrgb>(value);
+            }
+            return result;
+        }();
+        return lut.data();
+    }
+
+    /// Create the component conversion operator.
+    /// Lookup tables are used for all 8-bit and float16 sources as well as 16-bit sources with sRGB gamma,
+    /// everything else is computed on the fly.
+    template<typename S, typename D, bool SrcSrgb, bool DstSrgb>
+    auto make_op()
+    {
+        constexpr bool is_copy = std::is_same_v<S, D> && SrcSrgb == DstSrgb;
+        constexpr bool use_lut = !is_copy
+            && (sizeof(S) == 1 || std::is_same_v<S, math::float16_t> || (sizeof(S) == 2 && (SrcSrgb || DstSrgb)));
+        if constexpr (use_lut)
+            return LutOp<S, D>{get_lut<S, D, SrcSrgb, DstSrgb>()};
+        else
+            return ComputeOp<S, D, SrcSrgb, DstSrgb>{};
+    }
+
+    /// Conversion program running an ahead-of-time compiled kernel.
+    template<typename S, typename D, int SrcChannels, int DstChannels, typename ColorOp, typename AlphaOp>
+    struct KernelProgram : public Program {
+        ColorOp color_op;
+        AlphaOp alpha_op;
+        /// Alpha value used if the source has no alpha channel.
+        D default_alpha;
+
+        void execute(const void* src, void* dst, size_t count) const override
+        {
+            const S* s = static_cast<const S*>(src);
+            D* d = static_cast<D*>(dst);
+            for (size_t i = 0; i < count; ++i) {
+                d[0] = color_op(s[0]);
+                d[1] = color_op(s[1]);
+                d[2] = color_op(s[2]);
+                if constexpr (DstChannels == 4) {
+                    if constexpr (SrcChannels == 4)
+                        d[3] = alpha_op(s[3]);
+                    else
+                        d[3] = default_alpha;
+                }
+                s += SrcChannels;
+                d += DstChannels;
+            }
+        }
+    };
+
+    /// Layout of a struct supported by the kernels.
+    struct Layout {
+        Struct::Type type;
+        int channel_count;
+        bool srgb;
+    };
+
+    /// Check if a struct is a packed RGB/RGBA struct in host byte order with supported component type.
+    inline std::optional<Layout> get_layout(const Struct& s)
+    {
+        static const char* NAMES[] = {"R", "G", "B", "A"};
+
+        if (s.byte_order() != Struct::host_byte_order())
+            return {};
+        if (s.field_count() != 3 && s.field_count() != 4)
+            return {};
+
+        Layout layout{.type = s[0].type, .channel_count = int(s.field_count()), .srgb = false};
+        if (layout.type != Struct::Type::uint8 && layout.type != Struct::Type::uint16
+            && layout.type != Struct::Type::float16 && layout.type != Struct::Type::float32)
+            return {};
+        size_t component_size = Struct::type_size(layout.type);
+        if (s.size() != component_size * s.field_count())
+            return {};
+
+        for (size_t i = 0; i < s.field_count(); ++i) {
+            const Struct::Field& field = s[i];
+            if (field.name != NAMES[i] || field.type != layout.type || field.offset != i * component_size
+                || !field.blend.empty())
+                return {};
+            // Integer components need to be normalized.
+            if (field.is_integer() && !is_set(field.flags, Struct::Flags::normalized))
+                return {};
+            bool srgb = is_set(field.flags, Struct::Flags::srgb_gamma);
+            if (i == 0)
+                layout.srgb = srgb;
+            else if (i < 3 && srgb != layout.srgb)
+                return {};
+            // Alpha is always linear.
+            else if (i == 3 && srgb)
+                return {};
+        }
+        return layout;
+    }
+
+    template<typename F>
+    void dispatch_type(Struct::Type type, F&& f)
+    {
+        switch (type) {
+        case Struct::Type::uint8:
+            f(uint8_t{});
+            break;
+        case Struct::Type::uint16:
+            f(uint16_t{});
+            break;
+        case Struct::Type::float16:
+            f(math::float16_t{});
+            break;
+        case Struct::Type::float32:
+            f(float{});
+            break;
+        default:
+            SGL_UNREACHABLE();
+        }
+    }
+
+    template<typename F>
+    void dispatch_bool(bool value, F&& f)
+    {
+        if (value)
+            f(std::true_type{});
+        else
+            f(std::false_type{});
+    }
+
+    template<typename F>
+    void dispatch_channel_count(int channel_count, F&& f)
+    {
+        if (channel_count == 4)
+            f(std::integral_constant<int, 4>{});
+        else
+            f(std::integral_constant<int, 3>{});
+    }
+
+    template<typename S, typename D, int SrcChannels, int DstChannels, bool SrcSrgb, bool DstSrgb>
+    std::unique_ptr<Program> create_kernel(double default_alpha)
+    {
+        auto color_op = make_op<S, D, SrcSrgb, DstSrgb>();
+        auto alpha_op = make_op<S, D, false, false>();
+        using Kernel = KernelProgram<S, D, SrcChannels, DstChannels, decltype(color_op), decltype(alpha_op)>;
+        auto kernel = std::make_unique<Kernel>();
+        kernel->color_op = color_op;
+        kernel->alpha_op = alpha_op;
+        kernel->default_alpha = convert_default<D>(default_alpha);
+        return kernel;
+    }
+
+    template<typename S, typename D>
+    std::unique_ptr<Program> create_kernel(const Layout& src_layout, const Layout& dst_layout, double default_alpha)
+    {
+        std::unique_ptr<Program> program;
+        dispatch_channel_count(
+            src_layout.channel_count,
+            [&](auto src_channels)
+            {
+                dispatch_channel_count(
+                    dst_layout.channel_count,
+                    [&](auto dst_channels)
+                    {
+                        dispatch_bool(
+                            src_layout.srgb,
+                            [&](auto src_srgb)
+                            {
+                                dispatch_bool(
+                                    dst_layout.srgb,
+                                    [&](auto dst_srgb)
+                                    {
+                                        program = create_kernel<S, D, src_channels, dst_channels, src_srgb, dst_srgb>(
+                                            default_alpha
+                                        );
+                                    }
+                                );
+                            }
+                        );
+                    }
+                );
+            }
+        );
+        return program;
+    }
+
+    /// Compile a kernel program if the struct pair is supported, returns \c nullptr otherwise.
+    inline std::unique_ptr<Program> compile(const Struct& src_struct, const Struct& dst_struct)
+    {
+        auto src_layout = get_layout(src_struct);
+        auto dst_layout = get_layout(dst_struct);
+        if (!src_layout || !dst_layout)
+            return nullptr;
+
+        // Missing alpha channel needs to be filled with a default value.
+        double default_alpha = 0.0;
+        if (dst_layout->channel_count == 4 && src_layout->channel_count == 3) {
+            if (!is_set(dst_struct[3].flags, Struct::Flags::default_))
+                return nullptr;
+            default_alpha = dst_struct[3].default_value;
+        }
+
+        std::unique_ptr<Program> program;
+        dispatch_type(
+            src_layout->type,
+            [&](auto s)
+            {
+                dispatch_type(
+                    dst_layout->type,
+                    [&](auto d)
+                    {
+                        program = create_kernel<decltype(s), decltype(d)>(*src_layout, *dst_layout, default_alpha);
+                    }
+                );
+            }
+        );
+        return program;
+    }
+
+} // namespace aot
+
 #if SGL_HAS_ASMJIT
 
 /// Conversion program running just-in-time compiled X86 code.
@@ -1970,14 +2307,23 @@ class ProgramCache {
 public:
     const Program* get_program(const Struct& src_struct, const Struct& dst_struct)
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
         auto key = std::make_pair(src_struct, dst_struct);
-        auto it = m_programs.find(key);
-        if (it != m_programs.end())
-            return it->second.get();
-        auto [it2, inserted] = m_programs.emplace(key, compile_program(src_struct, dst_struct));
-        return it2->second.get();
+
+        // Fast path: lookup under a shared lock so concurrent conversions don't serialize.
+        {
+            std::shared_lock lock(m_mutex);
+            auto it = m_programs.find(key);
+            if (it != m_programs.end())
+                return it->second.get();
+        }
+
+        // Compile outside of the lock. If another thread compiled the same program
+        // in the meantime, the existing program is kept and ours is discarded.
+        std::unique_ptr<Program> program = compile_program(src_struct, dst_struct);
+
+        std::unique_lock lock(m_mutex);
+        auto [it, inserted] = m_programs.emplace(std::move(key), std::move(program));
+        return it->second.get();
     }
 
     static ProgramCache& get()
@@ -1989,14 +2335,18 @@ public:
 private:
     std::unique_ptr<Program> compile_program(const Struct& src_struct, const Struct& dst_struct)
     {
-        std::unique_ptr<Program> program;
+        // Prefer ahead-of-time compiled kernels. They need no warm-up and also work in
+        // processes that don't allow executable memory to be allocated.
+        std::unique_ptr<Program> program = aot::compile(src_struct, dst_struct);
 
 #if SGL_HAS_ASMJIT
+        if (!program) {
 #if SGL_X86_64
-        program = X86Program::compile(src_struct, dst_struct);
+            program = X86Program::compile(src_struct, dst_struct);
 #elif SGL_ARM64
-        program = ARMProgram::compile(src_struct, dst_struct);
+            program = ARMProgram::compile(src_struct, dst_struct);
 #endif
+        }
 #endif // SGL_HAS_ASMJIT
         if (!program)
             program = VMProgram::compile(src_struct, dst_struct);
@@ -2004,7 +2354,7 @@ private:
         return program;
     }
 
-    std::mutex m_mutex;
+    std::shared_mutex m_mutex;
     std::unordered_map<
         std::pair<Struct, Struct>,
         std::unique_ptr<Program>,
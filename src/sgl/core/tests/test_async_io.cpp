@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "testing.h"
+#include "sgl/core/async_io.h"
+
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <vector>
+
+using namespace sgl;
+
+TEST_SUITE_BEGIN("async_io");
+
+static std::vector<uint8_t> random_data(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    std::mt19937 rng;
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = rng() & 0xff;
+    return data;
+}
+
+static std::vector<AsyncIOBackend> available_backends()
+{
+    std::vector<AsyncIOBackend> backends{AsyncIOBackend::thread};
+    if (AsyncIOQueue::is_io_uring_supported())
+        backends.push_back(AsyncIOBackend::io_uring);
+    return backends;
+}
+
+TEST_CASE("AsyncFile")
+{
+    auto path = testing::get_case_temp_directory() / "test_async_file.bin";
+    auto data = random_data(10000);
+
+    {
+        auto file = make_ref<AsyncFile>(path, AsyncFile::Mode::write);
+        file->write_at(0, data.data(), 5000);
+        file->write_at(5000, data.data() + 5000, 5000);
+    }
+    {
+        auto file = make_ref<AsyncFile>(path, AsyncFile::Mode::read);
+        CHECK_EQ(file->size(), data.size());
+        std::vector<uint8_t> buffer(data.size() + 100);
+        CHECK_EQ(file->read_at(0, buffer.data(), buffer.size()), data.size());
+        CHECK(std::memcmp(buffer.data(), data.data(), data.size()) == 0);
+        CHECK_EQ(file->read_at(9000, buffer.data(), 100), 100);
+        CHECK(std::memcmp(buffer.data(), data.data() + 9000, 100) == 0);
+    }
+
+    CHECK_THROWS(make_ref<AsyncFile>("__file_that_does_not_exist__", AsyncFile::Mode::read));
+}
+
+TEST_CASE("AsyncIOQueue")
+{
+    static constexpr size_t CHUNK_SIZE = 4096;
+    static constexpr size_t CHUNK_COUNT = 64;
+
+    auto data = random_data(CHUNK_SIZE * CHUNK_COUNT);
+
+    for (AsyncIOBackend backend : available_backends()) {
+        CAPTURE(backend);
+        auto path = testing::get_case_temp_directory() / "test_async_io_queue.bin";
+        auto queue = make_ref<AsyncIOQueue>(AsyncIOQueueDesc{.backend = backend, .queue_depth = 8});
+        CHECK_EQ(queue->backend(), backend);
+
+        // Write chunks in reverse order (more requests than the queue depth).
+        {
+            auto file = make_ref<AsyncFile>(path, AsyncFile::Mode::write);
+            for (size_t i = 0; i < CHUNK_COUNT; ++i) {
+                size_t chunk = CHUNK_COUNT - 1 - i;
+                queue->submit_write(file, chunk * CHUNK_SIZE, data.data() + chunk * CHUNK_SIZE, CHUNK_SIZE, chunk);
+            }
+            std::vector<bool> completed(CHUNK_COUNT, false);
+            while (queue->pending_count() > 0) {
+                for (const AsyncIOCompletion& completion : queue->complete()) {
+                    CHECK_EQ(completion.result, CHUNK_SIZE);
+                    completed[completion.user_data] = true;
+                }
+            }
+            CHECK(std::all_of(completed.begin(), completed.end(), [](bool c) { return c; }));
+        }
+
+        // Read chunks back into a caller-owned buffer.
+        {
+            auto file = make_ref<AsyncFile>(path, AsyncFile::Mode::read);
+            REQUIRE_EQ(file->size(), data.size());
+            std::vector<uint8_t> buffer(data.size());
+            for (size_t i = 0; i < CHUNK_COUNT; ++i)
+                queue->submit_read(file, i * CHUNK_SIZE, buffer.data() + i * CHUNK_SIZE, CHUNK_SIZE, i);
+            auto completions = queue->complete(CHUNK_COUNT);
+            CHECK_EQ(completions.size(), CHUNK_COUNT);
+            CHECK_EQ(queue->pending_count(), 0);
+            for (const AsyncIOCompletion& completion : completions)
+                CHECK_EQ(completion.result, CHUNK_SIZE);
+            CHECK(buffer == data);
+
+            // Reading past the end of the file returns a short read.
+            queue->submit_read(file, data.size() - 100, buffer.data(), CHUNK_SIZE, 0);
+            completions = queue->complete();
+            REQUIRE_EQ(completions.size(), 1);
+            CHECK_EQ(completions[0].result, 100);
+        }
+    }
+}
+
+TEST_CASE("async_io")
+{
+    auto path = testing::get_case_temp_directory() / "test_async_io.bin";
+    // Larger than the chunk size used by the I/O service.
+    auto data = random_data(3 * 1024 * 1024 + 123);
+
+    std::promise<void> written;
+    async_io::write_file(
+        path,
+        data,
+        [&](std::exception_ptr error)
+        {
+            if (error)
+                written.set_exception(error);
+            else
+                written.set_value();
+        }
+    );
+    written.get_future().get();
+
+    auto future = async_io::read_file_and_process(path, [](std::vector<uint8_t> contents) { return contents; });
+    CHECK(future.get() == data);
+
+    auto failed = async_io::read_file_and_process("__file_that_does_not_exist__", [](std::vector<uint8_t>) { });
+    CHECK_THROWS(failed.get());
+
+    // Pool workers process the data themselves instead of waiting for another pool task.
+    auto nested = thread::do_async(
+        [&]()
+        {
+            auto inner = async_io::read_file_and_process(path, [](std::vector<uint8_t> contents) { return contents; });
+            return inner.get();
+        }
+    );
+    CHECK(nested.get() == data);
+
+    async_io::wait_for_idle();
+    CHECK_EQ(async_io::pending_count(), 0);
+}
+
+TEST_SUITE_END();
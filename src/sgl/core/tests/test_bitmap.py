@@ -3,7 +3,9 @@
 from pathlib import Path
 from typing import Any, Optional, Sequence
 import pytest
-from sgl import Bitmap, Struct
+import os
+import struct
+from sgl import Bitmap, Struct, MemoryPool, scan_image_directory
 import numpy as np
 import numpy.typing as npt
 
@@ -91,6 +93,14 @@ def write_read_test(
     assert b1.channel_count == b2.channel_count
     assert b1.srgb_gamma == b2.srgb_gamma
 
+    info = Bitmap.probe(path)
+    assert info.pixel_format == b2.pixel_format
+    assert info.component_type == b2.component_type
+    assert info.width == b2.width
+    assert info.height == b2.height
+    assert info.channel_count == b2.channel_count
+    assert info.srgb_gamma == b2.srgb_gamma
+
     a1 = np.array(b1, copy=False)
     a2 = np.array(b2, copy=False)
 
@@ -137,6 +147,119 @@ def test_bitmap_vflip():
     assert np.all(a == np.flip(img, 0))
 
 
+@pytest.mark.parametrize(
+    "pixel_format,component_type",
+    [
+        (Bitmap.PixelFormat.y, Bitmap.ComponentType.uint8),
+        (Bitmap.PixelFormat.rgb, Bitmap.ComponentType.uint8),
+        (Bitmap.PixelFormat.rgba, Bitmap.ComponentType.float32),
+    ],
+)
+def test_bitmap_transforms(pixel_format: Bitmap.PixelFormat, component_type: Bitmap.ComponentType):
+    # Use random data, the test image pattern is symmetric.
+    shape = create_test_image(300, 170, pixel_format, component_type).shape
+    img = (np.random.default_rng(0).random(shape) * 255).astype(COMPONENT_TYPE_TO_DTYPE[component_type])
+    b = Bitmap(img)
+    assert np.all(np.array(b.transpose(), copy=False) == np.swapaxes(img, 0, 1))
+    assert np.all(np.array(b.rotate90(), copy=False) == np.rot90(img, -1))
+    assert np.all(np.array(b.rotate180(), copy=False) == np.rot90(img, 2))
+    assert np.all(np.array(b.rotate270(), copy=False) == np.rot90(img, 1))
+    assert np.all(np.array(b.crop(10, 20, 50, 60), copy=False) == img[20:80, 10:60])
+    b.hflip()
+    assert np.all(np.array(b, copy=False) == np.flip(img, 1))
+
+
+@pytest.mark.parametrize(
+    "pixel_format,component_type",
+    [
+        (Bitmap.PixelFormat.y, Bitmap.ComponentType.uint8),
+        (Bitmap.PixelFormat.rgb, Bitmap.ComponentType.uint8),
+        (Bitmap.PixelFormat.rgba, Bitmap.ComponentType.float32),
+    ],
+)
+def test_bitmap_transforms_parallel(
+    pixel_format: Bitmap.PixelFormat, component_type: Bitmap.ComponentType
+):
+    # Large enough to run the transforms on the thread pool.
+    shape = create_test_image(600, 400, pixel_format, component_type).shape
+    img = (np.random.default_rng(0).random(shape) * 255).astype(
+        COMPONENT_TYPE_TO_DTYPE[component_type]
+    )
+    b = Bitmap(img)
+    assert np.all(np.array(b.transpose(), copy=False) == np.swapaxes(img, 0, 1))
+    assert np.all(np.array(b.rotate90(), copy=False) == np.rot90(img, -1))
+    assert np.all(np.array(b.rotate180(), copy=False) == np.rot90(img, 2))
+    assert np.all(np.array(b.rotate270(), copy=False) == np.rot90(img, 1))
+    view = b.view(7, 3, 520, 390)
+    assert np.all(np.array(view.to_bitmap(), copy=False) == img[3:393, 7:527])
+    b.hflip()
+    assert np.all(np.array(b, copy=False) == np.flip(img, 1))
+    b.vflip()
+    assert np.all(np.array(b, copy=False) == np.rot90(img, 2))
+
+
+def test_bitmap_view():
+    img = np.random.default_rng(0).integers(0, 255, (80, 100, 3), np.uint8)
+    b = Bitmap(img)
+    view = b.view(10, 20, 30, 40)
+    assert (view.x, view.y, view.width, view.height) == (10, 20, 30, 40)
+    assert not view.is_contiguous()
+    assert np.all(np.asarray(view) == img[20:60, 10:40])
+    sub = view.subview(5, 5, 10, 10)
+    assert np.all(np.array(sub.to_bitmap(), copy=False) == img[25:35, 15:25])
+    with pytest.raises(Exception):
+        b.view(90, 0, 20, 10)
+
+    tiles = b.tiles(32, 32)
+    assert len(tiles) == 3 * 2
+    assert np.all(np.asarray(tiles[4]) == img[32:64, 32:64])
+    assert len(b.tiles(32, 32, include_partial=True)) == 4 * 3
+
+
+def test_bitmap_tiles_overlap():
+    img = np.random.default_rng(0).integers(0, 255, (80, 100, 3), np.uint8)
+    b = Bitmap(img)
+
+    # Overlapping tiles, only full tiles.
+    tiles = b.tiles(32, 32, step_x=16, step_y=16)
+    origins = [(x, y) for y in range(0, 49, 16) for x in range(0, 65, 16)]
+    assert [(t.x, t.y) for t in tiles] == origins
+    for t in tiles:
+        assert (t.width, t.height) == (32, 32)
+        assert np.all(np.asarray(t) == img[t.y : t.y + 32, t.x : t.x + 32])
+
+    # Overlapping tiles clipped at the borders.
+    tiles = b.tiles(32, 32, step_x=16, step_y=16, include_partial=True)
+    origins = [(x, y) for y in range(0, 80, 16) for x in range(0, 100, 16)]
+    assert [(t.x, t.y) for t in tiles] == origins
+    for t in tiles:
+        assert (t.width, t.height) == (min(32, 100 - t.x), min(32, 80 - t.y))
+        assert np.all(
+            np.asarray(t) == img[t.y : t.y + t.height, t.x : t.x + t.width]
+        )
+
+    # Tiles with gaps in between.
+    tiles = b.tiles(10, 20, step_x=30, step_y=25)
+    assert [(t.x, t.y) for t in tiles] == [
+        (x, y) for y in range(0, 61, 25) for x in range(0, 91, 30)
+    ]
+
+
+def test_bitmap_split_views():
+    img = np.random.default_rng(0).random((10, 20, 5), np.float32)
+    b = Bitmap(
+        img,
+        Bitmap.PixelFormat.multi_channel,
+        ["albedo.R", "albedo.G", "albedo.B", "depth.Y", "mask"],
+    )
+    split = b.split()
+    views = b.split_views()
+    assert [prefix for prefix, _ in views] == [prefix for prefix, _ in split]
+    for (_, bitmap), (_, view) in zip(split, views):
+        assert view.has_channel_subset
+        assert bitmap == view.to_bitmap()
+
+
 EXR_LAYOUTS = [
     (5, 10, Bitmap.PixelFormat.y, Bitmap.ComponentType.float16),
     (10, 20, Bitmap.PixelFormat.ya, Bitmap.ComponentType.float16),
@@ -167,6 +290,8 @@ def test_exr_io(tmp_path: Path, layout: Sequence[Any]):
 BMP_LAYOUTS = [
     (50, 100, Bitmap.PixelFormat.rgb, Bitmap.ComponentType.uint8),
     (100, 200, Bitmap.PixelFormat.rgba, Bitmap.ComponentType.uint8),
+    (300, 300, Bitmap.PixelFormat.rgb, Bitmap.ComponentType.uint8),
+    (300, 300, Bitmap.PixelFormat.rgba, Bitmap.ComponentType.uint8),
 ]
 
 
@@ -182,6 +307,8 @@ TGA_LAYOUTS = [
     (5, 10, Bitmap.PixelFormat.y, Bitmap.ComponentType.uint8),
     (50, 100, Bitmap.PixelFormat.rgb, Bitmap.ComponentType.uint8),
     (100, 200, Bitmap.PixelFormat.rgba, Bitmap.ComponentType.uint8),
+    (300, 300, Bitmap.PixelFormat.y, Bitmap.ComponentType.uint8),
+    (300, 300, Bitmap.PixelFormat.rgba, Bitmap.ComponentType.uint8),
 ]
 
 
@@ -237,7 +364,9 @@ def test_jpg_io(tmp_path: Path, layout: Sequence[Any]):
 
 
 HDR_LAYOUTS = [
+    (5, 10, Bitmap.PixelFormat.rgb, Bitmap.ComponentType.float32, {"rtol": 1e-2}),
     (100, 200, Bitmap.PixelFormat.rgb, Bitmap.ComponentType.float32, {"rtol": 1e-2}),
+    (300, 300, Bitmap.PixelFormat.rgb, Bitmap.ComponentType.float32, {"rtol": 1e-2}),
 ]
 
 
@@ -249,5 +378,339 @@ def test_hdr_io(tmp_path: Path, layout: Sequence[Any]):
     )
 
 
+# Files built byte by byte, covering decoder paths that round trips do not reach.
+# Expected pixels follow the stb_image decoding rules. Variants without a native decoder
+# are decoded by stb_image and compared against the native decoding of the same pixels.
+
+
+def rng_image(width: int, height: int, channels: int, seed: int = 0):
+    rng = np.random.default_rng(seed)
+    return rng.integers(0, 256, (height, width, channels), dtype=np.uint8)
+
+
+def read_bytes(path: Path, data: bytes):
+    path.write_bytes(data)
+    return np.array(Bitmap(path), copy=True)
+
+
+def bmp_file(
+    width: int,
+    height: int,
+    bits_per_pixel: int,
+    pixel_data: bytes,
+    compression: int = 0,
+    palette: bytes = b"",
+):
+    data_offset = 14 + 40 + len(palette)
+    file_size = data_offset + len(pixel_data)
+    file_header = b"BM" + struct.pack("<IHHI", file_size, 0, 0, data_offset)
+    info_header = struct.pack(
+        "<IiiHHIIiiII",
+        40,
+        width,
+        height,
+        1,
+        bits_per_pixel,
+        compression,
+        len(pixel_data),
+        2835,
+        2835,
+        len(palette) // 4,
+        0,
+    )
+    return file_header + info_header + palette + pixel_data
+
+
+def bmp_rows(rows: Sequence[bytes]):
+    """Pad rows to 4 bytes and store them bottom-up."""
+    return b"".join(row + b"\0" * (-len(row) % 4) for row in reversed(rows))
+
+
+def test_bmp_32bit_implicit_alpha(tmp_path: Path):
+    img = rng_image(5, 3, 4)
+
+    # BI_RGB 32-bit files with an all-zero alpha channel are opaque.
+    img[:, :, 3] = 0
+    data = bmp_file(5, 3, 32, bmp_rows([row[:, [2, 1, 0, 3]].tobytes() for row in img]))
+    expected = img.copy()
+    expected[:, :, 3] = 255
+    assert np.array_equal(read_bytes(tmp_path / "zero_alpha.bmp", data), expected)
+
+    # Otherwise the alpha channel is kept.
+    img[1, 2, 3] = 7
+    data = bmp_file(5, 3, 32, bmp_rows([row[:, [2, 1, 0, 3]].tobytes() for row in img]))
+    assert np.array_equal(read_bytes(tmp_path / "alpha.bmp", data), img)
+
+
+def test_bmp_stb_fallback(tmp_path: Path):
+    # Odd width to exercise row padding.
+    width, height = 5, 3
+    img = rng_image(width, height, 3)
+    rows = bmp_rows([row[:, ::-1].tobytes() for row in img])
+    data = bmp_file(width, height, 24, rows)
+    native = read_bytes(tmp_path / "rgb24.bmp", data)
+    assert np.array_equal(native, img)
+
+    # Palettized (decoded by stb_image).
+    palette = b"".join(bytes([p[2], p[1], p[0], 0]) for p in img.reshape(-1, 3))
+    indices = np.arange(width * height, dtype=np.uint8).reshape(height, width)
+    rows = bmp_rows([row.tobytes() for row in indices])
+    data = bmp_file(width, height, 8, rows, palette=palette)
+    assert np.array_equal(read_bytes(tmp_path / "palette8.bmp", data), native)
+
+    # 16-bit 5-5-5 (decoded by stb_image, channels expanded by bit replication).
+    img5 = img >> 3
+    channels = img5.astype(np.uint16)
+    packed = (channels[:, :, 0] << 10) | (channels[:, :, 1] << 5) | channels[:, :, 2]
+    rows = bmp_rows([row.astype("<u2").tobytes() for row in packed])
+    data = bmp_file(width, height, 16, rows)
+    expected = (img5 << 3) | (img5 >> 2)
+    assert np.array_equal(read_bytes(tmp_path / "rgb16.bmp", data), expected)
+
+    # RLE8 is not supported by stb_image and fails to read.
+    rle = b"".join(bytes([width, i * width]) + b"\0\0" for i in range(height)) + b"\0\1"
+    data = bmp_file(width, height, 8, rle, compression=1, palette=palette)
+    with pytest.raises(Exception):
+        read_bytes(tmp_path / "rle8.bmp", data)
+
+
+def tga_file(
+    image_type: int,
+    width: int,
+    height: int,
+    bits_per_pixel: int,
+    pixel_data: bytes,
+    descriptor: int = 0,
+    color_map: bytes = b"",
+):
+    color_map_spec = b"\0" * 5
+    if color_map:
+        color_map_spec = struct.pack("<HHB", 0, len(color_map) // 3, 24)
+    header = struct.pack("<BBB", 0, 1 if color_map else 0, image_type) + color_map_spec
+    header += struct.pack("<HHHHBB", 0, 0, width, height, bits_per_pixel, descriptor)
+    return header + color_map + pixel_data
+
+
+def test_tga_uncompressed(tmp_path: Path):
+    width, height = 7, 4
+    img = rng_image(width, height, 4)
+
+    # Bottom-up 24-bit.
+    rows = b"".join(row[:, 2::-1].tobytes() for row in img[::-1])
+    data = tga_file(2, width, height, 24, rows)
+    native = read_bytes(tmp_path / "rgb24.tga", data)
+    assert np.array_equal(native, img[:, :, :3])
+
+    # Top-down 32-bit.
+    rows = img[:, :, [2, 1, 0, 3]].tobytes()
+    data = tga_file(2, width, height, 32, rows, descriptor=0x28)
+    assert np.array_equal(read_bytes(tmp_path / "rgba32.tga", data), img)
+
+    # Top-down 8-bit gray.
+    data = tga_file(3, width, height, 8, img[:, :, 0].tobytes(), descriptor=0x20)
+    assert np.array_equal(read_bytes(tmp_path / "y8.tga", data), img[:, :, 0])
+
+    # Color mapped (decoded by stb_image).
+    color_map = img[:, :, 2::-1].tobytes()
+    indices = np.arange(width * height, dtype=np.uint8).reshape(height, width)
+    data = tga_file(1, width, height, 8, indices[::-1].tobytes(), color_map=color_map)
+    assert np.array_equal(read_bytes(tmp_path / "color_map.tga", data), native)
+
+
+def test_tga_truncated_rle(tmp_path: Path):
+    # A raw packet of 128 pixels with the pixel data cut short.
+    packets = bytes([0x7F]) + b"\1" * (3 * 100) + bytes([0xFF, 1, 2, 3])
+    data = tga_file(10, 128, 2, 24, packets)
+    with pytest.raises(Exception):
+        read_bytes(tmp_path / "truncated.tga", data)
+
+    # The complete image decodes.
+    data = tga_file(10, 128, 2, 24, bytes([0xFF, 1, 2, 3]) * 2)
+    assert np.all(read_bytes(tmp_path / "complete.tga", data) == [3, 2, 1])
+
+
+def hdr_file(width: int, height: int, scanlines: bytes):
+    header = f"#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y {height} +X {width}\n".encode()
+    return header + scanlines
+
+
+def rgbe_to_float(rgbe: npt.NDArray[np.uint8]):
+    """Decode RGBE like stb_image, i.e. value = mantissa * 2^(exponent - 136)."""
+    exponent = rgbe[..., 3].astype(np.int32)
+    value = np.ldexp(rgbe[..., :3].astype(np.float32), (exponent - 136)[..., None])
+    return np.where(exponent[..., None] == 0, np.float32(0), value).astype(np.float32)
+
+
+def hdr_rle_decode(data: bytes, width: int, height: int):
+    rgbe = np.zeros((height, width, 4), np.uint8)
+    pos = 0
+    for y in range(height):
+        assert data[pos : pos + 4] == bytes([2, 2, width >> 8, width & 0xFF])
+        pos += 4
+        for c in range(4):
+            x = 0
+            while x < width:
+                count = data[pos]
+                pos += 1
+                if count > 128:
+                    rgbe[y, x : x + count - 128, c] = data[pos]
+                    pos += 1
+                    x += count - 128
+                else:
+                    literals = np.frombuffer(data[pos : pos + count], np.uint8)
+                    rgbe[y, x : x + count, c] = literals
+                    pos += count
+                    x += count
+    assert pos == len(data)
+    return rgbe
+
+
+def test_hdr_flat_all_exponents(tmp_path: Path):
+    # Widths below 8 store flat RGBE scanlines.
+    # Covers every exponent, including the ones with denormal results.
+    rgbe = rng_image(4, 64, 4)
+    rgbe[:, :, 3] = np.arange(256, dtype=np.uint8).reshape(64, 4)
+    result = read_bytes(tmp_path / "flat.hdr", hdr_file(4, 64, rgbe.tobytes()))
+    assert result.dtype == np.float32
+    assert np.array_equal(result.view(np.uint32), rgbe_to_float(rgbe).view(np.uint32))
+
+
+def test_hdr_rle(tmp_path: Path):
+    width, height = 16, 3
+    rgbe = rng_image(width, height, 4)
+    rgbe[:, 4:12, :] = rgbe[:, 4:5, :]
+    scanlines = b""
+    for y in range(height):
+        scanlines += bytes([2, 2, 0, width])
+        for c in range(4):
+            plane = rgbe[y, :, c].tobytes()
+            scanlines += bytes([4]) + plane[:4] + bytes([128 + 8, plane[4]])
+            scanlines += bytes([4]) + plane[12:]
+    result = read_bytes(tmp_path / "rle.hdr", hdr_file(width, height, scanlines))
+    assert np.array_equal(result.view(np.uint32), rgbe_to_float(rgbe).view(np.uint32))
+
+    # Truncated scanlines.
+    with pytest.raises(Exception):
+        read_bytes(tmp_path / "truncated.hdr", hdr_file(width, height, scanlines[:-5]))
+
+    # Runs extending past the end of the scanline.
+    corrupt = bytearray(scanlines)
+    corrupt[4 + 5] = 128 + 13
+    with pytest.raises(Exception):
+        read_bytes(tmp_path / "overrun.hdr", hdr_file(width, height, bytes(corrupt)))
+
+    # Zero length runs.
+    corrupt = bytearray(scanlines)
+    corrupt[4] = 0
+    with pytest.raises(Exception):
+        read_bytes(tmp_path / "zero_run.hdr", hdr_file(width, height, bytes(corrupt)))
+
+    # Large enough to decode scanlines on the thread pool.
+    width, height = 256, 320
+    rgbe = rng_image(width, height, 4)
+    scanlines = b""
+    for y in range(height):
+        scanlines += bytes([2, 2, width >> 8, width & 0xFF])
+        for c in range(4):
+            plane = rgbe[y, :, c].tobytes()
+            scanlines += bytes([128]) + plane[:128] + bytes([128]) + plane[128:]
+    result = read_bytes(tmp_path / "large.hdr", hdr_file(width, height, scanlines))
+    assert np.array_equal(result.view(np.uint32), rgbe_to_float(rgbe).view(np.uint32))
+
+
+def test_hdr_write_rgbe(tmp_path: Path):
+    # Encoded RGBE values match stb_image_write.
+    width, height = 32, 4
+    img = np.random.default_rng(0).random((height, width, 3), dtype=np.float32) * 100
+    img[0, :4] = 0
+    img[1, :4] = 1e-33
+    img[2, :4] = [0.5, 0.25, 1.0]
+    path = tmp_path / "write.hdr"
+    Bitmap(img).write(path)
+
+    data = path.read_bytes()
+    header = f"#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y {height} +X {width}\n".encode()
+    assert data.startswith(header)
+    rgbe = hdr_rle_decode(data[len(header) :], width, height)
+
+    max_value = img.max(axis=2)
+    safe_max = np.maximum(max_value, np.float32(1e-32))
+    normalize = np.frexp(safe_max)[0] * np.float32(256) / safe_max
+    expected = np.zeros((height, width, 4), np.uint8)
+    expected[..., :3] = (img * normalize[..., None]).astype(np.uint8)
+    expected[..., 3] = np.frexp(safe_max)[1] + 128
+    expected[max_value < np.float32(1e-32)] = 0
+    assert np.array_equal(rgbe, expected)
+
+
+def test_memory_pool():
+    pool = MemoryPool({"enable_pooling": True, "alignment": 64})
+    Bitmap.set_memory_pool(pool)
+    try:
+        for _ in range(4):
+            bitmap = Bitmap(
+                Bitmap.PixelFormat.rgba, Bitmap.ComponentType.float32, 256, 128
+            )
+            assert np.asarray(bitmap).ctypes.data % 64 == 0
+            del bitmap
+        assert pool.stats.allocation_count == 4
+        assert pool.stats.pool_hit_count == 3
+        pool.trim()
+        assert pool.stats.pooled_size == 0
+    finally:
+        Bitmap.set_memory_pool(None)
+
+
+def test_probe_multiple(tmp_path: Path):
+    paths = []
+    for i, ext in enumerate(["png", "jpg", "exr"]):
+        path = tmp_path / f"image{i}.{ext}"
+        Bitmap(np.zeros((10 + i, 20 + i, 3), np.float32 if ext == "exr" else np.uint8)).write(path)
+        paths.append(path)
+    infos = Bitmap.probe_multiple(paths)
+    assert [info.file_format for info in infos] == [
+        Bitmap.FileFormat.png,
+        Bitmap.FileFormat.jpg,
+        Bitmap.FileFormat.exr,
+    ]
+    assert [(info.width, info.height) for info in infos] == [(20, 10), (21, 11), (22, 12)]
+
+    # The PNG signature is checked, not just the IHDR chunk type.
+    data = bytearray(paths[0].read_bytes())
+    data[1:4] = b"XYZ"
+    corrupt = tmp_path / "corrupt.png"
+    corrupt.write_bytes(bytes(data))
+    with pytest.raises(Exception):
+        Bitmap.probe(corrupt, Bitmap.FileFormat.png)
+
+
+def test_scan_image_directory(tmp_path: Path):
+    (tmp_path / "sub").mkdir()
+    Bitmap(np.zeros((16, 32, 4), np.uint8)).write(tmp_path / "a.png")
+    Bitmap(np.zeros((8, 8, 3), np.float32)).write(tmp_path / "sub" / "b.exr")
+    (tmp_path / "broken.tga").write_bytes(b"not an image")
+    (tmp_path / "notes.txt").write_text("ignored")
+
+    entries = scan_image_directory(tmp_path)
+    assert [e.path.name for e in entries] == ["a.png", "broken.tga", "b.exr"]
+    a, broken, b = entries
+    assert a.bitmap_info.width == 32 and a.bitmap_info.height == 16
+    assert a.bitmap_info.pixel_format == Bitmap.PixelFormat.rgba
+    assert a.dds_info is None and a.error == ""
+    assert b.bitmap_info.component_type == Bitmap.ComponentType.float32
+    assert broken.bitmap_info is None and broken.error != ""
+
+    entries = scan_image_directory(tmp_path, {"recursive": False})
+    assert [e.path.name for e in entries] == ["a.png", "broken.tga"]
+
+    # Incremental scan: only modified files are probed again.
+    Bitmap(np.zeros((4, 4, 1), np.uint8)).write(tmp_path / "a.png")
+    st = os.stat(tmp_path / "a.png")
+    os.utime(tmp_path / "a.png", ns=(st.st_atime_ns, st.st_mtime_ns + 10**9))
+    updated = scan_image_directory(tmp_path, previous=entries)
+    assert updated[0].bitmap_info.width == 4
+    assert updated[0].bitmap_info.pixel_format == Bitmap.PixelFormat.y
+
+
 if __name__ == "__main__":
     pytest.main([__file__, "-v"])
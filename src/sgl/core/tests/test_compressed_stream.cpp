@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "testing.h"
+#include "sgl/core/compressed_stream.h"
+#include "sgl/core/file_stream.h"
+#include "sgl/core/memory_stream.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace sgl;
+
+TEST_SUITE_BEGIN("compressed_stream");
+
+/// Generate compressible data with some randomness.
+static std::vector<uint8_t> generate_data(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    std::mt19937 rng;
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = uint8_t((i / 7) & 0xff) ^ ((rng() & 0x7) == 0 ? uint8_t(rng()) : 0);
+    return data;
+}
+
+TEST_CASE("CompressedStream")
+{
+    auto data = generate_data(1000000);
+
+    for (CompressionCodec codec : {CompressionCodec::zstd, CompressionCodec::lz4}) {
+        if (!CompressedStream::is_codec_supported(codec))
+            continue;
+        CAPTURE(codec);
+
+        auto memory_stream = make_ref<MemoryStream>();
+        CompressedStreamDesc desc{.codec = codec, .block_size = 64 * 1024, .max_blocks_in_flight = 4};
+
+        // Write in irregular chunks.
+        {
+            auto stream = make_ref<CompressedStream>(memory_stream, CompressedStream::Mode::write, desc);
+            CHECK(stream->is_writable());
+            CHECK_FALSE(stream->is_readable());
+            size_t pos = 0;
+            size_t chunk = 1;
+            while (pos < data.size()) {
+                size_t count = std::min(chunk, data.size() - pos);
+                stream->write(data.data() + pos, count);
+                pos += count;
+                chunk = chunk * 3 + 1;
+            }
+            CHECK_EQ(stream->tell(), data.size());
+            CHECK_EQ(stream->size(), data.size());
+            CHECK_THROWS(stream->seek(0));
+            stream->close();
+            CHECK_EQ(stream->frame_count(), (data.size() + desc.block_size - 1) / desc.block_size);
+        }
+
+        CHECK(memory_stream->size() < data.size());
+        memory_stream->seek(0);
+        CHECK(CompressedStream::detect_compressed_stream(memory_stream));
+        CHECK_EQ(memory_stream->tell(), 0);
+
+        auto stream = make_ref<CompressedStream>(memory_stream, CompressedStream::Mode::read);
+        CHECK_EQ(stream->codec(), codec);
+        CHECK_EQ(stream->size(), data.size());
+
+        SUBCASE("read_all")
+        {
+            std::vector<uint8_t> buffer(data.size());
+            stream->read(buffer.data(), buffer.size());
+            CHECK(buffer == data);
+            CHECK_THROWS_AS(stream->read(buffer.data(), 1), EOFException);
+        }
+
+        SUBCASE("read_sequential")
+        {
+            std::vector<uint8_t> buffer(data.size());
+            for (size_t pos = 0; pos < data.size(); pos += 1000)
+                stream->read(buffer.data() + pos, std::min<size_t>(1000, data.size() - pos));
+            CHECK(buffer == data);
+        }
+
+        SUBCASE("read_random")
+        {
+            std::mt19937 rng;
+            std::vector<uint8_t> buffer;
+            for (int i = 0; i < 100; ++i) {
+                size_t offset = rng() % data.size();
+                size_t size = std::min<size_t>(rng() % 200000, data.size() - offset);
+                buffer.resize(size);
+                stream->seek(offset);
+                stream->read(buffer.data(), size);
+                CHECK_EQ(stream->tell(), offset + size);
+                CHECK(std::memcmp(buffer.data(), data.data() + offset, size) == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE("CompressedStream_flush")
+{
+    if (!CompressedStream::is_codec_supported(CompressionCodec::zstd))
+        return;
+
+    auto path = testing::get_case_temp_directory() / "test_compressed_stream.zst";
+    auto data = generate_data(10000);
+
+    {
+        auto stream = make_ref<CompressedStream>(
+            make_ref<FileStream>(path, FileStream::Mode::write),
+            CompressedStream::Mode::write
+        );
+        stream->write(data.data(), 3000);
+        // Flushing emits a partial frame.
+        stream->flush();
+        CHECK_EQ(stream->frame_count(), 1);
+        stream->write(data.data() + 3000, 7000);
+    }
+
+    auto stream = make_ref<CompressedStream>(
+        make_ref<FileStream>(path, FileStream::Mode::read),
+        CompressedStream::Mode::read
+    );
+    CHECK_EQ(stream->frame_count(), 2);
+    std::vector<uint8_t> buffer(data.size());
+    stream->seek(2000);
+    stream->read(buffer.data() + 2000, 2000);
+    stream->seek(0);
+    stream->read(buffer.data(), 2000);
+    stream->seek(4000);
+    stream->read(buffer.data() + 4000, 6000);
+    CHECK(buffer == data);
+}
+
+TEST_CASE("CompressedStream_invalid")
+{
+    std::vector<uint8_t> garbage(100, 0x55);
+    auto memory_stream = make_ref<MemoryStream>(garbage.data(), garbage.size());
+    CHECK_FALSE(CompressedStream::detect_compressed_stream(memory_stream));
+    CHECK_THROWS(make_ref<CompressedStream>(memory_stream, CompressedStream::Mode::read));
+}
+
+TEST_SUITE_END();
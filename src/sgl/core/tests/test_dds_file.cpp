@@ -409,6 +409,28 @@ TEST_CASE("formats")
     }
 }
 
+TEST_CASE("probe")
+{
+    std::filesystem::path images_dir = platform::project_directory() / "data" / "test_images" / "dds";
+
+    for (const TestItem& item : TEST_ITEMS) {
+        DDSFile::Info info = DDSFile::probe(images_dir / item.path);
+        CHECK_EQ(info.dxgi_format, item.dxgi_format);
+        CHECK_EQ(info.type, item.type);
+        CHECK_EQ(info.width, item.width);
+        CHECK_EQ(info.height, item.height);
+        CHECK_EQ(info.depth, item.depth);
+        CHECK_EQ(info.mip_count, item.mip_count);
+        CHECK_EQ(info.array_size, item.array_size);
+        CHECK_EQ(info.compressed, item.compressed);
+        CHECK_EQ(info.srgb, item.srgb);
+    }
+
+    const uint32_t VALID_MAGIC = 0x20534444;
+    MemoryStream truncated_stream(&VALID_MAGIC, sizeof(VALID_MAGIC));
+    CHECK_THROWS(DDSFile::probe(&truncated_stream));
+}
+
 TEST_CASE("detect_dds_file")
 {
     const uint32_t VALID_MAGIC = 0x20534444;
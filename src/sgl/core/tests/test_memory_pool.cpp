@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "testing.h"
+#include "sgl/core/memory_pool.h"
+#include "sgl/core/platform.h"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace sgl;
+
+TEST_SUITE_BEGIN("memory_pool");
+
+TEST_CASE("size_class")
+{
+    CHECK_EQ(MemoryPool::size_class(1), 8);
+    CHECK_EQ(MemoryPool::size_class(8), 8);
+    CHECK_EQ(MemoryPool::size_class(9), 9);
+    CHECK_EQ(MemoryPool::size_class(1024), 1024);
+    CHECK_EQ(MemoryPool::size_class(1025), 1152);
+    CHECK_EQ(MemoryPool::size_class(1152), 1152);
+    CHECK_EQ(MemoryPool::size_class(1153), 1280);
+    // Overhead is bounded by 12.5%.
+    for (size_t size = 16; size < (size_t(1) << 30); size = size * 3 + 1)
+        CHECK_LE(MemoryPool::size_class(size), size + size / 8);
+}
+
+TEST_CASE("alignment")
+{
+    ref<MemoryPool> pool = make_ref<MemoryPool>(MemoryPoolDesc{.alignment = 64});
+    for (size_t size : {1, 63, 64, 1000, 4096, 100000, 10000000}) {
+        void* ptr = pool->allocate(size);
+        CHECK(ptr != nullptr);
+        CHECK_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0);
+        if (size >= platform::page_size())
+            CHECK_EQ(reinterpret_cast<uintptr_t>(ptr) % platform::page_size(), 0);
+        std::memset(ptr, 0xff, size);
+        pool->release(ptr, size);
+    }
+    CHECK_EQ(pool->stats().allocated_size, 0);
+    CHECK_EQ(pool->stats().allocation_count, 7);
+}
+
+TEST_CASE("pooling")
+{
+    ref<MemoryPool> pool = make_ref<MemoryPool>(MemoryPoolDesc{.enable_pooling = true});
+
+    void* ptr1 = pool->allocate(1000000);
+    pool->release(ptr1, 1000000);
+    CHECK_EQ(pool->stats().pooled_size, MemoryPool::size_class(1000000));
+
+    // Same size class is served from the pool.
+    void* ptr2 = pool->allocate(1000001);
+    CHECK_EQ(ptr1, ptr2);
+    CHECK_EQ(pool->stats().pool_hit_count, 1);
+    CHECK_EQ(pool->stats().pooled_size, 0);
+    pool->release(ptr2, 1000001);
+
+    pool->trim();
+    CHECK_EQ(pool->stats().pooled_size, 0);
+    CHECK_EQ(pool->stats().allocated_size, 0);
+}
+
+TEST_CASE("max_pooled_size")
+{
+    ref<MemoryPool> pool = make_ref<MemoryPool>(MemoryPoolDesc{.enable_pooling = true, .max_pooled_size = 1024});
+
+    void* ptr = pool->allocate(4096);
+    pool->release(ptr, 4096);
+    CHECK_EQ(pool->stats().pooled_size, 0);
+    CHECK_EQ(pool->stats().allocated_size, 0);
+}
+
+TEST_CASE("huge_pages")
+{
+    const size_t size = 8 * 1024 * 1024;
+    ref<MemoryPool> pool = make_ref<MemoryPool>(MemoryPoolDesc{.huge_page_threshold = 4 * 1024 * 1024});
+    void* ptr = pool->allocate(size);
+    CHECK_EQ(reinterpret_cast<uintptr_t>(ptr) % (2 * 1024 * 1024), 0);
+    std::memset(ptr, 0, size);
+    pool->release(ptr, size);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "testing.h"
+#include "sgl/core/metrics.h"
+
+#include <thread>
+#include <vector>
+
+using namespace sgl;
+
+TEST_SUITE_BEGIN("metrics");
+
+TEST_CASE("counter")
+{
+    Counter& counter = MetricsRegistry::get().counter("test_counter", "Test counter.");
+    counter.reset();
+    CHECK_EQ(counter.value(), 0);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i)
+        threads.emplace_back(
+            [&counter]()
+            {
+                for (int j = 0; j < 1000; ++j)
+                    counter.add();
+            }
+        );
+    for (auto& thread : threads)
+        thread.join();
+    CHECK_EQ(counter.value(), 8000);
+
+    // Registering again returns the same counter.
+    CHECK_EQ(&MetricsRegistry::get().counter("test_counter"), &counter);
+    // Registering with a different type fails.
+    CHECK_THROWS(MetricsRegistry::get().gauge("test_counter"));
+}
+
+TEST_CASE("gauge")
+{
+    Gauge& gauge = MetricsRegistry::get().gauge("test_gauge", "Test gauge.");
+    gauge.set(10.0);
+    gauge.add(5.0);
+    gauge.sub(2.5);
+    CHECK_EQ(gauge.value(), 12.5);
+
+    Gauge& function_gauge = MetricsRegistry::get().gauge("test_function_gauge");
+    function_gauge.set_function([]() { return 42.0; });
+    CHECK_EQ(function_gauge.value(), 42.0);
+}
+
+TEST_CASE("histogram")
+{
+    CHECK_EQ(Histogram::exponential_bounds(1.0, 2.0, 4), std::vector<double>{1.0, 2.0, 4.0, 8.0});
+
+    Histogram& histogram = MetricsRegistry::get().histogram("test_histogram", "Test histogram.", {1.0, 10.0});
+    histogram.reset();
+    histogram.observe(0.5);
+    histogram.observe(1.0);
+    histogram.observe(5.0);
+    histogram.observe(100.0);
+    CHECK_EQ(histogram.bucket_counts(), std::vector<uint64_t>{2, 1, 1});
+    CHECK_EQ(histogram.count(), 4);
+    CHECK_EQ(histogram.sum(), 106.5);
+}
+
+TEST_CASE("export")
+{
+    MetricsRegistry::get().counter("test_export_counter", "Counter \"help\".").add(3);
+    Histogram& histogram = MetricsRegistry::get().histogram("test_export_histogram", "", {1.0});
+    histogram.reset();
+    histogram.observe(2.0);
+
+    std::string prometheus = MetricsRegistry::get().to_prometheus();
+    CHECK(prometheus.find("# TYPE test_export_counter counter\ntest_export_counter 3\n") != std::string::npos);
+    CHECK(prometheus.find("test_export_histogram_bucket{le=\"1\"} 0\n") != std::string::npos);
+    CHECK(prometheus.find("test_export_histogram_bucket{le=\"+Inf\"} 1\n") != std::string::npos);
+    CHECK(prometheus.find("test_export_histogram_sum 2\n") != std::string::npos);
+    CHECK(prometheus.find("test_export_histogram_count 1\n") != std::string::npos);
+
+    std::string json = MetricsRegistry::get().to_json();
+    CHECK(
+        json.find(
+            "{\"name\":\"test_export_counter\",\"type\":\"counter\",\"help\":\"Counter \\\"help\\\".\",\"value\":3}"
+        )
+        != std::string::npos
+    );
+    CHECK(json.find("\"buckets\":[{\"le\":1,\"count\":0},{\"le\":null,\"count\":1}]") != std::string::npos);
+}
+
+TEST_SUITE_END();
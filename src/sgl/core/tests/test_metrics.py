@@ -0,0 +1,43 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import json
+import pytest
+from sgl import MetricsRegistry, MetricType, Histogram
+
+
+def test_counter():
+    counter = MetricsRegistry.get().counter("test_py_counter", "Python counter.")
+    counter.reset()
+    counter.add()
+    counter.add(4)
+    assert counter.value == 5
+    assert counter.type == MetricType.counter
+
+
+def test_histogram():
+    histogram = MetricsRegistry.get().histogram(
+        "test_py_histogram", "", Histogram.exponential_bounds(1.0, 10.0, 3)
+    )
+    histogram.reset()
+    for value in [0.5, 5.0, 50.0, 500.0]:
+        histogram.observe(value)
+    assert histogram.bounds == [1.0, 10.0, 100.0]
+    assert histogram.bucket_counts == [1, 1, 1, 1]
+    assert histogram.count == 4
+    assert histogram.sum == 555.5
+
+
+def test_export():
+    MetricsRegistry.get().gauge("test_py_gauge").set(2.5)
+    samples = {s.name: s for s in MetricsRegistry.get().snapshot()}
+    assert samples["test_py_gauge"].type == MetricType.gauge
+    assert samples["test_py_gauge"].value == 2.5
+
+    assert "test_py_gauge 2.5\n" in MetricsRegistry.get().to_prometheus()
+
+    metrics = json.loads(MetricsRegistry.get().to_json())["metrics"]
+    assert {"name": "test_py_gauge", "type": "gauge", "help": "", "value": 2.5} in metrics
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v"])
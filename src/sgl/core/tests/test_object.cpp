@@ -63,6 +63,28 @@ TEST_CASE("ref")
     CHECK_EQ(DummyObject::get_count(), 0);
 }
 
+TEST_CASE("try_inc_ref")
+{
+    REQUIRE_EQ(DummyObject::get_count(), 0);
+
+    {
+        // Objects without references must not be resurrected.
+        DummyObject obj;
+        CHECK_EQ(obj.ref_count(), 0);
+        CHECK_FALSE(obj.try_inc_ref());
+        CHECK_EQ(obj.ref_count(), 0);
+    }
+
+    ref<DummyObject> r1 = make_ref<DummyObject>();
+    CHECK(r1->try_inc_ref());
+    CHECK_EQ(r1->ref_count(), 2);
+    r1->dec_ref();
+    CHECK_EQ(r1->ref_count(), 1);
+
+    r1 = nullptr;
+    CHECK_EQ(DummyObject::get_count(), 0);
+}
+
 class DummyBuffer;
 
 class DummyDevice : public Object {
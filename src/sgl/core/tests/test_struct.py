@@ -329,5 +329,79 @@ def test_blend_gamma():
     check_conversion(s, "@BB", "@B", (100, 200), (ref,))
 
 
+pixel_types: list[TSupportedType] = [
+    ("B", Struct.Type.uint8, np.uint8),
+    ("H", Struct.Type.uint16, np.uint16),
+    ("e", Struct.Type.float16, np.float16),
+    ("f", Struct.Type.float32, np.float32),
+]
+
+
+def create_pixel_struct(param: TSupportedType, channels: str, srgb: bool):
+    is_int = np.issubdtype(param[2], np.integer)
+    s = Struct()
+    for channel in channels:
+        flags = Struct.Flags.none
+        if is_int:
+            flags |= Struct.Flags.normalized
+        if srgb and channel != "A":
+            flags |= Struct.Flags.srgb_gamma
+        if channel == "A":
+            flags |= Struct.Flags.default
+        default_value = float(np.iinfo(param[2]).max) if is_int else 1.0
+        s.append(channel, param[1], flags, default_value=default_value)
+    return s
+
+
+# Conversions between common pixel formats run on ahead-of-time compiled kernels.
+@pytest.mark.parametrize(
+    "src_param,dst_param", itertools.product(pixel_types, pixel_types)
+)
+@pytest.mark.parametrize(
+    "src_channels,dst_channels", [("RGB", "RGBA"), ("RGBA", "RGB"), ("RGBA", "RGBA")]
+)
+@pytest.mark.parametrize(
+    "src_srgb,dst_srgb", itertools.product([False, True], [False, True])
+)
+def test_convert_pixel_formats(
+    src_param: TSupportedType,
+    dst_param: TSupportedType,
+    src_channels: str,
+    dst_channels: str,
+    src_srgb: bool,
+    dst_srgb: bool,
+):
+    src_struct = create_pixel_struct(src_param, src_channels, src_srgb)
+    dst_struct = create_pixel_struct(dst_param, dst_channels, dst_srgb)
+    converter = StructConverter(src_struct, dst_struct)
+
+    count = 256
+    src_is_int = np.issubdtype(src_param[2], np.integer)
+    dst_is_int = np.issubdtype(dst_param[2], np.integer)
+    src_max = np.iinfo(src_param[2]).max if src_is_int else 1.0
+    dst_max = np.iinfo(dst_param[2]).max if dst_is_int else 1.0
+
+    values = np.linspace(0, 1, count * len(src_channels)).reshape(count, -1)
+    src = (values * src_max).astype(src_param[2])
+    dst_data = converter.convert(src.tobytes())
+    dst = np.frombuffer(dst_data, dtype=dst_param[2]).reshape(count, -1)
+
+    ref = src.astype(np.float64) / src_max
+    if src_srgb:
+        ref[:, :3] = np.vectorize(from_srgb)(ref[:, :3])
+    if dst_srgb:
+        ref[:, :3] = np.vectorize(to_srgb)(ref[:, :3])
+    if len(dst_channels) > len(src_channels):
+        ref = np.hstack([ref, np.ones((count, 1))])
+    ref = ref[:, : len(dst_channels)]
+
+    if dst_is_int:
+        err = np.abs(dst.astype(np.float64) - np.round(ref * dst_max))
+        assert np.max(err) <= 1
+    else:
+        atol = 1e-3 if dst_param[1] == Struct.Type.float16 else 1e-5
+        assert np.allclose(dst.astype(np.float64), ref, rtol=atol, atol=atol)
+
+
 if __name__ == "__main__":
     pytest.main([__file__, "-v"])
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "testing.h"
+#include "sgl/core/thread.h"
+#include "sgl/core/platform.h"
+#include "sgl/core/metrics.h"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace sgl;
+
+TEST_SUITE_BEGIN("thread");
+
+TEST_CASE("numa")
+{
+    CHECK_GE(platform::processor_count(), 1);
+    CHECK_GE(platform::numa_node_count(), 1);
+    std::vector<uint32_t> processors = platform::numa_node_processors(0);
+    CHECK_FALSE(processors.empty());
+    for (uint32_t processor : processors)
+        CHECK_LT(processor, 4096);
+}
+
+TEST_CASE("configure_global_thread_pool")
+{
+    thread::ThreadPoolDesc default_desc = thread::global_thread_pool_desc();
+
+    thread::configure_global_thread_pool({
+        .thread_count = 3,
+        .name = "test-worker",
+        .priority = platform::ThreadPriority::low,
+        .numa_node = 0,
+    });
+    CHECK_EQ(thread::global_thread_pool().get_thread_count(), 3);
+    CHECK_EQ(thread::global_thread_pool_desc().name, "test-worker");
+
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+    std::atomic<uint32_t> count{0};
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 100; ++i) {
+        futures.push_back(thread::do_async(
+            [&]()
+            {
+                count++;
+                std::lock_guard lock(mutex);
+                thread_ids.insert(std::this_thread::get_id());
+            }
+        ));
+    }
+    for (auto& future : futures)
+        future.wait();
+    CHECK_EQ(count, 100);
+    CHECK_LE(thread_ids.size(), 3);
+
+    // Queue depth gauges can be read while the pools are replaced.
+    thread::ThreadPoolDesc default_io_desc = thread::io_thread_pool_desc();
+    std::atomic<bool> done{false};
+    std::thread reader(
+        [&]()
+        {
+            Gauge& gauge = MetricsRegistry::get().gauge("sgl_thread_pool_queue_depth");
+            Gauge& io_gauge = MetricsRegistry::get().gauge("sgl_io_thread_pool_queue_depth");
+            while (!done)
+                CHECK_GE(gauge.value() + io_gauge.value(), 0.0);
+        }
+    );
+    for (uint32_t i = 0; i < 10; ++i) {
+        thread::configure_global_thread_pool({.thread_count = 1 + i % 3});
+        thread::configure_io_thread_pool({.thread_count = 1 + i % 2});
+    }
+    done = true;
+    reader.join();
+    thread::configure_io_thread_pool(default_io_desc);
+
+    thread::configure_global_thread_pool(default_desc);
+}
+
+TEST_CASE("parallel_for")
+{
+    CHECK_FALSE(thread::in_global_thread_pool());
+    CHECK(thread::do_async([]() { return thread::in_global_thread_pool(); }).get());
+    CHECK_FALSE(thread::do_async_io([]() { return thread::in_global_thread_pool(); }).get());
+
+    std::vector<std::atomic<uint32_t>> counts(1000);
+    auto count_range = [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+            counts[i]++;
+    };
+    thread::parallel_for(size_t(0), counts.size(), count_range);
+    thread::parallel_for(size_t(10), size_t(10), count_range);
+    for (const auto& count : counts)
+        CHECK_EQ(count.load(), 1);
+
+    CHECK_THROWS(thread::parallel_for(0, 100, [](int, int) { throw std::runtime_error("error"); }));
+
+    // Nested loops run inline on pool workers, so they complete even with a single worker.
+    thread::ThreadPoolDesc default_desc = thread::global_thread_pool_desc();
+    thread::configure_global_thread_pool({.thread_count = 1});
+    thread::do_async([&]() { thread::parallel_for(size_t(0), counts.size(), count_range, 8); }).get();
+    for (const auto& count : counts)
+        CHECK_EQ(count.load(), 2);
+    thread::configure_global_thread_pool(default_desc);
+}
+
+TEST_CASE("io_thread_pool")
+{
+    CHECK_EQ(thread::io_thread_pool_desc().priority, platform::ThreadPriority::low);
+
+    std::atomic<uint32_t> count{0};
+    for (int i = 0; i < 10; ++i)
+        thread::do_async_io([&]() { count++; });
+    thread::wait_for_tasks();
+    CHECK_EQ(count, 10);
+}
+
+TEST_SUITE_END();
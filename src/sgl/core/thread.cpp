@@ -2,26 +2,138 @@
 
 #include "thread.h"
 
+#include "sgl/core/async_io.h"
 #include "sgl/core/error.h"
+#include "sgl/core/format.h"
+#include "sgl/core/metrics.h"
+
+#include <algorithm>
+#include <latch>
+#include <mutex>
 
 namespace sgl::thread {
 
+/// Maximum number of threads in the default I/O thread pool.
+static constexpr uint32_t DEFAULT_IO_THREAD_COUNT = 4;
+
+/// Guards replacing the pools against the queue depth gauges reading them from other threads.
+static std::mutex s_pool_mutex;
 static std::unique_ptr<BS::thread_pool> s_global_thread_pool;
+static std::unique_ptr<BS::thread_pool> s_io_thread_pool;
+static ThreadPoolDesc s_global_thread_pool_desc;
+static ThreadPoolDesc s_io_thread_pool_desc;
+
+static Gauge& s_queue_depth_gauge = MetricsRegistry::get().gauge(
+    "sgl_thread_pool_queue_depth",
+    "Number of tasks queued or running in the global thread pool."
+);
+static Gauge& s_io_queue_depth_gauge = MetricsRegistry::get().gauge(
+    "sgl_io_thread_pool_queue_depth",
+    "Number of tasks queued or running in the I/O thread pool."
+);
+
+/// Pool owning the current thread (null if the thread is not a pool worker).
+static thread_local const BS::thread_pool* t_worker_pool = nullptr;
+
+static std::unique_ptr<BS::thread_pool> create_thread_pool(const ThreadPoolDesc& desc)
+{
+    std::vector<uint32_t> processors = desc.processors;
+    if (processors.empty() && desc.numa_node) {
+        SGL_CHECK(
+            *desc.numa_node < platform::numa_node_count(),
+            "Invalid NUMA node {} (system has {} nodes).",
+            *desc.numa_node,
+            platform::numa_node_count()
+        );
+        processors = platform::numa_node_processors(*desc.numa_node);
+    }
+
+    uint32_t thread_count = desc.thread_count;
+    if (thread_count == 0)
+        thread_count = processors.empty() ? platform::processor_count() : uint32_t(processors.size());
+    thread_count = std::max(thread_count, 1u);
+
+    auto pool = std::make_unique<BS::thread_pool>(thread_count);
+
+    // Run one setup task on each worker thread. Each task blocks until all workers
+    // have picked up a task, which guarantees that every worker runs exactly one.
+    std::latch latch(thread_count);
+    for (uint32_t i = 0; i < thread_count; ++i) {
+        pool->push_task(
+            [&desc, &processors, &latch, i, pool = pool.get()]()
+            {
+                t_worker_pool = pool;
+                if (!desc.name.empty())
+                    platform::set_thread_name(fmt::format("{}-{}", desc.name, i));
+                if (!processors.empty())
+                    platform::set_thread_affinity(processors);
+                if (desc.priority != platform::ThreadPriority::normal)
+                    platform::set_thread_priority(desc.priority);
+                latch.arrive_and_wait();
+            }
+        );
+    }
+    pool->wait_for_tasks();
+
+    return pool;
+}
+
+static double queue_depth(const std::unique_ptr<BS::thread_pool>& pool)
+{
+    std::lock_guard lock(s_pool_mutex);
+    return pool ? double(pool->get_tasks_total()) : 0.0;
+}
+
+/// Replace a pool. The old pool is destroyed (joining its threads) outside of the lock.
+static void replace_thread_pool(std::unique_ptr<BS::thread_pool>& pool, std::unique_ptr<BS::thread_pool> new_pool)
+{
+    {
+        std::lock_guard lock(s_pool_mutex);
+        std::swap(pool, new_pool);
+    }
+    new_pool.reset();
+}
 
 void static_init()
 {
-    s_global_thread_pool = std::make_unique<BS::thread_pool>();
+    s_global_thread_pool_desc = {.name = "sgl-worker"};
+    s_global_thread_pool = create_thread_pool(s_global_thread_pool_desc);
+
+    s_io_thread_pool_desc = {
+        .thread_count = std::min(DEFAULT_IO_THREAD_COUNT, platform::processor_count()),
+        .name = "sgl-io",
+        .priority = platform::ThreadPriority::low,
+    };
+    s_io_thread_pool = create_thread_pool(s_io_thread_pool_desc);
+
+    s_queue_depth_gauge.set_function([]() { return queue_depth(s_global_thread_pool); });
+    s_io_queue_depth_gauge.set_function([]() { return queue_depth(s_io_thread_pool); });
 }
 
 void static_shutdown()
 {
+    s_queue_depth_gauge.set_function({});
+    s_io_queue_depth_gauge.set_function({});
+    s_io_thread_pool->wait_for_tasks();
+    replace_thread_pool(s_io_thread_pool, nullptr);
     s_global_thread_pool->wait_for_tasks();
-    s_global_thread_pool.reset();
+    replace_thread_pool(s_global_thread_pool, nullptr);
 }
 
 void wait_for_tasks()
 {
-    global_thread_pool().wait_for_tasks();
+    // I/O tasks and async file I/O may schedule compute tasks and vice versa, wait until all are idle.
+    while (global_thread_pool().get_tasks_total() > 0 || io_thread_pool().get_tasks_total() > 0
+           || async_io::pending_count() > 0) {
+        async_io::wait_for_idle();
+        global_thread_pool().wait_for_tasks();
+        io_thread_pool().wait_for_tasks();
+    }
+}
+
+bool in_global_thread_pool()
+{
+    return t_worker_pool && t_worker_pool == s_global_thread_pool.get();
 }
 
 BS::thread_pool& global_thread_pool()
@@ -30,4 +142,34 @@ BS::thread_pool& global_thread_pool()
     return *s_global_thread_pool;
 }
 
+BS::thread_pool& io_thread_pool()
+{
+    SGL_CHECK(s_io_thread_pool, "I/O thread pool not initialized!");
+    return *s_io_thread_pool;
+}
+
+void configure_global_thread_pool(ThreadPoolDesc desc)
+{
+    global_thread_pool().wait_for_tasks();
+    replace_thread_pool(s_global_thread_pool, create_thread_pool(desc));
+    s_global_thread_pool_desc = std::move(desc);
+}
+
+void configure_io_thread_pool(ThreadPoolDesc desc)
+{
+    io_thread_pool().wait_for_tasks();
+    replace_thread_pool(s_io_thread_pool, create_thread_pool(desc));
+    s_io_thread_pool_desc = std::move(desc);
+}
+
+const ThreadPoolDesc& global_thread_pool_desc()
+{
+    return s_global_thread_pool_desc;
+}
+
+const ThreadPoolDesc& io_thread_pool_desc()
+{
+    return s_io_thread_pool_desc;
+}
+
 } // namespace sgl::thread
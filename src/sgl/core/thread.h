@@ -3,26 +3,92 @@
 #pragma once
 
 #include "sgl/core/macros.h"
+#include "sgl/core/platform.h"
 
 #include <BS_thread_pool.hpp>
 
 #include <type_traits>
 #include <future>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace sgl::thread {
 
+struct ThreadPoolDesc {
+    /// Number of worker threads.
+    /// If zero, one thread per logical processor (of the selected NUMA node) is used.
+    uint32_t thread_count{0};
+    /// Name prefix of the worker threads (threads are named "<name>-<index>").
+    std::string name;
+    /// Priority of the worker threads.
+    platform::ThreadPriority priority{platform::ThreadPriority::normal};
+    /// Logical processors the worker threads are restricted to (no restriction if empty).
+    std::vector<uint32_t> processors;
+    /// NUMA node the worker threads are restricted to. Ignored if \c processors is not empty.
+    std::optional<uint32_t> numa_node;
+};
+
 SGL_API void static_init();
 SGL_API void static_shutdown();
 
-/// Block until all scheduled tasks are completed.
+/// Block until all scheduled tasks (on the global and I/O thread pools) are completed.
 SGL_API void wait_for_tasks();
 
+/// Global thread pool used for compute tasks.
 SGL_API BS::thread_pool& global_thread_pool();
 
+/// True if the calling thread is a worker of the global thread pool.
+SGL_API bool in_global_thread_pool();
+
+/// Thread pool used for background I/O tasks.
+/// By default, this pool runs a small number of low priority threads.
+SGL_API BS::thread_pool& io_thread_pool();
+
+/// Recreate the global thread pool with the given configuration.
+/// Waits for all pending tasks on the current pool. Must not be called while other threads submit tasks.
+SGL_API void configure_global_thread_pool(ThreadPoolDesc desc);
+
+/// Recreate the I/O thread pool with the given configuration.
+/// Waits for all pending tasks on the current pool. Must not be called while other threads submit tasks.
+SGL_API void configure_io_thread_pool(ThreadPoolDesc desc);
+
+/// Configuration of the global thread pool.
+SGL_API const ThreadPoolDesc& global_thread_pool_desc();
+
+/// Configuration of the I/O thread pool.
+SGL_API const ThreadPoolDesc& io_thread_pool_desc();
+
+/**
+ * \brief Run \c func(block_begin, block_end) over blocks of the range [begin, end) on the global
+ * thread pool and wait for all blocks to complete. Exceptions thrown by \c func are rethrown.
+ *
+ * When called from a worker of the global thread pool, \c func(begin, end) runs inline on the
+ * calling thread. Waiting on the pool from one of its tasks deadlocks once all workers wait.
+ *
+ * \param block_count Number of blocks (0 to use one block per pool thread).
+ */
+template<typename T, typename F>
+void parallel_for(T begin, T end, F&& func, size_t block_count = 0)
+{
+    if (end <= begin)
+        return;
+    if (end - begin == 1 || in_global_thread_pool())
+        func(begin, end);
+    else
+        global_thread_pool().parallelize_loop(begin, end, func, block_count).get();
+}
+
 template<typename F, typename... A, typename R = std::invoke_result_t<std::decay_t<F>, std::decay_t<A>...>>
 std::future<R> do_async(F&& task, A&&... args)
 {
     return global_thread_pool().submit(std::forward<F>(task), std::forward<A>(args)...);
 }
 
+template<typename F, typename... A, typename R = std::invoke_result_t<std::decay_t<F>, std::decay_t<A>...>>
+std::future<R> do_async_io(F&& task, A&&... args)
+{
+    return io_thread_pool().submit(std::forward<F>(task), std::forward<A>(args)...);
+}
+
 } // namespace sgl::thread
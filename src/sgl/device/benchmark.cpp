@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "benchmark.h"
+
+#include "sgl/core/error.h"
+#include "sgl/core/format.h"
+#include "sgl/core/string.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace sgl {
+
+double percentile_sorted(std::span<const double> sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0;
+    double position = std::clamp(p, 0.0, 100.0) / 100.0 * double(sorted.size() - 1);
+    size_t index = size_t(position);
+    if (index + 1 >= sorted.size())
+        return sorted.back();
+    double t = position - double(index);
+    return sorted[index] + t * (sorted[index + 1] - sorted[index]);
+}
+
+BenchmarkResult
+BenchmarkResult::from_samples(std::vector<double> samples, uint32_t dispatches_per_sample, const BenchmarkDesc& desc)
+{
+    SGL_CHECK(!samples.empty(), "Benchmark has no samples.");
+
+    BenchmarkResult result;
+    result.name = desc.name;
+    result.samples = std::move(samples);
+    result.dispatches_per_sample = dispatches_per_sample;
+
+    std::vector<double> sorted = result.samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    double n = double(sorted.size());
+    result.min = sorted.front();
+    result.max = sorted.back();
+    result.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / n;
+    double variance = 0.0;
+    for (double sample : sorted)
+        variance += (sample - result.mean) * (sample - result.mean);
+    result.stddev = sorted.size() > 1 ? std::sqrt(variance / (n - 1.0)) : 0.0;
+    result.median = percentile_sorted(sorted, 50.0);
+    result.p10 = percentile_sorted(sorted, 10.0);
+    result.p90 = percentile_sorted(sorted, 90.0);
+
+    // The interquartile range is insensitive to the occasional outlier (e.g. preemption)
+    // but catches bimodal or drifting timings (e.g. clock changes during the measurement).
+    double iqr = percentile_sorted(sorted, 75.0) - percentile_sorted(sorted, 25.0);
+    result.relative_spread = result.median > 0.0 ? iqr / result.median : 0.0;
+    result.noisy = result.relative_spread > desc.noise_threshold;
+
+    if (result.median > 0.0) {
+        result.bandwidth = double(desc.bytes) / result.median;
+        result.flops_per_second = double(desc.flops) / result.median;
+    }
+
+    return result;
+}
+
+double BenchmarkResult::percentile(double p) const
+{
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    return percentile_sorted(sorted, p);
+}
+
+std::string BenchmarkResult::to_string() const
+{
+    std::string result = fmt::format(
+        "BenchmarkResult(\n"
+        "  name = \"{}\",\n"
+        "  samples = {},\n"
+        "  dispatches_per_sample = {},\n"
+        "  median = {},\n"
+        "  mean = {},\n"
+        "  min = {},\n"
+        "  max = {},\n"
+        "  p10 = {},\n"
+        "  p90 = {},\n"
+        "  relative_spread = {:.2f}%,\n"
+        "  noisy = {}",
+        name,
+        samples.size(),
+        dispatches_per_sample,
+        string::format_duration(median),
+        string::format_duration(mean),
+        string::format_duration(min),
+        string::format_duration(max),
+        string::format_duration(p10),
+        string::format_duration(p90),
+        relative_spread * 100.0,
+        noisy
+    );
+    if (bandwidth > 0.0)
+        result += fmt::format(",\n  bandwidth = {}/s", string::format_byte_size(size_t(bandwidth)));
+    if (flops_per_second > 0.0)
+        result += fmt::format(",\n  flops_per_second = {:.4g} GFLOP/s", flops_per_second * 1e-9);
+    result += "\n)";
+    return result;
+}
+
+std::string BenchmarkResult::to_json() const
+{
+    std::string escaped_name;
+    for (char c : name) {
+        if (c == '"' || c == '\\')
+            escaped_name += '\\';
+        if (static_cast<unsigned char>(c) < 0x20)
+            escaped_name += fmt::format("\\u{:04x}", int(c));
+        else
+            escaped_name += c;
+    }
+
+    std::string result = fmt::format(
+        "{{\"name\":\"{}\",\"dispatches_per_sample\":{},\"median\":{},\"mean\":{},\"min\":{},\"max\":{},"
+        "\"stddev\":{},\"p10\":{},\"p90\":{},\"relative_spread\":{},\"noisy\":{},\"bandwidth\":{},"
+        "\"flops_per_second\":{},\"samples\":[",
+        escaped_name,
+        dispatches_per_sample,
+        median,
+        mean,
+        min,
+        max,
+        stddev,
+        p10,
+        p90,
+        relative_spread,
+        noisy,
+        bandwidth,
+        flops_per_second
+    );
+    for (size_t i = 0; i < samples.size(); ++i) {
+        if (i > 0)
+            result += ",";
+        result += fmt::format("{}", samples[i]);
+    }
+    result += "]}";
+    return result;
+}
+
+} // namespace sgl
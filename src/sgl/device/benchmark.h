@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sgl/device/fwd.h"
+
+#include "sgl/core/macros.h"
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace sgl {
+
+struct BenchmarkDesc {
+    /// Name of the benchmark (included in reports).
+    std::string name;
+    /// Number of untimed iterations run first, to let clocks ramp up and caches warm.
+    uint32_t warmup_iterations{10};
+    /// Number of timed samples per measurement round.
+    uint32_t iterations{50};
+    /// Maximum number of timed samples. While a measurement is noisy, additional rounds
+    /// are run until this limit is reached.
+    uint32_t max_iterations{200};
+    /// Minimum GPU time per sample in seconds. Kernels shorter than this are dispatched
+    /// multiple times between timestamps so that timestamp resolution and per-sample
+    /// overhead do not dominate the measurement.
+    double min_sample_time{20e-6};
+    /// Bytes read and written per dispatch (used to report bandwidth).
+    uint64_t bytes{0};
+    /// Floating point operations per dispatch (used to report FLOP/s).
+    uint64_t flops{0};
+    /// Measurements with an interquartile range above this fraction of the median are
+    /// reported as noisy.
+    double noise_threshold{0.05};
+};
+
+struct SGL_API BenchmarkResult {
+    /// Name of the benchmark.
+    std::string name;
+    /// GPU time per dispatch of each sample in seconds, in measurement order.
+    std::vector<double> samples;
+    /// Number of dispatches timed by each sample.
+    uint32_t dispatches_per_sample{1};
+
+    double min{0.0};
+    double max{0.0};
+    double mean{0.0};
+    double median{0.0};
+    double stddev{0.0};
+    /// 10th percentile.
+    double p10{0.0};
+    /// 90th percentile.
+    double p90{0.0};
+    /// Interquartile range relative to the median.
+    double relative_spread{0.0};
+    /// True if the relative spread exceeds \c BenchmarkDesc::noise_threshold.
+    bool noisy{false};
+
+    /// Bandwidth in bytes per second at the median time (0 if no byte count was given).
+    double bandwidth{0.0};
+    /// Floating point operations per second at the median time (0 if no FLOP count was given).
+    double flops_per_second{0.0};
+
+    /**
+     * \brief Compute statistics from a set of samples.
+     *
+     * \param samples GPU time per dispatch of each sample in seconds.
+     * \param dispatches_per_sample Number of dispatches timed by each sample.
+     * \param desc Benchmark description.
+     */
+    static BenchmarkResult
+    from_samples(std::vector<double> samples, uint32_t dispatches_per_sample, const BenchmarkDesc& desc);
+
+    /// Percentile \c p in [0, 100] of the samples (linearly interpolated).
+    double percentile(double p) const;
+
+    std::string to_string() const;
+
+    /// Serialize the result, including all samples, to JSON.
+    std::string to_json() const;
+};
+
+/// Compute percentile \c p in [0, 100] of a sorted range (linearly interpolated).
+SGL_API double percentile_sorted(std::span<const double> sorted, double p);
+
+} // namespace sgl
@@ -21,6 +21,13 @@ BufferElementCursor::BufferElementCursor(ref<TypeLayoutReflection> layout, ref<B
 {
 }
 
+BufferElementCursor::BufferElementCursor(ref<const TypeLayoutSnapshot> layout, ref<BufferCursor> owner)
+    : m_snapshot_type_layout(std::move(layout))
+    , m_buffer(std::move(owner))
+    , m_offset(0)
+{
+}
+
 std::string BufferElementCursor::to_string() const
 {
     return "BufferElementCursor()";
@@ -47,6 +54,17 @@ BufferElementCursor BufferElementCursor::find_field(std::string_view name) const
     if (!is_valid())
         return *this;
 
+    if (m_snapshot_type_layout) {
+        const TypeLayoutSnapshot::Field* field = m_snapshot_type_layout->find_field_by_name(name);
+        if (!field)
+            return {};
+        BufferElementCursor field_cursor;
+        field_cursor.m_buffer = m_buffer;
+        field_cursor.m_snapshot_type_layout = field->type_layout;
+        field_cursor.m_offset = m_offset + field->offset;
+        return field_cursor;
+    }
+
     switch (m_type_layout->kind()) {
     case TypeReflection::Kind::struct_: {
 
@@ -76,6 +94,22 @@ BufferElementCursor BufferElementCursor::find_element(uint32_t index) const
     if (!is_valid())
         return *this;
 
+    if (m_snapshot_type_layout) {
+        switch (m_snapshot_type_layout->kind()) {
+        case TypeReflection::Kind::array:
+        case TypeReflection::Kind::vector:
+        case TypeReflection::Kind::matrix: {
+            BufferElementCursor element_cursor;
+            element_cursor.m_buffer = m_buffer;
+            element_cursor.m_snapshot_type_layout = m_snapshot_type_layout->element_type_layout();
+            element_cursor.m_offset = m_offset + index * m_snapshot_type_layout->element_stride();
+            return element_cursor;
+        }
+        default:
+            return {};
+        }
+    }
+
     switch (m_type_layout->kind()) {
     case TypeReflection::Kind::array: {
         BufferElementCursor element_cursor;
@@ -103,7 +137,10 @@ BufferElementCursor BufferElementCursor::find_element(uint32_t index) const
 
 void BufferElementCursor::set_data(const void* data, size_t size)
 {
-    if (m_type_layout->parameter_category() != TypeReflection::ParameterCategory::uniform)
+    if (m_snapshot_type_layout) {
+        if (m_snapshot_type_layout->parameter_category() != TypeReflection::ParameterCategory::uniform)
+            SGL_THROW("\"{}\" cannot bind data", m_snapshot_type_layout->name());
+    } else if (m_type_layout->parameter_category() != TypeReflection::ParameterCategory::uniform)
         SGL_THROW("\"{}\" cannot bind data", m_type_layout->name());
     write_data(m_offset, data, size);
 }
@@ -115,12 +152,19 @@ void BufferElementCursor::_set_array(
     size_t element_count
 )
 {
-    ref<const TypeReflection> element_type = m_type_layout->unwrap_array()->type();
-    size_t element_size = cursor_utils::get_scalar_type_size(element_type->scalar_type());
-
-    cursor_utils::check_array(m_type_layout, size, scalar_type, element_count);
+    size_t element_size;
+    size_t stride;
+    if (m_snapshot_type_layout) {
+        element_size = cursor_utils::get_scalar_type_size(m_snapshot_type_layout->unwrap_array()->scalar_type());
+        cursor_utils::check_array(m_snapshot_type_layout, size, scalar_type, element_count);
+        stride = m_snapshot_type_layout->element_stride();
+    } else {
+        ref<const TypeReflection> element_type = m_type_layout->unwrap_array()->type();
+        element_size = cursor_utils::get_scalar_type_size(element_type->scalar_type());
+        cursor_utils::check_array(m_type_layout, size, scalar_type, element_count);
+        stride = m_type_layout->element_stride();
+    }
 
-    size_t stride = m_type_layout->element_stride();
     if (element_size == stride) {
         write_data(m_offset, data, size);
     } else {
@@ -139,12 +183,19 @@ void BufferElementCursor::_get_array(
     size_t element_count
 ) const
 {
-    ref<const TypeReflection> element_type = m_type_layout->unwrap_array()->type();
-    size_t element_size = cursor_utils::get_scalar_type_size(element_type->scalar_type());
-
-    cursor_utils::check_array(m_type_layout, size, scalar_type, element_count);
+    size_t element_size;
+    size_t stride;
+    if (m_snapshot_type_layout) {
+        element_size = cursor_utils::get_scalar_type_size(m_snapshot_type_layout->unwrap_array()->scalar_type());
+        cursor_utils::check_array(m_snapshot_type_layout, size, scalar_type, element_count);
+        stride = m_snapshot_type_layout->element_stride();
+    } else {
+        ref<const TypeReflection> element_type = m_type_layout->unwrap_array()->type();
+        element_size = cursor_utils::get_scalar_type_size(element_type->scalar_type());
+        cursor_utils::check_array(m_type_layout, size, scalar_type, element_count);
+        stride = m_type_layout->element_stride();
+    }
 
-    size_t stride = m_type_layout->element_stride();
     if (element_size == stride) {
         read_data(m_offset, data, size);
     } else {
@@ -157,13 +208,19 @@ void BufferElementCursor::_get_array(
 }
 void BufferElementCursor::_set_scalar(const void* data, size_t size, TypeReflection::ScalarType scalar_type)
 {
-    cursor_utils::check_scalar(m_type_layout, size, scalar_type);
+    if (m_snapshot_type_layout)
+        cursor_utils::check_scalar(m_snapshot_type_layout, size, scalar_type);
+    else
+        cursor_utils::check_scalar(m_type_layout, size, scalar_type);
     write_data(m_offset, data, size);
 }
 
 void BufferElementCursor::_get_scalar(void* data, size_t size, TypeReflection::ScalarType scalar_type) const
 {
-    cursor_utils::check_scalar(m_type_layout, size, scalar_type);
+    if (m_snapshot_type_layout)
+        cursor_utils::check_scalar(m_snapshot_type_layout, size, scalar_type);
+    else
+        cursor_utils::check_scalar(m_type_layout, size, scalar_type);
     read_data(m_offset, data, size);
 }
 
@@ -174,14 +231,20 @@ void BufferElementCursor::_set_vector(
     int dimension
 )
 {
-    cursor_utils::check_vector(m_type_layout, size, scalar_type, dimension);
+    if (m_snapshot_type_layout)
+        cursor_utils::check_vector(m_snapshot_type_layout, size, scalar_type, dimension);
+    else
+        cursor_utils::check_vector(m_type_layout, size, scalar_type, dimension);
     write_data(m_offset, data, size);
 }
 
 void BufferElementCursor::_get_vector(void* data, size_t size, TypeReflection::ScalarType scalar_type, int dimension)
     const
 {
-    cursor_utils::check_vector(m_type_layout, size, scalar_type, dimension);
+    if (m_snapshot_type_layout)
+        cursor_utils::check_vector(m_snapshot_type_layout, size, scalar_type, dimension);
+    else
+        cursor_utils::check_vector(m_type_layout, size, scalar_type, dimension);
     read_data(m_offset, data, size);
 }
 
@@ -193,7 +256,10 @@ void BufferElementCursor::_set_matrix(
     int cols
 )
 {
-    cursor_utils::check_matrix(m_type_layout, size, scalar_type, rows, cols);
+    if (m_snapshot_type_layout)
+        cursor_utils::check_matrix(m_snapshot_type_layout, size, scalar_type, rows, cols);
+    else
+        cursor_utils::check_matrix(m_type_layout, size, scalar_type, rows, cols);
     write_data(m_offset, data, size);
 }
 
@@ -205,7 +271,10 @@ void BufferElementCursor::_get_matrix(
     int cols
 ) const
 {
-    cursor_utils::check_matrix(m_type_layout, size, scalar_type, rows, cols);
+    if (m_snapshot_type_layout)
+        cursor_utils::check_matrix(m_snapshot_type_layout, size, scalar_type, rows, cols);
+    else
+        cursor_utils::check_matrix(m_type_layout, size, scalar_type, rows, cols);
     read_data(m_offset, data, size);
 }
 
@@ -410,6 +479,22 @@ BufferCursor::BufferCursor(ref<TypeLayoutReflection> element_layout, ref<Buffer>
     m_owner = true;
 }
 
+BufferCursor::BufferCursor(ref<const TypeLayoutSnapshot> element_layout, void* data, size_t size)
+    : m_element_snapshot_type_layout(std::move(element_layout))
+    , m_buffer((uint8_t*)data)
+    , m_size(size)
+    , m_owner(false)
+{
+}
+
+BufferCursor::BufferCursor(ref<const TypeLayoutSnapshot> element_layout, size_t element_count)
+    : m_element_snapshot_type_layout(std::move(element_layout))
+{
+    m_size = element_count * m_element_snapshot_type_layout->stride();
+    m_buffer = new uint8_t[m_size];
+    m_owner = true;
+}
+
 BufferCursor::~BufferCursor()
 {
     if (m_owner)
@@ -423,10 +508,21 @@ BufferElementCursor BufferCursor::find_element(uint32_t index)
     BufferElementCursor element_cursor;
     element_cursor.m_buffer = ref(this);
     element_cursor.m_type_layout = m_element_type_layout;
-    element_cursor.m_offset = index * m_element_type_layout->stride();
+    element_cursor.m_snapshot_type_layout = m_element_snapshot_type_layout;
+    element_cursor.m_offset = index * element_stride();
     return element_cursor;
 }
 
+size_t BufferCursor::element_size() const
+{
+    return m_element_snapshot_type_layout ? m_element_snapshot_type_layout->size() : m_element_type_layout->size();
+}
+
+size_t BufferCursor::element_stride() const
+{
+    return m_element_snapshot_type_layout ? m_element_snapshot_type_layout->stride() : m_element_type_layout->stride();
+}
+
 void BufferCursor::write_data(size_t offset, const void* data, size_t size)
 {
     if (!m_buffer) {
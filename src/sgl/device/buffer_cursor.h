@@ -6,6 +6,7 @@
 #include "sgl/device/shader_offset.h"
 #include "sgl/device/reflection.h"
 #include "sgl/device/cursor_utils.h"
+#include "sgl/device/reflection_snapshot.h"
 
 #include "sgl/core/config.h"
 #include "sgl/core/macros.h"
@@ -23,8 +24,16 @@ public:
     /// Create with none-owning view of specific block of memory
     BufferElementCursor(ref<TypeLayoutReflection> layout, ref<BufferCursor> owner);
 
+    /// Create with none-owning view of specific block of memory, using a type layout from a reflection snapshot.
+    BufferElementCursor(ref<const TypeLayoutSnapshot> layout, ref<BufferCursor> owner);
+
+    /// Type layout of the element (null if the cursor uses a reflection snapshot).
     ref<const TypeLayoutReflection> type_layout() const { return m_type_layout; }
-    ref<const TypeReflection> type() const { return m_type_layout->type(); }
+    /// Type of the element (null if the cursor uses a reflection snapshot).
+    ref<const TypeReflection> type() const { return m_type_layout ? m_type_layout->type() : nullptr; }
+
+    /// Type layout of the element if the cursor uses a reflection snapshot.
+    ref<const TypeLayoutSnapshot> snapshot_type_layout() const { return m_snapshot_type_layout; }
 
     size_t offset() const { return m_offset; }
 
@@ -78,6 +87,7 @@ private:
     void read_data(size_t offset, void* data, size_t size) const;
 
     ref<const TypeLayoutReflection> m_type_layout;
+    ref<const TypeLayoutSnapshot> m_snapshot_type_layout;
     ref<BufferCursor> m_buffer;
     size_t m_offset{0};
 
@@ -102,13 +112,27 @@ public:
     /// Create as a view onto a buffer resource.
     BufferCursor(ref<TypeLayoutReflection> element_layout, ref<Buffer> resource);
 
+    /// Create with none-owning view of specific block of memory, using an element type layout
+    /// from a reflection snapshot. This does not require slang reflection (or a device).
+    BufferCursor(ref<const TypeLayoutSnapshot> element_layout, void* data, size_t size);
+
+    /// Create buffer + allocate space internally for a given number of elements,
+    /// using an element type layout from a reflection snapshot.
+    BufferCursor(ref<const TypeLayoutSnapshot> element_layout, size_t element_count);
+
     ~BufferCursor();
 
-    /// Get type layout of an element of the cursor.
+    /// Get type layout of an element of the cursor (null if the cursor uses a reflection snapshot).
     ref<const TypeLayoutReflection> element_type_layout() const { return m_element_type_layout; }
 
-    /// Get type of an element of the cursor.
-    ref<const TypeReflection> element_type() const { return m_element_type_layout->type(); }
+    /// Get type of an element of the cursor (null if the cursor uses a reflection snapshot).
+    ref<const TypeReflection> element_type() const
+    {
+        return m_element_type_layout ? m_element_type_layout->type() : nullptr;
+    }
+
+    /// Get type layout of an element of the cursor if the cursor uses a reflection snapshot.
+    ref<const TypeLayoutSnapshot> element_snapshot_type_layout() const { return m_element_snapshot_type_layout; }
 
     /// Get element at a given index.
     BufferElementCursor find_element(uint32_t index);
@@ -120,7 +144,10 @@ public:
     size_t element_count() const { return size() / element_size(); }
 
     /// Size of element.
-    size_t element_size() const { return m_element_type_layout->size(); }
+    size_t element_size() const;
+
+    /// Stride between elements.
+    size_t element_stride() const;
 
     /// Size of whole buffer.
     size_t size() const { return m_size; }
@@ -145,6 +172,7 @@ public:
 
 private:
     ref<const TypeLayoutReflection> m_element_type_layout;
+    ref<const TypeLayoutSnapshot> m_element_snapshot_type_layout;
     ref<Buffer> m_resource;
     uint8_t* m_buffer{nullptr};
     size_t m_size{0};
@@ -15,9 +15,10 @@
 #include "sgl/device/cuda_utils.h"
 #include "sgl/device/cuda_interop.h"
 #include "sgl/device/shader_cursor.h"
-#include "sgl/device/print.h"
+#include "sgl/device/message_channel.h"
 #include "sgl/device/blit.h"
 
+#include "sgl/core/metrics.h"
 #include "sgl/core/short_vector.h"
 #include "sgl/core/maths.h"
 #include "sgl/core/type_utils.h"
@@ -38,6 +39,12 @@ namespace detail {
     }
 } // namespace detail
 
+static Counter& s_dispatch_counter
+    = MetricsRegistry::get().counter("sgl_dispatches_total", "Number of compute and ray tracing dispatches.");
+static Counter& s_barrier_counter
+    = MetricsRegistry::get().counter("sgl_barriers_total", "Number of resource barriers recorded.");
+static Counter& s_bytes_uploaded_counter
+    = MetricsRegistry::get().counter("sgl_bytes_uploaded_total", "Number of bytes uploaded to the device.");
 
 // ----------------------------------------------------------------------------
 // ComputeCommandEncoder
@@ -65,8 +72,8 @@ ref<TransientShaderObject> ComputeCommandEncoder::bind_pipeline(const ComputePip
     SLANG_CALL(m_gfx_compute_command_encoder->bindPipeline(pipeline->gfx_pipeline_state(), &gfx_shader_object));
     ref<TransientShaderObject> transient_shader_object
         = make_ref<TransientShaderObject>(ref<Device>(m_command_buffer->device()), gfx_shader_object, m_command_buffer);
-    if (m_command_buffer->device()->debug_printer())
-        m_command_buffer->device()->debug_printer()->bind(ShaderCursor(transient_shader_object));
+    if (m_command_buffer->device()->message_channel())
+        m_command_buffer->device()->message_channel()->bind(ShaderCursor(transient_shader_object));
     m_bound_shader_object = transient_shader_object;
     return transient_shader_object;
 }
@@ -81,6 +88,7 @@ void ComputeCommandEncoder::bind_pipeline(const ComputePipeline* pipeline, const
     // alternatively we could process CUDA buffers at bind time
     m_bound_shader_object = ref<const ShaderObject>(shader_object);
     static_cast<const MutableShaderObject*>(shader_object)->set_resource_states(m_command_buffer);
+    shader_object->commit_data();
     SLANG_CALL(m_gfx_compute_command_encoder
                    ->bindPipelineWithRootObject(pipeline->gfx_pipeline_state(), shader_object->gfx_shader_object()));
 }
@@ -101,11 +109,13 @@ void ComputeCommandEncoder::dispatch_thread_groups(uint3 thread_group_count)
 {
     SGL_CHECK(m_bound_pipeline, "No pipeline bound");
 
+    m_bound_shader_object->commit_data();
     m_bound_shader_object->get_cuda_interop_buffers(m_command_buffer->m_cuda_interop_buffers);
 
     SLANG_CALL(
         m_gfx_compute_command_encoder->dispatchCompute(thread_group_count.x, thread_group_count.y, thread_group_count.z)
     );
+    s_dispatch_counter.add();
 }
 
 void ComputeCommandEncoder::dispatch_thread_groups_indirect(const Buffer* cmd_buffer, DeviceOffset offset)
@@ -113,7 +123,11 @@ void ComputeCommandEncoder::dispatch_thread_groups_indirect(const Buffer* cmd_bu
     SGL_CHECK_NOT_NULL(cmd_buffer);
     SGL_CHECK(m_bound_pipeline, "No pipeline bound");
 
+    m_bound_shader_object->commit_data();
+    m_bound_shader_object->get_cuda_interop_buffers(m_command_buffer->m_cuda_interop_buffers);
+
     SLANG_CALL(m_gfx_compute_command_encoder->dispatchComputeIndirect(cmd_buffer->gfx_buffer_resource(), offset));
+    s_dispatch_counter.add();
 }
 
 // ----------------------------------------------------------------------------
@@ -142,8 +156,8 @@ ref<TransientShaderObject> RenderCommandEncoder::bind_pipeline(const GraphicsPip
     SLANG_CALL(m_gfx_render_command_encoder->bindPipeline(pipeline->gfx_pipeline_state(), &gfx_shader_object));
     ref<TransientShaderObject> transient_shader_object
         = make_ref<TransientShaderObject>(ref<Device>(m_command_buffer->device()), gfx_shader_object, m_command_buffer);
-    if (m_command_buffer->device()->debug_printer())
-        m_command_buffer->device()->debug_printer()->bind(ShaderCursor(transient_shader_object));
+    if (m_command_buffer->device()->message_channel())
+        m_command_buffer->device()->message_channel()->bind(ShaderCursor(transient_shader_object));
     m_bound_shader_object = transient_shader_object;
     return transient_shader_object;
 }
@@ -156,6 +170,7 @@ void RenderCommandEncoder::bind_pipeline(const GraphicsPipeline* pipeline, const
     m_bound_pipeline = pipeline;
     m_bound_shader_object = ref<const ShaderObject>(shader_object);
     static_cast<const MutableShaderObject*>(shader_object)->set_resource_states(m_command_buffer);
+    shader_object->commit_data();
     SLANG_CALL(m_gfx_render_command_encoder
                    ->bindPipelineWithRootObject(pipeline->gfx_pipeline_state(), shader_object->gfx_shader_object()));
 }
@@ -223,6 +238,7 @@ void RenderCommandEncoder::draw(uint32_t vertex_count, uint32_t start_vertex)
 {
     SGL_CHECK(m_bound_pipeline, "No pipeline bound");
 
+    m_bound_shader_object->commit_data();
     m_bound_shader_object->get_cuda_interop_buffers(m_command_buffer->m_cuda_interop_buffers);
 
     SLANG_CALL(m_gfx_render_command_encoder->draw(vertex_count, start_vertex));
@@ -232,6 +248,7 @@ void RenderCommandEncoder::draw_indexed(uint32_t index_count, uint32_t start_ind
 {
     SGL_CHECK(m_bound_pipeline, "No pipeline bound");
 
+    m_bound_shader_object->commit_data();
     m_bound_shader_object->get_cuda_interop_buffers(m_command_buffer->m_cuda_interop_buffers);
 
     SLANG_CALL(m_gfx_render_command_encoder->drawIndexed(index_count, start_index, base_vertex));
@@ -246,6 +263,7 @@ void RenderCommandEncoder::draw_instanced(
 {
     SGL_CHECK(m_bound_pipeline, "No pipeline bound");
 
+    m_bound_shader_object->commit_data();
     m_bound_shader_object->get_cuda_interop_buffers(m_command_buffer->m_cuda_interop_buffers);
 
     SLANG_CALL(m_gfx_render_command_encoder->drawInstanced(vertex_count, instance_count, start_vertex, start_instance));
@@ -261,6 +279,7 @@ void RenderCommandEncoder::draw_indexed_instanced(
 {
     SGL_CHECK(m_bound_pipeline, "No pipeline bound");
 
+    m_bound_shader_object->commit_data();
     m_bound_shader_object->get_cuda_interop_buffers(m_command_buffer->m_cuda_interop_buffers);
 
     SLANG_CALL(m_gfx_render_command_encoder
@@ -277,6 +296,7 @@ void RenderCommandEncoder::draw_indirect(
 {
     SGL_CHECK(m_bound_pipeline, "No pipeline bound");
 
+    m_bound_shader_object->commit_data();
     m_bound_shader_object->get_cuda_interop_buffers(m_command_buffer->m_cuda_interop_buffers);
 
     SLANG_CALL(m_gfx_render_command_encoder->drawIndirect(
@@ -298,6 +318,7 @@ void RenderCommandEncoder::draw_indexed_indirect(
 {
     SGL_CHECK(m_bound_pipeline, "No pipeline bound");
 
+    m_bound_shader_object->commit_data();
     m_bound_shader_object->get_cuda_interop_buffers(m_command_buffer->m_cuda_interop_buffers);
 
     SLANG_CALL(m_gfx_render_command_encoder->drawIndexedIndirect(
@@ -335,8 +356,8 @@ ref<TransientShaderObject> RayTracingCommandEncoder::bind_pipeline(const RayTrac
     SLANG_CALL(m_gfx_ray_tracing_command_encoder->bindPipeline(pipeline->gfx_pipeline_state(), &gfx_shader_object));
     ref<TransientShaderObject> transient_shader_object
         = make_ref<TransientShaderObject>(ref<Device>(m_command_buffer->device()), gfx_shader_object, m_command_buffer);
-    if (m_command_buffer->device()->debug_printer())
-        m_command_buffer->device()->debug_printer()->bind(ShaderCursor(transient_shader_object));
+    if (m_command_buffer->device()->message_channel())
+        m_command_buffer->device()->message_channel()->bind(ShaderCursor(transient_shader_object));
     m_bound_shader_object = transient_shader_object;
     return transient_shader_object;
 }
@@ -349,6 +370,7 @@ void RayTracingCommandEncoder::bind_pipeline(const RayTracingPipeline* pipeline,
     m_bound_pipeline = pipeline;
     m_bound_shader_object = ref<const ShaderObject>(shader_object);
     static_cast<const MutableShaderObject*>(shader_object)->set_resource_states(m_command_buffer);
+    shader_object->commit_data();
     SLANG_CALL(m_gfx_ray_tracing_command_encoder
                    ->bindPipelineWithRootObject(pipeline->gfx_pipeline_state(), shader_object->gfx_shader_object()));
 }
@@ -362,6 +384,7 @@ void RayTracingCommandEncoder::dispatch_rays(
     SGL_CHECK_NOT_NULL(shader_table);
     SGL_CHECK(m_bound_pipeline, "No pipeline bound");
 
+    m_bound_shader_object->commit_data();
     m_bound_shader_object->get_cuda_interop_buffers(m_command_buffer->m_cuda_interop_buffers);
 
     SLANG_CALL(m_gfx_ray_tracing_command_encoder->dispatchRays(
@@ -371,6 +394,7 @@ void RayTracingCommandEncoder::dispatch_rays(
         narrow_cast<gfx::GfxCount>(dimensions.y),
         narrow_cast<gfx::GfxCount>(dimensions.z)
     ));
+    s_dispatch_counter.add();
 }
 
 void RayTracingCommandEncoder::build_acceleration_structure(
@@ -584,6 +608,7 @@ bool CommandBuffer::set_buffer_state(const Buffer* buffer, ResourceState new_sta
         static_cast<gfx::ResourceState>(current_state),
         static_cast<gfx::ResourceState>(new_state)
     );
+    s_barrier_counter.add();
 
     return true;
 }
@@ -606,6 +631,7 @@ bool CommandBuffer::set_texture_state(const Texture* texture, ResourceState new_
             static_cast<gfx::ResourceState>(current_state),
             static_cast<gfx::ResourceState>(new_state)
         );
+        s_barrier_counter.add();
 
         return true;
     } else {
@@ -626,6 +652,7 @@ bool CommandBuffer::set_texture_state(const Texture* texture, ResourceState new_
                         static_cast<gfx::ResourceState>(old_state),
                         static_cast<gfx::ResourceState>(new_state)
                     );
+                    s_barrier_counter.add();
                     changed = true;
                 }
             }
@@ -681,6 +708,7 @@ bool CommandBuffer::set_texture_subresource_state(
                     static_cast<gfx::ResourceState>(old_state),
                     static_cast<gfx::ResourceState>(new_state)
                 );
+                s_barrier_counter.add();
                 changed = true;
             }
         }
@@ -709,6 +737,7 @@ void CommandBuffer::uav_barrier(const Resource* resource)
             gfx::ResourceState::UnorderedAccess
         );
     }
+    s_barrier_counter.add();
 }
 
 void CommandBuffer::clear_resource_view(ResourceView* resource_view, float4 clear_value)
@@ -1018,6 +1047,7 @@ void CommandBuffer::upload_buffer_data(Buffer* buffer, size_t offset, size_t siz
 
     get_gfx_resource_command_encoder()
         ->uploadBufferData(buffer->gfx_buffer_resource(), offset, size, const_cast<void*>(data));
+    s_bytes_uploaded_counter.add(size);
 }
 
 void CommandBuffer::upload_texture_data(Texture* texture, uint32_t subresource, SubresourceData subresource_data)
@@ -1052,6 +1082,7 @@ void CommandBuffer::upload_texture_data(Texture* texture, uint32_t subresource,
         &gfx_subresource_data,
         1
     );
+    s_bytes_uploaded_counter.add(texture->get_subresource_layout(subresource).total_size());
 }
 
 void CommandBuffer::resolve_texture(Texture* dst, const Texture* src)
@@ -0,0 +1,441 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "command_bundle.h"
+
+#include "sgl/device/device.h"
+#include "sgl/device/command.h"
+#include "sgl/device/kernel.h"
+#include "sgl/device/pipeline.h"
+#include "sgl/device/resource.h"
+#include "sgl/device/sampler.h"
+#include "sgl/device/raytracing.h"
+#include "sgl/device/shader.h"
+#include "sgl/device/shader_object.h"
+#include "sgl/device/reflection.h"
+
+#include "sgl/core/error.h"
+#include "sgl/core/maths.h"
+#include "sgl/core/string.h"
+#include "sgl/core/type_utils.h"
+
+#include <charconv>
+
+namespace sgl {
+
+namespace {
+
+    bool is_parameter_group(const TypeLayoutReflection* type_layout)
+    {
+        return type_layout->kind() == TypeReflection::Kind::constant_buffer
+            || type_layout->kind() == TypeReflection::Kind::parameter_block;
+    }
+
+    /// Shader objects hold the contents of a constant buffer or parameter block, not the wrapper.
+    ref<const TypeLayoutReflection> unwrap_parameter_group(ref<const TypeLayoutReflection> type_layout)
+    {
+        return is_parameter_group(type_layout) ? type_layout->element_type_layout() : type_layout;
+    }
+
+} // namespace
+
+CommandBundle::CommandBundle(ref<Device> device)
+    : DeviceResource(std::move(device))
+{
+}
+
+CommandBundle::Slot CommandBundle::add_slot(std::string name, Value value)
+{
+    SGL_CHECK(!has_slot(name), "Slot \"{}\" already exists.", name);
+    uint32_t index = narrow_cast<uint32_t>(m_slots.size());
+    m_slot_indices.emplace(name, index);
+    m_slots.push_back({std::move(name), std::move(value)});
+    return Slot{index};
+}
+
+CommandBundle::Slot CommandBundle::slot(std::string_view name) const
+{
+    auto it = m_slot_indices.find(name);
+    SGL_CHECK(it != m_slot_indices.end(), "Slot \"{}\" not found.", name);
+    return Slot{it->second};
+}
+
+bool CommandBundle::has_slot(std::string_view name) const
+{
+    return m_slot_indices.find(name) != m_slot_indices.end();
+}
+
+void CommandBundle::set_slot(Slot slot, Value value)
+{
+    SGL_CHECK_LT(slot.index, m_slots.size());
+    m_slots[slot.index].value = std::move(value);
+}
+
+const CommandBundle::Value& CommandBundle::get_slot(Slot slot) const
+{
+    SGL_CHECK_LT(slot.index, m_slots.size());
+    return m_slots[slot.index].value;
+}
+
+void CommandBundle::dispatch(ref<ComputeKernel> kernel, uint3 thread_count, std::span<const Binding> bindings)
+{
+    SGL_CHECK_NOT_NULL(kernel);
+
+    uint3 thread_group_size = kernel->pipeline()->thread_group_size();
+    uint3 thread_group_count{
+        div_round_up(thread_count.x, thread_group_size.x),
+        div_round_up(thread_count.y, thread_group_size.y),
+        div_round_up(thread_count.z, thread_group_size.z)};
+    dispatch_thread_groups(std::move(kernel), thread_group_count, bindings);
+}
+
+void CommandBundle::dispatch_thread_groups(
+    ref<ComputeKernel> kernel,
+    uint3 thread_group_count,
+    std::span<const Binding> bindings
+)
+{
+    SGL_CHECK_NOT_NULL(kernel);
+
+    DispatchCommand command{
+        .kernel = kernel,
+        .pipeline = ref(kernel->pipeline()),
+        .thread_group_count = thread_group_count,
+    };
+
+    // Resolve the parameter paths to shader offsets once at record time, using the same
+    // offset computation as ShaderCursor. Parameters are looked up in the global scope first
+    // and in the entry point otherwise.
+    ref<const ProgramLayout> layout = kernel->program()->layout();
+    ref<const TypeLayoutReflection> globals = unwrap_parameter_group(layout->globals_type_layout());
+    ref<const TypeLayoutReflection> entry_point
+        = unwrap_parameter_group(layout->get_entry_point_by_index(0)->type_layout());
+    command.bindings.reserve(bindings.size());
+    for (const Binding& binding : bindings) {
+        check_argument(binding.value);
+        std::vector<PathSegment> path = parse_path(binding.path);
+        SGL_CHECK(!path[0].is_index, "Invalid shader parameter path \"{}\".", binding.path);
+
+        const std::string& root_name = path[0].name;
+        bool is_entry_point_parameter = globals->kind() != TypeReflection::Kind::struct_
+            || globals->find_field_index_by_name(root_name.data(), root_name.data() + root_name.size()) < 0;
+        ResolvedBinding resolved{
+            .path = binding.path,
+            .is_entry_point_parameter = is_entry_point_parameter,
+            .offset = ShaderOffset::zero(),
+            .value = binding.value,
+        };
+        ref<const TypeLayoutReflection> type_layout = is_entry_point_parameter ? entry_point : globals;
+        for (const PathSegment& segment : path) {
+            if (!segment.is_index) {
+                // Accessing a field of a constant buffer or parameter block descends into its sub-object.
+                if (is_parameter_group(type_layout)) {
+                    resolved.object_offsets.push_back(resolved.offset);
+                    resolved.offset = ShaderOffset::zero();
+                    type_layout = type_layout->element_type_layout();
+                }
+                const std::string& name = segment.name;
+                int32_t field_index = type_layout->kind() == TypeReflection::Kind::struct_
+                    ? type_layout->find_field_index_by_name(name.data(), name.data() + name.size())
+                    : -1;
+                SGL_CHECK(field_index >= 0, "Shader parameter \"{}\" not found.", binding.path);
+                ref<const VariableLayoutReflection> field_layout = type_layout->get_field_by_index(field_index);
+                resolved.offset.uniform_offset += narrow_cast<uint32_t>(field_layout->offset());
+                resolved.offset.binding_range_index += type_layout->get_field_binding_range_offset(field_index);
+                type_layout = field_layout->type_layout();
+            } else {
+                switch (type_layout->kind()) {
+                case TypeReflection::Kind::array:
+                    resolved.offset.binding_array_index
+                        = resolved.offset.binding_array_index * narrow_cast<uint32_t>(type_layout->element_count())
+                        + segment.index;
+                    [[fallthrough]];
+                case TypeReflection::Kind::vector:
+                case TypeReflection::Kind::matrix:
+                    resolved.offset.uniform_offset
+                        += segment.index * narrow_cast<uint32_t>(type_layout->element_stride());
+                    type_layout = type_layout->element_type_layout();
+                    break;
+                default:
+                    SGL_THROW("Shader parameter \"{}\" not found.", binding.path);
+                }
+            }
+        }
+
+        // Determine how the parameter is written on replay.
+        ref<const TypeReflection> type = type_layout->unwrap_array()->type();
+        bool is_resource = type->kind() == TypeReflection::Kind::resource
+            || type->kind() == TypeReflection::Kind::texture_buffer
+            || type->kind() == TypeReflection::Kind::shader_storage_buffer;
+        if (type->kind() == TypeReflection::Kind::resource
+            && type->resource_shape() == TypeReflection::ResourceShape::acceleration_structure)
+            resolved.kind = BindingKind::acceleration_structure;
+        else if (type->kind() == TypeReflection::Kind::sampler_state)
+            resolved.kind = BindingKind::sampler;
+        else if (is_resource && type->resource_access() == TypeReflection::ResourceAccess::read)
+            resolved.kind = BindingKind::shader_resource;
+        else if (is_resource && type->resource_access() == TypeReflection::ResourceAccess::read_write)
+            resolved.kind = BindingKind::unordered_access;
+        else if (type_layout->parameter_category() == TypeReflection::ParameterCategory::uniform)
+            resolved.kind = BindingKind::data;
+        else
+            SGL_THROW("Shader parameter \"{}\" cannot be bound.", binding.path);
+        if (resolved.kind == BindingKind::data) {
+            resolved.data_size = type_layout->size();
+            // Fixed values are checked right away, slot values when they are bound.
+            if (auto value = std::get_if<Value>(&binding.value))
+                if (auto data = std::get_if<Data>(value))
+                    check_data_size(resolved, *data);
+        }
+
+        command.bindings.push_back(std::move(resolved));
+    }
+
+    m_commands.push_back(std::move(command));
+}
+
+void CommandBundle::copy_buffer_region(
+    Argument dst,
+    DeviceOffset dst_offset,
+    Argument src,
+    DeviceOffset src_offset,
+    DeviceSize size
+)
+{
+    check_argument(dst);
+    check_argument(src);
+    m_commands.push_back(CopyBufferRegionCommand{
+        .dst = std::move(dst),
+        .dst_offset = dst_offset,
+        .src = std::move(src),
+        .src_offset = src_offset,
+        .size = size,
+    });
+}
+
+void CommandBundle::uav_barrier(Argument resource)
+{
+    check_argument(resource);
+    m_commands.push_back(UavBarrierCommand{.resource = std::move(resource)});
+}
+
+void CommandBundle::clear()
+{
+    m_commands.clear();
+}
+
+void CommandBundle::execute(CommandBuffer* command_buffer) const
+{
+    // Ends the shared command buffer also when replaying throws.
+    struct SharedCommandBufferScope {
+        Device* device{nullptr};
+        ~SharedCommandBufferScope()
+        {
+            if (device)
+                device->_end_shared_command_buffer(false);
+        }
+    } shared_scope;
+    if (command_buffer == nullptr) {
+        command_buffer = m_device->_begin_shared_command_buffer();
+        shared_scope.device = m_device;
+    }
+
+    auto get_buffer = [this](const Argument& argument) -> Buffer*
+    {
+        const Value& value = resolve(argument);
+        SGL_CHECK(std::holds_alternative<ref<Buffer>>(value), "Expected a buffer.");
+        return std::get<ref<Buffer>>(value).get();
+    };
+
+    auto get_resource = [this](const Argument& argument) -> Resource*
+    {
+        const Value& value = resolve(argument);
+        if (auto buffer = std::get_if<ref<Buffer>>(&value))
+            return buffer->get();
+        if (auto texture = std::get_if<ref<Texture>>(&value))
+            return texture->get();
+        if (auto resource_view = std::get_if<ref<ResourceView>>(&value))
+            return (*resource_view)->resource();
+        SGL_THROW("Expected a buffer, texture or resource view.");
+    };
+
+    {
+        // All commands are encoded using a single compute encoder.
+        // Resource commands (copies, barriers) are valid on compute encoders.
+        auto encoder = command_buffer->encode_compute_commands();
+        const ComputePipeline* bound_pipeline{nullptr};
+        for (const Command& command : m_commands) {
+            if (auto dispatch = std::get_if<DispatchCommand>(&command)) {
+                // Binding a pipeline creates a new root shader object. Consecutive dispatches of the
+                // same pipeline without bindings keep using the current one.
+                if (dispatch->pipeline != bound_pipeline || !dispatch->bindings.empty()) {
+                    ref<ShaderObject> root = encoder.bind_pipeline(dispatch->pipeline);
+                    bound_pipeline = dispatch->pipeline;
+                    ref<ShaderObject> entry_point;
+                    for (const ResolvedBinding& binding : dispatch->bindings) {
+                        ShaderObject* object = root;
+                        if (binding.is_entry_point_parameter) {
+                            if (!entry_point)
+                                entry_point = root->get_entry_point(0);
+                            object = entry_point;
+                        }
+                        bind(object, binding, resolve(binding.value));
+                    }
+                }
+                encoder.dispatch_thread_groups(dispatch->thread_group_count);
+            } else if (auto copy = std::get_if<CopyBufferRegionCommand>(&command)) {
+                bound_pipeline = nullptr;
+                command_buffer->copy_buffer_region(
+                    get_buffer(copy->dst),
+                    copy->dst_offset,
+                    get_buffer(copy->src),
+                    copy->src_offset,
+                    copy->size
+                );
+            } else if (auto barrier = std::get_if<UavBarrierCommand>(&command)) {
+                bound_pipeline = nullptr;
+                command_buffer->uav_barrier(get_resource(barrier->resource));
+            }
+        }
+    }
+}
+
+DeviceResource::MemoryUsage CommandBundle::memory_usage() const
+{
+    size_t host = m_commands.capacity() * sizeof(Command) + m_slots.capacity() * sizeof(SlotEntry);
+    for (const SlotEntry& slot : m_slots)
+        if (auto data = std::get_if<Data>(&slot.value))
+            host += data->capacity();
+    return {.host = host};
+}
+
+std::string CommandBundle::to_string() const
+{
+    std::vector<std::string> slot_names;
+    for (const SlotEntry& slot : m_slots)
+        slot_names.push_back(slot.name);
+    return fmt::format(
+        "CommandBundle(\n"
+        "  device = {},\n"
+        "  slots = [{}],\n"
+        "  command_count = {}\n"
+        ")",
+        m_device,
+        string::join(slot_names, ", "),
+        m_commands.size()
+    );
+}
+
+const CommandBundle::Value& CommandBundle::resolve(const Argument& argument) const
+{
+    if (auto slot = std::get_if<Slot>(&argument))
+        return m_slots[slot->index].value;
+    return std::get<Value>(argument);
+}
+
+void CommandBundle::check_argument(const Argument& argument) const
+{
+    if (auto slot = std::get_if<Slot>(&argument))
+        SGL_CHECK_LT(slot->index, m_slots.size());
+}
+
+std::vector<CommandBundle::PathSegment> CommandBundle::parse_path(std::string_view path)
+{
+    std::vector<PathSegment> segments;
+    size_t pos = 0;
+    while (pos < path.size()) {
+        if (path[pos] == '.') {
+            SGL_CHECK(!segments.empty() && pos + 1 < path.size(), "Invalid shader parameter path \"{}\".", path);
+            ++pos;
+        } else if (path[pos] == '[') {
+            size_t end = path.find(']', pos);
+            SGL_CHECK(
+                end != std::string_view::npos && !segments.empty(),
+                "Invalid shader parameter path \"{}\".",
+                path
+            );
+            uint32_t index{0};
+            auto result = std::from_chars(path.data() + pos + 1, path.data() + end, index);
+            SGL_CHECK(
+                result.ec == std::errc() && result.ptr == path.data() + end,
+                "Invalid shader parameter path \"{}\".",
+                path
+            );
+            segments.push_back({.index = index, .is_index = true});
+            pos = end + 1;
+        } else {
+            size_t end = path.find_first_of(".[", pos);
+            if (end == std::string_view::npos)
+                end = path.size();
+            segments.push_back({.name = std::string(path.substr(pos, end - pos)), .index = 0, .is_index = false});
+            pos = end;
+        }
+    }
+    SGL_CHECK(!segments.empty(), "Invalid shader parameter path \"{}\".", path);
+    return segments;
+}
+
+void CommandBundle::check_data_size(const ResolvedBinding& binding, const Data& data)
+{
+    SGL_CHECK(
+        data.size() == binding.data_size,
+        "Shader parameter \"{}\" expects {} bytes of data but {} bytes were given.",
+        binding.path,
+        binding.data_size,
+        data.size()
+    );
+}
+
+void CommandBundle::bind(ShaderObject* object, const ResolvedBinding& binding, const Value& value)
+{
+    ref<ShaderObject> sub_object;
+    for (const ShaderOffset& offset : binding.object_offsets) {
+        sub_object = object->get_object(offset);
+        object = sub_object;
+    }
+
+    auto check = [&binding](bool condition)
+    { SGL_CHECK(condition, "Shader parameter \"{}\" cannot bind the given value.", binding.path); };
+
+    switch (binding.kind) {
+    case BindingKind::shader_resource:
+    case BindingKind::unordered_access: {
+        bool srv = binding.kind == BindingKind::shader_resource;
+        ref<ResourceView> resource_view;
+        if (auto buffer = std::get_if<ref<Buffer>>(&value)) {
+            if (*buffer)
+                resource_view = srv ? (*buffer)->get_srv() : (*buffer)->get_uav();
+        } else if (auto texture = std::get_if<ref<Texture>>(&value)) {
+            if (*texture)
+                resource_view = srv ? (*texture)->get_srv() : (*texture)->get_uav();
+        } else if (auto view = std::get_if<ref<ResourceView>>(&value)) {
+            resource_view = *view;
+            if (resource_view)
+                check(
+                    resource_view->type()
+                    == (srv ? ResourceViewType::shader_resource : ResourceViewType::unordered_access)
+                );
+        } else {
+            check(false);
+        }
+        object->set_resource(binding.offset, resource_view);
+        break;
+    }
+    case BindingKind::sampler:
+        check(std::holds_alternative<ref<Sampler>>(value));
+        object->set_sampler(binding.offset, std::get<ref<Sampler>>(value));
+        break;
+    case BindingKind::acceleration_structure:
+        check(std::holds_alternative<ref<AccelerationStructure>>(value));
+        object->set_acceleration_structure(binding.offset, std::get<ref<AccelerationStructure>>(value));
+        break;
+    case BindingKind::data: {
+        check(std::holds_alternative<Data>(value));
+        const Data& data = std::get<Data>(value);
+        check_data_size(binding, data);
+        object->set_data(binding.offset, data.data(), data.size());
+        break;
+    }
+    }
+}
+
+} // namespace sgl
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sgl/device/fwd.h"
+#include "sgl/device/device_resource.h"
+#include "sgl/device/shader_offset.h"
+#include "sgl/device/types.h"
+
+#include "sgl/core/object.h"
+#include "sgl/core/type_utils.h"
+#include "sgl/math/vector_types.h"
+
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace sgl {
+
+/**
+ * \brief A recorded sequence of commands that can be replayed many times.
+ *
+ * Commands are recorded once and reference either fixed values or named parameter slots.
+ * Slot values (resources or uniform data) can be updated between replays without
+ * re-recording the bundle. Shader parameter paths are resolved to shader offsets and
+ * binding kinds at record time, together with pipelines and thread group counts, so a
+ * replay only writes the bound values through those offsets and issues the commands.
+ *
+ * gfx does not expose secondary command buffers or bundles, therefore bundles are stored
+ * as a compact replay list on the host and re-encoded into the target command buffer.
+ */
+class SGL_API CommandBundle : public DeviceResource {
+    SGL_OBJECT(CommandBundle)
+public:
+    /// Uniform data (bytes matching the layout of the shader parameter).
+    using Data = std::vector<uint8_t>;
+
+    /// Value that can be bound to a shader parameter or a slot.
+    using Value = std::variant<
+        std::monostate,
+        ref<Buffer>,
+        ref<Texture>,
+        ref<ResourceView>,
+        ref<Sampler>,
+        ref<AccelerationStructure>,
+        Data>;
+
+    /// Reference to a parameter slot.
+    struct Slot {
+        uint32_t index;
+    };
+
+    /// Argument of a recorded command, either a fixed value or a slot.
+    using Argument = std::variant<Value, Slot>;
+
+    /// Shader parameter binding of a dispatch.
+    struct Binding {
+        /// Path of the shader parameter (e.g. "params.buffer" or "items[2]").
+        /// Global parameters take precedence over entry point parameters with the same name.
+        std::string path;
+        /// Bound value.
+        Argument value;
+    };
+
+    CommandBundle(ref<Device> device);
+    ~CommandBundle() = default;
+
+    SGL_NON_COPYABLE_AND_MOVABLE(CommandBundle);
+
+    // ------------------------------------------------------------------------
+    // Slots
+    // ------------------------------------------------------------------------
+
+    /**
+     * \brief Add a parameter slot.
+     *
+     * \param name Name of the slot (needs to be unique).
+     * \param value Initial value.
+     * \return Reference to the slot.
+     */
+    Slot add_slot(std::string name, Value value = {});
+
+    /// Get a slot by name.
+    Slot slot(std::string_view name) const;
+
+    /// True if a slot with the given name exists.
+    bool has_slot(std::string_view name) const;
+
+    /// Number of slots.
+    uint32_t slot_count() const { return narrow_cast<uint32_t>(m_slots.size()); }
+
+    /// Set the value of a slot.
+    void set_slot(Slot slot, Value value);
+
+    /// Set the value of a slot by name.
+    void set_slot(std::string_view name, Value value) { set_slot(this->slot(name), std::move(value)); }
+
+    /// Set the value of a slot to uniform data.
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    void set_slot_data(Slot slot, const T& value)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        set_slot(slot, Data(bytes, bytes + sizeof(T)));
+    }
+
+    /// Get the value of a slot.
+    const Value& get_slot(Slot slot) const;
+
+    // ------------------------------------------------------------------------
+    // Recording
+    // ------------------------------------------------------------------------
+
+    /**
+     * \brief Record a compute dispatch.
+     *
+     * \param kernel Compute kernel to dispatch.
+     * \param thread_count Number of threads to dispatch.
+     * \param bindings Shader parameter bindings.
+     */
+    void dispatch(ref<ComputeKernel> kernel, uint3 thread_count, std::span<const Binding> bindings = {});
+
+    /// Record a compute dispatch with a given number of thread groups.
+    void
+    dispatch_thread_groups(ref<ComputeKernel> kernel, uint3 thread_group_count, std::span<const Binding> bindings = {});
+
+    /// Record a buffer region copy. See \c CommandBuffer::copy_buffer_region.
+    void copy_buffer_region(
+        Argument dst,
+        DeviceOffset dst_offset,
+        Argument src,
+        DeviceOffset src_offset,
+        DeviceSize size
+    );
+
+    /// Record an unordered access barrier. See \c CommandBuffer::uav_barrier.
+    void uav_barrier(Argument resource);
+
+    /// Remove all recorded commands (slots are kept).
+    void clear();
+
+    /// Number of recorded commands.
+    size_t command_count() const { return m_commands.size(); }
+
+    // ------------------------------------------------------------------------
+    // Replay
+    // ------------------------------------------------------------------------
+
+    /**
+     * \brief Replay the recorded commands.
+     *
+     * \param command_buffer Command buffer to encode the commands into.
+     * If null, the commands are encoded into the device's shared command buffer.
+     */
+    void execute(CommandBuffer* command_buffer = nullptr) const;
+
+    MemoryUsage memory_usage() const override;
+
+    std::string to_string() const override;
+
+private:
+    struct PathSegment {
+        std::string name;
+        uint32_t index;
+        bool is_index;
+    };
+
+    /// How a resolved shader parameter is written on replay.
+    enum class BindingKind {
+        shader_resource,
+        unordered_access,
+        sampler,
+        acceleration_structure,
+        data,
+    };
+
+    struct ResolvedBinding {
+        /// Shader parameter path (for error messages).
+        std::string path;
+        bool is_entry_point_parameter;
+        /// Offsets of the sub-objects (constant buffers, parameter blocks) to descend into.
+        std::vector<ShaderOffset> object_offsets;
+        /// Offset of the parameter in the innermost shader object.
+        ShaderOffset offset;
+        BindingKind kind;
+        /// Size of the parameter in bytes (data bindings only).
+        size_t data_size{0};
+        Argument value;
+    };
+
+    struct DispatchCommand {
+        ref<ComputeKernel> kernel;
+        ref<ComputePipeline> pipeline;
+        uint3 thread_group_count;
+        std::vector<ResolvedBinding> bindings;
+    };
+
+    struct CopyBufferRegionCommand {
+        Argument dst;
+        DeviceOffset dst_offset;
+        Argument src;
+        DeviceOffset src_offset;
+        DeviceSize size;
+    };
+
+    struct UavBarrierCommand {
+        Argument resource;
+    };
+
+    using Command = std::variant<DispatchCommand, CopyBufferRegionCommand, UavBarrierCommand>;
+
+    const Value& resolve(const Argument& argument) const;
+    void check_argument(const Argument& argument) const;
+
+    static std::vector<PathSegment> parse_path(std::string_view path);
+    static void check_data_size(const ResolvedBinding& binding, const Data& data);
+    static void bind(ShaderObject* object, const ResolvedBinding& binding, const Value& value);
+
+    struct SlotEntry {
+        std::string name;
+        Value value;
+    };
+
+    std::vector<SlotEntry> m_slots;
+    std::map<std::string, uint32_t, std::less<>> m_slot_indices;
+    std::vector<Command> m_commands;
+};
+
+} // namespace sgl
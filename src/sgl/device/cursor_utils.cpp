@@ -1,4 +1,5 @@
 #include "sgl/device/cursor_utils.h"
+#include "sgl/device/reflection_snapshot.h"
 
 namespace sgl {
 
@@ -68,119 +69,201 @@ namespace cursor_utils {
             return 0;
         }
     }
-    void check_array(
-        const TypeLayoutReflection* type_layout,
-        size_t size,
-        TypeReflection::ScalarType scalar_type,
-        size_t element_count
-    )
+
+    /// Type information required for checking values written to or read from a cursor.
+    struct CheckedType {
+        std::string_view name;
+        bool is_array;
+        size_t element_count;
+        /// Type information of the innermost element (after unwrapping arrays).
+        TypeReflection::Kind kind;
+        TypeReflection::ScalarType scalar_type;
+        uint32_t row_count;
+        uint32_t col_count;
+    };
+
+    static CheckedType get_checked_type(const TypeLayoutReflection* type_layout)
     {
         ref<const TypeReflection> type = type_layout->type();
         ref<const TypeReflection> element_type = type_layout->unwrap_array()->type();
-        size_t element_size = get_scalar_type_size(element_type->scalar_type());
+        return {
+            .name = type_layout->name() ? type_layout->name() : "",
+            .is_array = type->is_array(),
+            .element_count = type->element_count(),
+            .kind = element_type->kind(),
+            .scalar_type = element_type->scalar_type(),
+            .row_count = element_type->row_count(),
+            .col_count = element_type->col_count(),
+        };
+    }
+
+    static CheckedType get_checked_type(const TypeLayoutSnapshot* type_layout)
+    {
+        ref<const TypeLayoutSnapshot> element_type_layout = type_layout->unwrap_array();
+        return {
+            .name = type_layout->name(),
+            .is_array = type_layout->is_array(),
+            .element_count = type_layout->element_count(),
+            .kind = element_type_layout->kind(),
+            .scalar_type = element_type_layout->scalar_type(),
+            .row_count = element_type_layout->row_count(),
+            .col_count = element_type_layout->col_count(),
+        };
+    }
 
-        SGL_CHECK(type->is_array(), "\"{}\" cannot bind an array", type_layout->name());
+    static void
+    check_array(const CheckedType& type, size_t size, TypeReflection::ScalarType scalar_type, size_t element_count)
+    {
+        size_t element_size = get_scalar_type_size(type.scalar_type);
+
+        SGL_CHECK(type.is_array, "\"{}\" cannot bind an array", type.name);
         SGL_CHECK(
-            allow_scalar_conversion(scalar_type, element_type->scalar_type()),
+            allow_scalar_conversion(scalar_type, type.scalar_type),
             "\"{}\" expects scalar type {} (no implicit conversion from type {})",
-            type_layout->name(),
-            element_type->scalar_type(),
+            type.name,
+            type.scalar_type,
             scalar_type
         );
         SGL_CHECK(
-            element_count <= type->element_count(),
+            element_count <= type.element_count,
             "\"{}\" expects an array with at most {} elements (got {})",
-            type_layout->name(),
-            type->element_count(),
+            type.name,
+            type.element_count,
             element_count
         );
         SGL_ASSERT(element_count * element_size == size);
+        SGL_UNUSED(element_size, size);
     }
 
-    void check_scalar(const TypeLayoutReflection* type_layout, size_t size, TypeReflection::ScalarType scalar_type)
+    static void check_scalar(const CheckedType& type, size_t size, TypeReflection::ScalarType scalar_type)
     {
-        ref<const TypeReflection> type = type_layout->unwrap_array()->type();
-
-        SGL_CHECK(
-            type->kind() == TypeReflection::Kind::scalar,
-            "\"{}\" cannot bind a scalar value",
-            type_layout->name()
-        );
+        SGL_CHECK(type.kind == TypeReflection::Kind::scalar, "\"{}\" cannot bind a scalar value", type.name);
         SGL_CHECK(
-            allow_scalar_conversion(scalar_type, type->scalar_type()),
+            allow_scalar_conversion(scalar_type, type.scalar_type),
             "\"{}\" expects scalar type {} (no implicit conversion from type {})",
-            type_layout->name(),
-            type->scalar_type(),
+            type.name,
+            type.scalar_type,
             scalar_type
         );
         SGL_UNUSED(size);
     }
 
-    void check_vector(
-        const TypeLayoutReflection* type_layout,
-        size_t size,
-        TypeReflection::ScalarType scalar_type,
-        int dimension
-    )
+    static void
+    check_vector(const CheckedType& type, size_t size, TypeReflection::ScalarType scalar_type, int dimension)
     {
-        ref<const TypeReflection> type = type_layout->unwrap_array()->type();
-
-        SGL_CHECK(
-            type->kind() == TypeReflection::Kind::vector,
-            "\"{}\" cannot bind a vector value",
-            type_layout->name()
-        );
+        SGL_CHECK(type.kind == TypeReflection::Kind::vector, "\"{}\" cannot bind a vector value", type.name);
         SGL_CHECK(
-            type->col_count() == uint32_t(dimension),
+            type.col_count == uint32_t(dimension),
             "\"{}\" expects a vector with dimension {} (got dimension {})",
-            type_layout->name(),
-            type->col_count(),
+            type.name,
+            type.col_count,
             dimension
         );
         SGL_CHECK(
-            allow_scalar_conversion(scalar_type, type->scalar_type()),
+            allow_scalar_conversion(scalar_type, type.scalar_type),
             "\"{}\" expects a vector with scalar type {} (no implicit conversion from type {})",
-            type_layout->name(),
-            type->scalar_type(),
+            type.name,
+            type.scalar_type,
             scalar_type
         );
         SGL_UNUSED(size);
     }
 
-    void check_matrix(
-        const TypeLayoutReflection* type_layout,
-        size_t size,
-        TypeReflection::ScalarType scalar_type,
-        int rows,
-        int cols
-    )
+    static void
+    check_matrix(const CheckedType& type, size_t size, TypeReflection::ScalarType scalar_type, int rows, int cols)
     {
-        ref<const TypeReflection> type = type_layout->unwrap_array()->type();
-
-        SGL_CHECK(
-            type->kind() == TypeReflection::Kind::matrix,
-            "\"{}\" cannot bind a matrix value",
-            type_layout->name()
-        );
+        SGL_CHECK(type.kind == TypeReflection::Kind::matrix, "\"{}\" cannot bind a matrix value", type.name);
         SGL_CHECK(
-            type->row_count() == uint32_t(rows) && type->col_count() == uint32_t(cols),
+            type.row_count == uint32_t(rows) && type.col_count == uint32_t(cols),
             "\"{}\" expects a matrix with dimension {}x{} (got dimension {}x{})",
-            type_layout->name(),
-            type->row_count(),
-            type->col_count(),
+            type.name,
+            type.row_count,
+            type.col_count,
             rows,
             cols
         );
         SGL_CHECK(
-            allow_scalar_conversion(scalar_type, type->scalar_type()),
+            allow_scalar_conversion(scalar_type, type.scalar_type),
             "\"{}\" expects a matrix with scalar type {} (no implicit conversion from type {})",
-            type_layout->name(),
-            type->scalar_type(),
+            type.name,
+            type.scalar_type,
             scalar_type
         );
         SGL_UNUSED(size);
     }
 
+    void check_array(
+        const TypeLayoutReflection* type_layout,
+        size_t size,
+        TypeReflection::ScalarType scalar_type,
+        size_t element_count
+    )
+    {
+        check_array(get_checked_type(type_layout), size, scalar_type, element_count);
+    }
+
+    void check_scalar(const TypeLayoutReflection* type_layout, size_t size, TypeReflection::ScalarType scalar_type)
+    {
+        check_scalar(get_checked_type(type_layout), size, scalar_type);
+    }
+
+    void check_vector(
+        const TypeLayoutReflection* type_layout,
+        size_t size,
+        TypeReflection::ScalarType scalar_type,
+        int dimension
+    )
+    {
+        check_vector(get_checked_type(type_layout), size, scalar_type, dimension);
+    }
+
+    void check_matrix(
+        const TypeLayoutReflection* type_layout,
+        size_t size,
+        TypeReflection::ScalarType scalar_type,
+        int rows,
+        int cols
+    )
+    {
+        check_matrix(get_checked_type(type_layout), size, scalar_type, rows, cols);
+    }
+
+    void check_array(
+        const TypeLayoutSnapshot* type_layout,
+        size_t size,
+        TypeReflection::ScalarType scalar_type,
+        size_t element_count
+    )
+    {
+        check_array(get_checked_type(type_layout), size, scalar_type, element_count);
+    }
+
+    void check_scalar(const TypeLayoutSnapshot* type_layout, size_t size, TypeReflection::ScalarType scalar_type)
+    {
+        check_scalar(get_checked_type(type_layout), size, scalar_type);
+    }
+
+    void check_vector(
+        const TypeLayoutSnapshot* type_layout,
+        size_t size,
+        TypeReflection::ScalarType scalar_type,
+        int dimension
+    )
+    {
+        check_vector(get_checked_type(type_layout), size, scalar_type, dimension);
+    }
+
+    void check_matrix(
+        const TypeLayoutSnapshot* type_layout,
+        size_t size,
+        TypeReflection::ScalarType scalar_type,
+        int rows,
+        int cols
+    )
+    {
+        check_matrix(get_checked_type(type_layout), size, scalar_type, rows, cols);
+    }
+
 
 } // namespace cursor_utils
 
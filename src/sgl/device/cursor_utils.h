@@ -33,6 +33,32 @@ namespace cursor_utils {
         int rows,
         int cols
     );
+
+    // Overloads for type layouts of reflection snapshots.
+
+    void check_array(
+        const TypeLayoutSnapshot* type_layout,
+        size_t size,
+        TypeReflection::ScalarType scalar_type,
+        size_t element_count
+    );
+
+    void check_scalar(const TypeLayoutSnapshot* type_layout, size_t size, TypeReflection::ScalarType scalar_type);
+
+    void check_vector(
+        const TypeLayoutSnapshot* type_layout,
+        size_t size,
+        TypeReflection::ScalarType scalar_type,
+        int dimension
+    );
+
+    void check_matrix(
+        const TypeLayoutSnapshot* type_layout,
+        size_t size,
+        TypeReflection::ScalarType scalar_type,
+        int rows,
+        int cols
+    );
 } // namespace cursor_utils
 
 /// Dummy type to represent traits of an arbitrary value type usable by cursors
@@ -16,18 +16,22 @@
 #include "sgl/device/raytracing.h"
 #include "sgl/device/memory_heap.h"
 #include "sgl/device/command.h"
+#include "sgl/device/command_bundle.h"
 #include "sgl/device/helpers.h"
 #include "sgl/device/native_handle_traits.h"
 #include "sgl/device/agility_sdk.h"
 #include "sgl/device/cuda_utils.h"
 #include "sgl/device/cuda_interop.h"
 #include "sgl/device/print.h"
+#include "sgl/device/message_channel.h"
 #include "sgl/device/blit.h"
+#include "sgl/device/primitives.h"
 #include "sgl/device/hot_reload.h"
 
 #include "sgl/core/file_system_watcher.h"
 #include "sgl/core/config.h"
 #include "sgl/core/error.h"
+#include "sgl/core/metrics.h"
 #include "sgl/core/window.h"
 #include "sgl/core/string.h"
 
@@ -41,6 +45,8 @@
 #include <nvapi.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
 #include <mutex>
 
 namespace sgl {
@@ -50,6 +56,17 @@ static constexpr size_t TEXTURE_UPLOAD_ALIGNMENT = 512;
 static std::vector<Device*> s_devices;
 static std::mutex s_devices_mutex;
 
+static Counter& s_submit_counter
+    = MetricsRegistry::get().counter("sgl_command_buffer_submits_total", "Number of submitted command buffers.");
+static Counter& s_bytes_uploaded_counter
+    = MetricsRegistry::get().counter("sgl_bytes_uploaded_total", "Number of bytes uploaded to the device.");
+static Counter& s_bytes_read_back_counter
+    = MetricsRegistry::get().counter("sgl_bytes_read_back_total", "Number of bytes read back from the device.");
+static Counter& s_transient_heap_reset_counter = MetricsRegistry::get().counter(
+    "sgl_transient_heap_resets_total",
+    "Number of transient resource heap resets."
+);
+
 class DebugLogger : public gfx::IDebugCallback {
 public:
     DebugLogger()
@@ -413,6 +430,8 @@ Device::Device(const DeviceDesc& desc)
     );
     m_info.limits.max_shader_visible_samplers = gfx_device_info.limits.maxShaderVisibleSamplers;
 
+    init_memory_properties();
+
     // Get supported shader model.
     const std::vector<std::pair<ShaderModel, const char*>> available_shader_models = {
         {ShaderModel::sm_6_7, "sm_6_7"},
@@ -482,8 +501,10 @@ Device::Device(const DeviceDesc& desc)
          .debug_name = "default_read_back_heap"}
     );
 
+    if (m_desc.enable_print || m_desc.enable_message_channel)
+        m_message_channel = make_ref<MessageChannel>(this);
     if (m_desc.enable_print)
-        m_debug_printer = std::make_unique<DebugPrinter>(this);
+        m_debug_printer = std::make_unique<DebugPrinter>(m_message_channel);
 
     // Add device to global device list.
     {
@@ -505,6 +526,9 @@ Device::~Device()
     m_gfx_graphics_queue.setNull();
     m_gfx_device.setNull();
 
+    if (m_vulkan_library)
+        platform::release_shared_library(m_vulkan_library);
+
 #if SGL_HAS_NVAPI
     m_api_dispatcher.reset();
 #endif
@@ -553,10 +577,18 @@ void Device::close()
     // Make sure Device's ref count is not going to zero when releasing resources.
     inc_ref();
 
-    m_closed = true;
+    {
+        std::lock_guard lock(m_mutex);
+        m_closed = true;
+    }
 
     m_blitter.reset();
+    m_primitives.reset();
     m_debug_printer.reset();
+    if (m_message_channel) {
+        m_message_channel->close();
+        m_message_channel.reset();
+    }
 
     m_read_back_heap.reset();
     m_upload_heap.reset();
@@ -704,13 +736,22 @@ ref<ShaderProgram> Device::load_program(
     return m_slang_session->load_program(module_name, entry_point_names, additional_source, link_options);
 }
 
+ref<ShaderProgram> Device::load_program_from_archive(
+    ref<const ShaderArchive> archive,
+    std::string_view program_name,
+    std::optional<SlangLinkOptions> link_options
+)
+{
+    return m_slang_session->load_program_from_archive(std::move(archive), program_name, link_options);
+}
+
 ref<MutableShaderObject> Device::create_mutable_shader_object(const ShaderProgram* shader_program)
 {
     ref<MutableShaderObject> shader_object = make_ref<MutableShaderObject>(ref<Device>(this), shader_program);
 
-    // Bind the debug printer to the new shader object, if enabled.
-    if (m_debug_printer)
-        m_debug_printer->bind(shader_object.get());
+    // Bind the message channel to the new shader object, if enabled.
+    if (m_message_channel)
+        m_message_channel->bind(shader_object.get());
 
     return shader_object;
 }
@@ -746,6 +787,11 @@ ref<ComputeKernel> Device::create_compute_kernel(ComputeKernelDesc desc)
     return make_ref<ComputeKernel>(ref(this), std::move(desc));
 }
 
+ref<CommandBundle> Device::create_command_bundle()
+{
+    return make_ref<CommandBundle>(ref(this));
+}
+
 ref<CommandBuffer> Device::create_command_buffer()
 {
     SGL_ASSERT(m_shared_command_buffer == nullptr);
@@ -755,6 +801,7 @@ ref<CommandBuffer> Device::create_command_buffer()
 
 void Device::_set_open_command_buffer(CommandBuffer* command_buffer)
 {
+    std::lock_guard lock(m_mutex);
     SGL_CHECK(
         m_open_command_buffer == nullptr || command_buffer == nullptr,
         "Only one command buffer can be open at any time."
@@ -765,6 +812,7 @@ void Device::_set_open_command_buffer(CommandBuffer* command_buffer)
 
 Slang::ComPtr<gfx::ITransientResourceHeap> Device::_get_or_create_transient_resource_heap()
 {
+    std::lock_guard lock(m_mutex);
     if (m_current_transient_resource_heap)
         return m_current_transient_resource_heap;
 
@@ -804,25 +852,35 @@ void Device::_end_shared_command_buffer(bool wait)
 {
     SGL_ASSERT(m_open_command_buffer);
 
+    // Commands recorded into a command buffer opened by the user are only submitted if they are waited for.
+    if (m_shared_command_buffer || wait) {
+        uint64_t id = _submit_shared_command_buffer();
+        if (wait)
+            wait_command_buffer(id);
+    }
+}
+
+uint64_t Device::_submit_shared_command_buffer()
+{
+    SGL_ASSERT(m_open_command_buffer);
+
     uint64_t id = 0;
     if (m_shared_command_buffer) {
         m_shared_command_buffer->close();
         id = submit_command_buffer(m_shared_command_buffer);
         m_shared_command_buffer.reset();
     } else {
-        if (wait) {
-            CommandBuffer* command_buffer = m_open_command_buffer;
-            command_buffer->close();
-            id = submit_command_buffer(command_buffer);
-            command_buffer->open();
-        }
+        CommandBuffer* command_buffer = m_open_command_buffer;
+        command_buffer->close();
+        id = submit_command_buffer(command_buffer);
+        command_buffer->open();
     }
-    if (wait)
-        wait_command_buffer(id);
+    return id;
 }
 
 uint64_t Device::submit_command_buffer(CommandBuffer* command_buffer, CommandQueueType queue)
 {
+    std::lock_guard lock(m_mutex);
     SGL_CHECK_NOT_NULL(command_buffer);
     SGL_CHECK(queue == CommandQueueType::graphics, "Only graphics queue is supported.");
 
@@ -842,6 +900,7 @@ uint64_t Device::submit_command_buffer(CommandBuffer* command_buffer, CommandQue
     uint64_t fence_value = m_global_fence->update_signaled_value();
     m_gfx_graphics_queue
         ->executeCommandBuffer(command_buffer->gfx_command_buffer(), m_global_fence->gfx_fence(), fence_value);
+    s_submit_counter.add();
 
     if (m_supports_cuda_interop && command_buffer->m_cuda_interop_buffers.size() > 0) {
         sync_to_device(cuda_stream);
@@ -886,6 +945,7 @@ void Device::sync_to_device(void* cuda_stream)
 
 void Device::run_garbage_collection()
 {
+    std::lock_guard lock(m_mutex);
     uint64_t signaled_value = m_global_fence->signaled_value();
 
     // Finish current transient resource heap and push it to the in-flight queue.
@@ -908,6 +968,7 @@ void Device::run_garbage_collection()
             = m_in_flight_transient_resource_heaps.front().first;
         m_in_flight_transient_resource_heaps.pop();
         transient_resource_heap->synchronizeAndReset();
+        s_transient_heap_reset_counter.add();
         m_transient_resource_heap_pool.push(transient_resource_heap);
     }
 
@@ -942,8 +1003,78 @@ void Device::wait()
     run_garbage_collection();
 }
 
+BenchmarkResult Device::benchmark(std::function<void(CommandBuffer*)> encode, const BenchmarkDesc& desc)
+{
+    SGL_CHECK(encode, "'encode' must be set");
+    SGL_CHECK(desc.iterations > 0, "'iterations' must be greater than 0");
+    SGL_CHECK(desc.max_iterations >= desc.iterations, "'max_iterations' must be at least 'iterations'");
+
+    // Finish pending work so it does not overlap with the measurement.
+    wait();
+
+    auto run = [&](ref<CommandBuffer> command_buffer)
+    {
+        uint64_t id = command_buffer->submit();
+        wait_command_buffer(id);
+    };
+
+    // Warm up, timing the warm-up as a whole to estimate the duration of one iteration.
+    uint32_t dispatches_per_sample = 1;
+    if (desc.warmup_iterations > 0) {
+        ref<QueryPool> query_pool = create_query_pool({.type = QueryType::timestamp, .count = 2});
+        ref<CommandBuffer> command_buffer = create_command_buffer();
+        command_buffer->write_timestamp(query_pool, 0);
+        for (uint32_t i = 0; i < desc.warmup_iterations; ++i)
+            encode(command_buffer);
+        command_buffer->write_timestamp(query_pool, 1);
+        run(command_buffer);
+        std::vector<double> times = query_pool->get_timestamp_results(0, 2);
+        double estimate = (times[1] - times[0]) / desc.warmup_iterations;
+        if (estimate > 0.0 && estimate < desc.min_sample_time)
+            dispatches_per_sample = std::min(uint32_t(std::ceil(desc.min_sample_time / estimate)), 1024u);
+    }
+
+    std::vector<double> samples;
+    samples.reserve(desc.max_iterations);
+    while (true) {
+        uint32_t count = std::min(desc.iterations, desc.max_iterations - uint32_t(samples.size()));
+        ref<QueryPool> query_pool = create_query_pool({.type = QueryType::timestamp, .count = count * 2});
+        ref<CommandBuffer> command_buffer = create_command_buffer();
+        for (uint32_t i = 0; i < count; ++i) {
+            command_buffer->write_timestamp(query_pool, i * 2);
+            for (uint32_t j = 0; j < dispatches_per_sample; ++j)
+                encode(command_buffer);
+            command_buffer->write_timestamp(query_pool, i * 2 + 1);
+        }
+        run(command_buffer);
+
+        std::vector<double> times = query_pool->get_timestamp_results(0, count * 2);
+        for (uint32_t i = 0; i < count; ++i)
+            samples.push_back((times[i * 2 + 1] - times[i * 2]) / dispatches_per_sample);
+
+        BenchmarkResult result = BenchmarkResult::from_samples(samples, dispatches_per_sample, desc);
+        if (!result.noisy || samples.size() >= desc.max_iterations)
+            return result;
+    }
+}
+
+BenchmarkResult Device::benchmark_kernel(
+    ComputeKernel* kernel,
+    uint3 thread_count,
+    std::function<void(ShaderCursor)> bind_vars,
+    const BenchmarkDesc& desc
+)
+{
+    SGL_CHECK_NOT_NULL(kernel);
+    return benchmark(
+        [&](CommandBuffer* command_buffer) { kernel->dispatch(thread_count, bind_vars, command_buffer); },
+        desc
+    );
+}
+
 void Device::upload_buffer_data(Buffer* buffer, const void* data, size_t size, size_t offset)
 {
+    std::lock_guard lock(m_mutex);
     SGL_CHECK_NOT_NULL(buffer);
     SGL_CHECK(offset + size <= buffer->size(), "Buffer write is out of bounds");
     SGL_CHECK_NOT_NULL(data);
@@ -955,10 +1086,13 @@ void Device::upload_buffer_data(Buffer* buffer, const void* data, size_t size, s
     CommandBuffer* command_buffer = _begin_shared_command_buffer();
     command_buffer->copy_buffer_region(buffer, offset, alloc->buffer, alloc->offset, size);
     _end_shared_command_buffer(false);
+
+    s_bytes_uploaded_counter.add(size);
 }
 
 void Device::read_buffer_data(const Buffer* buffer, void* data, size_t size, size_t offset)
 {
+    std::lock_guard lock(m_mutex);
     SGL_CHECK_NOT_NULL(buffer);
     SGL_CHECK(offset + size <= buffer->size(), "Buffer read is out of bounds");
     SGL_CHECK_NOT_NULL(data);
@@ -970,10 +1104,13 @@ void Device::read_buffer_data(const Buffer* buffer, void* data, size_t size, siz
     _end_shared_command_buffer(true);
 
     std::memcpy(data, alloc->data, size);
+
+    s_bytes_read_back_counter.add(size);
 }
 
 void Device::upload_texture_data(Texture* texture, uint32_t subresource, SubresourceData subresource_data)
 {
+    std::lock_guard lock(m_mutex);
     SGL_CHECK_NOT_NULL(texture);
     SGL_CHECK_LT(subresource, texture->subresource_count());
 
@@ -989,8 +1126,34 @@ OwnedSubresourceData Device::read_texture_data(const Texture* texture, uint32_t
 
     SubresourceLayout layout = texture->get_subresource_layout(subresource);
 
-    size_t size = layout.total_size_aligned();
-    auto alloc = m_read_back_heap->allocate(size, TEXTURE_UPLOAD_ALIGNMENT);
+    OwnedSubresourceData subresource_data;
+    subresource_data.size = layout.total_size();
+    subresource_data.owned_data = std::make_unique<uint8_t[]>(subresource_data.size);
+    subresource_data.data = subresource_data.owned_data.get();
+    subresource_data.row_pitch = layout.row_pitch;
+    subresource_data.slice_pitch = layout.row_count * layout.row_pitch;
+
+    read_texture_data(texture, subresource, subresource_data.owned_data.get(), subresource_data.size);
+
+    return subresource_data;
+}
+
+void Device::read_texture_data(const Texture* texture, uint32_t subresource, void* data, size_t size)
+{
+    std::lock_guard lock(m_mutex);
+    SGL_CHECK_NOT_NULL(texture);
+    SGL_CHECK_LT(subresource, texture->subresource_count());
+    SGL_CHECK_NOT_NULL(data);
+
+    SubresourceLayout layout = texture->get_subresource_layout(subresource);
+    SGL_CHECK(
+        size == layout.total_size(),
+        "Size does not match subresource size ({} != {}).",
+        size,
+        layout.total_size()
+    );
+
+    auto alloc = m_read_back_heap->allocate(layout.total_size_aligned(), TEXTURE_UPLOAD_ALIGNMENT);
 
     CommandBuffer* command_buffer = _begin_shared_command_buffer();
     command_buffer->copy_texture_to_buffer(
@@ -1003,15 +1166,8 @@ OwnedSubresourceData Device::read_texture_data(const Texture* texture, uint32_t
     );
     _end_shared_command_buffer(true);
 
-    OwnedSubresourceData subresource_data;
-    subresource_data.size = layout.total_size();
-    subresource_data.owned_data = std::make_unique<uint8_t[]>(subresource_data.size);
-    subresource_data.data = subresource_data.owned_data.get();
-    subresource_data.row_pitch = layout.row_pitch;
-    subresource_data.slice_pitch = layout.row_count * layout.row_pitch;
-
     const uint8_t* src = alloc->data;
-    uint8_t* dst = subresource_data.owned_data.get();
+    uint8_t* dst = static_cast<uint8_t*>(data);
     for (uint32_t depth = 0; depth < layout.depth; ++depth) {
         for (uint32_t row = 0; row < layout.row_count; ++row) {
             std::memcpy(dst, src, layout.row_pitch);
@@ -1020,11 +1176,45 @@ OwnedSubresourceData Device::read_texture_data(const Texture* texture, uint32_t
         }
     }
 
-    return subresource_data;
+    s_bytes_read_back_counter.add(size);
+}
+
+uint64_t Device::read_texture_data_async(const Texture* texture, uint32_t subresource, Buffer* buffer)
+{
+    std::lock_guard lock(m_mutex);
+    SGL_CHECK_NOT_NULL(texture);
+    SGL_CHECK_LT(subresource, texture->subresource_count());
+    SGL_CHECK_NOT_NULL(buffer);
+    SGL_CHECK(buffer->memory_type() == MemoryType::read_back, "Buffer needs to be a read back buffer.");
+
+    SubresourceLayout layout = texture->get_subresource_layout(subresource);
+    SGL_CHECK(
+        buffer->size() >= layout.total_size_aligned(),
+        "Buffer is too small ({} < {}).",
+        buffer->size(),
+        layout.total_size_aligned()
+    );
+
+    CommandBuffer* command_buffer = _begin_shared_command_buffer();
+    command_buffer->copy_texture_to_buffer(
+        buffer,
+        0,
+        layout.total_size_aligned(),
+        layout.row_pitch_aligned,
+        texture,
+        subresource
+    );
+    uint64_t id = _submit_shared_command_buffer();
+
+    s_bytes_read_back_counter.add(layout.total_size());
+
+    return id;
 }
 
 void Device::deferred_release(ISlangUnknown* object)
 {
+    std::lock_guard lock(m_mutex);
+
     // Skip deferred release when device is already closed (or in the process of being closed).
     if (m_closed)
         return;
@@ -1041,15 +1231,15 @@ NativeHandle Device::get_native_handle(uint32_t index) const
     SLANG_CALL(m_gfx_device->getNativeDeviceHandles(&handles));
 
 #if SGL_HAS_D3D12
-    SGL_ASSERT(index == 0);
     if (type() == DeviceType::d3d12) {
+        SGL_ASSERT(index == 0);
         if (index == 0)
             return NativeHandle(reinterpret_cast<ID3D12Device*>(handles.handles[0].handleValue));
     }
 #endif
 #if SGL_HAS_VULKAN
-    SGL_ASSERT(index < 3);
     if (type() == DeviceType::vulkan) {
+        SGL_ASSERT(index < 3);
         if (index == 0)
             return NativeHandle(reinterpret_cast<VkInstance>(handles.handles[0].handleValue));
         else if (index == 1)
@@ -1061,6 +1251,90 @@ NativeHandle Device::get_native_handle(uint32_t index) const
     return {};
 }
 
+void Device::init_memory_properties()
+{
+#if SGL_HAS_VULKAN
+    // gfx allocates device local buffers from the first memory type with the DEVICE_LOCAL property.
+    // On integrated GPUs and software rasterizers that memory type is typically also host visible,
+    // which allows writing to device local buffers without going through a staging buffer.
+    // D3D12 always allocates device local buffers on the default heap, which cannot be mapped.
+    if (type() != DeviceType::vulkan)
+        return;
+
+#if SGL_WINDOWS
+    const char* vulkan_library_name = "vulkan-1.dll";
+#elif SGL_MACOS
+    const char* vulkan_library_name = "libvulkan.1.dylib";
+#else
+    const char* vulkan_library_name = "libvulkan.so.1";
+#endif
+    m_vulkan_library = platform::load_shared_library(vulkan_library_name);
+    if (!m_vulkan_library) {
+        log_debug("Failed to load Vulkan library, device local memory is treated as not host visible.");
+        return;
+    }
+
+    auto vk_get_instance_proc_addr = reinterpret_cast<PFN_vkGetInstanceProcAddr>(
+        platform::get_proc_address(m_vulkan_library, "vkGetInstanceProcAddr")
+    );
+    if (!vk_get_instance_proc_addr)
+        return;
+
+    VkInstance vk_instance = get_native_handle(0).as<VkInstance>();
+    VkPhysicalDevice vk_physical_device = get_native_handle(1).as<VkPhysicalDevice>();
+    auto vk_get_physical_device_memory_properties = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties>(
+        vk_get_instance_proc_addr(vk_instance, "vkGetPhysicalDeviceMemoryProperties")
+    );
+    m_vk_get_buffer_memory_requirements
+        = reinterpret_cast<void*>(vk_get_instance_proc_addr(vk_instance, "vkGetBufferMemoryRequirements"));
+    if (!vk_get_physical_device_memory_properties || !m_vk_get_buffer_memory_requirements)
+        return;
+
+    VkPhysicalDeviceMemoryProperties memory_properties{};
+    vk_get_physical_device_memory_properties(vk_physical_device, &memory_properties);
+    for (uint32_t i = 0; i < memory_properties.memoryTypeCount; ++i)
+        m_memory_type_flags.push_back(memory_properties.memoryTypes[i].propertyFlags);
+
+    // Report the memory type used for buffers that support all memory types.
+    const uint32_t required_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    for (uint32_t flags : m_memory_type_flags) {
+        if (flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
+            m_info.host_visible_device_local_memory = (flags & required_flags) == required_flags;
+            break;
+        }
+    }
+    log_debug("Host visible device local memory: {}", m_info.host_visible_device_local_memory);
+#endif
+}
+
+bool Device::_is_host_visible(const Buffer* buffer) const
+{
+    SGL_ASSERT(buffer);
+#if SGL_HAS_VULKAN
+    if (type() != DeviceType::vulkan || m_memory_type_flags.empty())
+        return false;
+
+    VkMemoryRequirements memory_requirements{};
+    reinterpret_cast<PFN_vkGetBufferMemoryRequirements>(m_vk_get_buffer_memory_requirements)(
+        get_native_handle(2).as<VkDevice>(),
+        buffer->get_native_handle().as<VkBuffer>(),
+        &memory_requirements
+    );
+
+    // Mirror the memory type selection in gfx (first supported type with the requested properties).
+    const uint32_t required_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    for (uint32_t i = 0; i < m_memory_type_flags.size(); ++i) {
+        if ((memory_requirements.memoryTypeBits & (1u << i)) == 0)
+            continue;
+        if (m_memory_type_flags[i] & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+            return (m_memory_type_flags[i] & required_flags) == required_flags;
+    }
+#else
+    SGL_UNUSED(buffer);
+#endif
+    return false;
+}
+
 NativeHandle Device::get_native_command_queue_handle(CommandQueueType queue) const
 {
     SGL_CHECK(queue == CommandQueueType::graphics, "Only graphics queue is supported.");
@@ -1198,6 +1472,13 @@ std::string Device::to_string() const
     );
 }
 
+Primitives* Device::primitives()
+{
+    if (!m_primitives)
+        m_primitives = ref(new Primitives(this));
+    return m_primitives;
+}
+
 Blitter* Device::_blitter()
 {
     if (!m_blitter)
@@ -4,6 +4,7 @@
 
 #include "sgl/device/fwd.h"
 #include "sgl/device/types.h"
+#include "sgl/device/benchmark.h"
 #include "sgl/device/native_handle.h"
 #include "sgl/device/resource.h"
 #include "sgl/device/shader.h"
@@ -20,6 +21,8 @@
 
 #include <array>
 #include <filesystem>
+#include <functional>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -95,6 +98,10 @@ struct DeviceDesc {
     /// Enable device side printing (adds performance overhead).
     bool enable_print{false};
 
+    /// Enable the device to host message channel (see \c MessageChannel).
+    /// The channel is always enabled if printing is enabled.
+    bool enable_message_channel{false};
+
     /// Enable automatic shader reload in response to file changes.
     /// Note: Currently windows and linux only.
     bool enable_hot_reload{true};
@@ -161,6 +168,9 @@ struct DeviceInfo {
     /// The frequency of the timestamp counter.
     /// To resolve a timestamp to seconds, divide by this value.
     uint64_t timestamp_frequency;
+    /// True if device local memory is host visible (integrated GPUs, software rasterizers).
+    /// Device local buffers can then be mapped and written without staging (see \c Buffer::is_host_visible).
+    bool host_visible_device_local_memory{false};
     /// Limits of the device.
     DeviceLimits limits;
 };
@@ -386,6 +396,23 @@ public:
         std::optional<SlangLinkOptions> link_options = {}
     );
 
+    /**
+     * \brief Load a program from a shader archive.
+     *
+     * The program is loaded without compiling any shader source, but it is still linked and target code
+     * is generated when a pipeline is created (see \ref ShaderArchive for details).
+     *
+     * \param archive Shader archive (built with \c ShaderArchive::build or the \c sgl_shader_archive tool).
+     * \param program_name Name of the program in the archive.
+     * \param link_options Optional link options.
+     * \return New program object.
+     */
+    ref<ShaderProgram> load_program_from_archive(
+        ref<const ShaderArchive> archive,
+        std::string_view program_name,
+        std::optional<SlangLinkOptions> link_options = {}
+    );
+
     void reload_all_programs();
 
     ref<MutableShaderObject> create_mutable_shader_object(const ShaderProgram* shader_program);
@@ -404,11 +431,14 @@ public:
 
     ref<CommandBuffer> create_command_buffer();
 
+    ref<CommandBundle> create_command_bundle();
+
     void _set_open_command_buffer(CommandBuffer* command_buffer);
     Slang::ComPtr<gfx::ITransientResourceHeap> _get_or_create_transient_resource_heap();
 
     CommandBuffer* _begin_shared_command_buffer();
     void _end_shared_command_buffer(bool wait);
+    uint64_t _submit_shared_command_buffer();
 
     /**
      * \brief Submit a command buffer to the device.
@@ -475,6 +505,12 @@ public:
 
     DebugPrinter* debug_printer() const { return m_debug_printer.get(); }
 
+    /// Device to host message channel (nullptr if not enabled, see \c DeviceDesc::enable_message_channel).
+    MessageChannel* message_channel() const { return m_message_channel; }
+
+    /// Parallel primitives (reduction, prefix sum, histogram, compaction and sort) operating on buffers.
+    Primitives* primitives();
+
     /// Block and flush all shader side debug print output.
     void flush_print();
 
@@ -484,6 +520,36 @@ public:
     /// Wait for all device work to complete.
     void wait();
 
+    /**
+     * \brief Benchmark GPU work using timestamp queries.
+     *
+     * Runs \c BenchmarkDesc::warmup_iterations untimed iterations, then records timed samples
+     * in rounds of \c BenchmarkDesc::iterations until the measurement is not noisy or
+     * \c BenchmarkDesc::max_iterations samples have been taken. Work that is shorter than
+     * \c BenchmarkDesc::min_sample_time is repeated within each sample.
+     *
+     * \param encode Callback recording one iteration of the work into a command buffer.
+     * \param desc Benchmark description.
+     * \return Benchmark result.
+     */
+    BenchmarkResult benchmark(std::function<void(CommandBuffer*)> encode, const BenchmarkDesc& desc = {});
+
+    /**
+     * \brief Benchmark a compute kernel dispatch.
+     *
+     * \param kernel Compute kernel.
+     * \param thread_count Number of threads to dispatch.
+     * \param bind_vars Callback binding the kernel variables.
+     * \param desc Benchmark description.
+     * \return Benchmark result.
+     */
+    BenchmarkResult benchmark_kernel(
+        ComputeKernel* kernel,
+        uint3 thread_count,
+        std::function<void(ShaderCursor)> bind_vars,
+        const BenchmarkDesc& desc = {}
+    );
+
     /**
      * Upload host memory to buffer.
      *
@@ -524,6 +590,30 @@ public:
      */
     OwnedSubresourceData read_texture_data(const Texture* texture, uint32_t subresource);
 
+    /**
+     * Read texture data to caller provided host memory.
+     * Rows are tightly packed (row pitch of \c SubresourceLayout::row_pitch).
+     * \note This will wait until the data is copied back to host memory.
+     *
+     * \param texture Texture to read from.
+     * \param subresource Subresource index.
+     * \param data Pointer to host memory to write to.
+     * \param size Size of host memory in bytes (needs to match \c SubresourceLayout::total_size()).
+     */
+    void read_texture_data(const Texture* texture, uint32_t subresource, void* data, size_t size);
+
+    /**
+     * Copy texture data to a read back buffer without waiting for the copy to complete.
+     * Rows are written with a row pitch of \c SubresourceLayout::row_pitch_aligned.
+     * The buffer can be mapped once the returned submission has completed (see \c wait_command_buffer).
+     *
+     * \param texture Texture to read from.
+     * \param subresource Subresource index.
+     * \param buffer Read back buffer to copy to (needs to hold \c SubresourceLayout::total_size_aligned() bytes).
+     * \return Submission ID.
+     */
+    uint64_t read_texture_data_async(const Texture* texture, uint32_t subresource, Buffer* buffer);
+
     void deferred_release(ISlangUnknown* object);
 
     gfx::IDevice* gfx_device() const { return m_gfx_device; }
@@ -570,7 +660,12 @@ public:
     Blitter* _blitter();
     HotReload* _hot_reload() { return m_hot_reload; }
 
+    /// Check if the memory backing a device local buffer is host visible and coherent.
+    bool _is_host_visible(const Buffer* buffer) const;
+
 private:
+    void init_memory_properties();
+
     DeviceDesc m_desc;
     DeviceInfo m_info;
     ShaderModel m_supported_shader_model{ShaderModel::unknown};
@@ -593,10 +688,23 @@ private:
     ref<MemoryHeap> m_upload_heap;
     ref<MemoryHeap> m_read_back_heap;
 
+    /// Vulkan loader and entry points used to query memory types (gfx does not expose them).
+    SharedLibraryHandle m_vulkan_library{nullptr};
+    void* m_vk_get_buffer_memory_requirements{nullptr};
+    /// Property flags of the device memory types (Vulkan only).
+    std::vector<uint32_t> m_memory_type_flags;
+
+    ref<MessageChannel> m_message_channel;
     std::unique_ptr<DebugPrinter> m_debug_printer;
 
+    /// Mutex protecting the open command buffer, transient resource heaps, the deferred
+    /// release queue and \c m_closed, which may be accessed from multiple threads.
+    std::recursive_mutex m_mutex;
+
     /// Currently open command buffer.
-    /// Due to limitations in gfx, only one command buffer can be open at a time.
+    /// Due to limitations in gfx, only one command buffer can be open at a time. Recording into
+    /// it (including the shared command buffer used by kernel dispatches and data transfers)
+    /// is single-threaded, callers on different threads must serialize recording themselves.
     CommandBuffer* m_open_command_buffer{nullptr};
     ref<CommandBuffer> m_shared_command_buffer;
 
@@ -623,6 +731,7 @@ private:
 #endif
 
     ref<Blitter> m_blitter;
+    ref<Primitives> m_primitives;
     ref<HotReload> m_hot_reload;
 
     bool m_supports_cuda_interop{false};
@@ -63,8 +63,19 @@ class SlangEntryPoint;
 
 class ShaderProgram;
 
+// shader_archive.h
+
+struct ShaderArchiveProgramDesc;
+class ShaderArchive;
+
+// reflection_snapshot.h
+
+class TypeLayoutSnapshot;
+class ReflectionSnapshot;
+
 // reflection.h
 
+class BaseReflectionObject;
 class DeclReflection;
 class DeclReflectionChildList;
 class DeclReflectionIndexedChildList;
@@ -118,6 +129,10 @@ class ComputeCommandEncoder;
 class RenderCommandEncoder;
 class RayTracingCommandEncoder;
 
+// command_bundle.h
+
+class CommandBundle;
+
 // shader_cursor.h
 
 class ShaderCursor;
@@ -139,6 +154,15 @@ class MemoryHeap;
 
 class Blitter;
 
+// primitives.h
+
+class Primitives;
+
+// message_channel.h
+
+struct MessageChannelDesc;
+class MessageChannel;
+
 // texture_loader.h
 
 class TextureLoader;
@@ -129,8 +129,10 @@ std::string MemoryHeap::to_string() const
 
 void MemoryHeap::release(AllocationData* allocation)
 {
+    // Allocations may be used by the device for many frames after they were created,
+    // so the release has to wait for all work submitted until now.
     m_deferred_releases.push_back(DeferredRelease{
-        .fence_value = allocation->fence_value,
+        .fence_value = m_fence->signaled_value(),
         .page_id = allocation->page_id,
         .size = allocation->size,
     });
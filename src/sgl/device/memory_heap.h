@@ -33,11 +33,11 @@ struct MemoryHeapDesc {
  * If the allocation does not fit, a new page is allocated.
  * For allocations larger than the configured page size, a new large page is allocated.
  *
- * The memory heap is tied to a fence. Each allocation records the currently signaled fence
- * value when it is created. On release, the allocation is put on a deferred release queue.
- * Only if the fence value of the memory heap is greater than the fence value of the allocation,
- * the allocation is actually freed. This ensures that memory is not freed while still in use
- * by the device.
+ * The memory heap is tied to a fence. On release, the allocation is put on a deferred release
+ * queue together with the currently signaled fence value. Only if the fence value of the memory
+ * heap is greater than the recorded fence value, the allocation is actually freed. This ensures
+ * that memory is not freed while still in use by the device, even if the allocation was used
+ * for many frames.
  *
  * Allocations are returned as unique pointers. When the pointer is destroyed, the allocation
  * is released. This ensures that the memory is freed when it is no longer used.
@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "message_channel.h"
+
+#include "sgl/device/device.h"
+#include "sgl/device/resource.h"
+#include "sgl/device/command.h"
+
+#include "sgl/core/format.h"
+#include "sgl/core/logger.h"
+#include "sgl/core/platform.h"
+
+#include "sgl/math/vector.h"
+
+#include <bit>
+#include <chrono>
+#include <cstring>
+
+namespace sgl {
+
+static constexpr uint32_t WRITE_INDEX_OFFSET = 0;
+static constexpr uint32_t DROPPED_COUNT_OFFSET = 4;
+static constexpr uint32_t READ_INDEX_OFFSET = 8;
+
+/// Read a value written by the device to host visible memory.
+static uint32_t load_acquire(const uint8_t* ptr)
+{
+    uint32_t value = *reinterpret_cast<const volatile uint32_t*>(ptr);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return value;
+}
+
+/// Write a value read by the device from host visible memory.
+static void store_release(uint8_t* ptr, uint32_t value)
+{
+    std::atomic_thread_fence(std::memory_order_release);
+    *reinterpret_cast<volatile uint32_t*>(ptr) = value;
+}
+
+MessageChannel::MessageChannel(Device* device, MessageChannelDesc desc)
+    : m_device(device)
+    , m_desc(std::move(desc))
+{
+    SGL_ASSERT(m_device);
+    SGL_CHECK(
+        m_desc.capacity >= MAX_MESSAGE_SIZE && m_desc.capacity <= (size_t(1) << 31),
+        "Message channel capacity must be in [{}, 2^31] bytes.",
+        MAX_MESSAGE_SIZE
+    );
+    m_capacity = std::bit_ceil(uint32_t(m_desc.capacity));
+
+    // Messages starting close to the end of the ring extend into the slack area.
+    m_buffer = m_device->create_buffer({
+        .size = HEADER_SIZE + m_capacity + MAX_MESSAGE_SIZE,
+        .usage = ResourceUsage::unordered_access,
+        .debug_name = "message_channel_buffer",
+    });
+
+    if (m_buffer->is_host_visible()) {
+        m_mapped = m_buffer->map<uint8_t>();
+        std::memset(m_mapped, 0, m_buffer->size());
+    } else {
+        m_readback_buffer = m_device->create_buffer({
+            .size = m_buffer->size(),
+            .usage = ResourceUsage::none,
+            .memory_type = MemoryType::read_back,
+            .debug_name = "message_channel_readback_buffer",
+        });
+        m_read_index_buffer = m_device->create_buffer({
+            .size = 4,
+            .usage = ResourceUsage::none,
+            .memory_type = MemoryType::upload,
+            .debug_name = "message_channel_read_index_buffer",
+        });
+        CommandBuffer* command_buffer = m_device->_begin_shared_command_buffer();
+        command_buffer->clear_resource_view(m_buffer->get_uav(), uint4(0));
+        m_device->_end_shared_command_buffer(false);
+    }
+
+    if (m_mapped && m_desc.background_polling)
+        m_thread = std::thread(&MessageChannel::thread_func, this);
+}
+
+MessageChannel::~MessageChannel()
+{
+    close();
+}
+
+void MessageChannel::set_handler(uint32_t id, Handler handler)
+{
+    std::lock_guard lock(m_mutex);
+    m_handlers[id] = std::move(handler);
+}
+
+void MessageChannel::remove_handler(uint32_t id)
+{
+    std::lock_guard lock(m_mutex);
+    m_handlers.erase(id);
+}
+
+size_t MessageChannel::poll()
+{
+    std::lock_guard lock(m_mutex);
+    if (!m_buffer)
+        return 0;
+    return m_mapped ? poll_mapped() : poll_staged();
+}
+
+size_t MessageChannel::flush()
+{
+    // Submit and wait for all pending work, including the shared command buffer.
+    m_device->_begin_shared_command_buffer();
+    m_device->_end_shared_command_buffer(true);
+    return poll();
+}
+
+void MessageChannel::bind(ShaderCursor cursor)
+{
+    if (cursor.is_valid())
+        cursor = cursor.find_field("g_message_channel");
+    if (cursor.is_valid())
+        cursor["buffer"] = m_buffer;
+}
+
+void MessageChannel::close()
+{
+    if (m_thread.joinable()) {
+        {
+            std::lock_guard lock(m_thread_mutex);
+            m_stop = true;
+        }
+        m_thread_cv.notify_all();
+        m_thread.join();
+    }
+
+    std::lock_guard lock(m_mutex);
+    if (m_mapped) {
+        m_buffer->unmap();
+        m_mapped = nullptr;
+    }
+    m_buffer = nullptr;
+    m_readback_buffer = nullptr;
+    m_read_index_buffer = nullptr;
+    m_handlers.clear();
+}
+
+std::string MessageChannel::to_string() const
+{
+    return fmt::format(
+        "MessageChannel(\n"
+        "  device = {},\n"
+        "  capacity = {},\n"
+        "  is_host_visible = {},\n"
+        "  is_background_polling = {},\n"
+        "  dropped_count = {}\n"
+        ")",
+        m_device,
+        m_capacity,
+        is_host_visible(),
+        is_background_polling(),
+        dropped_count()
+    );
+}
+
+size_t MessageChannel::poll_mapped()
+{
+    uint32_t write_index = load_acquire(m_mapped + WRITE_INDEX_OFFSET);
+    size_t count = consume(m_mapped + HEADER_SIZE, write_index, true);
+    store_release(m_mapped + READ_INDEX_OFFSET, m_read_index);
+    update_dropped_count(load_acquire(m_mapped + DROPPED_COUNT_OFFSET));
+    return count;
+}
+
+size_t MessageChannel::poll_staged()
+{
+    CommandBuffer* command_buffer = m_device->_begin_shared_command_buffer();
+    command_buffer->copy_resource(m_readback_buffer, m_buffer);
+    m_device->_end_shared_command_buffer(true);
+
+    uint8_t* data = m_readback_buffer->map<uint8_t>();
+    // All messages in the copy are complete, the copy runs after the work that wrote them.
+    uint32_t write_index = *reinterpret_cast<const uint32_t*>(data + WRITE_INDEX_OFFSET);
+    size_t count = consume(data + HEADER_SIZE, write_index, false);
+    update_dropped_count(*reinterpret_cast<const uint32_t*>(data + DROPPED_COUNT_OFFSET));
+    m_readback_buffer->unmap();
+
+    // Publish the read index to free up space for the device.
+    *m_read_index_buffer->map<uint32_t>() = m_read_index;
+    m_read_index_buffer->unmap();
+    command_buffer = m_device->_begin_shared_command_buffer();
+    command_buffer->copy_buffer_region(m_buffer, READ_INDEX_OFFSET, m_read_index_buffer, 0, 4);
+    m_device->_end_shared_command_buffer(false);
+
+    return count;
+}
+
+size_t MessageChannel::consume(uint8_t* data, uint32_t write_index, bool clear)
+{
+    size_t count = 0;
+    while (m_read_index != write_index) {
+        uint32_t offset = m_read_index & (m_capacity - 1);
+        uint32_t size = load_acquire(data + offset);
+        // Message is reserved but not committed yet.
+        if (size == 0)
+            break;
+        if (size < MESSAGE_HEADER_SIZE || size > MAX_MESSAGE_SIZE || size % 4 != 0
+            || write_index - m_read_index < size) {
+            log_error("Message channel is corrupted (invalid message size {}), skipping pending messages.", size);
+            m_read_index = write_index;
+            break;
+        }
+
+        uint32_t id = *reinterpret_cast<const uint32_t*>(data + offset + 4);
+        if (auto it = m_handlers.find(id); it != m_handlers.end() && it->second) {
+            try {
+                it->second(std::span<const uint8_t>(data + offset + MESSAGE_HEADER_SIZE, size - MESSAGE_HEADER_SIZE));
+            } catch (const std::exception& e) {
+                log_error("Message channel handler for id {} failed: {}", id, e.what());
+            }
+        }
+
+        // Clear the message so the space reads as uncommitted when it is reused.
+        if (clear)
+            std::memset(data + offset, 0, size);
+        m_read_index += size;
+        ++count;
+    }
+    return count;
+}
+
+void MessageChannel::update_dropped_count(uint32_t dropped)
+{
+    uint32_t delta = dropped - m_last_dropped;
+    if (delta == 0)
+        return;
+    m_last_dropped = dropped;
+    m_dropped_count += delta;
+    log_warn("Message channel overflow, dropped {} messages!", delta);
+}
+
+void MessageChannel::thread_func()
+{
+    platform::set_thread_name("sgl-message-channel");
+
+    std::unique_lock lock(m_thread_mutex);
+    while (!m_stop) {
+        lock.unlock();
+        poll();
+        lock.lock();
+        m_thread_cv.wait_for(lock, std::chrono::milliseconds(m_desc.poll_interval_ms), [this] { return m_stop; });
+    }
+}
+
+} // namespace sgl
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sgl/device/fwd.h"
+#include "sgl/device/shader_cursor.h"
+
+#include "sgl/core/object.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <span>
+#include <thread>
+
+namespace sgl {
+
+struct MessageChannelDesc {
+    /// Capacity of the ring buffer in bytes (rounded up to a power of two).
+    size_t capacity{4 * 1024 * 1024};
+
+    /// Poll the channel from a background thread.
+    /// Only used if the ring buffer is host visible (see \c MessageChannel::is_host_visible).
+    bool background_polling{true};
+
+    /// Interval between polls of the background thread in milliseconds.
+    uint32_t poll_interval_ms{1};
+};
+
+/**
+ * \brief GPU to CPU message channel.
+ *
+ * Shaders send messages (see \c message_channel.slang) into a ring buffer in device memory.
+ * Every message is tagged with a 32-bit id and carries an arbitrary payload of up to
+ * \c MAX_MESSAGE_SIZE bytes. Messages are dispatched to the handler registered for their id.
+ *
+ * Ring buffer layout:
+ * - [0] write index (reserved bytes, advanced by the device with atomics)
+ * - [4] number of dropped messages
+ * - [8] read index (consumed bytes, written by the host)
+ * - [16] message data
+ *
+ * Each message starts with its size in bytes followed by its id. The size is written last,
+ * committing the message. Messages are written contiguously and may extend past the end of the ring
+ * into a slack area, so the device never has to split them. If the ring is full, messages are dropped
+ * and counted instead of overwriting unread data.
+ *
+ * If the ring buffer memory is host visible (see \c DeviceInfo::host_visible_device_local_memory),
+ * the host reads the messages and publishes the read index directly, from a background thread,
+ * without synchronizing with the device. Messages of a running kernel become visible as soon as
+ * the device makes its writes available to the host, at the latest when the kernel completes.
+ * Otherwise \c poll() copies the ring to a read back buffer and waits for the copy.
+ *
+ * Handlers are called from the polling thread. Ids starting at \c RESERVED_ID_BASE are used internally
+ * (e.g. by shader debug printing).
+ */
+class SGL_API MessageChannel : public Object {
+    SGL_OBJECT(MessageChannel)
+public:
+    using Handler = std::function<void(std::span<const uint8_t> payload)>;
+
+    /// Size of the ring buffer header in bytes.
+    static constexpr uint32_t HEADER_SIZE = 16;
+    /// Size of the message header (size and id) in bytes.
+    static constexpr uint32_t MESSAGE_HEADER_SIZE = 8;
+    /// Maximum size of a message in bytes, including the message header.
+    static constexpr uint32_t MAX_MESSAGE_SIZE = 16384;
+    /// First id reserved for internal use.
+    static constexpr uint32_t RESERVED_ID_BASE = 0xffff0000;
+    /// Id of shader debug print messages.
+    static constexpr uint32_t PRINT_ID = RESERVED_ID_BASE;
+
+    MessageChannel(Device* device, MessageChannelDesc desc = {});
+    ~MessageChannel();
+
+    const MessageChannelDesc& desc() const { return m_desc; }
+
+    /// Ring buffer capacity in bytes.
+    uint32_t capacity() const { return m_capacity; }
+
+    /// The ring buffer.
+    Buffer* buffer() const { return m_buffer; }
+
+    /// True if the ring buffer is host visible and read without copies.
+    bool is_host_visible() const { return m_mapped != nullptr; }
+
+    /// True if a background thread is polling the channel.
+    bool is_background_polling() const { return m_thread.joinable(); }
+
+    /// Set the handler for messages with the given id (replaces an existing handler).
+    /// Handlers must not call back into the channel.
+    void set_handler(uint32_t id, Handler handler);
+
+    /// Remove the handler for messages with the given id.
+    void remove_handler(uint32_t id);
+
+    /**
+     * \brief Dispatch all committed messages to their handlers.
+     *
+     * Messages without a handler are discarded.
+     *
+     * \return Number of dispatched messages.
+     */
+    size_t poll();
+
+    /// Wait for all submitted device work and dispatch all messages.
+    size_t flush();
+
+    /// Total number of messages dropped because the ring was full.
+    uint64_t dropped_count() const { return m_dropped_count; }
+
+    /// Bind the channel to a shader object (sets \c g_message_channel if present).
+    void bind(ShaderCursor cursor);
+
+    /// Stop polling and release the device resources.
+    /// Called when the device is closed.
+    void close();
+
+    std::string to_string() const override;
+
+private:
+    size_t poll_mapped();
+    size_t poll_staged();
+    size_t consume(uint8_t* data, uint32_t write_index, bool clear);
+    void update_dropped_count(uint32_t dropped);
+    void thread_func();
+
+    Device* m_device;
+    MessageChannelDesc m_desc;
+    uint32_t m_capacity;
+
+    ref<Buffer> m_buffer;
+    /// Persistently mapped ring buffer (if host visible).
+    uint8_t* m_mapped{nullptr};
+    /// Staging buffers (if not host visible).
+    ref<Buffer> m_readback_buffer;
+    ref<Buffer> m_read_index_buffer;
+
+    /// Protects the handlers and the consumer state.
+    std::mutex m_mutex;
+    std::map<uint32_t, Handler> m_handlers;
+    uint32_t m_read_index{0};
+    uint32_t m_last_dropped{0};
+    std::atomic<uint64_t> m_dropped_count{0};
+
+    std::thread m_thread;
+    std::mutex m_thread_mutex;
+    std::condition_variable m_thread_cv;
+    bool m_stop{false};
+};
+
+} // namespace sgl
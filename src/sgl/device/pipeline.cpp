@@ -10,6 +10,7 @@
 #include "sgl/device/native_handle_traits.h"
 
 #include "sgl/core/config.h"
+#include "sgl/core/metrics.h"
 #include "sgl/core/short_vector.h"
 #include "sgl/core/type_utils.h"
 
@@ -18,6 +19,9 @@
 
 namespace sgl {
 
+static Counter& s_pipeline_creation_counter
+    = MetricsRegistry::get().counter("sgl_pipeline_creations_total", "Number of created pipeline states.");
+
 // ----------------------------------------------------------------------------
 // Pipeline
 // ----------------------------------------------------------------------------
@@ -73,6 +77,7 @@ void ComputePipeline::recreate()
 {
     gfx::ComputePipelineStateDesc gfx_desc{.program = m_desc.program->gfx_shader_program()};
     SLANG_CALL(m_device->gfx_device()->createComputePipelineState(gfx_desc, m_gfx_pipeline_state.writeRef()));
+    s_pipeline_creation_counter.add();
     m_thread_group_size = m_desc.program->layout()->get_entry_point_by_index(0)->compute_thread_group_size();
 }
 
@@ -177,6 +182,7 @@ void GraphicsPipeline::recreate()
     }
 
     SLANG_CALL(m_device->gfx_device()->createGraphicsPipelineState(gfx_desc, m_gfx_pipeline_state.writeRef()));
+    s_pipeline_creation_counter.add();
 }
 
 std::string GraphicsPipeline::to_string() const
@@ -227,6 +233,7 @@ void RayTracingPipeline::recreate()
         .flags = static_cast<gfx::RayTracingPipelineFlags::Enum>(desc.flags),
     };
     SLANG_CALL(m_device->gfx_device()->createRayTracingPipelineState(gfx_desc, m_gfx_pipeline_state.writeRef()));
+    s_pipeline_creation_counter.add();
 }
 
 std::string RayTracingPipeline::to_string() const
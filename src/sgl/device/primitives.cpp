@@ -0,0 +1,462 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "primitives.h"
+
+#include "sgl/device/device.h"
+#include "sgl/device/resource.h"
+#include "sgl/device/shader.h"
+#include "sgl/device/kernel.h"
+#include "sgl/device/command.h"
+#include "sgl/device/shader_cursor.h"
+
+#include "sgl/core/format.h"
+#include "sgl/core/maths.h"
+
+#include "sgl/math/vector.h"
+
+namespace sgl {
+
+/// Threads per group of all primitives kernels (TILE_SIZE / ITEMS_PER_THREAD in primitives.slang).
+static constexpr uint32_t GROUP_SIZE = 256;
+static constexpr uint32_t RADIX_SIZE = 1 << Primitives::RADIX_BITS;
+/// Maximum number of thread groups per dispatch.
+static constexpr uint32_t MAX_TILE_COUNT = 65535;
+
+static uint32_t element_size(TypeReflection::ScalarType scalar_type, uint32_t component_count)
+{
+    SGL_UNUSED(scalar_type);
+    return 4 * component_count;
+}
+
+static void check_element_type(TypeReflection::ScalarType scalar_type, uint32_t component_count)
+{
+    SGL_CHECK(
+        scalar_type == TypeReflection::ScalarType::int32 || scalar_type == TypeReflection::ScalarType::uint32
+            || scalar_type == TypeReflection::ScalarType::float32,
+        "Unsupported scalar type \"{}\" (expected int32, uint32 or float32).",
+        scalar_type
+    );
+    SGL_CHECK(component_count >= 1 && component_count <= 4, "Component count must be in [1, 4].");
+}
+
+static uint32_t tile_count(uint32_t element_count)
+{
+    uint32_t count = div_round_up(element_count, Primitives::TILE_SIZE);
+    SGL_CHECK(
+        count <= MAX_TILE_COUNT,
+        "Element count {} exceeds the maximum of {}.",
+        element_count,
+        uint64_t(MAX_TILE_COUNT) * Primitives::TILE_SIZE
+    );
+    return count;
+}
+
+static void check_buffer_size(const Buffer* buffer, uint64_t size, std::string_view name)
+{
+    SGL_CHECK(buffer->size() >= size, "Buffer \"{}\" is too small ({} < {} bytes).", name, buffer->size(), size);
+}
+
+Primitives::Primitives(Device* device)
+    : m_device(device)
+{
+}
+
+Primitives::~Primitives() { }
+
+void Primitives::reduce(
+    CommandBuffer* command_buffer,
+    ReduceOp op,
+    const Buffer* src,
+    Buffer* dst,
+    uint32_t element_count,
+    ScalarType scalar_type,
+    uint32_t component_count
+)
+{
+    SGL_CHECK_NOT_NULL(command_buffer);
+    SGL_CHECK_NOT_NULL(src);
+    SGL_CHECK_NOT_NULL(dst);
+    SGL_CHECK(element_count > 0, "Cannot reduce an empty buffer.");
+    check_element_type(scalar_type, component_count);
+
+    uint32_t size = element_size(scalar_type, component_count);
+    check_buffer_size(src, uint64_t(element_count) * size, "src");
+    check_buffer_size(dst, size, "dst");
+
+    ComputeKernel* kernel = get_kernel("reduce", scalar_type, component_count, op);
+
+    // Every pass reduces tiles to single elements until one element is left.
+    ref<Buffer> pass_src = ref(const_cast<Buffer*>(src));
+    uint32_t count = element_count;
+    bool ping = true;
+    while (true) {
+        uint32_t groups = tile_count(count);
+        ref<Buffer> pass_dst
+            = groups == 1 ? ref(dst) : ref(get_scratch(ping ? Scratch::reduce_a : Scratch::reduce_b, groups * size));
+        kernel->dispatch(
+            uint3(groups * GROUP_SIZE, 1, 1),
+            [&](ShaderCursor cursor)
+            {
+                cursor["src"] = pass_src;
+                cursor["dst"] = pass_dst;
+                cursor["count"] = count;
+            },
+            command_buffer
+        );
+        command_buffer->uav_barrier(pass_dst);
+        if (groups == 1)
+            break;
+        pass_src = pass_dst;
+        count = groups;
+        ping = !ping;
+    }
+}
+
+void Primitives::scan(
+    CommandBuffer* command_buffer,
+    const Buffer* src,
+    Buffer* dst,
+    uint32_t element_count,
+    ScalarType scalar_type,
+    uint32_t component_count,
+    bool inclusive
+)
+{
+    SGL_CHECK_NOT_NULL(command_buffer);
+    SGL_CHECK_NOT_NULL(src);
+    SGL_CHECK_NOT_NULL(dst);
+    SGL_CHECK(src != dst, "Source and destination must be different buffers.");
+    check_element_type(scalar_type, component_count);
+
+    uint32_t size = element_size(scalar_type, component_count);
+    check_buffer_size(src, uint64_t(element_count) * size, "src");
+    check_buffer_size(dst, uint64_t(element_count) * size, "dst");
+    if (element_count == 0)
+        return;
+
+    uint32_t tiles = tile_count(element_count);
+    uint64_t state_size = (uint64_t(tiles) + 1) * sizeof(uint32_t);
+    Buffer* state = get_scratch(Scratch::scan_state, state_size);
+    Buffer* values = get_scratch(Scratch::scan_values, uint64_t(tiles) * 2 * size);
+
+    // The tile counter and flags need to be reset for every scan.
+    command_buffer->clear_resource_view(state->get_uav({.offset = 0, .size = state_size}), uint4(0));
+    command_buffer->uav_barrier(state);
+
+    get_kernel("scan", scalar_type, component_count)
+        ->dispatch(
+            uint3(tiles * GROUP_SIZE, 1, 1),
+            [&](ShaderCursor cursor)
+            {
+                cursor["g_scan_state"] = ref(state);
+                cursor["g_scan_values"] = ref(values);
+                cursor["src"] = ref(const_cast<Buffer*>(src));
+                cursor["dst"] = ref(dst);
+                cursor["count"] = element_count;
+                cursor["tile_count"] = tiles;
+                cursor["inclusive"] = inclusive ? 1u : 0u;
+            },
+            command_buffer
+        );
+    command_buffer->uav_barrier(dst);
+}
+
+void Primitives::histogram(
+    CommandBuffer* command_buffer,
+    const Buffer* keys,
+    Buffer* bins,
+    uint32_t element_count,
+    uint32_t bin_count
+)
+{
+    SGL_CHECK_NOT_NULL(command_buffer);
+    SGL_CHECK_NOT_NULL(keys);
+    SGL_CHECK_NOT_NULL(bins);
+    SGL_CHECK(bin_count > 0, "Bin count must be at least 1.");
+    check_buffer_size(keys, uint64_t(element_count) * sizeof(uint32_t), "keys");
+    check_buffer_size(bins, uint64_t(bin_count) * sizeof(uint32_t), "bins");
+
+    command_buffer->clear_resource_view(bins->get_uav({.offset = 0, .size = bin_count * sizeof(uint32_t)}), uint4(0));
+    command_buffer->uav_barrier(bins);
+    if (element_count == 0)
+        return;
+
+    get_kernel("histogram")
+        ->dispatch(
+            uint3(tile_count(element_count) * GROUP_SIZE, 1, 1),
+            [&](ShaderCursor cursor)
+            {
+                cursor["keys"] = ref(const_cast<Buffer*>(keys));
+                cursor["bins"] = ref(bins);
+                cursor["count"] = element_count;
+                cursor["bin_count"] = bin_count;
+            },
+            command_buffer
+        );
+    command_buffer->uav_barrier(bins);
+}
+
+void Primitives::compact(
+    CommandBuffer* command_buffer,
+    const Buffer* src,
+    const Buffer* flags,
+    Buffer* dst,
+    Buffer* dst_count,
+    uint32_t element_count,
+    ScalarType scalar_type,
+    uint32_t component_count
+)
+{
+    SGL_CHECK_NOT_NULL(command_buffer);
+    SGL_CHECK_NOT_NULL(src);
+    SGL_CHECK_NOT_NULL(flags);
+    SGL_CHECK_NOT_NULL(dst);
+    SGL_CHECK_NOT_NULL(dst_count);
+    check_element_type(scalar_type, component_count);
+
+    uint32_t size = element_size(scalar_type, component_count);
+    check_buffer_size(src, uint64_t(element_count) * size, "src");
+    check_buffer_size(flags, uint64_t(element_count) * sizeof(uint32_t), "flags");
+    check_buffer_size(dst, uint64_t(element_count) * size, "dst");
+    check_buffer_size(dst_count, sizeof(uint32_t), "dst_count");
+
+    if (element_count == 0) {
+        command_buffer->clear_resource_view(dst_count->get_uav({.offset = 0, .size = sizeof(uint32_t)}), uint4(0));
+        return;
+    }
+
+    uint32_t tiles = tile_count(element_count);
+    Buffer* tile_counts = get_scratch(Scratch::tile_counts, tiles * sizeof(uint32_t));
+    Buffer* tile_offsets = get_scratch(Scratch::tile_offsets, tiles * sizeof(uint32_t));
+
+    get_kernel("compact_count")
+        ->dispatch(
+            uint3(tiles * GROUP_SIZE, 1, 1),
+            [&](ShaderCursor cursor)
+            {
+                cursor["flags"] = ref(const_cast<Buffer*>(flags));
+                cursor["tile_counts"] = ref(tile_counts);
+                cursor["count"] = element_count;
+            },
+            command_buffer
+        );
+    command_buffer->uav_barrier(tile_counts);
+
+    scan(command_buffer, tile_counts, tile_offsets, tiles, ScalarType::uint32);
+
+    get_kernel("compact_scatter", scalar_type, component_count)
+        ->dispatch(
+            uint3(tiles * GROUP_SIZE, 1, 1),
+            [&](ShaderCursor cursor)
+            {
+                cursor["src"] = ref(const_cast<Buffer*>(src));
+                cursor["flags"] = ref(const_cast<Buffer*>(flags));
+                cursor["tile_offsets"] = ref(tile_offsets);
+                cursor["dst"] = ref(dst);
+                cursor["dst_count"] = ref(dst_count);
+                cursor["count"] = element_count;
+                cursor["tile_count"] = tiles;
+            },
+            command_buffer
+        );
+    command_buffer->uav_barrier(dst);
+    command_buffer->uav_barrier(dst_count);
+}
+
+void Primitives::sort(
+    CommandBuffer* command_buffer,
+    Buffer* keys,
+    Buffer* values,
+    uint32_t element_count,
+    uint32_t key_bits
+)
+{
+    SGL_CHECK_NOT_NULL(command_buffer);
+    SGL_CHECK_NOT_NULL(keys);
+    SGL_CHECK(key_bits >= 1 && key_bits <= 32, "Key bits must be in [1, 32].");
+
+    uint64_t size = uint64_t(element_count) * sizeof(uint32_t);
+    check_buffer_size(keys, size, "keys");
+    if (values)
+        check_buffer_size(values, size, "values");
+    if (element_count <= 1)
+        return;
+
+    uint32_t tiles = tile_count(element_count);
+    uint32_t count_size = tiles * RADIX_SIZE * sizeof(uint32_t);
+    Buffer* tile_counts = get_scratch(Scratch::tile_counts, count_size);
+    Buffer* tile_offsets = get_scratch(Scratch::tile_offsets, count_size);
+
+    // Ping-pong between the input and scratch buffers, one pass per digit.
+    ref<Buffer> keys_in = ref(keys);
+    ref<Buffer> keys_out = ref(get_scratch(Scratch::sort_keys, size));
+    ref<Buffer> values_in = values ? ref(values) : keys_in;
+    ref<Buffer> values_out = values ? ref(get_scratch(Scratch::sort_values, size)) : keys_out;
+
+    ComputeKernel* count_kernel = get_kernel("radix_count");
+    ComputeKernel* scatter_kernel = get_kernel("radix_scatter");
+
+    uint32_t pass_count = div_round_up(key_bits, RADIX_BITS);
+    for (uint32_t pass = 0; pass < pass_count; ++pass) {
+        uint32_t shift = pass * RADIX_BITS;
+        count_kernel->dispatch(
+            uint3(tiles * GROUP_SIZE, 1, 1),
+            [&](ShaderCursor cursor)
+            {
+                cursor["keys"] = keys_in;
+                cursor["tile_counts"] = ref(tile_counts);
+                cursor["count"] = element_count;
+                cursor["tile_count"] = tiles;
+                cursor["shift"] = shift;
+            },
+            command_buffer
+        );
+        command_buffer->uav_barrier(tile_counts);
+
+        scan(command_buffer, tile_counts, tile_offsets, tiles * RADIX_SIZE, ScalarType::uint32);
+
+        scatter_kernel->dispatch(
+            uint3(tiles * GROUP_SIZE, 1, 1),
+            [&](ShaderCursor cursor)
+            {
+                cursor["keys_in"] = keys_in;
+                cursor["values_in"] = values_in;
+                cursor["tile_offsets"] = ref(tile_offsets);
+                cursor["keys_out"] = keys_out;
+                cursor["values_out"] = values_out;
+                cursor["count"] = element_count;
+                cursor["tile_count"] = tiles;
+                cursor["shift"] = shift;
+                cursor["has_values"] = values ? 1u : 0u;
+            },
+            command_buffer
+        );
+        command_buffer->uav_barrier(keys_out);
+        if (values)
+            command_buffer->uav_barrier(values_out);
+
+        std::swap(keys_in, keys_out);
+        std::swap(values_in, values_out);
+    }
+
+    // After an odd number of passes the result is in the scratch buffers.
+    if (keys_in != keys) {
+        command_buffer->copy_buffer_region(keys, 0, keys_in, 0, size);
+        if (values)
+            command_buffer->copy_buffer_region(values, 0, values_in, 0, size);
+    }
+}
+
+void Primitives::histogram_cpu(std::span<const uint32_t> keys, std::span<uint32_t> bins)
+{
+    std::fill(bins.begin(), bins.end(), 0);
+    for (uint32_t key : keys)
+        if (key < bins.size())
+            bins[key]++;
+}
+
+void Primitives::sort_cpu(std::span<uint32_t> keys, std::span<uint32_t> values, uint32_t key_bits)
+{
+    SGL_CHECK(key_bits >= 1 && key_bits <= 32, "Key bits must be in [1, 32].");
+    SGL_CHECK(values.empty() || values.size() == keys.size(), "Expected one value per key.");
+
+    uint32_t mask = key_bits == 32 ? ~0u : (1u << key_bits) - 1;
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(
+        order.begin(),
+        order.end(),
+        [&](size_t a, size_t b) { return (keys[a] & mask) < (keys[b] & mask); }
+    );
+
+    auto permute = [&](std::span<uint32_t> data)
+    {
+        std::vector<uint32_t> copy(data.begin(), data.end());
+        for (size_t i = 0; i < order.size(); ++i)
+            data[i] = copy[order[i]];
+    };
+    permute(keys);
+    if (!values.empty())
+        permute(values);
+}
+
+ComputeKernel*
+Primitives::get_kernel(const char* entry_point, ScalarType scalar_type, uint32_t component_count, ReduceOp op)
+{
+    KernelKey key{
+        .entry_point = entry_point,
+        .scalar_type = scalar_type,
+        .component_count = component_count,
+        .op = op,
+    };
+    auto it = m_kernels.find(key);
+    if (it != m_kernels.end())
+        return it->second;
+
+    std::string_view scalar_name;
+    std::string_view scalar_min;
+    std::string_view scalar_max;
+    switch (scalar_type) {
+    case ScalarType::int32:
+        scalar_name = "int";
+        scalar_min = "int(0x80000000)";
+        scalar_max = "int(0x7fffffff)";
+        break;
+    case ScalarType::uint32:
+        scalar_name = "uint";
+        scalar_min = "0u";
+        scalar_max = "0xffffffffu";
+        break;
+    case ScalarType::float32:
+        scalar_name = "float";
+        scalar_min = "asfloat(0xff800000u)";
+        scalar_max = "asfloat(0x7f800000u)";
+        break;
+    default:
+        SGL_UNREACHABLE();
+    }
+    std::string element_type
+        = component_count > 1 ? fmt::format("{}{}", scalar_name, component_count) : std::string(scalar_name);
+
+    std::string source;
+    source += fmt::format(
+        "#define ELEMENT_TYPE {}\n"
+        "#define ELEMENT_SIZE {}\n"
+        "#define ELEMENT_MIN {}\n"
+        "#define ELEMENT_MAX {}\n"
+        "#define REDUCE_OP {}\n\n",
+        element_type,
+        element_size(scalar_type, component_count),
+        scalar_min,
+        scalar_max,
+        uint32_t(op)
+    );
+    source += m_device->slang_session()->load_source("sgl/device/primitives.slang");
+
+    std::string module_name = fmt::format("primitives_{}_{}", element_type, op);
+    ref<SlangModule> module = m_device->slang_session()->load_module_from_source(module_name, source);
+    module->break_strong_reference_to_session();
+    ref<ShaderProgram> program
+        = m_device->slang_session()->link_program({module}, {module->entry_point(entry_point)});
+    ref<ComputeKernel> kernel = m_device->create_compute_kernel({.program = program});
+
+    m_kernels[key] = kernel;
+    return kernel;
+}
+
+Buffer* Primitives::get_scratch(Scratch scratch, size_t size)
+{
+    ref<Buffer>& buffer = m_scratch[size_t(scratch)];
+    if (!buffer || buffer->size() < size) {
+        // Grow geometrically to avoid reallocating for slowly increasing sizes.
+        size_t capacity = std::max<size_t>(size, buffer ? buffer->size() * 2 : 0);
+        buffer = m_device->create_buffer({
+            .size = align_to(size_t(256), capacity),
+            .usage = ResourceUsage::shader_resource | ResourceUsage::unordered_access,
+            .debug_name = fmt::format("primitives_scratch_{}", uint32_t(scratch)),
+        });
+    }
+    return buffer;
+}
+
+} // namespace sgl
@@ -0,0 +1,264 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sgl/device/fwd.h"
+#include "sgl/device/reflection.h"
+
+#include "sgl/core/object.h"
+#include "sgl/core/enum.h"
+#include "sgl/core/error.h"
+
+#include "sgl/math/vector_math.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace sgl {
+
+/// Reduction operation.
+enum class ReduceOp : uint32_t {
+    sum,
+    min,
+    max,
+};
+
+SGL_ENUM_INFO(
+    ReduceOp,
+    {
+        {ReduceOp::sum, "sum"},
+        {ReduceOp::min, "min"},
+        {ReduceOp::max, "max"},
+    }
+);
+SGL_ENUM_REGISTER(ReduceOp);
+
+/**
+ * \brief Parallel primitives operating on buffers.
+ *
+ * Implements reduction, prefix sum, histogram, stream compaction and radix sort with wave intrinsics
+ * and group shared memory. The prefix sum is a single pass scan with decoupled look-back.
+ * Buffers are accessed as raw buffers, so inputs need \c ResourceUsage::shader_resource and outputs
+ * \c ResourceUsage::unordered_access. Elements are 32-bit scalars (int32, uint32 or float32) or vectors
+ * of 2-4 components of them, tightly packed.
+ *
+ * All functions record their work into the given command buffer. Scratch memory is owned by this
+ * object and reused between calls.
+ *
+ * The static \c *_cpu functions are reference implementations with the same semantics.
+ */
+class SGL_API Primitives : public Object {
+    SGL_OBJECT(Primitives)
+public:
+    using ScalarType = TypeReflection::ScalarType;
+
+    /// Number of elements processed per thread group.
+    static constexpr uint32_t TILE_SIZE = 2048;
+    /// Number of key bits sorted per radix sort pass.
+    static constexpr uint32_t RADIX_BITS = 4;
+
+    Primitives(Device* device);
+    ~Primitives();
+
+    /**
+     * \brief Reduce a buffer to a single element.
+     *
+     * \param command_buffer Command buffer.
+     * \param op Reduction operation.
+     * \param src Source buffer.
+     * \param dst Destination buffer (the result is written to the first element).
+     * \param element_count Number of elements in \c src (needs to be at least 1).
+     * \param scalar_type Scalar type of the elements.
+     * \param component_count Number of components of the elements (1-4).
+     */
+    void reduce(
+        CommandBuffer* command_buffer,
+        ReduceOp op,
+        const Buffer* src,
+        Buffer* dst,
+        uint32_t element_count,
+        ScalarType scalar_type,
+        uint32_t component_count = 1
+    );
+
+    /**
+     * \brief Prefix sum.
+     *
+     * \param command_buffer Command buffer.
+     * \param src Source buffer.
+     * \param dst Destination buffer (needs to be different from \c src).
+     * \param element_count Number of elements.
+     * \param scalar_type Scalar type of the elements.
+     * \param component_count Number of components of the elements (1-4).
+     * \param inclusive Compute an inclusive instead of an exclusive prefix sum.
+     */
+    void scan(
+        CommandBuffer* command_buffer,
+        const Buffer* src,
+        Buffer* dst,
+        uint32_t element_count,
+        ScalarType scalar_type,
+        uint32_t component_count = 1,
+        bool inclusive = false
+    );
+
+    /**
+     * \brief Histogram of uint32 keys.
+     *
+     * Clears \c bins and counts the occurrences of every key. Keys greater or equal to \c bin_count are ignored.
+     *
+     * \param command_buffer Command buffer.
+     * \param keys Buffer of uint32 keys.
+     * \param bins Buffer of \c bin_count uint32 counters.
+     * \param element_count Number of keys.
+     * \param bin_count Number of bins.
+     */
+    void histogram(
+        CommandBuffer* command_buffer,
+        const Buffer* keys,
+        Buffer* bins,
+        uint32_t element_count,
+        uint32_t bin_count
+    );
+
+    /**
+     * \brief Stream compaction.
+     *
+     * Writes all elements of \c src with a non-zero flag to \c dst, keeping their order,
+     * and the number of written elements as uint32 to \c dst_count.
+     *
+     * \param command_buffer Command buffer.
+     * \param src Source buffer.
+     * \param flags Buffer of uint32 flags, one per element.
+     * \param dst Destination buffer (needs space for \c element_count elements).
+     * \param dst_count Buffer receiving the number of selected elements.
+     * \param element_count Number of elements.
+     * \param scalar_type Scalar type of the elements.
+     * \param component_count Number of components of the elements (1-4).
+     */
+    void compact(
+        CommandBuffer* command_buffer,
+        const Buffer* src,
+        const Buffer* flags,
+        Buffer* dst,
+        Buffer* dst_count,
+        uint32_t element_count,
+        ScalarType scalar_type,
+        uint32_t component_count = 1
+    );
+
+    /**
+     * \brief Stable in-place radix sort of uint32 keys with optional uint32 values.
+     *
+     * Only the lowest \c key_bits bits of the keys are compared.
+     *
+     * \param command_buffer Command buffer.
+     * \param keys Buffer of keys (needs shader resource and unordered access usage).
+     * \param values Buffer of values (optional, same usage as \c keys).
+     * \param element_count Number of elements.
+     * \param key_bits Number of key bits to sort by (1-32).
+     */
+    void sort(
+        CommandBuffer* command_buffer,
+        Buffer* keys,
+        Buffer* values,
+        uint32_t element_count,
+        uint32_t key_bits = 32
+    );
+
+    /// Reference implementation of \c reduce().
+    template<typename T>
+    static T reduce_cpu(ReduceOp op, std::span<const T> src)
+    {
+        SGL_CHECK(!src.empty(), "Cannot reduce an empty range.");
+        return std::accumulate(
+            src.begin() + 1,
+            src.end(),
+            src[0],
+            [op](const T& a, const T& b) -> T
+            {
+                using std::max;
+                using std::min;
+                switch (op) {
+                case ReduceOp::min:
+                    return min(a, b);
+                case ReduceOp::max:
+                    return max(a, b);
+                default:
+                    return a + b;
+                }
+            }
+        );
+    }
+
+    /// Reference implementation of \c scan().
+    template<typename T>
+    static void scan_cpu(std::span<const T> src, std::span<T> dst, bool inclusive = false)
+    {
+        SGL_CHECK(dst.size() >= src.size(), "Destination is too small.");
+        T sum = T(0);
+        for (size_t i = 0; i < src.size(); ++i) {
+            T value = src[i];
+            dst[i] = inclusive ? sum + value : sum;
+            sum = sum + value;
+        }
+    }
+
+    /// Reference implementation of \c histogram().
+    static void histogram_cpu(std::span<const uint32_t> keys, std::span<uint32_t> bins);
+
+    /// Reference implementation of \c compact(). Returns the selected elements.
+    template<typename T>
+    static std::vector<T> compact_cpu(std::span<const T> src, std::span<const uint32_t> flags)
+    {
+        SGL_CHECK(flags.size() >= src.size(), "Expected one flag per element.");
+        std::vector<T> result;
+        for (size_t i = 0; i < src.size(); ++i)
+            if (flags[i] != 0)
+                result.push_back(src[i]);
+        return result;
+    }
+
+    /// Reference implementation of \c sort(). \c values may be empty.
+    static void sort_cpu(std::span<uint32_t> keys, std::span<uint32_t> values, uint32_t key_bits = 32);
+
+private:
+    enum class Scratch {
+        reduce_a,
+        reduce_b,
+        scan_state,
+        scan_values,
+        tile_counts,
+        tile_offsets,
+        sort_keys,
+        sort_values,
+        count,
+    };
+
+    struct KernelKey {
+        std::string entry_point;
+        ScalarType scalar_type;
+        uint32_t component_count;
+        ReduceOp op;
+
+        auto operator<=>(const KernelKey&) const = default;
+    };
+
+    ComputeKernel* get_kernel(
+        const char* entry_point,
+        ScalarType scalar_type = ScalarType::uint32,
+        uint32_t component_count = 1,
+        ReduceOp op = ReduceOp::sum
+    );
+    Buffer* get_scratch(Scratch scratch, size_t size);
+
+    Device* m_device;
+    std::map<KernelKey, ref<ComputeKernel>> m_kernels;
+    ref<Buffer> m_scratch[size_t(Scratch::count)];
+};
+
+} // namespace sgl
@@ -4,14 +4,15 @@
 
 #include "sgl/core/format.h"
 
-#include "sgl/device/device.h"
-#include "sgl/device/command.h"
+#include "sgl/device/message_channel.h"
 
 #include "sgl/math/vector.h"
 #include "sgl/math/matrix.h"
 
 #include <fmt/args.h>
 
+#include <utility>
+
 namespace sgl {
 namespace print_buffer {
 
@@ -224,27 +225,17 @@ namespace print_buffer {
         }
     }
 
+    /// Decode buffered messages. Each message is stored as its size followed by the message payload.
     template<typename Output>
     inline void
-    decode_buffer(const void* data, size_t size, const std::map<uint32_t, std::string>& hashed_strings, Output output)
+    decode_messages(std::span<const uint8_t> data, const std::map<uint32_t, std::string>& hashed_strings, Output output)
     {
-        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data);
-        uint32_t buffer_size = *reinterpret_cast<const uint32_t*>(ptr);
-        ptr += 4;
-        // Clamp buffer size to the actual size of the buffer (in case the device has overflown the buffer).
-        buffer_size = std::min(buffer_size, uint32_t(size) - 4);
-        const uint8_t* end = ptr + buffer_size;
-
-        size_t count = 0;
+        const uint8_t* ptr = data.data();
+        const uint8_t* end = ptr + data.size();
         while (ptr < end) {
             uint32_t msg_size = *reinterpret_cast<const uint32_t*>(ptr);
-            if (msg_size == 0xffffffff) {
-                log_warn("Print buffer overflow!");
-                break;
-            }
             SGL_ASSERT(ptr + msg_size <= end)
             decode_msg(std::span(ptr, msg_size), hashed_strings, output);
-            ++count;
             ptr += msg_size;
         }
     }
@@ -252,21 +243,27 @@ namespace print_buffer {
 } // namespace print_buffer
 
 
-DebugPrinter::DebugPrinter(Device* device, size_t buffer_size)
-    : m_device(device)
+DebugPrinter::DebugPrinter(MessageChannel* channel)
+    : m_channel(channel)
+{
+    SGL_ASSERT(m_channel);
+    m_channel->set_handler(
+        MessageChannel::PRINT_ID,
+        [this](std::span<const uint8_t> payload)
+        {
+            // Prepend the message size to restore the layout expected by decode_msg().
+            uint32_t msg_size = uint32_t(payload.size() + 4);
+            std::lock_guard lock(m_mutex);
+            const uint8_t* size_bytes = reinterpret_cast<const uint8_t*>(&msg_size);
+            m_messages.insert(m_messages.end(), size_bytes, size_bytes + 4);
+            m_messages.insert(m_messages.end(), payload.begin(), payload.end());
+        }
+    );
+}
+
+DebugPrinter::~DebugPrinter()
 {
-    m_buffer = m_device->create_buffer({
-        .size = buffer_size,
-        .usage = ResourceUsage::unordered_access,
-        .debug_name = "debug_printer_buffer",
-    });
-
-    m_readback_buffer = m_device->create_buffer({
-        .size = buffer_size,
-        .usage = ResourceUsage::none,
-        .memory_type = MemoryType::read_back,
-        .debug_name = "debug_printer_readback_buffer",
-    });
+    m_channel->remove_handler(MessageChannel::PRINT_ID);
 }
 
 void DebugPrinter::add_hashed_strings(const std::map<uint32_t, std::string>& hashed_strings)
@@ -276,25 +273,18 @@ void DebugPrinter::add_hashed_strings(const std::map<uint32_t, std::string>& has
 
 void DebugPrinter::flush()
 {
-    flush_device(true);
-    const void* data = m_readback_buffer->map();
-    print_buffer::decode_buffer(
-        data,
-        m_readback_buffer->size(),
+    print_buffer::decode_messages(
+        flush_messages(),
         m_hashed_strings,
         [](std::string_view str) { Logger::get().log(LogLevel::none, str); }
     );
-    m_readback_buffer->unmap();
 }
 
 std::string DebugPrinter::flush_to_string()
 {
-    flush_device(true);
     std::string result;
-    const void* data = m_readback_buffer->map();
-    print_buffer::decode_buffer(
-        data,
-        m_readback_buffer->size(),
+    print_buffer::decode_messages(
+        flush_messages(),
         m_hashed_strings,
         [&result](std::string_view str)
         {
@@ -302,24 +292,14 @@ std::string DebugPrinter::flush_to_string()
             result += "\n";
         }
     );
-    m_readback_buffer->unmap();
     return result;
 }
 
-void DebugPrinter::bind(ShaderCursor cursor)
-{
-    if (cursor.is_valid())
-        cursor = cursor.find_field("g_debug_printer");
-    if (cursor.is_valid())
-        cursor["buffer"] = m_buffer;
-}
-
-void DebugPrinter::flush_device(bool wait)
+std::vector<uint8_t> DebugPrinter::flush_messages()
 {
-    CommandBuffer* command_buffer = m_device->_begin_shared_command_buffer();
-    command_buffer->copy_resource(m_readback_buffer, m_buffer);
-    command_buffer->clear_resource_view(m_buffer->get_uav({.offset = 0, .size = 4}), uint4(0));
-    m_device->_end_shared_command_buffer(wait);
+    m_channel->flush();
+    std::lock_guard lock(m_mutex);
+    return std::exchange(m_messages, {});
 }
 
 } // namespace sgl
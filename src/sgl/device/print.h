@@ -3,10 +3,11 @@
 #pragma once
 
 #include "sgl/device/fwd.h"
-#include "sgl/device/shader_cursor.h"
 
 #include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace sgl {
 
@@ -14,10 +15,13 @@ namespace sgl {
  * \brief Debug printer.
  *
  * This class implements host-side support for shader debug printing.
+ * Print messages are streamed through the device's message channel (see \c MessageChannel)
+ * and buffered until the next flush.
  */
 class DebugPrinter {
 public:
-    DebugPrinter(Device* device, size_t buffer_size = 4 * 1024 * 1024);
+    DebugPrinter(MessageChannel* channel);
+    ~DebugPrinter();
 
     /// Add a map of hashed strings to the printer.
     /// This needs to be called for any shader that uses debug printing.
@@ -29,15 +33,15 @@ public:
     /// Flush the print buffer and output any messages as a string.
     std::string flush_to_string();
 
-    void bind(ShaderCursor cursor);
-
 private:
-    void flush_device(bool wait);
+    /// Flush the message channel and return the buffered messages.
+    std::vector<uint8_t> flush_messages();
 
-    Device* m_device;
+    MessageChannel* m_channel;
 
-    ref<Buffer> m_buffer;
-    ref<Buffer> m_readback_buffer;
+    /// Protects the buffered messages, which are appended from the polling thread.
+    std::mutex m_mutex;
+    std::vector<uint8_t> m_messages;
 
     std::map<uint32_t, std::string> m_hashed_strings;
 };
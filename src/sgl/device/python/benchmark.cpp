@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "nanobind.h"
+
+#include "sgl/device/benchmark.h"
+
+namespace sgl {
+SGL_DICT_TO_DESC_BEGIN(BenchmarkDesc)
+SGL_DICT_TO_DESC_FIELD(name, std::string)
+SGL_DICT_TO_DESC_FIELD(warmup_iterations, uint32_t)
+SGL_DICT_TO_DESC_FIELD(iterations, uint32_t)
+SGL_DICT_TO_DESC_FIELD(max_iterations, uint32_t)
+SGL_DICT_TO_DESC_FIELD(min_sample_time, double)
+SGL_DICT_TO_DESC_FIELD(bytes, uint64_t)
+SGL_DICT_TO_DESC_FIELD(flops, uint64_t)
+SGL_DICT_TO_DESC_FIELD(noise_threshold, double)
+SGL_DICT_TO_DESC_END()
+} // namespace sgl
+
+SGL_PY_EXPORT(device_benchmark)
+{
+    using namespace sgl;
+
+    nb::class_<BenchmarkDesc>(m, "BenchmarkDesc", D_NA(BenchmarkDesc))
+        .def(nb::init<>())
+        .def(
+            "__init__",
+            [](BenchmarkDesc* self, nb::dict dict) { new (self) BenchmarkDesc(dict_to_BenchmarkDesc(dict)); }
+        )
+        .def_rw("name", &BenchmarkDesc::name, D_NA(BenchmarkDesc, name))
+        .def_rw("warmup_iterations", &BenchmarkDesc::warmup_iterations, D_NA(BenchmarkDesc, warmup_iterations))
+        .def_rw("iterations", &BenchmarkDesc::iterations, D_NA(BenchmarkDesc, iterations))
+        .def_rw("max_iterations", &BenchmarkDesc::max_iterations, D_NA(BenchmarkDesc, max_iterations))
+        .def_rw("min_sample_time", &BenchmarkDesc::min_sample_time, D_NA(BenchmarkDesc, min_sample_time))
+        .def_rw("bytes", &BenchmarkDesc::bytes, D_NA(BenchmarkDesc, bytes))
+        .def_rw("flops", &BenchmarkDesc::flops, D_NA(BenchmarkDesc, flops))
+        .def_rw("noise_threshold", &BenchmarkDesc::noise_threshold, D_NA(BenchmarkDesc, noise_threshold));
+    nb::implicitly_convertible<nb::dict, BenchmarkDesc>();
+
+    nb::class_<BenchmarkResult>(m, "BenchmarkResult", D_NA(BenchmarkResult))
+        .def_static(
+            "from_samples",
+            &BenchmarkResult::from_samples,
+            "samples"_a,
+            "dispatches_per_sample"_a = 1,
+            "desc"_a = BenchmarkDesc(),
+            D_NA(BenchmarkResult, from_samples)
+        )
+        .def_ro("name", &BenchmarkResult::name, D_NA(BenchmarkResult, name))
+        .def_ro("samples", &BenchmarkResult::samples, D_NA(BenchmarkResult, samples))
+        .def_ro(
+            "dispatches_per_sample",
+            &BenchmarkResult::dispatches_per_sample,
+            D_NA(BenchmarkResult, dispatches_per_sample)
+        )
+        .def_ro("min", &BenchmarkResult::min, D_NA(BenchmarkResult, min))
+        .def_ro("max", &BenchmarkResult::max, D_NA(BenchmarkResult, max))
+        .def_ro("mean", &BenchmarkResult::mean, D_NA(BenchmarkResult, mean))
+        .def_ro("median", &BenchmarkResult::median, D_NA(BenchmarkResult, median))
+        .def_ro("stddev", &BenchmarkResult::stddev, D_NA(BenchmarkResult, stddev))
+        .def_ro("p10", &BenchmarkResult::p10, D_NA(BenchmarkResult, p10))
+        .def_ro("p90", &BenchmarkResult::p90, D_NA(BenchmarkResult, p90))
+        .def_ro("relative_spread", &BenchmarkResult::relative_spread, D_NA(BenchmarkResult, relative_spread))
+        .def_ro("noisy", &BenchmarkResult::noisy, D_NA(BenchmarkResult, noisy))
+        .def_ro("bandwidth", &BenchmarkResult::bandwidth, D_NA(BenchmarkResult, bandwidth))
+        .def_ro("flops_per_second", &BenchmarkResult::flops_per_second, D_NA(BenchmarkResult, flops_per_second))
+        .def("percentile", &BenchmarkResult::percentile, "p"_a, D_NA(BenchmarkResult, percentile))
+        .def("to_json", &BenchmarkResult::to_json, D_NA(BenchmarkResult, to_json))
+        .def("__repr__", &BenchmarkResult::to_string);
+}
@@ -187,6 +187,13 @@ SGL_PY_EXPORT(device_command)
             &ComputeCommandEncoder::dispatch_thread_groups,
             "thread_group_count"_a,
             D(ComputeCommandEncoder, dispatch_thread_groups)
+        )
+        .def(
+            "dispatch_thread_groups_indirect",
+            &ComputeCommandEncoder::dispatch_thread_groups_indirect,
+            "cmd_buffer"_a,
+            "offset"_a = 0,
+            D(ComputeCommandEncoder, dispatch_thread_groups_indirect)
         );
 
     nb::class_<RenderCommandEncoder>(m, "RenderCommandEncoder", D(RenderCommandEncoder))
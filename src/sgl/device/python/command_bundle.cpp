@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "nanobind.h"
+
+#include "sgl/device/command_bundle.h"
+#include "sgl/device/command.h"
+#include "sgl/device/kernel.h"
+#include "sgl/device/resource.h"
+#include "sgl/device/sampler.h"
+#include "sgl/device/raytracing.h"
+
+namespace sgl {
+
+/// Convert a python object to a bundle value (resources, None or contiguous numpy arrays holding uniform data).
+inline CommandBundle::Value python_to_bundle_value(nb::handle value)
+{
+    if (value.is_none())
+        return std::monostate{};
+
+    Buffer* buffer;
+    if (nb::try_cast(value, buffer))
+        return ref(buffer);
+    Texture* texture;
+    if (nb::try_cast(value, texture))
+        return ref(texture);
+    ResourceView* resource_view;
+    if (nb::try_cast(value, resource_view))
+        return ref(resource_view);
+    Sampler* sampler;
+    if (nb::try_cast(value, sampler))
+        return ref(sampler);
+    AccelerationStructure* acceleration_structure;
+    if (nb::try_cast(value, acceleration_structure))
+        return ref(acceleration_structure);
+
+    nb::ndarray<nb::numpy> array;
+    if (nb::try_cast(value, array)) {
+        SGL_CHECK(is_ndarray_contiguous(array), "numpy array is not contiguous");
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(array.data());
+        return CommandBundle::Data(data, data + array.nbytes());
+    }
+
+    SGL_THROW("Unsupported command bundle value type \"{}\".", nb::inst_name(value).c_str());
+}
+
+inline CommandBundle::Argument python_to_bundle_argument(nb::handle value)
+{
+    CommandBundle::Slot slot;
+    if (nb::try_cast(value, slot))
+        return slot;
+    return python_to_bundle_value(value);
+}
+
+inline std::vector<CommandBundle::Binding> python_to_bundle_bindings(nb::dict vars)
+{
+    std::vector<CommandBundle::Binding> bindings;
+    for (auto [path, value] : vars)
+        bindings.push_back({nb::cast<std::string>(path), python_to_bundle_argument(value)});
+    return bindings;
+}
+
+} // namespace sgl
+
+SGL_PY_EXPORT(device_command_bundle)
+{
+    using namespace sgl;
+
+    nb::class_<CommandBundle, DeviceResource> command_bundle(m, "CommandBundle", D_NA(CommandBundle));
+
+    nb::class_<CommandBundle::Slot>(command_bundle, "Slot", D_NA(CommandBundle, Slot))
+        .def_ro("index", &CommandBundle::Slot::index, D_NA(CommandBundle, Slot, index));
+
+    command_bundle //
+        .def(
+            "add_slot",
+            [](CommandBundle* self, std::string name, nb::handle value)
+            { return self->add_slot(std::move(name), python_to_bundle_value(value)); },
+            "name"_a,
+            "value"_a.none() = nb::none(),
+            D_NA(CommandBundle, add_slot)
+        )
+        .def(
+            "slot",
+            [](CommandBundle* self, std::string_view name) { return self->slot(name); },
+            "name"_a,
+            D_NA(CommandBundle, slot)
+        )
+        .def("has_slot", &CommandBundle::has_slot, "name"_a, D_NA(CommandBundle, has_slot))
+        .def_prop_ro("slot_count", &CommandBundle::slot_count, D_NA(CommandBundle, slot_count))
+        .def(
+            "set_slot",
+            [](CommandBundle* self, CommandBundle::Slot slot, nb::handle value)
+            { self->set_slot(slot, python_to_bundle_value(value)); },
+            "slot"_a,
+            "value"_a.none(),
+            D_NA(CommandBundle, set_slot)
+        )
+        .def(
+            "set_slot",
+            [](CommandBundle* self, std::string_view name, nb::handle value)
+            { self->set_slot(name, python_to_bundle_value(value)); },
+            "name"_a,
+            "value"_a.none(),
+            D_NA(CommandBundle, set_slot)
+        )
+        .def(
+            "dispatch",
+            [](CommandBundle* self, ref<ComputeKernel> kernel, uint3 thread_count, nb::dict vars)
+            { self->dispatch(std::move(kernel), thread_count, python_to_bundle_bindings(vars)); },
+            "kernel"_a,
+            "thread_count"_a,
+            "vars"_a = nb::dict(),
+            D_NA(CommandBundle, dispatch)
+        )
+        .def(
+            "dispatch_thread_groups",
+            [](CommandBundle* self, ref<ComputeKernel> kernel, uint3 thread_group_count, nb::dict vars)
+            { self->dispatch_thread_groups(std::move(kernel), thread_group_count, python_to_bundle_bindings(vars)); },
+            "kernel"_a,
+            "thread_group_count"_a,
+            "vars"_a = nb::dict(),
+            D_NA(CommandBundle, dispatch_thread_groups)
+        )
+        .def(
+            "copy_buffer_region",
+            [](CommandBundle* self,
+               nb::handle dst,
+               DeviceOffset dst_offset,
+               nb::handle src,
+               DeviceOffset src_offset,
+               DeviceSize size)
+            {
+                self->copy_buffer_region(
+                    python_to_bundle_argument(dst),
+                    dst_offset,
+                    python_to_bundle_argument(src),
+                    src_offset,
+                    size
+                );
+            },
+            "dst"_a,
+            "dst_offset"_a,
+            "src"_a,
+            "src_offset"_a,
+            "size"_a,
+            D_NA(CommandBundle, copy_buffer_region)
+        )
+        .def(
+            "uav_barrier",
+            [](CommandBundle* self, nb::handle resource) { self->uav_barrier(python_to_bundle_argument(resource)); },
+            "resource"_a,
+            D_NA(CommandBundle, uav_barrier)
+        )
+        .def("clear", &CommandBundle::clear, D_NA(CommandBundle, clear))
+        .def_prop_ro("command_count", &CommandBundle::command_count, D_NA(CommandBundle, command_count))
+        .def("execute", &CommandBundle::execute, "command_buffer"_a = nullptr, D_NA(CommandBundle, execute));
+}
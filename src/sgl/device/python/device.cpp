@@ -11,21 +11,28 @@
 #include "sgl/device/kernel.h"
 #include "sgl/device/raytracing.h"
 #include "sgl/device/query.h"
+#include "sgl/device/shader_archive.h"
 #include "sgl/device/input_layout.h"
 #include "sgl/device/framebuffer.h"
 #include "sgl/device/memory_heap.h"
+#include "sgl/device/primitives.h"
+#include "sgl/device/message_channel.h"
 #include "sgl/device/swapchain.h"
 #include "sgl/device/shader.h"
 #include "sgl/device/command.h"
+#include "sgl/device/command_bundle.h"
 
 #include "sgl/core/window.h"
 
 namespace sgl {
+extern void write_shader_cursor(ShaderCursor& cursor, nb::object value);
+
 SGL_DICT_TO_DESC_BEGIN(DeviceDesc)
 SGL_DICT_TO_DESC_FIELD(type, DeviceType)
 SGL_DICT_TO_DESC_FIELD(enable_debug_layers, bool)
 SGL_DICT_TO_DESC_FIELD(enable_cuda_interop, bool)
 SGL_DICT_TO_DESC_FIELD(enable_print, bool)
+SGL_DICT_TO_DESC_FIELD(enable_message_channel, bool)
 SGL_DICT_TO_DESC_FIELD(enable_hot_reload, bool)
 SGL_DICT_TO_DESC_FIELD(adapter_luid, AdapterLUID)
 SGL_DICT_TO_DESC_FIELD_DICT(compiler_options, SlangCompilerOptions)
@@ -53,6 +60,11 @@ SGL_PY_EXPORT(device_device)
         .def_rw("enable_debug_layers", &DeviceDesc::enable_debug_layers, D(DeviceDesc, enable_debug_layers))
         .def_rw("enable_cuda_interop", &DeviceDesc::enable_cuda_interop, D(DeviceDesc, enable_cuda_interop))
         .def_rw("enable_print", &DeviceDesc::enable_print, D(DeviceDesc, enable_print))
+        .def_rw(
+            "enable_message_channel",
+            &DeviceDesc::enable_message_channel,
+            D_NA(DeviceDesc, enable_message_channel)
+        )
         .def_rw("enable_hot_reload", &DeviceDesc::enable_hot_reload, D(DeviceDesc, adapter_luid))
         .def_rw("adapter_luid", &DeviceDesc::adapter_luid, D(DeviceDesc, adapter_luid))
         .def_rw("compiler_options", &DeviceDesc::compiler_options, D(DeviceDesc, compiler_options))
@@ -138,6 +150,11 @@ SGL_PY_EXPORT(device_device)
         .def_ro("api_name", &DeviceInfo::api_name, D(DeviceInfo, api_name))
         .def_ro("adapter_name", &DeviceInfo::adapter_name, D(DeviceInfo, adapter_name))
         .def_ro("timestamp_frequency", &DeviceInfo::timestamp_frequency, D(DeviceInfo, timestamp_frequency))
+        .def_ro(
+            "host_visible_device_local_memory",
+            &DeviceInfo::host_visible_device_local_memory,
+            D_NA(DeviceInfo, host_visible_device_local_memory)
+        )
         .def_ro("limits", &DeviceInfo::limits, D(DeviceInfo, limits));
 
     nb::class_<ShaderCacheStats>(m, "ShaderCacheStats", D(ShaderCacheStats))
@@ -153,6 +170,7 @@ SGL_PY_EXPORT(device_device)
            bool enable_debug_layers,
            bool enable_cuda_interop,
            bool enable_print,
+           bool enable_message_channel,
            bool enable_hot_reload,
            std::optional<AdapterLUID> adapter_luid,
            std::optional<SlangCompilerOptions> compiler_options,
@@ -163,6 +181,7 @@ SGL_PY_EXPORT(device_device)
                 .enable_debug_layers = enable_debug_layers,
                 .enable_cuda_interop = enable_cuda_interop,
                 .enable_print = enable_print,
+                .enable_message_channel = enable_message_channel,
                 .enable_hot_reload = enable_hot_reload,
                 .adapter_luid = adapter_luid,
                 .compiler_options = compiler_options.value_or(SlangCompilerOptions{}),
@@ -173,6 +192,7 @@ SGL_PY_EXPORT(device_device)
         "enable_debug_layers"_a = DeviceDesc().enable_debug_layers,
         "enable_cuda_interop"_a = DeviceDesc().enable_cuda_interop,
         "enable_print"_a = DeviceDesc().enable_print,
+        "enable_message_channel"_a = DeviceDesc().enable_message_channel,
         "enable_hot_reload"_a = true,
         "adapter_luid"_a.none() = nb::none(),
         "compiler_options"_a.none() = nb::none(),
@@ -194,7 +214,16 @@ SGL_PY_EXPORT(device_device)
     );
 
     device.def_prop_ro("slang_session", &Device::slang_session, D(Device, slang_session));
-    device.def("close", &Device::close, D(Device, close));
+    device.def(
+        "close",
+        [](Device* self)
+        {
+            // Closing joins the message channel polling thread, which may call into Python.
+            nb::gil_scoped_release guard;
+            self->close();
+        },
+        D(Device, close)
+    );
     device.def(
         "create_swapchain",
         [](Device* self,
@@ -487,6 +516,7 @@ SGL_PY_EXPORT(device_device)
     device.def("create_framebuffer", &Device::create_framebuffer, "desc"_a, D(Device, create_framebuffer));
 
     device.def("create_command_buffer", &Device::create_command_buffer, D(Device, create_command_buffer));
+    device.def("create_command_bundle", &Device::create_command_bundle, D_NA(Device, create_command_bundle));
     device.def(
         "submit_command_buffer",
         &Device::submit_command_buffer,
@@ -608,6 +638,18 @@ SGL_PY_EXPORT(device_device)
         "link_options"_a.none() = nb::none(),
         D(Device, load_program)
     );
+    device.def(
+        "load_program_from_archive",
+        [](Device* self,
+           const ShaderArchive* archive,
+           std::string_view program_name,
+           std::optional<SlangLinkOptions> link_options)
+        { return self->load_program_from_archive(ref(archive), program_name, link_options); },
+        "archive"_a,
+        "program_name"_a,
+        "link_options"_a.none() = nb::none(),
+        D_NA(Device, load_program_from_archive)
+    );
 
     device.def(
         "create_mutable_shader_object",
@@ -747,10 +789,65 @@ SGL_PY_EXPORT(device_device)
 
     device.def_prop_ro("upload_heap", &Device::upload_heap, D(Device, upload_heap));
     device.def_prop_ro("read_back_heap", &Device::read_back_heap, D(Device, read_back_heap));
-    device.def("flush_print", &Device::flush_print, D(Device, flush_print));
-    device.def("flush_print_to_string", &Device::flush_print_to_string, D(Device, flush_print_to_string));
+    device.def_prop_ro("primitives", &Device::primitives, D_NA(Device, primitives));
+    device.def_prop_ro("message_channel", &Device::message_channel, D_NA(Device, message_channel));
+    // Release the GIL, message handlers implemented in Python are called from the polling thread.
+    device.def(
+        "flush_print",
+        [](Device* self)
+        {
+            nb::gil_scoped_release guard;
+            self->flush_print();
+        },
+        D(Device, flush_print)
+    );
+    device.def(
+        "flush_print_to_string",
+        [](Device* self)
+        {
+            nb::gil_scoped_release guard;
+            return self->flush_print_to_string();
+        },
+        D(Device, flush_print_to_string)
+    );
     device.def("run_garbage_collection", &Device::run_garbage_collection, D(Device, run_garbage_collection));
     device.def("wait", &Device::wait, D(Device, wait));
+    device.def(
+        "benchmark",
+        [](Device* self, std::function<void(CommandBuffer*)> encode, const BenchmarkDesc& desc)
+        { return self->benchmark(encode, desc); },
+        "encode"_a,
+        "desc"_a = BenchmarkDesc(),
+        D_NA(Device, benchmark)
+    );
+    device.def(
+        "benchmark_kernel",
+        [](Device* self,
+           ComputeKernel* kernel,
+           uint3 thread_count,
+           nb::dict vars,
+           const BenchmarkDesc& desc,
+           nb::kwargs kwargs)
+        {
+            auto bind_vars = [&](ShaderCursor cursor)
+            {
+                // bind locals
+                if (kwargs.size() > 0) {
+                    ShaderCursor entry_point = cursor.find_entry_point(0);
+                    write_shader_cursor(entry_point, kwargs);
+                }
+                // bind globals
+                write_shader_cursor(cursor, vars);
+            };
+            return self->benchmark_kernel(kernel, thread_count, bind_vars, desc);
+        },
+        "kernel"_a,
+        "thread_count"_a,
+        "vars"_a = nb::dict(),
+        "desc"_a = BenchmarkDesc(),
+        "kwargs"_a,
+        D_NA(Device, benchmark_kernel)
+    );
 
     device.def_static(
         "enumerate_adapters",
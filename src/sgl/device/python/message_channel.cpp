@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "nanobind.h"
+
+#include "sgl/device/message_channel.h"
+#include "sgl/device/resource.h"
+
+#include <memory>
+
+SGL_PY_EXPORT(device_message_channel)
+{
+    using namespace sgl;
+
+    nb::class_<MessageChannel, Object>(m, "MessageChannel", D_NA(MessageChannel))
+        .def_ro_static("HEADER_SIZE", &MessageChannel::HEADER_SIZE, D_NA(MessageChannel, HEADER_SIZE))
+        .def_ro_static(
+            "MESSAGE_HEADER_SIZE",
+            &MessageChannel::MESSAGE_HEADER_SIZE,
+            D_NA(MessageChannel, MESSAGE_HEADER_SIZE)
+        )
+        .def_ro_static("MAX_MESSAGE_SIZE", &MessageChannel::MAX_MESSAGE_SIZE, D_NA(MessageChannel, MAX_MESSAGE_SIZE))
+        .def_ro_static("RESERVED_ID_BASE", &MessageChannel::RESERVED_ID_BASE, D_NA(MessageChannel, RESERVED_ID_BASE))
+        .def_ro_static("PRINT_ID", &MessageChannel::PRINT_ID, D_NA(MessageChannel, PRINT_ID))
+        .def_prop_ro("capacity", &MessageChannel::capacity, D_NA(MessageChannel, capacity))
+        .def_prop_ro("buffer", &MessageChannel::buffer, D_NA(MessageChannel, buffer))
+        .def_prop_ro("is_host_visible", &MessageChannel::is_host_visible, D_NA(MessageChannel, is_host_visible))
+        .def_prop_ro(
+            "is_background_polling",
+            &MessageChannel::is_background_polling,
+            D_NA(MessageChannel, is_background_polling)
+        )
+        .def_prop_ro("dropped_count", &MessageChannel::dropped_count, D_NA(MessageChannel, dropped_count))
+        // Handlers are called from the polling thread, so all functions that wait for the
+        // channel release the GIL.
+        .def(
+            "set_handler",
+            [](MessageChannel* self, uint32_t id, nb::callable handler)
+            {
+                // The handler may be destroyed on a thread without the GIL.
+                std::shared_ptr<nb::callable> callable(
+                    new nb::callable(std::move(handler)),
+                    [](nb::callable* ptr)
+                    {
+                        nb::gil_scoped_acquire guard;
+                        delete ptr;
+                    }
+                );
+                nb::gil_scoped_release guard;
+                self->set_handler(
+                    id,
+                    [callable](std::span<const uint8_t> payload)
+                    {
+                        nb::gil_scoped_acquire guard;
+                        (*callable)(nb::bytes(reinterpret_cast<const char*>(payload.data()), payload.size()));
+                    }
+                );
+            },
+            "id"_a,
+            "handler"_a,
+            D_NA(MessageChannel, set_handler)
+        )
+        .def(
+            "remove_handler",
+            [](MessageChannel* self, uint32_t id)
+            {
+                nb::gil_scoped_release guard;
+                self->remove_handler(id);
+            },
+            "id"_a,
+            D_NA(MessageChannel, remove_handler)
+        )
+        .def(
+            "poll",
+            [](MessageChannel* self)
+            {
+                nb::gil_scoped_release guard;
+                return self->poll();
+            },
+            D_NA(MessageChannel, poll)
+        )
+        .def(
+            "flush",
+            [](MessageChannel* self)
+            {
+                nb::gil_scoped_release guard;
+                return self->flush();
+            },
+            D_NA(MessageChannel, flush)
+        );
+}
@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "nanobind.h"
+
+#include "sgl/device/primitives.h"
+#include "sgl/device/resource.h"
+#include "sgl/device/command.h"
+
+SGL_PY_EXPORT(device_primitives)
+{
+    using namespace sgl;
+
+    nb::sgl_enum<ReduceOp>(m, "ReduceOp", D_NA(ReduceOp));
+
+    nb::class_<Primitives, Object>(m, "Primitives", D_NA(Primitives))
+        .def_ro_static("TILE_SIZE", &Primitives::TILE_SIZE, D_NA(Primitives, TILE_SIZE))
+        .def_ro_static("RADIX_BITS", &Primitives::RADIX_BITS, D_NA(Primitives, RADIX_BITS))
+        .def(
+            "reduce",
+            &Primitives::reduce,
+            "command_buffer"_a,
+            "op"_a,
+            "src"_a,
+            "dst"_a,
+            "element_count"_a,
+            "scalar_type"_a,
+            "component_count"_a = 1,
+            D_NA(Primitives, reduce)
+        )
+        .def(
+            "scan",
+            &Primitives::scan,
+            "command_buffer"_a,
+            "src"_a,
+            "dst"_a,
+            "element_count"_a,
+            "scalar_type"_a,
+            "component_count"_a = 1,
+            "inclusive"_a = false,
+            D_NA(Primitives, scan)
+        )
+        .def(
+            "histogram",
+            &Primitives::histogram,
+            "command_buffer"_a,
+            "keys"_a,
+            "bins"_a,
+            "element_count"_a,
+            "bin_count"_a,
+            D_NA(Primitives, histogram)
+        )
+        .def(
+            "compact",
+            &Primitives::compact,
+            "command_buffer"_a,
+            "src"_a,
+            "flags"_a,
+            "dst"_a,
+            "dst_count"_a,
+            "element_count"_a,
+            "scalar_type"_a,
+            "component_count"_a = 1,
+            D_NA(Primitives, compact)
+        )
+        .def(
+            "sort",
+            &Primitives::sort,
+            "command_buffer"_a,
+            "keys"_a,
+            "values"_a.none(),
+            "element_count"_a,
+            "key_bits"_a = 32,
+            D_NA(Primitives, sort)
+        );
+}
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "nanobind.h"
+
+#include "sgl/device/reflection.h"
+#include "sgl/device/reflection_snapshot.h"
+
+SGL_PY_EXPORT(device_reflection_snapshot)
+{
+    using namespace sgl;
+
+    nb::class_<TypeLayoutSnapshot, Object> type_layout_snapshot(m, "TypeLayoutSnapshot", D_NA(TypeLayoutSnapshot));
+
+    nb::class_<TypeLayoutSnapshot::Field>(type_layout_snapshot, "Field", D_NA(TypeLayoutSnapshot, Field))
+        .def_ro("name", &TypeLayoutSnapshot::Field::name, D_NA(TypeLayoutSnapshot, Field, name))
+        .def_ro("offset", &TypeLayoutSnapshot::Field::offset, D_NA(TypeLayoutSnapshot, Field, offset))
+        .def_ro("type_layout", &TypeLayoutSnapshot::Field::type_layout, D_NA(TypeLayoutSnapshot, Field, type_layout));
+
+    type_layout_snapshot //
+        .def_prop_ro("name", &TypeLayoutSnapshot::name, D_NA(TypeLayoutSnapshot, name))
+        .def_prop_ro("kind", &TypeLayoutSnapshot::kind, D_NA(TypeLayoutSnapshot, kind))
+        .def_prop_ro("scalar_type", &TypeLayoutSnapshot::scalar_type, D_NA(TypeLayoutSnapshot, scalar_type))
+        .def_prop_ro(
+            "parameter_category",
+            &TypeLayoutSnapshot::parameter_category,
+            D_NA(TypeLayoutSnapshot, parameter_category)
+        )
+        .def_prop_ro("row_count", &TypeLayoutSnapshot::row_count, D_NA(TypeLayoutSnapshot, row_count))
+        .def_prop_ro("col_count", &TypeLayoutSnapshot::col_count, D_NA(TypeLayoutSnapshot, col_count))
+        .def_prop_ro("size", &TypeLayoutSnapshot::size, D_NA(TypeLayoutSnapshot, size))
+        .def_prop_ro("stride", &TypeLayoutSnapshot::stride, D_NA(TypeLayoutSnapshot, stride))
+        .def_prop_ro("alignment", &TypeLayoutSnapshot::alignment, D_NA(TypeLayoutSnapshot, alignment))
+        .def_prop_ro("fields", &TypeLayoutSnapshot::fields, D_NA(TypeLayoutSnapshot, fields))
+        .def(
+            "find_field_by_name",
+            [](const TypeLayoutSnapshot* self, std::string_view name) -> std::optional<TypeLayoutSnapshot::Field>
+            {
+                if (const TypeLayoutSnapshot::Field* field = self->find_field_by_name(name))
+                    return *field;
+                return {};
+            },
+            "name"_a,
+            D_NA(TypeLayoutSnapshot, find_field_by_name)
+        )
+        .def_prop_ro("element_count", &TypeLayoutSnapshot::element_count, D_NA(TypeLayoutSnapshot, element_count))
+        .def_prop_ro("element_stride", &TypeLayoutSnapshot::element_stride, D_NA(TypeLayoutSnapshot, element_stride))
+        .def_prop_ro(
+            "element_type_layout",
+            &TypeLayoutSnapshot::element_type_layout,
+            D_NA(TypeLayoutSnapshot, element_type_layout)
+        )
+        .def("unwrap_array", &TypeLayoutSnapshot::unwrap_array, D_NA(TypeLayoutSnapshot, unwrap_array));
+
+    nb::class_<ReflectionSnapshot, Object> reflection_snapshot(m, "ReflectionSnapshot", D_NA(ReflectionSnapshot));
+
+    nb::class_<ReflectionSnapshot::EntryPoint>(reflection_snapshot, "EntryPoint", D_NA(ReflectionSnapshot, EntryPoint))
+        .def_ro("name", &ReflectionSnapshot::EntryPoint::name, D_NA(ReflectionSnapshot, EntryPoint, name))
+        .def_ro("stage", &ReflectionSnapshot::EntryPoint::stage, D_NA(ReflectionSnapshot, EntryPoint, stage))
+        .def_ro(
+            "thread_group_size",
+            &ReflectionSnapshot::EntryPoint::thread_group_size,
+            D_NA(ReflectionSnapshot, EntryPoint, thread_group_size)
+        )
+        .def_ro(
+            "parameters",
+            &ReflectionSnapshot::EntryPoint::parameters,
+            D_NA(ReflectionSnapshot, EntryPoint, parameters)
+        );
+
+    reflection_snapshot //
+        .def(nb::init<const std::filesystem::path&>(), "path"_a, D_NA(ReflectionSnapshot, ReflectionSnapshot))
+        .def_static(
+            "from_program_layout",
+            &ReflectionSnapshot::from_program_layout,
+            "program_layout"_a,
+            D_NA(ReflectionSnapshot, from_program_layout)
+        )
+        .def_static(
+            "from_type_layout",
+            &ReflectionSnapshot::from_type_layout,
+            "type_layout"_a,
+            D_NA(ReflectionSnapshot, from_type_layout)
+        )
+        .def(
+            "add_type_layout",
+            &ReflectionSnapshot::add_type_layout,
+            "name"_a,
+            "type_layout"_a,
+            D_NA(ReflectionSnapshot, add_type_layout)
+        )
+        .def("write", &ReflectionSnapshot::write, "path"_a, D_NA(ReflectionSnapshot, write))
+        .def_prop_ro(
+            "globals_type_layout",
+            &ReflectionSnapshot::globals_type_layout,
+            D_NA(ReflectionSnapshot, globals_type_layout)
+        )
+        .def_prop_ro("entry_points", &ReflectionSnapshot::entry_points, D_NA(ReflectionSnapshot, entry_points))
+        .def(
+            "find_entry_point_by_name",
+            [](const ReflectionSnapshot* self, std::string_view name) -> std::optional<ReflectionSnapshot::EntryPoint>
+            {
+                if (const ReflectionSnapshot::EntryPoint* entry_point = self->find_entry_point_by_name(name))
+                    return *entry_point;
+                return {};
+            },
+            "name"_a,
+            D_NA(ReflectionSnapshot, find_entry_point_by_name)
+        )
+        .def_prop_ro("type_layouts", &ReflectionSnapshot::type_layouts, D_NA(ReflectionSnapshot, type_layouts))
+        .def(
+            "find_type_layout",
+            &ReflectionSnapshot::find_type_layout,
+            "name"_a,
+            D_NA(ReflectionSnapshot, find_type_layout)
+        );
+}
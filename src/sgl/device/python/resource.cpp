@@ -256,6 +256,7 @@ SGL_PY_EXPORT(device_resource)
         .def_prop_ro("desc", &Buffer::desc, D(Buffer, desc))
         .def_prop_ro("size", &Buffer::size, D(Buffer, size))
         .def_prop_ro("struct_size", &Buffer::struct_size, D(Buffer, struct_size))
+        .def_prop_ro("is_host_visible", &Buffer::is_host_visible, D_NA(Buffer, is_host_visible))
         .def_prop_ro("device_address", &Buffer::device_address, D(Buffer, device_address))
         .def(
             "get_srv",
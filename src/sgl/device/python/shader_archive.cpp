@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "nanobind.h"
+
+#include "sgl/device/device.h"
+#include "sgl/device/shader_archive.h"
+
+SGL_PY_EXPORT(device_shader_archive)
+{
+    using namespace sgl;
+
+    nb::class_<ShaderArchiveProgramDesc>(m, "ShaderArchiveProgramDesc", D_NA(ShaderArchiveProgramDesc))
+        .def(nb::init<>())
+        .def(
+            "__init__",
+            [](ShaderArchiveProgramDesc* self,
+               std::string name,
+               std::string module_name,
+               std::vector<std::string> entry_point_names)
+            {
+                new (self) ShaderArchiveProgramDesc{
+                    .name = std::move(name),
+                    .module_name = std::move(module_name),
+                    .entry_point_names = std::move(entry_point_names),
+                };
+            },
+            "name"_a,
+            "module_name"_a,
+            "entry_point_names"_a
+        )
+        .def_rw("name", &ShaderArchiveProgramDesc::name, D_NA(ShaderArchiveProgramDesc, name))
+        .def_rw("module_name", &ShaderArchiveProgramDesc::module_name, D_NA(ShaderArchiveProgramDesc, module_name))
+        .def_rw(
+            "entry_point_names",
+            &ShaderArchiveProgramDesc::entry_point_names,
+            D_NA(ShaderArchiveProgramDesc, entry_point_names)
+        );
+
+    nb::class_<ShaderArchive, Object> shader_archive(m, "ShaderArchive", D_NA(ShaderArchive));
+
+    nb::class_<ShaderArchive::Program>(shader_archive, "Program", D_NA(ShaderArchive, Program))
+        .def_ro("name", &ShaderArchive::Program::name, D_NA(ShaderArchive, Program, name))
+        .def_ro(
+            "entry_point_names",
+            &ShaderArchive::Program::entry_point_names,
+            D_NA(ShaderArchive, Program, entry_point_names)
+        )
+        .def_ro(
+            "module_indices",
+            &ShaderArchive::Program::module_indices,
+            D_NA(ShaderArchive, Program, module_indices)
+        );
+
+    shader_archive //
+        .def(nb::init<const std::filesystem::path&>(), "path"_a, D_NA(ShaderArchive, ShaderArchive))
+        .def_static(
+            "build",
+            [](Device* device, std::vector<ShaderArchiveProgramDesc> programs)
+            { return ShaderArchive::build(device, programs); },
+            "device"_a,
+            "programs"_a,
+            D_NA(ShaderArchive, build)
+        )
+        .def("write", &ShaderArchive::write, "path"_a, D_NA(ShaderArchive, write))
+        .def_prop_ro("device_type", &ShaderArchive::device_type, D_NA(ShaderArchive, device_type))
+        .def_prop_ro("compiler_version", &ShaderArchive::compiler_version, D_NA(ShaderArchive, compiler_version))
+        .def_prop_ro(
+            "module_names",
+            [](const ShaderArchive* self)
+            {
+                std::vector<std::string> names;
+                for (const ShaderArchive::Module& module : self->modules())
+                    names.push_back(module.name);
+                return names;
+            },
+            D_NA(ShaderArchive, modules)
+        )
+        .def_prop_ro("programs", &ShaderArchive::programs, D_NA(ShaderArchive, programs))
+        .def("has_program", &ShaderArchive::has_program, "name"_a, D_NA(ShaderArchive, has_program))
+        .def("check_compatible", &ShaderArchive::check_compatible, "device"_a, D_NA(ShaderArchive, check_compatible));
+}
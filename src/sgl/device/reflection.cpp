@@ -9,26 +9,37 @@
 
 #include "sgl/math/vector.h"
 
+#include <mutex>
 #include <span>
 
 namespace sgl {
 
 namespace detail {
 
-    static std::map<void*, const BaseReflectionObject*> g_slang_reflection_to_sgl_reflection;
+    static std::recursive_mutex g_slang_reflection_mutex;
+    /// Live wrappers by slang reflection pointer. A failed \c try_inc_ref() creates an additional wrapper
+    /// for the same slang object, all of them are kept so that they are invalidated on hot reload.
+    static std::multimap<void*, const BaseReflectionObject*> g_slang_reflection_to_sgl_reflection;
 
     template<typename SGLType, typename SlangType>
     ref<const SGLType> create_reflection_type_from_slang_type(ref<const Object> owner, SlangType* slang_reflection)
     {
         if (slang_reflection) {
-            auto it = g_slang_reflection_to_sgl_reflection.find(slang_reflection);
-            if (it != g_slang_reflection_to_sgl_reflection.end()) {
-                return ref((const SGLType*)it->second);
-            } else {
-                auto res = make_ref<const SGLType>(std::move(owner), slang_reflection);
-                g_slang_reflection_to_sgl_reflection[slang_reflection] = res.get();
-                return res;
+            std::lock_guard lock(g_slang_reflection_mutex);
+            // Wrappers are erased in their destructor under the same lock, so cached pointers are valid.
+            // A wrapper whose last reference is being dropped on another thread must not be resurrected,
+            // skip it and create a new wrapper if no other one is alive.
+            auto [begin, end] = g_slang_reflection_to_sgl_reflection.equal_range(slang_reflection);
+            for (auto it = begin; it != end; ++it) {
+                if (it->second->try_inc_ref()) {
+                    ref<const SGLType> res((const SGLType*)it->second);
+                    it->second->dec_ref();
+                    return res;
+                }
             }
+            auto res = make_ref<const SGLType>(std::move(owner), slang_reflection);
+            g_slang_reflection_to_sgl_reflection.emplace(slang_reflection, res.get());
+            return res;
         } else
             return nullptr;
     }
@@ -50,13 +61,21 @@ namespace detail {
 
 #undef SGL_FROM_SLANG
 
-    void on_slang_wrapper_destroyed(void* slang_reflection)
+    void on_slang_wrapper_destroyed(const BaseReflectionObject* object, void* slang_reflection)
     {
-        g_slang_reflection_to_sgl_reflection.erase(slang_reflection);
+        std::lock_guard lock(g_slang_reflection_mutex);
+        auto [begin, end] = g_slang_reflection_to_sgl_reflection.equal_range(slang_reflection);
+        for (auto it = begin; it != end; ++it) {
+            if (it->second == object) {
+                g_slang_reflection_to_sgl_reflection.erase(it);
+                break;
+            }
+        }
     }
 
     void invalidate_all_reflection_data()
     {
+        std::lock_guard lock(g_slang_reflection_mutex);
         for (auto& [_, reflection] : g_slang_reflection_to_sgl_reflection) {
             const_cast<BaseReflectionObject*>(reflection)->_hot_reload_invalidate();
         }
@@ -36,7 +36,7 @@ namespace detail {
     from_slang(ref<const Object> owner, slang::EntryPointLayout* entry_point_reflection);
     SGL_API ref<const ProgramLayout> from_slang(ref<const Object> owner, slang::ProgramLayout* program_layout);
 
-    SGL_API void on_slang_wrapper_destroyed(void* slang_reflection);
+    SGL_API void on_slang_wrapper_destroyed(const BaseReflectionObject* object, void* slang_reflection);
 
     SGL_API void invalidate_all_reflection_data();
 } // namespace detail
@@ -209,7 +209,7 @@ public:
         , m_target(target)
     {
     }
-    ~BaseReflectionObjectImpl() { detail::on_slang_wrapper_destroyed(m_target); }
+    ~BaseReflectionObjectImpl() { detail::on_slang_wrapper_destroyed(this, m_target); }
 
     SlangType* slang_target() const
     {
@@ -991,6 +991,11 @@ public:
 
     EntryPointLayoutParameterList parameters() const;
 
+    ref<const TypeLayoutReflection> type_layout() const
+    {
+        return detail::from_slang(m_owner, slang_target()->getTypeLayout());
+    }
+
     uint3 compute_thread_group_size() const
     {
         SlangUInt size[3];
@@ -0,0 +1,382 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "reflection_snapshot.h"
+
+#include "sgl/core/error.h"
+#include "sgl/core/file_stream.h"
+#include "sgl/core/string.h"
+#include "sgl/core/type_utils.h"
+
+#include <algorithm>
+
+namespace sgl {
+
+namespace {
+
+    /// Snapshot file magic ("SGLR").
+    constexpr uint32_t SNAPSHOT_MAGIC = 0x524c4753;
+    constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+    /// Type index used for null type layouts.
+    constexpr uint32_t NULL_INDEX = 0xffffffff;
+
+    void write_u32(Stream* stream, uint32_t value)
+    {
+        stream->write(&value, sizeof(value));
+    }
+
+    void write_u64(Stream* stream, uint64_t value)
+    {
+        stream->write(&value, sizeof(value));
+    }
+
+    void write_string(Stream* stream, std::string_view str)
+    {
+        write_u32(stream, narrow_cast<uint32_t>(str.size()));
+        stream->write(str.data(), str.size());
+    }
+
+    uint32_t read_u32(Stream* stream)
+    {
+        uint32_t value;
+        stream->read(&value, sizeof(value));
+        return value;
+    }
+
+    uint64_t read_u64(Stream* stream)
+    {
+        uint64_t value;
+        stream->read(&value, sizeof(value));
+        return value;
+    }
+
+    /// Read a size and check that the remaining stream holds at least \c size elements of \c element_size bytes.
+    size_t read_size(Stream* stream, size_t element_size)
+    {
+        size_t size = read_u32(stream);
+        SGL_CHECK(
+            size * element_size <= stream->size() - stream->tell(),
+            "Invalid reflection snapshot (truncated data)."
+        );
+        return size;
+    }
+
+    std::string read_string(Stream* stream)
+    {
+        std::string str(read_size(stream, 1), '\0');
+        stream->read(str.data(), str.size());
+        return str;
+    }
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// TypeLayoutSnapshot
+// ----------------------------------------------------------------------------
+
+const TypeLayoutSnapshot::Field& TypeLayoutSnapshot::get_field_by_index(uint32_t index) const
+{
+    SGL_CHECK(index < m_fields.size(), "Field index out of range");
+    return m_fields[index];
+}
+
+int32_t TypeLayoutSnapshot::find_field_index_by_name(std::string_view name) const
+{
+    for (size_t i = 0; i < m_fields.size(); ++i)
+        if (m_fields[i].name == name)
+            return narrow_cast<int32_t>(i);
+    return -1;
+}
+
+const TypeLayoutSnapshot::Field* TypeLayoutSnapshot::find_field_by_name(std::string_view name) const
+{
+    int32_t index = find_field_index_by_name(name);
+    return index >= 0 ? &m_fields[index] : nullptr;
+}
+
+ref<const TypeLayoutSnapshot> TypeLayoutSnapshot::unwrap_array() const
+{
+    ref<const TypeLayoutSnapshot> type_layout = ref(this);
+    while (type_layout->is_array())
+        type_layout = type_layout->element_type_layout();
+    return type_layout;
+}
+
+std::string TypeLayoutSnapshot::to_string() const
+{
+    return fmt::format(
+        "TypeLayoutSnapshot(\n"
+        "  name = \"{}\",\n"
+        "  kind = {},\n"
+        "  size = {},\n"
+        "  stride = {},\n"
+        "  alignment = {},\n"
+        "  field_count = {}\n"
+        ")",
+        m_name,
+        m_kind,
+        m_size,
+        m_stride,
+        m_alignment,
+        m_fields.size()
+    );
+}
+
+// ----------------------------------------------------------------------------
+// ReflectionSnapshot
+// ----------------------------------------------------------------------------
+
+ReflectionSnapshot::ReflectionSnapshot(const std::filesystem::path& path)
+{
+    FileStream stream(path, FileStream::Mode::read);
+
+    SGL_CHECK(read_u32(&stream) == SNAPSHOT_MAGIC, "\"{}\" is not a reflection snapshot.", path);
+    uint32_t version = read_u32(&stream);
+    SGL_CHECK(version == SNAPSHOT_VERSION, "Unsupported reflection snapshot version {} in \"{}\".", version, path);
+
+    // Type layouts are created upfront, as they reference each other by index.
+    m_all_type_layouts.resize(read_size(&stream, sizeof(uint32_t)));
+    for (ref<TypeLayoutSnapshot>& type_layout : m_all_type_layouts)
+        type_layout = ref(new TypeLayoutSnapshot());
+
+    auto read_type_layout = [&]() -> ref<const TypeLayoutSnapshot>
+    {
+        uint32_t index = read_u32(&stream);
+        if (index == NULL_INDEX)
+            return nullptr;
+        SGL_CHECK(index < m_all_type_layouts.size(), "Invalid reflection snapshot (type index out of range).");
+        return m_all_type_layouts[index];
+    };
+
+    auto read_fields = [&](std::vector<TypeLayoutSnapshot::Field>& fields)
+    {
+        fields.resize(read_size(&stream, sizeof(uint32_t)));
+        for (TypeLayoutSnapshot::Field& field : fields) {
+            field.name = read_string(&stream);
+            field.offset = read_u64(&stream);
+            field.type_layout = read_type_layout();
+        }
+    };
+
+    for (ref<TypeLayoutSnapshot>& type_layout : m_all_type_layouts) {
+        type_layout->m_name = read_string(&stream);
+        type_layout->m_kind = static_cast<TypeReflection::Kind>(read_u32(&stream));
+        type_layout->m_scalar_type = static_cast<TypeReflection::ScalarType>(read_u32(&stream));
+        type_layout->m_parameter_category = static_cast<TypeReflection::ParameterCategory>(read_u32(&stream));
+        type_layout->m_row_count = read_u32(&stream);
+        type_layout->m_col_count = read_u32(&stream);
+        type_layout->m_size = read_u64(&stream);
+        type_layout->m_stride = read_u64(&stream);
+        type_layout->m_alignment = static_cast<int32_t>(read_u32(&stream));
+        type_layout->m_element_count = read_u64(&stream);
+        type_layout->m_element_stride = read_u64(&stream);
+        type_layout->m_element_type_layout = read_type_layout();
+        read_fields(type_layout->m_fields);
+    }
+
+    m_globals_type_layout = read_type_layout();
+
+    m_entry_points.resize(read_size(&stream, sizeof(uint32_t)));
+    for (EntryPoint& entry_point : m_entry_points) {
+        entry_point.name = read_string(&stream);
+        entry_point.stage = static_cast<ShaderStage>(read_u32(&stream));
+        for (int i = 0; i < 3; ++i)
+            entry_point.thread_group_size[i] = read_u32(&stream);
+        read_fields(entry_point.parameters);
+    }
+
+    size_t type_layout_count = read_size(&stream, sizeof(uint32_t));
+    for (size_t i = 0; i < type_layout_count; ++i) {
+        std::string name = read_string(&stream);
+        ref<const TypeLayoutSnapshot> type_layout = read_type_layout();
+        SGL_CHECK(type_layout, "Invalid reflection snapshot (null type layout \"{}\").", name);
+        m_type_layouts.emplace(std::move(name), std::move(type_layout));
+    }
+}
+
+ref<ReflectionSnapshot> ReflectionSnapshot::from_program_layout(const ProgramLayout* program_layout)
+{
+    SGL_CHECK_NOT_NULL(program_layout);
+
+    ref<ReflectionSnapshot> snapshot(new ReflectionSnapshot());
+    snapshot->m_globals_type_layout = snapshot->snapshot_type_layout(program_layout->globals_type_layout());
+
+    for (uint32_t i = 0; i < program_layout->entry_point_count(); ++i) {
+        ref<const EntryPointLayout> entry_point_layout = program_layout->get_entry_point_by_index(i);
+        EntryPoint entry_point{
+            .name = entry_point_layout->name(),
+            .stage = entry_point_layout->stage(),
+            .thread_group_size = uint3(0),
+        };
+        if (entry_point.stage == ShaderStage::compute)
+            entry_point.thread_group_size = entry_point_layout->compute_thread_group_size();
+        for (uint32_t j = 0; j < entry_point_layout->parameter_count(); ++j)
+            entry_point.parameters.push_back(snapshot->snapshot_field(entry_point_layout->get_parameter_by_index(j)));
+        snapshot->m_entry_points.push_back(std::move(entry_point));
+    }
+
+    return snapshot;
+}
+
+ref<ReflectionSnapshot> ReflectionSnapshot::from_type_layout(const TypeLayoutReflection* type_layout)
+{
+    SGL_CHECK_NOT_NULL(type_layout);
+
+    ref<ReflectionSnapshot> snapshot(new ReflectionSnapshot());
+    snapshot->add_type_layout(type_layout->name() ? type_layout->name() : "", type_layout);
+    return snapshot;
+}
+
+ref<const TypeLayoutSnapshot>
+ReflectionSnapshot::add_type_layout(std::string name, const TypeLayoutReflection* type_layout)
+{
+    SGL_CHECK_NOT_NULL(type_layout);
+
+    ref<const TypeLayoutSnapshot> result = snapshot_type_layout(type_layout);
+    m_type_layouts.insert_or_assign(std::move(name), result);
+    return result;
+}
+
+void ReflectionSnapshot::write(const std::filesystem::path& path) const
+{
+    std::map<const TypeLayoutSnapshot*, uint32_t> type_indices;
+    for (size_t i = 0; i < m_all_type_layouts.size(); ++i)
+        type_indices[m_all_type_layouts[i].get()] = narrow_cast<uint32_t>(i);
+
+    FileStream stream(path, FileStream::Mode::write);
+
+    auto write_type_layout = [&](const TypeLayoutSnapshot* type_layout)
+    { write_u32(&stream, type_layout ? type_indices.at(type_layout) : NULL_INDEX); };
+
+    auto write_fields = [&](const std::vector<TypeLayoutSnapshot::Field>& fields)
+    {
+        write_u32(&stream, narrow_cast<uint32_t>(fields.size()));
+        for (const TypeLayoutSnapshot::Field& field : fields) {
+            write_string(&stream, field.name);
+            write_u64(&stream, field.offset);
+            write_type_layout(field.type_layout);
+        }
+    };
+
+    write_u32(&stream, SNAPSHOT_MAGIC);
+    write_u32(&stream, SNAPSHOT_VERSION);
+
+    write_u32(&stream, narrow_cast<uint32_t>(m_all_type_layouts.size()));
+    for (const ref<TypeLayoutSnapshot>& type_layout : m_all_type_layouts) {
+        write_string(&stream, type_layout->m_name);
+        write_u32(&stream, static_cast<uint32_t>(type_layout->m_kind));
+        write_u32(&stream, static_cast<uint32_t>(type_layout->m_scalar_type));
+        write_u32(&stream, static_cast<uint32_t>(type_layout->m_parameter_category));
+        write_u32(&stream, type_layout->m_row_count);
+        write_u32(&stream, type_layout->m_col_count);
+        write_u64(&stream, type_layout->m_size);
+        write_u64(&stream, type_layout->m_stride);
+        write_u32(&stream, static_cast<uint32_t>(type_layout->m_alignment));
+        write_u64(&stream, type_layout->m_element_count);
+        write_u64(&stream, type_layout->m_element_stride);
+        write_type_layout(type_layout->m_element_type_layout);
+        write_fields(type_layout->m_fields);
+    }
+
+    write_type_layout(m_globals_type_layout);
+
+    write_u32(&stream, narrow_cast<uint32_t>(m_entry_points.size()));
+    for (const EntryPoint& entry_point : m_entry_points) {
+        write_string(&stream, entry_point.name);
+        write_u32(&stream, static_cast<uint32_t>(entry_point.stage));
+        for (int i = 0; i < 3; ++i)
+            write_u32(&stream, entry_point.thread_group_size[i]);
+        write_fields(entry_point.parameters);
+    }
+
+    write_u32(&stream, narrow_cast<uint32_t>(m_type_layouts.size()));
+    for (const auto& [name, type_layout] : m_type_layouts) {
+        write_string(&stream, name);
+        write_type_layout(type_layout);
+    }
+}
+
+const ReflectionSnapshot::EntryPoint* ReflectionSnapshot::find_entry_point_by_name(std::string_view name) const
+{
+    auto it = std::find_if(
+        m_entry_points.begin(),
+        m_entry_points.end(),
+        [name](const EntryPoint& entry_point) { return entry_point.name == name; }
+    );
+    return it != m_entry_points.end() ? &*it : nullptr;
+}
+
+ref<const TypeLayoutSnapshot> ReflectionSnapshot::find_type_layout(std::string_view name) const
+{
+    auto it = m_type_layouts.find(name);
+    return it != m_type_layouts.end() ? it->second : nullptr;
+}
+
+std::string ReflectionSnapshot::to_string() const
+{
+    std::vector<std::string> entry_point_names;
+    for (const EntryPoint& entry_point : m_entry_points)
+        entry_point_names.push_back(entry_point.name);
+    std::vector<std::string> type_names;
+    for (const auto& [name, type_layout] : m_type_layouts)
+        type_names.push_back(name);
+    return fmt::format(
+        "ReflectionSnapshot(\n"
+        "  entry_points = [{}],\n"
+        "  type_layouts = [{}]\n"
+        ")",
+        string::join(entry_point_names, ", "),
+        string::join(type_names, ", ")
+    );
+}
+
+ref<const TypeLayoutSnapshot> ReflectionSnapshot::snapshot_type_layout(const TypeLayoutReflection* type_layout)
+{
+    if (!type_layout)
+        return nullptr;
+
+    // Type layouts are shared between all fields and parameters using them.
+    const void* key = type_layout->get_slang_type_layout();
+    if (auto it = m_slang_type_layouts.find(key); it != m_slang_type_layouts.end())
+        return ref<const TypeLayoutSnapshot>(it->second);
+
+    ref<TypeLayoutSnapshot> result(new TypeLayoutSnapshot());
+    m_all_type_layouts.push_back(result);
+    m_slang_type_layouts.emplace(key, result.get());
+
+    ref<const TypeReflection> type = type_layout->type();
+    result->m_name = type_layout->name() ? type_layout->name() : "";
+    result->m_kind = type_layout->kind();
+    result->m_parameter_category = type_layout->parameter_category();
+    if (type) {
+        result->m_scalar_type = type->scalar_type();
+        result->m_row_count = type->row_count();
+        result->m_col_count = type->col_count();
+    }
+    result->m_size = type_layout->size();
+    result->m_stride = type_layout->stride();
+    result->m_alignment = type_layout->alignment();
+    result->m_element_count = type_layout->element_count();
+    result->m_element_stride = type_layout->element_stride();
+    result->m_element_type_layout = snapshot_type_layout(type_layout->element_type_layout());
+
+    if (result->m_kind == TypeReflection::Kind::struct_) {
+        for (uint32_t i = 0; i < type_layout->field_count(); ++i)
+            result->m_fields.push_back(snapshot_field(type_layout->get_field_by_index(i)));
+        if (!result->m_name.empty())
+            m_type_layouts.emplace(result->m_name, result);
+    }
+
+    return result;
+}
+
+TypeLayoutSnapshot::Field ReflectionSnapshot::snapshot_field(const VariableLayoutReflection* variable_layout)
+{
+    return {
+        .name = variable_layout->name() ? variable_layout->name() : "",
+        .offset = variable_layout->offset(),
+        .type_layout = snapshot_type_layout(variable_layout->type_layout()),
+    };
+}
+
+} // namespace sgl
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sgl/device/fwd.h"
+#include "sgl/device/reflection.h"
+#include "sgl/device/types.h"
+
+#include "sgl/core/object.h"
+#include "sgl/core/type_utils.h"
+#include "sgl/math/vector_types.h"
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sgl {
+
+/**
+ * \brief Snapshot of a type layout.
+ *
+ * Holds a copy of the layout information of a \c TypeLayoutReflection (uniform size, stride,
+ * alignment, fields and array/vector/matrix elements). Snapshots do not reference any slang
+ * reflection objects and can be used after the originating session has been destroyed.
+ */
+class SGL_API TypeLayoutSnapshot : public Object {
+    SGL_OBJECT(TypeLayoutSnapshot)
+public:
+    /// Field of a struct type layout.
+    struct Field {
+        /// Field name.
+        std::string name;
+        /// Uniform offset of the field in bytes.
+        size_t offset;
+        /// Type layout of the field.
+        ref<const TypeLayoutSnapshot> type_layout;
+    };
+
+    const std::string& name() const { return m_name; }
+    TypeReflection::Kind kind() const { return m_kind; }
+    TypeReflection::ScalarType scalar_type() const { return m_scalar_type; }
+    TypeReflection::ParameterCategory parameter_category() const { return m_parameter_category; }
+    uint32_t row_count() const { return m_row_count; }
+    uint32_t col_count() const { return m_col_count; }
+
+    size_t size() const { return m_size; }
+    size_t stride() const { return m_stride; }
+    int32_t alignment() const { return m_alignment; }
+
+    const std::vector<Field>& fields() const { return m_fields; }
+    uint32_t field_count() const { return narrow_cast<uint32_t>(m_fields.size()); }
+    const Field& get_field_by_index(uint32_t index) const;
+    int32_t find_field_index_by_name(std::string_view name) const;
+    const Field* find_field_by_name(std::string_view name) const;
+
+    bool is_array() const { return m_kind == TypeReflection::Kind::array; }
+    ref<const TypeLayoutSnapshot> unwrap_array() const;
+
+    size_t element_count() const { return m_element_count; }
+    size_t element_stride() const { return m_element_stride; }
+    ref<const TypeLayoutSnapshot> element_type_layout() const { return m_element_type_layout; }
+
+    std::string to_string() const override;
+
+private:
+    TypeLayoutSnapshot() = default;
+
+    std::string m_name;
+    TypeReflection::Kind m_kind{TypeReflection::Kind::none};
+    TypeReflection::ScalarType m_scalar_type{TypeReflection::ScalarType::none_};
+    TypeReflection::ParameterCategory m_parameter_category{TypeReflection::ParameterCategory::none};
+    uint32_t m_row_count{0};
+    uint32_t m_col_count{0};
+    size_t m_size{0};
+    size_t m_stride{0};
+    int32_t m_alignment{0};
+    size_t m_element_count{0};
+    size_t m_element_stride{0};
+    ref<const TypeLayoutSnapshot> m_element_type_layout;
+    std::vector<Field> m_fields;
+
+    friend class ReflectionSnapshot;
+};
+
+/**
+ * \brief Serializable snapshot of program reflection.
+ *
+ * Captures the global parameters, entry points (including thread group sizes) and
+ * a set of named type layouts of a program. Snapshots can be written to and read from
+ * a compact binary file, which allows tools that only need struct layouts and parameter
+ * offsets (e.g. packing data with \c BufferCursor) to run without compiling any shaders.
+ *
+ * When the slang session cache is enabled, a snapshot of each cached module is
+ * written next to the cached module (\c .slang-reflection next to \c .slang-module).
+ */
+class SGL_API ReflectionSnapshot : public Object {
+    SGL_OBJECT(ReflectionSnapshot)
+public:
+    /// Entry point snapshot.
+    struct EntryPoint {
+        /// Entry point name.
+        std::string name;
+        /// Shader stage.
+        ShaderStage stage;
+        /// Compute thread group size (zero for non-compute stages).
+        uint3 thread_group_size;
+        /// Entry point parameters.
+        std::vector<TypeLayoutSnapshot::Field> parameters;
+    };
+
+    /// Load a snapshot from a file.
+    explicit ReflectionSnapshot(const std::filesystem::path& path);
+
+    /// Create a snapshot of a program layout.
+    /// All struct types reachable from the global and entry point parameters are added as named type layouts.
+    static ref<ReflectionSnapshot> from_program_layout(const ProgramLayout* program_layout);
+
+    /// Create a snapshot containing a single named type layout.
+    static ref<ReflectionSnapshot> from_type_layout(const TypeLayoutReflection* type_layout);
+
+    /// Add a type layout to the snapshot, registered under the given name.
+    ref<const TypeLayoutSnapshot> add_type_layout(std::string name, const TypeLayoutReflection* type_layout);
+
+    /// Write the snapshot to a file.
+    void write(const std::filesystem::path& path) const;
+
+    /// Type layout of the global parameters (null if the snapshot was not created from a program).
+    ref<const TypeLayoutSnapshot> globals_type_layout() const { return m_globals_type_layout; }
+
+    /// Entry points.
+    const std::vector<EntryPoint>& entry_points() const { return m_entry_points; }
+
+    /// Find an entry point by name. Returns \c nullptr if not found.
+    const EntryPoint* find_entry_point_by_name(std::string_view name) const;
+
+    /// Named type layouts.
+    const std::map<std::string, ref<const TypeLayoutSnapshot>, std::less<>>& type_layouts() const
+    {
+        return m_type_layouts;
+    }
+
+    /// Find a type layout by name. Returns \c nullptr if not found.
+    ref<const TypeLayoutSnapshot> find_type_layout(std::string_view name) const;
+
+    std::string to_string() const override;
+
+private:
+    ReflectionSnapshot() = default;
+
+    ref<const TypeLayoutSnapshot> snapshot_type_layout(const TypeLayoutReflection* type_layout);
+    TypeLayoutSnapshot::Field snapshot_field(const VariableLayoutReflection* variable_layout);
+
+    ref<const TypeLayoutSnapshot> m_globals_type_layout;
+    std::vector<EntryPoint> m_entry_points;
+    std::map<std::string, ref<const TypeLayoutSnapshot>, std::less<>> m_type_layouts;
+
+    /// All type layouts of the snapshot (used for deduplication and serialization).
+    std::vector<ref<TypeLayoutSnapshot>> m_all_type_layouts;
+    std::map<const void*, TypeLayoutSnapshot*> m_slang_type_layouts;
+};
+
+} // namespace sgl
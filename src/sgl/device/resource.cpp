@@ -343,9 +343,18 @@ Buffer::Buffer(ref<Device> device, BufferDesc desc)
     if (!m_desc.debug_name.empty())
         m_gfx_buffer->setDebugName(m_desc.debug_name.c_str());
 
+    m_host_visible = m_desc.memory_type != MemoryType::device_local || m_device->_is_host_visible(this);
+
     // Upload init data.
-    if (m_desc.data)
-        set_data(m_desc.data, m_desc.data_size);
+    if (m_desc.data) {
+        if (m_desc.memory_type == MemoryType::device_local && m_host_visible) {
+            // The buffer is not in use by the device yet, write directly without staging.
+            std::memcpy(map(), m_desc.data, m_desc.data_size);
+            unmap();
+        } else {
+            set_data(m_desc.data, m_desc.data_size);
+        }
+    }
 
     // Clear initial data fields in desc.
     m_desc.data = nullptr;
@@ -359,7 +368,7 @@ Buffer::~Buffer()
 
 void* Buffer::map() const
 {
-    SGL_ASSERT(m_desc.memory_type != MemoryType::device_local);
+    SGL_ASSERT(m_host_visible);
     SGL_ASSERT(m_mapped_ptr == nullptr);
     SLANG_CALL(m_gfx_buffer->map(nullptr, &m_mapped_ptr));
     return m_mapped_ptr;
@@ -367,7 +376,7 @@ void* Buffer::map() const
 
 void* Buffer::map(DeviceAddress offset, DeviceSize size) const
 {
-    SGL_ASSERT(m_desc.memory_type != MemoryType::device_local);
+    SGL_ASSERT(m_host_visible);
     SGL_ASSERT(m_mapped_ptr == nullptr);
     gfx::MemoryRange gfx_read_range{
         .offset = offset,
@@ -379,7 +388,7 @@ void* Buffer::map(DeviceAddress offset, DeviceSize size) const
 
 void Buffer::unmap() const
 {
-    SGL_ASSERT(m_desc.memory_type != MemoryType::device_local);
+    SGL_ASSERT(m_host_visible);
     SGL_ASSERT(m_mapped_ptr != nullptr);
     SLANG_CALL(m_gfx_buffer->unmap(nullptr));
     m_mapped_ptr = nullptr;
@@ -397,7 +406,11 @@ void Buffer::set_data(const void* data, size_t size, DeviceOffset offset)
 
     switch (m_desc.memory_type) {
     case MemoryType::device_local:
-        m_device->upload_buffer_data(this, data, size, offset);
+        // Write directly to persistently mapped buffers in host visible device local memory.
+        if (is_mapped())
+            std::memcpy(static_cast<uint8_t*>(m_mapped_ptr) + offset, data, size);
+        else
+            m_device->upload_buffer_data(this, data, size, offset);
         break;
     case MemoryType::upload: {
         bool was_mapped = is_mapped();
@@ -425,7 +438,10 @@ void Buffer::get_data(void* data, size_t size, DeviceOffset offset)
 
     switch (m_desc.memory_type) {
     case MemoryType::device_local:
-        m_device->read_buffer_data(this, data, size, offset);
+        if (is_mapped())
+            std::memcpy(data, static_cast<const uint8_t*>(m_mapped_ptr) + offset, size);
+        else
+            m_device->read_buffer_data(this, data, size, offset);
         break;
     case MemoryType::upload:
         SGL_THROW("Cannot read data from buffer with memory type 'upload'.");
@@ -802,6 +818,17 @@ DeviceResource::MemoryUsage Texture::memory_usage() const
 }
 
 ref<Bitmap> Texture::to_bitmap(uint32_t mip_level, uint32_t array_slice) const
+{
+    ref<Bitmap> bitmap = create_bitmap(mip_level, array_slice);
+
+    // Read back directly into the (pool allocated) bitmap storage.
+    uint32_t subresource = get_subresource_index(mip_level, array_slice);
+    m_device->read_texture_data(this, subresource, bitmap->data(), bitmap->buffer_size());
+
+    return bitmap;
+}
+
+ref<Bitmap> Texture::create_bitmap(uint32_t mip_level, uint32_t array_slice) const
 {
     SGL_CHECK_LT(mip_level, mip_count());
     SGL_CHECK_LT(array_slice, array_size());
@@ -884,19 +911,12 @@ ref<Bitmap> Texture::to_bitmap(uint32_t mip_level, uint32_t array_slice) const
         SGL_THROW("Unsupported channel bits.");
     Bitmap::ComponentType component_type = it2->second;
 
-    uint32_t subresource = get_subresource_index(mip_level, array_slice);
-    OwnedSubresourceData subresource_data = get_subresource_data(subresource);
-
     uint32_t width = get_mip_width(mip_level);
     uint32_t height = get_mip_height(mip_level);
 
     ref<Bitmap> bitmap = ref<Bitmap>(new Bitmap(pixel_format, component_type, width, height));
     bitmap->set_srgb_gamma(info.is_srgb_format());
 
-    // TODO would be better to avoid this extra copy
-    SGL_ASSERT(bitmap->buffer_size() == subresource_data.size);
-    std::memcpy(bitmap->data(), subresource_data.data, subresource_data.size);
-
     return bitmap;
 }
 
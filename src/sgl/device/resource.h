@@ -436,8 +436,17 @@ public:
     Format format() const override { return m_desc.format; }
     MemoryType memory_type() const { return m_desc.memory_type; }
 
+    /// True if the buffer memory can be mapped to host memory.
+    /// This is always the case for \c MemoryType::upload and \c MemoryType::read_back buffers.
+    /// Device local buffers are host visible on devices with host visible device local memory
+    /// (see \c DeviceInfo::host_visible_device_local_memory).
+    bool is_host_visible() const { return m_host_visible; }
+
     /// Map the whole buffer.
-    /// Only available for buffers created with \c MemoryType::upload or \c MemoryType::read_back.
+    /// Only available for host visible buffers (see \c is_host_visible).
+    /// Host visible device local buffers can be kept mapped, in which case \c set_data and \c get_data
+    /// access the memory directly instead of going through a staging buffer. The caller is then responsible
+    /// for not modifying data that is still in use by the device.
     void* map() const;
 
     template<typename T>
@@ -447,7 +456,7 @@ public:
     }
 
     /// Map a range of the buffer.
-    /// Only available for buffers created with \c MemoryType::upload or \c MemoryType::read_back.
+    /// Only available for host visible buffers (see \c is_host_visible).
     void* map(DeviceOffset offset, DeviceSize size) const;
 
     template<typename T>
@@ -464,6 +473,7 @@ public:
 
     /**
      * Set buffer data from host memory.
+     * \note Writes to device local buffers go through a staging buffer unless the buffer is mapped.
      *
      * \param data Data to write.
      * \param size Size of the data in bytes.
@@ -533,6 +543,7 @@ private:
     BufferDesc m_desc;
     Slang::ComPtr<gfx::IBufferResource> m_gfx_buffer;
 
+    bool m_host_visible{false};
     mutable void* m_mapped_ptr{nullptr};
 };
 
@@ -690,6 +701,9 @@ public:
 
     ref<Bitmap> to_bitmap(uint32_t mip_level = 0, uint32_t array_slice = 0) const;
 
+    /// Create a bitmap matching the size and format of a subresource without reading back its data.
+    ref<Bitmap> create_bitmap(uint32_t mip_level = 0, uint32_t array_slice = 0) const;
+
     std::string to_string() const override;
 
 private:
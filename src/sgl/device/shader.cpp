@@ -5,6 +5,8 @@
 #include "sgl/device/device.h"
 #include "sgl/device/helpers.h"
 #include "sgl/device/reflection.h"
+#include "sgl/device/shader_archive.h"
+#include "sgl/device/reflection_snapshot.h"
 #include "sgl/device/kernel.h"
 #include "sgl/device/print.h"
 #include "sgl/device/slang_utils.h"
@@ -18,13 +20,31 @@
 #include "sgl/core/crypto.h"
 #include "sgl/core/timer.h"
 #include "sgl/core/file_stream.h"
+#include "sgl/core/metrics.h"
 
 #include <slang.h>
 
+#include <atomic>
 #include <random>
 
 namespace sgl {
 
+static Histogram& s_module_load_histogram = MetricsRegistry::get().histogram(
+    "sgl_slang_module_load_ms",
+    "Time spent loading (compiling) slang modules in milliseconds.",
+    Histogram::exponential_bounds(1.0, 2.0, 16)
+);
+static Histogram& s_archive_program_load_histogram = MetricsRegistry::get().histogram(
+    "sgl_shader_archive_program_load_ms",
+    "Time spent loading programs from shader archives in milliseconds (including linking).",
+    Histogram::exponential_bounds(1.0, 2.0, 16)
+);
+static Histogram& s_program_link_histogram = MetricsRegistry::get().histogram(
+    "sgl_shader_program_link_ms",
+    "Time spent linking shader programs in milliseconds.",
+    Histogram::exponential_bounds(1.0, 2.0, 16)
+);
+
 // ----------------------------------------------------------------------------
 // TypeConformance
 // ----------------------------------------------------------------------------
@@ -296,12 +316,17 @@ void SlangSession::create_session(SlangSessionBuild& build)
     // Slang will search for files in the order they are specified.
     // Use provided include paths first, followed by default include paths.
     // Keep a copy of the include paths for local resolution of module names.
+    std::filesystem::path default_include_path = platform::runtime_directory() / "shaders";
     data->include_paths = options.include_paths;
     if (m_desc.add_default_include_paths)
-        data->include_paths.push_back(platform::runtime_directory() / "shaders");
+        data->include_paths.push_back(default_include_path);
     for (const auto& path : data->include_paths)
         session_options.add_include(path);
 
+    // Serve sgl's internal shaders from the sources embedded in the library instead of reading them from disk.
+    data->file_system = Slang::ComPtr<SlangFileSystem>(new SlangFileSystem(default_include_path));
+    session_desc.fileSystem = data->file_system;
+
     // Set macro defines.
     for (const auto& define : options.defines)
         session_options.add_macro_define(define.first, define.second);
@@ -370,8 +395,11 @@ void SlangSession::create_session(SlangSessionBuild& build)
     );
 #endif
 
-    // Add device print enable flag.
+    // Add device print and message channel enable flags.
     session_options.add_macro_define("SGL_ENABLE_PRINT", m_device->desc().enable_print ? "1" : "0");
+    // The default session is created before the message channel, so derive the flag from the device desc.
+    bool enable_message_channel = m_device->desc().enable_print || m_device->desc().enable_message_channel;
+    session_options.add_macro_define("SGL_ENABLE_MESSAGE_CHANNEL", enable_message_channel ? "1" : "0");
 
     auto slang_target_option_entries = target_options.slang_entries();
     target_desc.compilerOptionEntries = slang_target_option_entries.data();
@@ -512,7 +540,7 @@ ref<ShaderProgram> SlangSession::load_program(
     ref<SlangModule> module = load_module(module_name);
     std::vector<ref<SlangModule>> modules{module};
     // TODO improve the way we generate unique names for additional sources
-    static uint32_t id = 0;
+    static std::atomic<uint32_t> id = 0;
     if (additional_source)
         modules.push_back(load_module_from_source(fmt::format("additional_source_{}", id++), *additional_source));
     std::vector<ref<SlangEntryPoint>> entry_points;
@@ -521,19 +549,60 @@ ref<ShaderProgram> SlangSession::load_program(
     return link_program(std::move(modules), std::move(entry_points), link_options);
 }
 
+ref<ShaderProgram> SlangSession::load_program_from_archive(
+    ref<const ShaderArchive> archive,
+    std::string_view program_name,
+    std::optional<SlangLinkOptions> link_options
+)
+{
+    SGL_CHECK_NOT_NULL(archive);
+    archive->check_compatible(m_device);
+
+    const ShaderArchive::Program* archive_program = archive->find_program(program_name);
+    SGL_CHECK(archive_program, "Program \"{}\" not found in shader archive.", program_name);
+
+    Timer timer;
+
+    // Load all required modules in order, the last module contains the entry points.
+    std::vector<ref<SlangModule>> modules;
+    for (uint32_t index : archive_program->module_indices) {
+        ref<SlangModule> module = make_ref<SlangModule>(
+            ref(this),
+            SlangModuleDesc{
+                .module_name = archive->modules()[index].name,
+                .archive = archive,
+            }
+        );
+        SlangSessionBuild build;
+        build.session = m_data;
+        module->load(build);
+        module->store_built_data(build);
+        modules.push_back(module);
+    }
+    update_module_cache_and_dependencies();
+
+    std::vector<ref<SlangEntryPoint>> entry_points;
+    for (const std::string& entry_point_name : archive_program->entry_point_names)
+        entry_points.push_back(modules.back()->entry_point(entry_point_name));
+    ref<ShaderProgram> program = link_program(std::move(modules), std::move(entry_points), link_options);
+
+    s_archive_program_load_histogram.observe(timer.elapsed_ms());
+    log_debug(
+        "Loading program \"{}\" from shader archive took {}",
+        program_name,
+        string::format_duration(timer.elapsed_s())
+    );
+
+    return program;
+}
+
 std::string SlangSession::load_source(std::string_view module_name)
 {
     std::string resolved_name = m_data->resolve_module_name(module_name);
 
     for (const std::filesystem::path& include_path : m_data->include_paths) {
-        std::filesystem::path full_path = include_path / resolved_name;
-        if (std::filesystem::exists(full_path)) {
-            FileStream stream(full_path, FileStream::Mode::read);
-            std::string result;
-            result.resize(stream.size());
-            stream.read(result.data(), result.size());
-            return result;
-        }
+        if (std::optional<std::string> source = m_data->file_system->read(include_path / resolved_name))
+            return std::move(*source);
     }
     SGL_THROW("Failed to load source for module \"{}\"", module_name);
 }
@@ -659,9 +728,39 @@ bool SlangSession::write_module_to_cache(slang::IModule* module)
 
     log_debug("Cached slang module \"{}\" to \"{}\"", module->getName(), cache_path);
 
+    write_reflection_snapshot_to_cache(module, cache_path);
+
     return true;
 }
 
+void SlangSession::write_reflection_snapshot_to_cache(slang::IModule* module, const std::filesystem::path& cache_path)
+{
+    // Store a reflection snapshot next to the cached module, so tools that only need layouts
+    // can load them without compiling the module (see ReflectionSnapshot).
+    std::filesystem::path snapshot_path = cache_path;
+    snapshot_path.replace_extension(".slang-reflection");
+    std::filesystem::path tmp_path = snapshot_path;
+    std::random_device rd;
+    uint64_t uid = rd();
+    tmp_path.replace_extension(".slang-reflection-" + string::hexlify(&uid, sizeof(uid)));
+
+    std::error_code ec;
+    try {
+        ref<const ProgramLayout> layout = ProgramLayout::from_slang(ref(this), module->getLayout());
+        ReflectionSnapshot::from_program_layout(layout)->write(tmp_path);
+    } catch (const std::exception& e) {
+        log_warn("Failed to write reflection snapshot of slang module \"{}\" ({})", module->getName(), e.what());
+        std::filesystem::remove(tmp_path, ec);
+        return;
+    }
+
+    std::filesystem::rename(tmp_path, snapshot_path, ec);
+    if (ec) {
+        log_warn("Failed to rename reflection snapshot \"{}\" to \"{}\" ({})", tmp_path, snapshot_path, ec.message());
+        std::filesystem::remove(tmp_path, ec);
+    }
+}
+
 std::string SlangSessionData::resolve_module_name(std::string_view module_name) const
 {
     // Return if module name is an absolute file path.
@@ -671,8 +770,7 @@ std::string SlangSessionData::resolve_module_name(std::string_view module_name)
 
     // Return relative path if module name is a relative path within the include paths.
     for (const std::filesystem::path& include_path : include_paths) {
-        std::filesystem::path full_path = include_path / path;
-        if (std::filesystem::exists(full_path))
+        if (file_system->exists(include_path / path))
             return path.string();
     }
 
@@ -682,8 +780,7 @@ std::string SlangSessionData::resolve_module_name(std::string_view module_name)
     str += ".slang";
     path = str;
     for (const std::filesystem::path& include_path : include_paths) {
-        std::filesystem::path full_path = include_path / path;
-        if (std::filesystem::exists(full_path))
+        if (file_system->exists(include_path / path))
             return path.string();
     }
 
@@ -691,6 +788,16 @@ std::string SlangSessionData::resolve_module_name(std::string_view module_name)
     return std::string{module_name};
 }
 
+slang::IModule* SlangSessionData::find_loaded_module(std::string_view module_name) const
+{
+    for (SlangInt i = 0; i < slang_session->getLoadedModuleCount(); ++i) {
+        slang::IModule* module = slang_session->getLoadedModule(i);
+        if (module_name == module->getName())
+            return module;
+    }
+    return nullptr;
+}
+
 SlangModule::SlangModule(ref<SlangSession> session, const SlangModuleDesc& desc)
     : m_session(std::move(session))
     , m_desc(desc)
@@ -712,8 +819,29 @@ void SlangModule::load(SlangSessionBuild& build_data) const
     const SlangModuleDesc& desc = m_desc;
     const SlangSessionData* session_data = build_data.session.get();
 
-    // Load module either from resolved name or source depending on whether source specified
-    if (!desc.source.has_value()) {
+    // Load module either from archive, resolved name or source depending on the descriptor.
+    if (desc.archive) {
+        // Modules shared by multiple programs of an archive are only loaded once.
+        slang_module = session_data->find_loaded_module(desc.module_name);
+        if (!slang_module) {
+            const ShaderArchive::Module* archive_module = desc.archive->find_module(desc.module_name);
+            SGL_CHECK(archive_module, "Module \"{}\" not found in shader archive.", desc.module_name);
+            UnownedSlangBlob blob(archive_module->data.data(), archive_module->data.size());
+            slang_module = session_data->slang_session->loadModuleFromIRBlob(
+                archive_module->name.c_str(),
+                archive_module->path.c_str(),
+                &blob,
+                diagnostics.writeRef()
+            );
+            if (!slang_module) {
+                std::string msg = append_diagnostics(
+                    fmt::format("Failed to load slang module \"{}\" from shader archive", desc.module_name),
+                    diagnostics
+                );
+                throw SlangCompileError(msg);
+            }
+        }
+    } else if (!desc.source.has_value()) {
         std::string resolved_name = session_data->resolve_module_name(desc.module_name);
         slang_module = session_data->slang_session->loadModule(resolved_name.c_str(), diagnostics.writeRef());
         if (!slang_module) {
@@ -723,7 +851,7 @@ void SlangModule::load(SlangSessionBuild& build_data) const
         }
     } else {
         // TODO workaround: slang doesn't like loading the same source twice
-        static uint32_t id = 0;
+        static std::atomic<uint32_t> id = 0;
         std::string source_str = fmt::format("// {}\n{}", id++, desc.source);
 
         slang_module = session_data->slang_session->loadModuleFromSourceString(
@@ -742,6 +870,7 @@ void SlangModule::load(SlangSessionBuild& build_data) const
     }
 
     report_diagnostics(diagnostics);
+    s_module_load_histogram.observe(timer.elapsed_ms());
     log_debug("Loading slang module \"{}\" took {}", desc.module_name, string::format_duration(timer.elapsed_s()));
 
     // Register with debug printer.
@@ -1143,6 +1272,7 @@ void ShaderProgram::link(SlangSessionBuild& build_data) const
         auto entry_point_data = build_data.entry_points[entry_point];
         name += (name.empty() ? "" : ", ") + module_data->name + ":" + entry_point_data->name;
     }
+    s_program_link_histogram.observe(timer.elapsed_ms());
     log_debug("Linking shader program \"{}\" took {}", name, string::format_duration(timer.elapsed_s()));
 
     auto data = make_ref<ShaderProgramData>();
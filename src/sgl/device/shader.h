@@ -6,6 +6,7 @@
 #include "sgl/device/types.h"
 #include "sgl/device/reflection.h"
 #include "sgl/device/device_resource.h"
+#include "sgl/device/slang_file_system.h"
 
 #include "sgl/core/object.h"
 #include "sgl/core/enum.h"
@@ -247,6 +248,9 @@ struct SlangSessionData : Object {
     /// List of include paths used for resolving module/include paths.
     std::vector<std::filesystem::path> include_paths;
 
+    /// File system used by the slang session (serves embedded internal shaders).
+    Slang::ComPtr<SlangFileSystem> file_system;
+
     /// True if session cache is enabled.
     bool cache_enabled{false};
 
@@ -258,6 +262,9 @@ struct SlangSessionData : Object {
 
     /// Finds fully qualified module name by scanning the cache and include paths.
     std::string resolve_module_name(std::string_view module_name) const;
+
+    /// Finds a module with the given name that is already loaded in the session.
+    slang::IModule* find_loaded_module(std::string_view module_name) const;
 };
 
 /// A slang session, used to load modules and link programs.
@@ -300,6 +307,23 @@ public:
         std::optional<SlangLinkOptions> link_options = {}
     );
 
+    /**
+     * \brief Load a program from a shader archive.
+     *
+     * Modules are loaded from their serialized IR stored in the archive, without compiling any shader source.
+     * Modules that are already loaded in this session are reused. The program is linked as usual.
+     *
+     * \param archive Shader archive.
+     * \param program_name Name of the program in the archive.
+     * \param link_options Optional link options.
+     * \return Linked program.
+     */
+    ref<ShaderProgram> load_program_from_archive(
+        ref<const ShaderArchive> archive,
+        std::string_view program_name,
+        std::optional<SlangLinkOptions> link_options = {}
+    );
+
     /// Load the source code for a given module.
     std::string load_source(std::string_view module_name);
 
@@ -337,6 +361,7 @@ private:
 
     void update_module_cache_and_dependencies();
     bool write_module_to_cache(slang::IModule* module);
+    void write_reflection_snapshot_to_cache(slang::IModule* module, const std::filesystem::path& cache_path);
     void create_session(SlangSessionBuild& build);
 };
 
@@ -349,6 +374,9 @@ struct SlangModuleDesc {
 
     /// If source specified, additional path for compilation.
     std::optional<std::filesystem::path> path;
+
+    /// Optional shader archive. If specified, the module is loaded from the serialized IR stored in the archive.
+    ref<const ShaderArchive> archive;
 };
 
 struct SlangModuleData : Object {
@@ -0,0 +1,273 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "shader_archive.h"
+
+#include "sgl/device/device.h"
+#include "sgl/device/shader.h"
+#include "sgl/device/helpers.h"
+
+#include "sgl/core/error.h"
+#include "sgl/core/file_stream.h"
+#include "sgl/core/logger.h"
+#include "sgl/core/string.h"
+#include "sgl/core/timer.h"
+#include "sgl/core/type_utils.h"
+
+#include <slang.h>
+#include <slang-com-ptr.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+namespace sgl {
+
+namespace {
+
+    /// Archive file magic ("SGLA").
+    constexpr uint32_t ARCHIVE_MAGIC = 0x414c4753;
+    constexpr uint32_t ARCHIVE_VERSION = 1;
+
+    void write_u32(Stream* stream, uint32_t value)
+    {
+        stream->write(&value, sizeof(value));
+    }
+
+    void write_string(Stream* stream, std::string_view str)
+    {
+        write_u32(stream, narrow_cast<uint32_t>(str.size()));
+        stream->write(str.data(), str.size());
+    }
+
+    uint32_t read_u32(Stream* stream)
+    {
+        uint32_t value;
+        stream->read(&value, sizeof(value));
+        return value;
+    }
+
+    /// Read a size and check that the remaining stream holds at least \c size elements of \c element_size bytes.
+    size_t read_size(Stream* stream, size_t element_size)
+    {
+        size_t size = read_u32(stream);
+        SGL_CHECK(size * element_size <= stream->size() - stream->tell(), "Invalid shader archive (truncated data).");
+        return size;
+    }
+
+    std::string read_string(Stream* stream)
+    {
+        std::string str(read_size(stream, 1), '\0');
+        stream->read(str.data(), str.size());
+        return str;
+    }
+
+} // namespace
+
+ShaderArchive::ShaderArchive(const std::filesystem::path& path)
+{
+    FileStream stream(path, FileStream::Mode::read);
+
+    SGL_CHECK(read_u32(&stream) == ARCHIVE_MAGIC, "\"{}\" is not a shader archive.", path);
+    uint32_t version = read_u32(&stream);
+    SGL_CHECK(version == ARCHIVE_VERSION, "Unsupported shader archive version {} in \"{}\".", version, path);
+
+    m_device_type = static_cast<DeviceType>(read_u32(&stream));
+    m_compiler_version = read_string(&stream);
+
+    m_modules.resize(read_size(&stream, sizeof(uint32_t)));
+    for (Module& module : m_modules) {
+        module.name = read_string(&stream);
+        module.path = read_string(&stream);
+        module.data.resize(read_size(&stream, 1));
+        stream.read(module.data.data(), module.data.size());
+    }
+
+    m_programs.resize(read_size(&stream, sizeof(uint32_t)));
+    for (Program& program : m_programs) {
+        program.name = read_string(&stream);
+        program.entry_point_names.resize(read_size(&stream, sizeof(uint32_t)));
+        for (std::string& name : program.entry_point_names)
+            name = read_string(&stream);
+        program.module_indices.resize(read_size(&stream, sizeof(uint32_t)));
+        for (uint32_t& index : program.module_indices) {
+            index = read_u32(&stream);
+            SGL_CHECK(index < m_modules.size(), "Invalid shader archive (module index out of range).");
+        }
+        SGL_CHECK(!program.module_indices.empty(), "Invalid shader archive (program without modules).");
+    }
+}
+
+ref<ShaderArchive> ShaderArchive::build(Device* device, std::span<const ShaderArchiveProgramDesc> programs)
+{
+    SGL_CHECK_NOT_NULL(device);
+
+    ref<ShaderArchive> archive(new ShaderArchive());
+    archive->m_device_type = device->type();
+    archive->m_compiler_version = device->global_session()->getBuildTagString();
+
+    // Compile the programs in a new session, so only modules loaded for these programs end up in the archive.
+    ref<SlangSession> session = device->create_slang_session({
+        .compiler_options = device->desc().compiler_options,
+        .add_default_include_paths = true,
+    });
+
+    std::set<std::string, std::less<>> program_names;
+    std::vector<ref<ShaderProgram>> linked_programs;
+    std::vector<slang::IModule*> program_modules;
+    for (const ShaderArchiveProgramDesc& desc : programs) {
+        SGL_CHECK(program_names.insert(desc.name).second, "Duplicate program name \"{}\".", desc.name);
+        Timer timer;
+        ref<SlangModule> module = session->load_module(desc.module_name);
+        std::vector<ref<SlangEntryPoint>> entry_points;
+        for (const std::string& entry_point_name : desc.entry_point_names)
+            entry_points.push_back(module->entry_point(entry_point_name));
+        linked_programs.push_back(session->link_program({module}, std::move(entry_points)));
+        program_modules.push_back(module->slang_module());
+        log_info("Compiled program \"{}\" in {}", desc.name, string::format_duration(timer.elapsed_s()));
+    }
+
+    // File dependencies of a module include the files of all transitively imported modules.
+    // Ordering the loaded modules by their number of file dependencies yields a valid load order.
+    auto dependency_paths = [](slang::IModule* module)
+    {
+        std::set<std::string, std::less<>> paths;
+        for (SlangInt32 i = 0; i < module->getDependencyFileCount(); ++i)
+            paths.insert(module->getDependencyFilePath(i));
+        return paths;
+    };
+
+    slang::ISession* slang_session = session->get_slang_session();
+    std::vector<slang::IModule*> loaded_modules;
+    for (SlangInt i = 0; i < slang_session->getLoadedModuleCount(); ++i)
+        loaded_modules.push_back(slang_session->getLoadedModule(i));
+    std::stable_sort(
+        loaded_modules.begin(),
+        loaded_modules.end(),
+        [](slang::IModule* a, slang::IModule* b) { return a->getDependencyFileCount() < b->getDependencyFileCount(); }
+    );
+
+    // Determine the modules required by each program.
+    std::vector<std::vector<slang::IModule*>> required_modules(programs.size());
+    std::set<slang::IModule*> used_modules;
+    for (size_t i = 0; i < programs.size(); ++i) {
+        auto paths = dependency_paths(program_modules[i]);
+        for (slang::IModule* module : loaded_modules) {
+            const char* path = module->getFilePath();
+            if (module == program_modules[i] || (path && paths.contains(path))) {
+                required_modules[i].push_back(module);
+                used_modules.insert(module);
+            }
+        }
+        // Make sure the module containing the entry points is loaded last.
+        std::erase(required_modules[i], program_modules[i]);
+        required_modules[i].push_back(program_modules[i]);
+    }
+
+    // Serialize all used modules.
+    std::map<slang::IModule*, uint32_t> module_indices;
+    for (slang::IModule* module : loaded_modules) {
+        if (!used_modules.contains(module))
+            continue;
+        Slang::ComPtr<ISlangBlob> blob;
+        SLANG_CALL(module->serialize(blob.writeRef()));
+        const uint8_t* data = static_cast<const uint8_t*>(blob->getBufferPointer());
+        module_indices[module] = narrow_cast<uint32_t>(archive->m_modules.size());
+        archive->m_modules.push_back({
+            .name = module->getName(),
+            .path = module->getFilePath() ? module->getFilePath() : "",
+            .data = std::vector<uint8_t>(data, data + blob->getBufferSize()),
+        });
+    }
+
+    for (size_t i = 0; i < programs.size(); ++i) {
+        Program program{
+            .name = programs[i].name,
+            .entry_point_names = programs[i].entry_point_names,
+        };
+        for (slang::IModule* module : required_modules[i])
+            program.module_indices.push_back(module_indices[module]);
+        archive->m_programs.push_back(std::move(program));
+    }
+
+    return archive;
+}
+
+void ShaderArchive::write(const std::filesystem::path& path) const
+{
+    FileStream stream(path, FileStream::Mode::write);
+
+    write_u32(&stream, ARCHIVE_MAGIC);
+    write_u32(&stream, ARCHIVE_VERSION);
+    write_u32(&stream, static_cast<uint32_t>(m_device_type));
+    write_string(&stream, m_compiler_version);
+
+    write_u32(&stream, narrow_cast<uint32_t>(m_modules.size()));
+    for (const Module& module : m_modules) {
+        write_string(&stream, module.name);
+        write_string(&stream, module.path);
+        write_u32(&stream, narrow_cast<uint32_t>(module.data.size()));
+        stream.write(module.data.data(), module.data.size());
+    }
+
+    write_u32(&stream, narrow_cast<uint32_t>(m_programs.size()));
+    for (const Program& program : m_programs) {
+        write_string(&stream, program.name);
+        write_u32(&stream, narrow_cast<uint32_t>(program.entry_point_names.size()));
+        for (const std::string& name : program.entry_point_names)
+            write_string(&stream, name);
+        write_u32(&stream, narrow_cast<uint32_t>(program.module_indices.size()));
+        for (uint32_t index : program.module_indices)
+            write_u32(&stream, index);
+    }
+}
+
+const ShaderArchive::Module* ShaderArchive::find_module(std::string_view name) const
+{
+    auto it = std::find_if(m_modules.begin(), m_modules.end(), [name](const Module& m) { return m.name == name; });
+    return it != m_modules.end() ? &*it : nullptr;
+}
+
+const ShaderArchive::Program* ShaderArchive::find_program(std::string_view name) const
+{
+    auto it = std::find_if(m_programs.begin(), m_programs.end(), [name](const Program& p) { return p.name == name; });
+    return it != m_programs.end() ? &*it : nullptr;
+}
+
+void ShaderArchive::check_compatible(Device* device) const
+{
+    SGL_CHECK_NOT_NULL(device);
+    SGL_CHECK(
+        m_device_type == device->type(),
+        "Shader archive was built for device type \"{}\" but the device type is \"{}\".",
+        m_device_type,
+        device->type()
+    );
+    std::string compiler_version = device->global_session()->getBuildTagString();
+    SGL_CHECK(
+        m_compiler_version == compiler_version,
+        "Shader archive was built with slang \"{}\" but the device uses slang \"{}\".",
+        m_compiler_version,
+        compiler_version
+    );
+}
+
+std::string ShaderArchive::to_string() const
+{
+    std::vector<std::string> program_names;
+    for (const Program& program : m_programs)
+        program_names.push_back(program.name);
+    return fmt::format(
+        "ShaderArchive(\n"
+        "  device_type = {},\n"
+        "  compiler_version = \"{}\",\n"
+        "  module_count = {},\n"
+        "  programs = [{}]\n"
+        ")",
+        m_device_type,
+        m_compiler_version,
+        m_modules.size(),
+        string::join(program_names, ", ")
+    );
+}
+
+} // namespace sgl
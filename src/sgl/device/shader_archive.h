@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sgl/device/fwd.h"
+#include "sgl/device/device.h"
+
+#include "sgl/core/object.h"
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sgl {
+
+/// Describes a program to be stored in a shader archive.
+struct ShaderArchiveProgramDesc {
+    /// Name used to look up the program in the archive.
+    std::string name;
+    /// Name of the module containing the entry points.
+    std::string module_name;
+    /// Names of the entry points to link.
+    std::vector<std::string> entry_point_names;
+};
+
+/**
+ * \brief Cache of slang front-end output (serialized IR) for a fixed set of programs.
+ *
+ * Archives are built offline (see \c ShaderArchive::build and the \c sgl_shader_archive tool)
+ * and store the serialized slang IR of all modules required by the listed programs, together
+ * with a manifest of the programs. Loading a program from an archive (see
+ * \c Device::load_program_from_archive) skips the slang front end: no shader source is parsed,
+ * checked or lowered to IR.
+ *
+ * Archives do not store target binaries or reflection. gfx only creates pipelines from linked
+ * slang programs, and sgl builds the program reflection from them, so loaded programs are
+ * still linked by the slang compiler, and target code is generated when a pipeline is created.
+ * Repeated target code generation is avoided by the device shader cache.
+ *
+ * Archives are specific to a device type and the slang compiler version used to build them.
+ */
+class SGL_API ShaderArchive : public Object {
+    SGL_OBJECT(ShaderArchive)
+public:
+    /// Serialized slang module.
+    struct Module {
+        /// Module name.
+        std::string name;
+        /// Module source path at the time the archive was built.
+        std::string path;
+        /// Serialized slang IR.
+        std::vector<uint8_t> data;
+    };
+
+    /// Program manifest entry.
+    struct Program {
+        /// Program name.
+        std::string name;
+        /// Names of the entry points to link.
+        std::vector<std::string> entry_point_names;
+        /// Indices of the modules required by the program in load order.
+        /// The last module contains the entry points.
+        std::vector<uint32_t> module_indices;
+    };
+
+    /// Load an archive from a file.
+    explicit ShaderArchive(const std::filesystem::path& path);
+
+    /**
+     * \brief Build an archive by compiling a set of programs.
+     *
+     * Programs are compiled in a new slang session using the compiler options of the device.
+     *
+     * \param device Device to compile the programs for.
+     * \param programs List of programs to store in the archive.
+     * \return New shader archive.
+     */
+    static ref<ShaderArchive> build(Device* device, std::span<const ShaderArchiveProgramDesc> programs);
+
+    /// Write the archive to a file.
+    void write(const std::filesystem::path& path) const;
+
+    /// Device type the archive was built for.
+    DeviceType device_type() const { return m_device_type; }
+
+    /// Slang compiler version (build tag) the archive was built with.
+    const std::string& compiler_version() const { return m_compiler_version; }
+
+    /// Serialized modules in load order.
+    const std::vector<Module>& modules() const { return m_modules; }
+
+    /// Programs stored in the archive.
+    const std::vector<Program>& programs() const { return m_programs; }
+
+    /// Find a module by name. Returns \c nullptr if the module is not in the archive.
+    const Module* find_module(std::string_view name) const;
+
+    /// Find a program by name. Returns \c nullptr if the program is not in the archive.
+    const Program* find_program(std::string_view name) const;
+
+    /// Returns true if the archive contains a program with the given name.
+    bool has_program(std::string_view name) const { return find_program(name) != nullptr; }
+
+    /// Check that programs in the archive can be loaded on the given device.
+    void check_compatible(Device* device) const;
+
+    std::string to_string() const override;
+
+private:
+    ShaderArchive() = default;
+
+    DeviceType m_device_type;
+    std::string m_compiler_version;
+    std::vector<Module> m_modules;
+    std::vector<Program> m_programs;
+};
+
+} // namespace sgl
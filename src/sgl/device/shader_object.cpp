@@ -11,8 +11,22 @@
 #include "sgl/device/device.h"
 #include "sgl/device/cuda_interop.h"
 
+#include "sgl/core/metrics.h"
+
+#include <algorithm>
+#include <cstring>
+
 namespace sgl {
 
+static Counter& s_data_write_counter = MetricsRegistry::get().counter(
+    "sgl_shader_object_data_writes_total",
+    "Number of uniform data writes to shader objects."
+);
+static Counter& s_data_commit_counter = MetricsRegistry::get().counter(
+    "sgl_shader_object_data_commits_total",
+    "Number of uniform data commits to gfx shader objects."
+);
+
 inline gfx::ShaderOffset gfx_shader_offset(const ShaderOffset& offset)
 {
     return {
@@ -44,6 +58,8 @@ uint32_t ShaderObject::get_entry_point_count() const
 
 void ShaderObject::set_object(const ShaderOffset& offset, const ref<ShaderObject>& object)
 {
+    if (object)
+        object->commit_data();
     SLANG_CALL(m_shader_object->setObject(gfx_shader_offset(offset), object ? object->gfx_shader_object() : nullptr));
 }
 
@@ -74,7 +90,79 @@ void ShaderObject::set_acceleration_structure(
 
 void ShaderObject::set_data(const ShaderOffset& offset, void const* data, size_t size)
 {
-    SLANG_CALL(m_shader_object->setData(gfx_shader_offset(offset), data, size));
+    s_data_write_counter.add();
+
+    if (m_staged_data.empty()) {
+        size_t data_size = m_shader_object->getSize();
+        m_staged_data.resize(data_size);
+        m_staged_mask.resize(data_size);
+    }
+
+    size_t begin = offset.uniform_offset;
+    size_t end = begin + size;
+    // Pass through writes that cannot be staged, gfx reports invalid ones.
+    if (size == 0 || end > m_staged_data.size()) {
+        s_data_commit_counter.add();
+        SLANG_CALL(m_shader_object->setData(gfx_shader_offset(offset), data, size));
+        return;
+    }
+
+    std::memcpy(m_staged_data.data() + begin, data, size);
+    for (size_t i = begin; i < end; ++i) {
+        m_staged_size += 1 - m_staged_mask[i];
+        m_staged_mask[i] = 1;
+    }
+    if (m_staged_begin == m_staged_end) {
+        m_staged_begin = begin;
+        m_staged_end = end;
+    } else {
+        m_staged_begin = std::min(m_staged_begin, begin);
+        m_staged_end = std::max(m_staged_end, end);
+    }
+}
+
+void ShaderObject::commit_data() const
+{
+    if (m_staged_begin == m_staged_end)
+        return;
+
+    auto commit = [this](size_t begin, size_t end)
+    {
+        s_data_commit_counter.add();
+        SLANG_CALL(m_shader_object->setData(
+            gfx_shader_offset(ShaderOffset(narrow_cast<uint32_t>(begin), 0, 0)),
+            m_staged_data.data() + begin,
+            end - begin
+        ));
+    };
+
+    const uint8_t* current = static_cast<const uint8_t*>(m_shader_object->getRawData());
+    if (m_staged_size == m_staged_end - m_staged_begin) {
+        commit(m_staged_begin, m_staged_end);
+    } else if (current) {
+        // Fill the gaps between written ranges with the current data to commit everything at once.
+        for (size_t i = m_staged_begin; i < m_staged_end; ++i)
+            if (!m_staged_mask[i])
+                m_staged_data[i] = current[i];
+        commit(m_staged_begin, m_staged_end);
+    } else {
+        // Commit each written range separately.
+        size_t i = m_staged_begin;
+        while (i < m_staged_end) {
+            while (i < m_staged_end && !m_staged_mask[i])
+                ++i;
+            size_t begin = i;
+            while (i < m_staged_end && m_staged_mask[i])
+                ++i;
+            if (begin < i)
+                commit(begin, i);
+        }
+    }
+
+    std::fill(m_staged_mask.begin() + m_staged_begin, m_staged_mask.begin() + m_staged_end, uint8_t(0));
+    m_staged_begin = 0;
+    m_staged_end = 0;
+    m_staged_size = 0;
 }
 
 void ShaderObject::set_cuda_tensor_view(const ShaderOffset& offset, const cuda::TensorView& tensor_view, bool is_uav)
@@ -107,19 +195,27 @@ TransientShaderObject::TransientShaderObject(
 
 ref<ShaderObject> TransientShaderObject::get_entry_point(uint32_t index)
 {
-    auto object = make_ref<TransientShaderObject>(m_device, m_shader_object->getEntryPoint(index), m_command_buffer);
-    m_sub_objects.push_back(object);
-    return object;
+    // Sub-objects are cached, so that staged data of each gfx object is held by a single wrapper.
+    if (index >= m_entry_points.size())
+        m_entry_points.resize(index + 1);
+    if (!m_entry_points[index]) {
+        m_entry_points[index]
+            = make_ref<TransientShaderObject>(m_device, m_shader_object->getEntryPoint(index), m_command_buffer);
+    }
+    return m_entry_points[index];
 }
 
 ref<ShaderObject> TransientShaderObject::get_object(const ShaderOffset& offset)
 {
+    auto it = m_sub_objects.find(offset);
+    if (it != m_sub_objects.end())
+        return it->second;
     auto object = make_ref<TransientShaderObject>(
         m_device,
         m_shader_object->getObject(gfx_shader_offset(offset)),
         m_command_buffer
     );
-    m_sub_objects.push_back(object);
+    m_sub_objects.insert({offset, object});
     return object;
 }
 
@@ -153,10 +249,23 @@ void TransientShaderObject::set_resource(const ShaderOffset& offset, const ref<R
     ShaderObject::set_resource(offset, resource_view);
 }
 
+void TransientShaderObject::commit_data() const
+{
+    ShaderObject::commit_data();
+    for (const auto& entry_point : m_entry_points)
+        if (entry_point)
+            entry_point->commit_data();
+    for (const auto& [_, sub_object] : m_sub_objects)
+        sub_object->commit_data();
+}
+
 void TransientShaderObject::get_cuda_interop_buffers(std::vector<ref<cuda::InteropBuffer>>& cuda_interop_buffers) const
 {
     ShaderObject::get_cuda_interop_buffers(cuda_interop_buffers);
-    for (const auto& sub_object : m_sub_objects)
+    for (const auto& entry_point : m_entry_points)
+        if (entry_point)
+            entry_point->get_cuda_interop_buffers(cuda_interop_buffers);
+    for (const auto& [_, sub_object] : m_sub_objects)
         sub_object->get_cuda_interop_buffers(cuda_interop_buffers);
 }
 
@@ -247,6 +356,14 @@ void MutableShaderObject::set_resource_states(CommandBuffer* command_buffer) con
     }
 }
 
+void MutableShaderObject::commit_data() const
+{
+    ShaderObject::commit_data();
+    for (auto& [_, sub_object] : m_sub_objects) {
+        sub_object->commit_data();
+    }
+}
+
 void MutableShaderObject::get_cuda_interop_buffers(std::vector<ref<cuda::InteropBuffer>>& cuda_interop_buffers) const
 {
     ShaderObject::get_cuda_interop_buffers(cuda_interop_buffers);
@@ -35,8 +35,15 @@ public:
     virtual void set_sampler(const ShaderOffset& offset, const ref<Sampler>& sampler);
     virtual void
     set_acceleration_structure(const ShaderOffset& offset, const ref<AccelerationStructure>& acceleration_structure);
+    /// Write uniform data.
+    /// Writes are staged on the host and committed to the underlying gfx object by \c commit_data(),
+    /// so writing many fields (e.g. a whole struct) results in a single \c setData call.
     virtual void set_data(const ShaderOffset& offset, void const* data, size_t size);
 
+    /// Commit staged uniform data of this object and its sub-objects.
+    /// Called automatically when the object is bound, set as a sub-object or used for a dispatch or draw.
+    virtual void commit_data() const;
+
     virtual void set_cuda_tensor_view(const ShaderOffset& offset, const cuda::TensorView& tensor_view, bool is_uav);
     virtual void get_cuda_interop_buffers(std::vector<ref<cuda::InteropBuffer>>& cuda_interop_buffers) const;
 
@@ -46,6 +53,15 @@ protected:
     ref<Device> m_device;
     gfx::IShaderObject* m_shader_object;
     std::vector<ref<cuda::InteropBuffer>> m_cuda_interop_buffers;
+
+private:
+    /// Host copy of the uniform data with a flag per written byte.
+    /// Only the range [m_staged_begin, m_staged_end) is valid.
+    mutable std::vector<uint8_t> m_staged_data;
+    mutable std::vector<uint8_t> m_staged_mask;
+    mutable size_t m_staged_begin{0};
+    mutable size_t m_staged_end{0};
+    mutable size_t m_staged_size{0};
 };
 
 class SGL_API TransientShaderObject : public ShaderObject {
@@ -60,11 +76,14 @@ public:
 
     virtual void set_resource(const ShaderOffset& offset, const ref<ResourceView>& resource_view) override;
 
+    virtual void commit_data() const override;
+
     virtual void get_cuda_interop_buffers(std::vector<ref<cuda::InteropBuffer>>& cuda_interop_buffers) const override;
 
 private:
     CommandBuffer* m_command_buffer;
-    std::vector<ref<TransientShaderObject>> m_sub_objects;
+    std::vector<ref<TransientShaderObject>> m_entry_points;
+    std::map<ShaderOffset, ref<TransientShaderObject>> m_sub_objects;
 };
 
 class SGL_API MutableShaderObject : public ShaderObject {
@@ -84,6 +103,8 @@ public:
 
     void set_resource_states(CommandBuffer* command_buffer) const;
 
+    virtual void commit_data() const override;
+
     virtual void get_cuda_interop_buffers(std::vector<ref<cuda::InteropBuffer>>& cuda_interop_buffers) const override;
 
 private:
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "slang_file_system.h"
+
+#include "sgl/device/slang_utils.h"
+
+#include "sgl/core/file_stream.h"
+
+#include <cmrc/cmrc.hpp>
+
+CMRC_DECLARE(sgl_shaders);
+
+namespace sgl {
+
+SlangFileSystem::SlangFileSystem(std::filesystem::path embedded_root)
+    : m_embedded_root(embedded_root.lexically_normal())
+{
+}
+
+std::optional<std::string_view> SlangFileSystem::find_embedded_file(std::string_view relative_path)
+{
+    auto fs = cmrc::sgl_shaders::get_filesystem();
+    std::string path{relative_path};
+    if (!fs.is_file(path))
+        return {};
+    cmrc::file file = fs.open(path);
+    return std::string_view(file.begin(), file.size());
+}
+
+std::optional<std::string_view> SlangFileSystem::find_embedded(const std::filesystem::path& path) const
+{
+    std::filesystem::path relative = path.lexically_normal().lexically_relative(m_embedded_root);
+    if (relative.empty() || *relative.begin() == "..")
+        return {};
+    return find_embedded_file(relative.generic_string());
+}
+
+bool SlangFileSystem::exists(const std::filesystem::path& path) const
+{
+    return find_embedded(path) || std::filesystem::exists(path);
+}
+
+std::optional<std::string> SlangFileSystem::read(const std::filesystem::path& path) const
+{
+    if (auto embedded = find_embedded(path))
+        return std::string(*embedded);
+
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec))
+        return {};
+    FileStream stream(path, FileStream::Mode::read);
+    std::string result;
+    result.resize(stream.size());
+    stream.read(result.data(), result.size());
+    return result;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL SlangFileSystem::queryInterface(SlangUUID const& uuid, void** outObject)
+{
+    if (void* ptr = castAs(uuid)) {
+        addRef();
+        *outObject = ptr;
+        return SLANG_OK;
+    }
+    return SLANG_E_NO_INTERFACE;
+}
+
+SLANG_NO_THROW uint32_t SLANG_MCALL SlangFileSystem::addRef()
+{
+    return ++m_ref_count;
+}
+
+SLANG_NO_THROW uint32_t SLANG_MCALL SlangFileSystem::release()
+{
+    uint32_t count = --m_ref_count;
+    if (count == 0)
+        delete this;
+    return count;
+}
+
+SLANG_NO_THROW void* SLANG_MCALL SlangFileSystem::castAs(const SlangUUID& guid)
+{
+    if (guid == ISlangUnknown::getTypeGuid() || guid == ISlangCastable::getTypeGuid()
+        || guid == ISlangFileSystem::getTypeGuid())
+        return static_cast<ISlangFileSystem*>(this);
+    return nullptr;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL SlangFileSystem::loadFile(char const* path, ISlangBlob** outBlob)
+{
+    try {
+        std::optional<std::string> data = read(path);
+        if (!data)
+            return SLANG_E_NOT_FOUND;
+        *outBlob = new OwnedSlangBlob(std::move(*data));
+        (*outBlob)->addRef();
+        return SLANG_OK;
+    } catch (...) {
+        return SLANG_FAIL;
+    }
+}
+
+} // namespace sgl
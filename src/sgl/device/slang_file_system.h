@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sgl/core/macros.h"
+
+#include <slang.h>
+
+#include <atomic>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace sgl {
+
+/**
+ * \brief Virtual file system used by slang sessions.
+ *
+ * sgl's internal shaders (e.g. \c sgl/device/print.slang) are embedded into the library at build time.
+ * Files requested within the embedded root directory (the default shader include path) are served from
+ * the embedded sources, all other files are read from disk. This avoids filesystem lookups and reads
+ * for the internal shaders, which are loaded on every device startup.
+ */
+class SGL_API SlangFileSystem : public ISlangFileSystem {
+public:
+    /// Create a file system serving embedded files within the given root directory.
+    SlangFileSystem(std::filesystem::path embedded_root);
+    virtual ~SlangFileSystem() = default;
+
+    /// Returns the embedded source of a file given by a path relative to the embedded root.
+    static std::optional<std::string_view> find_embedded_file(std::string_view relative_path);
+
+    /// Returns the embedded source of a file given by a full path, if the path is within the embedded root.
+    std::optional<std::string_view> find_embedded(const std::filesystem::path& path) const;
+
+    /// Returns true if the file exists, either embedded or on disk.
+    bool exists(const std::filesystem::path& path) const;
+
+    /// Read a file, either embedded or from disk.
+    std::optional<std::string> read(const std::filesystem::path& path) const;
+
+    // ISlangFileSystem interface
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL queryInterface(SlangUUID const& uuid, void** outObject) override;
+    virtual SLANG_NO_THROW uint32_t SLANG_MCALL addRef() override;
+    virtual SLANG_NO_THROW uint32_t SLANG_MCALL release() override;
+    virtual SLANG_NO_THROW void* SLANG_MCALL castAs(const SlangUUID& guid) override;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL loadFile(char const* path, ISlangBlob** outBlob) override;
+
+private:
+    std::filesystem::path m_embedded_root;
+    std::atomic<uint32_t> m_ref_count{0};
+};
+
+} // namespace sgl
@@ -1,8 +1,13 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#pragma once
+
 #include <slang.h>
 #include <slang-com-ptr.h>
 
+#include <atomic>
+#include <string>
+
 namespace sgl {
 
 /// Implementation of slang's ISlangBlob interface to access an unowned blob of data.
@@ -43,4 +48,41 @@ private:
     size_t m_size;
 };
 
+/// Implementation of slang's ISlangBlob interface owning a blob of data.
+/// Instances are reference counted and delete themselves once the last reference is released.
+class OwnedSlangBlob : public ISlangBlob {
+public:
+    OwnedSlangBlob(std::string data)
+        : m_data(std::move(data))
+    {
+    }
+
+    virtual SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() override { return m_data.data(); }
+    virtual SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() override { return m_data.size(); }
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL queryInterface(SlangUUID const& uuid, void** outObject) override
+    {
+        if (uuid == SLANG_UUID_ISlangBlob || uuid == ISlangUnknown::getTypeGuid()) {
+            addRef();
+            *outObject = static_cast<ISlangBlob*>(this);
+            return SLANG_OK;
+        }
+        return SLANG_E_NO_INTERFACE;
+    }
+
+    virtual SLANG_NO_THROW uint32_t SLANG_MCALL addRef() override { return ++m_ref_count; }
+
+    virtual SLANG_NO_THROW uint32_t SLANG_MCALL release() override
+    {
+        uint32_t count = --m_ref_count;
+        if (count == 0)
+            delete this;
+        return count;
+    }
+
+private:
+    std::atomic<uint32_t> m_ref_count{0};
+    std::string m_data;
+};
+
 } // namespace sgl
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "testing.h"
+#include "sgl/device/benchmark.h"
+
+#include <vector>
+
+using namespace sgl;
+
+TEST_SUITE_BEGIN("benchmark");
+
+TEST_CASE("percentile_sorted")
+{
+    std::vector<double> sorted{1.0, 2.0, 3.0, 4.0, 5.0};
+    CHECK_EQ(percentile_sorted(sorted, 0.0), 1.0);
+    CHECK_EQ(percentile_sorted(sorted, 50.0), 3.0);
+    CHECK_EQ(percentile_sorted(sorted, 100.0), 5.0);
+    CHECK_EQ(percentile_sorted(sorted, 12.5), 1.5);
+    CHECK_EQ(percentile_sorted(std::vector<double>{}, 50.0), 0.0);
+}
+
+TEST_CASE("from_samples")
+{
+    BenchmarkDesc desc{.name = "test", .bytes = 1000, .flops = 4000};
+    BenchmarkResult result = BenchmarkResult::from_samples({4.0, 1.0, 2.0, 3.0, 5.0}, 8, desc);
+    CHECK_EQ(result.name, "test");
+    CHECK_EQ(result.samples, std::vector<double>{4.0, 1.0, 2.0, 3.0, 5.0});
+    CHECK_EQ(result.dispatches_per_sample, 8);
+    CHECK_EQ(result.min, 1.0);
+    CHECK_EQ(result.max, 5.0);
+    CHECK_EQ(result.mean, 3.0);
+    CHECK_EQ(result.median, 3.0);
+    CHECK_EQ(result.p10, doctest::Approx(1.4));
+    CHECK_EQ(result.p90, doctest::Approx(4.6));
+    CHECK_EQ(result.relative_spread, doctest::Approx(2.0 / 3.0));
+    CHECK(result.noisy);
+    CHECK_EQ(result.bandwidth, doctest::Approx(1000.0 / 3.0));
+    CHECK_EQ(result.flops_per_second, doctest::Approx(4000.0 / 3.0));
+    CHECK_EQ(result.percentile(25.0), 2.0);
+}
+
+TEST_CASE("noise")
+{
+    // A single outlier does not make a measurement noisy.
+    std::vector<double> samples(100, 1.0);
+    samples[50] = 10.0;
+    CHECK_FALSE(BenchmarkResult::from_samples(samples, 1, {}).noisy);
+
+    // Bimodal timings (e.g. clock changes during the measurement) do.
+    for (size_t i = 0; i < samples.size(); i += 2)
+        samples[i] = 1.5;
+    CHECK(BenchmarkResult::from_samples(samples, 1, {}).noisy);
+}
+
+TEST_CASE("to_json")
+{
+    BenchmarkResult result = BenchmarkResult::from_samples({0.5, 0.25}, 1, {.name = "a\"b"});
+    std::string json = result.to_json();
+    CHECK(json.starts_with("{\"name\":\"a\\\"b\",\"dispatches_per_sample\":1,"));
+    CHECK(json.find("\"noisy\":true") != std::string::npos);
+    CHECK(json.ends_with("\"samples\":[0.5,0.25]}"));
+}
+
+TEST_SUITE_END();
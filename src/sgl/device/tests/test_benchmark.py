@@ -0,0 +1,100 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import pytest
+import sys
+import json
+import sgl
+import numpy as np
+from pathlib import Path
+
+sys.path.append(str(Path(__file__).parent))
+import sglhelpers as helpers
+from sglhelpers import test_id  # type: ignore (pytest fixture)
+
+
+def test_benchmark_result():
+    desc = sgl.BenchmarkDesc({"name": "copy", "bytes": 1000})
+    result = sgl.BenchmarkResult.from_samples([2.0, 1.0, 3.0], 4, desc)
+    assert result.name == "copy"
+    assert result.samples == [2.0, 1.0, 3.0]
+    assert result.dispatches_per_sample == 4
+    assert result.median == 2.0
+    assert result.min == 1.0
+    assert result.max == 3.0
+    assert result.bandwidth == 500.0
+    assert result.flops_per_second == 0.0
+    assert result.percentile(50) == 2.0
+
+    data = json.loads(result.to_json())
+    assert data["name"] == "copy"
+    assert data["median"] == 2.0
+    assert data["samples"] == [2.0, 1.0, 3.0]
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_benchmark_kernel(test_id: str, device_type: sgl.DeviceType):
+    device = helpers.get_device(type=device_type)
+
+    module = device.load_module_from_source(
+        f"test_benchmark_kernel_{test_id}",
+        r"""
+        [shader("compute")]
+        [numthreads(64, 1, 1)]
+        void main(
+            uint3 tid: SV_DispatchThreadID,
+            StructuredBuffer<float> src,
+            RWStructuredBuffer<float> dst
+        )
+        {
+            dst[tid.x] = src[tid.x] * 2;
+        }
+    """,
+    )
+    program = device.link_program([module], [module.entry_point("main")])
+    kernel = device.create_compute_kernel(program)
+
+    N = 1 << 20
+    data = np.random.rand(N).astype(np.float32)
+    src = device.create_buffer(
+        element_count=N,
+        struct_size=4,
+        usage=sgl.ResourceUsage.shader_resource,
+        data=data,
+    )
+    dst = device.create_buffer(
+        element_count=N,
+        struct_size=4,
+        usage=sgl.ResourceUsage.unordered_access,
+    )
+
+    result = device.benchmark_kernel(
+        kernel,
+        [N, 1, 1],
+        desc={
+            "name": "scale",
+            "bytes": N * 8,
+            "iterations": 10,
+            "max_iterations": 20,
+        },
+        src=src,
+        dst=dst,
+    )
+    assert result.name == "scale"
+    assert 10 <= len(result.samples) <= 20
+    assert result.dispatches_per_sample >= 1
+    assert result.median > 0
+    assert result.min <= result.p10 <= result.median <= result.p90 <= result.max
+    assert result.bandwidth == pytest.approx(N * 8 / result.median)
+    assert np.allclose(dst.to_numpy().view(np.float32), data * 2)
+
+    # Arbitrary work can be benchmarked by recording it into the given command buffer.
+    def encode(command_buffer: sgl.CommandBuffer):
+        kernel.dispatch([N, 1, 1], src=src, dst=dst, command_buffer=command_buffer)
+
+    result = device.benchmark(encode, {"warmup_iterations": 0, "iterations": 5})
+    assert result.dispatches_per_sample == 1
+    assert 5 <= len(result.samples) <= 200
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
@@ -0,0 +1,117 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import pytest
+import numpy as np
+import sgl
+import sys
+from pathlib import Path
+
+sys.path.append(str(Path(__file__).parent))
+import sglhelpers as helpers
+
+COUNT = 100
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_command_bundle(device_type: sgl.DeviceType):
+    device = helpers.get_device(device_type)
+
+    kernel = device.create_compute_kernel(
+        device.load_program("test_command_bundle.slang", ["add"])
+    )
+
+    def create_buffer():
+        return device.create_buffer(
+            element_count=COUNT,
+            struct_size=4,
+            usage=sgl.ResourceUsage.shader_resource
+            | sgl.ResourceUsage.unordered_access,
+            data=np.zeros(COUNT, dtype=np.uint32),
+        )
+
+    buffers = [create_buffer(), create_buffer()]
+    copy_buffer = create_buffer()
+
+    bundle = device.create_command_bundle()
+    result = bundle.add_slot("result")
+    bundle.add_slot("value", np.array([1], dtype=np.uint32))
+    assert bundle.slot_count == 2
+    assert bundle.has_slot("value")
+
+    # "result" and "value" are globals, "count" is an entry point parameter.
+    vars = {
+        "result": result,
+        "value": bundle.slot("value"),
+        "count": np.array([COUNT], dtype=np.uint32),
+    }
+    bundle.dispatch(kernel, [COUNT, 1, 1], vars)
+    bundle.uav_barrier(result)
+    bundle.dispatch(kernel, [COUNT, 1, 1], vars)
+    bundle.copy_buffer_region(copy_buffer, 0, result, 0, COUNT * 4)
+    assert bundle.command_count == 4
+
+    for buffer in buffers:
+        bundle.set_slot(result, buffer)
+        for value in [1, 2, 3]:
+            bundle.set_slot("value", np.array([value], dtype=np.uint32))
+            bundle.execute()
+
+    for buffer in buffers + [copy_buffer]:
+        assert np.all(buffer.to_numpy().view(np.uint32) == 12)
+
+    # Unknown parameters are reported at record time.
+    with pytest.raises(Exception):
+        bundle.dispatch(kernel, [COUNT, 1, 1], {"unknown": result})
+
+    # Uniform data needs to match the size of the parameter.
+    with pytest.raises(Exception):
+        bundle.dispatch(kernel, [COUNT, 1, 1], {**vars, "count": np.array([COUNT, 0], dtype=np.uint32)})
+    bundle.set_slot("value", np.array([1, 2], dtype=np.uint32))
+    with pytest.raises(Exception):
+        bundle.execute()
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_command_bundle_nested_parameters(device_type: sgl.DeviceType):
+    device = helpers.get_device(device_type)
+
+    kernel = device.create_compute_kernel(
+        device.load_program("test_command_bundle.slang", ["add_params"])
+    )
+
+    buffer = device.create_buffer(
+        element_count=COUNT,
+        struct_size=4,
+        usage=sgl.ResourceUsage.shader_resource | sgl.ResourceUsage.unordered_access,
+        data=np.zeros(COUNT, dtype=np.uint32),
+    )
+
+    # Paths through a parameter block and into an array are resolved at record time.
+    bundle = device.create_command_bundle()
+    result = bundle.add_slot("result")
+    bundle.dispatch(
+        kernel,
+        [COUNT, 1, 1],
+        {
+            "params.result": result,
+            "params.values[1]": np.array([5], dtype=np.uint32),
+            "count": np.array([COUNT], dtype=np.uint32),
+        },
+    )
+
+    # A value that cannot be bound fails the replay without leaving the shared command buffer open.
+    bundle.set_slot(result, np.array([1], dtype=np.uint32))
+    with pytest.raises(Exception):
+        bundle.execute()
+
+    bundle.set_slot(result, buffer)
+    bundle.execute()
+    bundle.execute()
+    assert np.all(buffer.to_numpy().view(np.uint32) == 10)
+
+    with pytest.raises(Exception):
+        bundle.dispatch(kernel, [COUNT, 1, 1], {"params.unknown": result})
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
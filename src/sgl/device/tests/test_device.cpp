@@ -5,6 +5,9 @@
 #include "sgl/device/resource.h"
 #include "sgl/device/shader.h"
 
+#include <numeric>
+#include <vector>
+
 using namespace sgl;
 
 TEST_SUITE_BEGIN("device");
@@ -20,4 +23,31 @@ TEST_CASE_GPU("init")
     CHECK(ctx.device);
 }
 
+TEST_CASE_GPU("host_visible_buffer")
+{
+    std::vector<uint32_t> data(1024);
+    std::iota(data.begin(), data.end(), 0);
+    ref<Buffer> buffer = ctx.device->create_buffer({
+        .size = data.size() * sizeof(uint32_t),
+        .usage = ResourceUsage::shader_resource,
+        .data = data.data(),
+        .data_size = data.size() * sizeof(uint32_t),
+    });
+    CHECK(buffer->get_elements<uint32_t>() == data);
+
+    if (!buffer->is_host_visible())
+        return;
+
+    // Writes to persistently mapped buffers bypass the staging buffer.
+    const uint32_t* mapped = buffer->map<uint32_t>();
+    for (uint32_t& value : data)
+        value *= 3;
+    buffer->set_data(data.data(), data.size() * sizeof(uint32_t));
+    CHECK(std::equal(data.begin(), data.end(), mapped));
+    CHECK(buffer->get_elements<uint32_t>() == data);
+    buffer->unmap();
+
+    CHECK(buffer->get_elements<uint32_t>() == data);
+}
+
 TEST_SUITE_END();
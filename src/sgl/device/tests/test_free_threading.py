@@ -0,0 +1,92 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import pytest
+import numpy as np
+import sgl
+import sys
+import sysconfig
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+
+sys.path.append(str(Path(__file__).parent))
+import sglhelpers as helpers
+
+# Stress tests calling into sgl from many threads at once.
+# On free-threaded Python builds these run truly in parallel.
+
+THREAD_COUNT = 16
+ITERATIONS = 50
+
+FREE_THREADED = bool(sysconfig.get_config_var("Py_GIL_DISABLED"))
+
+
+def run_in_threads(func):
+    with ThreadPoolExecutor(max_workers=THREAD_COUNT) as executor:
+        futures = [executor.submit(func, i) for i in range(THREAD_COUNT)]
+        return [f.result() for f in futures]
+
+
+def test_gil_disabled():
+    if not FREE_THREADED:
+        pytest.skip("Python is not a free-threaded build")
+    assert not sys._is_gil_enabled()  # type: ignore
+
+
+def test_bitmap_threads():
+    def work(index: int):
+        for i in range(ITERATIONS):
+            data = np.full((32, 64, 4), index + i, dtype=np.float32)
+            bitmap = sgl.Bitmap(data)
+            converted = bitmap.convert(
+                sgl.Bitmap.PixelFormat.rgba, sgl.Bitmap.ComponentType.float16, False
+            )
+            result = np.asarray(converted)
+            assert result.shape == (32, 64, 4)
+            assert np.all(result == np.float16(index + i))
+
+    run_in_threads(work)
+
+
+def test_struct_threads():
+    types = [
+        sgl.Struct.Type.int8,
+        sgl.Struct.Type.uint16,
+        sgl.Struct.Type.int32,
+        sgl.Struct.Type.float16,
+        sgl.Struct.Type.float64,
+    ]
+
+    def work(index: int):
+        for i in range(ITERATIONS):
+            # Use different type pairs per thread to exercise the conversion program cache.
+            src = sgl.Struct().append("val", sgl.Struct.Type.float32)
+            dst = sgl.Struct().append("val", types[(index + i) % len(types)])
+            converter = sgl.StructConverter(src, dst)
+            back = sgl.StructConverter(dst, src)
+            src_data = np.array([index % 8], dtype=np.float32).tobytes()
+            assert back.convert(converter.convert(src_data)) == src_data
+
+    run_in_threads(work)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_device_threads(device_type: sgl.DeviceType):
+    device = helpers.get_device(device_type)
+
+    def work(index: int):
+        for i in range(ITERATIONS // 5):
+            data = np.full(256, index * 1000 + i, dtype=np.uint32)
+            buffer = device.create_buffer(
+                size=data.nbytes,
+                usage=sgl.ResourceUsage.shader_resource,
+                data=data,
+            )
+            assert np.all(buffer.to_numpy().view(np.uint32) == data)
+            del buffer
+
+    run_in_threads(work)
+    device.run_garbage_collection()
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v"])
@@ -0,0 +1,104 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import pytest
+import sys
+import sgl
+import numpy as np
+from pathlib import Path
+
+sys.path.append(str(Path(__file__).parent))
+import sglhelpers as helpers
+
+RECORD_DTYPE = np.dtype(
+    [("thread_id", np.uint32), ("iteration", np.uint32), ("value", np.float32, 2)]
+)
+
+
+def sent_records(count: int, iteration: int):
+    ids = np.arange(count, dtype=np.uint32)
+    return set(int(i) for i in ids[(ids + iteration) % 3 != 0])
+
+
+def setup(device_type: sgl.DeviceType):
+    device = sgl.Device(type=device_type, enable_message_channel=True)
+    kernel = device.create_compute_kernel(
+        device.load_program(
+            str(Path(__file__).parent / "test_message_channel.slang"),
+            ["send_records"],
+        )
+    )
+    records = []
+    device.message_channel.set_handler(
+        7, lambda payload: records.append(np.frombuffer(payload, RECORD_DTYPE)[0])
+    )
+    return device, kernel, records
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_message_channel(device_type: sgl.DeviceType):
+    device, kernel, records = setup(device_type)
+    channel = device.message_channel
+    assert channel is not None
+    assert channel.capacity == 4 * 1024 * 1024
+    assert channel.is_background_polling == channel.is_host_visible
+
+    # Each iteration sends ~1MB of messages, wrapping around the ring several times.
+    count = 65536
+    for iteration in range(6):
+        kernel.dispatch([count, 1, 1], count=count, iteration=iteration)
+        channel.flush()
+        received = [r for r in records if r["iteration"] == iteration]
+        assert set(int(r["thread_id"]) for r in received) == sent_records(
+            count, iteration
+        )
+        for r in received:
+            assert r["value"][0] == r["thread_id"] * 0.5
+            assert r["value"][1] == iteration
+
+    assert len(records) == sum(len(sent_records(count, i)) for i in range(6))
+    assert channel.dropped_count == 0
+    device.close()
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_message_channel_overflow(device_type: sgl.DeviceType):
+    device, kernel, records = setup(device_type)
+    channel = device.message_channel
+
+    # Sends ~6MB of messages in a single dispatch, more than the ring can hold.
+    count = 400000
+    kernel.dispatch([count, 1, 1], count=count, iteration=0)
+    channel.flush()
+
+    expected = sent_records(count, 0)
+    received = set(int(r["thread_id"]) for r in records)
+    assert len(received) == len(records)
+    assert received <= expected
+    assert len(records) + channel.dropped_count == len(expected)
+    if not channel.is_background_polling:
+        assert channel.dropped_count > 0
+
+    # The channel keeps working after an overflow.
+    records.clear()
+    kernel.dispatch([1000, 1, 1], count=1000, iteration=1)
+    channel.flush()
+    assert set(int(r["thread_id"]) for r in records) == sent_records(1000, 1)
+    device.close()
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_message_channel_remove_handler(device_type: sgl.DeviceType):
+    device, kernel, records = setup(device_type)
+    channel = device.message_channel
+
+    # Messages without a handler are discarded.
+    channel.remove_handler(7)
+    kernel.dispatch([1000, 1, 1], count=1000, iteration=0)
+    channel.flush()
+    assert len(records) == 0
+    assert channel.dropped_count == 0
+    device.close()
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
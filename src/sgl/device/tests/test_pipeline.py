@@ -117,6 +117,38 @@ def test_compute_set_square(device_type: sgl.DeviceType):
     ctx.expect_counts([area, 0, 0, area])
 
 
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_compute_set_square_indirect(device_type: sgl.DeviceType):
+    ctx = PipelineTestContext(device_type)
+    prog = ctx.device.load_program("test_pipeline_utils.slang", ["setcolor"])
+    set_kernel = ctx.device.create_compute_kernel(prog)
+
+    # 16x16 threads per group, 8x8 groups cover the 128x128 output.
+    args_buffer = ctx.device.create_buffer(
+        usage=sgl.ResourceUsage.indirect_arg | sgl.ResourceUsage.shader_resource,
+        debug_name="args_buffer",
+        data=np.array([8, 8, 1], dtype=np.uint32),
+    )
+
+    # Staged uniform writes must be committed before the indirect dispatch.
+    pos = sgl.int2(32, 32)
+    size = sgl.int2(16, 16)
+    command_buffer = ctx.device.create_command_buffer()
+    command_buffer.set_buffer_state(args_buffer, sgl.ResourceState.indirect_argument)
+    with command_buffer.encode_compute_commands() as encoder:
+        shader_object = encoder.bind_pipeline(set_kernel.pipeline)
+        cursor = sgl.ShaderCursor(shader_object).find_entry_point(0)
+        cursor.render_texture = ctx.output_texture
+        cursor.pos = pos
+        cursor.size = size
+        cursor.color = sgl.float4(1, 0, 0, 1)
+        encoder.dispatch_thread_groups_indirect(args_buffer)
+    command_buffer.submit()
+
+    area = size.x * size.y
+    ctx.expect_counts([area, 0, 0, area])
+
+
 @pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
 def test_compute_set_and_overwrite(device_type: sgl.DeviceType):
     ctx = PipelineTestContext(device_type)
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "testing.h"
+#include "sgl/device/primitives.h"
+#include "sgl/device/device.h"
+#include "sgl/device/resource.h"
+#include "sgl/device/command.h"
+
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace sgl;
+
+namespace {
+
+ref<Buffer> create_buffer(Device* device, const std::vector<uint32_t>& data)
+{
+    return device->create_buffer({
+        .size = std::max<size_t>(data.size(), 1) * sizeof(uint32_t),
+        .usage = ResourceUsage::shader_resource | ResourceUsage::unordered_access,
+        .data = data.empty() ? nullptr : data.data(),
+        .data_size = data.size() * sizeof(uint32_t),
+    });
+}
+
+std::vector<uint32_t> random_keys(size_t count, uint32_t max_key, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> dist(0, max_key);
+    std::vector<uint32_t> keys(count);
+    for (uint32_t& key : keys)
+        key = dist(rng);
+    return keys;
+}
+
+} // namespace
+
+TEST_SUITE_BEGIN("primitives");
+
+TEST_CASE("reduce_cpu")
+{
+    std::vector<int> values{3, -1, 7, 2};
+    CHECK_EQ(Primitives::reduce_cpu<int>(ReduceOp::sum, values), 11);
+    CHECK_EQ(Primitives::reduce_cpu<int>(ReduceOp::min, values), -1);
+    CHECK_EQ(Primitives::reduce_cpu<int>(ReduceOp::max, values), 7);
+
+    std::vector<float3> vectors{{1.f, 5.f, -2.f}, {3.f, 0.f, 4.f}};
+    CHECK(all(Primitives::reduce_cpu<float3>(ReduceOp::sum, vectors) == float3(4.f, 5.f, 2.f)));
+    CHECK(all(Primitives::reduce_cpu<float3>(ReduceOp::min, vectors) == float3(1.f, 0.f, -2.f)));
+    CHECK(all(Primitives::reduce_cpu<float3>(ReduceOp::max, vectors) == float3(3.f, 5.f, 4.f)));
+}
+
+TEST_CASE("scan_cpu")
+{
+    std::vector<uint32_t> src{1, 2, 3, 4};
+    std::vector<uint32_t> dst(4);
+    Primitives::scan_cpu<uint32_t>(src, dst);
+    CHECK_EQ(dst, std::vector<uint32_t>{0, 1, 3, 6});
+    Primitives::scan_cpu<uint32_t>(src, dst, true);
+    CHECK_EQ(dst, std::vector<uint32_t>{1, 3, 6, 10});
+}
+
+TEST_CASE("histogram_cpu")
+{
+    std::vector<uint32_t> keys{0, 2, 2, 5, 1, 2};
+    std::vector<uint32_t> bins(4, 7);
+    Primitives::histogram_cpu(keys, bins);
+    CHECK_EQ(bins, std::vector<uint32_t>{1, 1, 3, 0});
+}
+
+TEST_CASE("compact_cpu")
+{
+    std::vector<uint32_t> src{10, 11, 12, 13, 14};
+    std::vector<uint32_t> flags{1, 0, 0, 3, 1};
+    CHECK_EQ(Primitives::compact_cpu<uint32_t>(src, flags), std::vector<uint32_t>{10, 13, 14});
+}
+
+TEST_CASE("sort_cpu")
+{
+    std::vector<uint32_t> keys{3, 1, 0x12, 2, 1};
+    std::vector<uint32_t> values{0, 1, 2, 3, 4};
+    Primitives::sort_cpu(keys, values);
+    CHECK_EQ(keys, std::vector<uint32_t>{1, 1, 2, 3, 0x12});
+    CHECK_EQ(values, std::vector<uint32_t>{1, 4, 3, 0, 2});
+
+    // Sorting by the low bits only keeps the order of keys with equal low bits.
+    keys = {0x13, 0x01, 0x02, 0x11};
+    values = {0, 1, 2, 3};
+    Primitives::sort_cpu(keys, values, 4);
+    CHECK_EQ(keys, std::vector<uint32_t>{0x01, 0x11, 0x02, 0x13});
+    CHECK_EQ(values, std::vector<uint32_t>{1, 3, 2, 0});
+}
+
+TEST_CASE_GPU("reduce")
+{
+    std::vector<uint32_t> data = random_keys(100000, 1000, 1);
+    ref<Buffer> src = create_buffer(ctx.device, data);
+    ref<Buffer> dst = create_buffer(ctx.device, {0});
+
+    for (ReduceOp op : {ReduceOp::sum, ReduceOp::min, ReduceOp::max}) {
+        ref<CommandBuffer> command_buffer = ctx.device->create_command_buffer();
+        ctx.device->primitives()
+            ->reduce(command_buffer, op, src, dst, uint32_t(data.size()), Primitives::ScalarType::uint32);
+        command_buffer->submit();
+        CHECK_EQ(dst->get_elements<uint32_t>(0, 1)[0], Primitives::reduce_cpu<uint32_t>(op, data));
+    }
+}
+
+TEST_CASE_GPU("scan")
+{
+    // Spans many tiles to exercise the look-back.
+    std::vector<uint32_t> data = random_keys(Primitives::TILE_SIZE * 37 + 5, 100, 2);
+    ref<Buffer> src = create_buffer(ctx.device, data);
+    ref<Buffer> dst = create_buffer(ctx.device, std::vector<uint32_t>(data.size()));
+
+    for (bool inclusive : {false, true}) {
+        ref<CommandBuffer> command_buffer = ctx.device->create_command_buffer();
+        ctx.device->primitives()
+            ->scan(command_buffer, src, dst, uint32_t(data.size()), Primitives::ScalarType::uint32, 1, inclusive);
+        command_buffer->submit();
+        std::vector<uint32_t> expected(data.size());
+        Primitives::scan_cpu<uint32_t>(data, expected, inclusive);
+        CHECK(dst->get_elements<uint32_t>() == expected);
+    }
+}
+
+TEST_CASE_GPU("sort")
+{
+    std::vector<uint32_t> keys = random_keys(50000, 0xffffffff, 3);
+    std::vector<uint32_t> values(keys.size());
+    std::iota(values.begin(), values.end(), 0);
+    ref<Buffer> keys_buffer = create_buffer(ctx.device, keys);
+    ref<Buffer> values_buffer = create_buffer(ctx.device, values);
+
+    ref<CommandBuffer> command_buffer = ctx.device->create_command_buffer();
+    ctx.device->primitives()->sort(command_buffer, keys_buffer, values_buffer, uint32_t(keys.size()));
+    command_buffer->submit();
+
+    Primitives::sort_cpu(keys, values);
+    CHECK(keys_buffer->get_elements<uint32_t>() == keys);
+    CHECK(values_buffer->get_elements<uint32_t>() == values);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,183 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import pytest
+import sys
+import sgl
+import numpy as np
+from pathlib import Path
+
+sys.path.append(str(Path(__file__).parent))
+import sglhelpers as helpers
+
+ScalarType = sgl.TypeReflection.ScalarType
+
+DTYPES = {
+    ScalarType.int32: np.int32,
+    ScalarType.uint32: np.uint32,
+    ScalarType.float32: np.float32,
+}
+
+USAGE = sgl.ResourceUsage.shader_resource | sgl.ResourceUsage.unordered_access
+
+# Element counts covering a partial tile, exact tiles and many tiles.
+COUNTS = [1, 1000, sgl.Primitives.TILE_SIZE * 4, 300001]
+
+
+def create_buffer(device: sgl.Device, data: np.ndarray):
+    return device.create_buffer(size=max(data.nbytes, 4), usage=USAGE, data=data)
+
+
+def random_data(count: int, scalar_type: ScalarType, components: int = 1):
+    rng = np.random.default_rng(count * 4 + components)
+    shape = (count, components)
+    if scalar_type == ScalarType.float32:
+        return rng.random(shape, dtype=np.float32)
+    return rng.integers(0, 100, shape).astype(DTYPES[scalar_type])
+
+
+def read(buffer: sgl.Buffer, dtype, shape):
+    return buffer.to_numpy().view(dtype)[: np.prod(shape)].reshape(shape)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+@pytest.mark.parametrize("op", [sgl.ReduceOp.sum, sgl.ReduceOp.min, sgl.ReduceOp.max])
+@pytest.mark.parametrize("scalar_type", list(DTYPES.keys()))
+@pytest.mark.parametrize("components", [1, 3])
+@pytest.mark.parametrize("count", COUNTS)
+def test_reduce(
+    device_type: sgl.DeviceType,
+    op: sgl.ReduceOp,
+    scalar_type: ScalarType,
+    components: int,
+    count: int,
+):
+    device = helpers.get_device(type=device_type)
+    data = random_data(count, scalar_type, components)
+    src = create_buffer(device, data)
+    dst = device.create_buffer(size=16, usage=USAGE)
+
+    command_buffer = device.create_command_buffer()
+    device.primitives.reduce(
+        command_buffer, op, src, dst, count, scalar_type, components
+    )
+    command_buffer.submit()
+
+    result = read(dst, DTYPES[scalar_type], (components,))
+    expected = {"sum": data.sum, "min": data.min, "max": data.max}[op.name](axis=0)
+    if scalar_type == ScalarType.float32:
+        assert np.allclose(result, expected, rtol=1e-4)
+    else:
+        assert np.array_equal(result, expected.astype(DTYPES[scalar_type]))
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+@pytest.mark.parametrize("scalar_type", list(DTYPES.keys()))
+@pytest.mark.parametrize("components", [1, 2, 4])
+@pytest.mark.parametrize("inclusive", [False, True])
+@pytest.mark.parametrize("count", COUNTS)
+def test_scan(
+    device_type: sgl.DeviceType,
+    scalar_type: ScalarType,
+    components: int,
+    inclusive: bool,
+    count: int,
+):
+    device = helpers.get_device(type=device_type)
+    data = random_data(count, scalar_type, components)
+    src = create_buffer(device, data)
+    dst = device.create_buffer(size=data.nbytes, usage=USAGE)
+
+    command_buffer = device.create_command_buffer()
+    device.primitives.scan(
+        command_buffer, src, dst, count, scalar_type, components, inclusive
+    )
+    command_buffer.submit()
+
+    result = read(dst, DTYPES[scalar_type], data.shape)
+    expected = np.cumsum(data, axis=0, dtype=DTYPES[scalar_type])
+    if not inclusive:
+        expected = np.concatenate([np.zeros_like(data[:1]), expected[:-1]])
+    if scalar_type == ScalarType.float32:
+        assert np.allclose(result, expected, rtol=1e-4, atol=1e-3)
+    else:
+        assert np.array_equal(result, expected)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+@pytest.mark.parametrize("bin_count", [16, 4096, 10000])
+def test_histogram(device_type: sgl.DeviceType, bin_count: int):
+    device = helpers.get_device(type=device_type)
+    rng = np.random.default_rng(bin_count)
+    # Include keys outside of the bin range, which are ignored.
+    keys = rng.integers(0, bin_count + 10, 200000).astype(np.uint32)
+    keys_buffer = create_buffer(device, keys)
+    bins = device.create_buffer(
+        size=bin_count * 4, usage=USAGE, data=np.ones(bin_count, dtype=np.uint32)
+    )
+
+    command_buffer = device.create_command_buffer()
+    device.primitives.histogram(command_buffer, keys_buffer, bins, len(keys), bin_count)
+    command_buffer.submit()
+
+    expected = np.bincount(keys[keys < bin_count], minlength=bin_count)
+    assert np.array_equal(read(bins, np.uint32, (bin_count,)), expected)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+@pytest.mark.parametrize("components", [1, 3])
+@pytest.mark.parametrize("count", COUNTS)
+def test_compact(device_type: sgl.DeviceType, components: int, count: int):
+    device = helpers.get_device(type=device_type)
+    data = random_data(count, ScalarType.float32, components)
+    flags = (np.random.default_rng(count).random(count) < 0.3).astype(np.uint32)
+    src = create_buffer(device, data)
+    flags_buffer = create_buffer(device, flags)
+    dst = device.create_buffer(size=data.nbytes, usage=USAGE)
+    dst_count = device.create_buffer(size=4, usage=USAGE)
+
+    command_buffer = device.create_command_buffer()
+    device.primitives.compact(
+        command_buffer,
+        src,
+        flags_buffer,
+        dst,
+        dst_count,
+        count,
+        ScalarType.float32,
+        components,
+    )
+    command_buffer.submit()
+
+    expected = data[flags != 0]
+    assert read(dst_count, np.uint32, (1,))[0] == len(expected)
+    assert np.array_equal(read(dst, np.float32, expected.shape), expected)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+@pytest.mark.parametrize("key_bits", [32, 12, 7])
+@pytest.mark.parametrize("with_values", [False, True])
+@pytest.mark.parametrize("count", COUNTS)
+def test_sort(
+    device_type: sgl.DeviceType, key_bits: int, with_values: bool, count: int
+):
+    device = helpers.get_device(type=device_type)
+    rng = np.random.default_rng(count + key_bits)
+    keys = rng.integers(0, 1 << 32, count, dtype=np.uint64).astype(np.uint32)
+    values = np.arange(count, dtype=np.uint32)
+    keys_buffer = create_buffer(device, keys)
+    values_buffer = create_buffer(device, values) if with_values else None
+
+    command_buffer = device.create_command_buffer()
+    device.primitives.sort(command_buffer, keys_buffer, values_buffer, count, key_bits)
+    command_buffer.submit()
+
+    # Only the low key bits are sorted, equal keys keep their order.
+    mask = np.uint32((1 << key_bits) - 1)
+    order = np.argsort(keys & mask, kind="stable")
+    assert np.array_equal(read(keys_buffer, np.uint32, (count,)), keys[order])
+    if values_buffer is not None:
+        assert np.array_equal(read(values_buffer, np.uint32, (count,)), values[order])
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
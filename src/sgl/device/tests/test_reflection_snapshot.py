@@ -0,0 +1,145 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import pytest
+import sgl
+import sys
+from pathlib import Path
+
+sys.path.append(str(Path(__file__).parent))
+import sglhelpers as helpers
+from sglhelpers import test_id  # type: ignore (pytest fixture)
+
+SOURCE = """
+struct Foo {
+    uint a;
+    float3 b;
+    float4x4 c;
+    int d[4];
+};
+struct Bar {
+    Foo foo;
+    uint16_t e;
+};
+RWStructuredBuffer<Bar> bars;
+
+[shader("compute")]
+[numthreads(8, 4, 1)]
+void main(uint3 tid: SV_DispatchThreadID, uniform uint count) {
+    if (tid.x < count)
+        bars[tid.x].e = 1;
+}
+"""
+
+
+def check_type_layout(
+    snapshot: sgl.TypeLayoutSnapshot, type_layout: sgl.TypeLayoutReflection
+):
+    assert snapshot.name == type_layout.name
+    assert snapshot.kind == type_layout.kind
+    assert snapshot.size == type_layout.size
+    assert snapshot.stride == type_layout.stride
+    assert snapshot.alignment == type_layout.alignment
+    assert [f.name for f in snapshot.fields] == [
+        f.name for f in type_layout.fields
+    ]
+    for field, ref_field in zip(snapshot.fields, type_layout.fields):
+        assert field.offset == ref_field.offset
+        check_type_layout(field.type_layout, ref_field.type_layout)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_snapshot_program_layout(
+    test_id: str, device_type: sgl.DeviceType, tmp_path: Path
+):
+    device = helpers.get_device(type=device_type)
+    module = device.load_module_from_source(
+        module_name=f"module_from_source_{test_id}", source=SOURCE
+    )
+    program = device.link_program([module], [module.entry_point("main")])
+    layout = program.layout
+
+    snapshot = sgl.ReflectionSnapshot.from_program_layout(layout)
+    snapshot.write(tmp_path / "program.slang-reflection")
+    loaded = sgl.ReflectionSnapshot(tmp_path / "program.slang-reflection")
+
+    for s in [snapshot, loaded]:
+        assert "Foo" in s.type_layouts
+        assert "Bar" in s.type_layouts
+        check_type_layout(
+            s.find_type_layout("Foo"),
+            layout.get_type_layout(layout.find_type_by_name("Foo")),
+        )
+        check_type_layout(
+            s.find_type_layout("Bar"),
+            layout.get_type_layout(layout.find_type_by_name("Bar")),
+        )
+        assert s.find_type_layout("Baz") is None
+
+        d = s.find_type_layout("Foo").find_field_by_name("d")
+        assert d is not None
+        assert d.type_layout.kind == sgl.TypeReflection.Kind.array
+        assert d.type_layout.element_count == 4
+        assert (
+            d.type_layout.unwrap_array().scalar_type
+            == sgl.TypeReflection.ScalarType.int32
+        )
+
+        assert [f.name for f in s.globals_type_layout.fields] == ["bars"]
+
+        assert len(s.entry_points) == 1
+        entry_point = s.find_entry_point_by_name("main")
+        assert entry_point is not None
+        assert entry_point.stage == sgl.ShaderStage.compute
+        assert entry_point.thread_group_size == [8, 4, 1]
+        assert "count" in [p.name for p in entry_point.parameters]
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_snapshot_type_layout(test_id: str, device_type: sgl.DeviceType):
+    device = helpers.get_device(type=device_type)
+    module = device.load_module_from_source(
+        module_name=f"module_from_source_{test_id}", source=SOURCE
+    )
+    type_layout = module.layout.get_type_layout(
+        module.layout.find_type_by_name("Foo")
+    )
+
+    snapshot = sgl.ReflectionSnapshot.from_type_layout(type_layout)
+    assert list(snapshot.type_layouts.keys()) == ["Foo"]
+    assert snapshot.globals_type_layout is None
+    assert len(snapshot.entry_points) == 0
+    check_type_layout(snapshot.find_type_layout("Foo"), type_layout)
+
+    snapshot.add_type_layout("MyFoo", type_layout)
+    assert snapshot.find_type_layout("MyFoo").size == type_layout.size
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_snapshot_cache(device_type: sgl.DeviceType, tmp_path: Path):
+    shader_dir = tmp_path / "shaders"
+    shader_dir.mkdir()
+    (shader_dir / "test_reflection_snapshot_module.slang").write_text(SOURCE)
+
+    device = sgl.Device(
+        type=device_type,
+        shader_cache_path=tmp_path / "cache",
+        compiler_options={"include_paths": [shader_dir]},
+    )
+    device.load_module("test_reflection_snapshot_module")
+    device.close()
+
+    # A snapshot is written next to the cached module.
+    paths = list(
+        (tmp_path / "cache").glob(
+            "**/test_reflection_snapshot_module.slang-reflection"
+        )
+    )
+    assert len(paths) == 1
+    assert paths[0].with_suffix(".slang-module").exists()
+
+    snapshot = sgl.ReflectionSnapshot(paths[0])
+    assert snapshot.find_type_layout("Bar") is not None
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
@@ -3,6 +3,10 @@
 #include "testing.h"
 #include "sgl/device/device.h"
 #include "sgl/device/shader.h"
+#include "sgl/device/buffer_cursor.h"
+#include "sgl/device/reflection_snapshot.h"
+#include "sgl/device/slang_file_system.h"
+#include "sgl/core/platform.h"
 #include <fstream>
 #include <filesystem>
 
@@ -102,4 +106,86 @@ TEST_CASE_GPU("shader")
     }
 }
 
+TEST_CASE_GPU("reflection_snapshot")
+{
+    ref<SlangModule> module = ctx.device->load_module_from_source("test_reflection_snapshot", R"SHADER(
+struct Foo {
+    uint a;
+    float3 b;
+    int c[3];
+};
+struct Bar {
+    Foo foo;
+    float d;
+};
+[shader("compute")]
+[numthreads(4, 2, 1)]
+void main(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<Bar> bars)
+{
+}
+)SHADER");
+    ref<ShaderProgram> program = ctx.device->link_program({module}, {module->entry_point("main")});
+    ref<const ProgramLayout> layout = program->layout();
+
+    std::filesystem::path path = testing::get_case_temp_directory() / "test.slang-reflection";
+    ReflectionSnapshot::from_program_layout(layout)->write(path);
+    ref<ReflectionSnapshot> snapshot = make_ref<ReflectionSnapshot>(path);
+
+    REQUIRE_EQ(snapshot->entry_points().size(), 1);
+    CHECK_EQ(snapshot->entry_points()[0].name, "main");
+    CHECK(all(snapshot->entry_points()[0].thread_group_size == uint3(4, 2, 1)));
+
+    ref<const TypeLayoutReflection> bar_layout
+        = layout->get_entry_point_by_index(0)->get_parameter_by_index(1)->type_layout()->element_type_layout();
+    REQUIRE_EQ(std::string_view(bar_layout->name()), "Bar");
+    ref<const TypeLayoutSnapshot> bar_snapshot = snapshot->find_type_layout("Bar");
+    REQUIRE(bar_snapshot);
+    CHECK_EQ(bar_snapshot->size(), bar_layout->size());
+    CHECK_EQ(bar_snapshot->stride(), bar_layout->stride());
+
+    // Writing through a cursor using the snapshot must produce the same data as using live reflection.
+    auto fill = [](BufferCursor& cursor)
+    {
+        for (uint32_t i = 0; i < 4; ++i) {
+            BufferElementCursor element = cursor[i];
+            element["foo"]["a"] = i;
+            element["foo"]["b"] = float3(float(i), 1.f, 2.f);
+            element["foo"]["c"][2] = int(i) * 3;
+            element["d"] = 0.5f * i;
+        }
+    };
+    ref<BufferCursor> cursor = make_ref<BufferCursor>(ref(const_cast<TypeLayoutReflection*>(bar_layout.get())), 4);
+    ref<BufferCursor> snapshot_cursor = make_ref<BufferCursor>(bar_snapshot, 4);
+    std::vector<uint8_t> data(cursor->size()), snapshot_data(snapshot_cursor->size());
+    cursor->write_data(0, data.data(), data.size());
+    snapshot_cursor->write_data(0, snapshot_data.data(), snapshot_data.size());
+    fill(*cursor);
+    fill(*snapshot_cursor);
+    cursor->read_data(0, data.data(), data.size());
+    snapshot_cursor->read_data(0, snapshot_data.data(), snapshot_data.size());
+    CHECK(data == snapshot_data);
+
+    CHECK_EQ((*snapshot_cursor)[3]["foo"]["c"][2].as<int>(), 9);
+    CHECK_THROWS((*snapshot_cursor)[0]["foo"]["a"] = 1.f);
+}
+
+TEST_CASE("embedded_shaders")
+{
+    for (const char* path : {"sgl/device/print.slang", "sgl/device/blit.slang", "sgl/math/ray.slang"}) {
+        CAPTURE(path);
+        std::optional<std::string_view> source = SlangFileSystem::find_embedded_file(path);
+        REQUIRE(source);
+        CHECK(source->find("SPDX-License-Identifier") != std::string_view::npos);
+    }
+    CHECK_FALSE(SlangFileSystem::find_embedded_file("sgl/device/missing.slang"));
+
+    // Only paths within the embedded root are served from the embedded sources.
+    std::filesystem::path root = platform::runtime_directory() / "shaders";
+    SlangFileSystem file_system(root);
+    CHECK(file_system.find_embedded(root / "sgl/device/print.slang"));
+    CHECK(file_system.find_embedded(root / "sgl/math/../device/print.slang"));
+    CHECK_FALSE(file_system.find_embedded(root / ".." / "sgl/device/print.slang"));
+    CHECK_FALSE(file_system.find_embedded(testing::get_case_temp_directory() / "sgl/device/print.slang"));
+}
+
 TEST_SUITE_END();
@@ -0,0 +1,55 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import pytest
+import numpy as np
+import sgl
+import sys
+from pathlib import Path
+
+sys.path.append(str(Path(__file__).parent))
+import sglhelpers as helpers
+
+COUNT = 64
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_shader_archive(device_type: sgl.DeviceType, tmp_path: Path):
+    device = helpers.get_device(device_type)
+
+    archive = sgl.ShaderArchive.build(
+        device,
+        [sgl.ShaderArchiveProgramDesc("scale", "test_shader_archive.slang", ["main"])],
+    )
+    assert archive.device_type == device.info.type
+    assert archive.has_program("scale")
+    assert len(archive.programs) == 1
+    assert "test_shader_archive_common" in archive.module_names
+
+    # Dependencies are loaded before the module containing the entry points.
+    program = archive.programs[0]
+    assert program.entry_point_names == ["main"]
+    assert archive.module_names[program.module_indices[-1]] == "test_shader_archive"
+
+    path = tmp_path / "test.sglarchive"
+    archive.write(path)
+    loaded = sgl.ShaderArchive(path)
+    assert loaded.has_program("scale")
+    assert loaded.module_names == archive.module_names
+
+    kernel = device.create_compute_kernel(
+        device.load_program_from_archive(loaded, "scale")
+    )
+    result = device.create_buffer(
+        element_count=COUNT,
+        struct_size=4,
+        usage=sgl.ResourceUsage.unordered_access,
+    )
+    kernel.dispatch(thread_count=[COUNT, 1, 1], vars={"result": result}, count=COUNT)
+    assert np.all(result.to_numpy().view(np.uint32) == np.arange(COUNT) * 3)
+
+    with pytest.raises(RuntimeError):
+        device.load_program_from_archive(loaded, "missing")
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
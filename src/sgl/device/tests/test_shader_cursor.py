@@ -328,6 +328,11 @@ def test_shader_cursor(device_type: sgl.DeviceType, use_numpy: bool):
                 else:
                     write_var(cursor, i, var, name_prefix)
 
+    writes = sgl.MetricsRegistry.get().counter("sgl_shader_object_data_writes_total")
+    commits = sgl.MetricsRegistry.get().counter("sgl_shader_object_data_commits_total")
+    writes.reset()
+    commits.reset()
+
     command_buffer = device.create_command_buffer()
     with command_buffer.encode_compute_commands() as encoder:
         shader_object = encoder.bind_pipeline(kernel.pipeline)
@@ -337,6 +342,9 @@ def test_shader_cursor(device_type: sgl.DeviceType, use_numpy: bool):
         encoder.dispatch(thread_count=[1, 1, 1])
     command_buffer.submit()
 
+    # Uniform writes are staged and committed in bulk at dispatch.
+    assert commits.value < writes.value
+
     data = result_buffer.to_numpy().tobytes()
     results = []
     for size in sizes:
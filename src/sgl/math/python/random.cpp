@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "nanobind.h"
+
+#include "sgl/math/random.h"
+
+namespace sgl::math {
+
+template<typename T, typename Generator>
+inline nb::ndarray<nb::numpy, T, nb::ndim<1>> generate_array(
+    const Generator& generator,
+    size_t count,
+    uint64_t offset,
+    void (Generator::*fill)(T*, size_t, uint64_t) const
+)
+{
+    T* data = new T[count];
+    {
+        nb::gil_scoped_release guard;
+        (generator.*fill)(data, count, offset);
+    }
+    nb::capsule owner(data, [](void* p) noexcept { delete[] reinterpret_cast<T*>(p); });
+    size_t shape[1] = {count};
+    return nb::ndarray<nb::numpy, T, nb::ndim<1>>(data, 1, shape, owner);
+}
+
+template<typename Generator>
+inline void bind_random_generator(nb::module_& m, const char* name)
+{
+    nb::class_<Generator>(m, name)
+        .def(nb::init<uint64_t, uint64_t>(), "seed"_a = 0, "stream"_a = 0)
+        .def_prop_ro("seed", &Generator::seed)
+        .def_prop_ro("stream", &Generator::stream)
+        .def("block", &Generator::block, "block_index"_a)
+        .def("get_uint", &Generator::get_uint, "index"_a)
+        .def("get_float", &Generator::get_float, "index"_a)
+        .def(
+            "uint_array",
+            [](const Generator& self, size_t count, uint64_t offset)
+            { return generate_array<uint32_t>(self, count, offset, &Generator::fill_uint); },
+            "count"_a,
+            "offset"_a = 0
+        )
+        .def(
+            "float_array",
+            [](const Generator& self, size_t count, uint64_t offset)
+            { return generate_array<float>(self, count, offset, &Generator::fill_float); },
+            "count"_a,
+            "offset"_a = 0
+        );
+}
+
+inline void bind_random(nb::module_& m)
+{
+    m.def("philox4x32_10", &philox4x32_10, "counter"_a, "key"_a);
+    m.def("pcg4d", &pcg4d, "v"_a);
+
+    bind_random_generator<Philox>(m, "Philox");
+    bind_random_generator<PCG>(m, "PCG");
+}
+
+} // namespace sgl::math
+
+SGL_PY_EXPORT(math_random)
+{
+    nb::module_ math = m.attr("math");
+
+    sgl::math::bind_random(math);
+}
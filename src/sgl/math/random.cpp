@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "random.h"
+
+#include "sgl/core/thread.h"
+#include "sgl/core/maths.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace sgl::math {
+
+namespace {
+
+    /// Number of blocks generated per batch. Batches are computed in structure-of-arrays
+    /// form so that the compiler can vectorize the generator rounds across blocks.
+    /// Large enough to keep compilers from fully unrolling (and not vectorizing) the loops.
+    constexpr size_t BATCH_BLOCKS = 64;
+    constexpr size_t BATCH_VALUES = BATCH_BLOCKS * 4;
+
+    /// Minimum number of values for which generation is split across the global thread pool.
+    constexpr size_t PARALLEL_MIN_COUNT = size_t(1) << 20;
+    /// Number of values generated per thread pool task.
+    constexpr size_t PARALLEL_CHUNK_VALUES = size_t(1) << 18;
+
+    struct PhiloxBatch {
+        uint32_t key0;
+        uint32_t key1;
+        uint32_t stream0;
+        uint32_t stream1;
+
+        PhiloxBatch(const Philox& generator)
+            : key0(uint32_t(generator.seed()))
+            , key1(uint32_t(generator.seed() >> 32))
+            , stream0(uint32_t(generator.stream()))
+            , stream1(uint32_t(generator.stream() >> 32))
+        {
+        }
+
+        void operator()(uint64_t first_block, uint32_t* values) const
+        {
+            uint32_t c0[BATCH_BLOCKS], c1[BATCH_BLOCKS], c2[BATCH_BLOCKS], c3[BATCH_BLOCKS];
+            for (size_t i = 0; i < BATCH_BLOCKS; ++i) {
+                c0[i] = uint32_t(first_block + i);
+                c1[i] = uint32_t((first_block + i) >> 32);
+                c2[i] = stream0;
+                c3[i] = stream1;
+            }
+            uint32_t k0 = key0;
+            uint32_t k1 = key1;
+            for (int round = 0; round < 10; ++round) {
+                // Widening multiplications in a separate loop vectorize (pmuludq) on SSE2/AVX2.
+                uint64_t p0[BATCH_BLOCKS], p1[BATCH_BLOCKS];
+                for (size_t i = 0; i < BATCH_BLOCKS; ++i) {
+                    p0[i] = uint64_t(c0[i]) * 0xD2511F53u;
+                    p1[i] = uint64_t(c2[i]) * 0xCD9E8D57u;
+                }
+                for (size_t i = 0; i < BATCH_BLOCKS; ++i) {
+                    c0[i] = uint32_t(p1[i] >> 32) ^ c1[i] ^ k0;
+                    c1[i] = uint32_t(p1[i]);
+                    c2[i] = uint32_t(p0[i] >> 32) ^ c3[i] ^ k1;
+                    c3[i] = uint32_t(p0[i]);
+                }
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            for (size_t i = 0; i < BATCH_BLOCKS; ++i) {
+                values[i * 4 + 0] = c0[i];
+                values[i * 4 + 1] = c1[i];
+                values[i * 4 + 2] = c2[i];
+                values[i * 4 + 3] = c3[i];
+            }
+        }
+    };
+
+    struct PCGBatch {
+        uint4 key;
+
+        PCGBatch(const PCG& generator)
+            : key(pcg4d(uint4(
+                uint32_t(generator.seed()),
+                uint32_t(generator.seed() >> 32),
+                uint32_t(generator.stream()),
+                uint32_t(generator.stream() >> 32)
+            )))
+        {
+        }
+
+        void operator()(uint64_t first_block, uint32_t* values) const
+        {
+            uint32_t x[BATCH_BLOCKS], y[BATCH_BLOCKS], z[BATCH_BLOCKS], w[BATCH_BLOCKS];
+            for (size_t i = 0; i < BATCH_BLOCKS; ++i) {
+                x[i] = (uint32_t(first_block + i) ^ key.x) * 1664525u + 1013904223u;
+                y[i] = (uint32_t((first_block + i) >> 32) ^ key.y) * 1664525u + 1013904223u;
+                z[i] = key.z * 1664525u + 1013904223u;
+                w[i] = key.w * 1664525u + 1013904223u;
+            }
+            for (size_t i = 0; i < BATCH_BLOCKS; ++i) {
+                x[i] += y[i] * w[i];
+                y[i] += z[i] * x[i];
+                z[i] += x[i] * y[i];
+                w[i] += y[i] * z[i];
+                x[i] ^= x[i] >> 16;
+                y[i] ^= y[i] >> 16;
+                z[i] ^= z[i] >> 16;
+                w[i] ^= w[i] >> 16;
+                x[i] += y[i] * w[i];
+                y[i] += z[i] * x[i];
+                z[i] += x[i] * y[i];
+                w[i] += y[i] * z[i];
+            }
+            for (size_t i = 0; i < BATCH_BLOCKS; ++i) {
+                values[i * 4 + 0] = x[i];
+                values[i * 4 + 1] = y[i];
+                values[i * 4 + 2] = z[i];
+                values[i * 4 + 3] = w[i];
+            }
+        }
+    };
+
+    template<typename Generator, typename Batch, typename T, typename Convert>
+    void fill_range(
+        const Generator& generator,
+        const Batch& batch,
+        T* data,
+        size_t count,
+        uint64_t offset,
+        Convert convert
+    )
+    {
+        // Values up to the first block boundary.
+        for (; count > 0 && offset % 4 != 0; --count)
+            *data++ = convert(generator.get_uint(offset++));
+
+        // Full batches.
+        uint32_t values[BATCH_VALUES];
+        for (; count >= BATCH_VALUES; count -= BATCH_VALUES) {
+            batch(offset / 4, values);
+            for (size_t i = 0; i < BATCH_VALUES; ++i)
+                data[i] = convert(values[i]);
+            data += BATCH_VALUES;
+            offset += BATCH_VALUES;
+        }
+
+        // Remaining values.
+        for (; count > 0; --count)
+            *data++ = convert(generator.get_uint(offset++));
+    }
+
+    template<typename Generator, typename T, typename Convert>
+    void fill(const Generator& generator, T* data, size_t count, uint64_t offset, Convert convert)
+    {
+        using Batch = std::conditional_t<std::is_same_v<Generator, Philox>, PhiloxBatch, PCGBatch>;
+        Batch batch(generator);
+
+        if (count < PARALLEL_MIN_COUNT) {
+            fill_range(generator, batch, data, count, offset, convert);
+            return;
+        }
+
+        size_t chunk_count = div_round_up(count, PARALLEL_CHUNK_VALUES);
+        auto fill_chunks = [&](size_t begin, size_t end)
+        {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                size_t first = chunk * PARALLEL_CHUNK_VALUES;
+                size_t chunk_size = std::min(PARALLEL_CHUNK_VALUES, count - first);
+                fill_range(generator, batch, data + first, chunk_size, offset + first, convert);
+            }
+        };
+        thread::parallel_for(size_t(0), chunk_count, fill_chunks);
+    }
+
+    inline uint32_t identity(uint32_t x)
+    {
+        return x;
+    }
+
+} // namespace
+
+void Philox::fill_uint(uint32_t* data, size_t count, uint64_t offset) const
+{
+    fill(*this, data, count, offset, identity);
+}
+
+void Philox::fill_float(float* data, size_t count, uint64_t offset) const
+{
+    fill(*this, data, count, offset, uint_to_unit_float);
+}
+
+void PCG::fill_uint(uint32_t* data, size_t count, uint64_t offset) const
+{
+    fill(*this, data, count, offset, identity);
+}
+
+void PCG::fill_float(float* data, size_t count, uint64_t offset) const
+{
+    fill(*this, data, count, offset, uint_to_unit_float);
+}
+
+} // namespace sgl::math
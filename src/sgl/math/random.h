@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sgl/core/macros.h"
+#include "sgl/math/vector.h"
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Counter-based random number generators.
+ *
+ * Counter-based generators compute random values as a pure function of (seed, stream, index),
+ * which makes them trivially parallel and reproducible. The same generators are implemented in
+ * the Slang module \c sgl/math/random.slang. Identical (seed, stream, index) triples produce
+ * identical values on host and device.
+ *
+ * A stream is a sequence of 32-bit values. Value \c i of a stream is component \c i % 4 of
+ * block \c i / 4, where each block is produced by a single evaluation of the generator.
+ * Floats are generated from the upper 24 bits of a value and are uniform in [0, 1).
+ */
+
+namespace sgl::math {
+
+/// Philox4x32 with 10 rounds (Salmon et al. 2011, "Parallel random numbers: as easy as 1, 2, 3").
+[[nodiscard]] inline uint4 philox4x32_10(uint4 counter, uint2 key)
+{
+    for (int i = 0; i < 10; ++i) {
+        uint64_t p0 = uint64_t(0xD2511F53u) * counter.x;
+        uint64_t p1 = uint64_t(0xCD9E8D57u) * counter.z;
+        counter = uint4(
+            uint32_t(p1 >> 32) ^ counter.y ^ key.x,
+            uint32_t(p1),
+            uint32_t(p0 >> 32) ^ counter.w ^ key.y,
+            uint32_t(p0)
+        );
+        key.x += 0x9E3779B9u;
+        key.y += 0xBB67AE85u;
+    }
+    return counter;
+}
+
+/// 4D PCG hash (Jarzynski and Olano 2020, "Hash functions for GPU rendering").
+[[nodiscard]] inline uint4 pcg4d(uint4 v)
+{
+    v = v * 1664525u + 1013904223u;
+    v.x += v.y * v.w;
+    v.y += v.z * v.x;
+    v.z += v.x * v.y;
+    v.w += v.y * v.z;
+    v ^= v >> 16u;
+    v.x += v.y * v.w;
+    v.y += v.z * v.x;
+    v.z += v.x * v.y;
+    v.w += v.y * v.z;
+    return v;
+}
+
+/// Convert a random 32-bit value to a float uniform in [0, 1).
+[[nodiscard]] inline float uint_to_unit_float(uint32_t x)
+{
+    return float(x >> 8) * 0x1p-24f;
+}
+
+/**
+ * Philox4x32-10 generator.
+ *
+ * The 64-bit seed is used as the key, the 64-bit block index and 64-bit stream form the counter.
+ * Statistically robust (passes BigCrush); preferred for simulations.
+ */
+class SGL_API Philox {
+public:
+    Philox(uint64_t seed = 0, uint64_t stream = 0)
+        : m_seed(seed)
+        , m_stream(stream)
+    {
+    }
+
+    uint64_t seed() const { return m_seed; }
+    uint64_t stream() const { return m_stream; }
+
+    /// Generate a block of 4 values.
+    [[nodiscard]] uint4 block(uint64_t block_index) const
+    {
+        return philox4x32_10(
+            uint4(uint32_t(block_index), uint32_t(block_index >> 32), uint32_t(m_stream), uint32_t(m_stream >> 32)),
+            uint2(uint32_t(m_seed), uint32_t(m_seed >> 32))
+        );
+    }
+
+    /// Get value \c index of the stream.
+    [[nodiscard]] uint32_t get_uint(uint64_t index) const { return block(index / 4)[int(index % 4)]; }
+
+    /// Get value \c index of the stream as a float in [0, 1).
+    [[nodiscard]] float get_float(uint64_t index) const { return uint_to_unit_float(get_uint(index)); }
+
+    /// Fill \c data with \c count values of the stream, starting at value \c offset.
+    void fill_uint(uint32_t* data, size_t count, uint64_t offset = 0) const;
+
+    /// Fill \c data with \c count floats in [0, 1), starting at value \c offset.
+    void fill_float(float* data, size_t count, uint64_t offset = 0) const;
+
+private:
+    uint64_t m_seed;
+    uint64_t m_stream;
+};
+
+/**
+ * PCG4D hash generator.
+ *
+ * Seed and stream are hashed to a 128-bit key once. Each block is the hash of the block index
+ * combined with the key. Considerably cheaper than \c Philox but with weaker statistical quality;
+ * intended for sample patterns and initial states where speed matters most.
+ */
+class SGL_API PCG {
+public:
+    PCG(uint64_t seed = 0, uint64_t stream = 0)
+        : m_seed(seed)
+        , m_stream(stream)
+        , m_key(pcg4d(uint4(uint32_t(seed), uint32_t(seed >> 32), uint32_t(stream), uint32_t(stream >> 32))))
+    {
+    }
+
+    uint64_t seed() const { return m_seed; }
+    uint64_t stream() const { return m_stream; }
+
+    /// Generate a block of 4 values.
+    [[nodiscard]] uint4 block(uint64_t block_index) const
+    {
+        return pcg4d(uint4(uint32_t(block_index), uint32_t(block_index >> 32), 0u, 0u) ^ m_key);
+    }
+
+    /// Get value \c index of the stream.
+    [[nodiscard]] uint32_t get_uint(uint64_t index) const { return block(index / 4)[int(index % 4)]; }
+
+    /// Get value \c index of the stream as a float in [0, 1).
+    [[nodiscard]] float get_float(uint64_t index) const { return uint_to_unit_float(get_uint(index)); }
+
+    /// Fill \c data with \c count values of the stream, starting at value \c offset.
+    void fill_uint(uint32_t* data, size_t count, uint64_t offset = 0) const;
+
+    /// Fill \c data with \c count floats in [0, 1), starting at value \c offset.
+    void fill_float(float* data, size_t count, uint64_t offset = 0) const;
+
+private:
+    uint64_t m_seed;
+    uint64_t m_stream;
+    uint4 m_key;
+};
+
+} // namespace sgl::math
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "testing.h"
+#include "sgl/math/random.h"
+
+#include <vector>
+
+using namespace sgl;
+
+TEST_SUITE_BEGIN("random");
+
+TEST_CASE("philox4x32_10")
+{
+    // Known answer tests from Random123.
+    CHECK(all(math::philox4x32_10(uint4(0), uint2(0)) == uint4(0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8)));
+    CHECK(all(
+        math::philox4x32_10(uint4(0xffffffff), uint2(0xffffffff))
+        == uint4(0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd)
+    ));
+    CHECK(all(
+        math::philox4x32_10(uint4(0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344), uint2(0xa4093822, 0x299f31d0))
+        == uint4(0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1)
+    ));
+}
+
+TEST_CASE("uint_to_unit_float")
+{
+    CHECK_EQ(math::uint_to_unit_float(0), 0.f);
+    CHECK_LT(math::uint_to_unit_float(0xffffffff), 1.f);
+    CHECK_EQ(math::uint_to_unit_float(0x80000000), 0.5f);
+}
+
+template<typename Generator>
+void check_fill(const Generator& generator)
+{
+    // Large enough to use the thread pool, odd sized to cover partial blocks and batches.
+    const size_t count = (size_t(1) << 20) + 13;
+    std::vector<uint32_t> uints(count);
+    std::vector<float> floats(count);
+
+    for (uint64_t offset : {uint64_t(0), uint64_t(3), uint64_t(1) << 33}) {
+        generator.fill_uint(uints.data(), count, offset);
+        generator.fill_float(floats.data(), count, offset);
+        for (size_t i = 0; i < count; i += (i < 1024 ? 1 : 997)) {
+            uint32_t value = generator.get_uint(offset + i);
+            CHECK_EQ(uints[i], value);
+            CHECK_EQ(floats[i], math::uint_to_unit_float(value));
+        }
+        CHECK_EQ(uints[count - 1], generator.get_uint(offset + count - 1));
+    }
+}
+
+TEST_CASE("Philox")
+{
+    math::Philox generator(0x0123456789abcdefull, 42);
+    CHECK_EQ(generator.seed(), 0x0123456789abcdefull);
+    CHECK_EQ(generator.stream(), 42);
+    CHECK(all(
+        generator.block(0x1122334455667788ull)
+        == math::philox4x32_10(uint4(0x55667788, 0x11223344, 42, 0), uint2(0x89abcdef, 0x01234567))
+    ));
+    check_fill(generator);
+
+    // Different streams produce different values.
+    CHECK_NE(math::Philox(1, 0).get_uint(0), math::Philox(1, 1).get_uint(0));
+}
+
+TEST_CASE("PCG")
+{
+    math::PCG generator(0x0123456789abcdefull, 42);
+    CHECK(all(generator.block(0) == math::PCG(0x0123456789abcdefull, 42).block(0)));
+    check_fill(generator);
+
+    CHECK_NE(math::PCG(1, 0).get_uint(0), math::PCG(1, 1).get_uint(0));
+    CHECK_NE(math::PCG(1, 0).get_uint(0), math::PCG(2, 0).get_uint(0));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,111 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import pytest
+import sys
+import sgl
+import numpy as np
+from pathlib import Path
+
+sys.path.append(str(Path(__file__).parent.parent.parent / "device/tests"))
+import sglhelpers as helpers
+from sglhelpers import test_id  # type: ignore (pytest fixture)
+
+
+def test_philox4x32_10():
+    # Known answer tests from Random123.
+    assert sgl.math.philox4x32_10(sgl.uint4(0), sgl.uint2(0)) == sgl.uint4(
+        0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8
+    )
+    assert sgl.math.philox4x32_10(
+        sgl.uint4(0x243F6A88, 0x85A308D3, 0x13198A2E, 0x03707344),
+        sgl.uint2(0xA4093822, 0x299F31D0),
+    ) == sgl.uint4(0xD16CFE09, 0x94FDCCEB, 0x5001E420, 0x24126EA1)
+
+
+@pytest.mark.parametrize("generator_type", [sgl.math.Philox, sgl.math.PCG])
+def test_arrays(generator_type: type):
+    generator = generator_type(seed=1234, stream=5)
+    assert generator.seed == 1234
+    assert generator.stream == 5
+
+    uints = generator.uint_array(1001, offset=3)
+    assert uints.dtype == np.uint32
+    assert uints.shape == (1001,)
+    assert all(uints[i] == generator.get_uint(i + 3) for i in range(0, 1001, 7))
+
+    floats = generator.float_array(1001, offset=3)
+    assert floats.dtype == np.float32
+    assert np.all(floats >= 0) and np.all(floats < 1)
+    assert np.all(floats == (uints >> 8).astype(np.float32) * np.float32(2**-24))
+    assert floats[10] == generator.get_float(13)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_host_device_match(test_id: str, device_type: sgl.DeviceType):
+    device = helpers.get_device(type=device_type)
+
+    module = device.load_module_from_source(
+        f"test_random_{test_id}",
+        r"""
+        import sgl.math.random;
+
+        uniform uint seed;
+        uniform uint stream;
+        RWStructuredBuffer<uint> philox;
+        RWStructuredBuffer<uint> pcg;
+        RWStructuredBuffer<float> philox_float;
+
+        [shader("compute")]
+        [numthreads(64, 1, 1)]
+        void main(uint3 tid: SV_DispatchThreadID)
+        {
+            philox[tid.x] = Philox(seed, stream).get_uint(tid.x);
+            pcg[tid.x] = PCG(seed, stream).get_uint(tid.x);
+            philox_float[tid.x] = Philox(seed, stream).get_float(tid.x);
+        }
+    """,
+    )
+    program = device.link_program([module], [module.entry_point("main")])
+    kernel = device.create_compute_kernel(program)
+
+    N = 1024
+    SEED = 12345
+    STREAM = 7
+
+    def create_buffer(element_size: int):
+        return device.create_buffer(
+            element_count=N,
+            struct_size=element_size,
+            usage=sgl.ResourceUsage.unordered_access,
+        )
+
+    philox = create_buffer(4)
+    pcg = create_buffer(4)
+    philox_float = create_buffer(4)
+
+    kernel.dispatch(
+        thread_count=[N, 1, 1],
+        vars={
+            "seed": SEED,
+            "stream": STREAM,
+            "philox": philox,
+            "pcg": pcg,
+            "philox_float": philox_float,
+        },
+    )
+
+    assert np.all(
+        philox.to_numpy().view(np.uint32)
+        == sgl.math.Philox(SEED, STREAM).uint_array(N)
+    )
+    assert np.all(
+        pcg.to_numpy().view(np.uint32) == sgl.math.PCG(SEED, STREAM).uint_array(N)
+    )
+    assert np.all(
+        philox_float.to_numpy().view(np.float32)
+        == sgl.math.Philox(SEED, STREAM).float_array(N)
+    )
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
@@ -13,8 +13,13 @@ SGL_PY_DECLARE(app_app);
 
 SGL_PY_DECLARE(core_bitmap);
 SGL_PY_DECLARE(core_crypto);
+SGL_PY_DECLARE(core_async_io);
+SGL_PY_DECLARE(core_dds_file);
+SGL_PY_DECLARE(core_image_scanner);
 SGL_PY_DECLARE(core_input);
 SGL_PY_DECLARE(core_logger);
+SGL_PY_DECLARE(core_memory_pool);
+SGL_PY_DECLARE(core_metrics);
 SGL_PY_DECLARE(core_object);
 SGL_PY_DECLARE(core_platform);
 SGL_PY_DECLARE(core_struct);
@@ -22,8 +27,10 @@ SGL_PY_DECLARE(core_thread);
 SGL_PY_DECLARE(core_timer);
 SGL_PY_DECLARE(core_window);
 
+SGL_PY_DECLARE(device_benchmark);
 SGL_PY_DECLARE(device_buffer_cursor);
 SGL_PY_DECLARE(device_command);
+SGL_PY_DECLARE(device_command_bundle);
 SGL_PY_DECLARE(device_device_resource);
 SGL_PY_DECLARE(device_device);
 SGL_PY_DECLARE(device_fence);
@@ -32,15 +39,19 @@ SGL_PY_DECLARE(device_framebuffer);
 SGL_PY_DECLARE(device_input_layout);
 SGL_PY_DECLARE(device_kernel);
 SGL_PY_DECLARE(device_memory_heap);
+SGL_PY_DECLARE(device_message_channel);
 SGL_PY_DECLARE(device_pipeline);
+SGL_PY_DECLARE(device_primitives);
 SGL_PY_DECLARE(device_query);
 SGL_PY_DECLARE(device_raytracing);
 SGL_PY_DECLARE(device_reflection);
+SGL_PY_DECLARE(device_reflection_snapshot);
 SGL_PY_DECLARE(device_resource);
 SGL_PY_DECLARE(device_sampler);
 SGL_PY_DECLARE(device_shader_cursor);
 SGL_PY_DECLARE(device_shader_object);
 SGL_PY_DECLARE(device_shader);
+SGL_PY_DECLARE(device_shader_archive);
 SGL_PY_DECLARE(device_swapchain);
 SGL_PY_DECLARE(device_types);
 
@@ -48,10 +59,12 @@ SGL_PY_DECLARE(math_scalar);
 SGL_PY_DECLARE(math_vector);
 SGL_PY_DECLARE(math_matrix);
 SGL_PY_DECLARE(math_quaternion);
+SGL_PY_DECLARE(math_random);
 
 SGL_PY_DECLARE(ui);
 SGL_PY_DECLARE(ui_widgets);
 
+SGL_PY_DECLARE(utils_environment_map);
 SGL_PY_DECLARE(utils_renderdoc);
 SGL_PY_DECLARE(utils_slangpy);
 SGL_PY_DECLARE(utils_tev);
@@ -90,14 +103,20 @@ NB_MODULE(sgl_ext, m_)
     SGL_PY_IMPORT(core_timer);
     SGL_PY_IMPORT(core_window);
     SGL_PY_IMPORT(core_struct);
+    SGL_PY_IMPORT(core_memory_pool);
+    SGL_PY_IMPORT(core_metrics);
     SGL_PY_IMPORT(core_bitmap);
     SGL_PY_IMPORT(core_crypto);
+    SGL_PY_IMPORT(core_async_io);
+    SGL_PY_IMPORT(core_dds_file);
+    SGL_PY_IMPORT(core_image_scanner);
 
     m.def_submodule("math", "Math module");
     SGL_PY_IMPORT(math_scalar);
     SGL_PY_IMPORT(math_vector);
     SGL_PY_IMPORT(math_matrix);
     SGL_PY_IMPORT(math_quaternion);
+    SGL_PY_IMPORT(math_random);
 
     SGL_PY_IMPORT(device_types);
     SGL_PY_IMPORT(device_formats);
@@ -110,15 +129,21 @@ NB_MODULE(sgl_ext, m_)
     SGL_PY_IMPORT(device_pipeline);
     SGL_PY_IMPORT(device_raytracing);
     SGL_PY_IMPORT(device_reflection);
+    SGL_PY_IMPORT(device_reflection_snapshot);
     SGL_PY_IMPORT(device_shader);
+    SGL_PY_IMPORT(device_shader_archive);
     SGL_PY_IMPORT(device_buffer_cursor);
     SGL_PY_IMPORT(device_shader_object);
     SGL_PY_IMPORT(device_shader_cursor);
     SGL_PY_IMPORT(device_framebuffer);
     SGL_PY_IMPORT(device_swapchain);
     SGL_PY_IMPORT(device_command);
+    SGL_PY_IMPORT(device_command_bundle);
     SGL_PY_IMPORT(device_kernel);
     SGL_PY_IMPORT(device_memory_heap);
+    SGL_PY_IMPORT(device_benchmark);
+    SGL_PY_IMPORT(device_primitives);
+    SGL_PY_IMPORT(device_message_channel);
     SGL_PY_IMPORT(device_device);
 
     m.def_submodule("ui", "UI module");
@@ -132,6 +157,7 @@ NB_MODULE(sgl_ext, m_)
     m.def_submodule("tev", "tev image viewer module");
     SGL_PY_IMPORT(utils_tev);
     SGL_PY_IMPORT(utils_texture_loader);
+    SGL_PY_IMPORT(utils_environment_map);
 
     SGL_PY_IMPORT(app_app);
 
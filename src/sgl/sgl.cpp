@@ -2,6 +2,7 @@
 
 #include "sgl.h"
 
+#include "sgl/core/async_io.h"
 #include "sgl/core/logger.h"
 #include "sgl/core/platform.h"
 #include "sgl/core/bitmap.h"
@@ -34,6 +35,7 @@ void static_shutdown()
 {
     thread::wait_for_tasks();
 
+    async_io::static_shutdown();
     Bitmap::static_shutdown();
     platform::static_shutdown();
     Logger::static_shutdown();
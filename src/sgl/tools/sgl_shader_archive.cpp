@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: Apache-2.0
+
+// Offline tool compiling a set of programs into a shader archive (see sgl::ShaderArchive).
+//
+// Usage:
+//   sgl_shader_archive --output <file> [--device-type <type>] [--include <dir>]...
+//                      --program <name>=<module>:<entry_point>[,<entry_point>]...
+//
+// After writing the archive, all programs are loaded from source and from the archive in new
+// sessions and the time spent in each stage is reported. Archives only skip the slang front end
+// (parsing, checking and IR generation), linking and target code generation remain.
+
+#include "sgl/sgl.h"
+#include "sgl/core/enum.h"
+#include "sgl/core/logger.h"
+#include "sgl/core/string.h"
+#include "sgl/core/timer.h"
+#include "sgl/device/device.h"
+#include "sgl/device/shader.h"
+#include "sgl/device/shader_archive.h"
+#include "sgl/device/agility_sdk.h"
+
+#include <cstring>
+#include <exception>
+
+SGL_EXPORT_AGILITY_SDK
+
+using namespace sgl;
+
+static void print_usage()
+{
+    fmt::print(
+        "Usage: sgl_shader_archive --output <file> [--device-type <type>] [--include <dir>]...\n"
+        "                          --program <name>=<module>:<entry_point>[,<entry_point>]...\n"
+    );
+}
+
+/// Parse a program specification of the form "name=module:entry_point[,entry_point...]".
+static ShaderArchiveProgramDesc parse_program(std::string_view spec)
+{
+    size_t eq = spec.find('=');
+    size_t colon = spec.rfind(':');
+    SGL_CHECK(
+        eq != std::string_view::npos && colon != std::string_view::npos && eq < colon,
+        "Invalid program specification \"{}\".",
+        spec
+    );
+    ShaderArchiveProgramDesc desc{
+        .name = std::string(spec.substr(0, eq)),
+        .module_name = std::string(spec.substr(eq + 1, colon - eq - 1)),
+        .entry_point_names = string::split(spec.substr(colon + 1), ","),
+    };
+    SGL_CHECK(
+        !desc.name.empty() && !desc.module_name.empty() && !desc.entry_point_names.empty(),
+        "Invalid program specification \"{}\".",
+        spec
+    );
+    return desc;
+}
+
+static void run(
+    const std::filesystem::path& output,
+    DeviceType device_type,
+    const std::vector<std::filesystem::path>& include_paths,
+    const std::vector<ShaderArchiveProgramDesc>& programs
+)
+{
+    ref<Device> device = Device::create({
+        .type = device_type,
+        .compiler_options = {.include_paths = include_paths},
+    });
+
+    ref<ShaderArchive> archive = ShaderArchive::build(device, programs);
+    archive->write(output);
+
+    size_t archive_size = 0;
+    for (const ShaderArchive::Module& module : archive->modules())
+        archive_size += module.data.size();
+    log_info(
+        "Wrote shader archive \"{}\" ({} programs, {} modules, {}).",
+        output,
+        archive->programs().size(),
+        archive->modules().size(),
+        string::format_byte_size(archive_size)
+    );
+
+    auto create_session = [&]()
+    {
+        return device->create_slang_session({
+            .compiler_options = device->desc().compiler_options,
+            .add_default_include_paths = true,
+        });
+    };
+
+    // Load all programs from source, timing the front end and linking separately.
+    Timer timer;
+    ref<SlangSession> source_session = create_session();
+    std::vector<ref<SlangModule>> source_modules;
+    for (const ShaderArchiveProgramDesc& program : programs)
+        source_modules.push_back(source_session->load_module(program.module_name));
+    double source_front_end_time = timer.elapsed_s();
+    for (size_t i = 0; i < programs.size(); ++i) {
+        std::vector<ref<SlangEntryPoint>> entry_points;
+        for (const std::string& entry_point_name : programs[i].entry_point_names)
+            entry_points.push_back(source_modules[i]->entry_point(entry_point_name));
+        source_session->link_program({source_modules[i]}, std::move(entry_points));
+    }
+    double source_link_time = timer.elapsed_s() - source_front_end_time;
+
+    // Load all programs back from the written archive to verify it.
+    timer.reset();
+    ref<SlangSession> archive_session = create_session();
+    ref<ShaderArchive> loaded_archive = make_ref<ShaderArchive>(output);
+    for (const ShaderArchiveProgramDesc& program : programs)
+        archive_session->load_program_from_archive(loaded_archive, program.name);
+    double archive_time = timer.elapsed_s();
+
+    // Target code generation happens at pipeline creation in both cases and is not included.
+    log_info(
+        "Program load time: {} from source ({} front end, {} linking), {} from archive (including linking).",
+        string::format_duration(source_front_end_time + source_link_time),
+        string::format_duration(source_front_end_time),
+        string::format_duration(source_link_time),
+        string::format_duration(archive_time)
+    );
+
+    device->close();
+}
+
+int main(int argc, char** argv)
+{
+    std::filesystem::path output;
+    DeviceType device_type = DeviceType::automatic;
+    std::vector<std::filesystem::path> include_paths;
+    std::vector<ShaderArchiveProgramDesc> programs;
+
+    sgl::static_init();
+
+    int result = 0;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            bool has_value = i + 1 < argc;
+            if (std::strcmp(argv[i], "--output") == 0 && has_value) {
+                output = argv[++i];
+            } else if (std::strcmp(argv[i], "--device-type") == 0 && has_value) {
+                device_type = string_to_enum<DeviceType>(argv[++i]);
+            } else if (std::strcmp(argv[i], "--include") == 0 && has_value) {
+                include_paths.push_back(argv[++i]);
+            } else if (std::strcmp(argv[i], "--program") == 0 && has_value) {
+                programs.push_back(parse_program(argv[++i]));
+            } else {
+                print_usage();
+                SGL_THROW("Invalid argument \"{}\".", argv[i]);
+            }
+        }
+        if (output.empty() || programs.empty()) {
+            print_usage();
+            SGL_THROW("Missing output file or programs.");
+        }
+        run(output, device_type, include_paths, programs);
+    } catch (const std::exception& e) {
+        log_error("{}", e.what());
+        result = 1;
+    }
+
+    sgl::static_shutdown();
+
+    return result;
+}
@@ -37,5 +37,6 @@ SGL_PY_EXPORT(ui)
         .def("handle_keyboard_event", &ui::Context::handle_keyboard_event, "event"_a, D(Context, handle_keyboard_event))
         .def("handle_mouse_event", &ui::Context::handle_mouse_event, "event"_a, D(Context, handle_mouse_event))
         .def("process_events", &ui::Context::process_events, D(Context, process_events))
-        .def_prop_ro("screen", &ui::Context::screen, D(Context, screen));
+        .def_prop_ro("screen", &ui::Context::screen, D(Context, screen))
+        .def_prop_ro("draw_data_changed", &ui::Context::draw_data_changed, D_NA(Context, draw_data_changed));
 }
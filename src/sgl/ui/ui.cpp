@@ -17,10 +17,13 @@
 #include "sgl/device/shader_cursor.h"
 #include "sgl/device/pipeline.h"
 #include "sgl/device/framebuffer.h"
+#include "sgl/device/memory_heap.h"
 
 #include <imgui.h>
 #include <cmrc/cmrc.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <unordered_map>
 
 CMRC_DECLARE(sgl_data);
@@ -298,6 +301,15 @@ Context::Context(ref<Device> device)
         .max_lod = 0.f,
     });
 
+    // Setup heap for vertex & index data.
+    m_draw_data_heap = m_device->create_memory_heap({
+        .memory_type = MemoryType::upload,
+        .usage = ResourceUsage::vertex | ResourceUsage::index,
+        .page_size = 1024 * 1024,
+        .retain_large_pages = true,
+        .debug_name = "imgui draw data heap",
+    });
+
     // Setup program.
     m_program = m_device->load_program("sgl/ui/imgui.slang", {"vs_main", "fs_main"});
 
@@ -368,95 +380,155 @@ void Context::render(Framebuffer* framebuffer, CommandBuffer* command_buffer)
     ImGui::Render();
     ImDrawData* draw_data = ImGui::GetDrawData();
 
-    if (draw_data->CmdListsCount > 0) {
-        // Cycle through vertex & index buffers.
-        ref<Buffer>& vertex_buffer = m_vertex_buffers[m_frame_index];
-        ref<Buffer>& index_buffer = m_index_buffers[m_frame_index];
-        m_frame_index = (m_frame_index + 1) % FRAME_COUNT;
-
-        // Allocate vertex buffer.
-        if (!vertex_buffer || vertex_buffer->size() < draw_data->TotalVtxCount * sizeof(ImDrawVert)) {
-            vertex_buffer = m_device->create_buffer({
-                .size = draw_data->TotalVtxCount * sizeof(ImDrawVert) + 128 * 1024,
-                .usage = ResourceUsage::vertex,
-                .memory_type = MemoryType::upload,
-                .debug_name = "imgui vertex buffer",
-            });
-        }
+    // Release draw data of previous frames that is no longer in use by the device.
+    m_draw_data_heap->execute_deferred_releases();
+
+    if (draw_data->CmdListsCount == 0) {
+        m_draw_data_changed = !m_draw_commands.empty();
+        m_vertex_allocation.reset();
+        m_index_allocation.reset();
+        m_draw_commands.clear();
+        m_vertex_data.clear();
+        m_index_data.clear();
+        return;
+    }
 
-        // Allocate index buffer.
-        if (!index_buffer || index_buffer->size() < draw_data->TotalIdxCount * sizeof(ImDrawIdx)) {
-            index_buffer = m_device->create_buffer({
-                .size = draw_data->TotalIdxCount * sizeof(ImDrawIdx) + 1024,
-                .usage = ResourceUsage::index,
-                .memory_type = MemoryType::upload,
-                .debug_name = "imgui index buffer",
-            });
-        }
+    m_draw_data_changed = update_draw_data(draw_data);
+
+    // Render command lists.
+    RenderCommandEncoder encoder = command_buffer->encode_render_commands(framebuffer);
+    ref<ShaderObject> shader_object = encoder.bind_pipeline(get_pipeline(framebuffer));
+    ShaderCursor shader_cursor = ShaderCursor(shader_object);
+    shader_cursor["sampler"] = m_sampler;
+    shader_cursor["scale"] = 2.f / float2(io.DisplaySize.x, -io.DisplaySize.y);
+    shader_cursor["offset"] = float2(-1.f, 1.f);
+    shader_cursor["is_srgb_format"] = is_srgb_format;
+    ShaderOffset texture_offset = shader_cursor["texture"].offset();
+
+    encoder.set_vertex_buffer(0, m_vertex_allocation->buffer, m_vertex_allocation->offset);
+    encoder.set_index_buffer(
+        m_index_allocation->buffer,
+        sizeof(ImDrawIdx) == 2 ? Format::r16_uint : Format::r32_uint,
+        m_index_allocation->offset
+    );
+    encoder.set_primitive_topology(PrimitiveTopology::triangle_list);
+    encoder.set_viewport_and_scissor_rect({
+        .x = 0.f,
+        .y = 0.f,
+        .width = io.DisplaySize.x,
+        .height = io.DisplaySize.y,
+        .min_depth = 0.f,
+        .max_depth = 1.f,
+    });
 
-        // Upload vertex & index data.
-        ImDrawVert* vertices = vertex_buffer->map<ImDrawVert>();
-        ImDrawIdx* indices = index_buffer->map<ImDrawIdx>();
-        for (int i = 0; i < draw_data->CmdListsCount; ++i) {
-            const ImDrawList* cmd_list = draw_data->CmdLists[i];
-            std::memcpy(vertices, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
-            std::memcpy(indices, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
-            vertices += cmd_list->VtxBuffer.Size;
-            indices += cmd_list->IdxBuffer.Size;
+    // The framebuffer is redrawn every frame, so the draw commands are encoded even if the draw data
+    // did not change. Consecutive commands mostly share the font texture, which is only bound once.
+    const Texture* bound_texture = nullptr;
+    for (size_t i = 0; i < m_draw_commands.size(); ++i) {
+        DrawCommand& cmd = m_draw_commands[i];
+        // Apply scissor/clipping rectangle, bind texture, draw.
+        encoder.set_scissor_rects(std::span<ScissorRect>{&cmd.clip_rect, 1});
+        if (i == 0 || cmd.texture != bound_texture) {
+            shader_object->set_resource(texture_offset, cmd.texture ? cmd.texture->get_srv() : nullptr);
+            bound_texture = cmd.texture;
         }
-        vertex_buffer->unmap();
-        index_buffer->unmap();
-
-        // Render command lists.
-        RenderCommandEncoder encoder = command_buffer->encode_render_commands(framebuffer);
-        ref<ShaderObject> shader_object = encoder.bind_pipeline(get_pipeline(framebuffer));
-        ShaderCursor shader_cursor = ShaderCursor(shader_object);
-        shader_cursor["sampler"] = m_sampler;
-        shader_cursor["scale"] = 2.f / float2(io.DisplaySize.x, -io.DisplaySize.y);
-        shader_cursor["offset"] = float2(-1.f, 1.f);
-        shader_cursor["is_srgb_format"] = is_srgb_format;
-        ShaderOffset texture_offset = shader_cursor["texture"].offset();
-
-        encoder.set_vertex_buffer(0, vertex_buffer);
-        encoder.set_index_buffer(index_buffer, sizeof(ImDrawIdx) == 2 ? Format::r16_uint : Format::r32_uint);
-        encoder.set_primitive_topology(PrimitiveTopology::triangle_list);
-        encoder.set_viewport_and_scissor_rect({
-            .x = 0.f,
-            .y = 0.f,
-            .width = io.DisplaySize.x,
-            .height = io.DisplaySize.y,
-            .min_depth = 0.f,
-            .max_depth = 1.f,
-        });
+        encoder.draw_indexed(cmd.index_count, cmd.index_offset, cmd.vertex_offset);
+    }
+}
 
-        int vertex_offset = 0;
-        int index_offset = 0;
-        ImVec2 clip_off = draw_data->DisplayPos;
-        for (int n = 0; n < draw_data->CmdListsCount; n++) {
-            const ImDrawList* cmd_list = draw_data->CmdLists[n];
-            for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++) {
-                const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
-                SGL_ASSERT(pcmd->UserCallback == nullptr);
-                // Project scissor/clipping rectangles into framebuffer space.
-                ScissorRect clip_rect{
-                    .min_x = int32_t(pcmd->ClipRect.x - clip_off.x),
-                    .min_y = int32_t(pcmd->ClipRect.y - clip_off.y),
-                    .max_x = int32_t(pcmd->ClipRect.z - clip_off.x),
-                    .max_y = int32_t(pcmd->ClipRect.w - clip_off.y),
-                };
-                if (clip_rect.max_x <= clip_rect.min_x || clip_rect.max_y <= clip_rect.min_y)
-                    continue;
-
-                // Apply scissor/clipping rectangle, bind texture, draw.
-                encoder.set_scissor_rects(std::span<ScissorRect>{&clip_rect, 1});
-                Texture* texture = static_cast<Texture*>(pcmd->GetTexID());
-                shader_object->set_resource(texture_offset, texture ? texture->get_srv() : nullptr);
-                encoder.draw_indexed(pcmd->ElemCount, pcmd->IdxOffset + index_offset, pcmd->VtxOffset + vertex_offset);
-            }
-            index_offset += cmd_list->IdxBuffer.Size;
-            vertex_offset += cmd_list->VtxBuffer.Size;
+bool Context::update_draw_data(const ImDrawData* draw_data)
+{
+    // Translate command lists to draw commands.
+    std::vector<DrawCommand> draw_commands;
+    draw_commands.reserve(m_draw_commands.size());
+    uint32_t vertex_offset = 0;
+    uint32_t index_offset = 0;
+    ImVec2 clip_off = draw_data->DisplayPos;
+    for (int n = 0; n < draw_data->CmdListsCount; n++) {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++) {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            SGL_ASSERT(pcmd->UserCallback == nullptr);
+            // Project scissor/clipping rectangles into framebuffer space.
+            ScissorRect clip_rect{
+                .min_x = int32_t(pcmd->ClipRect.x - clip_off.x),
+                .min_y = int32_t(pcmd->ClipRect.y - clip_off.y),
+                .max_x = int32_t(pcmd->ClipRect.z - clip_off.x),
+                .max_y = int32_t(pcmd->ClipRect.w - clip_off.y),
+            };
+            if (clip_rect.max_x <= clip_rect.min_x || clip_rect.max_y <= clip_rect.min_y)
+                continue;
+
+            draw_commands.push_back({
+                .clip_rect = clip_rect,
+                .texture = static_cast<Texture*>(pcmd->GetTexID()),
+                .index_count = pcmd->ElemCount,
+                .index_offset = pcmd->IdxOffset + index_offset,
+                .vertex_offset = pcmd->VtxOffset + vertex_offset,
+            });
         }
+        index_offset += cmd_list->IdxBuffer.Size;
+        vertex_offset += cmd_list->VtxBuffer.Size;
+    }
+
+    // ImGui rebuilds its draw lists every frame without tracking changes,
+    // so compare sizes first and only then the data of the previous upload.
+    size_t vertex_size = draw_data->TotalVtxCount * sizeof(ImDrawVert);
+    size_t index_size = draw_data->TotalIdxCount * sizeof(ImDrawIdx);
+    auto same_command = [](const DrawCommand& a, const DrawCommand& b)
+    {
+        return std::memcmp(&a.clip_rect, &b.clip_rect, sizeof(ScissorRect)) == 0 && a.texture == b.texture
+            && a.index_count == b.index_count && a.index_offset == b.index_offset
+            && a.vertex_offset == b.vertex_offset;
+    };
+    bool changed = !m_vertex_allocation || vertex_size != m_vertex_data.size() || index_size != m_index_data.size();
+    changed = changed
+        || !std::equal(
+                  draw_commands.begin(),
+                  draw_commands.end(),
+                  m_draw_commands.begin(),
+                  m_draw_commands.end(),
+                  same_command
+        );
+    size_t vertex_pos = 0;
+    size_t index_pos = 0;
+    for (int n = 0; n < draw_data->CmdListsCount && !changed; n++) {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        size_t list_vertex_size = cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
+        size_t list_index_size = cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+        changed = std::memcmp(m_vertex_data.data() + vertex_pos, cmd_list->VtxBuffer.Data, list_vertex_size) != 0
+            || std::memcmp(m_index_data.data() + index_pos, cmd_list->IdxBuffer.Data, list_index_size) != 0;
+        vertex_pos += list_vertex_size;
+        index_pos += list_index_size;
+    }
+    if (!changed)
+        return false;
+
+    m_draw_commands = std::move(draw_commands);
+
+    // Keep a host copy of the vertex & index data for comparing the next frame.
+    m_vertex_data.resize(vertex_size);
+    m_index_data.resize(index_size);
+    vertex_pos = 0;
+    index_pos = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++) {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        size_t list_vertex_size = cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
+        size_t list_index_size = cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+        std::memcpy(m_vertex_data.data() + vertex_pos, cmd_list->VtxBuffer.Data, list_vertex_size);
+        std::memcpy(m_index_data.data() + index_pos, cmd_list->IdxBuffer.Data, list_index_size);
+        vertex_pos += list_vertex_size;
+        index_pos += list_index_size;
     }
+
+    // Sub-allocate vertex & index data from the heap and upload it. Replaced allocations are
+    // released once the device has finished all work submitted before the replacement.
+    m_vertex_allocation = m_draw_data_heap->allocate(std::max(vertex_size, sizeof(ImDrawVert)));
+    m_index_allocation = m_draw_data_heap->allocate(std::max(index_size, sizeof(ImDrawIdx)));
+    std::memcpy(m_vertex_allocation->data, m_vertex_data.data(), vertex_size);
+    std::memcpy(m_index_allocation->data, m_index_data.data(), index_size);
+
+    return true;
 }
 
 bool Context::handle_keyboard_event(const KeyboardEvent& event)
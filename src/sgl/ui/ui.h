@@ -10,11 +10,15 @@
 
 #include "sgl/device/fwd.h"
 #include "sgl/device/framebuffer.h"
+#include "sgl/device/memory_heap.h"
+#include "sgl/device/types.h"
 
 #include <map>
+#include <vector>
 
 struct ImGuiContext;
 struct ImFont;
+struct ImDrawData;
 
 namespace sgl::ui {
 
@@ -36,22 +40,42 @@ public:
 
     void process_events();
 
+    /// True if the draw data of the last \c render call changed since the previous call.
+    /// Unchanged draw data is not uploaded again, but its draw commands are still encoded
+    /// into the framebuffer, which is usually redrawn every frame.
+    bool draw_data_changed() const { return m_draw_data_changed; }
+
 private:
     GraphicsPipeline* get_pipeline(Framebuffer* framebuffer);
 
-    static constexpr uint32_t FRAME_COUNT = 3;
+    /// Update the cached draw data. Returns false if the draw data did not change.
+    bool update_draw_data(const ImDrawData* draw_data);
+
+    /// Draw command translated from ImGui draw data.
+    struct DrawCommand {
+        ScissorRect clip_rect;
+        Texture* texture;
+        uint32_t index_count;
+        uint32_t index_offset;
+        uint32_t vertex_offset;
+    };
 
     ref<Device> m_device;
     ImGuiContext* m_imgui_context;
 
     ref<Screen> m_screen;
 
-    uint32_t m_frame_index{0};
     Timer m_frame_timer;
 
     ref<Sampler> m_sampler;
-    ref<Buffer> m_vertex_buffers[FRAME_COUNT];
-    ref<Buffer> m_index_buffers[FRAME_COUNT];
+    ref<MemoryHeap> m_draw_data_heap;
+    MemoryHeap::Allocation m_vertex_allocation;
+    MemoryHeap::Allocation m_index_allocation;
+    std::vector<DrawCommand> m_draw_commands;
+    /// Host copy of the uploaded vertex & index data, used to detect changes.
+    std::vector<uint8_t> m_vertex_data;
+    std::vector<uint8_t> m_index_data;
+    bool m_draw_data_changed{false};
     ref<ShaderProgram> m_program;
     ref<Texture> m_font_texture;
     ref<InputLayout> m_input_layout;
@@ -0,0 +1,606 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "environment_map.h"
+
+#include "sgl/device/device.h"
+#include "sgl/device/command.h"
+#include "sgl/device/kernel.h"
+#include "sgl/device/resource.h"
+#include "sgl/device/sampler.h"
+#include "sgl/device/shader.h"
+#include "sgl/device/shader_cursor.h"
+
+#include "sgl/core/error.h"
+#include "sgl/core/bitmap.h"
+#include "sgl/core/format.h"
+#include "sgl/core/maths.h"
+#include "sgl/core/thread.h"
+
+#include "sgl/math/vector.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numbers>
+
+namespace sgl {
+
+// The helpers below mirror the functions in environment_map.slang.
+
+static constexpr float PI = std::numbers::pi_v<float>;
+
+/// Maximum number of equirectangular lookups per axis and cube map texel.
+static constexpr uint32_t MAX_SAMPLES_PER_AXIS = 8;
+
+static float2 texel_uv(uint2 texel, uint32_t size)
+{
+    return (float2(texel) + 0.5f) * (2.f / float(size)) - 1.f;
+}
+
+static float texel_solid_angle(uint2 texel, uint32_t size)
+{
+    auto area = [](float x, float y) { return std::atan2(x * y, std::sqrt(x * x + y * y + 1.f)); };
+    float2 p0 = float2(texel) * (2.f / float(size)) - 1.f;
+    float2 p1 = p0 + 2.f / float(size);
+    return area(p0.x, p0.y) - area(p0.x, p1.y) - area(p1.x, p0.y) + area(p1.x, p1.y);
+}
+
+static float2 equirect_uv(float3 dir)
+{
+    return float2(
+        std::atan2(dir.x, -dir.z) * (0.5f / PI) + 0.5f,
+        std::acos(std::clamp(dir.y, -1.f, 1.f)) * (1.f / PI)
+    );
+}
+
+static float3 sample_equirect(const Bitmap* src, float2 uv)
+{
+    int width = int(src->width());
+    int height = int(src->height());
+    const float3* data = reinterpret_cast<const float3*>(src->data());
+    float2 p = uv * float2(float(width), float(height)) - 0.5f;
+    float2 p0 = floor(p);
+    float2 f = p - p0;
+    int x0 = int(p0.x) % width;
+    x0 = x0 < 0 ? x0 + width : x0;
+    int x1 = (x0 + 1) % width;
+    int y0 = std::clamp(int(p0.y), 0, height - 1);
+    int y1 = std::clamp(int(p0.y) + 1, 0, height - 1);
+    float3 c00 = data[y0 * width + x0];
+    float3 c10 = data[y0 * width + x1];
+    float3 c01 = data[y1 * width + x0];
+    float3 c11 = data[y1 * width + x1];
+    return lerp(lerp(c00, c10, float3(f.x)), lerp(c01, c11, float3(f.x)), float3(f.y));
+}
+
+static float ggx_d(float n_dot_h, float alpha)
+{
+    float a2 = alpha * alpha;
+    float d = n_dot_h * n_dot_h * (a2 - 1.f) + 1.f;
+    return a2 / (PI * d * d);
+}
+
+static void sh_basis(float3 d, float basis[9])
+{
+    basis[0] = 0.282095f;
+    basis[1] = 0.488603f * d.y;
+    basis[2] = 0.488603f * d.z;
+    basis[3] = 0.488603f * d.x;
+    basis[4] = 1.092548f * d.x * d.y;
+    basis[5] = 1.092548f * d.y * d.z;
+    basis[6] = 0.315392f * (3.f * d.z * d.z - 1.f);
+    basis[7] = 1.092548f * d.x * d.z;
+    basis[8] = 0.546274f * (d.x * d.x - d.y * d.y);
+}
+
+/// Factors of the clamped cosine lobe convolution per band.
+static float sh_band_factor(uint32_t k)
+{
+    return k == 0 ? PI : (k < 4 ? 2.f * PI / 3.f : PI / 4.f);
+}
+
+static uint32_t default_face_size(uint32_t equirect_width)
+{
+    return std::bit_floor(std::max(equirect_width / 4, 1u));
+}
+
+static uint32_t samples_per_axis(uint32_t equirect_width, uint32_t face_size)
+{
+    return std::clamp(div_round_up(equirect_width, 4 * face_size), 1u, MAX_SAMPLES_PER_AXIS);
+}
+
+static void check_faces(const std::vector<ref<Bitmap>>& faces)
+{
+    SGL_CHECK(faces.size() == 6, "Expected 6 cube map faces.");
+    for (const ref<Bitmap>& face : faces) {
+        SGL_CHECK_NOT_NULL(face);
+        SGL_CHECK(
+            face->pixel_format() == Bitmap::PixelFormat::rgb
+                && face->component_type() == Bitmap::ComponentType::float32,
+            "Cube map faces need to be RGB float32 bitmaps."
+        );
+        SGL_CHECK(
+            face->width() == faces[0]->width() && face->height() == faces[0]->width(),
+            "Cube map faces need to be square and have the same size."
+        );
+    }
+}
+
+static std::vector<ref<Bitmap>> create_face_bitmaps(uint32_t face_size)
+{
+    std::vector<ref<Bitmap>> faces(6);
+    for (auto& face : faces)
+        face = make_ref<Bitmap>(Bitmap::PixelFormat::rgb, Bitmap::ComponentType::float32, face_size, face_size);
+    return faces;
+}
+
+/// Run \c func(face, y) for all rows of 6 cube map faces on the global thread pool.
+template<typename F>
+static void parallel_for_rows(uint32_t face_size, F&& func)
+{
+    thread::parallel_for(
+        0u,
+        6 * face_size,
+        [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+                func(i / face_size, i % face_size);
+        }
+    );
+}
+
+float3 IrradianceSH::evaluate(float3 normal) const
+{
+    float basis[9];
+    sh_basis(normal, basis);
+    float3 result(0.f);
+    for (uint32_t k = 0; k < 9; ++k)
+        result += coefficients[k] * basis[k];
+    return result;
+}
+
+std::string IrradianceSH::to_string() const
+{
+    return fmt::format("IrradianceSH(coefficients = [{}])", fmt::join(coefficients, ", "));
+}
+
+EnvironmentMapBaker::EnvironmentMapBaker(ref<Device> device)
+    : m_device(std::move(device))
+{
+    std::string source = m_device->slang_session()->load_source("sgl/utils/environment_map.slang");
+    ref<SlangModule> module = m_device->slang_session()->load_module_from_source("environment_map", source);
+    module->break_strong_reference_to_session();
+    auto create_kernel = [&](const char* entry_point)
+    {
+        ref<ShaderProgram> program
+            = m_device->slang_session()->link_program({module}, {module->entry_point(entry_point)});
+        return m_device->create_compute_kernel({.program = program});
+    };
+    m_equirect_to_cube_kernel = create_kernel("equirect_to_cube");
+    m_downsample_kernel = create_kernel("downsample");
+    m_prefilter_kernel = create_kernel("prefilter");
+    m_project_sh_kernel = create_kernel("project_sh");
+    m_reduce_sh_kernel = create_kernel("reduce_sh");
+
+    m_linear_sampler = m_device->create_sampler({
+        .min_filter = TextureFilteringMode::linear,
+        .mag_filter = TextureFilteringMode::linear,
+        .mip_filter = TextureFilteringMode::linear,
+        .address_u = TextureAddressingMode::clamp_to_edge,
+        .address_v = TextureAddressingMode::clamp_to_edge,
+        .address_w = TextureAddressingMode::clamp_to_edge,
+    });
+    m_point_sampler = m_device->create_sampler({
+        .min_filter = TextureFilteringMode::point,
+        .mag_filter = TextureFilteringMode::point,
+        .mip_filter = TextureFilteringMode::point,
+        .address_u = TextureAddressingMode::clamp_to_edge,
+        .address_v = TextureAddressingMode::clamp_to_edge,
+        .address_w = TextureAddressingMode::clamp_to_edge,
+    });
+
+    // One partial sum of 9 coefficients per thread group (8x8 texels) of the projected faces.
+    uint32_t group_count = div_round_up(SH_MAX_FACE_SIZE, 8u);
+    m_sh_partials = m_device->create_buffer({
+        .element_count = 6 * group_count * group_count * 9,
+        .struct_size = sizeof(float4),
+        .usage = ResourceUsage::unordered_access,
+        .debug_name = "environment_map_sh_partials",
+    });
+}
+
+EnvironmentMapBaker::~EnvironmentMapBaker() = default;
+
+ref<Texture> EnvironmentMapBaker::create_cube(Format format, uint32_t face_size, uint32_t mip_count)
+{
+    return m_device->create_texture({
+        .type = ResourceType::texture_cube,
+        .format = format,
+        .width = face_size,
+        .height = face_size,
+        .mip_count = mip_count,
+        .usage = ResourceUsage::shader_resource,
+        .debug_name = "environment_map_cube",
+    });
+}
+
+ref<Texture> EnvironmentMapBaker::create_faces(Format format, uint32_t face_size, uint32_t mip_count)
+{
+    return m_device->create_texture({
+        .type = ResourceType::texture_2d,
+        .format = format,
+        .width = face_size,
+        .height = face_size,
+        .array_size = 6,
+        .mip_count = mip_count,
+        .usage = ResourceUsage::shader_resource | ResourceUsage::unordered_access,
+        .debug_name = "environment_map_faces",
+    });
+}
+
+void EnvironmentMapBaker::generate_mips(CommandBuffer* command_buffer, Texture* faces)
+{
+    for (uint32_t mip = 1; mip < faces->mip_count(); ++mip) {
+        uint32_t src_size = faces->get_mip_width(mip - 1);
+        uint32_t dst_size = faces->get_mip_width(mip);
+        m_downsample_kernel->dispatch(
+            uint3(dst_size, dst_size, 6),
+            [&](ShaderCursor cursor)
+            {
+                cursor["src"] = faces->get_srv({.mip_level = mip - 1, .mip_count = 1});
+                cursor["src_size"] = src_size;
+                cursor["dst"] = faces->get_uav({.mip_level = mip, .mip_count = 1});
+                cursor["dst_size"] = dst_size;
+            },
+            command_buffer
+        );
+    }
+}
+
+void EnvironmentMapBaker::copy_faces(CommandBuffer* command_buffer, Texture* cube, Texture* faces)
+{
+    SGL_ASSERT(cube->mip_count() == faces->mip_count());
+    for (uint32_t face = 0; face < 6; ++face) {
+        for (uint32_t mip = 0; mip < cube->mip_count(); ++mip) {
+            command_buffer->copy_texture_region(
+                cube,
+                cube->get_subresource_index(mip, face),
+                uint3(0),
+                faces,
+                faces->get_subresource_index(mip, face),
+                uint3(0)
+            );
+        }
+    }
+}
+
+ref<Texture> EnvironmentMapBaker::equirect_to_cube(
+    const Texture* equirect,
+    uint32_t face_size,
+    Format format,
+    CommandBuffer* command_buffer
+)
+{
+    SGL_CHECK_NOT_NULL(equirect);
+    SGL_CHECK(equirect->type() == ResourceType::texture_2d, "Equirectangular map needs to be a 2D texture.");
+
+    if (face_size == 0)
+        face_size = default_face_size(equirect->width());
+
+    ref<CommandBuffer> temp_command_buffer;
+    if (!command_buffer) {
+        temp_command_buffer = m_device->create_command_buffer();
+        command_buffer = temp_command_buffer;
+    }
+
+    ref<Texture> cube = create_cube(format, face_size, 0);
+    ref<Texture> faces = create_faces(format, face_size, cube->mip_count());
+
+    m_equirect_to_cube_kernel->dispatch(
+        uint3(face_size, face_size, 6),
+        [&](ShaderCursor cursor)
+        {
+            cursor["src"] = const_cast<Texture*>(equirect)->get_srv({.mip_level = 0, .mip_count = 1});
+            cursor["src_size"] = uint2(equirect->width(), equirect->height());
+            cursor["dst"] = faces->get_uav({.mip_level = 0, .mip_count = 1});
+            cursor["dst_size"] = face_size;
+            cursor["samples_per_axis"] = samples_per_axis(equirect->width(), face_size);
+        },
+        command_buffer
+    );
+    generate_mips(command_buffer, faces);
+    copy_faces(command_buffer, cube, faces);
+
+    if (temp_command_buffer)
+        temp_command_buffer->submit();
+
+    return cube;
+}
+
+ref<Texture> EnvironmentMapBaker::equirect_to_cube(const Bitmap* equirect, uint32_t face_size, Format format)
+{
+    SGL_CHECK_NOT_NULL(equirect);
+
+    ref<Bitmap> rgba = equirect->convert(Bitmap::PixelFormat::rgba, Bitmap::ComponentType::float32, false);
+    ref<Texture> texture = m_device->create_texture({
+        .format = Format::rgba32_float,
+        .width = rgba->width(),
+        .height = rgba->height(),
+        .mip_count = 1,
+        .usage = ResourceUsage::shader_resource,
+        .debug_name = "environment_map_equirect",
+        .data = rgba->data(),
+        .data_size = rgba->buffer_size(),
+    });
+    return equirect_to_cube(texture, face_size, format);
+}
+
+ref<Texture> EnvironmentMapBaker::prefilter_specular(
+    const Texture* cube,
+    uint32_t face_size,
+    uint32_t sample_count,
+    CommandBuffer* command_buffer
+)
+{
+    SGL_CHECK_NOT_NULL(cube);
+    SGL_CHECK(cube->type() == ResourceType::texture_cube, "Source needs to be a cube texture.");
+    SGL_CHECK(sample_count > 0, "Sample count must be at least 1.");
+
+    if (face_size == 0)
+        face_size = cube->width();
+
+    ref<CommandBuffer> temp_command_buffer;
+    if (!command_buffer) {
+        temp_command_buffer = m_device->create_command_buffer();
+        command_buffer = temp_command_buffer;
+    }
+
+    ref<Texture> result = create_cube(cube->format(), face_size, 0);
+    ref<Texture> faces = create_faces(cube->format(), face_size, result->mip_count());
+
+    uint32_t mip_count = result->mip_count();
+    for (uint32_t mip = 0; mip < mip_count; ++mip) {
+        uint32_t dst_size = faces->get_mip_width(mip);
+        float roughness = mip_count > 1 ? float(mip) / float(mip_count - 1) : 0.f;
+        m_prefilter_kernel->dispatch(
+            uint3(dst_size, dst_size, 6),
+            [&](ShaderCursor cursor)
+            {
+                cursor["src"] = const_cast<Texture*>(cube)->get_srv();
+                cursor["sampler"] = m_linear_sampler;
+                cursor["src_size"] = cube->width();
+                cursor["src_max_lod"] = float(cube->mip_count() - 1);
+                cursor["dst"] = faces->get_uav({.mip_level = mip, .mip_count = 1});
+                cursor["dst_size"] = dst_size;
+                cursor["roughness"] = roughness;
+                cursor["sample_count"] = sample_count;
+            },
+            command_buffer
+        );
+    }
+    copy_faces(command_buffer, result, faces);
+
+    if (temp_command_buffer)
+        temp_command_buffer->submit();
+
+    return result;
+}
+
+IrradianceSH EnvironmentMapBaker::compute_irradiance_sh(const Texture* cube)
+{
+    ref<Buffer> result = m_device->create_buffer({
+        .element_count = 9,
+        .struct_size = sizeof(float4),
+        .usage = ResourceUsage::unordered_access,
+        .debug_name = "environment_map_sh",
+    });
+    ref<CommandBuffer> command_buffer = m_device->create_command_buffer();
+    compute_irradiance_sh(command_buffer, cube, result, 0);
+    command_buffer->submit();
+
+    std::vector<float4> coefficients = result->get_elements<float4>(0, 9);
+    IrradianceSH sh;
+    for (uint32_t k = 0; k < 9; ++k)
+        sh.coefficients[k] = coefficients[k].xyz();
+    return sh;
+}
+
+void EnvironmentMapBaker::compute_irradiance_sh(
+    CommandBuffer* command_buffer,
+    const Texture* cube,
+    Buffer* dst,
+    uint32_t index
+)
+{
+    SGL_CHECK_NOT_NULL(command_buffer);
+    SGL_CHECK_NOT_NULL(cube);
+    SGL_CHECK_NOT_NULL(dst);
+    SGL_CHECK(cube->type() == ResourceType::texture_cube, "Source needs to be a cube texture.");
+    SGL_CHECK_LE((uint64_t(index) + 1) * 9 * sizeof(float4), dst->size());
+
+    // Project from the first mip level that fits into the partial sums buffer.
+    uint32_t mip = 0;
+    while (cube->get_mip_width(mip) > SH_MAX_FACE_SIZE && mip + 1 < cube->mip_count())
+        ++mip;
+    uint32_t size = cube->get_mip_width(mip);
+    SGL_CHECK(size <= SH_MAX_FACE_SIZE, "Cube map needs mip levels with at most {} texels per side.", SH_MAX_FACE_SIZE);
+    uint32_t group_count = div_round_up(size, 8u);
+
+    // Partial sums are shared between calls recorded to the same command buffer.
+    command_buffer->uav_barrier(m_sh_partials);
+    m_project_sh_kernel->dispatch(
+        uint3(size, size, 6),
+        [&](ShaderCursor cursor)
+        {
+            cursor["src"] = const_cast<Texture*>(cube)->get_srv();
+            cursor["sampler"] = m_point_sampler;
+            cursor["size"] = size;
+            cursor["lod"] = float(mip);
+            cursor["group_count"] = uint2(group_count, group_count);
+            cursor["partials"] = m_sh_partials;
+        },
+        command_buffer
+    );
+    command_buffer->uav_barrier(m_sh_partials);
+    m_reduce_sh_kernel->dispatch(
+        uint3(9, 1, 1),
+        [&](ShaderCursor cursor)
+        {
+            cursor["partials"] = m_sh_partials;
+            cursor["partial_count"] = 6 * group_count * group_count;
+            cursor["dst"] = ref<Buffer>(dst);
+            cursor["dst_offset"] = index * 9;
+        },
+        command_buffer
+    );
+}
+
+float3 EnvironmentMapBaker::cube_direction(uint32_t face, float2 uv)
+{
+    switch (face) {
+    case 0:
+        return float3(1.f, -uv.y, -uv.x);
+    case 1:
+        return float3(-1.f, -uv.y, uv.x);
+    case 2:
+        return float3(uv.x, 1.f, uv.y);
+    case 3:
+        return float3(uv.x, -1.f, -uv.y);
+    case 4:
+        return float3(uv.x, -uv.y, 1.f);
+    case 5:
+        return float3(-uv.x, -uv.y, -1.f);
+    default:
+        SGL_THROW("Invalid cube map face {}.", face);
+    }
+}
+
+std::vector<ref<Bitmap>> EnvironmentMapBaker::equirect_to_cube_cpu(const Bitmap* equirect, uint32_t face_size)
+{
+    SGL_CHECK_NOT_NULL(equirect);
+
+    ref<Bitmap> src = equirect->convert(Bitmap::PixelFormat::rgb, Bitmap::ComponentType::float32, false);
+    if (face_size == 0)
+        face_size = default_face_size(src->width());
+    uint32_t samples = samples_per_axis(src->width(), face_size);
+
+    std::vector<ref<Bitmap>> faces = create_face_bitmaps(face_size);
+    parallel_for_rows(
+        face_size,
+        [&](uint32_t face, uint32_t y)
+        {
+            float3* row = reinterpret_cast<float3*>(faces[face]->data()) + size_t(y) * face_size;
+            for (uint32_t x = 0; x < face_size; ++x) {
+                float3 sum(0.f);
+                for (uint32_t j = 0; j < samples; ++j) {
+                    for (uint32_t i = 0; i < samples; ++i) {
+                        float2 offset = (float2(float(i), float(j)) + 0.5f) / float(samples);
+                        float2 uv = (float2(float(x), float(y)) + offset) * (2.f / float(face_size)) - 1.f;
+                        float3 dir = normalize(cube_direction(face, uv));
+                        sum += sample_equirect(src, equirect_uv(dir));
+                    }
+                }
+                row[x] = sum / float(samples * samples);
+            }
+        }
+    );
+    return faces;
+}
+
+std::vector<ref<Bitmap>>
+EnvironmentMapBaker::prefilter_specular_cpu(const std::vector<ref<Bitmap>>& faces, float roughness, uint32_t face_size)
+{
+    check_faces(faces);
+    SGL_CHECK(roughness >= 0.f && roughness <= 1.f, "Roughness must be in [0, 1].");
+
+    uint32_t src_size = faces[0]->width();
+    if (face_size == 0)
+        face_size = src_size;
+
+    // Directions and solid angles of all source texels.
+    struct Texel {
+        float3 dir;
+        float3 radiance;
+        float solid_angle;
+    };
+    std::vector<Texel> texels;
+    texels.reserve(6 * size_t(src_size) * src_size);
+    for (uint32_t face = 0; face < 6; ++face) {
+        const float3* data = reinterpret_cast<const float3*>(faces[face]->data());
+        for (uint32_t y = 0; y < src_size; ++y) {
+            for (uint32_t x = 0; x < src_size; ++x) {
+                texels.push_back({
+                    .dir = normalize(cube_direction(face, texel_uv(uint2(x, y), src_size))),
+                    .radiance = data[y * src_size + x],
+                    .solid_angle = texel_solid_angle(uint2(x, y), src_size),
+                });
+            }
+        }
+    }
+
+    // Integrate the split-sum lobe over all source texels. For zero roughness the lobe is
+    // a mirror reflection, which picks the source texel closest to the normal.
+    float alpha = roughness * roughness;
+    std::vector<ref<Bitmap>> result = create_face_bitmaps(face_size);
+    parallel_for_rows(
+        face_size,
+        [&](uint32_t face, uint32_t y)
+        {
+            float3* row = reinterpret_cast<float3*>(result[face]->data()) + size_t(y) * face_size;
+            for (uint32_t x = 0; x < face_size; ++x) {
+                float3 n = normalize(cube_direction(face, texel_uv(uint2(x, y), face_size)));
+                if (roughness == 0.f) {
+                    auto it = std::max_element(
+                        texels.begin(),
+                        texels.end(),
+                        [&](const Texel& a, const Texel& b) { return dot(n, a.dir) < dot(n, b.dir); }
+                    );
+                    row[x] = it->radiance;
+                    continue;
+                }
+                float3 sum(0.f);
+                float weight = 0.f;
+                for (const Texel& texel : texels) {
+                    float n_dot_l = dot(n, texel.dir);
+                    if (n_dot_l <= 0.f)
+                        continue;
+                    float3 h = normalize(n + texel.dir);
+                    float w = ggx_d(dot(n, h), alpha) * n_dot_l * texel.solid_angle;
+                    sum += texel.radiance * w;
+                    weight += w;
+                }
+                row[x] = sum / std::max(weight, 1e-8f);
+            }
+        }
+    );
+    return result;
+}
+
+IrradianceSH EnvironmentMapBaker::compute_irradiance_sh_cpu(const std::vector<ref<Bitmap>>& faces)
+{
+    check_faces(faces);
+
+    uint32_t size = faces[0]->width();
+    std::array<math::vector<double, 3>, 9> sums;
+    sums.fill(math::vector<double, 3>(0.0));
+    for (uint32_t face = 0; face < 6; ++face) {
+        const float3* data = reinterpret_cast<const float3*>(faces[face]->data());
+        for (uint32_t y = 0; y < size; ++y) {
+            for (uint32_t x = 0; x < size; ++x) {
+                float3 dir = normalize(cube_direction(face, texel_uv(uint2(x, y), size)));
+                float basis[9];
+                sh_basis(dir, basis);
+                float3 radiance = data[y * size + x] * texel_solid_angle(uint2(x, y), size);
+                for (uint32_t k = 0; k < 9; ++k)
+                    sums[k] += math::vector<double, 3>(radiance * basis[k]);
+            }
+        }
+    }
+
+    IrradianceSH sh;
+    for (uint32_t k = 0; k < 9; ++k)
+        sh.coefficients[k] = float3(sums[k]) * sh_band_factor(k);
+    return sh;
+}
+
+} // namespace sgl
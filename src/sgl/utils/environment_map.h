@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sgl/device/fwd.h"
+#include "sgl/device/formats.h"
+
+#include "sgl/core/fwd.h"
+#include "sgl/core/object.h"
+
+#include "sgl/math/vector_types.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace sgl {
+
+/**
+ * \brief Irradiance of an environment as spherical harmonics (bands 0-2).
+ *
+ * The coefficients are the radiance projection convolved with the clamped cosine lobe,
+ * i.e. \c evaluate() returns irradiance (divide by pi for the outgoing radiance of a white Lambertian surface).
+ */
+struct SGL_API IrradianceSH {
+    /// Coefficients ordered by (l, m): (0,0), (1,-1), (1,0), (1,1), (2,-2), (2,-1), (2,0), (2,1), (2,2).
+    std::array<float3, 9> coefficients;
+
+    /// Evaluate the irradiance for a (normalized) surface normal.
+    float3 evaluate(float3 normal) const;
+
+    std::string to_string() const;
+};
+
+/**
+ * \brief Utility class for preparing environment maps for image-based lighting.
+ *
+ * Converts equirectangular maps to cube maps, prefilters cube maps for specular lighting
+ * and computes irradiance spherical harmonics. All GPU paths have a CPU reference implementation,
+ * which is intended for testing and headless use with small maps.
+ *
+ * Cube maps use the D3D/Vulkan face order +X, -X, +Y, -Y, +Z, -Z. Equirectangular maps use
+ * a y-up frame with the image center mapping to -Z. Cube maps are created as \c ResourceType::texture_cube
+ * with a full mip chain.
+ *
+ * GPU work is recorded into an optional command buffer. When baking many probes, record them
+ * into a single command buffer and use the buffer variant of \c compute_irradiance_sh() to avoid
+ * synchronizing with the device for every probe.
+ */
+class SGL_API EnvironmentMapBaker : public Object {
+    SGL_OBJECT(EnvironmentMapBaker)
+public:
+    /// Largest face size used for projecting to spherical harmonics.
+    /// Larger cube maps are projected from the first mip level that fits.
+    static constexpr uint32_t SH_MAX_FACE_SIZE = 64;
+
+    EnvironmentMapBaker(ref<Device> device);
+    ~EnvironmentMapBaker();
+
+    /**
+     * \brief Convert an equirectangular map to a cube map.
+     *
+     * Mip levels are generated with a 2x2 box filter.
+     *
+     * \param equirect Equirectangular 2D texture (float or normalized format).
+     * \param face_size Face size of the cube map (0 to use a quarter of the source width rounded down to a power of
+     * two).
+     * \param format Format of the cube map (needs to support unordered access).
+     * \param command_buffer Command buffer to record to (submitted immediately if null).
+     * \return New cube texture.
+     */
+    ref<Texture> equirect_to_cube(
+        const Texture* equirect,
+        uint32_t face_size = 0,
+        Format format = Format::rgba16_float,
+        CommandBuffer* command_buffer = nullptr
+    );
+
+    /**
+     * \brief Convert an equirectangular bitmap to a cube map.
+     *
+     * Bitmaps with sRGB gamma are converted to linear values before upload.
+     *
+     * \param equirect Equirectangular bitmap.
+     * \param face_size Face size of the cube map (0 to use a quarter of the source width rounded down to a power of
+     * two).
+     * \param format Format of the cube map (needs to support unordered access).
+     * \return New cube texture.
+     */
+    ref<Texture>
+    equirect_to_cube(const Bitmap* equirect, uint32_t face_size = 0, Format format = Format::rgba16_float);
+
+    /**
+     * \brief Prefilter a cube map for specular image-based lighting.
+     *
+     * Mip level \c i of the result is convolved with the GGX distribution for
+     * roughness <tt>i / (mip_count - 1)</tt> (perceptual roughness, alpha = roughness^2),
+     * using the split-sum approximation with n = v = r. Samples are taken with filtered importance
+     * sampling from the mip levels of the source, which needs a full mip chain to avoid noise.
+     *
+     * \param cube Source cube texture (with mip levels).
+     * \param face_size Face size of the result (0 to use the source face size).
+     * \param sample_count Number of samples per texel.
+     * \param command_buffer Command buffer to record to (submitted immediately if null).
+     * \return New cube texture with the same format as the source.
+     */
+    ref<Texture> prefilter_specular(
+        const Texture* cube,
+        uint32_t face_size = 0,
+        uint32_t sample_count = 64,
+        CommandBuffer* command_buffer = nullptr
+    );
+
+    /**
+     * \brief Compute the irradiance spherical harmonics of a cube map.
+     *
+     * \param cube Source cube texture.
+     * \return Irradiance coefficients.
+     */
+    IrradianceSH compute_irradiance_sh(const Texture* cube);
+
+    /**
+     * \brief Record computing the irradiance spherical harmonics of a cube map.
+     *
+     * Writes the 9 coefficients as \c float4 values (w = 0) to \c dst starting at element <tt>index * 9</tt>.
+     *
+     * \param command_buffer Command buffer to record to.
+     * \param cube Source cube texture.
+     * \param dst Destination buffer (needs unordered access).
+     * \param index Index of the coefficient set in \c dst.
+     */
+    void compute_irradiance_sh(CommandBuffer* command_buffer, const Texture* cube, Buffer* dst, uint32_t index = 0);
+
+    /// Direction (not normalized) of face coordinates \c uv in [-1, 1]^2 on cube map face \c face.
+    static float3 cube_direction(uint32_t face, float2 uv);
+
+    /**
+     * \brief Convert an equirectangular bitmap to cube map faces on the CPU.
+     *
+     * \param equirect Equirectangular bitmap.
+     * \param face_size Face size (0 to use a quarter of the source width rounded down to a power of two).
+     * \return 6 RGB float32 bitmaps.
+     */
+    static std::vector<ref<Bitmap>> equirect_to_cube_cpu(const Bitmap* equirect, uint32_t face_size = 0);
+
+    /**
+     * \brief Prefilter cube map faces with the GGX distribution on the CPU.
+     *
+     * Integrates over all source texels (no sampling noise), which is only practical for small maps.
+     *
+     * \param faces 6 source faces.
+     * \param roughness Perceptual roughness.
+     * \param face_size Face size of the result (0 to use the source face size).
+     * \return 6 RGB float32 bitmaps.
+     */
+    static std::vector<ref<Bitmap>>
+    prefilter_specular_cpu(const std::vector<ref<Bitmap>>& faces, float roughness, uint32_t face_size = 0);
+
+    /**
+     * \brief Compute the irradiance spherical harmonics of cube map faces on the CPU.
+     *
+     * \param faces 6 source faces.
+     * \return Irradiance coefficients.
+     */
+    static IrradianceSH compute_irradiance_sh_cpu(const std::vector<ref<Bitmap>>& faces);
+
+private:
+    ref<Texture> create_cube(Format format, uint32_t face_size, uint32_t mip_count);
+    ref<Texture> create_faces(Format format, uint32_t face_size, uint32_t mip_count);
+    void generate_mips(CommandBuffer* command_buffer, Texture* faces);
+    void copy_faces(CommandBuffer* command_buffer, Texture* cube, Texture* faces);
+
+    ref<Device> m_device;
+    ref<ComputeKernel> m_equirect_to_cube_kernel;
+    ref<ComputeKernel> m_downsample_kernel;
+    ref<ComputeKernel> m_prefilter_kernel;
+    ref<ComputeKernel> m_project_sh_kernel;
+    ref<ComputeKernel> m_reduce_sh_kernel;
+    ref<Sampler> m_linear_sampler;
+    ref<Sampler> m_point_sampler;
+    ref<Buffer> m_sh_partials;
+};
+
+} // namespace sgl
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "nanobind.h"
+
+#include "sgl/utils/environment_map.h"
+
+#include "sgl/device/device.h"
+#include "sgl/device/resource.h"
+#include "sgl/device/command.h"
+
+#include "sgl/core/bitmap.h"
+
+SGL_PY_EXPORT(utils_environment_map)
+{
+    using namespace sgl;
+
+    nb::class_<IrradianceSH>(m, "IrradianceSH", D_NA(IrradianceSH))
+        .def(nb::init<>())
+        .def_rw("coefficients", &IrradianceSH::coefficients, D_NA(IrradianceSH, coefficients))
+        .def("evaluate", &IrradianceSH::evaluate, "normal"_a, D_NA(IrradianceSH, evaluate))
+        .def("__repr__", &IrradianceSH::to_string);
+
+    nb::class_<EnvironmentMapBaker, Object>(m, "EnvironmentMapBaker", D_NA(EnvironmentMapBaker))
+        .def(nb::init<ref<Device>>(), "device"_a, D_NA(EnvironmentMapBaker, EnvironmentMapBaker))
+        .def_ro_static("SH_MAX_FACE_SIZE", &EnvironmentMapBaker::SH_MAX_FACE_SIZE)
+        .def(
+            "equirect_to_cube",
+            nb::overload_cast<const Texture*, uint32_t, Format, CommandBuffer*>(&EnvironmentMapBaker::equirect_to_cube),
+            "equirect"_a,
+            "face_size"_a = 0,
+            "format"_a = Format::rgba16_float,
+            "command_buffer"_a.none() = nullptr,
+            D_NA(EnvironmentMapBaker, equirect_to_cube)
+        )
+        .def(
+            "equirect_to_cube",
+            nb::overload_cast<const Bitmap*, uint32_t, Format>(&EnvironmentMapBaker::equirect_to_cube),
+            "equirect"_a,
+            "face_size"_a = 0,
+            "format"_a = Format::rgba16_float,
+            D_NA(EnvironmentMapBaker, equirect_to_cube, 2)
+        )
+        .def(
+            "prefilter_specular",
+            &EnvironmentMapBaker::prefilter_specular,
+            "cube"_a,
+            "face_size"_a = 0,
+            "sample_count"_a = 64,
+            "command_buffer"_a.none() = nullptr,
+            D_NA(EnvironmentMapBaker, prefilter_specular)
+        )
+        .def(
+            "compute_irradiance_sh",
+            nb::overload_cast<const Texture*>(&EnvironmentMapBaker::compute_irradiance_sh),
+            "cube"_a,
+            D_NA(EnvironmentMapBaker, compute_irradiance_sh)
+        )
+        .def(
+            "compute_irradiance_sh",
+            nb::overload_cast<CommandBuffer*, const Texture*, Buffer*, uint32_t>(
+                &EnvironmentMapBaker::compute_irradiance_sh
+            ),
+            "command_buffer"_a,
+            "cube"_a,
+            "dst"_a,
+            "index"_a = 0,
+            D_NA(EnvironmentMapBaker, compute_irradiance_sh, 2)
+        )
+        .def_static(
+            "cube_direction",
+            &EnvironmentMapBaker::cube_direction,
+            "face"_a,
+            "uv"_a,
+            D_NA(EnvironmentMapBaker, cube_direction)
+        )
+        .def_static(
+            "equirect_to_cube_cpu",
+            &EnvironmentMapBaker::equirect_to_cube_cpu,
+            "equirect"_a,
+            "face_size"_a = 0,
+            D_NA(EnvironmentMapBaker, equirect_to_cube_cpu)
+        )
+        .def_static(
+            "prefilter_specular_cpu",
+            &EnvironmentMapBaker::prefilter_specular_cpu,
+            "faces"_a,
+            "roughness"_a,
+            "face_size"_a = 0,
+            D_NA(EnvironmentMapBaker, prefilter_specular_cpu)
+        )
+        .def_static(
+            "compute_irradiance_sh_cpu",
+            &EnvironmentMapBaker::compute_irradiance_sh_cpu,
+            "faces"_a,
+            D_NA(EnvironmentMapBaker, compute_irradiance_sh_cpu)
+        );
+}
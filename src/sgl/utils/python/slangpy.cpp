@@ -80,6 +80,53 @@ void NativeBoundVariableRuntime::populate_call_shape(std::vector<int>& call_shap
     }
 }
 
+void NativeBoundVariableRuntime::resolve_gradient_reduction(
+    const Shape& call_shape,
+    size_t thread_count,
+    uint32_t thread_group_size
+)
+{
+    if (m_children) {
+        for (const auto& [name, child_ref] : *m_children) {
+            if (child_ref) {
+                child_ref->resolve_gradient_reduction(call_shape, thread_count, thread_group_size);
+            }
+        }
+        return;
+    }
+
+    m_resolved_gradient_reduction = {};
+    if (m_access.second != AccessType::write && m_access.second != AccessType::readwrite) {
+        return;
+    }
+    if (!m_transform.valid() || !m_shape.valid()) {
+        return;
+    }
+
+    // Dimensions mapped to call dimensions select the destination value of a thread, the
+    // remaining (element) dimensions are written by every thread. Broadcast dimensions have
+    // size 1, so the number of threads per destination value is thread_count / destination_count.
+    const auto& tf = m_transform.as_vector();
+    const auto& shape = m_shape.as_vector();
+    size_t csl = call_shape.size();
+    size_t destination_count = 1;
+    size_t element_count = 1;
+    for (size_t i = 0; i < shape.size(); ++i) {
+        element_count *= shape[i];
+        if (i < tf.size() && tf[i] < static_cast<int>(csl)) {
+            destination_count *= shape[i];
+        }
+    }
+
+    m_resolved_gradient_reduction = select_gradient_reduction(
+        m_gradient_reduction,
+        thread_count,
+        destination_count,
+        element_count,
+        thread_group_size
+    );
+}
+
 void NativeBoundVariableRuntime::write_call_data_pre_dispatch(
     CallContext* context,
     nb::dict call_data,
@@ -182,6 +229,20 @@ Shape NativeBoundCallRuntime::calculate_call_shape(int call_dimensionality, nb::
     return Shape(call_shape);
 }
 
+void NativeBoundCallRuntime::resolve_gradient_reductions(
+    const Shape& call_shape,
+    size_t thread_count,
+    uint32_t thread_group_size
+)
+{
+    for (const auto& arg : m_args) {
+        arg->resolve_gradient_reduction(call_shape, thread_count, thread_group_size);
+    }
+    for (const auto& [name, kwarg] : m_kwargs) {
+        kwarg->resolve_gradient_reduction(call_shape, thread_count, thread_group_size);
+    }
+}
+
 void NativeBoundCallRuntime::write_calldata_pre_dispatch(
     CallContext* context,
     nb::dict call_data,
@@ -234,6 +295,14 @@ nb::object NativeCallData::append_to(ref<CommandBuffer> command_buffer, nb::args
     return exec(command_buffer.get(), args, kwargs);
 }
 
+BenchmarkResult NativeCallData::benchmark(const BenchmarkDesc& desc, nb::args args, nb::kwargs kwargs)
+{
+    // A regular call first validates the arguments and allocates the return value (stored
+    // in kwargs), which is then reused by all benchmark iterations.
+    exec(nullptr, args, kwargs);
+    return m_device->benchmark([&](CommandBuffer* command_buffer) { exec(command_buffer, args, kwargs); }, desc);
+}
+
 nb::object NativeCallData::exec(CommandBuffer* command_buffer, nb::args args, nb::kwargs kwargs)
 {
     // Unpack args and kwargs.
@@ -244,8 +313,13 @@ nb::object NativeCallData::exec(CommandBuffer* command_buffer, nb::args args, nb
     Shape call_shape = m_runtime->calculate_call_shape(m_call_dimensionality, unpacked_args, unpacked_kwargs);
     m_last_call_shape = call_shape;
 
+    // Backward calls may accumulate gradients of broadcast arguments into partial sums,
+    // which are reduced after the dispatch. Pooled partial sums are only safe if the
+    // reductions are submitted immediately.
+    bool pooled_partials = command_buffer == nullptr;
+
     // Setup context.
-    auto context = make_ref<CallContext>(m_device, call_shape);
+    auto context = make_ref<CallContext>(m_device, call_shape, m_call_mode, pooled_partials);
 
     // Allocate return value if needed.
     if (!command_buffer && m_call_mode == CallMode::prim) {
@@ -258,10 +332,6 @@ nb::object NativeCallData::exec(CommandBuffer* command_buffer, nb::args args, nb
         }
     }
 
-    // Write uniforms to call data.
-    nb::dict call_data;
-    m_runtime->write_calldata_pre_dispatch(context, call_data, unpacked_args, unpacked_kwargs);
-
     // Calculate total threads and strides.
     int total_threads = 1;
     std::vector<int> strides;
@@ -272,6 +342,20 @@ nb::object NativeCallData::exec(CommandBuffer* command_buffer, nb::args args, nb
     }
     std::reverse(strides.begin(), strides.end());
 
+    // Resolve gradient reductions before marshals write their call data.
+    if (m_call_mode == CallMode::bwds) {
+        uint3 thread_group_size = m_kernel->pipeline()->thread_group_size();
+        m_runtime->resolve_gradient_reductions(
+            call_shape,
+            total_threads,
+            thread_group_size.x * thread_group_size.y * thread_group_size.z
+        );
+    }
+
+    // Write uniforms to call data.
+    nb::dict call_data;
+    m_runtime->write_calldata_pre_dispatch(context, call_data, unpacked_args, unpacked_kwargs);
+
     if (!strides.empty()) {
         call_data["_call_stride"] = nb::cast(strides);
         call_data["_call_dim"] = nb::cast(cs);
@@ -289,7 +373,36 @@ nb::object NativeCallData::exec(CommandBuffer* command_buffer, nb::args args, nb
 
     // Dispatch the kernel.
     auto bind_vars = [&](ShaderCursor cursor) { write_shader_cursor(cursor, vars); };
-    m_kernel->dispatch(uint3(total_threads, 1, 1), bind_vars, command_buffer);
+    const auto& gradient_reductions = context->gradient_reductions();
+    if (gradient_reductions.empty()) {
+        m_kernel->dispatch(uint3(total_threads, 1, 1), bind_vars, command_buffer);
+    } else {
+        // Keep the shared reducer (and its compiled kernel) alive for subsequent calls.
+        m_gradient_reducer = context->gradient_reducer();
+
+        // Clear partial sums, dispatch the kernel and reduce the partial sums into
+        // the gradient destinations in a single command buffer.
+        CommandBuffer* temp_command_buffer = nullptr;
+        if (!command_buffer)
+            temp_command_buffer = m_device->_begin_shared_command_buffer();
+        CommandBuffer* cmd = command_buffer ? command_buffer : temp_command_buffer;
+        for (const auto& reduction : gradient_reductions) {
+            m_gradient_reducer->clear(cmd, reduction);
+            cmd->uav_barrier(reduction.partials);
+        }
+        m_kernel->dispatch(uint3(total_threads, 1, 1), bind_vars, cmd);
+        std::vector<ref<Buffer>> partials;
+        for (const auto& reduction : gradient_reductions) {
+            partials.push_back(reduction.partials);
+            std::vector<ref<Buffer>> intermediates = m_gradient_reducer->reduce(cmd, reduction, pooled_partials);
+            partials.insert(partials.end(), intermediates.begin(), intermediates.end());
+        }
+        if (temp_command_buffer)
+            m_device->_end_shared_command_buffer(false);
+        // The commands are submitted, later calls can reuse the pooled buffers.
+        if (pooled_partials)
+            m_gradient_reducer->release_partials(partials);
+    }
 
     // If command_buffer is not null, return early.
     if (command_buffer != nullptr) {
@@ -473,6 +586,61 @@ SGL_PY_EXPORT(utils_slangpy)
 
     nb::sgl_enum<AccessType>(slangpy, "AccessType");
     nb::sgl_enum<CallMode>(slangpy, "CallMode");
+    nb::sgl_enum<GradientReduction>(slangpy, "GradientReduction");
+
+    nb::class_<GradientReductionInfo>(slangpy, "GradientReductionInfo") //
+        .def_ro("reduction", &GradientReductionInfo::reduction, D_NA(GradientReductionInfo, reduction))
+        .def_ro("partial_count", &GradientReductionInfo::partial_count, D_NA(GradientReductionInfo, partial_count));
+
+    slangpy.def(
+        "select_gradient_reduction",
+        &select_gradient_reduction,
+        "requested"_a,
+        "thread_count"_a,
+        "destination_count"_a,
+        "element_count"_a,
+        "thread_group_size"_a,
+        D_NA(slangpy, select_gradient_reduction)
+    );
+
+    nb::class_<GradientReductionDesc>(slangpy, "GradientReductionDesc") //
+        .def(nb::init<>(), D_NA(GradientReductionDesc, GradientReductionDesc))
+        .def_rw("partials", &GradientReductionDesc::partials, D_NA(GradientReductionDesc, partials))
+        .def_rw("destination", &GradientReductionDesc::destination, D_NA(GradientReductionDesc, destination))
+        .def_rw(
+            "destination_offset",
+            &GradientReductionDesc::destination_offset,
+            D_NA(GradientReductionDesc, destination_offset)
+        )
+        .def_rw("element_count", &GradientReductionDesc::element_count, D_NA(GradientReductionDesc, element_count))
+        .def_rw("partial_count", &GradientReductionDesc::partial_count, D_NA(GradientReductionDesc, partial_count));
+
+    nb::class_<GradientReducer, Object>(slangpy, "GradientReducer") //
+        .def(nb::init<ref<Device>>(), "device"_a, D_NA(GradientReducer, GradientReducer))
+        .def_static("get", &GradientReducer::get, "device"_a, D_NA(GradientReducer, get))
+        .def(
+            "allocate_partials",
+            &GradientReducer::allocate_partials,
+            "element_count"_a,
+            "partial_count"_a,
+            "pooled"_a = false,
+            D_NA(GradientReducer, allocate_partials)
+        )
+        .def(
+            "release_partials",
+            &GradientReducer::release_partials,
+            "buffers"_a,
+            D_NA(GradientReducer, release_partials)
+        )
+        .def("clear", &GradientReducer::clear, "command_buffer"_a, "desc"_a, D_NA(GradientReducer, clear))
+        .def(
+            "reduce",
+            &GradientReducer::reduce,
+            "command_buffer"_a,
+            "desc"_a,
+            "pooled"_a = false,
+            D_NA(GradientReducer, reduce)
+        );
 
     slangpy.def(
         "hash_signature",
@@ -568,6 +736,17 @@ SGL_PY_EXPORT(utils_slangpy)
             &NativeBoundVariableRuntime::set_children,
             D_NA(NativeBoundVariableRuntime, children)
         )
+        .def_prop_rw(
+            "gradient_reduction",
+            &NativeBoundVariableRuntime::get_gradient_reduction,
+            &NativeBoundVariableRuntime::set_gradient_reduction,
+            D_NA(NativeBoundVariableRuntime, gradient_reduction)
+        )
+        .def_prop_ro(
+            "resolved_gradient_reduction",
+            &NativeBoundVariableRuntime::get_resolved_gradient_reduction,
+            D_NA(NativeBoundVariableRuntime, resolved_gradient_reduction)
+        )
         .def(
             "populate_call_shape",
             &NativeBoundVariableRuntime::populate_call_shape,
@@ -658,6 +837,14 @@ SGL_PY_EXPORT(utils_slangpy)
             nb::arg("args"),
             nb::arg("kwargs"),
             D_NA(NativeCallData, append_to)
+        )
+        .def(
+            "benchmark",
+            &NativeCallData::benchmark,
+            nb::arg("desc"),
+            nb::arg("args"),
+            nb::arg("kwargs"),
+            D_NA(NativeCallData, benchmark)
         );
 
     nb::class_<Shape>(slangpy, "Shape") //
@@ -753,11 +940,14 @@ SGL_PY_EXPORT(utils_slangpy)
 
     nb::class_<CallContext, Object>(slangpy, "CallContext") //
         .def(
-            nb::init<ref<Device>, const Shape&>(),
+            nb::init<ref<Device>, const Shape&, CallMode, bool>(),
             nb::arg("device"),
             nb::arg("call_shape"),
+            nb::arg("call_mode") = CallMode::prim,
+            nb::arg("pooled_partials") = false,
             D_NA(CallContext, CallContext)
         )
+        .def_prop_ro("call_mode", &CallContext::call_mode, D_NA(CallContext, call_mode))
         .def_prop_ro(
             "device",
             [](const CallContext& self) -> Device* { return self.device(); },
@@ -768,5 +958,20 @@ SGL_PY_EXPORT(utils_slangpy)
             &CallContext::call_shape,
             nb::rv_policy::reference_internal,
             D_NA(CallContext, call_shape)
-        );
+        )
+        .def(
+            "add_gradient_reduction",
+            &CallContext::add_gradient_reduction,
+            "destination"_a,
+            "destination_offset"_a,
+            "element_count"_a,
+            "partial_count"_a,
+            D_NA(CallContext, add_gradient_reduction)
+        )
+        .def_prop_ro(
+            "gradient_reductions",
+            &CallContext::gradient_reductions,
+            D_NA(CallContext, gradient_reductions)
+        )
+        .def_prop_ro("gradient_reducer", &CallContext::gradient_reducer, D_NA(CallContext, gradient_reducer));
 }
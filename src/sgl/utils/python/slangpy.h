@@ -11,6 +11,7 @@
 #include "sgl/core/fwd.h"
 #include "sgl/core/object.h"
 #include "sgl/device/fwd.h"
+#include "sgl/device/benchmark.h"
 #include "sgl/utils/slangpy.h"
 
 namespace sgl::slangpy {
@@ -207,6 +208,16 @@ public:
     /// Set the uniform variable name.
     void set_variable_name(std::string_view variable_name) { m_variable_name = variable_name; }
 
+    /// Get the requested gradient reduction (backward calls only).
+    GradientReduction get_gradient_reduction() const { return m_gradient_reduction; }
+
+    /// Set the requested gradient reduction (backward calls only).
+    void set_gradient_reduction(GradientReduction gradient_reduction) { m_gradient_reduction = gradient_reduction; }
+
+    /// Get the gradient reduction resolved for the current call. Marshals read this when
+    /// writing call data and register partial sums with \c CallContext::add_gradient_reduction.
+    const GradientReductionInfo& get_resolved_gradient_reduction() const { return m_resolved_gradient_reduction; }
+
     /// Get children (for structs).
     std::optional<std::map<std::string, ref<NativeBoundVariableRuntime>>> get_children() const { return m_children; }
 
@@ -219,6 +230,9 @@ public:
     /// Recursively populate the overall kernel call shape.
     void populate_call_shape(std::vector<int>& call_shape, nb::object value);
 
+    /// Recursively resolve the gradient reduction of leaf nodes with derivative write access.
+    void resolve_gradient_reduction(const Shape& call_shape, size_t thread_count, uint32_t thread_group_size);
+
     /// Write call data to be passed to a compute kernel by calling create_calldata on the marshal.
     void write_call_data_pre_dispatch(CallContext* context, nb::dict call_data, nb::object value);
 
@@ -235,6 +249,8 @@ private:
     Shape m_shape;
     std::string m_variable_name;
     std::optional<std::map<std::string, ref<NativeBoundVariableRuntime>>> m_children;
+    GradientReduction m_gradient_reduction{GradientReduction::automatic};
+    GradientReductionInfo m_resolved_gradient_reduction;
 };
 
 /// Binding information for a call to a compute kernel. Includes a set of positional
@@ -268,6 +284,9 @@ public:
     /// Calculate the overall call shape by combining the shapes of all arguments.
     Shape calculate_call_shape(int call_dimensionality, nb::list args, nb::dict kwargs);
 
+    /// Resolve the gradient reductions of all arguments for a backward call.
+    void resolve_gradient_reductions(const Shape& call_shape, size_t thread_count, uint32_t thread_group_size);
+
     /// Write call data to be passed to a compute kernel by calling create_calldata on the argument marshals.
     void write_calldata_pre_dispatch(CallContext* context, nb::dict call_data, nb::list args, nb::dict kwargs);
 
@@ -341,6 +360,9 @@ public:
     /// Append the compute kernel to a command buffer with the provided arguments and keyword arguments.
     nb::object append_to(ref<CommandBuffer> command_buffer, nb::args args, nb::kwargs kwargs);
 
+    /// Benchmark the compute kernel with the provided arguments and keyword arguments.
+    BenchmarkResult benchmark(const BenchmarkDesc& desc, nb::args args, nb::kwargs kwargs);
+
 private:
     ref<Device> m_device;
     ref<ComputeKernel> m_kernel;
@@ -351,6 +373,7 @@ private:
     std::vector<std::function<void(nb::dict)>> m_before_dispatch_hooks;
     std::vector<std::function<void(nb::dict)>> m_after_dispatch_hooks;
     Shape m_last_call_shape;
+    ref<GradientReducer> m_gradient_reducer;
 
     nb::object exec(CommandBuffer* command_buffer, nb::args args, nb::kwargs kwargs);
 
@@ -6,6 +6,16 @@
 #include "sgl/core/bitmap.h"
 #include "sgl/device/resource.h"
 
+namespace sgl::tev {
+SGL_DICT_TO_DESC_BEGIN(SessionDesc)
+SGL_DICT_TO_DESC_FIELD(name, std::string)
+SGL_DICT_TO_DESC_FIELD(host, std::string)
+SGL_DICT_TO_DESC_FIELD(port, uint16_t)
+SGL_DICT_TO_DESC_FIELD(max_retries, uint32_t)
+SGL_DICT_TO_DESC_FIELD(tile_size, uint32_t)
+SGL_DICT_TO_DESC_END()
+} // namespace sgl::tev
+
 SGL_PY_EXPORT(utils_tev)
 {
     using namespace sgl;
@@ -52,4 +62,65 @@ SGL_PY_EXPORT(utils_tev)
         "max_retries"_a = 3,
         D(tev, show_async, 2)
     );
+
+    nb::class_<tev::SessionDesc>(tev, "SessionDesc", D_NA(tev, SessionDesc))
+        .def(nb::init<>())
+        .def(
+            "__init__",
+            [](tev::SessionDesc* self, nb::dict dict) { new (self) tev::SessionDesc(tev::dict_to_SessionDesc(dict)); }
+        )
+        .def_rw("name", &tev::SessionDesc::name, D_NA(tev, SessionDesc, name))
+        .def_rw("host", &tev::SessionDesc::host, D_NA(tev, SessionDesc, host))
+        .def_rw("port", &tev::SessionDesc::port, D_NA(tev, SessionDesc, port))
+        .def_rw("max_retries", &tev::SessionDesc::max_retries, D_NA(tev, SessionDesc, max_retries))
+        .def_rw("tile_size", &tev::SessionDesc::tile_size, D_NA(tev, SessionDesc, tile_size));
+    nb::implicitly_convertible<nb::dict, tev::SessionDesc>();
+
+    nb::class_<tev::SessionStats>(tev, "SessionStats", D_NA(tev, SessionStats))
+        .def_ro("frame_count", &tev::SessionStats::frame_count, D_NA(tev, SessionStats, frame_count))
+        .def_ro(
+            "dropped_frame_count",
+            &tev::SessionStats::dropped_frame_count,
+            D_NA(tev, SessionStats, dropped_frame_count)
+        )
+        .def_ro(
+            "failed_frame_count",
+            &tev::SessionStats::failed_frame_count,
+            D_NA(tev, SessionStats, failed_frame_count)
+        )
+        .def_ro("sent_tile_count", &tev::SessionStats::sent_tile_count, D_NA(tev, SessionStats, sent_tile_count))
+        .def_ro(
+            "skipped_tile_count",
+            &tev::SessionStats::skipped_tile_count,
+            D_NA(tev, SessionStats, skipped_tile_count)
+        )
+        .def_ro("sent_byte_count", &tev::SessionStats::sent_byte_count, D_NA(tev, SessionStats, sent_byte_count));
+
+    nb::class_<tev::Session, Object>(tev, "Session", D_NA(tev, Session))
+        .def(nb::init<tev::SessionDesc>(), "desc"_a = tev::SessionDesc{}, D_NA(tev, Session, Session))
+        .def_prop_ro("desc", &tev::Session::desc, D_NA(tev, Session, desc))
+        .def(
+            "update",
+            nb::overload_cast<const Bitmap*>(&tev::Session::update),
+            "bitmap"_a,
+            D_NA(tev, Session, update)
+        )
+        .def(
+            "update",
+            nb::overload_cast<const Texture*, uint32_t, uint32_t>(&tev::Session::update),
+            "texture"_a,
+            "mip_level"_a = 0,
+            "array_slice"_a = 0,
+            D_NA(tev, Session, update, 2)
+        )
+        .def(
+            "flush",
+            [](tev::Session* self)
+            {
+                nb::gil_scoped_release guard;
+                return self->flush();
+            },
+            D_NA(tev, Session, flush)
+        )
+        .def_prop_ro("stats", &tev::Session::stats, D_NA(tev, Session, stats));
 }
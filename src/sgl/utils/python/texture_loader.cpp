@@ -14,6 +14,9 @@ SGL_DICT_TO_DESC_BEGIN(TextureLoaderOptions)
 SGL_DICT_TO_DESC_FIELD(load_as_normalized, bool)
 SGL_DICT_TO_DESC_FIELD(load_as_srgb, bool)
 SGL_DICT_TO_DESC_FIELD(extend_alpha, bool)
+SGL_DICT_TO_DESC_FIELD(decode_srgb, bool)
+SGL_DICT_TO_DESC_FIELD(load_uint16_as_float16, bool)
+SGL_DICT_TO_DESC_FIELD(gpu_conversion, bool)
 SGL_DICT_TO_DESC_FIELD(allocate_mips, bool)
 SGL_DICT_TO_DESC_FIELD(generate_mips, bool)
 SGL_DICT_TO_DESC_FIELD(usage, ResourceUsage)
@@ -40,6 +43,13 @@ SGL_PY_EXPORT(utils_texture_loader)
         )
         .def_rw("load_as_srgb", &TextureLoader::Options::load_as_srgb, D(TextureLoader, Options, load_as_srgb))
         .def_rw("extend_alpha", &TextureLoader::Options::extend_alpha, D(TextureLoader, Options, extend_alpha))
+        .def_rw("decode_srgb", &TextureLoader::Options::decode_srgb, D_NA(TextureLoader, Options, decode_srgb))
+        .def_rw(
+            "load_uint16_as_float16",
+            &TextureLoader::Options::load_uint16_as_float16,
+            D_NA(TextureLoader, Options, load_uint16_as_float16)
+        )
+        .def_rw("gpu_conversion", &TextureLoader::Options::gpu_conversion, D_NA(TextureLoader, Options, gpu_conversion))
         .def_rw("allocate_mips", &TextureLoader::Options::allocate_mips, D(TextureLoader, Options, allocate_mips))
         .def_rw("generate_mips", &TextureLoader::Options::generate_mips, D(TextureLoader, Options, generate_mips))
         .def_rw("usage", &TextureLoader::Options::usage);
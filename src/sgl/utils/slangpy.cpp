@@ -2,7 +2,225 @@
 
 #include "slangpy.h"
 #include "sgl/device/device.h"
+#include "sgl/device/shader.h"
+#include "sgl/device/kernel.h"
+#include "sgl/device/command.h"
+#include "sgl/core/maths.h"
+#include "sgl/core/type_utils.h"
+
+#include <bit>
+#include <map>
+#include <mutex>
 
 namespace sgl::slangpy {
 
+static std::mutex s_gradient_reducers_mutex;
+static std::map<const Device*, GradientReducer*> s_gradient_reducers;
+
+GradientReductionInfo select_gradient_reduction(
+    GradientReduction requested,
+    size_t thread_count,
+    size_t destination_count,
+    size_t element_count,
+    uint32_t thread_group_size
+)
+{
+    if (requested == GradientReduction::atomic || destination_count == 0 || element_count == 0)
+        return {};
+
+    size_t broadcast_factor = thread_count / destination_count;
+    size_t max_partials = GRADIENT_REDUCTION_MAX_PARTIALS_SIZE / (element_count * sizeof(float));
+
+    GradientReduction reduction = requested;
+    if (reduction == GradientReduction::automatic) {
+        // Low contention: atomics are cheaper than clearing and reducing partial sums.
+        if (broadcast_factor < GRADIENT_REDUCTION_MIN_BROADCAST_FACTOR || max_partials < 2)
+            return {};
+        reduction = destination_count == 1 ? GradientReduction::workgroup : GradientReduction::privatized;
+    }
+
+    // Wave sums require all lanes to accumulate into the same destination value.
+    if (reduction == GradientReduction::workgroup && destination_count != 1)
+        reduction = GradientReduction::privatized;
+
+    if (max_partials < 1)
+        return {};
+
+    size_t partial_count;
+    if (reduction == GradientReduction::workgroup) {
+        partial_count = div_round_up<size_t>(thread_count, std::max(thread_group_size, 1u));
+    } else {
+        partial_count = std::bit_ceil(std::max<size_t>(broadcast_factor / GRADIENT_REDUCTION_MIN_BROADCAST_FACTOR, 2));
+        partial_count = std::min<size_t>(partial_count, GRADIENT_REDUCTION_MAX_PRIVATIZED_PARTIALS);
+    }
+    partial_count = std::clamp<size_t>(partial_count, 1, max_partials);
+
+    return {.reduction = reduction, .partial_count = narrow_cast<uint32_t>(partial_count)};
+}
+
+GradientReducer::GradientReducer(ref<Device> device)
+    : m_device(std::move(device))
+{
+}
+
+GradientReducer::~GradientReducer()
+{
+    std::lock_guard lock(s_gradient_reducers_mutex);
+    auto it = s_gradient_reducers.find(m_device.get());
+    if (it != s_gradient_reducers.end() && it->second == this)
+        s_gradient_reducers.erase(it);
+}
+
+ref<GradientReducer> GradientReducer::get(Device* device)
+{
+    SGL_CHECK_NOT_NULL(device);
+    std::lock_guard lock(s_gradient_reducers_mutex);
+    // Entries are erased in the destructor under the same lock, the reducer may be dying though.
+    auto it = s_gradient_reducers.find(device);
+    if (it != s_gradient_reducers.end() && it->second->try_inc_ref()) {
+        ref<GradientReducer> reducer(it->second);
+        it->second->dec_ref();
+        return reducer;
+    }
+    ref<GradientReducer> reducer = make_ref<GradientReducer>(ref(device));
+    s_gradient_reducers[device] = reducer.get();
+    return reducer;
+}
+
+ComputeKernel* GradientReducer::reduce_kernel()
+{
+    std::lock_guard lock(m_mutex);
+    if (!m_reduce_kernel) {
+        std::string source = m_device->slang_session()->load_source("sgl/utils/slangpy_reduce.slang");
+        ref<SlangModule> module = m_device->slang_session()->load_module_from_source("slangpy_reduce", source);
+        module->break_strong_reference_to_session();
+        ref<ShaderProgram> program
+            = m_device->slang_session()->link_program({module}, {module->entry_point("reduce_partials")});
+        m_reduce_kernel = m_device->create_compute_kernel({.program = program});
+    }
+    return m_reduce_kernel;
+}
+
+ref<Buffer> GradientReducer::allocate_partials(size_t element_count, uint32_t partial_count, bool pooled)
+{
+    size_t size = std::max<size_t>(element_count * partial_count * sizeof(float), sizeof(float));
+
+    if (pooled) {
+        // Take the smallest released buffer that fits.
+        std::lock_guard lock(m_mutex);
+        auto best = m_pool.end();
+        for (auto it = m_pool.begin(); it != m_pool.end(); ++it)
+            if ((*it)->size() >= size && (best == m_pool.end() || (*it)->size() < (*best)->size()))
+                best = it;
+        if (best != m_pool.end()) {
+            ref<Buffer> buffer = std::move(*best);
+            m_pool.erase(best);
+            return buffer;
+        }
+    }
+
+    return m_device->create_buffer({
+        .size = size,
+        .usage = ResourceUsage::unordered_access,
+        .debug_name = "slangpy_gradient_partials",
+    });
+}
+
+void GradientReducer::release_partials(std::span<ref<Buffer>> buffers)
+{
+    std::lock_guard lock(m_mutex);
+    m_pool.insert(m_pool.end(), buffers.begin(), buffers.end());
+}
+
+void GradientReducer::clear(CommandBuffer* command_buffer, const GradientReductionDesc& desc)
+{
+    SGL_CHECK_NOT_NULL(command_buffer);
+    SGL_CHECK_NOT_NULL(desc.partials);
+
+    uint64_t size = uint64_t(desc.element_count) * desc.partial_count * sizeof(float);
+    command_buffer->clear_resource_view(desc.partials->get_uav({.offset = 0, .size = size}), uint4(0));
+}
+
+std::vector<ref<Buffer>>
+GradientReducer::reduce(CommandBuffer* command_buffer, const GradientReductionDesc& desc, bool pooled)
+{
+    SGL_CHECK_NOT_NULL(command_buffer);
+    SGL_CHECK_NOT_NULL(desc.partials);
+    SGL_CHECK_NOT_NULL(desc.destination);
+    SGL_CHECK(desc.destination_offset % sizeof(float) == 0, "Destination offset must be 4-byte aligned.");
+
+    ComputeKernel* kernel = reduce_kernel();
+    std::vector<ref<Buffer>> intermediates;
+    ref<Buffer> src = desc.partials;
+    uint32_t partial_count = desc.partial_count;
+
+    command_buffer->uav_barrier(src);
+
+    // Each pass reduces groups of GRADIENT_REDUCTION_FAN_IN partial sums until a single
+    // partial sum is left, which is added to the destination.
+    while (true) {
+        uint32_t dst_partial_count = div_round_up(partial_count, GRADIENT_REDUCTION_FAN_IN);
+        bool last = dst_partial_count == 1;
+        ref<Buffer> dst = last ? desc.destination : allocate_partials(desc.element_count, dst_partial_count, pooled);
+        if (!last)
+            intermediates.push_back(dst);
+
+        kernel->dispatch(
+            uint3(desc.element_count * dst_partial_count, 1, 1),
+            [&](ShaderCursor cursor)
+            {
+                cursor["src"] = src;
+                cursor["dst"] = dst;
+                cursor["dst_offset"] = last ? narrow_cast<uint32_t>(desc.destination_offset) : 0u;
+                cursor["element_count"] = desc.element_count;
+                cursor["partial_count"] = partial_count;
+                cursor["fan_in"] = GRADIENT_REDUCTION_FAN_IN;
+                cursor["dst_partial_count"] = dst_partial_count;
+                cursor["accumulate"] = last ? 1u : 0u;
+            },
+            command_buffer
+        );
+        command_buffer->uav_barrier(dst);
+
+        if (last)
+            break;
+        src = dst;
+        partial_count = dst_partial_count;
+    }
+
+    return intermediates;
+}
+
+ref<Buffer> CallContext::add_gradient_reduction(
+    ref<Buffer> destination,
+    size_t destination_offset,
+    uint32_t element_count,
+    uint32_t partial_count
+)
+{
+    SGL_CHECK(m_call_mode == CallMode::bwds, "Gradient reductions are only supported for backward calls.");
+    SGL_CHECK_NOT_NULL(destination);
+    SGL_CHECK(partial_count > 0, "Partial count must be at least 1.");
+
+    // Most backward calls use atomics only, so the reducer is acquired on the first reduction.
+    if (!m_gradient_reducer)
+        m_gradient_reducer = GradientReducer::get(m_device);
+
+    // Keep the partial sums within the memory budget, even if the element count
+    // of the destination is larger than estimated from the argument shape.
+    size_t max_partials = GRADIENT_REDUCTION_MAX_PARTIALS_SIZE / (std::max(element_count, 1u) * sizeof(float));
+    max_partials = std::max<size_t>(max_partials, 1);
+    partial_count = narrow_cast<uint32_t>(std::clamp<size_t>(partial_count, 1, max_partials));
+
+    ref<Buffer> partials = m_gradient_reducer->allocate_partials(element_count, partial_count, m_pooled_partials);
+    m_gradient_reductions.push_back({
+        .partials = partials,
+        .destination = std::move(destination),
+        .destination_offset = destination_offset,
+        .element_count = element_count,
+        .partial_count = partial_count,
+    });
+    return partials;
+}
+
 } // namespace sgl::slangpy
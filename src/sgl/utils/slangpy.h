@@ -7,9 +7,13 @@
 #include "sgl/core/object.h"
 #include "sgl/core/enum.h"
 #include "sgl/device/fwd.h"
+#include "sgl/device/resource.h"
 
 #include <vector>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <span>
 
 namespace sgl::slangpy {
 
@@ -42,6 +46,134 @@ SGL_ENUM_INFO(
 );
 SGL_ENUM_REGISTER(CallMode);
 
+/// Strategy used to accumulate gradients of broadcast arguments in backward calls.
+/// The native call runtime resolves the strategy of each argument per call. Argument marshals
+/// apply it by registering partial sums with \c CallContext::add_gradient_reduction, marshals
+/// that do not register partial sums keep using global atomics.
+enum class GradientReduction {
+    /// Select a strategy based on the broadcast factor of the argument.
+    automatic,
+    /// Every thread adds its contribution to the destination with a global atomic.
+    atomic,
+    /// Contributions are summed over the wave and added to per thread group partial sums.
+    /// Only used for arguments broadcast to every thread of the call.
+    workgroup,
+    /// Threads add their contributions to one of several partial sums, selected by thread index.
+    privatized,
+};
+SGL_ENUM_INFO(
+    GradientReduction,
+    {
+        {GradientReduction::automatic, "automatic"},
+        {GradientReduction::atomic, "atomic"},
+        {GradientReduction::workgroup, "workgroup"},
+        {GradientReduction::privatized, "privatized"},
+    }
+);
+SGL_ENUM_REGISTER(GradientReduction);
+
+/// Minimum number of threads per destination value for which \c GradientReduction::automatic
+/// selects a hierarchical reduction over global atomics.
+static constexpr size_t GRADIENT_REDUCTION_MIN_BROADCAST_FACTOR = 64;
+/// Maximum number of privatized partial sums per destination value.
+static constexpr uint32_t GRADIENT_REDUCTION_MAX_PRIVATIZED_PARTIALS = 256;
+/// Maximum size of the partial sums buffer of a single argument in bytes.
+static constexpr size_t GRADIENT_REDUCTION_MAX_PARTIALS_SIZE = 64 * 1024 * 1024;
+/// Number of partial sums combined by each thread in one reduction pass.
+static constexpr uint32_t GRADIENT_REDUCTION_FAN_IN = 64;
+
+/// Resolved gradient reduction of an argument.
+struct GradientReductionInfo {
+    /// Reduction strategy (never \c GradientReduction::automatic).
+    GradientReduction reduction{GradientReduction::atomic};
+    /// Number of partial sums (zero for \c GradientReduction::atomic).
+    uint32_t partial_count{0};
+};
+
+/**
+ * \brief Select the gradient reduction of an argument.
+ *
+ * \param requested Requested strategy.
+ * \param thread_count Number of threads of the call.
+ * \param destination_count Number of distinct destination values the threads write to
+ *                          (product of the argument dimensions mapped to call dimensions).
+ * \param element_count Number of float elements of the destination.
+ * \param thread_group_size Number of threads per thread group of the kernel.
+ * \return Resolved strategy and number of partial sums.
+ */
+SGL_API GradientReductionInfo select_gradient_reduction(
+    GradientReduction requested,
+    size_t thread_count,
+    size_t destination_count,
+    size_t element_count,
+    uint32_t thread_group_size
+);
+
+/// Pending reduction of partial sums into a gradient destination.
+struct GradientReductionDesc {
+    /// Buffer holding \c partial_count * \c element_count float partial sums.
+    ref<Buffer> partials;
+    /// Destination buffer the reduced gradients are added to.
+    ref<Buffer> destination;
+    /// Offset into the destination buffer in bytes.
+    size_t destination_offset{0};
+    /// Number of float elements to reduce.
+    uint32_t element_count{0};
+    /// Number of partial sums per element.
+    uint32_t partial_count{0};
+};
+
+/**
+ * \brief Reduces gradient partial sums of backward calls.
+ *
+ * Partial sums are reduced with a tree of passes, each combining up to
+ * \c GRADIENT_REDUCTION_FAN_IN partial sums per element. The last pass adds
+ * the result to the destination, so gradients accumulate over calls as with
+ * global atomics.
+ */
+class SGL_API GradientReducer : public Object {
+    SGL_OBJECT(GradientReducer)
+public:
+    /// Create a reducer. The reduce kernel is compiled on first use.
+    GradientReducer(ref<Device> device);
+    ~GradientReducer();
+
+    /// Get the reducer shared by all calls on a device.
+    /// The reducer is kept alive by its users and created again once they are all gone.
+    static ref<GradientReducer> get(Device* device);
+
+    /**
+     * \brief Allocate a buffer for partial sums.
+     *
+     * Pooled buffers are taken from the pool of released buffers and are owned by the
+     * caller until they are handed back with \c release_partials.
+     */
+    ref<Buffer> allocate_partials(size_t element_count, uint32_t partial_count, bool pooled);
+
+    /// Return pooled buffers for reuse. Only valid once the commands using them are submitted.
+    void release_partials(std::span<ref<Buffer>> buffers);
+
+    /// Record commands to zero the partial sums of a reduction.
+    void clear(CommandBuffer* command_buffer, const GradientReductionDesc& desc);
+
+    /**
+     * \brief Record commands to reduce the partial sums of a reduction into its destination.
+     *
+     * \return Intermediate partial sum buffers. If \c pooled is true, they are allocated from the
+     *         pool and must be handed back with \c release_partials after submitting the commands.
+     */
+    std::vector<ref<Buffer>> reduce(CommandBuffer* command_buffer, const GradientReductionDesc& desc, bool pooled);
+
+private:
+    ComputeKernel* reduce_kernel();
+
+    ref<Device> m_device;
+    /// Guards the kernel and the pool, the reducer is shared by all calls on a device.
+    std::mutex m_mutex;
+    ref<ComputeKernel> m_reduce_kernel;
+    std::vector<ref<Buffer>> m_pool;
+};
+
 
 class SGL_API Shape {
 public:
@@ -136,18 +268,56 @@ private:
 
 class SGL_API CallContext : Object {
 public:
-    CallContext(ref<Device> device, const Shape& call_shape)
+    CallContext(
+        ref<Device> device,
+        const Shape& call_shape,
+        CallMode call_mode = CallMode::prim,
+        bool pooled_partials = false
+    )
         : m_device(std::move(device))
         , m_call_shape(call_shape)
+        , m_call_mode(call_mode)
+        , m_pooled_partials(pooled_partials)
     {
     }
 
     Device* device() const { return m_device.get(); }
     const Shape& call_shape() const { return m_call_shape; }
+    CallMode call_mode() const { return m_call_mode; }
+
+    /**
+     * \brief Register a gradient reduction for this call.
+     *
+     * Called by marshals when writing call data for an argument that uses a hierarchical
+     * gradient reduction. The partial sums are cleared before the kernel is dispatched and
+     * reduced into the destination after it.
+     *
+     * \param destination Destination buffer of the gradients.
+     * \param destination_offset Offset into the destination buffer in bytes.
+     * \param element_count Number of float elements of the destination.
+     * \param partial_count Number of partial sums per element.
+     * \return Buffer to accumulate partial sums into.
+     */
+    ref<Buffer> add_gradient_reduction(
+        ref<Buffer> destination,
+        size_t destination_offset,
+        uint32_t element_count,
+        uint32_t partial_count
+    );
+
+    /// Gradient reductions registered for this call.
+    const std::vector<GradientReductionDesc>& gradient_reductions() const { return m_gradient_reductions; }
+
+    /// Reducer used for the gradient reductions (nullptr if no reduction was registered).
+    const ref<GradientReducer>& gradient_reducer() const { return m_gradient_reducer; }
 
 private:
     ref<Device> m_device;
     Shape m_call_shape;
+    CallMode m_call_mode;
+    ref<GradientReducer> m_gradient_reducer;
+    bool m_pooled_partials;
+    std::vector<GradientReductionDesc> m_gradient_reductions;
 };
 
 } // namespace sgl::slangpy
@@ -0,0 +1,155 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import pytest
+import sgl
+from sgl import EnvironmentMapBaker, Bitmap, Format
+import sys
+import numpy as np
+from pathlib import Path
+
+sys.path.append(str(Path(__file__).parent.parent.parent / "device/tests"))
+import sglhelpers as helpers
+
+
+def smooth_environment(width: int, height: int):
+    """Equirectangular map with a bright sky and a colored horizon band."""
+    theta = (np.arange(height, dtype=np.float32) + 0.5) / height * np.pi
+    phi = (np.arange(width, dtype=np.float32) + 0.5) / width * 2 * np.pi
+    y = np.cos(theta)[:, None]
+    img = np.zeros((height, width, 3), dtype=np.float32)
+    img[..., 0] = 1.0 + 0.5 * y + 0.25 * np.sin(phi)[None, :]
+    img[..., 1] = 0.5 + 0.5 * np.maximum(y, 0)
+    img[..., 2] = 0.25 + 0.2 * np.cos(phi)[None, :]
+    return Bitmap(img)
+
+
+def read_faces(texture: sgl.Texture, mip_level: int = 0):
+    return [
+        texture.to_numpy(mip_level=mip_level, array_slice=face)[..., :3]
+        for face in range(6)
+    ]
+
+
+def to_bitmaps(faces: list[np.ndarray]):
+    return [Bitmap(np.ascontiguousarray(face, dtype=np.float32)) for face in faces]
+
+
+def test_cube_direction():
+    assert EnvironmentMapBaker.cube_direction(0, [0, 0]) == sgl.float3(1, 0, 0)
+    assert EnvironmentMapBaker.cube_direction(1, [0, 0]) == sgl.float3(-1, 0, 0)
+    assert EnvironmentMapBaker.cube_direction(2, [0, 0]) == sgl.float3(0, 1, 0)
+    assert EnvironmentMapBaker.cube_direction(3, [0, 0]) == sgl.float3(0, -1, 0)
+    assert EnvironmentMapBaker.cube_direction(4, [0, 0]) == sgl.float3(0, 0, 1)
+    assert EnvironmentMapBaker.cube_direction(5, [0, 0]) == sgl.float3(0, 0, -1)
+
+
+def test_cpu_constant_environment():
+    faces = EnvironmentMapBaker.equirect_to_cube_cpu(
+        Bitmap(np.full((16, 32, 3), 2.0, dtype=np.float32))
+    )
+    assert len(faces) == 6
+    for face in faces:
+        assert face.width == 8 and face.height == 8
+        assert np.allclose(np.array(face, copy=False), 2.0)
+
+    # Irradiance of a constant environment is pi * radiance in every direction.
+    sh = EnvironmentMapBaker.compute_irradiance_sh_cpu(faces)
+    for normal in [[0, 1, 0], [1, 0, 0], [0, 0, -1]]:
+        assert np.allclose(sh.evaluate(sgl.float3(normal)), 2.0 * np.pi, rtol=1e-3)
+
+    # Prefiltering preserves a constant environment.
+    for roughness in [0.0, 0.5, 1.0]:
+        filtered = EnvironmentMapBaker.prefilter_specular_cpu(faces, roughness, 4)
+        for face in filtered:
+            assert face.width == 4
+            assert np.allclose(np.array(face, copy=False), 2.0, rtol=1e-4)
+
+
+def test_cpu_sky_irradiance():
+    img = np.zeros((32, 64, 3), dtype=np.float32)
+    img[:16] = 1.0
+    faces = EnvironmentMapBaker.equirect_to_cube_cpu(Bitmap(img))
+    sh = EnvironmentMapBaker.compute_irradiance_sh_cpu(faces)
+    assert np.allclose(sh.evaluate(sgl.float3(0, 1, 0)), np.pi, atol=0.05)
+    assert np.allclose(sh.evaluate(sgl.float3(1, 0, 0)), np.pi / 2, atol=0.05)
+    assert np.allclose(sh.evaluate(sgl.float3(0, -1, 0)), 0.0, atol=0.05)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_equirect_to_cube(device_type: sgl.DeviceType):
+    device = helpers.get_device(type=device_type)
+    baker = EnvironmentMapBaker(device)
+
+    equirect = smooth_environment(128, 64)
+    cube = baker.equirect_to_cube(equirect, format=Format.rgba32_float)
+    assert cube.type == sgl.ResourceType.texture_cube
+    assert cube.width == 32 and cube.height == 32
+    assert cube.mip_count == 6
+
+    expected = EnvironmentMapBaker.equirect_to_cube_cpu(equirect)
+    faces = read_faces(cube)
+    for face in range(6):
+        assert np.allclose(faces[face], np.array(expected[face]), atol=1e-4)
+
+    # Mip levels are 2x2 box filtered.
+    mip1 = read_faces(cube, 1)
+    for face in range(6):
+        box = faces[face].reshape(16, 2, 16, 2, 3).mean(axis=(1, 3))
+        assert np.allclose(mip1[face], box, atol=1e-4)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_irradiance_sh(device_type: sgl.DeviceType):
+    device = helpers.get_device(type=device_type)
+    baker = EnvironmentMapBaker(device)
+
+    cube = baker.equirect_to_cube(smooth_environment(512, 256), face_size=128)
+    sh = baker.compute_irradiance_sh(cube)
+
+    # The GPU projects from the first mip level that is at most SH_MAX_FACE_SIZE.
+    faces = [f.astype(np.float32) for f in read_faces(cube, 1)]
+    assert faces[0].shape[0] == EnvironmentMapBaker.SH_MAX_FACE_SIZE
+    expected = EnvironmentMapBaker.compute_irradiance_sh_cpu(to_bitmaps(faces))
+    for k in range(9):
+        assert np.allclose(sh.coefficients[k], expected.coefficients[k], atol=1e-3)
+
+    # Batched variant writes 9 float4 per probe.
+    dst = device.create_buffer(
+        element_count=18, struct_size=16, usage=sgl.ResourceUsage.unordered_access
+    )
+    command_buffer = device.create_command_buffer()
+    baker.compute_irradiance_sh(command_buffer, cube, dst, 0)
+    baker.compute_irradiance_sh(command_buffer, cube, dst, 1)
+    command_buffer.submit()
+    data = dst.to_numpy().view(np.float32).reshape(2, 9, 4)
+    for k in range(9):
+        assert np.allclose(data[0, k, :3], sh.coefficients[k], atol=1e-5)
+        assert np.allclose(data[1, k, :3], sh.coefficients[k], atol=1e-5)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_prefilter_specular(device_type: sgl.DeviceType):
+    device = helpers.get_device(type=device_type)
+    baker = EnvironmentMapBaker(device)
+
+    cube = baker.equirect_to_cube(
+        smooth_environment(128, 64), format=Format.rgba32_float
+    )
+    prefiltered = baker.prefilter_specular(cube, face_size=16, sample_count=256)
+    assert prefiltered.type == sgl.ResourceType.texture_cube
+    assert prefiltered.format == Format.rgba32_float
+    assert prefiltered.width == 16
+    assert prefiltered.mip_count == 5
+
+    source = to_bitmaps(read_faces(cube))
+    for mip in range(prefiltered.mip_count - 1):
+        roughness = mip / (prefiltered.mip_count - 1)
+        size = 16 >> mip
+        expected = EnvironmentMapBaker.prefilter_specular_cpu(source, roughness, size)
+        faces = read_faces(prefiltered, mip)
+        for face in range(6):
+            assert np.allclose(faces[face], np.array(expected[face]), atol=0.05)
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
@@ -0,0 +1,199 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import pytest
+from concurrent.futures import ThreadPoolExecutor
+import sgl
+import numpy as np
+import sys
+from pathlib import Path
+
+sys.path.append(str(Path(__file__).parent.parent.parent / "device/tests"))
+import sglhelpers as helpers
+
+GradientReduction = sgl.slangpy.GradientReduction
+
+
+def test_select_gradient_reduction():
+    select = sgl.slangpy.select_gradient_reduction
+
+    # Low broadcast factor uses atomics.
+    info = select(GradientReduction.automatic, 1024, 1024, 1024, 32)
+    assert info.reduction == GradientReduction.atomic
+    assert info.partial_count == 0
+
+    # Fully broadcast destination uses wave/group reduction.
+    info = select(GradientReduction.automatic, 1 << 20, 1, 16, 32)
+    assert info.reduction == GradientReduction.workgroup
+    assert info.partial_count == (1 << 20) // 32
+
+    # Partially broadcast destination uses privatized partial sums.
+    info = select(GradientReduction.automatic, 1 << 20, 256, 256, 32)
+    assert info.reduction == GradientReduction.privatized
+    assert info.partial_count == 64
+
+    # Explicit requests are honored.
+    # Workgroup falls back to privatized if not fully broadcast.
+    info = select(GradientReduction.atomic, 1 << 20, 1, 16, 32)
+    assert info.reduction == GradientReduction.atomic
+    info = select(GradientReduction.workgroup, 1 << 20, 256, 256, 32)
+    assert info.reduction == GradientReduction.privatized
+
+    # Partial sums are limited by the memory budget.
+    info = select(GradientReduction.privatized, 1 << 30, 1 << 20, 1 << 24, 32)
+    assert info.partial_count == 1
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+@pytest.mark.parametrize("partial_count", [1, 37, 300, 5000])
+def test_gradient_reducer(device_type: sgl.DeviceType, partial_count: int):
+    device = helpers.get_device(type=device_type)
+    reducer = sgl.slangpy.GradientReducer(device)
+
+    element_count = 3
+    partials = np.random.rand(partial_count, element_count).astype(np.float32)
+    initial = np.random.rand(8).astype(np.float32)
+
+    desc = sgl.slangpy.GradientReductionDesc()
+    desc.partials = reducer.allocate_partials(element_count, partial_count)
+    desc.partials.from_numpy(partials)
+    desc.destination = device.create_buffer(
+        size=initial.nbytes,
+        usage=sgl.ResourceUsage.shader_resource | sgl.ResourceUsage.unordered_access,
+        data=initial,
+    )
+    desc.destination_offset = 4 * 4
+    desc.element_count = element_count
+    desc.partial_count = partial_count
+
+    command_buffer = device.create_command_buffer()
+    reducer.reduce(command_buffer, desc)
+    command_buffer.submit()
+
+    expected = initial.copy()
+    expected[4 : 4 + element_count] += partials.sum(axis=0)
+    result = desc.destination.to_numpy().view(np.float32)
+    assert np.allclose(result, expected, rtol=1e-4)
+
+    # Cleared partial sums reduce to zero, leaving the destination unchanged.
+    command_buffer = device.create_command_buffer()
+    reducer.clear(command_buffer, desc)
+    reducer.reduce(command_buffer, desc)
+    command_buffer.submit()
+    assert np.allclose(desc.destination.to_numpy().view(np.float32), expected)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_gradient_reducer_pool(device_type: sgl.DeviceType):
+    device = helpers.get_device(type=device_type)
+    reducer = sgl.slangpy.GradientReducer(device)
+
+    # Pooled buffers are owned by the caller until released, concurrent calls never share them.
+    def allocate(index: int):
+        return [reducer.allocate_partials(16, 4, pooled=True) for _ in range(8)]
+
+    with ThreadPoolExecutor(max_workers=8) as executor:
+        held = [b for bs in executor.map(allocate, range(8)) for b in bs]
+    assert len(set(id(b) for b in held)) == len(held)
+
+    # Released buffers are reused by later allocations that fit.
+    reducer.release_partials(held)
+    reused = reducer.allocate_partials(8, 4, pooled=True)
+    assert any(reused is b for b in held)
+    assert reducer.allocate_partials(16, 4) not in held
+
+
+ACCUMULATE_SOURCE = """
+import sgl.utils.slangpy_reduce;
+
+[shader("compute")]
+[numthreads(32, 1, 1)]
+void accumulate(
+    uint3 tid: SV_DispatchThreadID,
+    uint3 gid: SV_GroupID,
+    uniform RWByteAddressBuffer partials,
+    uniform uint element_count,
+    uniform uint partial_count,
+    uniform uint workgroup
+)
+{
+    for (uint element = 0; element < element_count; ++element) {
+        float value = float(tid.x % 7 + element);
+        if (workgroup != 0)
+            accumulate_workgroup(partials, element_count, partial_count, gid.x, element, value);
+        else
+            accumulate_privatized(partials, element_count, partial_count, tid.x, element, value);
+    }
+}
+"""
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+@pytest.mark.parametrize(
+    "reduction", [GradientReduction.workgroup, GradientReduction.privatized]
+)
+def test_call_context_gradient_reduction(
+    device_type: sgl.DeviceType, reduction: GradientReduction
+):
+    device = helpers.get_device(type=device_type)
+    module = device.load_module_from_source(
+        "test_gradient_reduction_accumulate", ACCUMULATE_SOURCE
+    )
+    kernel = device.create_compute_kernel(
+        device.link_program([module], [module.entry_point("accumulate")])
+    )
+
+    thread_count = 1 << 16
+    element_count = 4
+    info = sgl.slangpy.select_gradient_reduction(
+        reduction, thread_count, 1, element_count, 32
+    )
+    assert info.reduction == reduction
+    assert info.partial_count > 1
+
+    initial = np.ones(element_count, dtype=np.float32)
+    destination = device.create_buffer(
+        size=initial.nbytes,
+        usage=sgl.ResourceUsage.shader_resource | sgl.ResourceUsage.unordered_access,
+        data=initial,
+    )
+
+    # Primal calls cannot register reductions, backward calls acquire the shared reducer on demand.
+    shape = sgl.slangpy.Shape((thread_count,))
+    with pytest.raises(RuntimeError):
+        sgl.slangpy.CallContext(device, shape).add_gradient_reduction(
+            destination, 0, element_count, info.partial_count
+        )
+    context = sgl.slangpy.CallContext(device, shape, sgl.slangpy.CallMode.bwds)
+    assert context.gradient_reducer is None
+
+    partials = context.add_gradient_reduction(
+        destination, 0, element_count, info.partial_count
+    )
+    reducer = context.gradient_reducer
+    assert reducer is not None
+    (desc,) = context.gradient_reductions
+
+    command_buffer = device.create_command_buffer()
+    reducer.clear(command_buffer, desc)
+    command_buffer.uav_barrier(partials)
+    kernel.dispatch(
+        thread_count=[thread_count, 1, 1],
+        command_buffer=command_buffer,
+        partials=partials,
+        element_count=element_count,
+        partial_count=desc.partial_count,
+        workgroup=1 if reduction == GradientReduction.workgroup else 0,
+    )
+    reducer.reduce(command_buffer, desc)
+    command_buffer.submit()
+
+    values = np.arange(thread_count) % 7
+    expected = initial + np.array(
+        [np.sum(values + e) for e in range(element_count)], dtype=np.float32
+    )
+    result = destination.to_numpy().view(np.float32)
+    assert np.allclose(result, expected, rtol=1e-4)
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
@@ -1,9 +1,19 @@
 # SPDX-License-Identifier: Apache-2.0
 
 import pytest
+import socket
+import struct
+import threading
+import time
+import numpy as np
 import sgl
+import sys
+from pathlib import Path
 
-pytest.skip("tev required for running these tests", allow_module_level=True)
+sys.path.append(str(Path(__file__).parent.parent.parent / "device/tests"))
+import sglhelpers as helpers
+
+requires_tev = pytest.mark.skip(reason="tev required for running these tests")
 
 
 def create_bitmap(
@@ -19,6 +29,7 @@ def create_bitmap(
     )
 
 
+@requires_tev
 def test_show_in_tev():
     sgl.tev.show(
         bitmap=create_bitmap(component_type=sgl.Bitmap.ComponentType.float32),
@@ -34,14 +45,218 @@ def test_show_in_tev():
     )
 
 
+@requires_tev
 def test_show_in_tev_async():
     sgl.tev.show_async(bitmap=create_bitmap(), name="test2")
 
 
+@requires_tev
 def test_show_in_tev_async_stress():
     for i in range(500):
         sgl.tev.show_async(bitmap=create_bitmap(), name=f"test3_{i}")
 
 
+# Packet types of the tev IPC protocol.
+TEV_CREATE_IMAGE = 4
+TEV_UPDATE_IMAGE_V2 = 5
+TEV_UPDATE_IMAGE_V3 = 6
+
+
+class MockTevServer:
+    """
+    Minimal tev server recording create/update image packets.
+    Each packet is a little-endian uint32 length (including itself), a type byte and the payload.
+    """
+
+    def __init__(self):
+        self.packets = []
+        self.lock = threading.Lock()
+        self.socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.socket.bind(("127.0.0.1", 0))
+        self.socket.listen()
+        self.port = self.socket.getsockname()[1]
+        self.thread = threading.Thread(target=self._accept, daemon=True)
+        self.thread.start()
+
+    def close(self):
+        self.socket.close()
+
+    def wait_for_packets(self, count: int, timeout: float = 5.0):
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            with self.lock:
+                if len(self.packets) >= count:
+                    break
+            time.sleep(0.01)
+        # Give the client a chance to send unexpected extra packets.
+        time.sleep(0.1)
+        with self.lock:
+            packets = self.packets
+            self.packets = []
+        return packets
+
+    def _accept(self):
+        while True:
+            try:
+                conn, _ = self.socket.accept()
+            except OSError:
+                return
+            threading.Thread(target=self._serve, args=(conn,), daemon=True).start()
+
+    def _recv(self, conn: socket.socket, size: int):
+        data = b""
+        while len(data) < size:
+            chunk = conn.recv(size - len(data))
+            if not chunk:
+                raise EOFError()
+            data += chunk
+        return data
+
+    def _serve(self, conn: socket.socket):
+        with conn:
+            try:
+                while True:
+                    (length,) = struct.unpack("<I", self._recv(conn, 4))
+                    self._parse(self._recv(conn, length - 4))
+            except (EOFError, OSError):
+                pass
+
+    def _parse(self, data: bytes):
+        offset = 2  # type, grab focus
+
+        def read_string():
+            nonlocal offset
+            end = data.index(b"\0", offset)
+            value = data[offset:end].decode()
+            offset = end + 1
+            return value
+
+        def read_ints(count: int):
+            nonlocal offset
+            values = struct.unpack_from(f"<{count}i", data, offset)
+            offset += 4 * count
+            return values
+
+        type = data[0]
+        name = read_string()
+        if type == TEV_CREATE_IMAGE:
+            width, height, channel_count = read_ints(3)
+            packet = {"type": "create", "name": name, "width": width, "height": height}
+            packet["channels"] = [read_string() for _ in range(channel_count)]
+        elif type in (TEV_UPDATE_IMAGE_V2, TEV_UPDATE_IMAGE_V3):
+            (channel_count,) = read_ints(1)
+            channels = [read_string() for _ in range(channel_count)]
+            x, y, width, height = read_ints(4)
+            packet = {"type": "update", "name": name, "channels": channels}
+            packet.update({"x": x, "y": y, "width": width, "height": height})
+        else:
+            packet = {"type": type, "name": name}
+        with self.lock:
+            self.packets.append(packet)
+
+
+@pytest.fixture
+def tev_server():
+    server = MockTevServer()
+    yield server
+    server.close()
+
+
+def test_show_mock(tev_server: MockTevServer):
+    assert sgl.tev.show(create_bitmap(64, 32), name="show", port=tev_server.port)
+    packets = tev_server.wait_for_packets(2)
+    # The image must be sent exactly once.
+    assert [p["type"] for p in packets] == ["create", "update"]
+    assert packets[0]["width"] == 64 and packets[0]["height"] == 32
+    assert packets[1]["width"] == 64 and packets[1]["height"] == 32
+
+
+def test_session_mock(tev_server: MockTevServer):
+    session = sgl.tev.Session({"name": "session", "port": tev_server.port, "tile_size": 32})
+
+    data = np.zeros((64, 128, 3), dtype=np.float32)
+    session.update(sgl.Bitmap(data))
+    assert session.flush()
+
+    # First frame creates the image and sends one full-width span per band of tiles.
+    packets = tev_server.wait_for_packets(3)
+    assert [p["type"] for p in packets] == ["create", "update", "update"]
+    assert packets[0]["channels"] == ["R", "G", "B"]
+    assert [(p["x"], p["y"], p["width"], p["height"]) for p in packets[1:]] == [
+        (0, 0, 128, 32),
+        (0, 32, 128, 32),
+    ]
+
+    # Only the changed tile is sent.
+    data[40, 70, 1] = 1.0
+    session.update(sgl.Bitmap(data))
+    assert session.flush()
+    packets = tev_server.wait_for_packets(1)
+    assert [(p["x"], p["y"], p["width"], p["height"]) for p in packets] == [(64, 32, 32, 32)]
+
+    # Unchanged frames send nothing.
+    session.update(sgl.Bitmap(data))
+    assert session.flush()
+    assert tev_server.wait_for_packets(0) == []
+
+    stats = session.stats
+    assert stats.frame_count == 3
+    assert stats.sent_tile_count == 9
+    assert stats.skipped_tile_count == 7 + 8
+    assert stats.sent_byte_count == (128 * 64 + 32 * 32) * 3 * 4
+
+
+def test_session_mock_uint8(tev_server: MockTevServer):
+    session = sgl.tev.Session({"name": "session_uint8", "port": tev_server.port, "tile_size": 16})
+    data = np.zeros((20, 40, 4), dtype=np.uint8)
+    session.update(sgl.Bitmap(data))
+    assert session.flush()
+    packets = tev_server.wait_for_packets(3)
+    assert [p["type"] for p in packets] == ["create", "update", "update"]
+    assert packets[0]["channels"] == ["R", "G", "B", "A"]
+    assert (packets[2]["y"], packets[2]["height"]) == (16, 4)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_session_mock_texture(device_type: sgl.DeviceType, tev_server: MockTevServer):
+    device = helpers.get_device(type=device_type)
+    session = sgl.tev.Session({"name": "session_texture", "port": tev_server.port, "tile_size": 16})
+
+    # Rows of 20 pixels are padded in the read back buffer.
+    data = np.zeros((20, 20, 4), dtype=np.float32)
+    texture = device.create_texture(
+        format=sgl.Format.rgba32_float,
+        width=20,
+        height=20,
+        usage=sgl.ResourceUsage.shader_resource,
+    )
+    texture.from_numpy(data)
+    session.update(texture)
+    assert session.flush()
+    packets = tev_server.wait_for_packets(3)
+    assert [(p["x"], p["y"], p["width"], p["height"]) for p in packets[1:]] == [
+        (0, 0, 20, 16),
+        (0, 16, 20, 4),
+    ]
+
+    # The changed pixel ends up in the right tile.
+    data[5, 18, 0] = 1.0
+    texture.from_numpy(data)
+    session.update(texture)
+    assert session.flush()
+    packets = tev_server.wait_for_packets(1)
+    assert [(p["x"], p["y"], p["width"], p["height"]) for p in packets] == [(16, 0, 4, 16)]
+
+
+def test_session_no_server():
+    with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as s:
+        s.bind(("127.0.0.1", 0))
+        port = s.getsockname()[1]
+    session = sgl.tev.Session({"port": port, "max_retries": 1})
+    session.update(create_bitmap(8, 8))
+    assert not session.flush()
+    assert session.stats.failed_frame_count == 1
+
+
 if __name__ == "__main__":
     pytest.main([__file__, "-v"])
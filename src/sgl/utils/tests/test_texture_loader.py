@@ -220,6 +220,80 @@ def test_load_texture_from_bitmap(device_type: sgl.DeviceType, format: FormatEnt
     assert np.allclose(data, image, atol=1e-6)
 
 
+@dataclass
+class ConversionEntry:
+    pixel_format: PixelFormat
+    component_type: ComponentType
+    srgb_gamma: bool
+    options: dict[str, bool]
+    format: Format
+
+
+# fmt: off
+CONVERSIONS = [
+    ConversionEntry(PixelFormat.rgb, ComponentType.uint8, False, {}, Format.rgba8_unorm),
+    ConversionEntry(PixelFormat.rgb, ComponentType.uint8, False, {"load_as_normalized": False}, Format.rgba8_uint),
+    ConversionEntry(PixelFormat.rgb, ComponentType.uint16, False, {}, Format.rgba16_unorm),
+    ConversionEntry(PixelFormat.rgb, ComponentType.uint16, False, {"load_uint16_as_float16": True}, Format.rgba16_float),
+    ConversionEntry(PixelFormat.rgba, ComponentType.uint16, False, {"load_uint16_as_float16": True}, Format.rgba16_float),
+    ConversionEntry(PixelFormat.y, ComponentType.uint16, False, {"load_uint16_as_float16": True}, Format.r16_float),
+    ConversionEntry(PixelFormat.rgb, ComponentType.float16, False, {}, Format.rgba16_float),
+    ConversionEntry(PixelFormat.rgb, ComponentType.uint8, True, {"decode_srgb": True}, Format.rgba16_float),
+    ConversionEntry(PixelFormat.rgba, ComponentType.uint8, True, {"decode_srgb": True}, Format.rgba16_float),
+    ConversionEntry(PixelFormat.rgb, ComponentType.uint16, True, {"decode_srgb": True}, Format.rgba16_float),
+]
+# fmt: on
+
+
+@pytest.mark.parametrize("conversion", CONVERSIONS)
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_load_texture_with_conversion(
+    device_type: sgl.DeviceType, conversion: ConversionEntry
+):
+    device = helpers.get_device(type=device_type)
+
+    bitmap = Bitmap(
+        pixel_format=conversion.pixel_format,
+        component_type=conversion.component_type,
+        width=100,
+        height=50,
+    )
+    bitmap.srgb_gamma = conversion.srgb_gamma
+    channels = PIXEL_FORMAT_TO_CHANNELS[conversion.pixel_format]
+    dtype = COMPONENT_TYPE_TO_DTYPE[conversion.component_type]
+    if Struct.is_float(conversion.component_type):
+        type_range = (0.0, 1.0)
+    else:
+        type_range = Struct.type_range(conversion.component_type)
+    image = create_test_array(bitmap.width, bitmap.height, channels, dtype, type_range)
+    np.array(bitmap, copy=False)[:] = image
+
+    # Results of converting on the GPU and on the CPU need to match. GPU conversion writes textures with
+    # unordered access directly and goes through a pooled scratch texture otherwise (loaded twice to reuse it).
+    loader = TextureLoader(device)
+    usages = [
+        sgl.ResourceUsage.shader_resource,
+        sgl.ResourceUsage.shader_resource | sgl.ResourceUsage.unordered_access,
+    ]
+    reference = None
+    for gpu_conversion, usage in [(False, usages[0]), (True, usages[0]), (True, usages[0]), (True, usages[1])]:
+        texture = loader.load_texture(
+            bitmap=bitmap,
+            options={**conversion.options, "gpu_conversion": gpu_conversion, "usage": usage},
+        )
+        assert texture.format == conversion.format
+        # GPU conversion does not add unordered access to the texture.
+        assert texture.desc.usage == usage
+        data = texture.to_numpy().astype(np.float64)
+        if reference is None:
+            reference = data
+            continue
+        assert data.shape == reference.shape
+        is_float16 = conversion.format in [Format.rgba16_float, Format.r16_float]
+        atol = 1e-3 if is_float16 else 0
+        assert np.allclose(data, reference, rtol=1e-3, atol=atol)
+
+
 @pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
 @pytest.mark.parametrize("filename", TEST_BITMAP_FILES)
 def test_load_texture_from_bitmap_file(device_type: sgl.DeviceType, filename: str):
@@ -275,6 +349,21 @@ def test_load_texture_array(device_type: sgl.DeviceType):
 
     loader = TextureLoader(device)
 
+    # The first layer is uploaded as is, the second one is extended to RGBA on the GPU.
+    rgba = np.random.default_rng(0).integers(0, 256, (16, 32, 4), dtype=np.uint8)
+    bitmaps = [Bitmap(rgba), Bitmap(np.ascontiguousarray(rgba[:, :, :3]))]
+    for bitmap in bitmaps:
+        bitmap.srgb_gamma = False
+    texture = loader.load_texture_array(bitmaps)
+    assert texture.format == Format.rgba8_unorm
+    assert texture.array_size == 2
+    assert texture.desc.usage == sgl.ResourceUsage.shader_resource
+
+    assert np.array_equal(texture.to_numpy(array_slice=0), rgba)
+    expected = rgba.copy()
+    expected[:, :, 3] = 255
+    assert np.array_equal(texture.to_numpy(array_slice=1), expected)
+
 
 if __name__ == "__main__":
     pytest.main([__file__, "-vvs"])
@@ -5,13 +5,18 @@
 #include "sgl/core/config.h"
 #include "sgl/core/bitmap.h"
 #include "sgl/core/format.h"
+#include "sgl/core/logger.h"
+#include "sgl/core/struct.h"
 #include "sgl/core/thread.h"
 
+#include "sgl/device/device.h"
 #include "sgl/device/resource.h"
 
 #include <tevclient.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cstring>
 #include <semaphore>
 
 namespace sgl::tev {
@@ -65,6 +70,12 @@ private:
     std::vector<std::unique_ptr<tevclient::Client>> m_clients;
 };
 
+static std::string generate_image_name()
+{
+    static std::atomic<uint32_t> image_counter{0};
+    return fmt::format("image_{}", image_counter++);
+}
+
 bool show(const Bitmap* bitmap, std::string name, std::string host, uint16_t port, uint32_t max_retries)
 {
     SGL_CHECK_NOT_NULL(bitmap);
@@ -79,9 +90,8 @@ bool show(const Bitmap* bitmap, std::string name, std::string host, uint16_t por
         bitmap = converted;
     }
 
-    static std::atomic<uint32_t> image_counter{0};
     if (name.empty())
-        name = fmt::format("image_{}", image_counter++);
+        name = generate_image_name();
 
     const auto& pixel_struct = *bitmap->pixel_struct();
     std::vector<const char*> channel_names(pixel_struct.field_count());
@@ -149,9 +159,10 @@ bool show(const Bitmap* bitmap, std::string name, std::string host, uint16_t por
         }
 
         ClientPool::get().release_client(std::move(client));
+        return true;
     }
 
-    return true;
+    return false;
 }
 
 bool show(const Texture* texture, std::string name, std::string host, uint16_t port, uint32_t max_retries)
@@ -168,7 +179,7 @@ void show_async(const Bitmap* bitmap, std::string name, std::string host, uint16
 
     bitmap->inc_ref();
 
-    thread::do_async(
+    thread::do_async_io(
         [=]()
         {
             static std::counting_semaphore semaphore{8};
@@ -188,4 +199,313 @@ void show_async(const Texture* texture, std::string name, std::string host, uint
     return show_async(bitmap, name, host, port, max_retries);
 }
 
+// -----------------------------------------------------------------------------
+// Session
+// -----------------------------------------------------------------------------
+
+Session::Session(SessionDesc desc)
+    : m_desc(std::move(desc))
+{
+    SGL_CHECK(m_desc.tile_size > 0, "Tile size must be greater than zero.");
+
+    if (m_desc.name.empty())
+        m_desc.name = generate_image_name();
+
+    // Make sure tevclient is initialized.
+    ClientPool::get();
+}
+
+Session::~Session()
+{
+    flush();
+}
+
+void Session::update(const Bitmap* bitmap)
+{
+    SGL_CHECK_NOT_NULL(bitmap);
+
+    enqueue({.bitmap = make_ref<Bitmap>(*bitmap)});
+}
+
+void Session::update(const Texture* texture, uint32_t mip_level, uint32_t array_slice)
+{
+    SGL_CHECK_NOT_NULL(texture);
+
+    ref<Bitmap> bitmap = texture->create_bitmap(mip_level, array_slice);
+    uint32_t subresource = texture->get_subresource_index(mip_level, array_slice);
+    SubresourceLayout layout = texture->get_subresource_layout(subresource);
+    Device* device = texture->device();
+
+    ref<Buffer> buffer;
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_read_back_buffer && m_read_back_buffer->device() == device
+            && m_read_back_buffer->size() >= layout.total_size_aligned())
+            buffer = std::move(m_read_back_buffer);
+    }
+    if (!buffer)
+        buffer = device->create_buffer({
+            .size = layout.total_size_aligned(),
+            .memory_type = MemoryType::read_back,
+            .debug_name = "tev_session_read_back",
+        });
+
+    // The processing thread waits for the copy and maps the buffer.
+    uint64_t submission_id = device->read_texture_data_async(texture, subresource, buffer);
+    enqueue({
+        .bitmap = std::move(bitmap),
+        .read_back_buffer = std::move(buffer),
+        .submission_id = submission_id,
+        .row_pitch = layout.row_pitch_aligned,
+    });
+}
+
+bool Session::flush()
+{
+    std::unique_lock lock(m_mutex);
+    m_idle_cv.wait(lock, [this]() { return !m_busy; });
+    return m_last_result;
+}
+
+SessionStats Session::stats() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+std::string Session::to_string() const
+{
+    return fmt::format(
+        "tev.Session(\n"
+        "  name = \"{}\",\n"
+        "  host = \"{}\",\n"
+        "  port = {},\n"
+        "  tile_size = {}\n"
+        ")",
+        m_desc.name,
+        m_desc.host,
+        m_desc.port,
+        m_desc.tile_size
+    );
+}
+
+void Session::enqueue(Frame frame)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_pending)
+        m_stats.dropped_frame_count++;
+    m_pending = std::move(frame);
+    if (!m_busy) {
+        m_busy = true;
+        thread::do_async_io([this]() { process(); });
+    }
+}
+
+void Session::process()
+{
+    while (true) {
+        Frame frame;
+        {
+            std::lock_guard lock(m_mutex);
+            if (!m_pending) {
+                m_busy = false;
+                m_idle_cv.notify_all();
+                return;
+            }
+            frame = std::move(*m_pending);
+            m_pending.reset();
+        }
+
+        SessionStats stats;
+        bool result = false;
+        bool has_data = !frame.read_back_buffer || read_back(frame);
+        for (uint32_t attempt = 1; has_data && attempt <= m_desc.max_retries && !result; ++attempt) {
+            result = send(frame.bitmap, stats);
+            if (!result) {
+                log_warn(
+                    "Failed to send image to tev (attempt {}/{}): {}",
+                    attempt,
+                    m_desc.max_retries,
+                    m_client ? m_client->lastErrorString() : "not connected"
+                );
+                reset_connection();
+            }
+        }
+
+        std::lock_guard lock(m_mutex);
+        m_last_result = result;
+        m_stats.frame_count += result ? 1 : 0;
+        m_stats.failed_frame_count += result ? 0 : 1;
+        m_stats.sent_tile_count += stats.sent_tile_count;
+        m_stats.skipped_tile_count += stats.skipped_tile_count;
+        m_stats.sent_byte_count += stats.sent_byte_count;
+    }
+}
+
+bool Session::send(const Bitmap* bitmap, SessionStats& stats)
+{
+    const Struct* pixel_struct = bitmap->pixel_struct();
+    const uint32_t width = bitmap->width();
+    const uint32_t height = bitmap->height();
+    const uint32_t channel_count = bitmap->channel_count();
+    const bool is_float = bitmap->component_type() == Bitmap::ComponentType::float32;
+
+    // Recreate the image if the layout changed.
+    if (m_previous
+        && (m_previous->width() != width || m_previous->height() != height
+            || *m_previous->pixel_struct() != *pixel_struct)) {
+        m_previous = nullptr;
+        m_image_created = false;
+    }
+
+    if (!m_previous) {
+        m_channel_names.clear();
+        for (const Struct::Field& field : *pixel_struct)
+            m_channel_names.push_back(field.name);
+        // Convert to linear float32 (the only pixel format supported by tev).
+        m_converter = nullptr;
+        if (!is_float) {
+            Bitmap dst(bitmap->pixel_format(), Bitmap::ComponentType::float32, 1, 1, channel_count, m_channel_names);
+            m_converter = make_ref<StructConverter>(pixel_struct, dst.pixel_struct());
+        }
+    }
+
+    std::vector<const char*> channel_names(channel_count);
+    std::vector<uint64_t> channel_offsets(channel_count);
+    std::vector<uint64_t> channel_strides(channel_count);
+    for (uint32_t i = 0; i < channel_count; ++i) {
+        channel_names[i] = m_channel_names[i].c_str();
+        channel_offsets[i] = i;
+        channel_strides[i] = channel_count;
+    }
+
+    if (!m_client)
+        m_client = std::make_unique<tevclient::Client>(m_desc.host.c_str(), m_desc.port);
+    if (!m_client->isConnected() && m_client->connect() != tevclient::Error::Ok)
+        return false;
+
+    if (!m_image_created) {
+        if (m_client->createImage(m_desc.name.c_str(), width, height, channel_count, channel_names.data())
+            != tevclient::Error::Ok)
+            return false;
+        m_image_created = true;
+        m_previous = nullptr;
+    }
+
+    const uint32_t tile_size = m_desc.tile_size;
+    const uint32_t tiles_x = (width + tile_size - 1) / tile_size;
+    const size_t row_size = size_t(width) * bitmap->bytes_per_pixel();
+    const size_t tile_row_size = size_t(tile_size) * bitmap->bytes_per_pixel();
+
+    std::vector<bool> changed(tiles_x);
+    for (uint32_t y = 0; y < height; y += tile_size) {
+        const uint32_t band_height = std::min(tile_size, height - y);
+        const uint8_t* src = bitmap->uint8_data() + y * row_size;
+
+        // Detect changed tiles in this band of rows.
+        uint32_t changed_count = 0;
+        for (uint32_t tx = 0; tx < tiles_x; ++tx) {
+            changed[tx] = !m_previous;
+            if (m_previous) {
+                const uint8_t* prev = m_previous->uint8_data() + y * row_size;
+                size_t offset = tx * tile_row_size;
+                size_t size = std::min(tile_row_size, row_size - offset);
+                for (uint32_t row = 0; row < band_height && !changed[tx]; ++row)
+                    changed[tx] = std::memcmp(src + row * row_size + offset, prev + row * row_size + offset, size) != 0;
+            }
+            changed_count += changed[tx] ? 1 : 0;
+        }
+        stats.skipped_tile_count += tiles_x - changed_count;
+        if (changed_count == 0)
+            continue;
+
+        // Convert the band to float32.
+        const float* band = reinterpret_cast<const float*>(src);
+        if (m_converter) {
+            m_band_data.resize(size_t(width) * band_height * channel_count);
+            m_converter->convert(src, m_band_data.data(), size_t(width) * band_height);
+            band = m_band_data.data();
+        }
+
+        // Send runs of adjacent changed tiles as a single update.
+        for (uint32_t tx = 0; tx < tiles_x;) {
+            if (!changed[tx]) {
+                ++tx;
+                continue;
+            }
+            uint32_t tx_end = tx;
+            while (tx_end < tiles_x && changed[tx_end])
+                ++tx_end;
+
+            const uint32_t x = tx * tile_size;
+            const uint32_t span_width = std::min(tx_end * tile_size, width) - x;
+            const size_t span_size = size_t(span_width) * band_height * channel_count;
+            const float* data = band;
+            if (span_width != width) {
+                m_span_data.resize(span_size);
+                for (uint32_t row = 0; row < band_height; ++row)
+                    std::memcpy(
+                        m_span_data.data() + size_t(row) * span_width * channel_count,
+                        band + (size_t(row) * width + x) * channel_count,
+                        span_width * channel_count * sizeof(float)
+                    );
+                data = m_span_data.data();
+            }
+
+            if (m_client->updateImage(
+                    m_desc.name.c_str(),
+                    x,
+                    y,
+                    span_width,
+                    band_height,
+                    channel_count,
+                    channel_names.data(),
+                    channel_offsets.data(),
+                    channel_strides.data(),
+                    data,
+                    span_size
+                )
+                != tevclient::Error::Ok)
+                return false;
+
+            stats.sent_tile_count += tx_end - tx;
+            stats.sent_byte_count += span_size * sizeof(float);
+            tx = tx_end;
+        }
+    }
+
+    m_previous = ref(bitmap);
+    return true;
+}
+
+bool Session::read_back(Frame& frame)
+{
+    Buffer* buffer = frame.read_back_buffer;
+    try {
+        buffer->device()->wait_command_buffer(frame.submission_id);
+
+        // Rows in the read back buffer are aligned, bitmap rows are tightly packed.
+        const uint8_t* src = buffer->map<uint8_t>();
+        uint8_t* dst = frame.bitmap->uint8_data();
+        const size_t row_size = size_t(frame.bitmap->width()) * frame.bitmap->bytes_per_pixel();
+        for (uint32_t row = 0; row < frame.bitmap->height(); ++row)
+            std::memcpy(dst + row * row_size, src + row * frame.row_pitch, row_size);
+        buffer->unmap();
+    } catch (const std::exception& e) {
+        log_warn("Failed to read back texture for tev: {}", e.what());
+        return false;
+    }
+
+    std::lock_guard lock(m_mutex);
+    m_read_back_buffer = std::move(frame.read_back_buffer);
+    return true;
+}
+
+void Session::reset_connection()
+{
+    m_client.reset();
+    m_image_created = false;
+    m_previous = nullptr;
+}
+
 } // namespace sgl::tev
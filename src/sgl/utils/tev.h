@@ -4,12 +4,22 @@
 
 #include "sgl/core/macros.h"
 #include "sgl/core/fwd.h"
+#include "sgl/core/object.h"
 
 #include "sgl/device/fwd.h"
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <vector>
 #include <cstdint>
 
+namespace tevclient {
+class Client;
+}
+
 namespace sgl::tev {
 
 /**
@@ -90,4 +100,105 @@ SGL_API void show_async(
     uint32_t max_retries = 3
 );
 
+struct SessionDesc {
+    /// Name of the image in tev. If empty, a unique name is generated.
+    std::string name;
+    /// Host to connect to.
+    std::string host{"127.0.0.1"};
+    /// Port to connect to.
+    uint16_t port{14158};
+    /// Maximum number of retries when sending a frame fails.
+    uint32_t max_retries{3};
+    /// Size of the tiles used for change detection (in pixels).
+    uint32_t tile_size{64};
+};
+
+struct SessionStats {
+    /// Number of frames sent.
+    uint64_t frame_count{0};
+    /// Number of frames dropped because a newer frame was submitted before they were sent.
+    uint64_t dropped_frame_count{0};
+    /// Number of frames that failed to send.
+    uint64_t failed_frame_count{0};
+    /// Number of tiles sent.
+    uint64_t sent_tile_count{0};
+    /// Number of unchanged tiles that were not sent.
+    uint64_t skipped_tile_count{0};
+    /// Number of pixel data bytes sent.
+    uint64_t sent_byte_count{0};
+};
+
+/**
+ * \brief Persistent connection to an image in the tev viewer (https://github.com/Tom94/tev).
+ *
+ * Intended for live previews of progressive renders. The image is created in tev once
+ * and subsequent updates only send tiles that changed since the previous frame.
+ *
+ * Frames are converted and sent on the I/O thread pool, so \c update returns immediately.
+ * Textures are copied to a read back buffer on the GPU, which is mapped on the I/O thread pool
+ * once the copy has completed. If a new frame is submitted while the previous one has not been
+ * sent yet, the previous frame is dropped.
+ */
+class SGL_API Session : public Object {
+    SGL_OBJECT(Session)
+public:
+    Session(SessionDesc desc = {});
+    ~Session();
+
+    const SessionDesc& desc() const { return m_desc; }
+
+    /// Submit a new frame. The bitmap is copied.
+    void update(const Bitmap* bitmap);
+
+    /// Submit a new frame. The texture is read back in its native format without waiting for the GPU.
+    void update(const Texture* texture, uint32_t mip_level = 0, uint32_t array_slice = 0);
+
+    /// Block until all submitted frames are sent.
+    /// \return True if the last frame was sent successfully.
+    bool flush();
+
+    /// Statistics of the session.
+    SessionStats stats() const;
+
+    std::string to_string() const override;
+
+private:
+    /// Frame waiting to be sent.
+    struct Frame {
+        ref<Bitmap> bitmap;
+        /// Read back buffer holding the texture data to copy into \c bitmap (texture frames only).
+        ref<Buffer> read_back_buffer;
+        /// Submission that copies the texture data to \c read_back_buffer.
+        uint64_t submission_id{0};
+        /// Row pitch of the data in \c read_back_buffer.
+        size_t row_pitch{0};
+    };
+
+    void enqueue(Frame frame);
+    void process();
+    bool read_back(Frame& frame);
+    bool send(const Bitmap* bitmap, SessionStats& stats);
+    void reset_connection();
+
+    SessionDesc m_desc;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_idle_cv;
+    std::optional<Frame> m_pending;
+    bool m_busy{false};
+    /// Read back buffer that is not in use and can be reused by the next texture frame.
+    ref<Buffer> m_read_back_buffer;
+    bool m_last_result{true};
+    SessionStats m_stats;
+
+    // State below is only accessed while processing frames.
+    std::unique_ptr<tevclient::Client> m_client;
+    bool m_image_created{false};
+    ref<const Bitmap> m_previous;
+    ref<StructConverter> m_converter;
+    std::vector<std::string> m_channel_names;
+    std::vector<float> m_band_data;
+    std::vector<float> m_span_data;
+};
+
 } // namespace sgl::tev
@@ -5,16 +5,29 @@
 #include "sgl/device/device.h"
 #include "sgl/device/command.h"
 #include "sgl/device/blit.h"
+#include "sgl/device/formats.h"
+#include "sgl/device/kernel.h"
+#include "sgl/device/memory_heap.h"
 #include "sgl/device/native_formats.h"
+#include "sgl/device/shader.h"
+#include "sgl/device/shader_cursor.h"
 
 #include "sgl/core/error.h"
+#include "sgl/core/async_io.h"
 #include "sgl/core/bitmap.h"
 #include "sgl/core/dds_file.h"
 #include "sgl/core/file_stream.h"
+#include "sgl/core/format.h"
+#include "sgl/core/maths.h"
+#include "sgl/core/memory_stream.h"
 #include "sgl/core/timer.h"
 #include "sgl/core/thread.h"
 
+#include "sgl/math/vector.h"
+
+#include <cstring>
 #include <map>
+#include <mutex>
 
 namespace sgl {
 
@@ -26,6 +39,24 @@ struct SourceImage {
     ref<Bitmap> bitmap;
     ref<DDSFile> dds_file;
     Format format{Format::unknown};
+    /// Bitmap needs to be converted to the texture format on the GPU.
+    bool gpu_conversion{false};
+    /// Decode sRGB gamma during GPU conversion.
+    bool decode_srgb{false};
+};
+
+/// Texture format determined for a bitmap and the bitmap format required to upload to it.
+struct TextureFormat {
+    Format format;
+    Bitmap::PixelFormat pixel_format;
+    Bitmap::ComponentType component_type;
+    /// Decode sRGB gamma to linear values.
+    bool decode_srgb;
+
+    bool needs_conversion(const Bitmap* bitmap) const
+    {
+        return pixel_format != bitmap->pixel_format() || component_type != bitmap->component_type() || decode_srgb;
+    }
 };
 
 /**
@@ -38,12 +69,16 @@ struct SourceImage {
  *   8-bit RGBA bitmap with sRGB gamma will be determined as \c Format::rgba8_unorm_srgb.
  * - \c Options::load_as_normalized
  *   8/16-bit integer bitmap will be determined as normalized resource format.
+ * - \c Options::decode_srgb
+ *   Bitmap with sRGB gamma will be determined as float16 format (unless float32) holding linear values.
+ * - \c Options::load_uint16_as_float16
+ *   Normalized 16-bit integer bitmap will be determined as float16 format.
  *
  * \param bitmap Bitmap to determine format for.
  * \param options Texture loading options.
- * \return A pair containing the determined format and flag if the bitmap needs to be converted to RGBA to match the format.
+ * \return The determined format and the bitmap format needed to match it.
  */
-inline std::pair<Format, bool> determine_texture_format(const Bitmap* bitmap, const TextureLoader::Options& options)
+inline TextureFormat determine_texture_format(const Bitmap* bitmap, const TextureLoader::Options& options)
 {
     SGL_ASSERT(bitmap != nullptr);
 
@@ -119,26 +154,38 @@ inline std::pair<Format, bool> determine_texture_format(const Bitmap* bitmap, co
     if (pixel_format == PixelFormat::y)
         pixel_format = PixelFormat::r;
     ComponentType component_type = bitmap->component_type();
+    bool is_normalized = Struct::is_float(component_type)
+        || (options.load_as_normalized && Struct::type_size(component_type) <= 2);
+
+    // Decode sRGB gamma to linear float16 (float32 bitmaps keep their precision).
+    bool decode_srgb = false;
+    if (options.decode_srgb && bitmap->srgb_gamma() && is_normalized) {
+        decode_srgb = true;
+        if (component_type != ComponentType::float32)
+            component_type = ComponentType::float16;
+    }
+
+    // Load normalized 16-bit integer data as float16.
+    if (options.load_uint16_as_float16 && options.load_as_normalized && component_type == ComponentType::uint16)
+        component_type = ComponentType::float16;
+
     FormatFlags format_flags = FormatFlags::none;
     if (options.load_as_normalized && Struct::is_integer(component_type))
         format_flags = FormatFlags::normalized;
 
     // Check if bitmap is RGB and we can convert to RGBA.
-    bool convert_to_rgba = false;
     if (options.extend_alpha && pixel_format == PixelFormat::rgb) {
         bool rgb_format_supported
             = FORMAT_TABLE.find(make_key(PixelFormat::rgb, component_type, format_flags)) != FORMAT_TABLE.end();
         bool rgba_format_supported
             = FORMAT_TABLE.find(make_key(PixelFormat::rgba, component_type, format_flags)) != FORMAT_TABLE.end();
-        if (!rgb_format_supported && rgba_format_supported) {
-            convert_to_rgba = true;
+        if (!rgb_format_supported && rgba_format_supported)
             pixel_format = PixelFormat::rgba;
-        }
     }
 
     // Use sRGB format if requested and supported.
     if (options.load_as_srgb && pixel_format == PixelFormat::rgba && component_type == ComponentType::uint8
-        && bitmap->srgb_gamma())
+        && bitmap->srgb_gamma() && !decode_srgb)
         format_flags = FormatFlags::srgb;
 
     // Find texture format.
@@ -146,7 +193,16 @@ inline std::pair<Format, bool> determine_texture_format(const Bitmap* bitmap, co
     if (it == FORMAT_TABLE.end())
         SGL_THROW("Unsupported bitmap format: {} {}", pixel_format, component_type);
 
-    return {it->second, convert_to_rgba};
+    // Y bitmaps are uploaded to R textures as is.
+    if (pixel_format == PixelFormat::r && bitmap->pixel_format() == PixelFormat::y)
+        pixel_format = PixelFormat::y;
+
+    return {
+        .format = it->second,
+        .pixel_format = pixel_format,
+        .component_type = component_type,
+        .decode_srgb = decode_srgb,
+    };
 }
 
 inline ResourceType get_resource_type(DDSFile::TextureType type)
@@ -165,44 +221,354 @@ inline ResourceType get_resource_type(DDSFile::TextureType type)
     }
 }
 
-inline SourceImage convert_bitmap(ref<Bitmap> bitmap, const TextureLoader::Options& options)
+/// Check if a bitmap can be converted to a texture format on the GPU.
+inline bool supports_gpu_conversion(const Device* device, const Bitmap* bitmap, Format format)
 {
-    auto [format, convert_to_rgba] = determine_texture_format(bitmap, options);
-    return SourceImage{
-        .bitmap = convert_to_rgba
-            ? bitmap->convert(Bitmap::PixelFormat::rgba, bitmap->component_type(), bitmap->srgb_gamma())
-            : bitmap,
-        .format = format,
+    if (bitmap->pixel_format() == Bitmap::PixelFormat::multi_channel || bitmap->channel_count() > 4)
+        return false;
+    if (Struct::type_size(bitmap->component_type()) > 4)
+        return false;
+    return device->get_format_supported_resource_states(format).contains(ResourceState::unordered_access);
+}
+
+inline SourceImage convert_bitmap(const Device* device, ref<Bitmap> bitmap, const TextureLoader::Options& options)
+{
+    TextureFormat texture_format = determine_texture_format(bitmap, options);
+    SourceImage source_image{
+        .bitmap = bitmap,
+        .format = texture_format.format,
     };
+    if (texture_format.needs_conversion(bitmap)) {
+        if (options.gpu_conversion && supports_gpu_conversion(device, bitmap, texture_format.format)) {
+            source_image.gpu_conversion = true;
+            source_image.decode_srgb = texture_format.decode_srgb;
+        } else {
+            source_image.bitmap = bitmap->convert(
+                texture_format.pixel_format,
+                texture_format.component_type,
+                bitmap->srgb_gamma() && !texture_format.decode_srgb
+            );
+        }
+    }
+    return source_image;
 }
 
-inline SourceImage load_source_image(const std::filesystem::path& path)
+inline SourceImage load_source_image(Stream* stream)
 {
     SourceImage source_image;
-    FileStream stream(path, FileStream::Mode::read);
-    if (DDSFile::detect_dds_file(&stream)) {
-        source_image.dds_file = ref(new DDSFile(&stream));
+    if (DDSFile::detect_dds_file(stream)) {
+        source_image.dds_file = ref(new DDSFile(stream));
         source_image.format = get_format(DXGI_FORMAT(source_image.dds_file->dxgi_format()));
-    } else if (Bitmap::detect_file_format(&stream) != Bitmap::FileFormat::unknown) {
-        source_image.bitmap = ref(new Bitmap(&stream));
+    } else if (Bitmap::detect_file_format(stream) != Bitmap::FileFormat::unknown) {
+        source_image.bitmap = ref(new Bitmap(stream));
     }
     return source_image;
 }
 
-inline SourceImage
-load_and_convert_source_image(const std::filesystem::path& path, const TextureLoader::Options& options)
+inline SourceImage load_source_image(const std::filesystem::path& path)
+{
+    FileStream stream(path, FileStream::Mode::read);
+    return load_source_image(&stream);
+}
+
+inline SourceImage load_and_convert_source_image(
+    const Device* device,
+    const std::filesystem::path& path,
+    const TextureLoader::Options& options
+)
 {
     SourceImage source_image = load_source_image(path);
     if (source_image.bitmap) {
-        source_image = convert_bitmap(source_image.bitmap, options);
+        source_image = convert_bitmap(device, source_image.bitmap, options);
     }
     return source_image;
 }
 
+/// Read a source image with the async I/O service and convert it on the global thread pool.
+inline std::future<SourceImage> read_and_convert_source_image_async(
+    const Device* device,
+    const std::filesystem::path& path,
+    const TextureLoader::Options& options
+)
+{
+    return async_io::read_file_and_process(
+        path,
+        [device, options](std::vector<uint8_t> data)
+        {
+            MemoryStream stream(data.data(), data.size());
+            SourceImage source_image = load_source_image(&stream);
+            if (source_image.bitmap)
+                source_image = convert_bitmap(device, source_image.bitmap, options);
+            return source_image;
+        }
+    );
+}
+
+/**
+ * \brief Uploads bitmaps to textures and converts them to the texture format on the GPU.
+ *
+ * The packed bitmap rows are written to upload memory and a compute kernel converts each pixel
+ * (RGB to RGBA expansion, normalization, float16 conversion and sRGB decoding). Destination textures
+ * with unordered access are written directly. Otherwise the kernel writes into a pooled scratch texture,
+ * which is then copied into the destination texture. Compared to converting bitmaps on the CPU, this
+ * avoids allocating and filling converted copies.
+ *
+ * The uploader can be used from multiple threads.
+ */
+class BitmapUploader : public Object {
+    SGL_OBJECT(BitmapUploader)
+public:
+    /// Resources used by a command buffer. Need to be kept alive until the command buffer is submitted.
+    struct Uploads {
+        std::vector<MemoryHeap::Allocation> allocations;
+        std::vector<ref<Texture>> scratch_textures;
+    };
+
+    BitmapUploader(Device* device)
+        : m_device(device)
+    {
+        // Upload memory is bound directly to the conversion kernel.
+        m_upload_heap = m_device->create_memory_heap({
+            .memory_type = MemoryType::upload,
+            .usage = ResourceUsage::shader_resource,
+            .debug_name = "texture_loader_upload_heap",
+        });
+    }
+
+    /**
+     * \brief Upload a bitmap to mip level 0 of a texture (or texture array layer).
+     *
+     * \param command_buffer Command buffer.
+     * \param texture Destination texture.
+     * \param array_layer Destination array layer.
+     * \param bitmap Bitmap to upload.
+     * \param decode_srgb Decode sRGB gamma of color channels to linear values.
+     * \param uploads Receives the upload memory and scratch textures used by the command buffer.
+     */
+    void upload(
+        CommandBuffer* command_buffer,
+        Texture* texture,
+        uint32_t array_layer,
+        const Bitmap* bitmap,
+        bool decode_srgb,
+        Uploads& uploads
+    )
+    {
+        SGL_ASSERT(texture->width() == bitmap->width() && texture->height() == bitmap->height());
+
+        Struct::Type component_type = bitmap->component_type();
+        const FormatInfo& info = get_format_info(texture->format());
+
+        KernelKey key{
+            .src_kind = Struct::is_float(component_type) ? SourceKind::float_
+                : Struct::is_signed(component_type)      ? SourceKind::sint
+                                                         : SourceKind::uint,
+            .src_bits = narrow_cast<uint32_t>(Struct::type_size(component_type) * 8),
+            .src_channels = bitmap->channel_count(),
+            .srgb_channels = decode_srgb ? get_srgb_channel_count(bitmap->pixel_format()) : 0,
+            .dst_type = info.is_integer_format() ? (info.type == FormatType::uint ? DestType::uint : DestType::int_)
+                                                 : DestType::float_,
+        };
+        ComputeKernel* kernel = get_kernel(key);
+
+        // Raw buffers are addressed in 32-bit words.
+        MemoryHeap::Allocation allocation;
+        {
+            std::lock_guard lock(m_mutex);
+            m_upload_heap->execute_deferred_releases();
+            allocation = m_upload_heap->allocate(align_to<size_t>(4, bitmap->buffer_size()), 4);
+        }
+        std::memcpy(allocation->data, bitmap->data(), bitmap->buffer_size());
+
+        // Single layer textures with unordered access are written directly. The kernel writes a 2D texture,
+        // so array layers go through a scratch texture.
+        bool write_direct
+            = is_set(texture->desc().usage, ResourceUsage::unordered_access) && texture->layer_count() == 1;
+        ref<Texture> scratch;
+        ref<ResourceView> dst;
+        if (write_direct) {
+            dst = texture->get_uav({.mip_level = 0, .mip_count = 1});
+        } else {
+            scratch = acquire_scratch(texture->format(), bitmap->width(), bitmap->height());
+            dst = scratch->get_uav();
+        }
+
+        kernel->dispatch(
+            uint3(bitmap->width(), bitmap->height(), 1),
+            [&](ShaderCursor cursor)
+            {
+                cursor["src"] = allocation->buffer;
+                cursor["dst"] = dst;
+                cursor["src_offset"] = narrow_cast<uint32_t>(allocation->offset);
+                cursor["size"] = uint2(bitmap->width(), bitmap->height());
+                cursor["row_pitch"] = narrow_cast<uint32_t>(bitmap->width() * bitmap->bytes_per_pixel());
+            },
+            command_buffer
+        );
+        if (scratch) {
+            uint32_t subresource = texture->get_subresource_index(0, array_layer);
+            command_buffer->copy_texture_region(texture, subresource, uint3(0), scratch, 0, uint3(0));
+            uploads.scratch_textures.push_back(std::move(scratch));
+        }
+
+        uploads.allocations.push_back(std::move(allocation));
+    }
+
+    /// Release upload memory and return scratch textures to the pool after the command buffer using them was
+    /// submitted. Later command buffers are executed after it, so the scratch textures can be reused right away.
+    void release(Uploads& uploads)
+    {
+        std::lock_guard lock(m_mutex);
+        uploads.allocations.clear();
+        for (ref<Texture>& scratch : uploads.scratch_textures) {
+            auto& pool = m_scratch_pool[{scratch->format(), scratch->width(), scratch->height()}];
+            if (pool.size() < MAX_POOLED_SCRATCH_TEXTURES)
+                pool.push_back(std::move(scratch));
+        }
+        uploads.scratch_textures.clear();
+    }
+
+private:
+    enum class SourceKind {
+        uint,
+        sint,
+        float_,
+    };
+
+    enum class DestType {
+        float_,
+        uint,
+        int_,
+    };
+
+    struct KernelKey {
+        SourceKind src_kind;
+        uint32_t src_bits;
+        uint32_t src_channels;
+        uint32_t srgb_channels;
+        DestType dst_type;
+
+        auto operator<=>(const KernelKey&) const = default;
+    };
+
+    /// Maximum number of pooled scratch textures per format and size.
+    static constexpr size_t MAX_POOLED_SCRATCH_TEXTURES = 4;
+
+    struct ScratchKey {
+        Format format;
+        uint32_t width;
+        uint32_t height;
+
+        auto operator<=>(const ScratchKey&) const = default;
+    };
+
+    ref<Texture> acquire_scratch(Format format, uint32_t width, uint32_t height)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            auto it = m_scratch_pool.find({format, width, height});
+            if (it != m_scratch_pool.end() && !it->second.empty()) {
+                ref<Texture> scratch = std::move(it->second.back());
+                it->second.pop_back();
+                return scratch;
+            }
+        }
+        return m_device->create_texture({
+            .format = format,
+            .width = width,
+            .height = height,
+            .usage = ResourceUsage::unordered_access,
+            .debug_name = "texture_loader_scratch",
+        });
+    }
+
+    /// Number of leading channels holding sRGB encoded values (alpha is always linear).
+    static uint32_t get_srgb_channel_count(Bitmap::PixelFormat pixel_format)
+    {
+        switch (pixel_format) {
+        case Bitmap::PixelFormat::y:
+        case Bitmap::PixelFormat::ya:
+        case Bitmap::PixelFormat::r:
+            return 1;
+        case Bitmap::PixelFormat::rg:
+            return 2;
+        case Bitmap::PixelFormat::rgb:
+        case Bitmap::PixelFormat::rgba:
+            return 3;
+        default:
+            return 0;
+        }
+    }
+
+    ComputeKernel* get_kernel(const KernelKey& key)
+    {
+        std::lock_guard lock(m_mutex);
+
+        auto it = m_kernel_cache.find(key);
+        if (it != m_kernel_cache.end())
+            return it->second;
+
+        std::string source;
+        source += fmt::format(
+            "#define SRC_KIND {}\n"
+            "#define SRC_BITS {}\n"
+            "#define SRC_CHANNELS {}\n"
+            "#define SRGB_CHANNELS {}\n"
+            "#define DST_TYPE {}\n\n",
+            uint32_t(key.src_kind),
+            key.src_bits,
+            key.src_channels,
+            key.srgb_channels,
+            uint32_t(key.dst_type)
+        );
+        source += m_device->slang_session()->load_source("sgl/utils/texture_loader.slang");
+
+        ref<SlangModule> module = m_device->slang_session()->load_module_from_source("texture_loader", source);
+        module->break_strong_reference_to_session();
+        ref<ShaderProgram> program = m_device->slang_session()->link_program({module}, {module->entry_point("main")});
+        ref<ComputeKernel> kernel = m_device->create_compute_kernel({.program = program});
+
+        m_kernel_cache[key] = kernel;
+        return kernel;
+    }
+
+    Device* m_device;
+    /// Guards the kernel cache, the upload heap and the scratch texture pool.
+    std::mutex m_mutex;
+    std::map<KernelKey, ref<ComputeKernel>> m_kernel_cache;
+    ref<MemoryHeap> m_upload_heap;
+    std::map<ScratchKey, std::vector<ref<Texture>>> m_scratch_pool;
+};
+
+/// Upload a bitmap source image to mip level 0 of a texture (or texture array layer).
+inline void upload_bitmap(
+    CommandBuffer* command_buffer,
+    BitmapUploader* bitmap_uploader,
+    Texture* texture,
+    uint32_t array_layer,
+    const SourceImage& source_image,
+    BitmapUploader::Uploads& uploads
+)
+{
+    const Bitmap* bitmap = source_image.bitmap;
+    if (source_image.gpu_conversion) {
+        bitmap_uploader->upload(command_buffer, texture, array_layer, bitmap, source_image.decode_srgb, uploads);
+    } else {
+        SubresourceData subresource_data{
+            .data = bitmap->data(),
+            .size = bitmap->buffer_size(),
+            .row_pitch = bitmap->width() * bitmap->bytes_per_pixel(),
+        };
+        command_buffer->upload_texture_data(texture, texture->get_subresource_index(0, array_layer), subresource_data);
+    }
+}
+
 inline ref<Texture> create_texture(
     Device* device,
     Blitter* blitter,
+    BitmapUploader* bitmap_uploader,
     CommandBuffer* command_buffer,
+    BitmapUploader::Uploads& uploads,
     SourceImage source_image,
     const TextureLoader::Options& options
 )
@@ -223,12 +589,7 @@ inline ref<Texture> create_texture(
             .usage = usage,
         });
 
-        SubresourceData subresource_data{
-            .data = bitmap->data(),
-            .row_pitch = bitmap->width() * bitmap->bytes_per_pixel(),
-        };
-
-        command_buffer->upload_texture_data(texture, 0, subresource_data);
+        upload_bitmap(command_buffer, bitmap_uploader, texture, 0, source_image, uploads);
         if (options.generate_mips) {
             blitter->generate_mips(command_buffer, texture);
             texture->invalidate_views();
@@ -258,21 +619,33 @@ inline ref<Texture> create_texture(
 inline std::vector<ref<Texture>> create_textures(
     Device* device,
     Blitter* blitter,
+    BitmapUploader* bitmap_uploader,
     std::span<std::future<SourceImage>> source_images,
     const TextureLoader::Options& options
 )
 {
     std::vector<ref<Texture>> textures(source_images.size());
     ref<CommandBuffer> command_buffer = device->create_command_buffer();
+    BitmapUploader::Uploads uploads;
     for (size_t i = 0; i < source_images.size(); ++i) {
-        textures[i] = create_texture(device, blitter, command_buffer, source_images[i].get(), options);
+        textures[i] = create_texture(
+            device,
+            blitter,
+            bitmap_uploader,
+            command_buffer,
+            uploads,
+            source_images[i].get(),
+            options
+        );
         if (i && (i % BATCH_SIZE == 0)) {
             command_buffer->submit();
+            bitmap_uploader->release(uploads);
             device->run_garbage_collection();
             command_buffer->open();
         }
     }
     command_buffer->submit();
+    bitmap_uploader->release(uploads);
 
     return textures;
 }
@@ -280,6 +653,7 @@ inline std::vector<ref<Texture>> create_textures(
 inline ref<Texture> create_texture_array(
     Device* device,
     Blitter* blitter,
+    BitmapUploader* bitmap_uploader,
     std::span<std::future<SourceImage>> source_images,
     const TextureLoader::Options& options
 )
@@ -298,6 +672,7 @@ inline ref<Texture> create_texture_array(
     Format first_format = Format::unknown;
 
     ref<CommandBuffer> command_buffer = device->create_command_buffer();
+    BitmapUploader::Uploads uploads;
 
     for (size_t i = 0; i < source_images.size(); ++i) {
         SourceImage source_image = source_images[i].get();
@@ -325,22 +700,19 @@ inline ref<Texture> create_texture_array(
 
         if (i && (i % BATCH_SIZE == 0)) {
             command_buffer->submit();
+            bitmap_uploader->release(uploads);
             device->run_garbage_collection();
             command_buffer->open();
         }
 
-        uint32_t subresource = texture->get_subresource_index(0, narrow_cast<uint32_t>(i));
-        SubresourceData subresource_data{
-            .data = bitmap->data(),
-            .size = bitmap->buffer_size(),
-            .row_pitch = bitmap->width() * bitmap->bytes_per_pixel(),
-        };
-        command_buffer->upload_texture_data(texture, subresource, subresource_data);
+        // Each layer is converted on the GPU or the CPU depending on its own bitmap.
+        upload_bitmap(command_buffer, bitmap_uploader, texture, narrow_cast<uint32_t>(i), source_image, uploads);
 
         if (options.generate_mips)
             blitter->generate_mips(command_buffer, texture, narrow_cast<uint32_t>(i));
     }
     command_buffer->submit();
+    bitmap_uploader->release(uploads);
 
     if (options.generate_mips)
         texture->invalidate_views();
@@ -354,6 +726,7 @@ TextureLoader::TextureLoader(ref<Device> device)
     : m_device(std::move(device))
 {
     m_blitter = ref(new Blitter(m_device));
+    m_bitmap_uploader = ref(new BitmapUploader(m_device));
 }
 
 TextureLoader::~TextureLoader() = default;
@@ -361,20 +734,26 @@ TextureLoader::~TextureLoader() = default;
 ref<Texture> TextureLoader::load_texture(const Bitmap* bitmap, std::optional<Options> options_)
 {
     Options options = options_.value_or(Options{});
-    SourceImage source_image = convert_bitmap(ref(const_cast<Bitmap*>(bitmap)), options);
+    SourceImage source_image = convert_bitmap(m_device, ref(const_cast<Bitmap*>(bitmap)), options);
     ref<CommandBuffer> command_buffer = m_device->create_command_buffer();
-    ref<Texture> texture = create_texture(m_device, m_blitter, command_buffer, source_image, options);
+    BitmapUploader::Uploads uploads;
+    ref<Texture> texture
+        = create_texture(m_device, m_blitter, m_bitmap_uploader, command_buffer, uploads, source_image, options);
     command_buffer->submit();
+    m_bitmap_uploader->release(uploads);
     return texture;
 }
 
 ref<Texture> TextureLoader::load_texture(const std::filesystem::path& path, std::optional<Options> options_)
 {
     Options options = options_.value_or(Options{});
-    SourceImage source_image = load_and_convert_source_image(path, options);
+    SourceImage source_image = load_and_convert_source_image(m_device, path, options);
     ref<CommandBuffer> command_buffer = m_device->create_command_buffer();
-    ref<Texture> texture = create_texture(m_device, m_blitter, command_buffer, source_image, options);
+    BitmapUploader::Uploads uploads;
+    ref<Texture> texture
+        = create_texture(m_device, m_blitter, m_bitmap_uploader, command_buffer, uploads, source_image, options);
     command_buffer->submit();
+    m_bitmap_uploader->release(uploads);
     return texture;
 }
 
@@ -387,9 +766,11 @@ TextureLoader::load_textures(std::span<const Bitmap*> bitmaps, std::optional<Opt
     std::vector<std::future<SourceImage>> source_images;
     source_images.reserve(bitmaps.size());
     for (const auto& bitmap : bitmaps)
-        source_images.push_back(thread::do_async(convert_bitmap, ref(const_cast<Bitmap*>(bitmap)), options));
+        source_images.push_back(
+            thread::do_async(convert_bitmap, m_device.get(), ref(const_cast<Bitmap*>(bitmap)), options)
+        );
 
-    return create_textures(m_device, m_blitter, source_images, options);
+    return create_textures(m_device, m_blitter, m_bitmap_uploader, source_images, options);
 }
 
 std::vector<ref<Texture>>
@@ -397,13 +778,13 @@ TextureLoader::load_textures(std::span<std::filesystem::path> paths, std::option
 {
     Options options = options_.value_or(Options{});
 
-    // Load & convert source images in parallel.
+    // Read source images asynchronously & convert them in parallel.
     std::vector<std::future<SourceImage>> source_images;
     source_images.reserve(paths.size());
     for (const auto& path : paths)
-        source_images.push_back(thread::do_async(load_and_convert_source_image, path, options));
+        source_images.push_back(read_and_convert_source_image_async(m_device, path, options));
 
-    return create_textures(m_device, m_blitter, source_images, options);
+    return create_textures(m_device, m_blitter, m_bitmap_uploader, source_images, options);
 }
 
 ref<Texture> TextureLoader::load_texture_array(std::span<const Bitmap*> bitmaps, std::optional<Options> options_)
@@ -417,9 +798,11 @@ ref<Texture> TextureLoader::load_texture_array(std::span<const Bitmap*> bitmaps,
     std::vector<std::future<SourceImage>> source_images;
     source_images.reserve(bitmaps.size());
     for (const auto& bitmap : bitmaps)
-        source_images.push_back(thread::do_async(convert_bitmap, ref(const_cast<Bitmap*>(bitmap)), options));
+        source_images.push_back(
+            thread::do_async(convert_bitmap, m_device.get(), ref(const_cast<Bitmap*>(bitmap)), options)
+        );
 
-    return create_texture_array(m_device, m_blitter, source_images, options);
+    return create_texture_array(m_device, m_blitter, m_bitmap_uploader, source_images, options);
 }
 
 ref<Texture> TextureLoader::load_texture_array(std::span<std::filesystem::path> paths, std::optional<Options> options_)
@@ -429,13 +812,13 @@ ref<Texture> TextureLoader::load_texture_array(std::span<std::filesystem::path>
 
     Options options = options_.value_or(Options{});
 
-    // Load & convert source images in parallel.
+    // Read source images asynchronously & convert them in parallel.
     std::vector<std::future<SourceImage>> source_images;
     source_images.reserve(paths.size());
     for (const auto& path : paths)
-        source_images.push_back(thread::do_async(load_and_convert_source_image, path, options));
+        source_images.push_back(read_and_convert_source_image_async(m_device, path, options));
 
-    return create_texture_array(m_device, m_blitter, source_images, options);
+    return create_texture_array(m_device, m_blitter, m_bitmap_uploader, source_images, options);
 }
 
 } // namespace sgl
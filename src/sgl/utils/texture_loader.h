@@ -12,6 +12,8 @@
 
 namespace sgl {
 
+class BitmapUploader;
+
 /**
  * \brief Utility class for loading textures from bitmaps and image files.
  */
@@ -28,6 +30,15 @@ public:
         bool load_as_srgb{true};
         /// Extend RGB to RGBA if RGB texture format is not available.
         bool extend_alpha{true};
+        /// Decode bitmaps with sRGB gamma to linear values (stored as float16 unless the bitmap is float32).
+        bool decode_srgb{false};
+        /// Load normalized 16-bit integer data as float16.
+        bool load_uint16_as_float16{false};
+        /// Convert bitmaps on the GPU during upload instead of on the CPU (if the texture format supports
+        /// unordered access). A compute kernel converts the packed bitmap data directly into textures with
+        /// unordered access usage, or into a scratch texture that is copied into the texture otherwise,
+        /// so the texture keeps the requested usage flags.
+        bool gpu_conversion{true};
         /// Allocate mip levels for the texture.
         bool allocate_mips{false};
         /// Generate mip levels for the texture.
@@ -101,6 +112,7 @@ public:
 private:
     ref<Device> m_device;
     ref<Blitter> m_blitter;
+    ref<BitmapUploader> m_bitmap_uploader;
 };
 
 } // namespace sgl